@@ -53,6 +53,18 @@ endif()
 find_package(JeMalloc)
 include_directories(SYSTEM ${JEMALLOC_INCLUDE_DIR})
 
+# ---[ NUMA (optional; enables NUMA-aware tile group allocation)
+find_path(NUMA_INCLUDE_DIR numa.h)
+find_library(NUMA_LIBRARY numa)
+if(NUMA_INCLUDE_DIR AND NUMA_LIBRARY)
+  include_directories(SYSTEM ${NUMA_INCLUDE_DIR})
+  list(APPEND Peloton_LINKER_LIBS ${NUMA_LIBRARY})
+  add_definitions(-DPELOTON_NUMA)
+  message(STATUS "Found NUMA (include: ${NUMA_INCLUDE_DIR}, library: ${NUMA_LIBRARY})")
+else()
+  message(STATUS "NUMA not found; NUMA-aware tile group allocation disabled")
+endif()
+
 # --[ PQXX
 find_package(PQXX REQUIRED)
 include_directories(SYSTEM ${PQXX_INCLUDE_DIRECTORIES})
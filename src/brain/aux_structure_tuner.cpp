@@ -0,0 +1,311 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// aux_structure_tuner.cpp
+//
+// Identification: src/brain/aux_structure_tuner.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/aux_structure_tuner.h"
+
+#include <chrono>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/zone_map_manager.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace brain {
+
+const uint64_t AuxStructureTuner::kMinObservations;
+const uint64_t AuxStructureTuner::kBloomBitsPerTuple;
+
+void AuxStructureTuner::TileGroupBloomFilter::Insert(size_t hash) {
+  // Second probe from the golden-ratio multiply already used by the hash
+  // executor's partitioning
+  uint64_t second = static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15);
+  uint64_t first_bit = hash & bit_mask;
+  uint64_t second_bit = second & bit_mask;
+  bits[first_bit >> 3] |= static_cast<uint8_t>(1u << (first_bit & 7));
+  bits[second_bit >> 3] |= static_cast<uint8_t>(1u << (second_bit & 7));
+}
+
+bool AuxStructureTuner::TileGroupBloomFilter::MayContain(size_t hash) const {
+  uint64_t second = static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15);
+  uint64_t first_bit = hash & bit_mask;
+  uint64_t second_bit = second & bit_mask;
+  return (bits[first_bit >> 3] & (1u << (first_bit & 7))) != 0 &&
+         (bits[second_bit >> 3] & (1u << (second_bit & 7))) != 0;
+}
+
+AuxStructureTuner::AuxStructureTuner()
+    : tuner_stop_(true), bloom_bytes_(0), pass_count_(0) {}
+
+AuxStructureTuner::~AuxStructureTuner() {}
+
+AuxStructureTuner &AuxStructureTuner::GetInstance() {
+  static AuxStructureTuner aux_structure_tuner;
+  return aux_structure_tuner;
+}
+
+void AuxStructureTuner::Start() {
+  tuner_stop_ = false;
+
+  tuner_thread_ = std::thread(&brain::AuxStructureTuner::Tune, this);
+
+  LOG_INFO("Started auxiliary structure tuner");
+}
+
+void AuxStructureTuner::Stop() {
+  tuner_stop_ = true;
+
+  if (tuner_thread_.joinable()) {
+    tuner_thread_.join();
+  }
+
+  LOG_INFO("Stopped auxiliary structure tuner");
+}
+
+void AuxStructureTuner::Tune() {
+  while (tuner_stop_ == false) {
+    // Re-read every pass so the interval can be tuned at runtime
+    int interval_ms = settings::SettingsManager::GetInt(
+        settings::SettingId::aux_tuner_interval_ms);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+    BuildStructures();
+
+    pass_count_.fetch_add(1);
+
+    LOG_TRACE("Aux tuning pass %" PRIu64 " done, %" PRIu64
+              " bloom filter bytes in use",
+              pass_count_.load(), bloom_bytes_.load());
+  }
+}
+
+void AuxStructureTuner::RecordFilters(
+    storage::DataTable *table,
+    const std::vector<storage::PredicateInfo> &predicates) {
+  oid_t database_oid = table->GetDatabaseOid();
+  oid_t table_oid = table->GetOid();
+
+  stats_latch_.Lock();
+  for (const auto &predicate : predicates) {
+    auto &stats = filter_stats_[std::make_tuple(
+        database_oid, table_oid, static_cast<oid_t>(predicate.col_id))];
+    switch (predicate.comparison_operator) {
+      case (int)ExpressionType::COMPARE_EQUAL:
+        stats.equality_count++;
+        break;
+      case (int)ExpressionType::COMPARE_LESSTHAN:
+      case (int)ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      case (int)ExpressionType::COMPARE_GREATERTHAN:
+      case (int)ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        stats.range_count++;
+        break;
+      default:
+        break;
+    }
+  }
+  stats_latch_.Unlock();
+}
+
+bool AuxStructureTuner::ShouldSkipTileGroup(
+    storage::DataTable *table, oid_t tile_group_offset,
+    const std::vector<storage::PredicateInfo> &predicates) {
+  oid_t database_oid = table->GetDatabaseOid();
+  oid_t table_oid = table->GetOid();
+  auto schema = table->GetSchema();
+
+  for (const auto &predicate : predicates) {
+    if (predicate.comparison_operator !=
+        (int)ExpressionType::COMPARE_EQUAL) {
+      continue;
+    }
+
+    const type::Value &value = predicate.predicate_value;
+    // Equality with NULL never matches, but the scan handles that; the
+    // filter only answers for real literals
+    if (value.IsNull()) {
+      continue;
+    }
+
+    // The filter hashes values in the column's native type. Rather than
+    // casting the literal -- a lossy cast could hash to a value the column
+    // does hold -- a mismatched literal simply never causes a skip.
+    if (value.GetTypeId() !=
+        schema->GetType(static_cast<oid_t>(predicate.col_id))) {
+      continue;
+    }
+
+    const TileGroupBloomFilter *filter = nullptr;
+    bloom_latch_.Lock();
+    auto it = bloom_filters_.find(
+        std::make_tuple(database_oid, table_oid, tile_group_offset,
+                        static_cast<oid_t>(predicate.col_id)));
+    if (it != bloom_filters_.end()) {
+      // entries are never removed, so the pointer outlives the latch
+      filter = &it->second;
+    }
+    bloom_latch_.Unlock();
+
+    if (filter != nullptr && filter->MayContain(value.Hash()) == false) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AuxStructureTuner::BuildStructures() {
+  uint64_t budget_bytes =
+      static_cast<uint64_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::aux_tuner_bloom_budget_mb)) *
+      1024 * 1024;
+
+  // Snapshot the counts so scans never wait on a build pass
+  stats_latch_.Lock();
+  auto stats_snapshot = filter_stats_;
+  stats_latch_.Unlock();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+
+  for (const auto &entry : stats_snapshot) {
+    oid_t database_oid = std::get<0>(entry.first);
+    oid_t table_oid = std::get<1>(entry.first);
+    oid_t col_id = std::get<2>(entry.first);
+    const FilterStats &stats = entry.second;
+
+    bool wants_zone_map = stats.range_count >= kMinObservations;
+    bool wants_bloom = stats.equality_count >= kMinObservations;
+    if (!wants_zone_map && !wants_bloom) {
+      continue;
+    }
+
+    storage::DataTable *table = nullptr;
+    try {
+      table = storage_manager->GetTableWithOid(database_oid, table_oid);
+    } catch (Exception &e) {
+      // dropped since the observation; counts for it just go stale
+      continue;
+    }
+    if (table == nullptr) {
+      continue;
+    }
+
+    // An index already answers equality filters on this column faster
+    // than a tile group skip would
+    if (wants_bloom) {
+      for (const auto &index_columns : table->GetIndexColumns()) {
+        if (index_columns.count(col_id) != 0) {
+          wants_bloom = false;
+          break;
+        }
+      }
+    }
+    if (!wants_zone_map && !wants_bloom) {
+      continue;
+    }
+
+    size_t tile_group_count = table->GetTileGroupCount();
+    for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+         tile_group_offset++) {
+      auto tile_group = table->GetTileGroup(tile_group_offset);
+      if (tile_group == nullptr) {
+        continue;
+      }
+
+      // Mutable tile groups still accept inserts, which would let a
+      // filter or zone map claim a value is absent when it is not
+      if (tile_group->GetHeader()->GetImmutability() == false) {
+        continue;
+      }
+
+      StructureKey key = std::make_tuple(database_oid, table_oid,
+                                         tile_group_offset, col_id);
+
+      if (wants_zone_map && built_zone_maps_.count(key) == 0) {
+        if (zone_map_manager->ZoneMapTableExists() == false) {
+          zone_map_manager->CreateZoneMapTableInCatalog();
+        }
+        zone_map_manager->CreateOrUpdateZoneMapForColumn(
+            table, tile_group_offset, col_id, nullptr);
+        built_zone_maps_.insert(key);
+      }
+
+      if (wants_bloom) {
+        bloom_latch_.Lock();
+        bool exists = bloom_filters_.count(key) != 0;
+        bloom_latch_.Unlock();
+        if (!exists &&
+            BuildBloomFilter(table, tile_group_offset, col_id,
+                             budget_bytes) == false) {
+          // budget exhausted; later passes retry once it is raised
+          wants_bloom = false;
+        }
+      }
+    }
+  }
+}
+
+bool AuxStructureTuner::BuildBloomFilter(storage::DataTable *table,
+                                         oid_t tile_group_offset,
+                                         oid_t col_id,
+                                         uint64_t budget_bytes) {
+  auto tile_group = table->GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return true;
+  }
+
+  // Size to the next power of two above kBloomBitsPerTuple bits per slot
+  oid_t num_tuple_slots = tile_group->GetAllocatedTupleCount();
+  uint64_t num_bits = 64;
+  while (num_bits < num_tuple_slots * kBloomBitsPerTuple) {
+    num_bits <<= 1;
+  }
+
+  uint64_t num_bytes = num_bits / 8;
+  if (bloom_bytes_.load() + num_bytes > budget_bytes) {
+    return false;
+  }
+
+  TileGroupBloomFilter filter;
+  filter.bits.assign(num_bytes, 0);
+  filter.bit_mask = num_bits - 1;
+
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+    type::Value value = tile_group->GetValue(tuple_itr, col_id);
+    if (value.IsNull()) {
+      continue;
+    }
+    filter.Insert(value.Hash());
+  }
+
+  bloom_latch_.Lock();
+  auto inserted = bloom_filters_.emplace(
+      std::make_tuple(table->GetDatabaseOid(), table->GetOid(),
+                      tile_group_offset, col_id),
+      std::move(filter));
+  bloom_latch_.Unlock();
+
+  if (inserted.second) {
+    bloom_bytes_.fetch_add(num_bytes);
+    LOG_TRACE("Built bloom filter for table %u tile group %u column %u",
+              table->GetOid(), tile_group_offset, col_id);
+  }
+  return true;
+}
+
+}  // namespace brain
+}  // namespace peloton
@@ -137,8 +137,29 @@ void IndexTuner::BuildIndex(storage::DataTable* table,
   tile_groups_indexed_ += tile_groups_indexed;
 }
 
+// Does the table have an index whose backfill has not caught up with the
+// table yet? Such an index is the one in-flight mutation the tuner allows.
+static bool HasIndexBuildInFlight(storage::DataTable* table) {
+  oid_t index_count = table->GetIndexCount();
+  auto table_tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = table->GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
+
+    if (index->GetIndexedTileGroupOff() < table_tile_group_count) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void IndexTuner::BuildIndices(storage::DataTable* table) {
   oid_t index_count = table->GetIndexCount();
+  auto table_tile_group_count = table->GetTileGroupCount();
 
   for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
     // Get index
@@ -147,8 +168,11 @@ void IndexTuner::BuildIndices(storage::DataTable* table) {
       continue;
     }
 
-    // Build index
-    // BuildIndex(table, index);
+    // Backfill the index online: a bounded slice of tile groups per pass on
+    // the tuner thread, while writers keep it current for new tuples
+    if (index->GetIndexedTileGroupOff() < table_tile_group_count) {
+      BuildIndex(table, index);
+    }
   }
 }
 
@@ -253,7 +277,8 @@ std::vector<sample_frequency_map_entry> GetFrequentSamples(
 }
 
 std::vector<std::vector<double>> GetSuggestedIndices(
-    const std::vector<sample_frequency_map_entry>& list) {
+    const std::vector<sample_frequency_map_entry>& list,
+    std::vector<double>& suggested_utilities) {
   // Find frequent samples
   size_t frequency_rank_threshold = 10;
 
@@ -268,6 +293,7 @@ std::vector<std::vector<double>> GetSuggestedIndices(
     auto& sample = entry.first;
     LOG_TRACE("%s Utility : %.2lf", sample.GetInfo().c_str(), entry.second);
     suggested_indices.push_back(sample.GetColumnsAccessed());
+    suggested_utilities.push_back(entry.second);
   }
 
   return suggested_indices;
@@ -327,9 +353,9 @@ void IndexTuner::DropIndexes(storage::DataTable* table) {
 
 void IndexTuner::AddIndexes(
     storage::DataTable* table,
-    const std::vector<std::vector<double>>& suggested_indices) {
+    const std::vector<std::vector<double>>& suggested_indices,
+    const std::vector<double>& suggested_utilities) {
   oid_t valid_index_count = table->GetValidIndexCount();
-  size_t constructed_index_itr = 0;
 
   // Check if we have constructed too many indexess
   if (valid_index_count > index_count_threshold) {
@@ -337,12 +363,24 @@ void IndexTuner::AddIndexes(
     return;
   }
 
-  for (auto suggested_index : suggested_indices) {
+  for (size_t suggestion_itr = 0; suggestion_itr < suggested_indices.size();
+       suggestion_itr++) {
+    auto& suggested_index = suggested_indices[suggestion_itr];
     std::set<oid_t> suggested_index_set(suggested_index.begin(),
                                         suggested_index.end());
 
     if (suggested_index_set.empty()) continue;
 
+    // Benefit gate: only build an index whose workload share makes the
+    // backfill expense worthwhile; this filters the long tail of
+    // suggestions that would be built only to decay below the drop
+    // threshold later
+    if (suggested_utilities[suggestion_itr] < index_build_utility_threshold) {
+      LOG_TRACE("Suggested index utility %.2lf below build threshold",
+                suggested_utilities[suggestion_itr]);
+      continue;
+    }
+
     // Go over all indices
     bool suggested_index_found = false;
     oid_t index_count = table->GetIndexCount();
@@ -365,7 +403,10 @@ void IndexTuner::AddIndexes(
 
       // Add adhoc index with given utility
       AddIndex(table, suggested_index_set);
-      constructed_index_itr++;
+
+      // Rate limit: one index mutation in flight; the new index must finish
+      // its backfill before the tuner adds or drops anything else
+      return;
     }
     // Found suggested index, enable it
     else if (suggested_index_found == true) {
@@ -459,11 +500,17 @@ void IndexTuner::Analyze(storage::DataTable* table) {
   auto sample_frequency_entry_list = GetFrequentSamples(samples);
 
   // Compute suggested indices
-  auto suggested_indices = GetSuggestedIndices(sample_frequency_entry_list);
+  std::vector<double> suggested_utilities;
+  auto suggested_indices =
+      GetSuggestedIndices(sample_frequency_entry_list, suggested_utilities);
 
   // Check index storage footprint
   auto valid_index_count = table->GetValidIndexCount();
 
+  // While an index is still backfilling, the only mutation allowed is
+  // finishing that build; utilities keep being tracked below
+  auto index_build_in_flight = HasIndexBuildInFlight(table);
+
   ////////////////////////////////////////////////
   // Drop indexes if
   // a) constructed too many indexes
@@ -474,14 +521,17 @@ void IndexTuner::Analyze(storage::DataTable* table) {
   auto write_intensive_workload = (average_write_ratio > write_ratio_threshold);
 
   // Skip drop table time
-  if (visibility_mode_ == false) {
+  if (visibility_mode_ == false && index_build_in_flight == false) {
     if (index_overflow == true || write_intensive_workload == true) {
       DropIndexes(table);
     }
   }
 
-  // Add indexes if needed
-  AddIndexes(table, suggested_indices);
+  // Add indexes if needed; a write-intensive workload would not amortize
+  // the build, and we just dropped under the same condition
+  if (index_build_in_flight == false && write_intensive_workload == false) {
+    AddIndexes(table, suggested_indices, suggested_utilities);
+  }
 
   // Update index utility
   if (visibility_mode_ == false) {
@@ -112,7 +112,41 @@ Sample GetClustererSample(const Sample& sample, oid_t column_count) {
   return clusterer_sample;
 }
 
-void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
+double LayoutTuner::GetLayoutDifference(const column_map_type& layout,
+                                        const column_map_type& other) const {
+  if (layout.size() != other.size()) {
+    return 1.0;
+  }
+  if (layout.size() < 2) {
+    return 0.0;
+  }
+
+  // Count column pairs co-located in one layout but split in the other;
+  // comparing pairs instead of tile ids keeps the measure insensitive to
+  // tile id permutation
+  size_t pair_count = 0;
+  size_t disagreement_count = 0;
+  for (auto first_itr = layout.begin(); first_itr != layout.end();
+       first_itr++) {
+    auto second_itr = first_itr;
+    for (++second_itr; second_itr != layout.end(); second_itr++) {
+      bool together_here =
+          (first_itr->second.first == second_itr->second.first);
+      bool together_there = (other.at(first_itr->first).first ==
+                             other.at(second_itr->first).first);
+      if (together_here != together_there) {
+        disagreement_count++;
+      }
+      pair_count++;
+    }
+  }
+
+  return static_cast<double>(disagreement_count) /
+         static_cast<double>(pair_count);
+}
+
+void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table,
+                                         TableTunerState& state) {
   oid_t column_count = table->GetSchema()->GetColumnCount();
 
   // Set up clusterer
@@ -121,8 +155,9 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
   // Process all samples in table
   auto samples = table->GetLayoutSamples();
 
-  // Check if we have any samples
-  if (samples.empty()) {
+  // Wait until the executors have recorded enough real accesses to make the
+  // proposal meaningful
+  if (samples.size() < min_sample_count) {
     return;
   }
 
@@ -146,8 +181,33 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
 
   LOG_TRACE("%s", GetColumnMapInfo(layout).c_str());
 
+  // Hysteresis: ignore proposals close to the current layout, and adopt a
+  // genuinely different one only after the workload keeps re-deriving it
+  if (GetLayoutDifference(layout, table->GetDefaultLayout()) <
+      layout_change_threshold) {
+    state.pending_layout.clear();
+    state.rounds_pending = 0;
+    return;
+  }
+
+  if (!state.pending_layout.empty() &&
+      GetLayoutDifference(layout, state.pending_layout) <
+          layout_change_threshold) {
+    state.rounds_pending++;
+  } else {
+    state.pending_layout = layout;
+    state.rounds_pending = 1;
+  }
+
+  if (state.rounds_pending < hysteresis_rounds) {
+    return;
+  }
+
   // Update table layout
   table->SetDefaultLayout(layout);
+  layout_update_count_.fetch_add(1);
+  state.pending_layout.clear();
+  state.rounds_pending = 0;
 }
 
 void LayoutTuner::Tune() {
@@ -156,15 +216,29 @@ void LayoutTuner::Tune() {
   while (layout_tuning_stop == false) {
     // Go over all tables
     for (auto table : tables) {
-      // Transform
-      auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
+      auto& state = table_states_[table];
 
-      LOG_TRACE("Transforming tile group at offset: %lu", tile_group_offset);
-      table->TransformTileGroup(tile_group_offset, theta);
+      // Transform a bounded batch of tile groups towards the default
+      // layout, clock-style, so one epoch never rewrites the whole table
+      auto tile_group_count = table->GetTileGroupCount();
+      if (tile_group_count == 0) {
+        continue;
+      }
+      for (oid_t batch_itr = 0; batch_itr < transform_batch_size;
+           batch_itr++) {
+        auto tile_group_offset =
+            state.next_tile_group_offset % tile_group_count;
+        state.next_tile_group_offset =
+            (tile_group_offset + 1) % tile_group_count;
+
+        LOG_TRACE("Transforming tile group at offset: %u", tile_group_offset);
+        if (table->TransformTileGroup(tile_group_offset, theta) != nullptr) {
+          tile_groups_transformed_.fetch_add(1);
+        }
+      }
 
       // Update partitioning periodically
-      UpdateDefaultPartition(table);
+      UpdateDefaultPartition(table, state);
 
       // Sleep a bit
       std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
@@ -195,6 +269,7 @@ void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    table_states_.clear();
   }
 }
 
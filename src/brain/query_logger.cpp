@@ -19,6 +19,15 @@
 namespace peloton {
 namespace brain {
 
+namespace {
+// upper bound on queries buffered between flushes; the queue grows past
+// this if a flush falls behind, it is only the pre-allocated capacity
+const size_t QUERY_LOG_QUEUE_SIZE = 1024;
+}  // namespace
+
+LockFreeQueue<QueryLogger::QueryLogEntry> QueryLogger::query_queue_{
+    QUERY_LOG_QUEUE_SIZE};
+
 QueryLogger::Fingerprint::Fingerprint(const std::string &query)
     : query_(query),
       fingerprint_(""),
@@ -33,18 +42,28 @@ QueryLogger::Fingerprint::~Fingerprint() {
 }
 
 void QueryLogger::LogQuery(std::string query_string, uint64_t timestamp) {
-  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto *txn = txn_manager.BeginTransaction();
+  query_queue_.Enqueue(QueryLogEntry{std::move(query_string), timestamp});
+}
 
-  // Perform fingerprint
-  Fingerprint fingerprint{query_string};
+void QueryLogger::Flush() {
+  QueryLogEntry entry;
+  if (query_queue_.Dequeue(entry) == false) {
+    return;
+  }
 
-  // Log query + fingerprint
+  // One transaction covers the whole batch; the per-query cost is the
+  // fingerprint plus a catalog insert
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
   auto &query_history_catalog = catalog::QueryHistoryCatalog::GetInstance();
-  query_history_catalog.InsertQueryHistory(
-      query_string, fingerprint.GetFingerprint(), timestamp, nullptr, txn);
 
-  // We're done
+  do {
+    Fingerprint fingerprint{entry.query_string};
+    query_history_catalog.InsertQueryHistory(
+        entry.query_string, fingerprint.GetFingerprint(), entry.timestamp,
+        nullptr, txn);
+  } while (query_queue_.Dequeue(entry));
+
   txn_manager.CommitTransaction(txn);
 }
 
@@ -0,0 +1,158 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tiering_service.cpp
+//
+// Identification: src/brain/tiering_service.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/tiering_service.h"
+
+#include <chrono>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace brain {
+
+TieringService::TieringService()
+    : tiering_stop_(true), total_frozen_count_(0), pass_count_(0) {}
+
+TieringService::~TieringService() {}
+
+TieringService &TieringService::GetInstance() {
+  static TieringService tiering_service;
+  return tiering_service;
+}
+
+void TieringService::Start() {
+  tiering_stop_ = false;
+
+  tiering_thread_ = std::thread(&brain::TieringService::Tier, this);
+
+  LOG_INFO("Started tiering service");
+}
+
+void TieringService::Stop() {
+  tiering_stop_ = true;
+
+  if (tiering_thread_.joinable()) {
+    tiering_thread_.join();
+  }
+
+  LOG_INFO("Stopped tiering service");
+}
+
+void TieringService::Tier() {
+  while (tiering_stop_ == false) {
+    // Both knobs are re-read every pass so they can be tuned at runtime
+    int interval_ms = settings::SettingsManager::GetInt(
+        settings::SettingId::tiering_interval_ms);
+    int cold_epoch_count = settings::SettingsManager::GetInt(
+        settings::SettingId::tiering_cold_epoch_count);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+    FreezeColdTileGroups(cold_epoch_count);
+
+    pass_count_.fetch_add(1);
+
+    LOG_TRACE("Tiering pass %" PRIu64 " done, %" PRIu64
+              " tile groups frozen so far",
+              pass_count_.load(), total_frozen_count_.load());
+  }
+}
+
+void TieringService::FreezeColdTileGroups(int cold_epoch_count) {
+  eid_t current_epoch =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  oid_t database_count = storage_manager->GetDatabaseCount();
+  for (oid_t database_offset = 0; database_offset < database_count;
+       database_offset++) {
+    auto database = storage_manager->GetDatabaseWithOffset(database_offset);
+    if (database == nullptr) continue;
+
+    oid_t table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; table_offset++) {
+      auto table = database->GetTable(table_offset);
+      if (table == nullptr) continue;
+
+      size_t tile_group_count = table->GetTileGroupCount();
+      for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+           tile_group_offset++) {
+        auto tile_group = table->GetTileGroup(tile_group_offset);
+        if (tile_group == nullptr) continue;
+
+        auto tile_group_header = tile_group->GetHeader();
+
+        // Only full tile groups are frozen; partially filled ones still
+        // accept inserts
+        if (tile_group->GetNextTupleSlot() <
+            tile_group->GetAllocatedTupleCount()) {
+          continue;
+        }
+
+        // Already frozen
+        if (tile_group_header->GetImmutability() == true) {
+          continue;
+        }
+
+        // Still hot: read within the last cold_epoch_count epochs
+        eid_t last_access_epoch = tile_group_header->GetLastAccessEpochId();
+        if (current_epoch <
+            last_access_epoch + static_cast<eid_t>(cold_epoch_count)) {
+          continue;
+        }
+
+        if (FreezeTileGroup(tile_group) == true) {
+          total_frozen_count_.fetch_add(1);
+        }
+      }
+    }
+  }
+}
+
+bool TieringService::FreezeTileGroup(
+    const std::shared_ptr<storage::TileGroup> &tile_group) {
+  // The CAS on the immutable flag makes sure only one freezer wins, e.g.
+  // when racing with the zone map manager
+  if (tile_group->GetHeader()->SetImmutability() == false) {
+    return false;
+  }
+
+  // Dictionary-encode the VARCHAR columns of every tile. The tile group no
+  // longer accepts inserts, so the encodings stay complete.
+  for (oid_t tile_offset = 0; tile_offset < tile_group->NumTiles();
+       tile_offset++) {
+    auto tile = tile_group->GetTileReference(tile_offset);
+    auto *schema = tile->GetSchema();
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      if (schema->GetType(column_itr) == type::TypeId::VARCHAR) {
+        tile->DictionaryEncodeColumn(column_itr);
+      }
+    }
+  }
+
+  LOG_TRACE("Froze tile group %u", tile_group->GetTileGroupId());
+
+  return true;
+}
+
+}  // namespace brain
+}  // namespace peloton
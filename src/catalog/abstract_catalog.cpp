@@ -16,8 +16,11 @@
 
 #include "catalog/catalog.h"
 #include "catalog/database_catalog.h"
+#include "catalog/manager.h"
 #include "catalog/table_catalog.h"
 
+#include "concurrency/transaction_manager_factory.h"
+
 #include "index/index_factory.h"
 #include "optimizer/optimizer.h"
 #include "parser/postgresparser.h"
@@ -36,6 +39,11 @@
 #include "storage/database.h"
 #include "storage/storage_manager.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+
+#include "type/ephemeral_pool.h"
 
 namespace peloton {
 namespace catalog {
@@ -200,6 +208,112 @@ AbstractCatalog::GetResultWithIndexScan(
   return result_tiles;
 }
 
+/*@brief   Hand-written point lookup helper function
+* Probes the index with ScanKey and reads the visible version's columns
+* straight from the tile group; no plan or executor is built. The version
+* chain traversal follows IndexScanExecutor::ExecPrimaryIndexLookup minus
+* the predicate and for-update paths catalog lookups never use.
+* @param   column_offsets    Column ids to materialize per matching tuple
+* @param   index_offset      Offset of index for the probe
+* @param   values            Full equality key, one value per key column
+* @param   txn               TransactionContext
+* @return  One row of values per visible matching tuple
+*/
+std::vector<std::vector<type::Value>> AbstractCatalog::GetRowsWithIndexLookup(
+    const std::vector<oid_t> &column_offsets, oid_t index_offset,
+    const std::vector<type::Value> &values,
+    concurrency::TransactionContext *txn) const {
+  if (txn == nullptr) throw CatalogException("Scan table requires transaction");
+
+  std::vector<std::vector<type::Value>> rows;
+
+  auto index = catalog_table_->GetIndex(index_offset);
+  PL_ASSERT(index != nullptr);
+  auto *key_schema = index->GetMetadata()->GetKeySchema();
+  PL_ASSERT(values.size() == key_schema->GetColumnCount());
+
+  // Build the probe key directly; varchar key values stay in a local pool
+  type::EphemeralPool pool;
+  storage::Tuple key(key_schema, true);
+  for (oid_t column_itr = 0; column_itr < values.size(); column_itr++) {
+    key.SetValue(column_itr, values[column_itr], &pool);
+  }
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  index->ScanKey(&key, tuple_location_ptrs);
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location = *tuple_location_ptr;
+    auto tile_group = manager.GetTileGroup(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
+    size_t chain_length = 0;
+
+    // traverse the version chain until a visible version is found
+    while (true) {
+      ++chain_length;
+
+      auto visibility = transaction_manager.IsVisible(txn, tile_group_header,
+                                                      tuple_location.offset);
+
+      if (visibility == VisibilityType::DELETED) {
+        break;
+      } else if (visibility == VisibilityType::OK) {
+        if (!transaction_manager.PerformRead(txn, tuple_location, false)) {
+          transaction_manager.SetTransactionResult(txn, ResultType::FAILURE);
+          return {};
+        }
+        std::vector<type::Value> row;
+        row.reserve(column_offsets.size());
+        for (auto column_offset : column_offsets) {
+          row.push_back(
+              tile_group->GetValue(tuple_location.offset, column_offset));
+        }
+        rows.push_back(std::move(row));
+        break;
+      } else {
+        PL_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+        bool is_acquired = (tile_group_header->GetTransactionId(
+                                tuple_location.offset) == INITIAL_TXN_ID);
+        bool is_alive =
+            (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+             txn->GetReadId());
+        if (is_acquired && is_alive) {
+          // the version chain was modified under us; restart from the
+          // indirection layer
+          tuple_location =
+              *(tile_group_header->GetIndirection(tuple_location.offset));
+          tile_group = manager.GetTileGroup(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
+          chain_length = 0;
+          continue;
+        }
+
+        tuple_location =
+            tile_group_header->GetNextItemPointer(tuple_location.offset);
+
+        if (tuple_location.IsNull()) {
+          if (chain_length == 1) {
+            break;
+          }
+          // there must exist a visible version
+          transaction_manager.SetTransactionResult(txn, ResultType::FAILURE);
+          return {};
+        }
+
+        tile_group = manager.GetTileGroup(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
+      }
+    }
+  }
+
+  return rows;
+}
+
 /*@brief   Sequential scan helper function
 * NOTE: try to use efficient index scan instead of sequential scan, but you
 * shouldn't build too many indexes on one catalog table
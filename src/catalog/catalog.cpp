@@ -12,6 +12,7 @@
 
 #include "catalog/catalog.h"
 
+#include "catalog/catalog_name_cache.h"
 #include "catalog/column_catalog.h"
 #include "catalog/database_catalog.h"
 #include "catalog/database_metrics_catalog.h"
@@ -20,6 +21,8 @@
 #include "catalog/language_catalog.h"
 #include "catalog/proc_catalog.h"
 #include "catalog/query_history_catalog.h"
+#include "catalog/latency_metrics_catalog.h"
+#include "catalog/query_progress_catalog.h"
 #include "catalog/query_metrics_catalog.h"
 #include "catalog/settings_catalog.h"
 #include "catalog/table_catalog.h"
@@ -29,6 +32,7 @@
 #include "function/date_functions.h"
 #include "function/decimal_functions.h"
 #include "function/old_engine_string_functions.h"
+#include "function/system_functions.h"
 #include "function/timestamp_functions.h"
 #include "index/index_factory.h"
 #include "settings/settings_manager.h"
@@ -148,7 +152,9 @@ void Catalog::Bootstrap() {
   DatabaseMetricsCatalog::GetInstance(txn);
   TableMetricsCatalog::GetInstance(txn);
   IndexMetricsCatalog::GetInstance(txn);
-  QueryMetricsCatalog::GetInstance(txn);  
+  QueryMetricsCatalog::GetInstance(txn);
+  LatencyMetricsCatalog::GetInstance(txn);
+  QueryProgressCatalog::GetInstance(txn);
   SettingsCatalog::GetInstance(txn);
   TriggerCatalog::GetInstance(txn);
   LanguageCatalog::GetInstance(txn);
@@ -199,6 +205,9 @@ ResultType Catalog::CreateDatabase(const std::string &database_name,
   // Insert database record into pg_db
   pg_database->InsertDatabase(database_oid, database_name, pool_.get(), txn);
 
+  // invalidate cached name resolutions
+  CatalogNameCache::GetInstance().BumpEpoch();
+
   LOG_TRACE("Database %s created. Returning RESULT_SUCCESS.",
             database_name.c_str());
   return ResultType::SUCCESS;
@@ -284,6 +293,9 @@ ResultType Catalog::CreateTable(const std::string &database_name,
     column_id++;
   }
   CreatePrimaryIndex(database_object->GetDatabaseOid(), table_oid, txn);
+
+  // invalidate cached name resolutions
+  CatalogNameCache::GetInstance().BumpEpoch();
   return ResultType::SUCCESS;
 }
 
@@ -453,6 +465,10 @@ ResultType Catalog::CreateIndex(
       index_oid, index_name, table_oid, index_type, index_constraint,
       unique_keys, key_attrs, pool_.get(), txn);
 
+  // index DDL changes which plans are valid, so it advances the catalog
+  // epoch as well even though it does not affect name resolution
+  CatalogNameCache::GetInstance().BumpEpoch();
+
   LOG_TRACE("Successfully add index for table %s contains %d indexes",
             table->GetName().c_str(), (int)table->GetValidIndexCount());
   return ResultType::SUCCESS;
@@ -462,6 +478,52 @@ ResultType Catalog::CreateIndex(
 // DROP FUNCTIONS
 //===----------------------------------------------------------------------===//
 
+/*@brief   Metadata-only ALTER TABLE ADD COLUMN fast path
+ * Only a nullable column without constraints qualifies. The column is
+ * appended to the table schema and recorded in pg_attribute; existing
+ * tile groups are never rewritten, so the change is instantaneous and
+ * concurrent writes do not stall. Old rows read the column back as NULL
+ * and materialize it the next time a new version of them is written.
+ * @param   database_name   the database the table belongs to
+ * @param   table_name      the table the column is added to
+ * @param   column          the column to add
+ * @param   txn             TransactionContext
+ * @return  TransactionContext ResultType(SUCCESS or FAILURE)
+ */
+ResultType Catalog::AddDefaultNullColumn(
+    const std::string &database_name, const std::string &table_name,
+    const catalog::Column &column, concurrency::TransactionContext *txn) {
+  if (txn == nullptr)
+    throw CatalogException("Do not have transaction to alter table " +
+                           table_name);
+
+  // throws CatalogException when the database or table does not exist
+  auto table = GetTableWithName(database_name, table_name, txn);
+
+  for (const auto &existing_column : table->GetSchema()->GetColumns()) {
+    if (existing_column.GetName() == column.GetName())
+      throw CatalogException("Alter Table: column " + column.GetName() +
+                             " already exists");
+  }
+
+  oid_t column_id = table->GetSchema()->GetColumnCount();
+  if (table->AddDefaultNullColumn(column) == false) {
+    return ResultType::FAILURE;
+  }
+
+  // record the column in pg_attribute, mirroring CreateTable's bookkeeping
+  const auto &added_column = table->GetSchema()->GetColumns().back();
+  ColumnCatalog::GetInstance()->InsertColumn(
+      table->GetOid(), added_column.GetName(), column_id,
+      added_column.GetOffset(), added_column.GetType(),
+      added_column.IsInlined(), added_column.GetConstraints(), pool_.get(),
+      txn);
+
+  // invalidate cached name resolutions
+  CatalogNameCache::GetInstance().BumpEpoch();
+  return ResultType::SUCCESS;
+}
+
 ResultType Catalog::DropDatabaseWithName(const std::string &database_name,
                                          concurrency::TransactionContext *txn) {
   if (txn == nullptr)
@@ -500,6 +562,8 @@ ResultType Catalog::DropDatabaseWithOid(oid_t database_oid,
   storage_manager->GetDatabaseWithOid(database_oid);
   txn->RecordDrop(database_oid, INVALID_OID, INVALID_OID);
 
+  // invalidate cached name resolutions
+  CatalogNameCache::GetInstance().BumpEpoch();
   return ResultType::SUCCESS;
 }
 
@@ -568,6 +632,8 @@ ResultType Catalog::DropTable(oid_t database_oid, oid_t table_oid,
   database->GetTableWithOid(table_oid);
   txn->RecordDrop(database_oid, table_oid, INVALID_OID);
 
+  // invalidate cached name resolutions
+  CatalogNameCache::GetInstance().BumpEpoch();
   return ResultType::SUCCESS;
 }
 
@@ -609,6 +675,10 @@ ResultType Catalog::DropIndex(oid_t index_oid,
   txn->RecordDrop(table_object->GetDatabaseOid(), table_object->GetTableOid(),
                   index_oid);
 
+  // index DDL changes which plans are valid, so it advances the catalog
+  // epoch as well even though it does not affect name resolution
+  CatalogNameCache::GetInstance().BumpEpoch();
+
   return ResultType::SUCCESS;
 }
 
@@ -641,6 +711,17 @@ storage::Database *Catalog::GetDatabaseWithName(
     concurrency::TransactionContext *txn) const {
   PL_ASSERT(txn != nullptr);
 
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto &name_cache = CatalogNameCache::GetInstance();
+
+  // Fast path: resolve through the shared name cache; no DDL has run since
+  // the entry was filled, so skip the pg_database scan
+  oid_t cached_database_oid = INVALID_OID;
+  if (name_cache.ResolveDatabase(database_name, cached_database_oid)) {
+    return storage_manager->GetDatabaseWithOid(cached_database_oid);
+  }
+  uint64_t epoch = name_cache.GetEpoch();
+
   // Check in pg_database using txn
   auto database_object =
       DatabaseCatalog::GetInstance()->GetDatabaseObject(database_name, txn);
@@ -649,7 +730,8 @@ storage::Database *Catalog::GetDatabaseWithName(
     throw CatalogException("Database " + database_name + " is not found");
   }
 
-  auto storage_manager = storage::StorageManager::GetInstance();
+  name_cache.FillDatabase(epoch, database_name,
+                          database_object->GetDatabaseOid());
   return storage_manager->GetDatabaseWithOid(database_object->GetDatabaseOid());
 }
 
@@ -665,11 +747,28 @@ storage::DataTable *Catalog::GetTableWithName(
   LOG_TRACE("Looking for table %s in database %s", table_name.c_str(),
             database_name.c_str());
 
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto &name_cache = CatalogNameCache::GetInstance();
+
+  // Fast path: resolve through the shared name cache; no DDL has run since
+  // the entry was filled, so skip the pg_database and pg_table scans
+  oid_t cached_database_oid = INVALID_OID;
+  oid_t cached_table_oid = INVALID_OID;
+  if (name_cache.ResolveTable(database_name, table_name, cached_database_oid,
+                              cached_table_oid)) {
+    return storage_manager->GetTableWithOid(cached_database_oid,
+                                            cached_table_oid);
+  }
+  uint64_t epoch = name_cache.GetEpoch();
+
   // Check in pg_database, throw exception and abort txn if not exists
   auto table_object = GetTableObject(database_name, table_name, txn);
 
+  name_cache.FillTable(epoch, database_name, table_name,
+                       table_object->GetDatabaseOid(),
+                       table_object->GetTableOid());
+
   // Get table from storage manager
-  auto storage_manager = storage::StorageManager::GetInstance();
   return storage_manager->GetTableWithOid(table_object->GetDatabaseOid(),
                                           table_object->GetTableOid());
 }
@@ -1254,6 +1353,16 @@ void Catalog::InitializeFunctions() {
                              OperatorId::Now, function::DateFunctions::_Now},
                          txn);
 
+      /**
+       * system functions
+       */
+      AddBuiltinFunction(
+          "kill_query", {type::TypeId::BIGINT}, type::TypeId::BOOLEAN,
+          internal_lang, "KillQuery",
+          function::BuiltInFuncType{OperatorId::KillQuery,
+                                    function::SystemFunctions::KillQuery},
+          txn);
+
     } catch (CatalogException &e) {
       txn_manager.AbortTransaction(txn);
       throw e;
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// catalog_name_cache.cpp
+//
+// Identification: src/catalog/catalog_name_cache.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog_name_cache.h"
+
+namespace peloton {
+namespace catalog {
+
+bool CatalogNameCache::ResolveDatabase(const std::string &database_name,
+                                       oid_t &database_oid) {
+  NameCacheEntry entry;
+  if (!Resolve(database_name, entry)) {
+    return false;
+  }
+  database_oid = entry.database_oid;
+  return true;
+}
+
+bool CatalogNameCache::ResolveTable(const std::string &database_name,
+                                    const std::string &table_name,
+                                    oid_t &database_oid, oid_t &table_oid) {
+  NameCacheEntry entry;
+  if (!Resolve(TableKey(database_name, table_name), entry)) {
+    return false;
+  }
+  database_oid = entry.database_oid;
+  table_oid = entry.table_oid;
+  return true;
+}
+
+void CatalogNameCache::FillDatabase(uint64_t epoch,
+                                    const std::string &database_name,
+                                    oid_t database_oid) {
+  Fill(database_name, {epoch, database_oid, INVALID_OID});
+}
+
+void CatalogNameCache::FillTable(uint64_t epoch,
+                                 const std::string &database_name,
+                                 const std::string &table_name,
+                                 oid_t database_oid, oid_t table_oid) {
+  Fill(TableKey(database_name, table_name), {epoch, database_oid, table_oid});
+}
+
+bool CatalogNameCache::Resolve(const std::string &key, NameCacheEntry &entry) {
+  std::shared_ptr<NameCacheEntry> cached;
+  if (!entries_.Find(key, cached)) {
+    return false;
+  }
+  // an entry filled before the last DDL is as good as absent
+  if (cached->epoch != epoch_.load()) {
+    return false;
+  }
+  entry = *cached;
+  return true;
+}
+
+void CatalogNameCache::Fill(const std::string &key,
+                            const NameCacheEntry &entry) {
+  // a DDL bumped the epoch while the caller was scanning the catalog; the
+  // resolution may reflect the old schema, so do not remember it
+  if (entry.epoch != epoch_.load()) {
+    return;
+  }
+  auto cached = std::make_shared<NameCacheEntry>(entry);
+  if (!entries_.Insert(key, cached)) {
+    entries_.Update(key, cached);
+  }
+}
+
+}  // namespace catalog
+}  // namespace peloton
@@ -24,17 +24,31 @@ void Column::SetLength(size_t column_length) {
   if (is_inlined) {
     fixed_length = column_length;
     variable_length = 0;
+    switch (column_type) {
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY:
+        // Inlined varlens carry their length prefix in the tuple itself
+        fixed_length += sizeof(uint32_t);
+        break;
+      default:
+        break;
+    }
   } else {
     fixed_length = sizeof(uintptr_t);
     variable_length = column_length;
   }
 }
 
-void Column::SetInlined() {
+void Column::SetInlined(size_t column_length) {
   switch (column_type) {
     case type::TypeId::VARCHAR:
     case type::TypeId::VARBINARY:
-      break;  // No change of inlined setting
+      // Short declared varlens live inline in the tuple; longer or
+      // unbounded ones keep the varlen pool pointer
+      if (column_length > 0 && column_length <= kMaxInlinedVarlenLength) {
+        is_inlined = true;
+      }
+      break;
 
     default:
       is_inlined = true;
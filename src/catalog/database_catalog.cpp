@@ -36,6 +36,16 @@ DatabaseCatalogObject::DatabaseCatalogObject(executor::LogicalTile *tile,
       valid_table_objects(false),
       txn(txn) {}
 
+DatabaseCatalogObject::DatabaseCatalogObject(
+    const std::vector<type::Value> &row, concurrency::TransactionContext *txn)
+    : database_oid(
+          row[DatabaseCatalog::ColumnId::DATABASE_OID].GetAs<oid_t>()),
+      database_name(row[DatabaseCatalog::ColumnId::DATABASE_NAME].ToString()),
+      table_objects_cache(),
+      table_name_cache(),
+      valid_table_objects(false),
+      txn(txn) {}
+
 /* @brief   insert table catalog object into cache
  * @param   table_object
  * @return  false if table_name already exists in cache
@@ -293,19 +303,18 @@ std::shared_ptr<DatabaseCatalogObject> DatabaseCatalog::GetDatabaseObject(
   std::vector<type::Value> values;
   values.push_back(type::ValueFactory::GetIntegerValue(database_oid).Copy());
 
-  auto result_tiles =
-      GetResultWithIndexScan(column_ids, index_offset, values, txn);
+  auto rows = GetRowsWithIndexLookup(column_ids, index_offset, values, txn);
 
-  if (result_tiles->size() == 1 && (*result_tiles)[0]->GetTupleCount() == 1) {
+  if (rows.size() == 1) {
     auto database_object =
-        std::make_shared<DatabaseCatalogObject>((*result_tiles)[0].get(), txn);
+        std::make_shared<DatabaseCatalogObject>(rows[0], txn);
     // insert into cache
     bool success = txn->catalog_cache.InsertDatabaseObject(database_object);
     PL_ASSERT(success == true);
     (void)success;
     return database_object;
   } else {
-    LOG_DEBUG("Found %lu database tiles with oid %u", result_tiles->size(),
+    LOG_DEBUG("Found %lu database rows with oid %u", rows.size(),
               database_oid);
   }
 
@@ -333,12 +342,11 @@ std::shared_ptr<DatabaseCatalogObject> DatabaseCatalog::GetDatabaseObject(
   values.push_back(
       type::ValueFactory::GetVarcharValue(database_name, nullptr).Copy());
 
-  auto result_tiles =
-      GetResultWithIndexScan(column_ids, index_offset, values, txn);
+  auto rows = GetRowsWithIndexLookup(column_ids, index_offset, values, txn);
 
-  if (result_tiles->size() == 1 && (*result_tiles)[0]->GetTupleCount() == 1) {
+  if (rows.size() == 1) {
     auto database_object =
-        std::make_shared<DatabaseCatalogObject>((*result_tiles)[0].get(), txn);
+        std::make_shared<DatabaseCatalogObject>(rows[0], txn);
     if (database_object) {
       // insert into cache
       bool success = txn->catalog_cache.InsertDatabaseObject(database_object);
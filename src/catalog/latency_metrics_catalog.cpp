@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_metrics_catalog.cpp
+//
+// Identification: src/catalog/latency_metrics_catalog.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/latency_metrics_catalog.h"
+
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace catalog {
+
+LatencyMetricsCatalog *LatencyMetricsCatalog::GetInstance(
+    concurrency::TransactionContext *txn) {
+  static LatencyMetricsCatalog latency_metrics_catalog{txn};
+  return &latency_metrics_catalog;
+}
+
+LatencyMetricsCatalog::LatencyMetricsCatalog(
+    concurrency::TransactionContext *txn)
+    : AbstractCatalog("CREATE TABLE " CATALOG_DATABASE_NAME
+                      "." LATENCY_METRICS_CATALOG_NAME
+                      " ("
+                      "query_type  VARCHAR NOT NULL, "
+                      "count       INT NOT NULL, "
+                      "p50_ms      DECIMAL NOT NULL, "
+                      "p95_ms      DECIMAL NOT NULL, "
+                      "p99_ms      DECIMAL NOT NULL, "
+                      "p999_ms     DECIMAL NOT NULL, "
+                      "max_ms      DECIMAL NOT NULL, "
+                      "time_stamp  INT NOT NULL);",
+                      txn) {
+  // Add secondary index here if necessary
+}
+
+LatencyMetricsCatalog::~LatencyMetricsCatalog() {}
+
+bool LatencyMetricsCatalog::InsertLatencyMetrics(
+    const std::string &query_type, int64_t count, double p50_ms, double p95_ms,
+    double p99_ms, double p999_ms, double max_ms, int64_t time_stamp,
+    type::AbstractPool *pool, concurrency::TransactionContext *txn) {
+  std::unique_ptr<storage::Tuple> tuple(
+      new storage::Tuple(catalog_table_->GetSchema(), true));
+
+  auto val0 = type::ValueFactory::GetVarcharValue(query_type, pool);
+  auto val1 = type::ValueFactory::GetIntegerValue(count);
+  auto val2 = type::ValueFactory::GetDecimalValue(p50_ms);
+  auto val3 = type::ValueFactory::GetDecimalValue(p95_ms);
+  auto val4 = type::ValueFactory::GetDecimalValue(p99_ms);
+  auto val5 = type::ValueFactory::GetDecimalValue(p999_ms);
+  auto val6 = type::ValueFactory::GetDecimalValue(max_ms);
+  auto val7 = type::ValueFactory::GetIntegerValue(time_stamp);
+
+  tuple->SetValue(ColumnId::QUERY_TYPE, val0, pool);
+  tuple->SetValue(ColumnId::COUNT, val1, pool);
+  tuple->SetValue(ColumnId::P50_MS, val2, pool);
+  tuple->SetValue(ColumnId::P95_MS, val3, pool);
+  tuple->SetValue(ColumnId::P99_MS, val4, pool);
+  tuple->SetValue(ColumnId::P999_MS, val5, pool);
+  tuple->SetValue(ColumnId::MAX_MS, val6, pool);
+  tuple->SetValue(ColumnId::TIME_STAMP, val7, pool);
+
+  // Insert the tuple into catalog table
+  return InsertTuple(std::move(tuple), txn);
+}
+
+}  // namespace catalog
+}  // namespace peloton
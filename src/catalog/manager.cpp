@@ -14,8 +14,10 @@
 #include "common/logger.h"
 #include "catalog/manager.h"
 #include "catalog/foreign_key.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -37,28 +39,67 @@ Manager &Manager::GetInstance() {
 void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
 
-  // add/update the catalog reference to the tile group
+  // add/update the catalog reference to the tile group; the owning
+  // reference goes in first so a raw hit always has a live owner
   tile_group_locator_.Update(oid, location);
+  tile_group_raw_locator_.Update(oid, location.get());
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
-  
-  // drop the catalog reference to the tile group
+
+  // cut off new raw readers first, then retire the owning reference: raw
+  // readers inside an older epoch may still hold the pointer, so the group
+  // is only freed once every epoch active at this point has expired
+  auto tile_group = tile_group_locator_.Find(oid);
+  tile_group_raw_locator_.Erase(oid, nullptr);
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  if (tile_group != nullptr) {
+    eid_t current_eid =
+        concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+    retired_tile_groups_.Retire(std::move(tile_group), current_eid);
+  }
+}
+
+void Manager::ReplaceTileGroup(const oid_t oid,
+                               std::shared_ptr<storage::TileGroup> location) {
+
+  // publish the replacement for both reader paths (owning reference first,
+  // as in AddTileGroup), then retire the displaced group: raw readers
+  // inside an older epoch may still hold the old pointer, so it is only
+  // freed once every epoch active at this point has expired
+  auto old_tile_group = tile_group_locator_.Find(oid);
+  tile_group_locator_.Update(oid, location);
+  tile_group_raw_locator_.Update(oid, location.get());
+
+  if (old_tile_group != nullptr) {
+    eid_t current_eid =
+        concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+    retired_tile_groups_.Retire(std::move(old_tile_group), current_eid);
+  }
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
   std::shared_ptr<storage::TileGroup> location;
-  
+
   location = tile_group_locator_.Find(oid);
 
   return location;
 }
 
+storage::TileGroup *Manager::GetTileGroupRaw(const oid_t oid) {
+  return tile_group_raw_locator_.Find(oid);
+}
+
+void Manager::ReclaimRetiredTileGroups(const eid_t &expired_eid) {
+  retired_tile_groups_.Reclaim(expired_eid);
+}
+
 // used for logging test
 void Manager::ClearTileGroup() {
 
   tile_group_locator_.Clear(empty_tile_group_);
+  tile_group_raw_locator_.Clear(nullptr);
 }
 
 
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_progress_catalog.cpp
+//
+// Identification: src/catalog/query_progress_catalog.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/query_progress_catalog.h"
+
+#include "catalog/catalog.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace catalog {
+
+QueryProgressCatalog *QueryProgressCatalog::GetInstance(
+    concurrency::TransactionContext *txn) {
+  static QueryProgressCatalog query_progress_catalog{txn};
+  return &query_progress_catalog;
+}
+
+QueryProgressCatalog::QueryProgressCatalog(concurrency::TransactionContext *txn)
+    : AbstractCatalog("CREATE TABLE " CATALOG_DATABASE_NAME
+                      "." QUERY_PROGRESS_CATALOG_NAME
+                      " ("
+                      "query_id         BIGINT NOT NULL, "
+                      "query_text       VARCHAR NOT NULL, "
+                      "start_time_us    BIGINT NOT NULL, "
+                      "elapsed_us       BIGINT NOT NULL, "
+                      "rows_produced    BIGINT NOT NULL, "
+                      "phase            VARCHAR NOT NULL, "
+                      "memory_bytes     BIGINT NOT NULL, "
+                      "cancel_requested INT NOT NULL);",
+                      txn) {
+  // Add secondary index here if necessary
+  Catalog::GetInstance()->CreateIndex(
+      CATALOG_DATABASE_NAME, QUERY_PROGRESS_CATALOG_NAME, {0},
+      QUERY_PROGRESS_CATALOG_NAME "_skey0", true, IndexType::BWTREE, txn);
+}
+
+QueryProgressCatalog::~QueryProgressCatalog() {}
+
+bool QueryProgressCatalog::InsertQueryProgress(
+    uint64_t query_id, const std::string &query_text, int64_t start_time_us,
+    int64_t elapsed_us, int64_t rows_produced, const std::string &phase,
+    int64_t memory_bytes, bool cancel_requested, type::AbstractPool *pool,
+    concurrency::TransactionContext *txn) {
+  std::unique_ptr<storage::Tuple> tuple(
+      new storage::Tuple(catalog_table_->GetSchema(), true));
+
+  auto val0 = type::ValueFactory::GetBigIntValue(query_id);
+  auto val1 = type::ValueFactory::GetVarcharValue(query_text, pool);
+  auto val2 = type::ValueFactory::GetBigIntValue(start_time_us);
+  auto val3 = type::ValueFactory::GetBigIntValue(elapsed_us);
+  auto val4 = type::ValueFactory::GetBigIntValue(rows_produced);
+  auto val5 = type::ValueFactory::GetVarcharValue(phase, pool);
+  auto val6 = type::ValueFactory::GetBigIntValue(memory_bytes);
+  auto val7 = type::ValueFactory::GetIntegerValue(cancel_requested ? 1 : 0);
+
+  tuple->SetValue(ColumnId::QUERY_ID, val0, pool);
+  tuple->SetValue(ColumnId::QUERY_TEXT, val1, pool);
+  tuple->SetValue(ColumnId::START_TIME_US, val2, pool);
+  tuple->SetValue(ColumnId::ELAPSED_US, val3, pool);
+  tuple->SetValue(ColumnId::ROWS_PRODUCED, val4, pool);
+  tuple->SetValue(ColumnId::PHASE, val5, pool);
+  tuple->SetValue(ColumnId::MEMORY_BYTES, val6, pool);
+  tuple->SetValue(ColumnId::CANCEL_REQUESTED, val7, pool);
+
+  // Insert the tuple
+  return InsertTuple(std::move(tuple), txn);
+}
+
+bool QueryProgressCatalog::DeleteQueryProgress(
+    uint64_t query_id, concurrency::TransactionContext *txn) {
+  oid_t index_offset = IndexId::SECONDARY_KEY_0;  // Primary key index
+
+  std::vector<type::Value> values;
+  values.push_back(type::ValueFactory::GetBigIntValue(query_id).Copy());
+
+  return DeleteWithIndexScan(index_offset, values, txn);
+}
+
+}  // namespace catalog
+}  // namespace peloton
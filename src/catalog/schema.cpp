@@ -15,6 +15,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "catalog/tuple_accessor.h"
 #include "common/macros.h"
 
 namespace peloton {
@@ -50,6 +51,9 @@ void Schema::CreateTupleSchema(
 
   column_count = columns.size();
   uninlined_column_count = uninlined_columns.size();
+
+  // The layout is now fixed, so pick the typed accessors for it once
+  tuple_accessor_ = std::make_shared<const TupleAccessor>(*this);
 }
 
 // Construct schema from vector of Column
@@ -41,6 +41,19 @@ TableCatalogObject::TableCatalogObject(executor::LogicalTile *tile,
       valid_column_objects(false),
       txn(txn) {}
 
+TableCatalogObject::TableCatalogObject(const std::vector<type::Value> &row,
+                                       concurrency::TransactionContext *txn)
+    : table_oid(row[TableCatalog::ColumnId::TABLE_OID].GetAs<oid_t>()),
+      table_name(row[TableCatalog::ColumnId::TABLE_NAME].ToString()),
+      database_oid(row[TableCatalog::ColumnId::DATABASE_OID].GetAs<oid_t>()),
+      index_objects(),
+      index_names(),
+      valid_index_objects(false),
+      column_objects(),
+      column_names(),
+      valid_column_objects(false),
+      txn(txn) {}
+
 /* @brief   insert index catalog object into cache
  * @param   index_object
  * @return  false if index_name already exists in cache
@@ -414,12 +427,10 @@ std::shared_ptr<TableCatalogObject> TableCatalog::GetTableObject(
   std::vector<type::Value> values;
   values.push_back(type::ValueFactory::GetIntegerValue(table_oid).Copy());
 
-  auto result_tiles =
-      GetResultWithIndexScan(column_ids, index_offset, values, txn);
+  auto rows = GetRowsWithIndexLookup(column_ids, index_offset, values, txn);
 
-  if (result_tiles->size() == 1 && (*result_tiles)[0]->GetTupleCount() == 1) {
-    auto table_object =
-        std::make_shared<TableCatalogObject>((*result_tiles)[0].get(), txn);
+  if (rows.size() == 1) {
+    auto table_object = std::make_shared<TableCatalogObject>(rows[0], txn);
     // insert into cache
     auto database_object = DatabaseCatalog::GetInstance()->GetDatabaseObject(
         table_object->GetDatabaseOid(), txn);
@@ -429,7 +440,7 @@ std::shared_ptr<TableCatalogObject> TableCatalog::GetTableObject(
     (void)success;
     return table_object;
   } else {
-    LOG_DEBUG("Found %lu table with oid %u", result_tiles->size(), table_oid);
+    LOG_DEBUG("Found %lu table with oid %u", rows.size(), table_oid);
   }
 
   // return empty object if not found
@@ -465,12 +476,10 @@ std::shared_ptr<TableCatalogObject> TableCatalog::GetTableObject(
       type::ValueFactory::GetVarcharValue(table_name, nullptr).Copy());
   values.push_back(type::ValueFactory::GetIntegerValue(database_oid).Copy());
 
-  auto result_tiles =
-      GetResultWithIndexScan(column_ids, index_offset, values, txn);
+  auto rows = GetRowsWithIndexLookup(column_ids, index_offset, values, txn);
 
-  if (result_tiles->size() == 1 && (*result_tiles)[0]->GetTupleCount() == 1) {
-    auto table_object =
-        std::make_shared<TableCatalogObject>((*result_tiles)[0].get(), txn);
+  if (rows.size() == 1) {
+    auto table_object = std::make_shared<TableCatalogObject>(rows[0], txn);
     // insert into cache
     auto database_object = DatabaseCatalog::GetInstance()->GetDatabaseObject(
         table_object->GetDatabaseOid(), txn);
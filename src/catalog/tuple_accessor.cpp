@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tuple_accessor.cpp
+//
+// Identification: src/catalog/tuple_accessor.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/tuple_accessor.h"
+
+#include "catalog/schema.h"
+
+namespace peloton {
+namespace catalog {
+
+TupleAccessor::TupleAccessor(const Schema &schema) {
+  oid_t column_count = schema.GetColumnCount();
+  columns_.resize(column_count);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column = columns_[column_itr];
+    column.offset = schema.GetOffset(column_itr);
+    column.type = schema.GetType(column_itr);
+
+    // Only inlined fixed-width columns can bypass the Type singletons
+    if (schema.IsInlined(column_itr) == false) {
+      continue;
+    }
+
+    switch (column.type) {
+      case type::TypeId::BOOLEAN:
+        column.load_function = InlinedColumnOps<type::TypeId::BOOLEAN>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::BOOLEAN>::Store;
+        break;
+      case type::TypeId::TINYINT:
+        column.load_function = InlinedColumnOps<type::TypeId::TINYINT>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::TINYINT>::Store;
+        break;
+      case type::TypeId::SMALLINT:
+        column.load_function = InlinedColumnOps<type::TypeId::SMALLINT>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::SMALLINT>::Store;
+        break;
+      case type::TypeId::INTEGER:
+        column.load_function = InlinedColumnOps<type::TypeId::INTEGER>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::INTEGER>::Store;
+        break;
+      case type::TypeId::BIGINT:
+        column.load_function = InlinedColumnOps<type::TypeId::BIGINT>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::BIGINT>::Store;
+        break;
+      case type::TypeId::DECIMAL:
+        column.load_function = InlinedColumnOps<type::TypeId::DECIMAL>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::DECIMAL>::Store;
+        break;
+      case type::TypeId::TIMESTAMP:
+        column.load_function = InlinedColumnOps<type::TypeId::TIMESTAMP>::Load;
+        column.store_function =
+            InlinedColumnOps<type::TypeId::TIMESTAMP>::Store;
+        break;
+      case type::TypeId::DATE:
+        column.load_function = InlinedColumnOps<type::TypeId::DATE>::Load;
+        column.store_function = InlinedColumnOps<type::TypeId::DATE>::Store;
+        break;
+      default:
+        // varlen and exotic types keep the generic dispatch
+        break;
+    }
+  }
+}
+
+}  // namespace catalog
+}  // namespace peloton
@@ -53,20 +53,35 @@ DEFINE_METHOD(peloton::codegen, BufferingConsumer, BufferTuple);
 //===----------------------------------------------------------------------===//
 
 BufferingConsumer::BufferingConsumer(const std::vector<oid_t> &cols,
-                                     const planner::BindingContext &context) {
+                                     const planner::BindingContext &context)
+    : BufferingConsumer(cols, context, 0, BatchCallback{}) {}
+
+BufferingConsumer::BufferingConsumer(const std::vector<oid_t> &cols,
+                                     const planner::BindingContext &context,
+                                     size_t batch_size,
+                                     BatchCallback batch_callback)
+    : batch_callback_(std::move(batch_callback)) {
   for (oid_t col_id : cols) {
     output_ais_.push_back(context.Find(col_id));
   }
   state.output = &tuples_;
+  state.batch_size = (batch_callback_ != nullptr) ? batch_size : 0;
+  state.batch_callback = &batch_callback_;
 }
 
 // Append the array of values (i.e., a tuple) into the consumer's buffer of
-// output tuples.
+// output tuples. In streaming mode, drain the buffer through the batch
+// callback once it holds a full batch.
 void BufferingConsumer::BufferTuple(char *state, char *tuple,
                                     uint32_t num_cols) {
   BufferingState *buffer_state = reinterpret_cast<BufferingState *>(state);
   buffer_state->output->emplace_back(
       reinterpret_cast<peloton::type::Value *>(tuple), num_cols);
+  if (buffer_state->batch_size != 0 &&
+      buffer_state->output->size() >= buffer_state->batch_size) {
+    (*buffer_state->batch_callback)(*buffer_state->output);
+    buffer_state->output->clear();
+  }
 }
 
 // Create two pieces of state: a pointer to the output tuple vector and an
@@ -36,8 +36,26 @@ namespace {
 class PelotonMM : public llvm::SectionMemoryManager {
  public:
   explicit PelotonMM(
-      const std::unordered_map<std::string, CodeContext::FuncPtr> &symbols)
-      : symbols_(symbols) {}
+      const std::unordered_map<std::string, CodeContext::FuncPtr> &symbols,
+      uint64_t &memory_footprint)
+      : symbols_(symbols), memory_footprint_(memory_footprint) {}
+
+  uint8_t *allocateCodeSection(uintptr_t size, unsigned alignment,
+                               unsigned section_id,
+                               llvm::StringRef section_name) override {
+    memory_footprint_ += size;
+    return llvm::SectionMemoryManager::allocateCodeSection(
+        size, alignment, section_id, section_name);
+  }
+
+  uint8_t *allocateDataSection(uintptr_t size, unsigned alignment,
+                               unsigned section_id,
+                               llvm::StringRef section_name,
+                               bool is_read_only) override {
+    memory_footprint_ += size;
+    return llvm::SectionMemoryManager::allocateDataSection(
+        size, alignment, section_id, section_name, is_read_only);
+  }
 
 #if LLVM_VERSION_GE(4, 0)
 #define RET_TYPE llvm::JITSymbol
@@ -84,12 +102,16 @@ class PelotonMM : public llvm::SectionMemoryManager {
  private:
   // The code context
   const std::unordered_map<std::string, CodeContext::FuncPtr> &symbols_;
+
+  // Running total of section bytes allocated for the owning context
+  uint64_t &memory_footprint_;
 };
 }  // anonymous namespace
 
 /// Constructor
-CodeContext::CodeContext()
+CodeContext::CodeContext(OptimizationLevel opt_level)
     : id_(kIdCounter++),
+      opt_level_(opt_level),
       context_(nullptr),
       module_(nullptr),
       builder_(nullptr),
@@ -118,9 +140,12 @@ CodeContext::CodeContext()
   module_ = m.get();
   engine_.reset(llvm::EngineBuilder(std::move(m))
                     .setEngineKind(llvm::EngineKind::JIT)
-                    .setMCJITMemoryManager(
-                        llvm::make_unique<PelotonMM>(function_symbols_))
+                    .setMCJITMemoryManager(llvm::make_unique<PelotonMM>(
+                        function_symbols_, memory_footprint_))
                     .setMCPU(llvm::sys::getHostCPUName())
+                    .setOptLevel(opt_level_ == OptimizationLevel::kFast
+                                     ? llvm::CodeGenOpt::None
+                                     : llvm::CodeGenOpt::Default)
                     .setErrorStr(&err_str_)
                     .create());
   PL_ASSERT(engine_ != nullptr);
@@ -200,12 +225,16 @@ bool CodeContext::Compile() {
     return false;
   }
 
-  // Run the optimization passes over each function in this module
-  pass_manager_->doInitialization();
-  for (auto &func_iter : functions_) {
-    pass_manager_->run(*func_iter.first);
+  // Run the optimization passes over each function in this module. The fast
+  // tier skips IR optimization entirely; hot queries get a fully optimized
+  // recompilation later.
+  if (opt_level_ != OptimizationLevel::kFast) {
+    pass_manager_->doInitialization();
+    for (auto &func_iter : functions_) {
+      pass_manager_->run(*func_iter.first);
+    }
+    pass_manager_->doFinalization();
   }
-  pass_manager_->doFinalization();
 
   // Functions and module have been optimized, now JIT compile the module
   engine_->finalizeObject();
@@ -260,5 +289,35 @@ std::string CodeContext::GetIR() const {
   return module_str;
 }
 
+// Get the textual form of the IR with this context's id scrubbed out. The
+// module and the generated query functions are named "_<id>_..."; rewriting
+// that token makes the dump comparable across contexts, while everything
+// else — including the table and index oids the translators bake in as
+// constants — still has to match byte-for-byte. The dump is taken before
+// the optimization passes run, so the compilation tier is folded in
+// explicitly: a full-tier recompile must never pass for a fast-tier module.
+std::string CodeContext::GetCanonicalIR() const {
+  std::string ir = GetIR();
+  const std::string token = "_" + std::to_string(id_) + "_";
+  std::string canonical;
+  canonical.reserve(ir.size() + 16);
+  canonical.append("; tier ");
+  canonical.append(
+      std::to_string(static_cast<uint32_t>(opt_level_)));
+  canonical.append("\n");
+  size_t pos = 0;
+  while (true) {
+    size_t hit = ir.find(token, pos);
+    if (hit == std::string::npos) {
+      break;
+    }
+    canonical.append(ir, pos, hit - pos);
+    canonical.append("_q_");
+    pos = hit + token.size();
+  }
+  canonical.append(ir, pos, std::string::npos);
+  return canonical;
+}
+
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
@@ -15,9 +15,12 @@
 #include "codegen/proxy/storage_manager_proxy.h"
 #include "codegen/proxy/executor_context_proxy.h"
 #include "codegen/proxy/query_parameters_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
 #include "codegen/proxy/storage_manager_proxy.h"
+#include "codegen/query_cache.h"
 #include "common/logger.h"
 #include "common/timer.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
@@ -34,14 +37,17 @@ void InitializeParameterCache(CodeGen &codegen, ParameterCache &cache,
 }  // anonymous namespace
 
 // Constructor
-CompilationContext::CompilationContext(Query &query,
-                                       const QueryParametersMap &parameters_map,
-                                       QueryResultConsumer &result_consumer)
+CompilationContext::CompilationContext(
+    Query &query, const QueryParametersMap &parameters_map,
+    QueryResultConsumer &result_consumer,
+    const ParameterCache::PinnedValues *pinned_parameters)
     : query_(query),
       parameters_map_(parameters_map),
-      parameter_cache_(parameters_map_),
+      parameter_cache_(parameters_map_, pinned_parameters),
       result_consumer_(result_consumer),
-      codegen_(query_.GetCodeContext()) {
+      codegen_(query_.GetCodeContext()),
+      instrument_pipelines_(settings::SettingsManager::GetBool(
+          settings::SettingId::codegen_pipeline_metrics)) {
   // Allocate a storage manager instance in the runtime state
   auto &runtime_state = GetRuntimeState();
 
@@ -60,6 +66,10 @@ CompilationContext::CompilationContext(Query &query,
   query_parameters_state_id_ =
       runtime_state.RegisterState("queryParameters", query_parameters_type);
 
+  auto *host_pointers_type = codegen_.CharPtrType()->getPointerTo();
+  host_pointers_state_id_ =
+      runtime_state.RegisterState("hostPointers", host_pointers_type);
+
   // Let the query consumer modify the runtime state object
   result_consumer_.Prepare(*this);
 }
@@ -121,11 +131,36 @@ void CompilationContext::GeneratePlan(QueryCompiler::CompileStats *stats) {
     timer.Start();
   }
 
+  // Hand the query the host pointers its code references through the
+  // relocatable pointer table
+  query_.SetHostPointers(std::move(host_pointers_));
+
+  // Before JITing, see whether a cached query already compiled exactly this
+  // IR. Distinct plans from the same query template routinely generate
+  // byte-identical modules; adopting the donor's machine code skips
+  // compilation and keeps the instruction-cache footprint down.
+  bool adopted = false;
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::codegen_code_sharing)) {
+    CodeContext &code_context = query_.GetCodeContext();
+    std::string ir = code_context.GetCanonicalIR();
+    uint64_t ir_hash = std::hash<std::string>{}(ir);
+    auto donor = QueryCache::Instance().FindCompiledByIR(ir_hash, ir);
+    if (donor != nullptr) {
+      adopted = query_.AdoptCompiledCode(std::move(donor));
+    }
+    // Record the signature either way, so the cache can publish this query
+    // as a donor once it is added
+    query_.SetIRSignature(ir_hash, std::move(ir));
+  }
+
   // Next, we prepare the query statement with the functions we've generated
-  Query::QueryFunctions funcs = {init, plan, tear_down};
-  bool prepared = query_.Prepare(funcs);
-  if (!prepared) {
-    throw Exception{"There was an error preparing the compiled query"};
+  if (!adopted) {
+    Query::QueryFunctions funcs = {init, plan, tear_down};
+    bool prepared = query_.Prepare(funcs);
+    if (!prepared) {
+      throw Exception{"There was an error preparing the compiled query"};
+    }
   }
 
   // We're done
@@ -135,6 +170,24 @@ void CompilationContext::GeneratePlan(QueryCompiler::CompileStats *stats) {
   }
 }
 
+uint32_t CompilationContext::EmitPipelineBegin(
+    const std::string &pipeline_info) {
+  const uint32_t pipeline_id = next_pipeline_id_++;
+  if (instrument_pipelines_) {
+    codegen_.Call(RuntimeFunctionsProxy::PipelineBegin,
+                  {codegen_.Const32(pipeline_id),
+                   codegen_.ConstStringPtr(pipeline_info)});
+  }
+  return pipeline_id;
+}
+
+void CompilationContext::EmitPipelineEnd(uint32_t pipeline_id) {
+  if (instrument_pipelines_) {
+    codegen_.Call(RuntimeFunctionsProxy::PipelineEnd,
+                  {codegen_.Const32(pipeline_id)});
+  }
+}
+
 // Generate any helper functions that the query needs
 void CompilationContext::GenerateHelperFunctions() {
   // Allow each operator to initialize its state
@@ -150,6 +203,8 @@ void CompilationContext::GenerateHelperFunctions() {
     const auto &function_declaration = iter.second;
     FunctionBuilder func{cc, function_declaration};
     {
+      const uint32_t pipeline_id = EmitPipelineBegin(
+          function_declaration.GetDeclaredFunction()->getName().str());
       // Don't try to optimize this by moving the cache population outside the
       // function definition. We need the call to exist within the context of
       // the function we're generating.
@@ -157,6 +212,7 @@ void CompilationContext::GenerateHelperFunctions() {
                                GetQueryParametersPtr());
       // Let the plan produce
       Produce(plan);
+      EmitPipelineEnd(pipeline_id);
       // That's it
       func.ReturnAndFinish();
     }
@@ -176,6 +232,22 @@ llvm::Value *CompilationContext::GetQueryParametersPtr() {
   return GetRuntimeState().LoadStateValue(codegen_, query_parameters_state_id_);
 }
 
+llvm::Value *CompilationContext::LoadRelocatablePointer(
+    const void *pointer, llvm::Type *pointer_type) {
+  // Assign the pointer the next slot in the table. Translators fire in a
+  // deterministic order, so two compilations of structurally identical
+  // queries hand out the same slots.
+  uint32_t slot = static_cast<uint32_t>(host_pointers_.size());
+  host_pointers_.push_back(pointer);
+
+  llvm::Value *table =
+      GetRuntimeState().LoadStateValue(codegen_, host_pointers_state_id_);
+  llvm::Value *entry = codegen_->CreateLoad(
+      codegen_->CreateConstInBoundsGEP1_32(codegen_.CharPtrType(), table,
+                                           slot));
+  return codegen_->CreateBitCast(entry, pointer_type);
+}
+
 // Generate code for the init() function of the query
 llvm::Function *CompilationContext::GenerateInitFunction() {
   // Create function definition
@@ -216,6 +288,8 @@ llvm::Function *CompilationContext::GeneratePlanFunction(
       {"runtimeState", runtime_state.FinalizeType(codegen_)->getPointerTo()}};
   FunctionBuilder plan_func{code_context, name, codegen_.VoidType(), args};
   {
+    const uint32_t pipeline_id = EmitPipelineBegin(main_pipeline_.GetInfo());
+
     // Load the query parameter values
     InitializeParameterCache(codegen_, parameter_cache_,
                              GetQueryParametersPtr());
@@ -223,6 +297,8 @@ llvm::Function *CompilationContext::GeneratePlanFunction(
     // Generate the primary plan logic
     Produce(root);
 
+    EmitPipelineEnd(pipeline_id);
+
     // Finish the function
     plan_func.ReturnAndFinish();
   }
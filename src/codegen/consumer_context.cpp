@@ -13,6 +13,7 @@
 #include "codegen/consumer_context.h"
 
 #include "codegen/compilation_context.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
 
 namespace peloton {
 namespace codegen {
@@ -61,6 +62,10 @@ void ConsumerContext::Consume(RowBatch::Row &row) {
 
   // We're at the end of the query pipeline, we now send the output tuples
   // to the result consumer configured in the compilation context
+  if (compilation_context_.InstrumentingPipelines()) {
+    auto &codegen = GetCodeGen();
+    codegen.Call(RuntimeFunctionsProxy::PipelineRow, {});
+  }
   auto &consumer = compilation_context_.GetQueryResultConsumer();
   consumer.ConsumeResult(*this, row);
 }
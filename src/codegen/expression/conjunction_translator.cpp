@@ -12,6 +12,7 @@
 
 #include "codegen/expression/conjunction_translator.h"
 
+#include "codegen/lang/if.h"
 #include "expression/conjunction_expression.h"
 
 namespace peloton {
@@ -26,22 +27,53 @@ ConjunctionTranslator::ConjunctionTranslator(
 }
 
 // Produce the value that is the result of codegening the expression
+//
+// The right side is derived under a branch that only executes when the left
+// side has not already decided the result. Since attribute values are loaded
+// lazily at first use, the column loads feeding the right side are then
+// skipped entirely for rows the left side filtered out, which is what makes
+// selective conjunctive predicates over wide tables cheap. NULL cannot decide
+// either conjunction (NULL AND FALSE is FALSE, NULL OR TRUE is TRUE), so a
+// NULL left side still evaluates the right side.
 codegen::Value ConjunctionTranslator::DeriveValue(CodeGen &codegen,
                                                   RowBatch::Row &row) const {
   const auto &conjunction =
       GetExpressionAs<expression::ConjunctionExpression>();
   codegen::Value left = row.DeriveValue(codegen, *conjunction.GetChild(0));
-  codegen::Value right = row.DeriveValue(codegen, *conjunction.GetChild(1));
 
+  llvm::Value *left_undecided = nullptr;
   switch (conjunction.GetExpressionType()) {
     case ExpressionType::CONJUNCTION_AND:
-      return left.LogicalAnd(codegen, right);
+      // A definitively FALSE left side decides an AND
+      left_undecided =
+          codegen->CreateOr(left.GetValue(), left.IsNull(codegen));
+      break;
     case ExpressionType::CONJUNCTION_OR:
-      return left.LogicalOr(codegen, right);
+      // A definitively TRUE left side decides an OR
+      left_undecided = codegen->CreateOr(codegen->CreateNot(left.GetValue()),
+                                         left.IsNull(codegen));
+      break;
     default:
       throw Exception{"Received a non-conjunction expression type: " +
                       ExpressionTypeToString(conjunction.GetExpressionType())};
   }
+
+  codegen::Value full;
+  lang::If undecided{codegen, left_undecided, "rhs"};
+  {
+    codegen::Value right = row.DeriveValue(codegen, *conjunction.GetChild(1));
+    full = conjunction.GetExpressionType() == ExpressionType::CONJUNCTION_AND
+               ? left.LogicalAnd(codegen, right)
+               : left.LogicalOr(codegen, right);
+  }
+  undecided.EndIf();
+
+  // When the branch is skipped the left side is the result; rebuild it with
+  // the merged type so both PHI inputs agree on nullability
+  codegen::Value short_left{
+      full.GetType(), left.GetValue(), nullptr,
+      full.GetType().nullable ? left.IsNull(codegen) : nullptr};
+  return undecided.BuildPHI(full, short_left);
 }
 
 }  // namespace codegen
@@ -28,11 +28,11 @@ FunctionTranslator::FunctionTranslator(
   if (!func_expr.IsUDF()) {
     PL_ASSERT(func_expr.GetFunc().op_id != OperatorId::Invalid);
     PL_ASSERT(func_expr.GetFunc().impl != nullptr);
+  }
 
-    // Prepare each of the child expressions
-    for (uint32_t i = 0; i < func_expr.GetChildrenSize(); i++) {
-      context.Prepare(*func_expr.GetChild(i));
-    }
+  // Prepare each of the child expressions
+  for (uint32_t i = 0; i < func_expr.GetChildrenSize(); i++) {
+    context.Prepare(*func_expr.GetChild(i));
   }
 }
 
@@ -96,17 +96,21 @@ codegen::Value FunctionTranslator::DeriveValue(CodeGen &codegen,
       raw_args.push_back(args[i].GetValue());
     }
 
-    std::unique_ptr<peloton::udf::UDFHandler> udf_handler(
-        new peloton::udf::UDFHandler());
-
-    // Register function prototype in current context
-    auto *func_ptr = udf_handler->RegisterExternalFunction(codegen, func_expr);
+    // Register the function prototype in the current context, reusing the
+    // prototype when the same UDF appears more than once in the query
+    auto *func_ptr =
+        codegen.GetCodeContext().GetModule().getFunction(func_expr.GetFuncName());
+    if (func_ptr == nullptr) {
+      std::unique_ptr<peloton::udf::UDFHandler> udf_handler(
+          new peloton::udf::UDFHandler());
+      func_ptr = udf_handler->RegisterExternalFunction(codegen, func_expr);
+    }
 
     auto call_ret = codegen.CallFunc(func_ptr, raw_args);
 
-    // TODO(PP): Should be changed to accomodate any return type
-    return codegen::Value{type::Decimal::Instance(), call_ret, nullptr,
-                          nullptr};
+    // Wrap the raw return in the SQL type the UDF was declared with
+    const auto &ret_type = type::SqlType::LookupType(func_expr.GetValueType());
+    return codegen::Value{ret_type, call_ret, nullptr, nullptr};
   }
 }
 
@@ -689,6 +689,7 @@ void OAHashTable::VectorizedIterate(
 }
 
 void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+                          llvm::Value *hash,
                           const std::vector<codegen::Value> &key,
                           IterateCallback &callback) const {
   auto key_found = [&codegen, &callback, &key](llvm::Value *data_ptr) {
@@ -698,7 +699,7 @@ void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
   // It does not do anything for a key that is not found
   auto key_not_found = [](llvm::Value *data_ptr) { (void)data_ptr; };
 
-  TranslateProbing(codegen, ht_ptr, nullptr, key, key_found, key_not_found,
+  TranslateProbing(codegen, ht_ptr, hash, key, key_found, key_not_found,
                    true, false,
                    false,  // If key is missing create it in empty slot
                    false);
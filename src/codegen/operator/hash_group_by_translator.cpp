@@ -18,6 +18,7 @@
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/type/integer_type.h"
 #include "common/logger.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
@@ -257,8 +258,9 @@ uint64_t HashGroupByTranslator::EstimateHashTableSize() const {
 
 // Should this aggregation use prefetching
 bool HashGroupByTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
+  return kUsePrefetch ||
+         settings::SettingsManager::GetBool(
+             settings::SettingId::codegen_group_prefetch);
 }
 
 void HashGroupByTranslator::CollectHashKeys(
@@ -18,6 +18,7 @@
 #include "codegen/proxy/oa_hash_table_proxy.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/hash_join_plan.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
@@ -288,6 +289,16 @@ void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
   std::vector<codegen::Value> key;
   CollectKeys(row, right_key_exprs_, key);
 
+  // If the group-prefetch pass already hashed this key (and prefetched its
+  // bucket), reuse the hash so the probe resolves against warm cache lines
+  // without recomputing it
+  llvm::Value *hash = nullptr;
+  if (row.HasAttribute(&OAHashTable::kHashAI)) {
+    codegen::Value hash_val =
+        row.DeriveValue(GetCodeGen(), &OAHashTable::kHashAI);
+    hash = hash_val.GetValue();
+  }
+
   if (GetJoinPlan().IsBloomFilterEnabled()) {
     // Prefilter the tuple using Bloom Filter
     llvm::Value *contains = bloom_filter_.Contains(
@@ -297,22 +308,22 @@ void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
     {
       // For each tuple that passes the bloom filter, probe the hash table
       // to eliminate the false positives.
-      CodegenHashProbe(context, row, key);
+      CodegenHashProbe(context, row, hash, key);
     }
     is_valid_row.EndIf();
   } else {
     // Bloom filter is not enabled. Directly probe the hash table
-    CodegenHashProbe(context, row, key);
+    CodegenHashProbe(context, row, hash, key);
   }
 }
 
 void HashJoinTranslator::CodegenHashProbe(
-    ConsumerContext &context, RowBatch::Row &row,
+    ConsumerContext &context, RowBatch::Row &row, llvm::Value *hash,
     std::vector<codegen::Value> &key) const {
   if (GetJoinPlan().GetJoinType() == JoinType::INNER) {
     // For inner joins, find all join partners
     ProbeRight probe_right{*this, context, row, key};
-    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), key,
+    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), hash, key,
                         probe_right);
   }
 }
@@ -350,6 +361,10 @@ std::string HashJoinTranslator::GetName() const {
       name.append("Semi");
       break;
     }
+    case JoinType::ANTI: {
+      name.append("Anti");
+      break;
+    }
     case JoinType::INVALID:
       throw Exception{"Invalid join type"};
   }
@@ -370,10 +385,11 @@ uint64_t HashJoinTranslator::EstimateCardinalityLeft() const {
   return (uint64_t)GetJoinPlan().GetChild(0)->GetCardinality();
 }
 
-// Should this aggregation use prefetching
+// Should this join use group prefetching
 bool HashJoinTranslator::UsePrefetching() const {
-  // TODO: Implement me
-  return kUsePrefetch;
+  return kUsePrefetch ||
+         settings::SettingsManager::GetBool(
+             settings::SettingId::codegen_group_prefetch);
 }
 
 void HashJoinTranslator::CollectKeys(
@@ -75,9 +75,8 @@ void TableScanTranslator::Produce() const {
 
   auto predicate = const_cast<expression::AbstractExpression *>(
       GetScanPlan().GetPredicate());
-  llvm::Value *predicate_ptr = codegen->CreateIntToPtr(
-      codegen.Const64((int64_t)predicate),
-      AbstractExpressionProxy::GetType(codegen)->getPointerTo());
+  llvm::Value *predicate_ptr = GetCompilationContext().LoadRelocatablePointer(
+      predicate, AbstractExpressionProxy::GetType(codegen)->getPointerTo());
   size_t num_preds = 0;
 
   auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
@@ -88,7 +87,8 @@ void TableScanTranslator::Produce() const {
   }
   ScanConsumer scan_consumer{*this, sel_vec};
   table_.GenerateScan(codegen, table_ptr, sel_vec.GetCapacity(), scan_consumer,
-                      predicate_ptr, num_preds);
+                      predicate_ptr, num_preds,
+                      GetCompilationContext().GetExecutorContextPtr());
   LOG_TRACE("TableScan on [%u] finished producing tuples ...", table.GetOid());
 }
 
@@ -65,8 +65,8 @@ void UpdateTranslator::InitializeState() {
   // Get the target list's raw vectors and their sizes
   // : this is required when installing a new version at updater
   const auto *project_info = update_plan_.GetProjectInfo();
-  llvm::Value *target_vector_ptr = codegen->CreateIntToPtr(
-      codegen.Const64((int64_t)project_info->GetTargetList().data()),
+  llvm::Value *target_vector_ptr = context.LoadRelocatablePointer(
+      project_info->GetTargetList().data(),
       TargetProxy::GetType(codegen)->getPointerTo());
   llvm::Value *target_vector_size_ptr =
       codegen.Const32((int32_t)project_info->GetTargetList().size());
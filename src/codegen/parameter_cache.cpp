@@ -17,6 +17,7 @@
 #include "codegen/proxy/query_parameters_proxy.h"
 #include "codegen/type/sql_type.h"
 #include "codegen/type/type.h"
+#include "type/value_peeker.h"
 
 namespace peloton {
 namespace codegen {
@@ -28,6 +29,14 @@ void ParameterCache::Populate(CodeGen &codegen,
     auto &parameter = parameters[i];
     auto type_id = parameter.GetValueType();
     auto is_nullable = parameter.IsNullable();
+    // Pinned parameters become literals the optimizer can fold; everything
+    // else is loaded from the runtime parameter storage as usual
+    auto pinned = pinned_values_.find(i);
+    if (pinned != pinned_values_.end()) {
+      values_.push_back(
+          DeriveConstantValue(codegen, pinned->second, type_id, is_nullable));
+      continue;
+    }
     auto val = DeriveParameterValue(codegen, query_parameters_ptr, i,
                                     type_id, is_nullable);
     values_.push_back(val);
@@ -103,5 +112,62 @@ codegen::Value ParameterCache::DeriveParameterValue(CodeGen &codegen,
   return Value{type::Type{type_id, is_nullable}, val, len, is_null};
 }
 
+codegen::Value ParameterCache::DeriveConstantValue(
+    CodeGen &codegen, const peloton::type::Value &value,
+    peloton::type::TypeId type_id, bool is_nullable) {
+  llvm::Value *val = nullptr, *len = nullptr;
+  switch (type_id) {
+    case peloton::type::TypeId::BOOLEAN: {
+      val = codegen.ConstBool(peloton::type::ValuePeeker::PeekBoolean(value));
+      break;
+    }
+    case peloton::type::TypeId::TINYINT: {
+      val = codegen.Const8(peloton::type::ValuePeeker::PeekTinyInt(value));
+      break;
+    }
+    case peloton::type::TypeId::SMALLINT: {
+      val = codegen.Const16(peloton::type::ValuePeeker::PeekSmallInt(value));
+      break;
+    }
+    case peloton::type::TypeId::INTEGER: {
+      val = codegen.Const32(peloton::type::ValuePeeker::PeekInteger(value));
+      break;
+    }
+    case peloton::type::TypeId::BIGINT: {
+      val = codegen.Const64(peloton::type::ValuePeeker::PeekBigInt(value));
+      break;
+    }
+    case peloton::type::TypeId::DECIMAL: {
+      val = codegen.ConstDouble(peloton::type::ValuePeeker::PeekDouble(value));
+      break;
+    }
+    case peloton::type::TypeId::DATE: {
+      val = codegen.Const32(peloton::type::ValuePeeker::PeekDate(value));
+      break;
+    }
+    case peloton::type::TypeId::TIMESTAMP: {
+      val = codegen.Const64(peloton::type::ValuePeeker::PeekTimestamp(value));
+      break;
+    }
+    case peloton::type::TypeId::VARCHAR: {
+      // the string bytes are interned in the module, outliving the query
+      std::string str{peloton::type::ValuePeeker::PeekVarchar(value),
+                      value.GetLength()};
+      val = codegen.ConstStringPtr(str);
+      len = codegen.Const32(value.GetLength());
+      break;
+    }
+    default: {
+      throw Exception{"Unsupported pinned parameter value type " +
+                      TypeIdToString(type_id)};
+    }
+  }
+  llvm::Value *is_null = nullptr;
+  if (is_nullable) {
+    is_null = codegen.ConstBool(value.IsNull());
+  }
+  return Value{type::Type{type_id, is_nullable}, val, len, is_null};
+}
+
 }  // namespace codegen
 }  // namespace peloton
@@ -13,6 +13,7 @@
 #include "codegen/pipeline.h"
 
 #include "codegen/operator/operator_translator.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace codegen {
@@ -95,6 +96,12 @@ uint32_t Pipeline::GetTranslatorStage(
   return GetNumStages() - stage - 1;
 }
 
+bool Pipeline::IsParallelizable() const {
+  return parallelizable_ &&
+         settings::SettingsManager::GetBool(
+             settings::SettingId::codegen_parallel_pipelines);
+}
+
 // Get the stringified version of this pipeline
 std::string Pipeline::GetInfo() const {
   std::string result;
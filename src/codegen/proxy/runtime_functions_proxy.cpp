@@ -13,6 +13,7 @@
 #include "codegen/proxy/runtime_functions_proxy.h"
 
 #include "codegen/proxy/data_table_proxy.h"
+#include "codegen/proxy/executor_context_proxy.h"
 #include "codegen/proxy/tile_group_proxy.h"
 #include "codegen/proxy/zone_map_proxy.h"
 
@@ -31,6 +32,11 @@ DEFINE_METHOD(peloton::codegen, RuntimeFunctions, GetTileGroupLayout);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, FillPredicateArray);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowDivideByZeroException);
 DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowOverflowException);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ThrowIfQueryCanceled);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, PipelineBegin);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, PipelineRow);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, PipelineEnd);
+DEFINE_METHOD(peloton::codegen, RuntimeFunctions, ExecuteTileGroupsParallel);
 
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
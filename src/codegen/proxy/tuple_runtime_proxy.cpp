@@ -19,6 +19,7 @@ namespace peloton {
 namespace codegen {
 
 DEFINE_METHOD(peloton::codegen, TupleRuntime, CreateVarlen);
+DEFINE_METHOD(peloton::codegen, TupleRuntime, CreateInlineVarlen);
 
 }  // namespace codegen
 }  // namespace peloton
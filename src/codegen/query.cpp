@@ -20,13 +20,145 @@ namespace peloton {
 namespace codegen {
 
 // Constructor
-Query::Query(const planner::AbstractPlan &query_plan)
-    : query_plan_(query_plan) {}
+Query::Query(const planner::AbstractPlan &query_plan,
+             OptimizationLevel opt_level)
+    : query_plan_(query_plan), code_context_(opt_level) {}
+
+void Query::TierUp(std::shared_ptr<planner::AbstractPlan> optimized_plan,
+                   std::unique_ptr<Query> optimized_query) {
+  PL_ASSERT(optimized_query != nullptr);
+  PL_ASSERT(optimized_query_.load() == nullptr);
+  optimized_query_plan_ = std::move(optimized_plan);
+  optimized_query_owner_ = std::move(optimized_query);
+  optimized_query_.store(optimized_query_owner_.get(),
+                         std::memory_order_release);
+}
+
+bool Query::AdoptCompiledCode(std::shared_ptr<Query> donor) {
+  PL_ASSERT(donor != nullptr);
+  if (donor->init_func_ == nullptr || donor->plan_func_ == nullptr ||
+      donor->tear_down_func_ == nullptr) {
+    return false;
+  }
+  init_func_ = donor->init_func_;
+  plan_func_ = donor->plan_func_;
+  tear_down_func_ = donor->tear_down_func_;
+  code_donor_ = std::move(donor);
+  return true;
+}
+
+void Query::RecordParameterValues(const QueryParameters &params) {
+  const auto &values = params.GetParameterValues();
+  profile_latch_.Lock();
+  if (profile_candidates_.empty()) {
+    profile_candidates_ = values;
+    profile_votes_.assign(values.size(), 1);
+  } else if (profile_candidates_.size() == values.size()) {
+    for (uint32_t i = 0; i < values.size(); i++) {
+      auto &candidate = profile_candidates_[i];
+      bool equal = candidate.GetTypeId() == values[i].GetTypeId() &&
+                   !candidate.IsNull() && !values[i].IsNull() &&
+                   candidate.CompareEquals(values[i]) == CmpBool::TRUE;
+      if (equal) {
+        profile_votes_[i]++;
+      } else if (--profile_votes_[i] <= 0) {
+        candidate = values[i];
+        profile_votes_[i] = 1;
+      }
+    }
+  }
+  profile_samples_++;
+  profile_latch_.Unlock();
+}
+
+bool Query::HasStableParameterProfile(uint64_t min_samples,
+                                      ParameterCache::PinnedValues &pinned) {
+  profile_latch_.Lock();
+  if (profile_samples_ >= min_samples) {
+    for (uint32_t i = 0; i < profile_candidates_.size(); i++) {
+      const auto &candidate = profile_candidates_[i];
+      // Only pin types the specialized compilation can fold into literals
+      switch (candidate.GetTypeId()) {
+        case peloton::type::TypeId::BOOLEAN:
+        case peloton::type::TypeId::TINYINT:
+        case peloton::type::TypeId::SMALLINT:
+        case peloton::type::TypeId::INTEGER:
+        case peloton::type::TypeId::BIGINT:
+        case peloton::type::TypeId::DECIMAL:
+        case peloton::type::TypeId::DATE:
+        case peloton::type::TypeId::TIMESTAMP:
+        case peloton::type::TypeId::VARCHAR:
+          break;
+        default:
+          continue;
+      }
+      if (candidate.IsNull()) {
+        continue;
+      }
+      // A vote share of 90% guarantees the candidate's true share is at
+      // least 95%, since the counter is the candidate's lead over all
+      // other values combined
+      if (profile_votes_[i] > 0 &&
+          static_cast<uint64_t>(profile_votes_[i]) * 10 >=
+              profile_samples_ * 9) {
+        pinned.emplace(i, candidate);
+      }
+    }
+  }
+  profile_latch_.Unlock();
+  return !pinned.empty();
+}
+
+void Query::Specialize(std::shared_ptr<planner::AbstractPlan> specialized_plan,
+                       std::unique_ptr<Query> specialized_query,
+                       ParameterCache::PinnedValues pinned_values) {
+  PL_ASSERT(specialized_query != nullptr);
+  PL_ASSERT(specialized_query_.load() == nullptr);
+  specialized_query_plan_ = std::move(specialized_plan);
+  specialized_query_owner_ = std::move(specialized_query);
+  pinned_values_ = std::move(pinned_values);
+  specialized_query_.store(specialized_query_owner_.get(),
+                           std::memory_order_release);
+}
+
+bool Query::MatchesPinnedValues(const QueryParameters &params) const {
+  const auto &values = params.GetParameterValues();
+  for (const auto &entry : pinned_values_) {
+    if (entry.first >= values.size()) {
+      return false;
+    }
+    const auto &value = values[entry.first];
+    if (value.GetTypeId() != entry.second.GetTypeId() || value.IsNull() ||
+        value.CompareEquals(entry.second) != CmpBool::TRUE) {
+      return false;
+    }
+  }
+  return true;
+}
 
 void Query::Execute(std::unique_ptr<executor::ExecutorContext> executor_context,
                     QueryResultConsumer &consumer,
                     std::function<void(executor::ExecutionResult)> on_complete,
                     RuntimeStats *stats) {
+  // A specialized variant only serves executions whose parameters carry the
+  // values it was compiled against; everything else falls back to the
+  // parameter-generic code below
+  Query *specialized = specialized_query_.load(std::memory_order_acquire);
+  if (specialized != nullptr &&
+      MatchesPinnedValues(executor_context->GetParams())) {
+    specialized->Execute(std::move(executor_context), consumer,
+                         std::move(on_complete), stats);
+    return;
+  }
+
+  // If a fully optimized version has been swapped in, run that instead
+  Query *optimized = optimized_query_.load(std::memory_order_acquire);
+  if (optimized != nullptr) {
+    optimized->Execute(std::move(executor_context), consumer,
+                       std::move(on_complete), stats);
+    return;
+  }
+
   CodeGen codegen{GetCodeContext()};
 
   llvm::Type *runtime_state_type = runtime_state_.FinalizeType(codegen);
@@ -43,6 +175,7 @@ void Query::Execute(std::unique_ptr<executor::ExecutorContext> executor_context,
     storage::StorageManager *storage_manager;
     executor::ExecutorContext *executor_context;
     QueryParameters *query_parameters;
+    const void *const *host_pointers;
     char *consumer_arg;
     char rest[0];
   } PACKED;
@@ -52,6 +185,7 @@ void Query::Execute(std::unique_ptr<executor::ExecutorContext> executor_context,
   func_args->storage_manager = storage::StorageManager::GetInstance();
   func_args->executor_context = executor_context.get();
   func_args->query_parameters = &executor_context->GetParams();
+  func_args->host_pointers = host_pointers_.data();
   func_args->consumer_arg = consumer.GetConsumerState();
 
   // Timer
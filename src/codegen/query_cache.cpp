@@ -12,6 +12,7 @@
 
 #include "codegen/query_cache.h"
 #include "planner/delete_plan.h"
+#include "settings/settings_manager.h"
 #include "planner/insert_plan.h"
 #include "planner/seq_scan_plan.h"
 #include "planner/update_plan.h"
@@ -24,20 +25,67 @@ Query* QueryCache::Find(const std::shared_ptr<planner::AbstractPlan> &key) {
   cache_lock_.ReadLock();
   auto it = cache_map_.find(key);
   if (it == cache_map_.end()) {
+    num_misses_.fetch_add(1, std::memory_order_relaxed);
     cache_lock_.Unlock();
     return nullptr;
   }
+  num_hits_.fetch_add(1, std::memory_order_relaxed);
   query_list_.splice(query_list_.begin(), query_list_, it->second);
   auto *query = it->second->second.get();
   cache_lock_.Unlock();
   return query;
 }
 
+std::shared_ptr<Query> QueryCache::FindCompiledByIR(
+    uint64_t ir_hash, const std::string &ir_text) {
+  cache_lock_.WriteLock();
+  auto it = ir_index_.find(ir_hash);
+  if (it == ir_index_.end()) {
+    cache_lock_.Unlock();
+    return nullptr;
+  }
+  auto donor = it->second.lock();
+  if (donor == nullptr) {
+    // The cache entry is gone and nobody adopted its code; drop the stale
+    // index entry
+    ir_index_.erase(it);
+    cache_lock_.Unlock();
+    return nullptr;
+  }
+  // Guard against hash collisions: the donor only qualifies if its module
+  // dumped exactly the same canonical text
+  if (donor->GetIRText() != ir_text) {
+    cache_lock_.Unlock();
+    return nullptr;
+  }
+  num_shared_.fetch_add(1, std::memory_order_relaxed);
+  cache_lock_.Unlock();
+  return donor;
+}
+
+bool QueryCache::Contains(const std::shared_ptr<planner::AbstractPlan> &key) {
+  cache_lock_.ReadLock();
+  bool found = (cache_map_.find(key) != cache_map_.end());
+  cache_lock_.Unlock();
+  return found;
+}
+
 void QueryCache::Add(const std::shared_ptr<planner::AbstractPlan> &key,
                      std::unique_ptr<Query> &&val) {
   cache_lock_.WriteLock();
-  query_list_.push_front(make_pair(key, std::move(val)));
+  std::shared_ptr<Query> query{std::move(val)};
+  memory_bytes_ += query->GetCodeContext().GetMemoryFootprint();
+  query_list_.push_front(make_pair(key, query));
   cache_map_.insert(make_pair(key, query_list_.begin()));
+  // Publish the query's IR signature so later compilations of structurally
+  // identical queries can adopt its code instead of JITing their own
+  if (!query->GetIRText().empty()) {
+    auto it = ir_index_.find(query->GetIRHash());
+    if (it == ir_index_.end() || it->second.expired()) {
+      ir_index_[query->GetIRHash()] = query;
+    }
+  }
+  EnforceBudget();
   cache_lock_.Unlock();
 }
 
@@ -45,6 +93,8 @@ void QueryCache::Clear() {
   cache_lock_.WriteLock();
   cache_map_.clear();
   query_list_.clear();
+  ir_index_.clear();
+  memory_bytes_ = 0;
   cache_lock_.Unlock();
 }
 
@@ -54,6 +104,8 @@ void QueryCache::Remove(const oid_t table_oid) {
   for (auto it = cache_map_.begin(); it != cache_map_.end(); ) {
     oid_t oid = GetOidFromPlan(*it->first.get());
     if (oid == table_oid) {
+      memory_bytes_ -= it->second->second->GetCodeContext().GetMemoryFootprint();
+      DropIRIndexEntry(it->second->second);
       query_list_.erase(it->second);
       it = cache_map_.erase(it);
     } else {
@@ -66,15 +118,40 @@ void QueryCache::Remove(const oid_t table_oid) {
 void QueryCache::Resize(size_t target_size) {
   cache_lock_.WriteLock();
   while (cache_map_.size() > target_size) {
-    auto last_it = query_list_.end();
-    last_it--;
-    cache_map_.erase(last_it->first);
-    query_list_.pop_back();
+    EvictLast();
   }
   capacity_ = target_size;
   cache_lock_.Unlock();
 }
 
+void QueryCache::EnforceBudget() {
+  size_t budget_bytes =
+      static_cast<size_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::query_cache_size_kb)) * 1024;
+  while ((capacity_ != 0 && cache_map_.size() > capacity_) ||
+         (budget_bytes != 0 && memory_bytes_ > budget_bytes &&
+          cache_map_.size() > 1)) {
+    // keep at least one entry so a single oversized query still caches
+    EvictLast();
+  }
+}
+
+void QueryCache::EvictLast() {
+  auto last_it = query_list_.end();
+  last_it--;
+  memory_bytes_ -= last_it->second->GetCodeContext().GetMemoryFootprint();
+  DropIRIndexEntry(last_it->second);
+  cache_map_.erase(last_it->first);
+  query_list_.pop_back();
+}
+
+void QueryCache::DropIRIndexEntry(const std::shared_ptr<Query> &query) {
+  auto it = ir_index_.find(query->GetIRHash());
+  if (it != ir_index_.end() && it->second.lock() == query) {
+    ir_index_.erase(it);
+  }
+}
+
 oid_t QueryCache::GetOidFromPlan(const planner::AbstractPlan &plan) const {
  switch (plan.GetPlanNodeType()) {
     case PlanNodeType::SEQSCAN: {
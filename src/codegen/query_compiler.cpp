@@ -27,12 +27,15 @@ QueryCompiler::QueryCompiler() : next_id_(0) {}
 // Compile the given query statement
 std::unique_ptr<Query> QueryCompiler::Compile(
     const planner::AbstractPlan &root, const QueryParametersMap &parameters_map,
-    QueryResultConsumer &result_consumer, CompileStats *stats) {
+    QueryResultConsumer &result_consumer, CompileStats *stats,
+    OptimizationLevel opt_level,
+    const ParameterCache::PinnedValues *pinned_parameters) {
   // The query statement we compile
-  std::unique_ptr<Query> query{new Query(root)};
+  std::unique_ptr<Query> query{new Query(root, opt_level)};
 
   // Set up the compilation context
-  CompilationContext context{*query, parameters_map, result_consumer};
+  CompilationContext context{*query, parameters_map, result_consumer,
+                             pinned_parameters};
 
   // Perform the compilation
   context.GeneratePlan(stats);
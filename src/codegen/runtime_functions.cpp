@@ -14,8 +14,19 @@
 
 #include <nmmintrin.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 #include "common/exception.h"
 #include "common/logger.h"
+#include "executor/executor_context.h"
+#include "settings/settings_manager.h"
+#include "statistics/backend_stats_context.h"
+#include "threadpool/mono_queue_pool.h"
 #include "expression/abstract_expression.h"
 #include "expression/expression_util.h"
 #include "storage/data_table.h"
@@ -121,6 +132,63 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
   }
 }
 
+namespace {
+
+// One active pipeline on this thread's instrumentation stack
+struct PipelineFrame {
+  uint32_t pipeline_id;
+  const char *pipeline_info;
+  uint64_t start_cycles;
+  uint64_t rows;
+};
+
+// Pipelines nest when a pipeline function invokes an auxiliary producer,
+// hence a stack rather than a single frame
+thread_local std::vector<PipelineFrame> pipeline_frames;
+
+// Read the CPU's cycle counter; falls back to a monotonic clock on
+// architectures without rdtsc
+inline uint64_t ReadCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+#else
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+}  // anonymous namespace
+
+void RuntimeFunctions::PipelineBegin(uint32_t pipeline_id,
+                                     const char *pipeline_info) {
+  pipeline_frames.push_back(
+      PipelineFrame{pipeline_id, pipeline_info, ReadCycleCounter(), 0});
+}
+
+void RuntimeFunctions::PipelineRow() {
+  if (pipeline_frames.empty() == false) {
+    pipeline_frames.back().rows++;
+  }
+}
+
+void RuntimeFunctions::PipelineEnd(uint32_t pipeline_id) {
+  if (pipeline_frames.empty() == true) {
+    return;
+  }
+  const PipelineFrame &frame = pipeline_frames.back();
+  PL_ASSERT(frame.pipeline_id == pipeline_id);
+  (void)pipeline_id;
+
+  const uint64_t cycles = ReadCycleCounter() - frame.start_cycles;
+  LOG_TRACE("Pipeline %u [%s]: %lu cycles, %lu rows", frame.pipeline_id,
+            frame.pipeline_info, cycles, frame.rows);
+  stats::BackendStatsContext::GetInstance()->RecordPipelineStat(
+      frame.pipeline_id, frame.pipeline_info, cycles, frame.rows);
+  pipeline_frames.pop_back();
+}
+
 void RuntimeFunctions::ThrowDivideByZeroException() {
   throw DivideByZeroException("ERROR: division by zero");
 }
@@ -129,5 +197,69 @@ void RuntimeFunctions::ThrowOverflowException() {
   throw std::overflow_error("ERROR: overflow");
 }
 
+void RuntimeFunctions::ThrowIfQueryCanceled(
+    executor::ExecutorContext *executor_context) {
+  PL_ASSERT(executor_context != nullptr);
+  executor_context->ThrowIfExecutionAborted();
+}
+
+namespace {
+
+// Tile groups handed to a worker per cursor bump. Coarse enough to
+// amortize the atomic, fine enough to load-balance a skewed scan
+constexpr uint64_t kMorselTileGroups = 4;
+
+}  // namespace
+
+void RuntimeFunctions::ExecuteTileGroupsParallel(storage::DataTable *table,
+                                                 void *runtime_state,
+                                                 MorselFunction morsel_func) {
+  PL_ASSERT(table != nullptr && morsel_func != nullptr);
+  const uint64_t tile_group_count = table->GetTileGroupCount();
+
+  size_t worker_pool_size = static_cast<size_t>(settings::SettingsManager::
+      GetInt(settings::SettingId::monoqueue_worker_pool_size));
+  size_t num_workers = std::min<size_t>(
+      worker_pool_size, (tile_group_count + kMorselTileGroups - 1) /
+                            kMorselTileGroups);
+  if (num_workers <= 1) {
+    morsel_func(runtime_state, 0, tile_group_count);
+    return;
+  }
+
+  // Morsel-driven: workers pull tile group ranges off a shared cursor
+  // until the table is exhausted
+  std::atomic<uint64_t> cursor(0);
+  auto worker = [&cursor, tile_group_count, runtime_state, morsel_func]() {
+    while (true) {
+      uint64_t begin = cursor.fetch_add(kMorselTileGroups);
+      if (begin >= tile_group_count) {
+        break;
+      }
+      uint64_t end = std::min(begin + kMorselTileGroups, tile_group_count);
+      morsel_func(runtime_state, begin, end);
+    }
+  };
+
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  // Workers dispatched to the pool; this thread handles worker slot zero
+  uint32_t workers_left = static_cast<uint32_t>(num_workers) - 1;
+
+  auto &pool = threadpool::MonoQueuePool::GetInstance();
+  for (size_t worker_itr = 1; worker_itr < num_workers; worker_itr++) {
+    pool.SubmitTask([&worker, &done_mutex, &done_cv, &workers_left] {
+      worker();
+      std::lock_guard<std::mutex> lock(done_mutex);
+      workers_left--;
+      done_cv.notify_one();
+    });
+  }
+  worker();
+
+  std::unique_lock<std::mutex> lock(done_mutex);
+  done_cv.wait(lock, [&workers_left] { return workers_left == 0; });
+}
+
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
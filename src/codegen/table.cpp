@@ -57,6 +57,7 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 // num_tile_groups = GetTileGroupCount(table_ptr)
 //
 // for (; tile_group_idx < num_tile_groups; ++tile_group_idx) {
+//   ThrowIfQueryCanceled(executor_context)
 //   if (ShouldScanTileGroup(predicate_array, tile_group_idx)) {
 //      tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
 //      consumer.TileGroupStart(tile_group_ptr);
@@ -69,8 +70,8 @@ llvm::Value *Table::GetZoneMapManager(CodeGen &codegen) const {
 // @endcode
 void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                          uint32_t batch_size, ScanCallback &consumer,
-                         llvm::Value *predicate_ptr,
-                         size_t num_predicates) const {
+                         llvm::Value *predicate_ptr, size_t num_predicates,
+                         llvm::Value *executor_context_ptr) const {
   // Allocate some space for the column layouts
   const auto num_columns =
       static_cast<uint32_t>(table_.GetSchema()->GetColumnCount());
@@ -97,6 +98,13 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
   {
     // Get the tile group with the given tile group ID
     tile_group_idx = loop.GetLoopVar(0);
+
+    // Cancellation point: a tile group is the compiled scan's morsel, so a
+    // kill_query() or an expired statement timeout gets one cheap poll per
+    // tile group and never interrupts work mid-tuple
+    codegen.Call(RuntimeFunctionsProxy::ThrowIfQueryCanceled,
+                 {executor_context_ptr});
+
     llvm::Value *tile_group_ptr =
         GetTileGroup(codegen, table_ptr, tile_group_idx);
     llvm::Value *tile_group_id =
@@ -18,6 +18,7 @@
 #include "codegen/type/sql_type.h"
 #include "codegen/type/type.h"
 #include "codegen/value.h"
+#include "type/limits.h"
 
 namespace peloton {
 namespace codegen {
@@ -37,7 +38,26 @@ void TableStorage::StoreValues(CodeGen &codegen, llvm::Value *tuple_ptr,
     auto offset = schema_.GetOffset(i);
     auto *ptr = codegen->CreateConstInBoundsGEP1_32(codegen.ByteType(),
                                                     tuple_ptr, offset);
-    if (sql_type.IsVariableLength()) {
+    if (sql_type.IsVariableLength() && schema_.GetColumn(i).IsInlined()) {
+      // Inlined varlen: write the length prefix and the bytes straight into
+      // the tuple; NULL stores the length sentinel alone
+      PL_ASSERT(value.GetLength() != nullptr);
+      auto *len_ptr =
+          codegen->CreateBitCast(ptr, codegen.Int32Type()->getPointerTo());
+      lang::If value_is_null{codegen, value.IsNull(codegen)};
+      {
+        codegen->CreateStore(
+            codegen.Const32(
+                static_cast<int32_t>(peloton::type::PELOTON_VALUE_NULL)),
+            len_ptr);
+      }
+      value_is_null.ElseBlock();
+      {
+        codegen.Call(TupleRuntimeProxy::CreateInlineVarlen,
+                     {value.GetValue(), value.GetLength(), ptr});
+      }
+      value_is_null.EndIf();
+    } else if (sql_type.IsVariableLength()) {
       PL_ASSERT(value.GetLength() != nullptr);
       auto val_ptr = codegen->CreateBitCast(ptr, val_type);
       lang::If value_is_null{codegen, value.IsNull(codegen)};
@@ -19,6 +19,7 @@
 #include "codegen/scan_callback.h"
 #include "codegen/proxy/tile_group_proxy.h"
 #include "codegen/varlen.h"
+#include "type/limits.h"
 #include "codegen/vector.h"
 #include "codegen/lang/vectorized_loop.h"
 #include "codegen/type/boolean_type.h"
@@ -127,7 +128,21 @@ codegen::Value TileGroup::LoadColumn(
   const auto &sql_type = type::SqlType::LookupType(column.GetType());
 
   // Check if it's a string or numeric value
-  if (sql_type.IsVariableLength()) {
+  if (sql_type.IsVariableLength() && column.IsInlined()) {
+    // Inlined varlen: the length prefix and the bytes sit directly in the
+    // tile, so no pointer needs to be chased
+    auto *len_ptr = codegen->CreateBitCast(
+        col_address, codegen.Int32Type()->getPointerTo());
+    length = codegen->CreateLoad(len_ptr);
+    val = codegen->CreateConstInBoundsGEP1_32(codegen.ByteType(), col_address,
+                                              sizeof(uint32_t));
+    if (is_nullable) {
+      is_null = codegen->CreateICmpEQ(
+          length,
+          codegen.Const32(
+              static_cast<int32_t>(peloton::type::PELOTON_VALUE_NULL)));
+    }
+  } else if (sql_type.IsVariableLength()) {
     auto *varlen_type = VarlenProxy::GetType(codegen);
     auto *varlen_ptr_ptr = codegen->CreateBitCast(
         col_address, varlen_type->getPointerTo()->getPointerTo());
@@ -31,5 +31,10 @@ void TupleRuntime::CreateVarlen(char *data, uint32_t len, char *buf,
   *reinterpret_cast<varlen_t **>(buf) = area;
 }
 
+void TupleRuntime::CreateInlineVarlen(char *data, uint32_t len, char *buf) {
+  PL_MEMCPY(buf, &len, sizeof(uint32_t));
+  PL_MEMCPY(buf + sizeof(uint32_t), data, len);
+}
+
 }  // namespace codegen
 }  // namespace peloton
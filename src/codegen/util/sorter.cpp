@@ -12,7 +12,10 @@
 
 #include "codegen/util/sorter.h"
 
+#include <algorithm>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 #include "common/logger.h"
 #include "common/timer.h"
@@ -78,15 +81,137 @@ void Sorter::Sort() {
   Timer<std::milli> timer;
   timer.Start();
 
-  // Sort the sucker
-  std::qsort(buffer_start_, num_tuples, tuple_size_,
-             reinterpret_cast<int (*)(const void *, const void *)>(cmp_func_));
+  if (num_tuples < kParallelSortThreshold ||
+      std::thread::hardware_concurrency() <= 1) {
+    // Sort the sucker
+    std::qsort(
+        buffer_start_, num_tuples, tuple_size_,
+        reinterpret_cast<int (*)(const void *, const void *)>(cmp_func_));
+  } else {
+    ParallelSort();
+  }
 
   timer.Stop();
 
   LOG_DEBUG("Sorted %llu tuples in %.2f ms", num_tuples, timer.GetDuration());
 }
 
+// Split the buffer into equal contiguous runs, sort each run on its own
+// worker thread, then merge the runs pairwise over multiple rounds. Each
+// round's merges are independent and also run in parallel, ping-ponging
+// between the tuple buffer and one scratch buffer of equal size. At the end
+// the fully merged result is made the sorter's buffer, so iteration remains
+// a walk over contiguous memory.
+void Sorter::ParallelSort() {
+  uint64_t num_tuples = GetNumTuples();
+
+  uint64_t num_workers = std::min<uint64_t>(
+      std::max(1u, std::thread::hardware_concurrency()), kMaxSortWorkers);
+  uint64_t tuples_per_run = (num_tuples + num_workers - 1) / num_workers;
+
+  // (start, tuple count) of each sorted run
+  std::vector<std::pair<char *, uint64_t>> runs;
+  for (uint64_t run_start = 0; run_start < num_tuples;
+       run_start += tuples_per_run) {
+    uint64_t run_count = std::min(tuples_per_run, num_tuples - run_start);
+    runs.emplace_back(buffer_start_ + run_start * tuple_size_, run_count);
+  }
+
+  // Sort each run in parallel
+  {
+    std::vector<std::thread> workers;
+    for (const auto &run : runs) {
+      workers.emplace_back([this, run]() {
+        std::qsort(
+            run.first, run.second, tuple_size_,
+            reinterpret_cast<int (*)(const void *, const void *)>(cmp_func_));
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  if (runs.size() == 1) {
+    return;
+  }
+
+  // Merge rounds, ping-ponging between the buffer and the scratch space
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  char *scratch = reinterpret_cast<char *>(
+      backend_manager.Allocate(BackendType::MM, GetAllocatedSpace()));
+
+  char *dest_base = scratch;
+  while (runs.size() > 1) {
+    std::vector<std::pair<char *, uint64_t>> next_runs;
+    std::vector<std::thread> workers;
+    char *dest_pos = dest_base;
+
+    for (size_t run_itr = 0; run_itr + 1 < runs.size(); run_itr += 2) {
+      auto left = runs[run_itr];
+      auto right = runs[run_itr + 1];
+      char *dest = dest_pos;
+      dest_pos += (left.second + right.second) * tuple_size_;
+      next_runs.emplace_back(dest, left.second + right.second);
+      workers.emplace_back([this, left, right, dest]() {
+        MergeRuns(left.first, left.second, right.first, right.second, dest);
+      });
+    }
+
+    // An odd run out is copied through to the next round
+    if (runs.size() % 2 == 1) {
+      auto last = runs.back();
+      PL_MEMCPY(dest_pos, last.first, last.second * tuple_size_);
+      next_runs.emplace_back(dest_pos, last.second);
+    }
+
+    for (auto &worker : workers) {
+      worker.join();
+    }
+
+    runs = std::move(next_runs);
+    dest_base = (dest_base == scratch) ? buffer_start_ : scratch;
+  }
+
+  if (runs[0].first == buffer_start_) {
+    // final merge round landed back in the original buffer
+    backend_manager.Release(BackendType::MM, scratch);
+  } else {
+    // the scratch buffer holds the sorted result: adopt it
+    PL_ASSERT(runs[0].first == scratch);
+    char *old_buffer_start = buffer_start_;
+    uint64_t used_space = GetUsedSpace();
+    uint64_t allocated_space = GetAllocatedSpace();
+    buffer_start_ = scratch;
+    buffer_pos_ = buffer_start_ + used_space;
+    buffer_end_ = buffer_start_ + allocated_space;
+    backend_manager.Release(BackendType::MM, old_buffer_start);
+  }
+}
+
+void Sorter::MergeRuns(const char *left, uint64_t left_count,
+                       const char *right, uint64_t right_count,
+                       char *dest) const {
+  const char *left_end = left + left_count * tuple_size_;
+  const char *right_end = right + right_count * tuple_size_;
+  while (left != left_end && right != right_end) {
+    // take from the left on ties to keep the merge stable
+    if (cmp_func_(left, right) <= 0) {
+      PL_MEMCPY(dest, left, tuple_size_);
+      left += tuple_size_;
+    } else {
+      PL_MEMCPY(dest, right, tuple_size_);
+      right += tuple_size_;
+    }
+    dest += tuple_size_;
+  }
+  if (left != left_end) {
+    PL_MEMCPY(dest, left, left_end - left);
+  } else if (right != right_end) {
+    PL_MEMCPY(dest, right, right_end - right);
+  }
+}
+
 void Sorter::Clear() {
   buffer_pos_ = buffer_start_;
   num_tuples_ = 0;
@@ -31,9 +31,16 @@ class IndexMetric;
 
 class StatementCache;
 
+namespace catalog {
+struct NameCacheEntry;
+}  // namespace catalog
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 CUCKOO_MAP_TYPE::CuckooMap() {}
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+CUCKOO_MAP_TYPE::CuckooMap(size_t initial_size) : cuckoo_map(initial_size) {}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 CUCKOO_MAP_TYPE::~CuckooMap() {}
 
@@ -65,6 +72,36 @@ bool CUCKOO_MAP_TYPE::Find(const KeyType &key, ValueType &value) const {
   return status;
 }
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+size_t CUCKOO_MAP_TYPE::FindBulk(const std::vector<KeyType> &keys,
+                                 std::vector<ValueType> &values) const {
+  values.clear();
+  values.resize(keys.size());
+  size_t found_count = 0;
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    if (cuckoo_map.find(keys[key_itr], values[key_itr])) {
+      found_count++;
+    }
+  }
+  return found_count;
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+void CUCKOO_MAP_TYPE::GetSnapshot(
+    std::vector<std::pair<KeyType, ValueType>> &snapshot) {
+  snapshot.clear();
+  auto locked_table = cuckoo_map.lock_table();
+  snapshot.reserve(cuckoo_map.size());
+  for (auto &entry : locked_table) {
+    snapshot.emplace_back(entry.first, entry.second);
+  }
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+bool CUCKOO_MAP_TYPE::Reserve(size_t new_size) {
+  return cuckoo_map.reserve(new_size);
+}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 bool CUCKOO_MAP_TYPE::Contains(const KeyType &key) {
   return cuckoo_map.contains(key);
@@ -102,4 +139,7 @@ template class CuckooMap<std::shared_ptr<oid_t>, std::shared_ptr<oid_t>>;
 // Used in StatementCacheManager
 template class CuckooMap<StatementCache *, StatementCache *>;
 
+// Used in CatalogNameCache
+template class CuckooMap<std::string, std::shared_ptr<catalog::NameCacheEntry>>;
+
 }  // namespace peloton
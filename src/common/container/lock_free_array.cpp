@@ -31,25 +31,61 @@ class IndirectionArray;
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 LOCK_FREE_ARRAY_TYPE::LockFreeArray(){
-  lock_free_array.reset(new lock_free_array_t());
+  for (std::size_t segment_itr = 0; segment_itr < kSegmentCount;
+       segment_itr++) {
+    segments_[segment_itr].store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 LOCK_FREE_ARRAY_TYPE::~LockFreeArray(){
+  for (std::size_t segment_itr = 0; segment_itr < kSegmentCount;
+       segment_itr++) {
+    delete segments_[segment_itr].load(std::memory_order_relaxed);
+  }
+}
+
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+typename LOCK_FREE_ARRAY_TYPE::Segment *
+LOCK_FREE_ARRAY_TYPE::EnsureSegment(const std::size_t offset) {
+  const std::size_t segment_itr = offset >> kSegmentBits;
+  Segment *segment = segments_[segment_itr].load(std::memory_order_acquire);
+  if (segment == nullptr) {
+    // Race to publish a fresh segment; whoever loses frees its copy and
+    // adopts the winner's. Entries never relocate after this point.
+    Segment *fresh_segment = new Segment();
+    Segment *expected = nullptr;
+    if (segments_[segment_itr].compare_exchange_strong(
+            expected, fresh_segment, std::memory_order_acq_rel)) {
+      segment = fresh_segment;
+    } else {
+      delete fresh_segment;
+      segment = expected;
+    }
+  }
+  return segment;
+}
+
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+typename LOCK_FREE_ARRAY_TYPE::Segment *
+LOCK_FREE_ARRAY_TYPE::GetSegment(const std::size_t offset) const {
+  return segments_[offset >> kSegmentBits].load(std::memory_order_acquire);
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Update(const std::size_t &offset, ValueType value){
   PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Update at %lu", lock_free_array_offset.load());
-  lock_free_array->at(offset) =  value;
+  EnsureSegment(offset)->items[offset & kSegmentMask] = value;
   return true;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Append(ValueType value){
   LOG_TRACE("Appended at %lu", lock_free_array_offset.load());
-  lock_free_array->at(lock_free_array_offset++) = value;
+  const std::size_t offset = lock_free_array_offset++;
+  PL_ASSERT(offset < LOCK_FREE_ARRAY_MAX_SIZE);
+  EnsureSegment(offset)->items[offset & kSegmentMask] = value;
   return true;
 }
 
@@ -57,7 +93,7 @@ LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Erase(const std::size_t &offset, const ValueType& invalid_value){
   PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Erase at %lu", offset);
-  lock_free_array->at(offset) =  invalid_value;
+  EnsureSegment(offset)->items[offset & kSegmentMask] = invalid_value;
   return true;
 }
 
@@ -65,8 +101,12 @@ LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 ValueType LOCK_FREE_ARRAY_TYPE::Find(const std::size_t &offset) const{
   PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Find at %lu", offset);
-  auto value = lock_free_array->at(offset);
-  return value;
+  Segment *segment = GetSegment(offset);
+  if (segment == nullptr) {
+    // Nothing was ever stored in this segment
+    return ValueType();
+  }
+  return segment->items[offset & kSegmentMask];
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
@@ -81,7 +121,7 @@ ValueType LOCK_FREE_ARRAY_TYPE::FindValid(const std::size_t &offset,
   for(array_itr = 0;
       array_itr < lock_free_array_offset;
       array_itr++){
-    auto value = lock_free_array->at(array_itr);
+    auto value = Find(array_itr);
     if (value != invalid_value) {
       // Check offset
       if(valid_array_itr == offset) {
@@ -103,17 +143,24 @@ size_t LOCK_FREE_ARRAY_TYPE::GetSize() const{
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::IsEmpty() const{
-  return lock_free_array->empty();
+  return lock_free_array_offset == 0;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 void LOCK_FREE_ARRAY_TYPE::Clear(const ValueType& invalid_value) {
 
-  // Set invalid value for all elements and reset lock_free_array_offset
+  // Set invalid value for all elements and reset lock_free_array_offset.
+  // Already-published segments stay allocated for reuse.
   for(std::size_t array_itr = 0;
       array_itr < lock_free_array_offset;
       array_itr++){
-    lock_free_array->at(array_itr) = invalid_value;
+    Segment *segment = GetSegment(array_itr);
+    if (segment == nullptr) {
+      // skip the rest of the unallocated segment
+      array_itr |= kSegmentMask;
+      continue;
+    }
+    segment->items[array_itr & kSegmentMask] = invalid_value;
   }
 
   // Reset sentinel
@@ -129,7 +176,7 @@ bool LOCK_FREE_ARRAY_TYPE::Contains(const ValueType& value) {
   for(std::size_t array_itr = 0;
       array_itr < lock_free_array_offset;
       array_itr++){
-    auto array_value = lock_free_array->at(array_itr);
+    auto array_value = Find(array_itr);
     // Check array value
     if(array_value == value) {
       exists = true;
@@ -147,6 +194,8 @@ template class LockFreeArray<std::shared_ptr<index::Index>>;
 
 template class LockFreeArray<std::shared_ptr<storage::TileGroup>>;
 
+template class LockFreeArray<storage::TileGroup *>;
+
 template class LockFreeArray<std::shared_ptr<storage::Database>>;
 
 template class LockFreeArray<std::shared_ptr<storage::IndirectionArray>>;
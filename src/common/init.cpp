@@ -22,7 +22,11 @@
 #include "common/thread_pool.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/tile_group_compactor.h"
 #include "index/index.h"
+#include "brain/aux_structure_tuner.h"
+#include "brain/tiering_service.h"
+#include "index/index_consolidator.h"
 #include "settings/settings_manager.h"
 #include "threadpool/mono_queue_pool.h"
 
@@ -43,6 +47,9 @@ void PelotonInit::Initialize() {
   // start worker pool
   threadpool::MonoQueuePool::GetInstance().Startup();
 
+  // start the per-socket worker pools (no-op unless NUMA partition mode)
+  threadpool::MonoQueuePool::StartupNodeInstances();
+
   // start brain thread pool
   if (settings::SettingsManager::GetBool(settings::SettingId::brain)) {
     threadpool::MonoQueuePool::GetBrainInstance().Startup();
@@ -72,6 +79,32 @@ void PelotonInit::Initialize() {
     layout_tuner.Start();
   }
 
+  // start background index consolidator
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::index_consolidator)) {
+    auto &index_consolidator = index::IndexConsolidator::GetInstance();
+    index_consolidator.Start();
+  }
+
+  // start tile group compactor
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_compaction)) {
+    auto &tile_group_compactor = gc::TileGroupCompactor::GetInstance();
+    tile_group_compactor.Start();
+  }
+
+  // start tiering service
+  if (settings::SettingsManager::GetBool(settings::SettingId::tiering)) {
+    auto &tiering_service = brain::TieringService::GetInstance();
+    tiering_service.Start();
+  }
+
+  // start auxiliary structure tuner
+  if (settings::SettingsManager::GetBool(settings::SettingId::aux_tuner)) {
+    auto &aux_structure_tuner = brain::AuxStructureTuner::GetInstance();
+    aux_structure_tuner.Start();
+  }
+
   // Initialize catalog
   auto pg_catalog = catalog::Catalog::GetInstance();
   pg_catalog->Bootstrap();  // Additional catalogs
@@ -104,6 +137,32 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down background index consolidator
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::index_consolidator)) {
+    auto &index_consolidator = index::IndexConsolidator::GetInstance();
+    index_consolidator.Stop();
+  }
+
+  // shut down tile group compactor
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::tile_group_compaction)) {
+    auto &tile_group_compactor = gc::TileGroupCompactor::GetInstance();
+    tile_group_compactor.Stop();
+  }
+
+  // shut down tiering service
+  if (settings::SettingsManager::GetBool(settings::SettingId::tiering)) {
+    auto &tiering_service = brain::TieringService::GetInstance();
+    tiering_service.Stop();
+  }
+
+  // shut down auxiliary structure tuner
+  if (settings::SettingsManager::GetBool(settings::SettingId::aux_tuner)) {
+    auto &aux_structure_tuner = brain::AuxStructureTuner::GetInstance();
+    aux_structure_tuner.Stop();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
@@ -113,6 +172,9 @@ void PelotonInit::Shutdown() {
   // stop worker pool
   threadpool::MonoQueuePool::GetInstance().Shutdown();
 
+  // stop the per-socket worker pools (no-op unless NUMA partition mode)
+  threadpool::MonoQueuePool::ShutdownNodeInstances();
+
   // stop brain thread pool
   if (settings::SettingsManager::GetBool(settings::SettingId::brain)) {
     threadpool::MonoQueuePool::GetBrainInstance().Shutdown();
@@ -1140,6 +1140,9 @@ std::string IndexTypeToString(IndexType type) {
     case IndexType::ART: {
       return "ART";
     }
+    case IndexType::BITMAP: {
+      return "BITMAP";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for IndexType value '%d'",
@@ -1162,6 +1165,8 @@ IndexType StringToIndexType(const std::string &str) {
     return IndexType::SKIPLIST;
   } else if (upper_str == "ART") {
     return IndexType::ART;
+  } else if (upper_str == "BITMAP") {
+    return IndexType::BITMAP;
   } else {
     throw ConversionException(StringUtil::Format(
         "No IndexType conversion from string '%s'", upper_str.c_str()));
@@ -1576,6 +1581,9 @@ std::string JoinTypeToString(JoinType type) {
     case JoinType::SEMI: {
       return "SEMI";
     }
+    case JoinType::ANTI: {
+      return "ANTI";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for JoinType value '%d'",
@@ -1599,6 +1607,8 @@ JoinType StringToJoinType(const std::string &str) {
     return JoinType::OUTER;
   } else if (upper_str == "SEMI") {
     return JoinType::SEMI;
+  } else if (upper_str == "ANTI") {
+    return JoinType::ANTI;
   } else {
     throw ConversionException(StringUtil::Format(
         "No JoinType conversion from string '%s'", upper_str.c_str()));
@@ -2577,6 +2587,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LogRecordType::TUPLE_UPDATE: {
       return "TUPLE_UPDATE";
     }
+    case LogRecordType::TUPLE_UPDATE_DELTA: {
+      return "TUPLE_UPDATE_DELTA";
+    }
     case LogRecordType::EPOCH_BEGIN: {
       return "EPOCH_BEGIN";
     }
@@ -2606,6 +2619,8 @@ LogRecordType StringToLogRecordType(const std::string &str) {
     return LogRecordType::TUPLE_DELETE;
   } else if (upper_str == "TUPLE_UPDATE") {
     return LogRecordType::TUPLE_UPDATE;
+  } else if (upper_str == "TUPLE_UPDATE_DELTA") {
+    return LogRecordType::TUPLE_UPDATE_DELTA;
   } else if (upper_str == "EPOCH_BEGIN") {
     return LogRecordType::EPOCH_BEGIN;
   } else if (upper_str == "EPOCH_END") {
@@ -3090,6 +3105,8 @@ std::string OperatorIdToString(OperatorId op_id) {
       return "Like";
     case OperatorId::DateTrunc:
       return "DateTrunc";
+    case OperatorId::KillQuery:
+      return "KillQuery";
     default: {
       throw Exception{StringUtil::Format("Invalid operator ID: %u", op_id)};
     }
@@ -83,6 +83,8 @@ void Statement::SetTupleDescriptor(
 
 void Statement::SetPlanTree(std::shared_ptr<planner::AbstractPlan> plan_tree) {
   plan_tree_ = std::move(plan_tree);
+  // any cached executor tree was built for the old plan
+  ClearCachedExecutorTree();
 }
 
 void Statement::SetReferencedTables(const std::set<oid_t> table_ids) {
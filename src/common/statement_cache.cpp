@@ -13,11 +13,12 @@
 #include <unordered_set>
 
 #include "common/statement_cache.h"
+#include "common/statement_cache_manager.h"
 
 namespace peloton {
 // Add a statement to the cache
 void StatementCache::AddStatement(std::shared_ptr<Statement> stmt) {
-  UpdateFromInvalidTableQueue();
+  RefreshInvalidations();
   statement_map_[stmt->GetStatementName()] = stmt;
   for (auto table_id : stmt->GetReferencedTables()) {
     table_ref_[table_id].insert(stmt);
@@ -26,7 +27,7 @@ void StatementCache::AddStatement(std::shared_ptr<Statement> stmt) {
 
 // Get the statement by its name;
 std::shared_ptr<Statement> StatementCache::GetStatement(std::string name) {
-  UpdateFromInvalidTableQueue();
+  RefreshInvalidations();
   return statement_map_[name];
 }
 
@@ -42,31 +43,86 @@ void StatementCache::DeleteStatement(std::string name) {
   statement_map_.erase(name);
 }
 
-// Notify the Statement Cache a table id that is invalidated
+// Add a statement to the cache under a plan fingerprint
+void StatementCache::AddFingerprintedStatement(const std::string &fingerprint,
+                                               std::shared_ptr<Statement> stmt) {
+  RefreshInvalidations();
+  fingerprint_map_[fingerprint] = stmt;
+  for (auto table_id : stmt->GetReferencedTables()) {
+    table_ref_[table_id].insert(stmt);
+  }
+}
+
+// Get the statement cached under a plan fingerprint
+std::shared_ptr<Statement> StatementCache::GetStatementByFingerprint(
+    const std::string &fingerprint) {
+  RefreshInvalidations();
+  auto itr = fingerprint_map_.find(fingerprint);
+  if (itr == fingerprint_map_.end()) {
+    return nullptr;
+  }
+  return itr->second;
+}
+
+// Mark the statements referencing the invalidated table for replan
 void StatementCache::NotifyInvalidTable(oid_t table_id) {
-  invalid_table_queue_.Enqueue(table_id);
+  auto ref_itr = table_ref_.find(table_id);
+  if (ref_itr == table_ref_.end()) {
+    return;
+  }
+  for (auto &statement : ref_itr->second) {
+    statement->SetNeedsReplan(true);
+  }
 }
 
-void StatementCache::UpdateFromInvalidTableQueue() {
-  std::unordered_set<oid_t> invalid_set;
-  oid_t invalid_oid;
-  while (invalid_table_queue_.Dequeue(invalid_oid)) {
-    if (table_ref_.count(invalid_oid)) invalid_set.insert(invalid_oid);
+void StatementCache::Attach(StatementCacheManager *manager) {
+  manager_ = manager;
+  // Skip the invalidation history from before this connection existed
+  auto registry = manager_->GetInvalidationRegistry();
+  last_seen_version_ = (registry != nullptr) ? registry->version : 0;
+}
+
+void StatementCache::Detach() { manager_ = nullptr; }
+
+void StatementCache::RefreshInvalidations() {
+  if (manager_ == nullptr) {
+    return;
+  }
+  // Fast path: nothing published since we last looked
+  if (likely_branch(manager_->GetInvalidationVersion() ==
+                    last_seen_version_)) {
+    return;
   }
 
-  if (invalid_set.size()) {
-    for (oid_t id : invalid_set)
-      for (auto &statement : table_ref_[id]) statement->SetNeedsReplan(true);
+  auto registry = manager_->GetInvalidationRegistry();
+  if (registry == nullptr || registry->version == last_seen_version_) {
+    return;
   }
+
+  if (registry->base_version > last_seen_version_) {
+    // We fell behind the pruning horizon and cannot tell which tables were
+    // invalidated; conservatively replan everything we hold
+    for (auto &ref_entry : table_ref_) {
+      for (auto &statement : ref_entry.second) {
+        statement->SetNeedsReplan(true);
+      }
+    }
+  } else {
+    for (auto &entry : registry->entries) {
+      if (entry.first > last_seen_version_) {
+        NotifyInvalidTable(entry.second);
+      }
+    }
+  }
+  // Resynchronize from the snapshot, not the version hint: the hint may run
+  // ahead of the snapshot we actually applied
+  last_seen_version_ = registry->version;
 }
 
 void StatementCache::Clear() {
   statement_map_.clear();
+  fingerprint_map_.clear();
   table_ref_.clear();
-  while (!invalid_table_queue_.IsEmpty()) {
-    oid_t dummy;
-    invalid_table_queue_.Dequeue(dummy);
-  }
 }
 
 }  // namespace peloton
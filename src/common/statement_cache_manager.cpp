@@ -12,45 +12,68 @@
 
 #include "common/statement_cache_manager.h"
 
+#include "common/logger.h"
+
 namespace peloton {
 
 void StatementCacheManager::RegisterStatementCache(StatementCache *stmt_cache) {
-  statement_caches_.Insert(stmt_cache, stmt_cache);
+  stmt_cache->Attach(this);
 }
 
 void StatementCacheManager::UnRegisterStatementCache(StatementCache *stmt_cache) {
-  statement_caches_.Erase(stmt_cache);
+  stmt_cache->Detach();
 }
 
 void StatementCacheManager::InvalidateTableOid(oid_t table_id) {
-  if (statement_caches_.IsEmpty()) 
+  std::set<oid_t> table_ids = {table_id};
+  PublishInvalidations(table_ids);
+}
+
+void StatementCacheManager::InvalidateTableOids(std::set<oid_t> &table_ids) {
+  if (table_ids.empty())
     return;
 
-  // Lock the table by grabbing the iterator
-  LOG_TRACE("Locking the table to get the iterator");
-  auto iterator = statement_caches_.GetIterator();
+  PublishInvalidations(table_ids);
+}
 
-  // Iterate each plan cache
-  for (auto &iter : iterator) {
-    iter.first->NotifyInvalidTable(table_id);
-  }
-  // Automatically release the table;
+std::shared_ptr<const StatementCacheManager::InvalidationRegistry>
+StatementCacheManager::GetInvalidationRegistry() const {
+  return std::atomic_load(&registry_);
 }
 
-void StatementCacheManager::InvalidateTableOids(std::set<oid_t> &table_ids) {
-  if (table_ids.empty() || statement_caches_.IsEmpty())
-    return;
+void StatementCacheManager::PublishInvalidations(
+    const std::set<oid_t> &table_ids) {
+  write_latch_.Lock();
 
-  // Lock the table by grabbing the iterator
-  LOG_TRACE("Locking the table to get the iterator");
-  auto iterator = statement_caches_.GetIterator();
+  // Copy-on-write: the published snapshot is never mutated
+  auto new_registry = std::make_shared<InvalidationRegistry>();
+  auto old_registry = std::atomic_load(&registry_);
+  if (old_registry != nullptr) {
+    *new_registry = *old_registry;
+  }
 
-  // Iterate each plan cache and notify every table id
-  for (auto &iter : iterator) {
-    for (auto &table_id : table_ids)
-      iter.first->NotifyInvalidTable(table_id);
+  uint64_t new_version = new_registry->version + 1;
+  new_registry->version = new_version;
+  for (oid_t table_id : table_ids) {
+    new_registry->entries.emplace_back(new_version, table_id);
   }
-  // Automatically release the table;
-}
+
+  // Prune the oldest entries; caches behind the horizon replan wholesale
+  if (new_registry->entries.size() > kMaxRetainedInvalidations) {
+    size_t prune_count = new_registry->entries.size() - kMaxRetainedInvalidations;
+    new_registry->base_version = new_registry->entries[prune_count - 1].first;
+    new_registry->entries.erase(
+        new_registry->entries.begin(),
+        new_registry->entries.begin() + prune_count);
+  }
+
+  std::atomic_store(&registry_,
+                    std::shared_ptr<const InvalidationRegistry>(new_registry));
+  invalidation_version_.store(new_version, std::memory_order_relaxed);
+
+  write_latch_.Unlock();
+
+  LOG_TRACE("Published statement invalidation version %" PRIu64, new_version);
 }
- 
\ No newline at end of file
+
+}  // namespace peloton
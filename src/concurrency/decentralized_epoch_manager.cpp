@@ -22,29 +22,41 @@ namespace concurrency {
 
     PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
 
-    if (ts_type == TimestampType::SNAPSHOT_READ) {
-
-      local_epochs_.at(thread_id)->EnterEpoch(snapshot_global_epoch_id_, ts_type);
-
-      return (snapshot_global_epoch_id_ << 32) | 0x0;
-
-    } else {
-
-      while (true) {
-        uint64_t epoch_id = GetCurrentEpochId();
+    while (true) {
+      uint64_t epoch_id = (ts_type == TimestampType::SNAPSHOT_READ)
+                              ? snapshot_global_epoch_id_
+                              : GetCurrentEpochId();
+
+      // enter the corresponding local epoch.
+      bool was_parked = false;
+      bool rt = local_epochs_.at(thread_id)->EnterEpoch(epoch_id, ts_type,
+                                                        was_parked);
+
+      // if successfully entered local epoch
+      if (rt == true) {
+
+        // unpark validation: while this thread was parked the epoch
+        // reducer skipped it, so the reclamation watermark may already
+        // cover the epoch a stale read of the global epoch produced. the
+        // thread published its new lower bound inside EnterEpoch before
+        // this load, and the reducer publishes the watermark after its
+        // scan; with both sides sequentially consistent, either the
+        // reducer saw the bound or this check sees the watermark.
+        if (was_parked && ts_type != TimestampType::COMMIT &&
+            epoch_id <= published_watermark_.load()) {
+          // back out; the exit re-parks the thread
+          local_epochs_.at(thread_id)->ExitEpoch(epoch_id);
+          continue;
+        }
 
-        // enter the corresponding local epoch.
-        bool rt = local_epochs_.at(thread_id)->EnterEpoch(epoch_id, ts_type);
+        if (ts_type == TimestampType::SNAPSHOT_READ) {
+          return (epoch_id << 32) | 0x0;
+        }
 
-        // if successfully entered local epoch
-        if (rt == true) {
-      
-          uint32_t next_txn_id = GetNextTransactionId();
+        uint32_t next_txn_id = GetNextTransactionId(epoch_id);
 
-          return (epoch_id << 32) | next_txn_id;
-        }
+        return (epoch_id << 32) | next_txn_id;
       }
-
     }
   }
 
@@ -59,18 +71,71 @@ namespace concurrency {
 
 
   eid_t DecentralizedEpochManager::GetExpiredEpochId() {
-    eid_t global_expired_eid = MAX_EID;
-    
-    // for all the local epoch contexts, obtain the minimum max committed epoch id.
+    eid_t current_eid = current_global_epoch_id_.load();
+
+    // for all the local epoch contexts, collect the max committed epoch id.
+    std::vector<eid_t> local_expired_eids;
+    local_expired_eids.reserve(local_epochs_.size());
+
     for (auto &local_epoch_itr : local_epochs_) {
-      
+
+      // fast path: each local epoch publishes its lower bound into its own
+      // cache line. a thread that has already caught up with the current
+      // global epoch cannot report anything newer, so we skip its latch.
+      eid_t published_eid = local_epoch_itr.second->GetPublishedLowerBound();
+
+      // parked: the thread has no transaction in flight, so it does not
+      // constrain the horizon. idle connections are skipped here without
+      // touching their latch.
+      if (published_eid == UINT64_MAX) {
+        continue;
+      }
+
+      if (published_eid + 1 == current_eid) {
+        local_expired_eids.push_back(published_eid);
+        continue;
+      }
+
       // the centralized epoch manager must notify each local epoch
       // the current global epoch.
-      eid_t local_expired_eid = local_epoch_itr.second->GetExpiredEpochId(current_global_epoch_id_);
-      
-      if (local_expired_eid < global_expired_eid) {
-        global_expired_eid = local_expired_eid;
+      eid_t local_expired_eid =
+          local_epoch_itr.second->GetExpiredEpochId(current_eid);
+
+      // the thread drained its queue and parked itself under the latch
+      if (local_expired_eid == UINT64_MAX) {
+        continue;
       }
+
+      local_expired_eids.push_back(local_expired_eid);
+    }
+
+    // pairwise tree-reduce the collected ids to the minimum.
+    size_t count = local_expired_eids.size();
+    while (count > 1) {
+      size_t half = (count + 1) >> 1;
+      for (size_t i = 0; i + half < count; i++) {
+        if (local_expired_eids[i + half] < local_expired_eids[i]) {
+          local_expired_eids[i] = local_expired_eids[i + half];
+        }
+      }
+      count = half;
+    }
+
+    // with every thread parked nothing constrains the horizon; everything
+    // before the running epoch is reclaimable. the same clamp bounds the
+    // result when threads report from epochs at or past the running one.
+    eid_t global_expired_eid =
+        (count == 0) ? current_eid - 1 : local_expired_eids[0];
+    if (global_expired_eid >= current_eid) {
+      global_expired_eid = current_eid - 1;
+    }
+
+    // publish the watermark for the unpark handshake; it only moves
+    // forward.
+    eid_t published = published_watermark_.load();
+    while (published < global_expired_eid &&
+           !published_watermark_.compare_exchange_weak(published,
+                                                       global_expired_eid)) {
     }
 
     // if we observe that global_expired_eid is larger than snapshot_global_epoch,
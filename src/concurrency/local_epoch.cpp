@@ -17,15 +17,18 @@
 namespace peloton {
 namespace concurrency {
 
-  bool LocalEpoch::EnterEpoch(const eid_t epoch_id, const TimestampType ts_type) {
+  bool LocalEpoch::EnterEpoch(const eid_t epoch_id, const TimestampType ts_type,
+                              bool &was_parked) {
 
     epoch_lock_.Lock();
 
-    // if this thread is never used or has been GC'd
+    // if this thread is parked (never used, or idle since its last
+    // transaction exited)
     if (epoch_id_lower_bound_ == UINT64_MAX) {
 
+      was_parked = true;
       epoch_id_lower_bound_ = epoch_id - 1;
-    
+
     } else if (epoch_id_lower_bound_ >= epoch_id) {
     
       if (ts_type == TimestampType::SNAPSHOT_READ) {
@@ -58,6 +61,8 @@ namespace concurrency {
       
     }
 
+    PublishLowerBound();
+
     epoch_lock_.Unlock();
 
     return true;
@@ -81,32 +86,44 @@ namespace concurrency {
       }
     }
 
+    // the last transaction has left: park the thread so the epoch reducer
+    // stops visiting it until the next transaction enters.
+    if (epoch_queue_.size() == 0) {
+      epoch_id_lower_bound_ = UINT64_MAX;
+    }
+
+    PublishLowerBound();
+
     epoch_lock_.Unlock();
   }
 
-  uint64_t LocalEpoch::GetExpiredEpochId(const uint64_t epoch_id) {
+  uint64_t LocalEpoch::GetExpiredEpochId(const uint64_t epoch_id UNUSED_ATTRIBUTE) {
     epoch_lock_.Lock();
-    // there's no epoch in this thread.
-    // which indicates that this thread is never used or has been GC'd for some time.
-    if (epoch_queue_.size() == 0) {
-      epoch_id_lower_bound_ = epoch_id - 1;
-    } else {
-      while (epoch_queue_.size() != 0) {
-        // get the smallest epoch.
-        auto &epoch_ptr = epoch_queue_.top();
-        // if there's no transaction in the epoch
-        if (epoch_ptr->txn_count_ == 0) {
-          epoch_map_.erase(epoch_ptr->epoch_id_);
-          epoch_queue_.pop();
-        } else {
-          PL_ASSERT(epoch_ptr->epoch_id_ > epoch_id_lower_bound_);
-          epoch_id_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-          break;
-        }
+
+    while (epoch_queue_.size() != 0) {
+      // get the smallest epoch.
+      auto &epoch_ptr = epoch_queue_.top();
+      // if there's no transaction in the epoch
+      if (epoch_ptr->txn_count_ == 0) {
+        epoch_map_.erase(epoch_ptr->epoch_id_);
+        epoch_queue_.pop();
+      } else {
+        PL_ASSERT(epoch_ptr->epoch_id_ > epoch_id_lower_bound_);
+        epoch_id_lower_bound_ = epoch_ptr->epoch_id_ - 1;
+        break;
       }
     }
+
+    // there's no epoch in this thread: park it, so it neither constrains
+    // the reclamation horizon nor costs the reducer a latch next pass.
+    if (epoch_queue_.size() == 0) {
+      epoch_id_lower_bound_ = UINT64_MAX;
+    }
+
     uint64_t ret = epoch_id_lower_bound_;
-    
+
+    PublishLowerBound();
+
     epoch_lock_.Unlock();
     return ret;
   }
@@ -21,6 +21,7 @@
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager_factory.h"
 #include "settings/settings_manager.h"
+#include "storage/materialized_view_manager.h"
 
 namespace peloton {
 namespace concurrency {
@@ -221,7 +222,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
     LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
     // Check if it's select for update before we check the ownership
     // and modify the last reader cid
@@ -232,7 +233,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
       tile_group_id = location.block;
       tuple_id = location.offset;
 
-      tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+      tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
       if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
         // Acquire ownership if we haven't
@@ -288,7 +289,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
     LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
     // Check if it's select for update before we check the ownership.
     if (acquire_ownership == true) {
@@ -370,7 +371,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
     LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
     // Check if it's select for update before we check the ownership
     // and modify the last reader cid.
@@ -470,7 +471,7 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -514,9 +515,9 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   auto &manager = catalog::Manager::GetInstance();
 
   auto tile_group_header =
-      manager.GetTileGroup(old_location.block)->GetHeader();
+      manager.GetTileGroupRaw(old_location.block)->GetHeader();
   auto new_tile_group_header =
-      manager.GetTileGroup(new_location.block)->GetHeader();
+      manager.GetTileGroupRaw(new_location.block)->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
   // if we can perform update, then we must have already locked the older
@@ -593,7 +594,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   auto &manager = catalog::Manager::GetInstance();
   UNUSED_ATTRIBUTE auto tile_group_header =
-      manager.GetTileGroup(tile_group_id)->GetHeader();
+      manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -631,9 +632,9 @@ void TimestampOrderingTransactionManager::PerformDelete(
   auto &manager = catalog::Manager::GetInstance();
 
   auto tile_group_header =
-      manager.GetTileGroup(old_location.block)->GetHeader();
+      manager.GetTileGroupRaw(old_location.block)->GetHeader();
   auto new_tile_group_header =
-      manager.GetTileGroup(new_location.block)->GetHeader();
+      manager.GetTileGroupRaw(new_location.block)->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
 
@@ -710,7 +711,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -780,7 +781,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
       StatsType::INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroupRaw(rw_set.begin()->first)->GetDatabaseId();
     }
   }
 
@@ -790,7 +791,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   // 3. install a new tuple for insert operations.
   for (auto &tile_group_entry : rw_set) {
     oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
     for (auto &tuple_entry : tile_group_entry.second) {
       auto tuple_slot = tuple_entry.first;
@@ -811,7 +812,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         auto cid = tile_group_header->GetEndCommitId(tuple_slot);
         PL_ASSERT(cid > end_commit_id);
         auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+            manager.GetTileGroupRaw(new_version.block)->GetHeader();
         new_tile_group_header->SetBeginCommitId(new_version.offset,
                                                 end_commit_id);
         new_tile_group_header->SetEndCommitId(new_version.offset, cid);
@@ -841,7 +842,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         auto cid = tile_group_header->GetEndCommitId(tuple_slot);
         PL_ASSERT(cid > end_commit_id);
         auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+            manager.GetTileGroupRaw(new_version.block)->GetHeader();
         new_tile_group_header->SetBeginCommitId(new_version.offset,
                                                 end_commit_id);
         new_tile_group_header->SetEndCommitId(new_version.offset, cid);
@@ -905,6 +906,11 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
     }
   }
 
+  // fold the committed write set into any materialized views; must happen
+  // after version installation (new versions readable) and before the GC can
+  // recycle the prev-version pointers the delta application follows.
+  storage::MaterializedViewManager::GetInstance().ApplyTransactionDelta(rw_set);
+
   ResultType result = current_txn->GetResult();
 
   log_manager.LogEnd();
@@ -950,144 +956,148 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
       StatsType::INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroupRaw(rw_set.begin()->first)->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_header, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+  // Undo only the entries that left a physical trace, newest first. Plain
+  // reads never make it onto the compact write list, so aborting a large
+  // read-mostly transaction no longer walks its read set or touches the
+  // tile group headers of the tuples it merely read.
+  auto &write_set = current_txn->GetWriteSet();
+  for (auto w_itr = write_set.rbegin(); w_itr != write_set.rend(); ++w_itr) {
+    oid_t tile_group_id = w_itr->block;
+    oid_t tuple_slot = w_itr->offset;
+    auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
+    RWType rw_type = current_txn->GetRWType(*w_itr);
+
+    if (rw_type == RWType::READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_header, tuple_slot);
+    } else if (rw_type == RWType::UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
 
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
 
-        // this must be the latest version of a version chain.
-        PL_ASSERT(new_tile_group_header->GetPrevItemPointer(new_version.offset)
-                      .IsNull() == true);
+      // this must be the latest version of a version chain.
+      PL_ASSERT(new_tile_group_header->GetPrevItemPointer(new_version.offset)
+                    .IsNull() == true);
 
-        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-        // if we updated the latest version.
-        // We must first adjust the head pointer
-        // before we unlink the aborted version from version list
-        ItemPointer *index_entry_ptr =
-            tile_group_header->GetIndirection(tuple_slot);
-        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-        PL_ASSERT(res == true);
-        //////////////////////////////////////////////////
+      PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+      // if we updated the latest version.
+      // We must first adjust the head pointer
+      // before we unlink the aborted version from version list
+      ItemPointer *index_entry_ptr =
+          tile_group_header->GetIndirection(tuple_slot);
+      UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+          index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+      PL_ASSERT(res == true);
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add the version to gc set.
-        // this version has already been unlinked from the version chain.
-        // however, the gc should further unlink it from indexes.
-        gc_set->operator[](new_version.block)[new_version.offset] =
-            GCVersionType::ABORT_UPDATE;
+      // add the version to gc set.
+      // this version has already been unlinked from the version chain.
+      // however, the gc should further unlink it from indexes.
+      gc_set->operator[](new_version.block)[new_version.offset] =
+          GCVersionType::ABORT_UPDATE;
 
-      } else if (tuple_entry.second == RWType::DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+    } else if (rw_type == RWType::DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
 
-        // this must be the latest version of a version chain.
-        PL_ASSERT(new_tile_group_header->GetPrevItemPointer(new_version.offset)
-                      .IsNull() == true);
+      // this must be the latest version of a version chain.
+      PL_ASSERT(new_tile_group_header->GetPrevItemPointer(new_version.offset)
+                    .IsNull() == true);
 
-        // if we updated the latest version.
-        // We must first adjust the head pointer
-        // before we unlink the aborted version from version list
-        ItemPointer *index_entry_ptr =
-            tile_group_header->GetIndirection(tuple_slot);
-        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-        PL_ASSERT(res == true);
-        //////////////////////////////////////////////////
+      // if we updated the latest version.
+      // We must first adjust the head pointer
+      // before we unlink the aborted version from version list
+      ItemPointer *index_entry_ptr =
+          tile_group_header->GetIndirection(tuple_slot);
+      UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+          index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+      PL_ASSERT(res == true);
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add the version to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] =
-            GCVersionType::ABORT_DELETE;
+      // add the version to gc set.
+      gc_set->operator[](new_version.block)[new_version.offset] =
+          GCVersionType::ABORT_DELETE;
 
-      } else if (tuple_entry.second == RWType::INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (rw_type == RWType::INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add the version to gc set.
-        // delete from index.
-        gc_set->operator[](tile_group_id)[tuple_slot] =
-            GCVersionType::ABORT_INSERT;
+      // add the version to gc set.
+      // delete from index.
+      gc_set->operator[](tile_group_id)[tuple_slot] =
+          GCVersionType::ABORT_INSERT;
 
-      } else if (tuple_entry.second == RWType::INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (rw_type == RWType::INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] =
-            GCVersionType::ABORT_INS_DEL;
-      }
+      // add to gc set.
+      gc_set->operator[](tile_group_id)[tuple_slot] =
+          GCVersionType::ABORT_INS_DEL;
     }
   }
 
@@ -1103,5 +1113,174 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   return ResultType::ABORTED;
 }
 
+void TimestampOrderingTransactionManager::RollbackTupleEntry(
+    TransactionContext *const current_txn, const oid_t &tile_group_id,
+    const oid_t &tuple_slot, const RWType current_type,
+    const RWType restored_type) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
+  auto gc_set = current_txn->GetGCSetPtr();
+
+  if (current_type == RWType::READ) {
+    // a plain read leaves no physical trace
+    return;
+
+  } else if (current_type == RWType::READ_OWN) {
+    // ownership was acquired after the mark; give it back
+    YieldOwnership(current_txn, tile_group_header, tuple_slot);
+
+  } else if (current_type == RWType::UPDATE || current_type == RWType::DELETE) {
+    if (current_type == RWType::DELETE && restored_type == RWType::UPDATE) {
+      // A delete retyped a pre-mark update in place: its only physical
+      // trace is the end-commit mark on the transaction's own new
+      // version. Clear it and the update stands again.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      return;
+    }
+
+    // Unlink and retire the version installed after the mark, exactly as
+    // a full abort would
+    ItemPointer new_version = tile_group_header->GetPrevItemPointer(tuple_slot);
+    auto new_tile_group_header =
+        manager.GetTileGroupRaw(new_version.block)->GetHeader();
+
+    new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+    new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+    COMPILER_MEMORY_FENCE;
+
+    // this must be the latest version of a version chain.
+    PL_ASSERT(new_tile_group_header->GetPrevItemPointer(new_version.offset)
+                  .IsNull() == true);
+
+    // adjust the head pointer before unlinking the rolled-back version
+    ItemPointer *index_entry_ptr =
+        tile_group_header->GetIndirection(tuple_slot);
+    UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+        index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+    PL_ASSERT(res == true);
+
+    COMPILER_MEMORY_FENCE;
+
+    new_tile_group_header->SetTransactionId(new_version.offset,
+                                            INVALID_TXN_ID);
+
+    tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+
+    COMPILER_MEMORY_FENCE;
+
+    if (restored_type != RWType::READ_OWN) {
+      // select-for-update taken before the mark keeps its ownership;
+      // everything else releases the slot
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    }
+
+    // the version is unlinked; the gc further unlinks it from indexes
+    gc_set->operator[](new_version.block)[new_version.offset] =
+        current_type == RWType::UPDATE ? GCVersionType::ABORT_UPDATE
+                                       : GCVersionType::ABORT_DELETE;
+
+  } else if (current_type == RWType::INSERT) {
+    tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+    tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+    COMPILER_MEMORY_FENCE;
+
+    tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+
+    gc_set->operator[](tile_group_id)[tuple_slot] =
+        GCVersionType::ABORT_INSERT;
+
+  } else if (current_type == RWType::INS_DEL) {
+    if (restored_type == RWType::INSERT) {
+      // the delete's only physical trace is the end-commit mark on the
+      // transaction's own (pre-mark) insert
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      return;
+    }
+
+    tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+    tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+    COMPILER_MEMORY_FENCE;
+
+    tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+
+    gc_set->operator[](tile_group_id)[tuple_slot] =
+        GCVersionType::ABORT_INS_DEL;
+  }
+}
+
+bool TimestampOrderingTransactionManager::RollbackToSavepoint(
+    TransactionContext *const current_txn, const std::string &name) {
+  PL_ASSERT(current_txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY);
+
+  int64_t target = current_txn->FindSavepoint(name);
+  if (target < 0) {
+    return false;
+  }
+
+  LOG_TRACE("Rolling back peloton txn %" PRId64 " to savepoint %s",
+            current_txn->GetTransactionId(), name.c_str());
+
+  auto &savepoints = current_txn->GetSavepoints();
+  const auto &mark = savepoints[target];
+  auto &rw_set = current_txn->GetReadWriteSet();
+
+  auto mark_size = [&mark](oid_t tile_group_id) -> size_t {
+    auto itr = mark.bucket_sizes.find(tile_group_id);
+    return itr == mark.bucket_sizes.end() ? 0 : itr->second;
+  };
+
+  // Drop every entry recorded after the mark. The per-tile-group entry
+  // vectors are append-only, so the suffix past the mark's size is exactly
+  // the post-savepoint work.
+  for (auto &tile_group_entry : rw_set) {
+    oid_t tile_group_id = tile_group_entry.first;
+    auto &bucket = tile_group_entry.second;
+    for (auto itr = bucket.begin() + mark_size(tile_group_id);
+         itr != bucket.end(); ++itr) {
+      RollbackTupleEntry(current_txn, tile_group_id, itr->first, itr->second,
+                         RWType::INVALID);
+    }
+  }
+
+  // Restore pre-mark entries that were retyped in place after the mark,
+  // newest change first so a chain like READ -> READ_OWN -> UPDATE unwinds
+  // one step at a time
+  for (int64_t sp = static_cast<int64_t>(savepoints.size()) - 1; sp >= target;
+       sp--) {
+    const auto &retyped = savepoints[sp].retyped;
+    for (auto r_itr = retyped.rbegin(); r_itr != retyped.rend(); ++r_itr) {
+      const ItemPointer &location = r_itr->first;
+      const RWType restored = r_itr->second;
+
+      auto bucket_itr = rw_set.find(location.block);
+      PL_ASSERT(bucket_itr != rw_set.end());
+      const auto &bucket = bucket_itr->second;
+      auto entry_itr = bucket.find(location.offset);
+      PL_ASSERT(entry_itr != bucket.end());
+
+      // entries recorded after the mark were already dropped above
+      if (static_cast<size_t>(entry_itr - bucket.begin()) >=
+          mark_size(location.block)) {
+        continue;
+      }
+
+      RollbackTupleEntry(current_txn, location.block, location.offset,
+                         entry_itr->second, restored);
+      current_txn->RestoreRWType(location, restored);
+    }
+  }
+
+  current_txn->TruncateToSavepoint(target);
+
+  return true;
+}
+
 }  // namespace storage
 }  // namespace peloton
\ No newline at end of file
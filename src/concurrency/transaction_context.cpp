@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
 #include "trigger/trigger.h"
 
 #include <chrono>
@@ -26,6 +27,92 @@
 namespace peloton {
 namespace concurrency {
 
+namespace {
+
+// Recycling pool for transaction contexts. Every transaction creates and
+// destroys one context, so allocating them from the heap each time is pure
+// churn. Each thread keeps a small cache of retired contexts; overflow and
+// refill go through a latch-protected shared list so contexts retired on a
+// GC thread can be reused by worker threads.
+class TransactionContextPool {
+ public:
+  // Maximum number of contexts cached per thread before spilling to the
+  // shared list.
+  static const size_t kLocalCacheSize = 32;
+
+  ~TransactionContextPool() {
+    for (auto txn : shared_pool_) {
+      ::delete txn;
+    }
+  }
+
+  TransactionContext *Pop() {
+    auto &cache = GetLocalCache();
+    if (cache.contexts.empty()) {
+      Refill(cache.contexts);
+    }
+    if (cache.contexts.empty()) {
+      return nullptr;
+    }
+    TransactionContext *txn = cache.contexts.back();
+    cache.contexts.pop_back();
+    return txn;
+  }
+
+  void Push(TransactionContext *txn) {
+    auto &cache = GetLocalCache();
+    cache.contexts.push_back(txn);
+    if (cache.contexts.size() > kLocalCacheSize) {
+      Spill(cache.contexts);
+    }
+  }
+
+ private:
+  struct LocalCache {
+    std::vector<TransactionContext *> contexts;
+
+    ~LocalCache() {
+      for (auto txn : contexts) {
+        ::delete txn;
+      }
+    }
+  };
+
+  LocalCache &GetLocalCache() {
+    static thread_local LocalCache cache;
+    return cache;
+  }
+
+  // Move up to half a cache's worth of contexts from the shared list.
+  void Refill(std::vector<TransactionContext *> &contexts) {
+    shared_pool_latch_.Lock();
+    size_t count = std::min(shared_pool_.size(), kLocalCacheSize / 2);
+    while (count > 0) {
+      contexts.push_back(shared_pool_.back());
+      shared_pool_.pop_back();
+      count--;
+    }
+    shared_pool_latch_.Unlock();
+  }
+
+  // Move half of the local cache to the shared list.
+  void Spill(std::vector<TransactionContext *> &contexts) {
+    shared_pool_latch_.Lock();
+    while (contexts.size() > kLocalCacheSize / 2) {
+      shared_pool_.push_back(contexts.back());
+      contexts.pop_back();
+    }
+    shared_pool_latch_.Unlock();
+  }
+
+  std::vector<TransactionContext *> shared_pool_;
+  common::synchronization::SpinLatch shared_pool_latch_;
+};
+
+TransactionContextPool txn_context_pool;
+
+}  // namespace
+
 /*
  * TransactionContext state transition:
  *                r           r/ro            u/r/ro
@@ -62,6 +149,40 @@ TransactionContext::TransactionContext(const size_t thread_id,
 
 TransactionContext::~TransactionContext() {}
 
+TransactionContext *TransactionContext::GetInstance(
+    const size_t thread_id, const IsolationLevelType isolation,
+    const cid_t &read_id) {
+  return GetInstance(thread_id, isolation, read_id, read_id);
+}
+
+TransactionContext *TransactionContext::GetInstance(
+    const size_t thread_id, const IsolationLevelType isolation,
+    const cid_t &read_id, const cid_t &commit_id) {
+  TransactionContext *txn = txn_context_pool.Pop();
+  if (txn == nullptr) {
+    return new TransactionContext(thread_id, isolation, read_id, commit_id);
+  }
+  txn->Init(thread_id, isolation, read_id, commit_id);
+  return txn;
+}
+
+void TransactionContext::RecycleInstance(TransactionContext *txn) {
+  // clear() keeps the containers' bucket arrays and capacity around, which
+  // is the whole point of recycling: the next transaction served by this
+  // context records its read/write set without rehashing from scratch.
+  txn->rw_set_.clear();
+  txn->write_set_.clear();
+  txn->rw_object_set_.clear();
+  txn->savepoints_.clear();
+  txn->query_strings_.clear();
+  txn->catalog_cache.Clear();
+  txn->result_ = ResultType::SUCCESS;
+  txn->gc_set_.reset();
+  txn->gc_object_set_.reset();
+  txn->on_commit_triggers_.reset();
+  txn_context_pool.Push(txn);
+}
+
 void TransactionContext::Init(const size_t thread_id,
                        const IsolationLevelType isolation, const cid_t &read_id,
                        const cid_t &commit_id) {
@@ -125,13 +246,16 @@ void TransactionContext::RecordReadOwn(const ItemPointer &location) {
   if (IsInRWSet(location)) {
     RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
     if (type == RWType::READ) {
+      LogSavepointRetype(location, type);
       type = RWType::READ_OWN;
       // record write.
+      LogWrite(location);
       return;
     }
     PL_ASSERT(type != RWType::DELETE && type != RWType::INS_DEL);
   } else {
     rw_set_[tile_group_id][tuple_id] = RWType::READ_OWN;
+    LogWrite(location);
   }
 }
 
@@ -142,6 +266,11 @@ void TransactionContext::RecordUpdate(const ItemPointer &location) {
   if (IsInRWSet(location)) {
     RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
     if (type == RWType::READ || type == RWType::READ_OWN) {
+      // a READ_OWN entry is already on the write list
+      if (type == RWType::READ) {
+        LogWrite(location);
+      }
+      LogSavepointRetype(location, type);
       type = RWType::UPDATE;
       // record write.
       is_written_ = true;
@@ -162,6 +291,7 @@ void TransactionContext::RecordUpdate(const ItemPointer &location) {
   } else {
     // consider select_for_udpate case.
     rw_set_[tile_group_id][tuple_id] = RWType::UPDATE;
+    LogWrite(location);
   }
 }
 
@@ -173,6 +303,7 @@ void TransactionContext::RecordInsert(const ItemPointer &location) {
     PL_ASSERT(false);
   } else {
     rw_set_[tile_group_id][tuple_id] = RWType::INSERT;
+    LogWrite(location);
     ++insert_count_;
   }
 }
@@ -184,6 +315,11 @@ bool TransactionContext::RecordDelete(const ItemPointer &location) {
   if (IsInRWSet(location)) {
     RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
     if (type == RWType::READ || type == RWType::READ_OWN) {
+      // a READ_OWN entry is already on the write list
+      if (type == RWType::READ) {
+        LogWrite(location);
+      }
+      LogSavepointRetype(location, type);
       type = RWType::DELETE;
       // record write.
       is_written_ = true;
@@ -191,11 +327,13 @@ bool TransactionContext::RecordDelete(const ItemPointer &location) {
       return false;
     }
     if (type == RWType::UPDATE) {
+      LogSavepointRetype(location, type);
       type = RWType::DELETE;
 
       return false;
     }
     if (type == RWType::INSERT) {
+      LogSavepointRetype(location, type);
       type = RWType::INS_DEL;
       --insert_count_;
 
@@ -208,10 +346,81 @@ bool TransactionContext::RecordDelete(const ItemPointer &location) {
     PL_ASSERT(false);
   } else {
     rw_set_[tile_group_id][tuple_id] = RWType::DELETE;
+    LogWrite(location);
   }
   return false;
 }
 
+void TransactionContext::SetSavepoint(const std::string &name) {
+  Savepoint savepoint;
+  savepoint.name = name;
+  for (auto &tile_group_entry : rw_set_) {
+    savepoint.bucket_sizes[tile_group_entry.first] =
+        tile_group_entry.second.size();
+  }
+  savepoint.write_set_size = write_set_.size();
+  savepoint.insert_count = insert_count_;
+  savepoint.is_written = is_written_;
+  savepoints_.push_back(std::move(savepoint));
+}
+
+int64_t TransactionContext::FindSavepoint(const std::string &name) const {
+  for (int64_t idx = static_cast<int64_t>(savepoints_.size()) - 1; idx >= 0;
+       idx--) {
+    if (savepoints_[idx].name == name) {
+      return idx;
+    }
+  }
+  return -1;
+}
+
+bool TransactionContext::ReleaseSavepoint(const std::string &name) {
+  int64_t idx = FindSavepoint(name);
+  if (idx < 0) {
+    return false;
+  }
+  if (idx > 0) {
+    // The released savepoints' retype logs now belong to the enclosing
+    // savepoint: an outer rollback must still restore those entries
+    auto &enclosing = savepoints_[idx - 1].retyped;
+    for (size_t sp = idx; sp < savepoints_.size(); sp++) {
+      enclosing.insert(enclosing.end(), savepoints_[sp].retyped.begin(),
+                       savepoints_[sp].retyped.end());
+    }
+  }
+  savepoints_.resize(idx);
+  return true;
+}
+
+void TransactionContext::TruncateToSavepoint(size_t savepoint_index) {
+  PL_ASSERT(savepoint_index < savepoints_.size());
+  auto &mark = savepoints_[savepoint_index];
+
+  for (auto itr = rw_set_.begin(); itr != rw_set_.end();) {
+    auto size_itr = mark.bucket_sizes.find(itr->first);
+    if (size_itr == mark.bucket_sizes.end()) {
+      // first touched after the mark
+      itr = rw_set_.erase(itr);
+    } else {
+      itr->second.Truncate(size_itr->second);
+      ++itr;
+    }
+  }
+
+  // Write-list appends after the mark belong to the dropped suffix (or to
+  // retypes the rollback just restored), so the prefix is again exactly the
+  // live write entries
+  write_set_.resize(mark.write_set_size);
+
+  insert_count_ = mark.insert_count;
+  is_written_ = mark.is_written;
+
+  // Everything logged after the mark has been rolled back; the mark itself
+  // stays armed for another rollback
+  mark.retyped.clear();
+  savepoints_.resize(savepoint_index + 1);
+}
+
 const std::string TransactionContext::GetInfo() const {
   std::ostringstream os;
 
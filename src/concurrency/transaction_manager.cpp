@@ -38,7 +38,7 @@ TransactionContext *TransactionManager::BeginTransaction(
     // transaction processing with decentralized epoch manager
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::SNAPSHOT_READ);
-    txn = new TransactionContext(thread_id, type, read_id);
+    txn = TransactionContext::GetInstance(thread_id, type, read_id);
 
   } else if (type == IsolationLevelType::SNAPSHOT) {
     // transaction processing with decentralized epoch manager
@@ -50,9 +50,10 @@ TransactionContext *TransactionManager::BeginTransaction(
       cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
           thread_id, TimestampType::COMMIT);
 
-      txn = new TransactionContext(thread_id, type, read_id, commit_id);
+      txn = TransactionContext::GetInstance(thread_id, type, read_id,
+                                           commit_id);
     } else {
-      txn = new TransactionContext(thread_id, type, read_id);
+      txn = TransactionContext::GetInstance(thread_id, type, read_id);
     }
 
   } else {
@@ -63,7 +64,7 @@ TransactionContext *TransactionManager::BeginTransaction(
     // transaction processing with decentralized epoch manager
     cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(
         thread_id, TimestampType::READ);
-    txn = new TransactionContext(thread_id, type, read_id);
+    txn = TransactionContext::GetInstance(thread_id, type, read_id);
   }
 
   if (static_cast<StatsType>(settings::SettingsManager::GetInt(
@@ -87,7 +88,7 @@ void TransactionManager::EndTransaction(TransactionContext *current_txn) {
   if(gc::GCManagerFactory::GetGCType() == GarbageCollectionType::ON) {
     gc::GCManagerFactory::GetInstance().RecycleTransaction(current_txn);
   } else {
-    delete current_txn;
+    TransactionContext::RecycleInstance(current_txn);
   }
 
   current_txn = nullptr;
@@ -174,6 +175,64 @@ bool TransactionManager::IsOccupied(TransactionContext *const current_txn,
 }
 
 // this function checks whether a version is visible to current transaction.
+void TransactionManager::PruneVersionChain(
+    const storage::TileGroupHeader *const tile_group_header,
+    const ItemPointer &location) {
+  cid_t expired_cid = EpochManagerFactory::GetInstance().GetExpiredCid();
+  if (expired_cid == INVALID_CID) {
+    return;
+  }
+
+  ItemPointer next_location =
+      tile_group_header->GetNextItemPointer(location.offset);
+  if (next_location.IsNull()) {
+    return;
+  }
+
+  auto next_tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(next_location.block);
+  if (next_tile_group == nullptr) {
+    return;
+  }
+  auto next_tile_group_header = next_tile_group->GetHeader();
+
+  // the version behind us can only be bypassed once it is committed, not
+  // write-locked, and invisible to every active transaction: all active
+  // read ids are at least the epoch low-watermark, so a version whose end
+  // timestamp lies below it can never be activated again.
+  txn_id_t next_txn_id =
+      next_tile_group_header->GetTransactionId(next_location.offset);
+  cid_t next_end_cid =
+      next_tile_group_header->GetEndCommitId(next_location.offset);
+  if (next_txn_id != INITIAL_TXN_ID) {
+    return;
+  }
+  if (next_end_cid == MAX_CID || next_end_cid == INVALID_CID ||
+      next_end_cid > expired_cid) {
+    return;
+  }
+
+  ItemPointer next_next_location =
+      next_tile_group_header->GetNextItemPointer(next_location.offset);
+
+  // bypass the obsolete version. the version keeps its own chain pointers,
+  // so readers that already stepped onto it can still walk past it; losing
+  // the CAS race to a concurrent reader is fine.
+  if (tile_group_header->CASNextItemPointer(location.offset, next_location,
+                                            next_next_location) == true) {
+    if (next_next_location.IsNull() == false) {
+      auto next_next_tile_group = catalog::Manager::GetInstance().GetTileGroup(
+          next_next_location.block);
+      if (next_next_tile_group != nullptr) {
+        next_next_tile_group->GetHeader()->SetPrevItemPointer(
+            next_next_location.offset, location);
+      }
+    }
+    LOG_TRACE("pruned obsolete version %u.%u from version chain",
+              next_location.block, next_location.offset);
+  }
+}
+
 VisibilityType TransactionManager::IsVisible(
     TransactionContext *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
@@ -255,5 +314,45 @@ VisibilityType TransactionManager::IsVisible(
   }
 }
 
+void TransactionManager::IsVisibleBatch(
+    TransactionContext *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t start_slot, const oid_t end_slot,
+    uint64_t *visibility_bitmap) {
+  // hoisted per-batch: re-read per tuple in IsVisible
+  const cid_t txn_vis_id = current_txn->GetReadId();
+
+  const size_t word_count =
+      (static_cast<size_t>(end_slot - start_slot) + 63) / 64;
+  PL_MEMSET(visibility_bitmap, 0, word_count * sizeof(uint64_t));
+
+  for (oid_t tuple_id = start_slot; tuple_id < end_slot; tuple_id++) {
+    const txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+
+    bool visible;
+    if (likely_branch(tuple_txn_id == INITIAL_TXN_ID)) {
+      // committed version owned by nobody: plain timestamp window check,
+      // branch-light so the compiler can keep the loads flowing
+      const cid_t tuple_begin_cid =
+          tile_group_header->GetBeginCommitId(tuple_id);
+      const cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+      visible = (txn_vis_id >= tuple_begin_cid) & (txn_vis_id < tuple_end_cid);
+    } else if (tuple_txn_id == INVALID_TXN_ID) {
+      // deleted or aborted slot: never qualifies for a scan
+      visible = false;
+    } else {
+      // owned by this or another transaction: fall back to the full
+      // RW-set aware per-tuple check
+      visible = (IsVisible(current_txn, tile_group_header, tuple_id) ==
+                 VisibilityType::OK);
+    }
+
+    if (visible) {
+      const oid_t position = tuple_id - start_slot;
+      visibility_bitmap[position >> 6] |= (1ULL << (position & 63));
+    }
+  }
+}
+
 }  // namespace concurrency
 }  // namespace peloton
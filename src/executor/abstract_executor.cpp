@@ -75,6 +75,19 @@ bool AbstractExecutor::Init() {
   return true;
 }
 
+/**
+ * @brief Recursively clears per-execution state so a cached executor tree
+ * can be re-initialized with Init() and executed again without being
+ * rebuilt.
+ */
+void AbstractExecutor::Reset() {
+  for (auto child : children_) {
+    child->Reset();
+  }
+  output.reset();
+  ResetState();
+}
+
 /**
  * @brief Returns next tile processed by this executor.
  *
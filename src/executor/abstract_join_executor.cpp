@@ -279,6 +279,8 @@ void AbstractJoinExecutor::BufferLeftTile(LogicalTile *left_tile) {
   switch (join_type_) {
     case JoinType::LEFT:
     case JoinType::OUTER:
+    case JoinType::SEMI:
+    case JoinType::ANTI:
       UpdateLeftJoinRowSets();
       break;
     default:
@@ -315,6 +317,8 @@ void AbstractJoinExecutor::UpdateJoinRowSets() {
   PL_ASSERT(join_type_ != JoinType::INVALID);
   switch (join_type_) {
     case JoinType::LEFT:
+    case JoinType::SEMI:
+    case JoinType::ANTI:
       UpdateLeftJoinRowSets();
       break;
     case JoinType::RIGHT:
@@ -383,6 +387,13 @@ bool AbstractJoinExecutor::BuildOuterJoinOutput() {
 
     case JoinType::INNER: { return false; }
 
+    // all semi join results are emitted during the probe phase
+    case JoinType::SEMI: { return false; }
+
+    // an anti join emits exactly the left rows that never matched,
+    // null-padded on the right like an unmatched left join row
+    case JoinType::ANTI: { return BuildLeftJoinOutput(); }
+
     default: {
       throw Exception("Unsupported join type : " + JoinTypeToString(join_type_));
       break;
@@ -10,15 +10,31 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "index/index.h"
 #include "executor/aggregate_executor.h"
 #include "executor/aggregator.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
+#include "expression/tuple_value_expression.h"
 #include "planner/aggregate_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
 #include "storage/table_factory.h"
+#include "storage/temp_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/zone_map_manager.h"
+#include "threadpool/mono_queue_pool.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace executor {
@@ -32,6 +48,9 @@ AggregateExecutor::AggregateExecutor(const planner::AbstractPlan *node,
     : AbstractExecutor(node, executor_context) {}
 
 AggregateExecutor::~AggregateExecutor() {
+  if (executor_context_ != nullptr) {
+    executor_context_->GetMemoryTracker().UnregisterSpillHook(this);
+  }
   // clean up temporary aggregation table
   delete output_table;
 }
@@ -64,8 +83,18 @@ bool AggregateExecutor::DInit() {
   // clean up temporary aggregation table
   delete output_table;
 
-  output_table =
+  storage::TempTable *temp_table =
       storage::TableFactory::GetTempTable(output_table_schema, false);
+  output_table = temp_table;
+
+  if (executor_context_ != nullptr) {
+    // Count the output table against the query's memory budget, and let
+    // the budget force its full tile groups to disk under pressure
+    auto &tracker = executor_context_->GetMemoryTracker();
+    temp_table->SetMemoryTracker(&tracker);
+    tracker.RegisterSpillHook(
+        this, [temp_table]() -> size_t { return temp_table->SpillNow(); });
+  }
 
   return true;
 }
@@ -93,80 +122,108 @@ bool AggregateExecutor::DExecute() {
   // Get an aggregator
   std::unique_ptr<AbstractAggregator> aggregator(nullptr);
 
-  // Get input tiles and aggregate them
-  while (children_[0]->Execute() == true) {
-    std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
-
-    if (nullptr == aggregator.get()) {
-      // Initialize the aggregator
-      switch (node.GetAggregateStrategy()) {
-        case AggregateType::HASH:
-          LOG_TRACE("Use HashAggregator");
-          aggregator.reset(new HashAggregator(
-              &node, output_table, executor_context_, tile->GetColumnCount()));
-          break;
-        case AggregateType::SORTED:
-          LOG_TRACE("Use SortedAggregator");
-          aggregator.reset(new SortedAggregator(
-              &node, output_table, executor_context_, tile->GetColumnCount()));
-          break;
-        case AggregateType::PLAIN:
-          LOG_TRACE("Use PlainAggregator");
-          aggregator.reset(
-              new PlainAggregator(&node, output_table, executor_context_));
-          break;
-        default:
-          LOG_ERROR("Invalid aggregate type. Return.");
+  // Global MIN/MAX over a bare seq scan can usually be answered from the
+  // zone map catalog with a bounded row scan, and a global COUNT(DISTINCT)
+  // over an indexed column from an ordered index walk; when either works
+  // the result row is already in output_table and the child is never
+  // pulled
+  if (TryZoneMapMinMax(node) == false &&
+      TryIndexDistinctCount(node) == false) {
+    // Parallel hash aggregation: buffer the child's tiles, aggregate them into
+    // per-worker hash tables on the thread pool, and merge the partial tables
+    if (node.GetAggregateStrategy() == AggregateType::HASH &&
+        settings::SettingsManager::GetBool(
+            settings::SettingId::parallel_aggregation)) {
+      std::vector<std::unique_ptr<LogicalTile>> input_tiles;
+      while (children_[0]->Execute() == true) {
+        input_tiles.emplace_back(children_[0]->GetOutput());
+      }
+      if (input_tiles.empty() == false) {
+        aggregator.reset(ParallelHashAggregate(input_tiles));
+        if (aggregator.get() == nullptr) {
           return false;
+        }
       }
     }
 
-    LOG_TRACE("Looping over tile..");
+    // Get input tiles and aggregate them
+    while (children_[0]->Execute() == true) {
+      std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
+
+      if (nullptr == aggregator.get()) {
+        // Initialize the aggregator
+        switch (node.GetAggregateStrategy()) {
+          case AggregateType::HASH:
+            LOG_TRACE("Use HashAggregator");
+            aggregator.reset(new HashAggregator(
+                &node, output_table, executor_context_, tile->GetColumnCount()));
+            break;
+          case AggregateType::SORTED:
+            LOG_TRACE("Use SortedAggregator");
+            aggregator.reset(new SortedAggregator(
+                &node, output_table, executor_context_, tile->GetColumnCount()));
+            break;
+          case AggregateType::PLAIN:
+            LOG_TRACE("Use PlainAggregator");
+            aggregator.reset(
+                new PlainAggregator(&node, output_table, executor_context_));
+            break;
+          default:
+            LOG_ERROR("Invalid aggregate type. Return.");
+            return false;
+        }
+      }
 
-    for (oid_t tuple_id : *tile) {
-      std::unique_ptr<ContainerTuple<LogicalTile>> cur_tuple(
-          new ContainerTuple<LogicalTile>(tile.get(), tuple_id));
+      LOG_TRACE("Looping over tile..");
 
-      if (aggregator->Advance(cur_tuple.get()) == false) {
-        return false;
+      for (oid_t tuple_id : *tile) {
+        // warm the base rows a few positions ahead of the aggregator
+        tile->PrefetchTuple(tuple_id + LogicalTile::kDefaultPrefetchDistance);
+
+        std::unique_ptr<ContainerTuple<LogicalTile>> cur_tuple(
+            new ContainerTuple<LogicalTile>(tile.get(), tuple_id));
+
+        if (aggregator->Advance(cur_tuple.get()) == false) {
+          return false;
+        }
       }
+      LOG_TRACE("Finished processing logical tile");
     }
-    LOG_TRACE("Finished processing logical tile");
-  }
-
-  LOG_TRACE("Finalizing..");
-  if (!aggregator.get() || !aggregator->Finalize()) {
-    // If there's no tuples and no group-by, count() aggregations should return
-    // 0 according to the test in MySQL.
-    // TODO: We only checked whether all AggTerms are counts here. If there're
-    // mixed terms, we should return 0 for counts and null for others.
-    bool all_count_aggs = true;
-    for (oid_t aggno = 0; aggno < node.GetUniqueAggTerms().size(); aggno++) {
-      auto agg_type = node.GetUniqueAggTerms()[aggno].aggtype;
-      if (agg_type != ExpressionType::AGGREGATE_COUNT &&
-          agg_type != ExpressionType::AGGREGATE_COUNT_STAR)
-        all_count_aggs = false;
-    }
-
-    // If there's no tuples in the table and only if no group-by in the
-    // query, we should return a NULL tuple
-    // this is required by SQL
-    if (!aggregator.get() && node.GetGroupbyColIds().empty()) {
-      LOG_TRACE(
-          "No tuples received and no group-by. Should insert a NULL tuple "
-          "here.");
-      std::unique_ptr<storage::Tuple> tuple(
-          new storage::Tuple(output_table->GetSchema(), true));
-      if (all_count_aggs == true) {
-        tuple->SetAllZeros();
+
+    LOG_TRACE("Finalizing..");
+    if (!aggregator.get() || !aggregator->Finalize()) {
+      // If there's no tuples and no group-by, count() aggregations should return
+      // 0 according to the test in MySQL.
+      // TODO: We only checked whether all AggTerms are counts here. If there're
+      // mixed terms, we should return 0 for counts and null for others.
+      bool all_count_aggs = true;
+      for (oid_t aggno = 0; aggno < node.GetUniqueAggTerms().size(); aggno++) {
+        auto agg_type = node.GetUniqueAggTerms()[aggno].aggtype;
+        if (agg_type != ExpressionType::AGGREGATE_COUNT &&
+            agg_type != ExpressionType::AGGREGATE_COUNT_STAR)
+          all_count_aggs = false;
+      }
+
+      // If there's no tuples in the table and only if no group-by in the
+      // query, we should return a NULL tuple
+      // this is required by SQL
+      if (!aggregator.get() && node.GetGroupbyColIds().empty()) {
+        LOG_TRACE(
+            "No tuples received and no group-by. Should insert a NULL tuple "
+            "here.");
+        std::unique_ptr<storage::Tuple> tuple(
+            new storage::Tuple(output_table->GetSchema(), true));
+        if (all_count_aggs == true) {
+          tuple->SetAllZeros();
+        } else {
+          tuple->SetAllNulls();
+        }
+        UNUSED_ATTRIBUTE auto location = output_table->InsertTuple(tuple.get());
+        PL_ASSERT(location.block != INVALID_OID);
       } else {
-        tuple->SetAllNulls();
+        done = true;
+        return false;
       }
-      UNUSED_ATTRIBUTE auto location = output_table->InsertTuple(tuple.get());
-      PL_ASSERT(location.block != INVALID_OID);
-    } else {
-      done = true;
-      return false;
     }
   }
 
@@ -196,5 +253,426 @@ bool AggregateExecutor::DExecute() {
   return true;
 }
 
+bool AggregateExecutor::TryZoneMapMinMax(const planner::AggregatePlan &node) {
+  // Shape check: global aggregation, MIN/MAX terms only, over a bare
+  // (predicate-free) sequential scan of a data table
+  if (node.GetGroupbyColIds().empty() == false) return false;
+  if (node.GetPredicate() != nullptr) return false;
+  if (node.GetChildren().size() != 1) return false;
+  auto *child_plan = node.GetChildren()[0].get();
+  if (child_plan->GetPlanNodeType() != PlanNodeType::SEQSCAN) return false;
+  auto *scan_plan = static_cast<const planner::SeqScanPlan *>(child_plan);
+  if (scan_plan->GetPredicate() != nullptr) return false;
+  storage::DataTable *table = scan_plan->GetTable();
+  if (table == nullptr) return false;
+
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  if (zone_map_manager->ZoneMapTableExists() == false) return false;
+
+  const auto &scan_column_ids = scan_plan->GetColumnIds();
+  const auto &agg_terms = node.GetUniqueAggTerms();
+  if (agg_terms.empty()) return false;
+
+  // Every term must be a plain MIN/MAX over a zone-mappable column
+  std::vector<oid_t> term_table_cols(agg_terms.size());
+  std::vector<int> term_value_idxs(agg_terms.size());
+  for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+    const auto &term = agg_terms[term_itr];
+    if (term.aggtype != ExpressionType::AGGREGATE_MIN &&
+        term.aggtype != ExpressionType::AGGREGATE_MAX) {
+      return false;
+    }
+    if (term.distinct) return false;
+    auto *expr = term.expression;
+    if (expr == nullptr ||
+        expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      return false;
+    }
+    auto *tve = static_cast<const expression::TupleValueExpression *>(expr);
+    int value_idx = tve->GetColumnId();
+    if (value_idx < 0 ||
+        static_cast<size_t>(value_idx) >= scan_column_ids.size()) {
+      return false;
+    }
+    oid_t table_col = scan_column_ids[value_idx];
+    if (storage::ZoneMapManager::IsZoneMappableType(
+            table->GetSchema()->GetType(table_col)) == false) {
+      return false;
+    }
+    term_table_cols[term_itr] = table_col;
+    term_value_idxs[term_itr] = value_idx;
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto *current_txn = executor_context_->GetTransaction();
+
+  std::vector<type::Value> best_values(agg_terms.size());
+  std::vector<bool> has_best(agg_terms.size(), false);
+
+  auto fold_value = [&](size_t term_itr, const type::Value &val) {
+    if (val.IsNull()) return;
+    if (has_best[term_itr] == false) {
+      best_values[term_itr] = val;
+      has_best[term_itr] = true;
+      return;
+    }
+    if (agg_terms[term_itr].aggtype == ExpressionType::AGGREGATE_MAX) {
+      if (val.CompareGreaterThan(best_values[term_itr]) == CmpBool::TRUE) {
+        best_values[term_itr] = val;
+      }
+    } else {
+      if (val.CompareLessThan(best_values[term_itr]) == CmpBool::TRUE) {
+        best_values[term_itr] = val;
+      }
+    }
+  };
+
+  auto scan_tile_group_rows = [&](size_t tile_group_offset) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    auto *tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (transaction_manager.IsVisible(current_txn, tile_group_header,
+                                        tuple_id) != VisibilityType::OK) {
+        continue;
+      }
+      for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+        fold_value(term_itr,
+                   tile_group->GetValue(tuple_id, term_table_cols[term_itr]));
+      }
+    }
+  };
+
+  // Pass 1: the mutable tail, and any tile group without complete zone map
+  // coverage, must be scanned for real -- the zone map catalog only covers
+  // immutable tile groups
+  struct ZoneMappedGroup {
+    size_t offset;
+    std::vector<std::unique_ptr<storage::ZoneMapManager::ColumnStatistics>>
+        stats;
+  };
+  std::vector<ZoneMappedGroup> zone_mapped_groups;
+
+  oid_t database_id = table->GetDatabaseOid();
+  oid_t table_id = table->GetOid();
+  size_t tile_group_count = table->GetTileGroupCount();
+  for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    bool covered = tile_group->GetHeader()->GetImmutability();
+    ZoneMappedGroup group;
+    group.offset = tile_group_offset;
+    if (covered) {
+      for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+        auto stats = zone_map_manager->GetZoneMapFromCatalog(
+            database_id, table_id, tile_group_offset,
+            term_table_cols[term_itr]);
+        if (stats == nullptr) {
+          covered = false;
+          break;
+        }
+        group.stats.push_back(std::move(stats));
+      }
+    }
+    if (covered) {
+      zone_mapped_groups.push_back(std::move(group));
+    } else {
+      scan_tile_group_rows(tile_group_offset);
+    }
+  }
+
+  // Pass 2: zone-mapped tile groups, newest first. The zone map may include
+  // versions invisible to this transaction, so its min/max only bound the
+  // answer: a tile group is scanned when its bound could still beat the
+  // best value found in actual visible rows, and skipped when it provably
+  // cannot. For the monitoring-style MAX(timestamp) shape the extremum sits
+  // in the tail, so typically every zone-mapped group is skipped.
+  size_t scanned_group_count = 0;
+  for (auto group_itr = zone_mapped_groups.rbegin();
+       group_itr != zone_mapped_groups.rend(); ++group_itr) {
+    bool must_scan = false;
+    for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+      if (has_best[term_itr] == false) {
+        must_scan = true;
+        break;
+      }
+      const auto &stats = group_itr->stats[term_itr];
+      if (agg_terms[term_itr].aggtype == ExpressionType::AGGREGATE_MAX) {
+        if (stats->max.CompareGreaterThan(best_values[term_itr]) ==
+            CmpBool::TRUE) {
+          must_scan = true;
+          break;
+        }
+      } else {
+        if (stats->min.CompareLessThan(best_values[term_itr]) ==
+            CmpBool::TRUE) {
+          must_scan = true;
+          break;
+        }
+      }
+    }
+    if (must_scan) {
+      scan_tile_group_rows(group_itr->offset);
+      scanned_group_count++;
+    }
+  }
+
+  // Empty table or all-null columns: defer to the regular path, which
+  // handles the NULL output semantics
+  for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+    if (has_best[term_itr] == false) return false;
+  }
+
+  // Feed the extrema through a plain aggregator as one synthetic row, so
+  // output schema and projection handling stay identical to the slow path
+  std::vector<type::Value> synthetic_values(
+      scan_column_ids.size(),
+      type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER));
+  for (size_t term_itr = 0; term_itr < agg_terms.size(); term_itr++) {
+    synthetic_values[term_value_idxs[term_itr]] = best_values[term_itr];
+  }
+  ContainerTuple<std::vector<type::Value>> synthetic_tuple(&synthetic_values);
+
+  PlainAggregator aggregator(&node, output_table, executor_context_);
+  if (aggregator.Advance(&synthetic_tuple) == false) return false;
+  if (aggregator.Finalize() == false) return false;
+
+  LOG_TRACE("Zone map MIN/MAX: scanned %lu of %lu tile groups",
+            scanned_group_count + (tile_group_count - zone_mapped_groups.size()),
+            tile_group_count);
+  return true;
+}
+
+bool AggregateExecutor::TryIndexDistinctCount(
+    const planner::AggregatePlan &node) {
+  // Shape check: a single global COUNT(DISTINCT col) over a bare
+  // (predicate-free) sequential scan of a data table
+  if (node.GetGroupbyColIds().empty() == false) return false;
+  if (node.GetPredicate() != nullptr) return false;
+  if (node.GetChildren().size() != 1) return false;
+  auto *child_plan = node.GetChildren()[0].get();
+  if (child_plan->GetPlanNodeType() != PlanNodeType::SEQSCAN) return false;
+  auto *scan_plan = static_cast<const planner::SeqScanPlan *>(child_plan);
+  if (scan_plan->GetPredicate() != nullptr) return false;
+  storage::DataTable *table = scan_plan->GetTable();
+  if (table == nullptr) return false;
+
+  const auto &scan_column_ids = scan_plan->GetColumnIds();
+  const auto &agg_terms = node.GetUniqueAggTerms();
+  if (agg_terms.size() != 1) return false;
+  const auto &term = agg_terms[0];
+  if (term.aggtype != ExpressionType::AGGREGATE_COUNT) return false;
+  if (term.distinct == false) return false;
+  auto *expr = term.expression;
+  if (expr == nullptr ||
+      expr->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    return false;
+  }
+  auto *tve = static_cast<const expression::TupleValueExpression *>(expr);
+  int value_idx = tve->GetColumnId();
+  if (value_idx < 0 ||
+      static_cast<size_t>(value_idx) >= scan_column_ids.size()) {
+    return false;
+  }
+  oid_t table_col = scan_column_ids[value_idx];
+
+  // The column must lead the key of an ordered (BWTree) index so that the
+  // leaf walk hands entries back sorted on it
+  std::shared_ptr<index::Index> distinct_index = nullptr;
+  oid_t index_count = table->GetIndexCount();
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = table->GetIndex(index_itr);
+    if (index == nullptr) continue;
+    if (index->GetIndexMethodType() != IndexType::BWTREE) continue;
+    const auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+    if (key_attrs.empty() || key_attrs[0] != table_col) continue;
+    distinct_index = index;
+    break;
+  }
+  if (distinct_index == nullptr) return false;
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto *current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  distinct_index->ScanAllKeys(tuple_location_ptrs);
+
+  // Walk the entries in key order, collapsing each run of duplicates with
+  // one comparison per entry. Only run boundaries are fed through the
+  // aggregator, whose distinct set still deduplicates the rare entry that
+  // a key-changing update left behind under its old key (those resolve to
+  // a value out of key order); the set sees one insert per distinct run
+  // instead of one per row, and the output path stays the slow path's.
+  PlainAggregator aggregator(&node, output_table, executor_context_);
+  std::vector<type::Value> synthetic_values(
+      scan_column_ids.size(),
+      type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER));
+  ContainerTuple<std::vector<type::Value>> synthetic_tuple(&synthetic_values);
+
+  bool has_previous = false;
+  type::Value previous_value;
+  bool fed_any = false;
+
+  for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location = *tuple_location_ptr;
+    auto *tile_group = manager.GetTileGroupRaw(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
+    size_t chain_length = 0;
+
+    // traverse the version chain until a visible version is found, the
+    // same way the index scan does
+    while (true) {
+      ++chain_length;
+
+      auto visibility = transaction_manager.IsVisible(
+          current_txn, tile_group_header, tuple_location.offset);
+
+      if (visibility == VisibilityType::DELETED) {
+        break;
+      } else if (visibility == VisibilityType::OK) {
+        type::Value val =
+            tile_group->GetValue(tuple_location.offset, table_col);
+
+        bool duplicate = false;
+        if (has_previous) {
+          if (val.IsNull()) {
+            duplicate = previous_value.IsNull();
+          } else if (previous_value.IsNull() == false) {
+            duplicate = (val.CompareEquals(previous_value) == CmpBool::TRUE);
+          }
+        }
+
+        if (duplicate == false) {
+          synthetic_values[value_idx] = val;
+          if (aggregator.Advance(&synthetic_tuple) == false) return false;
+          previous_value = val;
+          has_previous = true;
+          fed_any = true;
+        }
+        break;
+      } else {
+        PL_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+        bool is_acquired = (tile_group_header->GetTransactionId(
+                                tuple_location.offset) == INITIAL_TXN_ID);
+        bool is_alive =
+            (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+             current_txn->GetReadId());
+        if (is_acquired && is_alive) {
+          // the version chain was modified under us; restart from the head
+          tuple_location =
+              *(tile_group_header->GetIndirection(tuple_location.offset));
+          tile_group = manager.GetTileGroupRaw(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
+          chain_length = 0;
+          continue;
+        }
+
+        ItemPointer old_item = tuple_location;
+        transaction_manager.PruneVersionChain(tile_group_header, old_item);
+        tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
+
+        if (tuple_location.IsNull()) {
+          if (chain_length == 1) {
+            break;
+          }
+          // a visible version should exist; nothing has been written to
+          // the output table yet, so hand the anomaly to the regular path
+          return false;
+        }
+
+        tile_group = manager.GetTileGroupRaw(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
+      }
+    }
+  }
+
+  // Nothing visible: defer to the regular path, which produces the
+  // zero-count output row for an empty input
+  if (fed_any == false) return false;
+
+  if (aggregator.Finalize() == false) return false;
+
+  LOG_TRACE("Index distinct count: %lu index entries walked",
+            tuple_location_ptrs.size());
+  return true;
+}
+
+AbstractAggregator *AggregateExecutor::ParallelHashAggregate(
+    std::vector<std::unique_ptr<LogicalTile>> &input_tiles) {
+  const planner::AggregatePlan &node = GetPlanNode<planner::AggregatePlan>();
+  const size_t num_input_columns = input_tiles[0]->GetColumnCount();
+
+  size_t worker_pool_size = static_cast<size_t>(settings::SettingsManager::
+      GetInt(settings::SettingId::monoqueue_worker_pool_size));
+  size_t num_workers = std::min<size_t>(worker_pool_size, input_tiles.size());
+  if (num_workers == 0) num_workers = 1;
+
+  std::vector<std::unique_ptr<HashAggregator>> partials;
+  for (size_t worker_itr = 0; worker_itr < num_workers; worker_itr++) {
+    partials.emplace_back(new HashAggregator(
+        &node, output_table, executor_context_, num_input_columns));
+  }
+
+  // Workers pull tiles off a shared cursor and advance their own table
+  std::atomic<size_t> cursor(0);
+  std::atomic<bool> failed(false);
+  auto worker = [&input_tiles, &cursor, &failed](HashAggregator *partial) {
+    while (failed.load() == false) {
+      const size_t tile_idx = cursor.fetch_add(1);
+      if (tile_idx >= input_tiles.size()) break;
+      LogicalTile *tile = input_tiles[tile_idx].get();
+      for (oid_t tuple_id : *tile) {
+        tile->PrefetchTuple(tuple_id + LogicalTile::kDefaultPrefetchDistance);
+        ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
+        if (partial->Advance(&cur_tuple) == false) {
+          failed.store(true);
+          return;
+        }
+      }
+    }
+  };
+
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  // Workers dispatched to the pool; this thread handles worker slot zero
+  uint32_t workers_left = static_cast<uint32_t>(num_workers) - 1;
+
+  auto &pool = threadpool::MonoQueuePool::GetInstance();
+  for (size_t worker_itr = 1; worker_itr < num_workers; worker_itr++) {
+    HashAggregator *partial = partials[worker_itr].get();
+    pool.SubmitTask([&worker, partial, &done_mutex, &done_cv, &workers_left] {
+      worker(partial);
+      std::lock_guard<std::mutex> lock(done_mutex);
+      workers_left--;
+      done_cv.notify_one();
+    });
+  }
+
+  // Participate on the calling thread so aggregation finishes even when
+  // every pool worker is busy with other queries
+  worker(partials[0].get());
+
+  {
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [&workers_left] { return workers_left == 0; });
+  }
+
+  if (failed.load()) {
+    return nullptr;
+  }
+
+  // Merge the partial tables into worker zero's table
+  for (size_t worker_itr = 1; worker_itr < num_workers; worker_itr++) {
+    partials[0]->Merge(*partials[worker_itr]);
+  }
+
+  LOG_TRACE("Parallel aggregation merged %lu partial tables", num_workers);
+  return partials[0].release();
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -16,7 +16,11 @@
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
+#include "settings/settings_manager.h"
 #include "storage/abstract_table.h"
+#include "type/memory_tracker.h"
+#include "type/serializeio.h"
+#include "type/value_peeker.h"
 
 namespace peloton {
 namespace executor {
@@ -59,27 +63,257 @@ AbstractAttributeAggregator *GetAttributeAggregatorInstance(ExpressionType agg_t
 }
 
 /* Handle distinct */
-AbstractAttributeAggregator::~AbstractAttributeAggregator() {}
+AbstractAttributeAggregator::~AbstractAttributeAggregator() {
+  if (spill_arena_ != nullptr && distinct_buffered_bytes_ > 0) {
+    spill_arena_->Release(distinct_buffered_bytes_);
+  }
+}
+
+void AbstractAttributeAggregator::SetDistinctSpillArena(
+    std::shared_ptr<DistinctSpillArena> arena) {
+  spill_arena_ = std::move(arena);
+}
+
+size_t AbstractAttributeAggregator::DistinctValueBytes(
+    const type::Value &val) {
+  // sizeof(Value) plus a nominal hash-set node overhead; variable-length
+  // values additionally own their payload
+  size_t bytes = sizeof(type::Value) + 48;
+  auto type_id = val.GetTypeId();
+  if ((type_id == type::TypeId::VARCHAR ||
+       type_id == type::TypeId::VARBINARY) &&
+      val.IsNull() == false) {
+    bytes += val.GetLength();
+  }
+  return bytes;
+}
 
 void AbstractAttributeAggregator::Advance(const type::Value val) {
   if (is_distinct_) {
     // Insert a deep copy
     type::Value val_copy = (val.Copy());
-    distinct_set_.insert(val_copy);
+    if (distinct_set_.insert(val_copy).second == false) {
+      return;
+    }
+    if (spill_arena_ != nullptr) {
+      size_t bytes = DistinctValueBytes(val_copy);
+      distinct_buffered_bytes_ += bytes;
+      if (spill_arena_->Consume(bytes)) {
+        SpillDistinctSet();
+      }
+    }
   } else {
     DAdvance(val);
   }
 }
 
+size_t AbstractAttributeAggregator::SpillDistinctSet() {
+  if (spill_arena_ == nullptr || distinct_set_.empty()) {
+    return 0;
+  }
+
+  // One run per non-empty hash partition, each value serialized as a type
+  // byte followed by its payload. A value's partition depends only on its
+  // hash, so re-occurrences across spills land in the same partition
+  for (size_t partition = 0; partition < kDistinctPartitions; partition++) {
+    CopySerializeOutput output;
+    size_t count = 0;
+    for (const auto &spill_val : distinct_set_) {
+      if (spill_val.Hash() % kDistinctPartitions != partition) {
+        continue;
+      }
+      output.WriteByte(static_cast<int8_t>(spill_val.GetTypeId()));
+      spill_val.SerializeTo(output);
+      count++;
+    }
+    if (count == 0) {
+      continue;
+    }
+    size_t file_offset = 0;
+    if (spill_arena_->AppendRun(static_cast<const char *>(output.Data()),
+                                output.Size(), file_offset) == false) {
+      // Could not spill; keep the remaining values buffered. Values both in
+      // a written run and still in the set are harmless because the
+      // finalize path re-deduplicates every partition
+      return 0;
+    }
+    distinct_runs_.push_back({partition, file_offset, output.Size(), count});
+  }
+
+  size_t freed = distinct_buffered_bytes_;
+  distinct_set_.clear();
+  distinct_buffered_bytes_ = 0;
+  spill_arena_->Release(freed);
+  return freed;
+}
+
+void AbstractAttributeAggregator::ReadRunInto(const DistinctRun &run,
+                                              DistinctSetType &set) const {
+  std::vector<char> buffer(run.length);
+  if (spill_arena_->ReadRun(run.file_offset, run.length, buffer.data()) ==
+      false) {
+    LOG_ERROR("Failed to read back a spilled distinct aggregate run");
+    return;
+  }
+  CopySerializeInput input(buffer.data(), run.length);
+  for (size_t value_itr = 0; value_itr < run.count; value_itr++) {
+    auto type_id = static_cast<type::TypeId>(input.ReadEnumInSingleByte());
+    type::Value run_val = type::Value::DeserializeFrom(input, type_id, nullptr);
+    // Deserialized varlen values reference the read buffer, so insert an
+    // owning copy that outlives it
+    if (type_id == type::TypeId::VARCHAR && run_val.IsNull() == false) {
+      set.insert(type::ValueFactory::GetVarcharValue(
+          run_val.GetData(), run_val.GetLength(), true));
+    } else if (type_id == type::TypeId::VARBINARY &&
+               run_val.IsNull() == false) {
+      set.insert(type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(run_val.GetData()),
+          static_cast<int32_t>(run_val.GetLength()), true));
+    } else {
+      set.insert(run_val);
+    }
+  }
+}
+
 type::Value AbstractAttributeAggregator::Finalize() {
   if (is_distinct_) {
-    for (auto val : distinct_set_) {
-      DAdvance(val);
+    if (distinct_runs_.empty()) {
+      for (auto val : distinct_set_) {
+        DAdvance(val);
+      }
+    } else {
+      // Spilled: feed the aggregate one hash partition at a time so only a
+      // single partition's distinct values are in memory at once. A value
+      // can recur across runs of one partition and in the still-buffered
+      // set, so each partition is re-deduplicated before replay
+      for (size_t partition = 0; partition < kDistinctPartitions;
+           partition++) {
+        DistinctSetType partition_set;
+        for (const auto &run : distinct_runs_) {
+          if (run.partition == partition) {
+            ReadRunInto(run, partition_set);
+          }
+        }
+        for (const auto &val : distinct_set_) {
+          if (val.Hash() % kDistinctPartitions == partition) {
+            partition_set.insert(val);
+          }
+        }
+        for (const auto &val : partition_set) {
+          DAdvance(val);
+        }
+      }
     }
   }
   return DFinalize();
 }
 
+void AbstractAttributeAggregator::Merge(
+    const AbstractAttributeAggregator &other) {
+  if (is_distinct_) {
+    // Distinct values are deduplicated at finalize time, so merging two
+    // partial states is a set union; going through Advance() keeps this
+    // aggregator's dedup and spill accounting intact
+    for (auto &val : other.distinct_set_) {
+      Advance(val);
+    }
+    DistinctSetType run_values;
+    for (const auto &run : other.distinct_runs_) {
+      run_values.clear();
+      other.ReadRunInto(run, run_values);
+      for (const auto &val : run_values) {
+        Advance(val);
+      }
+    }
+  } else {
+    DMerge(other);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Distinct Spill Arena
+//===--------------------------------------------------------------------===//
+DistinctSpillArena::DistinctSpillArena(type::QueryMemoryTracker *tracker)
+    : tracker_(tracker) {
+  int budget_mb = settings::SettingsManager::GetInt(
+      settings::SettingId::agg_distinct_spill_budget_mb);
+  if (budget_mb > 0) {
+    budget_bytes_ = static_cast<size_t>(budget_mb) * 1024 * 1024;
+  }
+}
+
+DistinctSpillArena::~DistinctSpillArena() {
+  if (spill_file_ != nullptr) {
+    fclose(spill_file_);
+  }
+}
+
+bool DistinctSpillArena::Consume(size_t bytes) {
+  buffered_bytes_ += bytes;
+  if (tracker_ != nullptr) {
+    tracker_->Consume(bytes);
+  }
+  return spill_failed_ == false && budget_bytes_ > 0 &&
+         buffered_bytes_ > budget_bytes_;
+}
+
+void DistinctSpillArena::Release(size_t bytes) {
+  PL_ASSERT(bytes <= buffered_bytes_);
+  buffered_bytes_ -= bytes;
+  if (tracker_ != nullptr) {
+    tracker_->Release(bytes);
+  }
+}
+
+bool DistinctSpillArena::AppendRun(const char *data, size_t length,
+                                   size_t &file_offset) {
+  if (spill_failed_) {
+    return false;
+  }
+  if (spill_file_ == nullptr) {
+    spill_file_ = std::tmpfile();
+    if (spill_file_ == nullptr) {
+      LOG_ERROR(
+          "Failed to create distinct aggregate spill file, keeping distinct "
+          "values in memory");
+      spill_failed_ = true;
+      return false;
+    }
+  }
+  if (fseek(spill_file_, static_cast<long>(spill_file_size_), SEEK_SET) != 0 ||
+      fwrite(data, 1, length, spill_file_) != length) {
+    LOG_ERROR(
+        "Failed to write a distinct aggregate spill run, keeping distinct "
+        "values in memory");
+    spill_failed_ = true;
+    return false;
+  }
+  file_offset = spill_file_size_;
+  spill_file_size_ += length;
+  return true;
+}
+
+bool DistinctSpillArena::ReadRun(size_t file_offset, size_t length,
+                                 char *buffer) const {
+  if (spill_file_ == nullptr) {
+    return false;
+  }
+  if (fseek(spill_file_, static_cast<long>(file_offset), SEEK_SET) != 0 ||
+      fread(buffer, 1, length, spill_file_) != length) {
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<DistinctSpillArena> AbstractAggregator::GetDistinctSpillArena() {
+  if (distinct_spill_arena_ == nullptr) {
+    distinct_spill_arena_ = std::make_shared<DistinctSpillArena>(
+        executor_context != nullptr ? &executor_context->GetMemoryTracker()
+                                    : nullptr);
+  }
+  return distinct_spill_arena_;
+}
+
 /*
  * Helper method responsible for inserting the results of the aggregation
  * into a new tuple in the output tile group as well as passing through any
@@ -171,45 +405,94 @@ HashAggregator::~HashAggregator() {
 }
 
 bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
-  AggregateList *aggregate_list;
-
-  // Configure a group-by-key and search for the required group.
-  group_by_key_values.clear();
-  for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
-       column_itr++) {
-    type::Value cur_tuple_val =
-        cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
-    group_by_key_values.push_back(cur_tuple_val);
+  AggregateList *aggregate_list = nullptr;
+
+  // Direct-array fast path: a single integer-family group-by key with a
+  // small non-negative value indexes dense_groups_ directly
+  int64_t dense_key = -1;
+  if (node->GetGroupbyColIds().size() == 1) {
+    type::Value key_val = cur_tuple->GetValue(node->GetGroupbyColIds()[0]);
+    if (key_val.IsNull() == false) {
+      switch (key_val.GetTypeId()) {
+        case type::TypeId::TINYINT:
+          dense_key = type::ValuePeeker::PeekTinyInt(key_val);
+          break;
+        case type::TypeId::SMALLINT:
+          dense_key = type::ValuePeeker::PeekSmallInt(key_val);
+          break;
+        case type::TypeId::INTEGER:
+          dense_key = type::ValuePeeker::PeekInteger(key_val);
+          break;
+        case type::TypeId::BIGINT:
+          dense_key = type::ValuePeeker::PeekBigInt(key_val);
+          break;
+        default:
+          break;
+      }
+    }
+    if (dense_key >= kDenseGroupLimit) {
+      dense_key = -1;
+    }
+    if (dense_key >= 0 &&
+        static_cast<size_t>(dense_key) < dense_groups_.size()) {
+      aggregate_list = dense_groups_[dense_key];
+    }
   }
 
-  auto map_itr = aggregates_map.find(group_by_key_values);
-
-  // Group not found. Make a new entry in the hash for this new group.
-  if (map_itr == aggregates_map.end()) {
-    LOG_TRACE("Group-by key not found. Start a new group.");
-    // Allocate new aggregate list
-    aggregate_list = new AggregateList();
-    aggregate_list->aggregates = new AbstractAttributeAggregator *[node->GetUniqueAggTerms().size()];
-    // Make a deep copy of the first tuple we meet
-    for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
-      // first_tuple_values has the ownership
-      aggregate_list->first_tuple_values.push_back(cur_tuple->GetValue(col_id));
-    };
+  if (aggregate_list == nullptr) {
+    // Configure a group-by-key and search for the required group.
+    group_by_key_values.clear();
+    for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
+         column_itr++) {
+      type::Value cur_tuple_val =
+          cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
+      group_by_key_values.push_back(cur_tuple_val);
+    }
 
-    for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
-      aggregate_list->aggregates[aggno] =
-          GetAttributeAggregatorInstance(node->GetUniqueAggTerms()[aggno].aggtype);
+    auto map_itr = aggregates_map.find(group_by_key_values);
+
+    // Group not found. Make a new entry in the hash for this new group.
+    if (map_itr == aggregates_map.end()) {
+      LOG_TRACE("Group-by key not found. Start a new group.");
+      // Allocate new aggregate list
+      aggregate_list = new AggregateList();
+      aggregate_list->aggregates =
+          new AbstractAttributeAggregator *[node->GetUniqueAggTerms().size()];
+      // Make a deep copy of the first tuple we meet
+      for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
+        // first_tuple_values has the ownership
+        aggregate_list->first_tuple_values.push_back(
+            cur_tuple->GetValue(col_id));
+      };
+
+      for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
+        aggregate_list->aggregates[aggno] = GetAttributeAggregatorInstance(
+            node->GetUniqueAggTerms()[aggno].aggtype);
+
+        bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
+        aggregate_list->aggregates[aggno]->SetDistinct(distinct);
+        if (distinct) {
+          aggregate_list->aggregates[aggno]->SetDistinctSpillArena(
+              GetDistinctSpillArena());
+        }
+      }
 
-      bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
-      aggregate_list->aggregates[aggno]->SetDistinct(distinct);
+      aggregates_map.insert(HashAggregateMapType::value_type(
+          group_by_key_values, aggregate_list));
+    }
+    // Otherwise, the list is the second item of the pair.
+    else {
+      aggregate_list = map_itr->second;
     }
 
-    aggregates_map.insert(
-        HashAggregateMapType::value_type(group_by_key_values, aggregate_list));
-  }
-  // Otherwise, the list is the second item of the pair.
-  else {
-    aggregate_list = map_itr->second;
+    // Remember the slot so later rows of this group skip the hash table.
+    // The slot holds a plain alias; ownership stays with the map.
+    if (dense_key >= 0) {
+      if (dense_groups_.size() <= static_cast<size_t>(dense_key)) {
+        dense_groups_.resize(dense_key + 1, nullptr);
+      }
+      dense_groups_[dense_key] = aggregate_list;
+    }
   }
 
   // Update the aggregation calculation
@@ -240,6 +523,27 @@ bool HashAggregator::Finalize() {
   return true;
 }
 
+void HashAggregator::Merge(HashAggregator &partial) {
+  for (auto partial_itr = partial.aggregates_map.begin();
+       partial_itr != partial.aggregates_map.end();) {
+    auto map_itr = aggregates_map.find(partial_itr->first);
+    if (map_itr == aggregates_map.end()) {
+      // Group only seen by the partial: adopt its aggregate list wholesale.
+      // Ownership moves with it, so drop the partial's map entry to keep its
+      // destructor from freeing the list.
+      aggregates_map.insert(*partial_itr);
+      partial_itr = partial.aggregates_map.erase(partial_itr);
+    } else {
+      for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size();
+           aggno++) {
+        map_itr->second->aggregates[aggno]->Merge(
+            *partial_itr->second->aggregates[aggno]);
+      }
+      ++partial_itr;
+    }
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Sort Aggregator
 //===--------------------------------------------------------------------===//
@@ -311,6 +615,9 @@ bool SortedAggregator::Advance(AbstractTuple *next_tuple) {
 
       bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
       aggregates[aggno]->SetDistinct(distinct);
+      if (distinct) {
+        aggregates[aggno]->SetDistinctSpillArena(GetDistinctSpillArena());
+      }
     }
 
     // Update delegate tuple values
@@ -368,6 +675,9 @@ PlainAggregator::PlainAggregator(const planner::AggregatePlan *node,
 
     bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
     aggregates[aggno]->SetDistinct(distinct);
+    if (distinct) {
+      aggregates[aggno]->SetDistinctSpillArena(GetDistinctSpillArena());
+    }
   }
 }
 
@@ -57,8 +57,10 @@ bool AnalyzeExecutor::DExecute() {
       LOG_TRACE("Failed to analyze table %s", node.GetTableName().c_str());
     }
   } else {
-    // other operations unsupported for now
-    current_txn->SetResult(peloton::ResultType::SUCCESS);
+    // Plain ANALYZE: refresh only the tables whose stats have gone stale
+    LOG_TRACE("Analyzing stale tables");
+    ResultType result = stats->AnalyzeStaleTables(current_txn);
+    current_txn->SetResult(result);
   }
 
   LOG_TRACE("Analyzing finished!");
@@ -13,15 +13,62 @@
 #include <utility>
 
 #include "type/value.h"
+#include "common/exception.h"
 #include "executor/executor_context.h"
 #include "concurrency/transaction_context.h"
+#include "settings/settings_manager.h"
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// Compute the statement deadline for an execution starting now; returns
+// whether the statement_timeout_ms setting imposes one
+bool ComputeDeadline(std::chrono::steady_clock::time_point &deadline) {
+  int timeout_ms = settings::SettingsManager::GetInt(
+      settings::SettingId::statement_timeout_ms);
+  if (timeout_ms <= 0) {
+    return false;
+  }
+  deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  return true;
+}
+
+}  // namespace
+
 ExecutorContext::ExecutorContext(concurrency::TransactionContext *transaction,
                                  codegen::QueryParameters parameters)
-    : transaction_(transaction), parameters_(std::move(parameters)) {}
+    : transaction_(transaction), parameters_(std::move(parameters)) {
+  memory_tracker_.SetBudget(
+      static_cast<uint64_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::query_memory_budget_mb)) *
+      1024 * 1024);
+  has_deadline_ = ComputeDeadline(deadline_);
+}
+
+void ExecutorContext::Reset(concurrency::TransactionContext *transaction,
+                            codegen::QueryParameters parameters) {
+  transaction_ = transaction;
+  parameters_ = std::move(parameters);
+  // drop allocations made for the previous execution
+  pool_.reset();
+  scoped_pools_.clear();
+  memory_tracker_.Reset();
+  progress_entry_.reset();
+  has_deadline_ = ComputeDeadline(deadline_);
+  num_processed = 0;
+}
+
+void ExecutorContext::ThrowIfExecutionAborted() const {
+  if (IsCancelRequested()) {
+    throw ExecutorException("query killed by administrator");
+  }
+  if (IsStatementTimeoutExpired()) {
+    throw ExecutorException("canceling statement due to statement timeout");
+  }
+}
 
 concurrency::TransactionContext *ExecutorContext::GetTransaction() const {
   return transaction_;
@@ -36,12 +83,25 @@ codegen::QueryParameters &ExecutorContext::GetParams() { return parameters_; }
 type::EphemeralPool *ExecutorContext::GetPool() {
   // construct pool if needed
   if (pool_ == nullptr) {
-    pool_.reset(new type::EphemeralPool());
+    pool_.reset(new type::EphemeralPool(&memory_tracker_));
   }
 
   // return pool
   return pool_.get();
 }
 
+type::EphemeralPool *ExecutorContext::GetScopedPool(const void *scope) {
+  auto &pool = scoped_pools_[scope];
+  if (pool == nullptr) {
+    pool.reset(new type::EphemeralPool(&memory_tracker_));
+  }
+  return pool.get();
+}
+
+void ExecutorContext::ReleaseScopedPool(const void *scope) {
+  // the pool's destructor returns every allocation at once
+  scoped_pools_.erase(scope);
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -16,10 +16,44 @@
 #include "executor/hash_executor.h"
 #include "planner/hash_plan.h"
 #include "expression/tuple_value_expression.h"
+#include "settings/settings_manager.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// A filter block is eight 32-bit lanes -- one 32-byte SIMD register -- and
+// a key sets exactly one bit per lane. Each lane derives its bit position
+// from the hash's low half through its own odd multiplier, so the eight
+// positions are pairwise independent (the classic split-block construction;
+// the salts are the ones commonly used with it).
+constexpr size_t kBloomLanesPerBlock = 8;
+
+constexpr uint32_t kBloomSalts[kBloomLanesPerBlock] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+#if defined(__AVX2__)
+// Lane masks for a key: multiply the hash's low half into every lane,
+// keep each product's top five bits as a bit index, and set that bit
+inline __m256i BloomBlockMask(uint64_t hash) {
+  const __m256i salts =
+      _mm256_setr_epi32(kBloomSalts[0], kBloomSalts[1], kBloomSalts[2],
+                        kBloomSalts[3], kBloomSalts[4], kBloomSalts[5],
+                        kBloomSalts[6], kBloomSalts[7]);
+  __m256i keys = _mm256_set1_epi32(static_cast<int32_t>(hash));
+  __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(keys, salts), 27);
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+}
+#endif
+
+}  // namespace
+
 /**
  * @brief Constructor
  */
@@ -36,11 +70,105 @@ bool HashExecutor::DInit() {
 
   // Initialize executor state
   done_ = false;
+  build_capped_ = false;
   result_itr = 0;
 
   return true;
 }
 
+void HashExecutor::InitBloomFilter(size_t build_tuple_count) {
+  bloom_lanes_ = nullptr;
+  bloom_block_mask_ = 0;
+  if (build_tuple_count == 0) {
+    return;
+  }
+
+  // ~10 bits per key, rounded up to a power of two of 256-bit blocks so
+  // probes can mask instead of mod
+  uint64_t num_blocks = 1;
+  while (num_blocks * 256 < build_tuple_count * 10) {
+    num_blocks <<= 1;
+  }
+
+  // Over-allocate by one block's worth of lanes and round the start up so
+  // every block sits on a 32-byte boundary and never straddles cache lines
+  bloom_storage_.assign(num_blocks * kBloomLanesPerBlock + kBloomLanesPerBlock,
+                        0);
+  uintptr_t base = reinterpret_cast<uintptr_t>(bloom_storage_.data());
+  bloom_lanes_ = reinterpret_cast<uint32_t *>((base + 31) & ~uintptr_t(31));
+  bloom_block_mask_ = num_blocks - 1;
+}
+
+void HashExecutor::BloomBlockSet(uint64_t hash) {
+  uint32_t *block =
+      bloom_lanes_ + ((hash >> 32) & bloom_block_mask_) * kBloomLanesPerBlock;
+  const uint32_t key = static_cast<uint32_t>(hash);
+  for (size_t lane = 0; lane < kBloomLanesPerBlock; lane++) {
+    block[lane] |= UINT32_C(1) << ((key * kBloomSalts[lane]) >> 27);
+  }
+}
+
+bool HashExecutor::BloomBlockTest(uint64_t hash) const {
+  const uint32_t *block =
+      bloom_lanes_ + ((hash >> 32) & bloom_block_mask_) * kBloomLanesPerBlock;
+#if defined(__AVX2__)
+  // One load of the block, then a single carry test of block against the
+  // key's lane masks: testc is 1 iff every mask bit is set in the block
+  __m256i block_vec =
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(block));
+  return _mm256_testc_si256(block_vec, BloomBlockMask(hash)) != 0;
+#else
+  const uint32_t key = static_cast<uint32_t>(hash);
+  for (size_t lane = 0; lane < kBloomLanesPerBlock; lane++) {
+    if ((block[lane] & (UINT32_C(1) << ((key * kBloomSalts[lane]) >> 27))) ==
+        0) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+void HashExecutor::MayContainHashes(const uint64_t *hashes, bool *matches,
+                                    size_t count) const {
+  if (bloom_lanes_ == nullptr) {
+    PL_MEMSET(matches, 1, count);
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    matches[i] = BloomBlockTest(hashes[i]);
+  }
+}
+
+void HashExecutor::InitPartitions(size_t build_tuple_count) {
+  size_t num_partitions = 1;
+
+  if (settings::SettingsManager::GetBool(settings::SettingId::radix_hash_join)) {
+    // Aim for partition tables of a few thousand keys each, small enough to
+    // stay cache-resident while a partition is probed
+    const size_t target_keys_per_partition = 4096;
+    const size_t max_partitions = 1024;
+    while (num_partitions < max_partitions &&
+           build_tuple_count > num_partitions * target_keys_per_partition) {
+      num_partitions <<= 1;
+    }
+  }
+
+  partitions_ = std::vector<HashMapType>(num_partitions);
+  size_t shift = 64;
+  for (size_t bits = num_partitions; bits > 1; bits >>= 1) {
+    shift--;
+  }
+  partition_shift_ = shift;
+
+  for (auto &partition : partitions_) {
+    partition.Reserve(build_tuple_count / num_partitions + 1);
+  }
+
+  LOG_TRACE("Hash build over %lu tuples using %lu radix partitions",
+            build_tuple_count, num_partitions);
+}
+
 bool HashExecutor::DExecute() {
   LOG_TRACE("Hash Executor");
 
@@ -74,31 +202,64 @@ bool HashExecutor::DExecute() {
       column_ids_.push_back(tuple_value->GetColumnId());
     }
 
-    // Construct the hash table by going over each child logical tile and
-    // hashing
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      if (tile->GetTupleCount() > 0) {
-        output_tile_itrs_.emplace_back(child_tile_itr);
-        for (oid_t tuple_id : *tile) {
-          // Key : container tuple with a subset of tuple attributes
-          // Value : < child_tile offset, tuple offset >
-          auto key = HashMapType::key_type(tile, tuple_id, &column_ids_);
-          if (hash_table_.find(key) != hash_table_.end()) {
-            //If data is already present, remove from output
-            //but leave data for hash joins.
-            tile->RemoveVisibility(tuple_id);
+    // Size the bloom filter and the hash table from the build-side
+    // cardinality
+    size_t build_tuple_count = 0;
+    for (auto &tile : child_tiles_) {
+      build_tuple_count += tile->GetTupleCount();
+    }
+
+    // Defensive cap: when stale statistics picked the big input as the
+    // build side, building its hash table is what blows memory up. Past
+    // the cap we only pass the materialized tiles through and flag the
+    // condition; the hash join then builds over its other input instead.
+    int build_row_cap = settings::SettingsManager::GetInt(
+        settings::SettingId::hash_build_row_cap);
+    if (build_row_cap > 0 &&
+        build_tuple_count > static_cast<size_t>(build_row_cap)) {
+      LOG_DEBUG("Hash build side has %lu tuples, above the cap of %d; "
+                "deferring to a switched-side build in the join",
+                build_tuple_count, build_row_cap);
+      build_capped_ = true;
+      for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
+           child_tile_itr++) {
+        if (child_tiles_[child_tile_itr]->GetTupleCount() > 0) {
+          output_tile_itrs_.emplace_back(child_tile_itr);
+        }
+      }
+      done_ = true;
+    } else {
+      InitBloomFilter(build_tuple_count);
+      InitPartitions(build_tuple_count);
+
+      // Construct the hash table by going over each child logical tile and
+      // hashing
+      for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
+           child_tile_itr++) {
+        auto tile = child_tiles_[child_tile_itr].get();
+
+        // Go over all tuples in the logical tile
+        if (tile->GetTupleCount() > 0) {
+          output_tile_itrs_.emplace_back(child_tile_itr);
+          for (oid_t tuple_id : *tile) {
+            // Key : container tuple with a subset of tuple attributes
+            // Value : < child_tile offset, tuple offset >
+            auto key =
+                ContainerTuple<LogicalTile>(tile, tuple_id, &column_ids_);
+            AddToBloomFilter(key);
+            if (partitions_[GetPartitionFor(key)].Insert(
+                    key, std::make_pair(output_tile_itrs_.size() - 1,
+                                        tuple_id))) {
+              //If data is already present, remove from output
+              //but leave data for hash joins.
+              tile->RemoveVisibility(tuple_id);
+            }
           }
-          hash_table_[key].insert(
-              std::make_pair(output_tile_itrs_.size()-1, tuple_id));
         }
       }
-    }
 
-    done_ = true;
+      done_ = true;
+    }
   }
 
   if (result_itr < output_tile_itrs_.size()) {
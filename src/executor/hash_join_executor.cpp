@@ -40,6 +40,13 @@ bool HashJoinExecutor::DInit() {
 
   hash_executor_ = reinterpret_cast<HashExecutor *>(children_[1]);
 
+  // Reset the switched-side state
+  switched_table_.reset();
+  switched_build_done_ = false;
+  switched_probe_itr_ = 0;
+  switched_left_col_ids_.clear();
+  switched_right_col_ids_.clear();
+
   return true;
 }
 
@@ -78,10 +85,35 @@ bool HashJoinExecutor::DExecute() {
       right_child_done_ = true;
     }
 
+    // Defensive role switch: the planned build side ran past the row cap,
+    // so no hash table was built over it. Build over the left input
+    // instead and probe with the buffered right tiles, one per pass, which
+    // turns a memory blowup from a stale cardinality estimate into a
+    // switched-side join.
+    if (hash_executor_->IsBuildCapped()) {
+      if (switched_build_done_ == false) {
+        BuildSwitchedHashTable();
+        switched_build_done_ = true;
+      }
+      if (switched_probe_itr_ < right_result_tiles_.size()) {
+        ProbeSwitchedHashTable(switched_probe_itr_++);
+        continue;
+      }
+      // probing is over; drop the switched table before the outer-join
+      // pass, mirroring ReleaseHashTables() on the normal path
+      switched_table_.reset();
+      left_child_done_ = true;
+      continue;
+    }
+
     // Get next tile from LEFT child
     if (children_[0]->Execute() == false) {
       LOG_TRACE("Did not get left tile \n");
       left_child_done_ = true;
+      // Probing is over; the outer-join pass below only needs the join's
+      // own matched-row bookkeeping, so give the build side's hash tables
+      // back right away instead of at plan teardown
+      hash_executor_->ReleaseHashTables();
       continue;
     }
 
@@ -99,8 +131,6 @@ bool HashJoinExecutor::DExecute() {
     // Build Join Tile
     //===------------------------------------------------------------------===//
 
-    // Get the hash table from the hash executor
-    auto &hash_table = hash_executor_->GetHashTable();
     std::vector<const expression::AbstractExpression *> left_hashed_cols;
     this->GetPlanNode<planner::HashJoinPlan>().GetLeftHashKeys(left_hashed_cols);
 
@@ -116,58 +146,110 @@ bool HashJoinExecutor::DExecute() {
     std::unique_ptr<LogicalTile> output_tile;
     LogicalTile::PositionListsBuilder pos_lists_builder;
 
-    // Go over the left tile
+    // Group the left tile's tuples by the build side's radix partition, so
+    // each partition's table stays cache-resident for its whole probe burst.
+    // With radix partitioning off there is one partition and the grouping
+    // degenerates to tile order.
+    const size_t num_partitions = hash_executor_->GetPartitionCount();
+
+    // Hash every probe key up front and run the tile through the build
+    // side's bloom filter as one batch: probe-heavy joins are mostly
+    // misses, the block tests stay hot with no tuple access interleaved,
+    // and the hashes are reused below for partition routing
+    std::vector<oid_t> probe_tuple_ids;
+    std::vector<uint64_t> probe_hashes;
     for (auto left_tile_itr : *left_tile) {
       const ContainerTuple<executor::LogicalTile> left_tuple(
           left_tile, left_tile_itr, &left_hashed_col_ids);
+      probe_tuple_ids.push_back(left_tile_itr);
+      probe_hashes.push_back(
+          ContainerTupleHasher<executor::LogicalTile>()(left_tuple));
+    }
+    std::unique_ptr<bool[]> bloom_matches(new bool[probe_tuple_ids.size()]);
+    hash_executor_->MayContainHashes(probe_hashes.data(), bloom_matches.get(),
+                                     probe_hashes.size());
+
+    std::vector<std::vector<oid_t>> partition_probe_lists(num_partitions);
+    for (size_t probe_itr = 0; probe_itr < probe_tuple_ids.size();
+         probe_itr++) {
+      // A bloom miss means the key is guaranteed absent from the hash
+      // table; drop the tuple before it is even grouped
+      if (!bloom_matches[probe_itr]) {
+        continue;
+      }
+      partition_probe_lists[hash_executor_->GetPartitionForHash(
+                                probe_hashes[probe_itr])]
+          .push_back(probe_tuple_ids[probe_itr]);
+    }
 
-      // Find matching tuples in the hash table built on top of the right table
-      auto right_tuples = hash_table.find(left_tuple);
-
-      if (right_tuples != hash_table.end()) {
-    	// Not yet supported due to assertion in gettomg right_tuples->first
-    	if (predicate_ != nullptr) {
-    		auto eval = predicate_->Evaluate(&left_tuple, &right_tuples->first,
-					executor_context_);
-			if (eval.IsFalse())
-				continue;
-    	}
-
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
-
-        // Go over the matching right tuples
-        for (auto &location : right_tuples->second) {
-          // Check if we got a new right tile itr
-          if (prev_tile != location.first) {
-            // Check if we have any join tuples
-            if (pos_lists_builder.Size() > 0) {
-              LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-              output_tile->SetPositionListsAndVisibility(
-                  pos_lists_builder.Release());
-              buffered_output_tiles.push_back(output_tile.release());
+    // Go over the left tile partition by partition
+    for (size_t partition = 0; partition < num_partitions; partition++) {
+      auto &hash_table = hash_executor_->GetPartitionTable(partition);
+      for (auto left_tile_itr : partition_probe_lists[partition]) {
+        const ContainerTuple<executor::LogicalTile> left_tuple(
+            left_tile, left_tile_itr, &left_hashed_col_ids);
+
+        // Find matching tuples in the hash table built on top of the right table
+        const ContainerTuple<executor::LogicalTile> *right_key = nullptr;
+        HashExecutor::HashMapType::ValueIterator right_tuples;
+
+        if (hash_table.Probe(left_tuple, right_key, right_tuples)) {
+      	if (predicate_ != nullptr) {
+      		auto eval = predicate_->Evaluate(&left_tuple, right_key,
+  					executor_context_);
+  			if (eval.IsFalse())
+  				continue;
+      	}
+
+          RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
+
+          // An anti join emits nothing during probing; its output is the
+          // unmatched left rows, built once all probing is done
+          if (join_type_ == JoinType::ANTI) {
+            continue;
+          }
+
+          // Go over the matching right tuples
+          while (right_tuples.HasNext()) {
+            const auto &location = right_tuples.Next();
+            // Check if we got a new right tile itr
+            if (prev_tile != location.first) {
+              // Check if we have any join tuples
+              if (pos_lists_builder.Size() > 0) {
+                LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+                output_tile->SetPositionListsAndVisibility(
+                    pos_lists_builder.Release());
+                buffered_output_tiles.push_back(output_tile.release());
+              }
+
+              // Get the logical tile from right child
+              LogicalTile *right_tile = right_result_tiles_[location.first].get();
+
+              // Build output logical tile
+              output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+
+              // Build position lists
+              pos_lists_builder =
+                  LogicalTile::PositionListsBuilder(left_tile, right_tile);
+
+              pos_lists_builder.SetRightSource(
+                  &right_result_tiles_[location.first]->GetPositionLists());
             }
 
-            // Get the logical tile from right child
-            LogicalTile *right_tile = right_result_tiles_[location.first].get();
+            // Add join tuple
+            pos_lists_builder.AddRow(left_tile_itr, location.second);
 
-            // Build output logical tile
-            output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+            RecordMatchedRightRow(location.first, location.second);
 
-            // Build position lists
-            pos_lists_builder =
-                LogicalTile::PositionListsBuilder(left_tile, right_tile);
+            // Cache prev logical tile itr
+            prev_tile = location.first;
 
-            pos_lists_builder.SetRightSource(
-                &right_result_tiles_[location.first]->GetPositionLists());
+            // A semi join emits each left row at most once, so the first
+            // matching right tuple settles it
+            if (join_type_ == JoinType::SEMI) {
+              break;
+            }
           }
-
-          // Add join tuple
-          pos_lists_builder.AddRow(left_tile_itr, location.second);
-
-          RecordMatchedRightRow(location.first, location.second);
-
-          // Cache prev logical tile itr
-          prev_tile = location.first;
         }
       }
     }
@@ -193,5 +275,130 @@ bool HashJoinExecutor::DExecute() {
   }
 }
 
+void HashJoinExecutor::BuildSwitchedHashTable() {
+  // Resolve the key column ids for both sides once
+  std::vector<const expression::AbstractExpression *> left_hashed_cols;
+  this->GetPlanNode<planner::HashJoinPlan>().GetLeftHashKeys(left_hashed_cols);
+  for (auto &hashkey : left_hashed_cols) {
+    PL_ASSERT(hashkey->GetExpressionType() == ExpressionType::VALUE_TUPLE);
+    auto tuple_value =
+        reinterpret_cast<const expression::TupleValueExpression *>(hashkey);
+    switched_left_col_ids_.push_back(tuple_value->GetColumnId());
+  }
+
+  std::vector<const expression::AbstractExpression *> right_hashed_cols;
+  this->GetPlanNode<planner::HashJoinPlan>().GetRightHashKeys(
+      right_hashed_cols);
+  for (auto &hashkey : right_hashed_cols) {
+    PL_ASSERT(hashkey->GetExpressionType() == ExpressionType::VALUE_TUPLE);
+    auto tuple_value =
+        reinterpret_cast<const expression::TupleValueExpression *>(hashkey);
+    switched_right_col_ids_.push_back(tuple_value->GetColumnId());
+  }
+
+  // Drain the left child; its tiles are buffered anyway for the output
+  // pass, so the switch costs no extra materialization
+  while (children_[0]->Execute()) {
+    BufferLeftTile(children_[0]->GetOutput());
+  }
+
+  size_t build_tuple_count = 0;
+  for (auto &tile : left_result_tiles_) {
+    build_tuple_count += tile->GetTupleCount();
+  }
+  LOG_DEBUG("Switched-side hash build over %lu left tuples",
+            build_tuple_count);
+
+  switched_table_.reset(new HashExecutor::HashMapType());
+  switched_table_->Reserve(build_tuple_count);
+
+  for (size_t tile_itr = 0; tile_itr < left_result_tiles_.size(); tile_itr++) {
+    auto tile = left_result_tiles_[tile_itr].get();
+    for (oid_t tuple_id : *tile) {
+      auto key =
+          ContainerTuple<LogicalTile>(tile, tuple_id, &switched_left_col_ids_);
+      switched_table_->Insert(key, std::make_pair(tile_itr, tuple_id));
+    }
+  }
+}
+
+void HashJoinExecutor::ProbeSwitchedHashTable(size_t right_tile_idx) {
+  LogicalTile *right_tile = right_result_tiles_[right_tile_idx].get();
+
+  oid_t prev_tile = INVALID_OID;
+  std::unique_ptr<LogicalTile> output_tile;
+  LogicalTile::PositionListsBuilder pos_lists_builder;
+
+  for (auto right_tile_itr : *right_tile) {
+    const ContainerTuple<executor::LogicalTile> right_tuple(
+        right_tile, right_tile_itr, &switched_right_col_ids_);
+
+    // Find matching left tuples in the switched hash table
+    const ContainerTuple<executor::LogicalTile> *left_key = nullptr;
+    HashExecutor::HashMapType::ValueIterator left_tuples;
+
+    if (switched_table_->Probe(right_tuple, left_key, left_tuples)) {
+      if (predicate_ != nullptr) {
+        auto eval =
+            predicate_->Evaluate(left_key, &right_tuple, executor_context_);
+        if (eval.IsFalse()) continue;
+      }
+
+      RecordMatchedRightRow(right_tile_idx, right_tile_itr);
+
+      // Go over the matching left tuples
+      while (left_tuples.HasNext()) {
+        const auto &location = left_tuples.Next();
+
+        // An anti join only records the match; unmatched left rows are
+        // emitted after the last probe pass
+        if (join_type_ == JoinType::ANTI) {
+          RecordMatchedLeftRow(location.first, location.second);
+          continue;
+        }
+
+        // Unlike the normal path, a left row can match again on a later
+        // right tile's pass, so a semi join has to skip rows it already
+        // emitted
+        if (join_type_ == JoinType::SEMI &&
+            IsLeftRowMatched(location.first, location.second)) {
+          continue;
+        }
+
+        // Join tiles pair one left tile with this right tile; start a new
+        // output tile whenever the left tile changes
+        if (prev_tile != location.first) {
+          if (pos_lists_builder.Size() > 0) {
+            output_tile->SetPositionListsAndVisibility(
+                pos_lists_builder.Release());
+            buffered_output_tiles.push_back(output_tile.release());
+          }
+
+          LogicalTile *left_tile = left_result_tiles_[location.first].get();
+
+          output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+
+          pos_lists_builder =
+              LogicalTile::PositionListsBuilder(left_tile, right_tile);
+
+          pos_lists_builder.SetLeftSource(
+              &left_result_tiles_[location.first]->GetPositionLists());
+        }
+
+        pos_lists_builder.AddRow(location.second, right_tile_itr);
+
+        RecordMatchedLeftRow(location.first, location.second);
+
+        prev_tile = location.first;
+      }
+    }
+  }
+
+  if (pos_lists_builder.Size() > 0) {
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    buffered_output_tiles.push_back(output_tile.release());
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -42,6 +42,15 @@ bool HashSetOpExecutor::DInit() {
 bool HashSetOpExecutor::DExecute() {
   LOG_TRACE("Set Op executor ");
 
+  const planner::SetOpPlan &node = GetPlanNode<planner::SetOpPlan>();
+  if (node.AreChildrenSorted()) {
+    if (set_op_ == SetOpType::INVALID) {
+      set_op_ = node.GetSetOp();
+      PL_ASSERT(set_op_ != SetOpType::INVALID);
+    }
+    return ExecuteStreaming();
+  }
+
   if (!hash_done_) ExecuteHelper();
 
   PL_ASSERT(hash_done_);
@@ -77,7 +86,8 @@ bool HashSetOpExecutor::ExecuteHelper() {
   // Scan the left child's input and update the counters
   for (auto &tile : left_tiles_) {
     for (oid_t tuple_id : *tile) {
-      htable_[HashSetOpMapType::key_type(tile.get(), tuple_id)].left++;
+      htable_.FindOrCreate(HashSetOpMapType::key_type(tile.get(), tuple_id))
+          .left++;
     }
   }
 
@@ -87,11 +97,12 @@ bool HashSetOpExecutor::ExecuteHelper() {
     std::unique_ptr<LogicalTile> tile(children_[1]->GetOutput());
 
     for (oid_t tuple_id : *tile) {
-      auto it = htable_.find(HashSetOpMapType::key_type(tile.get(), tuple_id));
+      auto *counters =
+          htable_.Find(HashSetOpMapType::key_type(tile.get(), tuple_id));
       // Do nothing if this key never appears in the left child
       // because it shouldn't show up in the result anyway
-      if (it != htable_.end()) {
-        it->second.right++;
+      if (counters != nullptr) {
+        counters->right++;
       }
     }
   }
@@ -126,34 +137,206 @@ bool HashSetOpExecutor::ExecuteHelper() {
   // 1st round
   for (auto &tile : left_tiles_) {
     for (oid_t tuple_id : *tile) {
-      auto it = htable_.find(HashSetOpMapType::key_type(tile.get(), tuple_id));
+      const HashSetOpMapType::key_type *stored_key = nullptr;
+      auto *counters = htable_.Find(
+          HashSetOpMapType::key_type(tile.get(), tuple_id), stored_key);
 
-      PL_ASSERT(it != htable_.end());
+      PL_ASSERT(counters != nullptr);
 
-      if (it->first.GetContainer() == tile.get() &&
-          it->first.GetTupleId() == tuple_id)
+      if (stored_key->GetContainer() == tile.get() &&
+          stored_key->GetTupleId() == tuple_id)
         continue;
-      else if (it->second.left > 0)
-        it->second.left--;
+      else if (counters->left > 0)
+        counters->left--;
       else
         tile->RemoveVisibility(tuple_id);
     }
   }
 
   // 2nd round
-  for (auto &item : htable_) {
+  htable_.ForEach([](const HashSetOpMapType::key_type &key,
+                     counter_pair_t &counters) {
     // We should have at most one quota left
-    PL_ASSERT(item.second.left == 1 || item.second.left == 0);
-    if (item.second.left == 0) {
-      item.first.GetContainer()->RemoveVisibility(item.first.GetTupleId());
+    PL_ASSERT(counters.left == 1 || counters.left == 0);
+    if (counters.left == 0) {
+      key.GetContainer()->RemoveVisibility(key.GetTupleId());
     }
-  }
+  });
 
   hash_done_ = true;
   next_tile_to_return_ = 0;
   return true;
 }
 
+/**
+ * @brief Streaming set-op over children that advertise sorted output.
+ *
+ * Merges the two sorted inputs in a single pass: left tiles are pulled one
+ * at a time, the visibility of each left tuple is decided as soon as the
+ * matching right run has been counted, and the tile is forwarded upwards
+ * once the run key no longer points into it. Memory stays constant in the
+ * input size: at most two left tiles and one right tile are alive.
+ */
+bool HashSetOpExecutor::ExecuteStreaming() {
+  for (;;) {
+    // Forward a fully decided tile, skipping empty ones
+    if (pending_output_ != nullptr) {
+      if (pending_output_->GetTupleCount() > 0) {
+        SetOutput(pending_output_.release());
+        return true;
+      }
+      pending_output_.reset();
+    }
+
+    if (streaming_done_) {
+      if (held_left_tile_ != nullptr) {
+        // The run key dies with the input; safe to let the last tile go
+        run_tile_ = nullptr;
+        pending_output_ = std::move(held_left_tile_);
+        continue;
+      }
+      return false;
+    }
+
+    // Early termination for INTERSECT (ALL): the right side is exhausted,
+    // so no further left tuple can make it into the result
+    if (early_out_ || children_[0]->Execute() == false) {
+      streaming_done_ = true;
+      continue;
+    }
+
+    std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
+    ProcessSortedLeftTile(tile.get());
+
+    // The run key now points into the current tile (if anywhere), so the
+    // previously held tile is fully decided
+    pending_output_ = std::move(held_left_tile_);
+    held_left_tile_ = std::move(tile);
+  }
+}
+
+/**
+ * Decide the visibility of every tuple in the given left tile.
+ *
+ * Tuples are grouped into runs of equal values; for each new run the right
+ * cursor is advanced once to count the equal right tuples. Within a run,
+ * position i stays visible iff
+ *   INTERSECT:      i == 0 and the right count is nonzero
+ *   INTERSECT ALL:  i < right count
+ *   EXCEPT:         i == 0 and the right count is zero
+ *   EXCEPT ALL:     i >= right count
+ * which emits exactly the same multiset as the hash-based path without
+ * needing the run's total length up front.
+ */
+void HashSetOpExecutor::ProcessSortedLeftTile(LogicalTile *tile) {
+  for (oid_t tuple_id : *tile) {
+    if (early_out_) {
+      tile->RemoveVisibility(tuple_id);
+      continue;
+    }
+
+    bool new_run =
+        (run_tile_ == nullptr ||
+         CompareTuples(run_tile_, run_tuple_id_, tile, tuple_id) != 0);
+    if (new_run) {
+      run_index_ = 0;
+      run_right_matches_ = CountMatchingRightTuples(tile, tuple_id);
+    } else {
+      run_index_++;
+    }
+
+    // Rebase the run key onto this tuple (it is equal to the old key when
+    // the run continues), so earlier tiles can be released. Hidden tuples
+    // are fine as keys: RemoveVisibility() only flips the bitmap.
+    run_tile_ = tile;
+    run_tuple_id_ = tuple_id;
+
+    bool visible;
+    switch (set_op_) {
+      case SetOpType::INTERSECT:
+        visible = (run_index_ == 0 && run_right_matches_ > 0);
+        break;
+      case SetOpType::INTERSECT_ALL:
+        visible = (run_index_ < run_right_matches_);
+        break;
+      case SetOpType::EXCEPT:
+        visible = (run_index_ == 0 && run_right_matches_ == 0);
+        break;
+      case SetOpType::EXCEPT_ALL:
+        visible = (run_index_ >= run_right_matches_);
+        break;
+      default:
+        visible = false;
+    }
+    if (!visible) {
+      tile->RemoveVisibility(tuple_id);
+    }
+
+    if (right_exhausted_ && run_right_matches_ == 0 &&
+        (set_op_ == SetOpType::INTERSECT ||
+         set_op_ == SetOpType::INTERSECT_ALL)) {
+      early_out_ = true;
+    }
+  }
+}
+
+/**
+ * Advance the right cursor past everything smaller than the given left
+ * tuple and count the right tuples equal to it. The equal tuples are
+ * consumed, so each right tuple is matched against at most one left run.
+ */
+size_t HashSetOpExecutor::CountMatchingRightTuples(LogicalTile *left_tile,
+                                                   oid_t left_id) {
+  size_t matches = 0;
+  while (EnsureRightTuple()) {
+    int cmp = CompareTuples(right_tile_.get(), right_ids_[right_pos_],
+                            left_tile, left_id);
+    if (cmp > 0) break;
+    if (cmp == 0) matches++;
+    right_pos_++;
+  }
+  return matches;
+}
+
+/**
+ * Make sure the right cursor points at a tuple, pulling (and replacing)
+ * right tiles as needed. Returns false once the right child is exhausted.
+ */
+bool HashSetOpExecutor::EnsureRightTuple() {
+  while (right_tile_ == nullptr || right_pos_ >= right_ids_.size()) {
+    if (right_exhausted_) return false;
+    if (children_[1]->Execute() == false) {
+      right_exhausted_ = true;
+      right_tile_.reset();
+      return false;
+    }
+    right_tile_.reset(children_[1]->GetOutput());
+    right_ids_.clear();
+    for (oid_t tuple_id : *right_tile_) {
+      right_ids_.push_back(tuple_id);
+    }
+    right_pos_ = 0;
+  }
+  return true;
+}
+
+/**
+ * Three-way comparison of two tuples over the full column list.
+ * Children of a set-op share one physical schema, so column ids line up.
+ */
+int HashSetOpExecutor::CompareTuples(LogicalTile *left_tile, oid_t left_id,
+                                     LogicalTile *right_tile,
+                                     oid_t right_id) {
+  oid_t column_count = left_tile->GetColumnCount();
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    type::Value left_value = left_tile->GetValue(left_id, column_id);
+    type::Value right_value = right_tile->GetValue(right_id, column_id);
+    if (left_value.CompareLessThan(right_value) == CmpBool::TRUE) return -1;
+    if (left_value.CompareGreaterThan(right_value) == CmpBool::TRUE) return 1;
+  }
+  return 0;
+}
+
 /**
  * Based on the set-op type,
  * calculate the number of output copies of each tuples
@@ -161,27 +344,29 @@ bool HashSetOpExecutor::ExecuteHelper() {
  */
 template <SetOpType SETOP>
 bool HashSetOpExecutor::CalculateCopies(HashSetOpMapType &htable) {
-  for (auto &item : htable) {
+  bool valid = true;
+  htable.ForEach([&valid](const HashSetOpMapType::key_type &,
+                          counter_pair_t &counters) {
     switch (SETOP) {
       case SetOpType::INTERSECT:
-        item.second.left = (item.second.right > 0) ? 1 : 0;
+        counters.left = (counters.right > 0) ? 1 : 0;
         break;
       case SetOpType::INTERSECT_ALL:
-        item.second.left = std::min(item.second.left, item.second.right);
+        counters.left = std::min(counters.left, counters.right);
         break;
       case SetOpType::EXCEPT:
-        item.second.left = (item.second.right > 0) ? 0 : 1;
+        counters.left = (counters.right > 0) ? 0 : 1;
         break;
       case SetOpType::EXCEPT_ALL:
-        item.second.left = (item.second.left > item.second.right)
-                               ? (item.second.left - item.second.right)
-                               : 0;
+        counters.left = (counters.left > counters.right)
+                            ? (counters.left - counters.right)
+                            : 0;
         break;
       default:
-        return false;
+        valid = false;
     }
-  }
-  return true;
+  });
+  return valid;
 }
 
 }  // namespace executor
@@ -175,6 +175,25 @@ bool HybridScanExecutor::SeqScanUtil() {
 
   // Retrieve next tile group.
   while (current_tile_group_offset_ < table_tile_group_count_) {
+    // Runtime adaptivity: if the predicate turns out to be far more
+    // selective than the estimate that put us on the sequential path, and
+    // the index has been backfilled past our scan position in the meantime,
+    // probe the index for the newly covered tile groups instead of grinding
+    // through them tuple by tuple.
+    if (type_ == HybridScanType::HYBRID && predicate_ != nullptr &&
+        seq_tile_groups_scanned_ >= adapt_tile_group_window_) {
+      seq_tile_groups_scanned_ = 0;
+      double observed_selectivity =
+          (seq_scanned_tuples_ == 0)
+              ? 1.0
+              : static_cast<double>(seq_qualified_tuples_) /
+                    static_cast<double>(seq_scanned_tuples_);
+      if (observed_selectivity < adapt_selectivity_threshold_ &&
+          AdaptToIndexProbe() == true) {
+        return true;
+      }
+    }
+
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
     auto tile_group_header = tile_group->GetHeader();
@@ -230,6 +249,10 @@ bool HybridScanExecutor::SeqScanUtil() {
       }
     }
 
+    seq_scanned_tuples_ += active_tuple_count;
+    seq_qualified_tuples_ += position_list.size();
+    seq_tile_groups_scanned_++;
+
     // Don't return empty tiles
     if (position_list.size() == 0) {
       continue;
@@ -335,9 +358,12 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     index_->ScanAllKeys(tuple_location_ptrs);
   } else {
     LOG_TRACE("Scan");
-    index_->Scan(values_, key_column_ids_, expr_type_,
-                 ScanDirectionType::FORWARD, tuple_location_ptrs,
-                 &node.GetIndexPredicate().GetConjunctionList()[0]);
+    // One probe per OR'd conjunction; for a single conjunction this is
+    // the plain scan the index always did
+    node.GetIndexPredicate().ScanUnion(index_.get(), values_,
+                                       key_column_ids_, expr_type_,
+                                       ScanDirectionType::FORWARD,
+                                       tuple_location_ptrs);
   }
 
   LOG_TRACE("Result tuple count: %lu", tuple_location_ptrs.size());
@@ -358,6 +384,16 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
 
+    if (adapt_lower_block_ != INVALID_OID) {
+      // adaptive re-probe: only materialize the newly indexed block range,
+      // and skip tuples the initial probe already returned
+      if (tuple_location.block < adapt_lower_block_ ||
+          tuple_location.block > adapt_upper_block_ ||
+          item_pointers_.find(tuple_location) != item_pointers_.end()) {
+        continue;
+      }
+    }
+
     if (type_ == HybridScanType::HYBRID &&
         tuple_location.block >= (block_threshold)) {
       item_pointers_.insert(tuple_location);
@@ -389,6 +425,10 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
         ItemPointer old_item = tuple_location;
         cid_t old_end_cid = tile_group_header->GetEndCommitId(old_item.offset);
 
+        // cooperatively prune obsolete versions behind this one before
+        // stepping to the next version
+        transaction_manager.PruneVersionChain(tile_group_header, old_item);
+
         tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
         // there must exist a visible version.
         assert(tuple_location.IsNull() == false);
@@ -440,5 +480,34 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
   return true;
 }
 
+bool HybridScanExecutor::AdaptToIndexProbe() {
+  int indexed_offset = index_->GetIndexedTileGroupOff();
+  if (indexed_offset < 0 ||
+      static_cast<oid_t>(indexed_offset) < current_tile_group_offset_) {
+    // the index has not been backfilled past the scan position yet
+    return false;
+  }
+
+  oid_t upper_offset = std::min(static_cast<oid_t>(indexed_offset),
+                                table_tile_group_count_ - 1);
+  adapt_lower_block_ =
+      table_->GetTileGroup(current_tile_group_offset_)->GetTileGroupId();
+  adapt_upper_block_ = table_->GetTileGroup(upper_offset)->GetTileGroupId();
+
+  LOG_TRACE("Adaptive switch to index probe for blocks [%u, %u]",
+            adapt_lower_block_, adapt_upper_block_);
+
+  index_done_ = false;
+  ExecPrimaryIndexLookup();
+
+  adapt_lower_block_ = INVALID_OID;
+  adapt_upper_block_ = INVALID_OID;
+
+  // the sequential scan resumes behind the re-probed range
+  current_tile_group_offset_ = upper_offset + 1;
+
+  return IndexScanUtil();
+}
+
 }  // namespace executor
 }  // namespace peloton
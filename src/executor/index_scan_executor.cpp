@@ -12,6 +12,10 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
+
+#include "brain/sample.h"
+#include "catalog/catalog_defaults.h"
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
@@ -22,8 +26,10 @@
 #include "expression/abstract_expression.h"
 #include "index/index.h"
 #include "planner/index_scan_plan.h"
+#include "settings/settings_manager.h"
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "common/internal_types.h"
@@ -105,6 +111,78 @@ bool IndexScanExecutor::DInit() {
   if (table_ != nullptr) {
     full_column_ids_.resize(table_->GetSchema()->GetColumnCount());
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
+
+    // Feed the layout tuner a real access sample for this scan; catalog
+    // tables are never layout-tuned
+    if (settings::SettingsManager::GetBool(
+            settings::SettingId::layout_tuner)) {
+      auto data_table = dynamic_cast<storage::DataTable *>(
+          const_cast<storage::AbstractTable *>(table_));
+      if (data_table != nullptr &&
+          data_table->GetDatabaseOid() != CATALOG_DATABASE_OID) {
+        std::vector<double> columns_accessed(column_ids_.begin(),
+                                             column_ids_.end());
+        data_table->RecordLayoutSample(brain::Sample(columns_accessed));
+      }
+    }
+  }
+
+  // Decide whether this scan can be answered from index keys alone: every
+  // output column must be a key column (and fixed-width, so the key copy is
+  // a faithful replica), and there must be no residual predicate. Restricted
+  // to the primary key index, whose keys cannot go stale in a version chain.
+  index_only_scan_ = false;
+  key_output_positions_.clear();
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::index_only_scan) &&
+      index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY &&
+      predicate_ == nullptr && column_ids_.size() > 0) {
+    const auto &key_attrs = index_->GetMetadata()->GetKeyAttrs();
+    const auto *key_schema = index_->GetKeySchema();
+
+    bool covered = true;
+    for (auto column_id : column_ids_) {
+      auto key_itr = std::find(key_attrs.begin(), key_attrs.end(), column_id);
+      if (key_itr == key_attrs.end()) {
+        covered = false;
+        break;
+      }
+      key_output_positions_.push_back(
+          static_cast<oid_t>(key_itr - key_attrs.begin()));
+    }
+    if (covered) {
+      for (oid_t column_itr = 0; column_itr < key_schema->GetColumnCount();
+           column_itr++) {
+        if (key_schema->GetColumn(column_itr).IsInlined() == false) {
+          covered = false;
+          break;
+        }
+      }
+    }
+    index_only_scan_ = covered;
+  }
+
+  // Decide whether the index may answer a conjunction by skip scan. The
+  // index only skip-scans forward walks; with several OR'd conjunctions any
+  // skip-scannable one is enough, since the post-scan checks below must
+  // then cover the whole result anyway
+  skip_scan_ = false;
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::index_skip_scan) &&
+      descend_ == false) {
+    for (const auto &conjunction : index_predicate_.GetConjunctionList()) {
+      if (conjunction.IsSkipScannable()) {
+        skip_scan_ = true;
+        break;
+      }
+    }
+  }
+
+  // The covering-scan path realigns its key copies assuming the open-bound
+  // pruning only trims the two ends, which skip scans break; keep the two
+  // paths apart
+  if (skip_scan_) {
+    index_only_scan_ = false;
   }
 
   return true;
@@ -150,29 +228,46 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   std::vector<ItemPointer *> tuple_location_ptrs;
 
+  // Key copies paired with locations when running as an index-only scan
+  std::vector<std::pair<std::shared_ptr<storage::Tuple>, ItemPointer *>>
+      key_value_pairs;
+  bool index_only = false;
+
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
   PL_ASSERT(index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY);
 
+  // A skip scan can surface open-bound violators at every prefix-group
+  // boundary, so the end-pruning below is replaced by checking every
+  // returned location; the LIMIT cutoff must then not stop the collection
+  // early, since entries it counted may still be filtered out
+  const bool skip_scan_filter = skip_scan_ && (left_open_ || right_open_);
+
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
+    if (descend_) {
+      // ScanAllKeys() has no direction; reversing the ascending pass yields
+      // the descending key order the optimizer promised
+      std::reverse(tuple_location_ptrs.begin(), tuple_location_ptrs.end());
+    }
   } else {
-    // Limit clause accelerate
-    if (limit_) {
+    const auto &conjunction_list = index_predicate_.GetConjunctionList();
+
+    // Limit clause accelerate (single-probe scans only: with several OR'd
+    // probes the limit window is applied after the visibility pass)
+    if (limit_ && conjunction_list.size() == 1) {
       // invoke index scan limit
       if (!descend_) {
         LOG_TRACE("ASCENDING SCAN LIMIT in Primary Index");
         index_->ScanLimit(values_, key_column_ids_, expr_types_,
                           ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
+                          &conjunction_list[0], limit_number_, limit_offset_);
       } else {
         LOG_TRACE("DESCENDING SCAN LIMIT in Primary Index");
         index_->ScanLimit(values_, key_column_ids_, expr_types_,
                           ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
+                          &conjunction_list[0], limit_number_, limit_offset_);
 
         LOG_TRACE("1-Result size is %lu", result_.size());
       }
@@ -180,9 +275,26 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     // Normal SQL (without limit)
     else {
       LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
+      auto scan_direction =
+          descend_ ? ScanDirectionType::BACKWARD : ScanDirectionType::FORWARD;
+      if (index_only_scan_ && conjunction_list.size() == 1 &&
+          index_->ScanKeyValues(values_, key_column_ids_, expr_types_,
+                                scan_direction, key_value_pairs,
+                                &conjunction_list[0],
+                                executor_context_->GetPool())) {
+        // Covering scan: the output will come from the key copies; the
+        // locations are still needed for the visibility pass
+        index_only = true;
+        for (auto &key_value_pair : key_value_pairs) {
+          tuple_location_ptrs.push_back(key_value_pair.second);
+        }
+      } else {
+        // One probe per OR'd conjunction; for a single conjunction this
+        // is the plain scan the index always did
+        index_predicate_.ScanUnion(index_.get(), values_, key_column_ids_,
+                                   expr_types_, scan_direction,
+                                   tuple_location_ptrs);
+      }
     }
 
     LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
@@ -200,15 +312,32 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   auto &manager = catalog::Manager::GetInstance();
   std::vector<ItemPointer> visible_tuple_locations;
 
+  // Key copies of the visible entries, aligned with the locations above
+  std::vector<std::shared_ptr<storage::Tuple>> visible_keys;
+  size_t entry_itr = 0;
+
 #ifdef LOG_TRACE_ENABLED
   int num_tuples_examined = 0;
 #endif
 
   // for every tuple that is found in the index.
   for (auto tuple_location_ptr : tuple_location_ptrs) {
+    // Enough visible matches for the LIMIT window above: the remaining
+    // entries can never be returned, so skip their version-chain walks.
+    // With an open bound some collected entries may still be pruned after
+    // collection, so the cutoff would return short results; collect
+    // everything in that case
+    if (limit_ && left_open_ == false && right_open_ == false &&
+        visible_tuple_locations.size() >=
+            static_cast<size_t>(limit_offset_ + limit_number_)) {
+      break;
+    }
+    const size_t visible_count_before = visible_tuple_locations.size();
     ItemPointer tuple_location = *tuple_location_ptr;
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    // epoch-protected raw access: the scan runs inside the transaction's
+    // epoch, so no shared_ptr pin is needed per tuple
+    auto *tile_group = manager.GetTileGroupRaw(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     size_t chain_length = 0;
 
 #ifdef LOG_TRACE_ENABLED
@@ -238,7 +367,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
           LOG_TRACE("perform predicate evaluate");
-          ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+          ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                    tuple_location.offset);
           eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
@@ -281,13 +410,18 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupRaw(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
 
         ItemPointer old_item = tuple_location;
+
+        // cooperatively prune obsolete versions behind this one before
+        // stepping to the next version
+        transaction_manager.PruneVersionChain(tile_group_header, old_item);
+
         tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
 
         // there must exist a visible version.
@@ -306,11 +440,16 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupRaw(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
         continue;
       }
     }
+    if (index_only &&
+        visible_tuple_locations.size() > visible_count_before) {
+      visible_keys.push_back(key_value_pairs[entry_itr].first);
+    }
+    entry_itr++;
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
   }
   LOG_TRACE("Examined %d tuples from index %s", num_tuples_examined,
@@ -319,12 +458,66 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   LOG_TRACE("%ld tuples before pruning boundaries",
             visible_tuple_locations.size());
 
-  // Check whether the boundaries satisfy the required condition
+  // A skip scan enforces inclusive bounds per prefix group, so entries
+  // violating an open bound appear at every group boundary rather than only
+  // at the two ends; check every returned location instead of end-pruning
+  if (skip_scan_filter) {
+    size_t kept_itr = 0;
+    for (auto &visible_tuple_location : visible_tuple_locations) {
+      if (CheckKeyConditions(visible_tuple_location) == true) {
+        visible_tuple_locations[kept_itr++] = visible_tuple_location;
+      }
+    }
+    visible_tuple_locations.resize(kept_itr);
+
+    // The open bounds have been fully enforced
+    left_open_ = false;
+    right_open_ = false;
+  }
+
+  // Check whether the boundaries satisfy the required condition. The pruning
+  // only trims the two ends, so the survivors stay a contiguous slice; for an
+  // index-only scan, realign the key copies with that slice afterwards.
+  std::vector<ItemPointer> pre_prune_locations;
+  if (index_only) {
+    pre_prune_locations = visible_tuple_locations;
+  }
   CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
+  if (index_only &&
+      visible_keys.size() != visible_tuple_locations.size()) {
+    size_t front_removed = pre_prune_locations.size();
+    if (visible_tuple_locations.empty() == false) {
+      for (size_t location_itr = 0; location_itr < pre_prune_locations.size();
+           location_itr++) {
+        if (pre_prune_locations[location_itr].block ==
+                visible_tuple_locations.front().block &&
+            pre_prune_locations[location_itr].offset ==
+                visible_tuple_locations.front().offset) {
+          front_removed = location_itr;
+          break;
+        }
+      }
+    }
+    visible_keys.erase(visible_keys.begin(),
+                       visible_keys.begin() + front_removed);
+    visible_keys.resize(visible_tuple_locations.size());
+  }
 
   LOG_TRACE("%ld tuples after pruning boundaries",
             visible_tuple_locations.size());
 
+  // Covering scan: materialize the output from the key copies without
+  // reading any base tuples
+  if (index_only) {
+    BuildIndexOnlyResult(visible_keys);
+
+    done_ = true;
+
+    LOG_TRACE("Result tiles : %lu", result_.size());
+
+    return true;
+  }
+
   // Add the tuple locations to the result vector in the order returned by
   // the index scan. We might end up reading the same tile group multiple
   // times. However, this is necessary to adhere to the ORDER BY clause
@@ -379,6 +572,40 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   return true;
 }
 
+void IndexScanExecutor::BuildIndexOnlyResult(
+    const std::vector<std::shared_ptr<storage::Tuple>> &visible_keys) {
+  // Output schema: the projected columns, copied from the table schema
+  std::vector<catalog::Column> output_columns;
+  auto *table_schema = table_->GetSchema();
+  for (auto column_id : column_ids_) {
+    output_columns.push_back(table_schema->GetColumn(column_id));
+  }
+  catalog::Schema output_schema(output_columns);
+
+  size_t next_key = 0;
+  while (next_key < visible_keys.size()) {
+    size_t tile_size = std::min(size_t(DEFAULT_TUPLES_PER_TILEGROUP),
+                                visible_keys.size() - next_key);
+
+    std::shared_ptr<storage::Tile> ptile(storage::TileFactory::GetTile(
+        BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+        nullptr, output_schema, nullptr, tile_size));
+
+    for (size_t row_itr = 0; row_itr < tile_size; row_itr++) {
+      const auto &key = visible_keys[next_key + row_itr];
+      for (oid_t output_itr = 0; output_itr < column_ids_.size();
+           output_itr++) {
+        type::Value val = key->GetValue(key_output_positions_[output_itr]);
+        ptile->SetValue(val, row_itr, output_itr);
+      }
+    }
+
+    std::vector<std::shared_ptr<storage::Tile>> singleton({ptile});
+    result_.push_back(LogicalTileFactory::WrapTiles(singleton));
+    next_key += tile_size;
+  }
+}
+
 bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   LOG_TRACE("ExecSecondaryIndexLookup");
   PL_ASSERT(!done_);
@@ -391,22 +618,28 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
   if (0 == key_column_ids_.size()) {
     index_->ScanAllKeys(tuple_location_ptrs);
+    if (descend_) {
+      // ScanAllKeys() has no direction; reversing the ascending pass yields
+      // the descending key order the optimizer promised
+      std::reverse(tuple_location_ptrs.begin(), tuple_location_ptrs.end());
+    }
   } else {
-    // Limit clause accelerate
-    if (limit_) {
+    const auto &conjunction_list = index_predicate_.GetConjunctionList();
+
+    // Limit clause accelerate (single-probe scans only: with several OR'd
+    // probes the limit window is applied after the visibility pass)
+    if (limit_ && conjunction_list.size() == 1) {
       // invoke index scan limit
       if (!descend_) {
         LOG_TRACE("ASCENDING SCAN LIMIT in Secondary Index");
         index_->ScanLimit(values_, key_column_ids_, expr_types_,
                           ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
+                          &conjunction_list[0], limit_number_, limit_offset_);
       } else {
         LOG_TRACE("DESCENDING SCAN LIMIT in Secondary Index");
         index_->ScanLimit(values_, key_column_ids_, expr_types_,
                           ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
+                          &conjunction_list[0], limit_number_, limit_offset_);
 
         if (tuple_location_ptrs.size() == 0) {
           LOG_TRACE("2-Result size is %lu", tuple_location_ptrs.size());
@@ -415,10 +648,13 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     }
     // Normal SQL (without limit)
     else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
+      LOG_TRACE("Index Scan in Secondary Index");
+      // One probe per OR'd conjunction; for a single conjunction this is
+      // the plain scan the index always did
+      index_predicate_.ScanUnion(
+          index_.get(), values_, key_column_ids_, expr_types_,
+          descend_ ? ScanDirectionType::BACKWARD : ScanDirectionType::FORWARD,
+          tuple_location_ptrs);
     }
   }
 
@@ -441,7 +677,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // we got for each tuple and check whether its the same to avoid having
   // to go back to the catalog each time.
   oid_t last_block = INVALID_OID;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  storage::TileGroup *tile_group = nullptr;
   storage::TileGroupHeader *tile_group_header = nullptr;
 
 #ifdef LOG_TRACE_ENABLED
@@ -450,10 +686,20 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 #endif
 
   for (auto tuple_location_ptr : tuple_location_ptrs) {
+    // Enough visible matches for the LIMIT window above. As in the primary
+    // path, an open bound means collected entries may still be pruned after
+    // collection, so the cutoff must not fire then
+    if (limit_ && left_open_ == false && right_open_ == false &&
+        visible_tuple_locations.size() >=
+            static_cast<size_t>(limit_offset_ + limit_number_)) {
+      break;
+    }
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
-      tile_group = manager.GetTileGroup(tuple_location.block);
-      tile_group_header = tile_group.get()->GetHeader();
+      // epoch-protected raw access: the scan runs inside the transaction's
+      // epoch, so no shared_ptr pin is needed per tuple
+      tile_group = manager.GetTileGroupRaw(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
     else
@@ -486,8 +732,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
                   tuple_location.offset);
 
         // Further check if the version has the secondary key
-        ContainerTuple<storage::TileGroup> candidate_tuple(tile_group.get(),
-            tuple_location.offset);
+        ContainerTuple<storage::TileGroup> candidate_tuple(
+            tile_group, tuple_location.offset);
 
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
@@ -550,13 +796,18 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupRaw(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
 
         ItemPointer old_item = tuple_location;
+
+        // cooperatively prune obsolete versions behind this one before
+        // stepping to the next version
+        transaction_manager.PruneVersionChain(tile_group_header, old_item);
+
         tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
 
         if (tuple_location.IsNull()) {
@@ -579,8 +830,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupRaw(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
@@ -678,9 +929,8 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group = manager.GetTileGroup(tuple_location.block);
-  ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                           tuple_location.offset);
+  auto *tile_group = manager.GetTileGroupRaw(tuple_location.block);
+  ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_location.offset);
 
   // This is the end of loop
   oid_t cond_num = key_column_ids_.size();
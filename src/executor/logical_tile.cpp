@@ -10,11 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <sstream>
 #include "executor/logical_tile.h"
 
 #include "catalog/schema.h"
 #include "common/macros.h"
+#include "storage/cold_tier_cache.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
@@ -73,6 +75,7 @@ catalog::Schema *LogicalTile::GetPhysicalSchema() const {
  * @return Position lists of the tile.
  */
 const LogicalTile::PositionLists &LogicalTile::GetPositionLists() const {
+  MaterializeIdentityPositionList();
   return position_lists_;
 }
 
@@ -82,9 +85,23 @@ const LogicalTile::PositionLists &LogicalTile::GetPositionLists() const {
  */
 const LogicalTile::PositionList &LogicalTile::GetPositionList(
     const oid_t column_id) const {
+  MaterializeIdentityPositionList();
   return position_lists_[column_id];
 }
 
+void LogicalTile::MaterializeIdentityPositionList() const {
+  if (identity_position_list_ == false || position_lists_.size() > 0) {
+    return;
+  }
+
+  PositionList position_list;
+  position_list.reserve(total_tuples_);
+  for (oid_t tuple_id = 0; tuple_id < total_tuples_; tuple_id++) {
+    position_list.push_back(tuple_id);
+  }
+  position_lists_.push_back(std::move(position_list));
+}
+
 /**
  * @brief Set the position lists of the tile.
  * @param Position lists.
@@ -114,6 +131,7 @@ void LogicalTile::SetPositionListsAndVisibility(
  * @return Position list index of newly added list.
  */
 int LogicalTile::AddPositionList(LogicalTile::PositionList &&position_list) {
+  PL_ASSERT(identity_position_list_ == false);
   PL_ASSERT(position_lists_.size() == 0 ||
             position_lists_[0].size() == position_list.size());
 
@@ -129,6 +147,21 @@ int LogicalTile::AddPositionList(LogicalTile::PositionList &&position_list) {
   return position_lists_.size() - 1;
 }
 
+/**
+ * @brief Puts the tile into pass-through mode over a dense tile group
+ * prefix: every base tuple in [0, tuple_count) is visible and no explicit
+ * position list is built.
+ * @param tuple_count Number of base tuples covered by the tile.
+ */
+void LogicalTile::AddIdentityPositionList(const oid_t tuple_count) {
+  PL_ASSERT(position_lists_.size() == 0);
+
+  identity_position_list_ = true;
+  visible_tuples_ = tuple_count;
+  total_tuples_ = tuple_count;
+  visible_rows_.resize(tuple_count, true);
+}
+
 /**
  * @brief Remove visibility the specified tuple in the logical tile.
  * @param tuple_id Id of the specified tuple.
@@ -165,7 +198,9 @@ type::Value LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < total_tuples_);
 
   ColumnInfo &cp = schema_[column_id];
-  oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_id];
+  oid_t base_tuple_id = identity_position_list_
+                            ? tuple_id
+                            : position_lists_[cp.position_list_idx][tuple_id];
   storage::Tile *base_tile = cp.base_tile.get();
 
   if (base_tuple_id == NULL_OID) {
@@ -176,6 +211,79 @@ type::Value LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
   }
 }
 
+const oid_t LogicalTile::kDefaultPrefetchDistance;
+
+/**
+ * @brief Append the values of the given column for positions
+ * [start_pos, end_pos) to the output vector in one pass.
+ *
+ * The base-tile row backing the position prefetch_distance entries ahead
+ * is software-prefetched so that the dependent position-list and row
+ * loads overlap with the handling of the current value.
+ */
+void LogicalTile::GetValues(const oid_t column_id, const oid_t start_pos,
+                            const oid_t end_pos,
+                            std::vector<type::Value> &values,
+                            const oid_t prefetch_distance) {
+  PL_ASSERT(column_id < schema_.size());
+  PL_ASSERT(end_pos <= total_tuples_);
+
+  ColumnInfo &cp = schema_[column_id];
+  storage::Tile *base_tile = cp.base_tile.get();
+  const PositionList *position_list =
+      identity_position_list_ ? nullptr
+                              : &position_lists_[cp.position_list_idx];
+
+  values.reserve(values.size() + (end_pos - start_pos));
+
+  for (oid_t pos = start_pos; pos < end_pos; pos++) {
+    oid_t prefetch_pos = pos + prefetch_distance;
+    if (prefetch_pos < end_pos) {
+      oid_t prefetch_tuple_id =
+          (position_list != nullptr) ? (*position_list)[prefetch_pos]
+                                     : prefetch_pos;
+      if (prefetch_tuple_id != NULL_OID) {
+        __builtin_prefetch(base_tile->GetTupleLocation(prefetch_tuple_id), 0,
+                           3);
+      }
+    }
+
+    oid_t base_tuple_id =
+        (position_list != nullptr) ? (*position_list)[pos] : pos;
+    if (base_tuple_id == NULL_OID) {
+      values.push_back(type::ValueFactory::GetNullValueByType(
+          base_tile->GetSchema()->GetType(column_id)));
+    } else {
+      values.push_back(base_tile->GetValue(base_tuple_id,
+                                           cp.origin_column_id));
+    }
+  }
+}
+
+void LogicalTile::PrefetchValue(const oid_t column_id, const oid_t tuple_id) {
+  if (tuple_id >= total_tuples_) {
+    return;
+  }
+
+  ColumnInfo &cp = schema_[column_id];
+  oid_t base_tuple_id = identity_position_list_
+                            ? tuple_id
+                            : position_lists_[cp.position_list_idx][tuple_id];
+  if (base_tuple_id != NULL_OID) {
+    __builtin_prefetch(cp.base_tile->GetTupleLocation(base_tuple_id), 0, 3);
+  }
+}
+
+void LogicalTile::PrefetchTuple(const oid_t tuple_id) {
+  if (tuple_id >= total_tuples_) {
+    return;
+  }
+
+  for (oid_t column_id = 0; column_id < schema_.size(); column_id++) {
+    PrefetchValue(column_id, tuple_id);
+  }
+}
+
 // this function is designed for overriding pure virtual function.
 void LogicalTile::SetValue(type::Value &value UNUSED_ATTRIBUTE,
                            oid_t tuple_id UNUSED_ATTRIBUTE,
@@ -395,8 +503,26 @@ void LogicalTile::AddColumn(const std::shared_ptr<storage::Tile> &base_tile,
 void LogicalTile::AddColumns(
     const std::shared_ptr<storage::TileGroup> &tile_group,
     const std::vector<oid_t> &column_ids) {
+  // Scans funnel tile groups into the executor here; let the cold tier
+  // cache manage residency of any memory-mapped tiles
+  storage::ColdTierCache::GetInstance().OnTileGroupAccess(tile_group.get());
+
   const int position_list_idx = 0;
   for (oid_t origin_column_id : column_ids) {
+    // Columns added to the table after this tile group was built have no
+    // physical storage here. Attach the table's shared NULL-filled fill
+    // tile in their place, so every downstream consumer sees NULL without
+    // special-casing.
+    if (tile_group->HasColumn(origin_column_id) == false) {
+      auto *table =
+          dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PL_ASSERT(table != nullptr);
+      AddColumn(table->GetNullFillTile(origin_column_id,
+                                       tile_group->GetAllocatedTupleCount()),
+                0, position_list_idx);
+      continue;
+    }
+
     oid_t base_tile_offset, tile_column_id;
 
     tile_group->LocateTileAndColumn(origin_column_id, base_tile_offset,
@@ -438,7 +564,10 @@ std::vector<std::vector<std::string>> LogicalTile::GetAllValuesAsStrings(
     if (visible_rows_[tuple_itr] == false) continue;
     for (oid_t column_itr = 0; column_itr < schema_.size(); column_itr++) {
       const LogicalTile::ColumnInfo &cp = schema_[column_itr];
-      oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_itr];
+      oid_t base_tuple_id =
+          identity_position_list_
+              ? tuple_itr
+              : position_lists_[cp.position_list_idx][tuple_itr];
       // get the value from the base physical tile
       type::Value val;
       if (base_tuple_id == NULL_OID) {
@@ -465,20 +594,16 @@ std::vector<std::vector<std::string>> LogicalTile::GetAllValuesAsStrings(
         auto data_length =
             cp.base_tile->GetSchema()->GetLength(cp.origin_column_id);
         LOG_TRACE("data length: %ld", data_length);
-        char *val_binary = new char[data_length];
+        std::string val_binary(data_length, '\0');
         bool is_inlined = false;
 
-        val.SerializeTo(val_binary, is_inlined, nullptr);
+        val.SerializeTo(&val_binary[0], is_inlined, nullptr);
 
         // convert little endian to big endian...
         // TODO: This is stupid.... But I think this hack is fine for now.
-        for (size_t i = 0; i < (data_length >> 1); ++i) {
-          auto tmp_char = val_binary[i];
-          val_binary[i] = val_binary[data_length - i - 1];
-          val_binary[data_length - i - 1] = tmp_char;
-        }
+        std::reverse(val_binary.begin(), val_binary.end());
 
-        row.push_back(std::string(val_binary, data_length));
+        row.push_back(std::move(val_binary));
       }
     }
     string_tile.push_back(row);
@@ -497,7 +622,10 @@ const std::string LogicalTile::GetInfo() const {
     for (oid_t column_itr = 0; column_itr < schema_.size(); column_itr++) {
       const LogicalTile::ColumnInfo &cp = schema_[column_itr];
 
-      oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_itr];
+      oid_t base_tuple_id =
+          identity_position_list_
+              ? tuple_itr
+              : position_lists_[cp.position_list_idx][tuple_itr];
       // get the value from the base physical tile
       if (base_tuple_id == NULL_OID) {
         type::Value value = type::ValueFactory::GetNullValueByType(
@@ -12,7 +12,9 @@
 
 #include "executor/logical_tile_factory.h"
 
+#include "concurrency/epoch_manager_factory.h"
 #include "executor/logical_tile.h"
+#include "storage/cold_tier_cache.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/data_table.h"
@@ -84,6 +86,15 @@ LogicalTile *LogicalTileFactory::WrapTileGroup(
     const std::shared_ptr<storage::TileGroup> &tile_group) {
   std::unique_ptr<LogicalTile> new_tile(new LogicalTile());
 
+  // Record the access so the tiering service can tell hot tile groups apart
+  // from cold ones
+  tile_group->GetHeader()->SetLastAccessEpochId(
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId());
+
+  // ... and let the cold tier cache manage residency of any memory-mapped
+  // tiles
+  storage::ColdTierCache::GetInstance().OnTileGroupAccess(tile_group.get());
+
   const int position_list_idx = 0;
   new_tile->AddPositionList(
       CreateIdentityPositionList(tile_group->GetActiveTupleCount()));
@@ -20,6 +20,7 @@
 #include "executor/logical_tile_factory.h"
 #include "storage/tuple.h"
 #include "storage/data_table.h"
+#include "storage/dictionary_encoded_column.h"
 #include "storage/tile.h"
 
 namespace peloton {
@@ -133,7 +134,11 @@ void MaterializeRowAtAtATime(
     auto &schema = source_tile->GetSchema();
     oid_t new_tuple_id = 0;
 
-    auto &column_position_lists = source_tile->GetPositionLists();
+    // pass-through tiles have no explicit position lists; the tuple
+    // position is the base tuple id
+    const bool identity = source_tile->HasIdentityPositionList();
+    const LogicalTile::PositionLists *column_position_lists =
+        identity ? nullptr : &source_tile->GetPositionLists();
 
     // Get old column information
     std::vector<oid_t> old_column_position_idxs;
@@ -190,6 +195,14 @@ void MaterializeRowAtAtATime(
     // Copy all values in the tuple to the physical tile
     // This uses fast getter and setter functions
     for (oid_t old_tuple_id : *source_tile) {
+      // resolve and prefetch the base rows a few positions ahead of the
+      // copy loop to hide the position-list pointer chase
+      oid_t prefetch_tuple_id =
+          old_tuple_id + LogicalTile::kDefaultPrefetchDistance;
+      for (oid_t old_col_id : old_column_ids) {
+        source_tile->PrefetchValue(old_col_id, prefetch_tuple_id);
+      }
+
       ///////////////////////////
       // EACH COLUMN
       ///////////////////////////
@@ -197,9 +210,9 @@ void MaterializeRowAtAtATime(
       oid_t col_itr = 0;
 
       for (oid_t old_col_id : old_column_position_idxs) {
-        auto &column_position_list = column_position_lists[old_col_id];
-
-        oid_t base_tuple_id = column_position_list[old_tuple_id];
+        oid_t base_tuple_id =
+            identity ? old_tuple_id
+                     : (*column_position_lists)[old_col_id][old_tuple_id];
 
         type::Value value = (old_tiles[col_itr]->GetValueFast(
             base_tuple_id, old_column_offsets[col_itr],
@@ -264,18 +277,44 @@ void MaterializeColumnAtATime(
       const size_t new_column_length =
           new_schema->GetAppropriateLength(new_column_id);
 
-      // Get the position list
-      auto &column_position_list =
-          source_tile->GetPositionList(column_info.position_list_idx);
+      // Get the position list; pass-through tiles have none and use the
+      // tuple position directly
+      const bool identity = source_tile->HasIdentityPositionList();
+      const LogicalTile::PositionList *column_position_list =
+          identity ? nullptr
+                   : &source_tile->GetPositionList(
+                         column_info.position_list_idx);
       oid_t new_tuple_id = 0;
 
+      // If the source column is dictionary encoded, resolve the deferred
+      // dictionary lookups here instead of reading varlen pointers
+      const storage::DictionaryEncodedColumn *dict =
+          old_tile->GetDictionaryEncodedColumn(old_column_id);
+      if (dict != nullptr) {
+        for (oid_t old_tuple_id : *source_tile) {
+          source_tile->PrefetchValue(
+              old_col_id,
+              old_tuple_id + LogicalTile::kDefaultPrefetchDistance);
+          oid_t base_tuple_id =
+              identity ? old_tuple_id : (*column_position_list)[old_tuple_id];
+          type::Value value = dict->Decode(dict->GetCode(base_tuple_id));
+          dest_tile->SetValueFast(value, new_tuple_id, new_column_offset,
+                                  new_is_inlined, new_column_length);
+          new_tuple_id++;
+        }
+        continue;
+      }
+
       // Copy all values in the column to the physical tile
       // This uses fast getter and setter functions
       ///////////////////////////
       // EACH TUPLE
       ///////////////////////////
       for (oid_t old_tuple_id : *source_tile) {
-        oid_t base_tuple_id = column_position_list[old_tuple_id];
+        source_tile->PrefetchValue(
+            old_col_id, old_tuple_id + LogicalTile::kDefaultPrefetchDistance);
+        oid_t base_tuple_id =
+            identity ? old_tuple_id : (*column_position_list)[old_tuple_id];
         type::Value value = (
           old_tile->GetValueFast(base_tuple_id, old_column_offset,
             old_column_type, old_is_inlined));
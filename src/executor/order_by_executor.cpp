@@ -11,6 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 #include "common/logger.h"
 #include "executor/logical_tile.h"
@@ -19,11 +23,158 @@
 #include "executor/executor_context.h"
 
 #include "planner/order_by_plan.h"
+#include "settings/settings_manager.h"
 #include "storage/tile.h"
+#include "type/type.h"
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// Sort key types that can be normalized into a fixed-width,
+// memcmp-comparable byte string
+bool IsNormalizableSortKeyType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::DATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Encode one sort key value as a null byte followed by the value in
+// big-endian order with the sign bit flipped, so that unsigned bytewise
+// comparison matches the value order (NULLs sort first). A descending
+// column is stored with all bytes inverted.
+void EncodeNormalizedValue(const type::Value &val, type::TypeId type_id,
+                           bool descend, unsigned char *out, size_t width) {
+  if (val.IsNull()) {
+    PL_MEMSET(out, 0, width + 1);
+  } else {
+    out[0] = 1;
+    uint64_t bits = 0;
+    switch (type_id) {
+      case type::TypeId::BOOLEAN:
+      case type::TypeId::TINYINT:
+        bits = static_cast<uint64_t>(static_cast<int64_t>(val.GetAs<int8_t>()));
+        break;
+      case type::TypeId::SMALLINT:
+        bits =
+            static_cast<uint64_t>(static_cast<int64_t>(val.GetAs<int16_t>()));
+        break;
+      case type::TypeId::INTEGER:
+        bits =
+            static_cast<uint64_t>(static_cast<int64_t>(val.GetAs<int32_t>()));
+        break;
+      case type::TypeId::BIGINT:
+        bits = static_cast<uint64_t>(val.GetAs<int64_t>());
+        break;
+      case type::TypeId::TIMESTAMP:
+        bits = val.GetAs<uint64_t>();
+        break;
+      case type::TypeId::DATE:
+        bits = static_cast<uint64_t>(val.GetAs<uint32_t>());
+        break;
+      case type::TypeId::DECIMAL: {
+        double decimal = val.GetAs<double>();
+        std::memcpy(&bits, &decimal, sizeof(bits));
+        // Map IEEE 754 ordering onto unsigned integer ordering
+        if ((bits >> 63) != 0) {
+          bits = ~bits;
+        } else {
+          bits |= (1ULL << 63);
+        }
+        break;
+      }
+      default:
+        PL_ASSERT(false);
+    }
+    for (size_t byte_itr = 0; byte_itr < width; byte_itr++) {
+      out[1 + byte_itr] =
+          static_cast<unsigned char>(bits >> ((width - 1 - byte_itr) * 8));
+    }
+    // Two's complement to order-preserving: flip the sign bit. The unsigned
+    // types (timestamp, date) never set it and decimal was handled above.
+    switch (type_id) {
+      case type::TypeId::BOOLEAN:
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT:
+        out[1] ^= 0x80;
+        break;
+      default:
+        break;
+    }
+  }
+  if (descend) {
+    for (size_t byte_itr = 0; byte_itr <= width; byte_itr++) {
+      out[byte_itr] = static_cast<unsigned char>(~out[byte_itr]);
+    }
+  }
+}
+
+// Stable LSD radix sort over the leading key_width bytes of fixed-width
+// entries. The payload bytes after the key ride along untouched.
+void RadixSortEntries(std::vector<unsigned char> &entries,
+                      std::vector<unsigned char> &scratch, size_t entry_width,
+                      size_t key_width) {
+  size_t num_entries = entries.size() / entry_width;
+  scratch.resize(entries.size());
+
+  for (size_t byte_idx = key_width; byte_idx-- > 0;) {
+    std::array<size_t, 256> counts;
+    counts.fill(0);
+    for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+      counts[entries[entry_itr * entry_width + byte_idx]]++;
+    }
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < 256; bucket++) {
+      size_t bucket_count = counts[bucket];
+      counts[bucket] = offset;
+      offset += bucket_count;
+    }
+    for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+      const unsigned char *entry = &entries[entry_itr * entry_width];
+      size_t dest = counts[entry[byte_idx]]++;
+      std::memcpy(&scratch[dest * entry_width], entry, entry_width);
+    }
+    entries.swap(scratch);
+  }
+}
+
+// Wide keys: the O(key_width) radix passes stop paying off, so fall back
+// to a comparison sort over the same memcmp-comparable keys
+void SortEntriesWide(std::vector<unsigned char> &entries,
+                     std::vector<unsigned char> &scratch, size_t entry_width,
+                     size_t key_width) {
+  size_t num_entries = entries.size() / entry_width;
+  std::vector<const unsigned char *> entry_ptrs(num_entries);
+  for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+    entry_ptrs[entry_itr] = &entries[entry_itr * entry_width];
+  }
+  std::stable_sort(entry_ptrs.begin(), entry_ptrs.end(),
+                   [&](const unsigned char *a, const unsigned char *b) {
+                     return std::memcmp(a, b, key_width) < 0;
+                   });
+  scratch.resize(entries.size());
+  for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+    std::memcpy(&scratch[entry_itr * entry_width], entry_ptrs[entry_itr],
+                entry_width);
+  }
+  entries.swap(scratch);
+}
+
+}  // namespace
+
 /**
  * @brief Constructor
  * @param node  OrderByNode plan node corresponding to this executor
@@ -63,7 +214,7 @@ bool OrderByExecutor::DExecute() {
 
   if (!sort_done_) DoSort();
 
-  if (!(num_tuples_returned_ < sort_buffer_.size())) {
+  if (!(num_tuples_returned_ < sorted_pointers_.size())) {
     return false;
   }
 
@@ -75,7 +226,7 @@ bool OrderByExecutor::DExecute() {
   // NOTE: the schema of these tiles might not match the input tiles when some of the order by columns are not be part of the output schema
 
   size_t tile_size = std::min(size_t(DEFAULT_TUPLES_PER_TILEGROUP),
-                              sort_buffer_.size() - num_tuples_returned_);
+                              sorted_pointers_.size() - num_tuples_returned_);
 
   std::shared_ptr<storage::Tile> ptile(storage::TileFactory::GetTile(
       BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
@@ -83,9 +234,9 @@ bool OrderByExecutor::DExecute() {
 
   for (size_t id = 0; id < tile_size; id++) {
     oid_t source_tile_id =
-        sort_buffer_[num_tuples_returned_ + id].item_pointer.block;
+        sorted_pointers_[num_tuples_returned_ + id].block;
     oid_t source_tuple_id =
-        sort_buffer_[num_tuples_returned_ + id].item_pointer.offset;
+        sorted_pointers_[num_tuples_returned_ + id].offset;
     // Insert a physical tuple into physical tile
     for (oid_t i = 0; i < output_schema_->GetColumnCount(); i++) {
       type::Value val =
@@ -103,7 +254,7 @@ bool OrderByExecutor::DExecute() {
 
   num_tuples_returned_ += tile_size;
 
-  PL_ASSERT(num_tuples_returned_ <= sort_buffer_.size());
+  PL_ASSERT(num_tuples_returned_ <= sorted_pointers_.size());
 
   return true;
 }
@@ -159,7 +310,34 @@ bool OrderByExecutor::DoSort() {
   output_column_ids_ = node.GetOutputColumnIds();
   sort_key_tuple_schema_.reset(new catalog::Schema(sort_key_columns));
   output_schema_.reset(new catalog::Schema(output_key_columns));
-  auto executor_pool = executor_context_->GetPool();
+
+  // If the underlying result has the same order, it is not necessary to sort
+  // the result again. Return the tuples in input order.
+  if (underling_ordered_) {
+    LOG_TRACE("underling_ordered works and already get all tuples (%lu)",
+              count);
+    sorted_pointers_.reserve(count);
+    for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
+      for (oid_t tuple_id : *input_tiles_[tile_id]) {
+        sorted_pointers_.emplace_back(tile_id, tuple_id);
+      }
+    }
+    sort_done_ = true;
+    return true;
+  }
+
+  // Fast path: when every sort key is a fixed-width orderable type, sort
+  // normalized byte-string keys instead of tuples, avoiding the
+  // Value-dispatch chain on every comparison
+  if (SortNormalized(node, count)) {
+    sort_done_ = true;
+    return true;
+  }
+
+  // The sort keys are only needed until sorted_pointers_ is built, so their
+  // varlen copies go into a sub-pool this operator releases at the end of
+  // the sort instead of holding them until query end
+  auto executor_pool = executor_context_->GetScopedPool(this);
 
   // Extract all valid tuples into a single std::vector (the sort buffer)
   sort_buffer_.reserve(count);
@@ -181,15 +359,6 @@ bool OrderByExecutor::DoSort() {
 
   PL_ASSERT(count == sort_buffer_.size());
 
-  // If the underlying result has the same order, it is not necessary to sort
-  // the result again. Instead, go to the end.
-  if (underling_ordered_) {
-    LOG_TRACE("underling_ordered works and already get all tuples (%lu)",
-              count);
-    sort_done_ = true;
-    return true;
-  }
-
   // Prepare the compare function
   // Note: This is a less-than comparer, NOT an equality comparer.
   struct TupleComparer {
@@ -223,16 +392,297 @@ bool OrderByExecutor::DoSort() {
   TupleComparer comp(descend_flags_);
 
   // Finally ... sort it !
-  std::sort(
-      sort_buffer_.begin(), sort_buffer_.end(),
-      [&comp](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
-        return comp(a.tuple.get(), b.tuple.get());
-      });
+  // With a LIMIT above, only the first limit_offset_ + limit_number_
+  // entries can be returned, so a partial sort suffices
+  size_t sort_bound = sort_buffer_.size();
+  if (limit_) {
+    sort_bound = std::min<size_t>(
+        sort_bound, static_cast<size_t>(limit_offset_ + limit_number_));
+  }
+  if (sort_bound < sort_buffer_.size()) {
+    std::partial_sort(
+        sort_buffer_.begin(), sort_buffer_.begin() + sort_bound,
+        sort_buffer_.end(),
+        [&comp](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
+          return comp(a.tuple.get(), b.tuple.get());
+        });
+    sort_buffer_.erase(sort_buffer_.begin() + sort_bound,
+                       sort_buffer_.end());
+  } else {
+    std::sort(
+        sort_buffer_.begin(), sort_buffer_.end(),
+        [&comp](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
+          return comp(a.tuple.get(), b.tuple.get());
+        });
+  }
+
+  sorted_pointers_.reserve(count);
+  for (auto &entry : sort_buffer_) {
+    sorted_pointers_.push_back(entry.item_pointer);
+  }
+
+  // Output is driven purely by sorted_pointers_ into the input tiles; drop
+  // the key tuples and their sub-pool wholesale
+  sort_buffer_.clear();
+  executor_context_->ReleaseScopedPool(this);
 
   sort_done_ = true;
 
   return true;
 }
 
+bool OrderByExecutor::SortNormalized(const planner::OrderByPlan &node,
+                                     size_t count) {
+  const auto &sort_keys = node.GetSortKeys();
+
+  // Compute the key layout: one null byte plus the big-endian value per
+  // sort column
+  std::vector<size_t> column_widths;
+  size_t key_width = 0;
+  for (oid_t id = 0; id < sort_keys.size(); id++) {
+    type::TypeId type_id = sort_key_tuple_schema_->GetType(id);
+    if (IsNormalizableSortKeyType(type_id) == false) {
+      return false;
+    }
+    size_t width = type::Type::GetTypeSize(type_id);
+    column_widths.push_back(width);
+    key_width += 1 + width;
+  }
+
+  // An entry is the normalized key followed by the tuple position
+  const size_t entry_width = key_width + sizeof(ItemPointer);
+  size_t budget_bytes = static_cast<size_t>(settings::SettingsManager::GetInt(
+                            settings::SettingId::sort_buffer_mb)) *
+                        1024 * 1024;
+  size_t max_run_entries = std::max<size_t>(budget_bytes / entry_width, 1024);
+
+  std::vector<unsigned char> entries;
+  std::vector<unsigned char> scratch;
+  entries.reserve(std::min(count, max_run_entries) * entry_width);
+
+  // Sorted runs spilled to disk when the budget is exceeded
+  FILE *spill_file = nullptr;
+  std::vector<size_t> run_entry_counts;
+
+  auto sort_run = [&]() {
+    if (key_width <= 16) {
+      RadixSortEntries(entries, scratch, entry_width, key_width);
+    } else {
+      SortEntriesWide(entries, scratch, entry_width, key_width);
+    }
+  };
+
+  // Top-K: a LIMIT above caps the output at limit_offset_ + limit_number_
+  // tuples, so only that many keys can survive the sort. Keep them in a
+  // bounded max-heap of normalized keys instead of buffering (and possibly
+  // spilling) the whole input, then sort just the survivors.
+  size_t top_k = 0;
+  if (limit_) {
+    top_k = static_cast<size_t>(limit_offset_ + limit_number_);
+  }
+  if (top_k > 0 && top_k < count && top_k <= max_run_entries) {
+    std::vector<unsigned char> heap_entries;
+    heap_entries.reserve(top_k * entry_width);
+    // Entry slots ordered as a max-heap on the normalized key, so the
+    // largest kept key is always at the root
+    std::vector<size_t> heap;
+    heap.reserve(top_k);
+    auto heap_less = [&](size_t a, size_t b) {
+      return std::memcmp(&heap_entries[a * entry_width],
+                         &heap_entries[b * entry_width], key_width) < 0;
+    };
+    std::vector<unsigned char> candidate(entry_width);
+
+    for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
+      for (oid_t tuple_id : *input_tiles_[tile_id]) {
+        unsigned char *out = candidate.data();
+        for (oid_t id = 0; id < sort_keys.size(); id++) {
+          type::Value val =
+              (input_tiles_[tile_id]->GetValue(tuple_id, sort_keys[id]));
+          EncodeNormalizedValue(val, sort_key_tuple_schema_->GetType(id),
+                                descend_flags_[id], out, column_widths[id]);
+          out += 1 + column_widths[id];
+        }
+        ItemPointer location(tile_id, tuple_id);
+        std::memcpy(out, &location, sizeof(ItemPointer));
+
+        if (heap.size() < top_k) {
+          size_t slot = heap.size();
+          heap_entries.insert(heap_entries.end(), candidate.begin(),
+                              candidate.end());
+          heap.push_back(slot);
+          std::push_heap(heap.begin(), heap.end(), heap_less);
+        } else if (std::memcmp(candidate.data(),
+                               &heap_entries[heap.front() * entry_width],
+                               key_width) < 0) {
+          // Evict the current maximum and reuse its slot
+          std::pop_heap(heap.begin(), heap.end(), heap_less);
+          std::memcpy(&heap_entries[heap.back() * entry_width],
+                      candidate.data(), entry_width);
+          std::push_heap(heap.begin(), heap.end(), heap_less);
+        }
+      }
+    }
+
+    entries.swap(heap_entries);
+    sort_run();
+    size_t num_entries = entries.size() / entry_width;
+    sorted_pointers_.reserve(num_entries);
+    for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+      ItemPointer location;
+      std::memcpy(&location, &entries[entry_itr * entry_width + key_width],
+                  sizeof(ItemPointer));
+      sorted_pointers_.push_back(location);
+    }
+    return true;
+  }
+
+  auto spill_run = [&]() -> bool {
+    if (spill_file == nullptr) {
+      spill_file = std::tmpfile();
+      if (spill_file == nullptr) {
+        LOG_ERROR("Failed to create sort spill file; sorting in memory");
+        return false;
+      }
+    }
+    sort_run();
+    if (std::fwrite(entries.data(), 1, entries.size(), spill_file) !=
+        entries.size()) {
+      LOG_ERROR("Failed to write sort spill run; sorting in memory");
+      return false;
+    }
+    run_entry_counts.push_back(entries.size() / entry_width);
+    entries.clear();
+    return true;
+  };
+
+  // Extract and normalize the sort key of every valid input tuple
+  bool spill_failed = false;
+  for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
+    for (oid_t tuple_id : *input_tiles_[tile_id]) {
+      if (spill_failed == false &&
+          entries.size() / entry_width >= max_run_entries) {
+        if (spill_run() == false) spill_failed = true;
+      }
+      size_t entry_offset = entries.size();
+      entries.resize(entry_offset + entry_width);
+      unsigned char *out = &entries[entry_offset];
+      for (oid_t id = 0; id < sort_keys.size(); id++) {
+        type::Value val =
+            (input_tiles_[tile_id]->GetValue(tuple_id, sort_keys[id]));
+        EncodeNormalizedValue(val, sort_key_tuple_schema_->GetType(id),
+                              descend_flags_[id], out, column_widths[id]);
+        out += 1 + column_widths[id];
+      }
+      ItemPointer location(tile_id, tuple_id);
+      std::memcpy(out, &location, sizeof(ItemPointer));
+    }
+  }
+
+  sorted_pointers_.reserve(count);
+
+  if (run_entry_counts.empty() || spill_failed) {
+    // Everything fit in memory (or spilling failed): one sorted run
+    sort_run();
+    size_t num_entries = entries.size() / entry_width;
+    for (size_t entry_itr = 0; entry_itr < num_entries; entry_itr++) {
+      ItemPointer location;
+      std::memcpy(&location, &entries[entry_itr * entry_width + key_width],
+                  sizeof(ItemPointer));
+      sorted_pointers_.push_back(location);
+    }
+    if (spill_file != nullptr) std::fclose(spill_file);
+    return true;
+  }
+
+  // Spill the final partial run, then merge all runs off disk
+  if (entries.empty() == false && spill_run() == false) {
+    // Could not finish spilling; fall back to the tuple-based sort
+    std::fclose(spill_file);
+    sorted_pointers_.clear();
+    return false;
+  }
+  entries.shrink_to_fit();
+  scratch.clear();
+  scratch.shrink_to_fit();
+
+  // One buffered cursor per run; runs are laid out back to back in the file
+  struct RunCursor {
+    size_t file_offset;    // next unread byte of this run in the file
+    size_t entries_left;   // entries not yet consumed (buffered or on disk)
+    size_t buffer_offset;  // next entry in the refill buffer
+    std::vector<unsigned char> buffer;
+  };
+
+  const size_t refill_entries = 1024;
+  std::vector<RunCursor> cursors(run_entry_counts.size());
+  size_t file_offset = 0;
+  for (size_t run_itr = 0; run_itr < run_entry_counts.size(); run_itr++) {
+    cursors[run_itr].file_offset = file_offset;
+    cursors[run_itr].entries_left = run_entry_counts[run_itr];
+    cursors[run_itr].buffer_offset = 0;
+    file_offset += run_entry_counts[run_itr] * entry_width;
+  }
+
+  auto refill = [&](RunCursor &cursor) -> bool {
+    size_t buffered =
+        cursor.buffer.size() / entry_width - cursor.buffer_offset;
+    if (buffered > 0) return true;
+    size_t on_disk = cursor.entries_left;
+    if (on_disk == 0) return false;
+    size_t to_read = std::min(on_disk, refill_entries);
+    cursor.buffer.resize(to_read * entry_width);
+    cursor.buffer_offset = 0;
+    if (std::fseek(spill_file, static_cast<long>(cursor.file_offset),
+                   SEEK_SET) != 0 ||
+        std::fread(cursor.buffer.data(), 1, cursor.buffer.size(),
+                   spill_file) != cursor.buffer.size()) {
+      LOG_ERROR("Failed to read sort spill run");
+      return false;
+    }
+    cursor.file_offset += cursor.buffer.size();
+    return true;
+  };
+
+  // K-way merge: the runs are individually sorted, so repeatedly take the
+  // smallest head key. Ties go to the earliest run, keeping the merge stable.
+  for (size_t merged = 0; merged < count; merged++) {
+    RunCursor *min_cursor = nullptr;
+    for (auto &cursor : cursors) {
+      if (refill(cursor) == false) continue;
+      if (min_cursor == nullptr ||
+          std::memcmp(&cursor.buffer[cursor.buffer_offset * entry_width],
+                      &min_cursor->buffer[min_cursor->buffer_offset *
+                                          entry_width],
+                      key_width) < 0) {
+        min_cursor = &cursor;
+      }
+    }
+    if (min_cursor == nullptr) {
+      LOG_ERROR("Sort spill merge ran out of entries early");
+      std::fclose(spill_file);
+      sorted_pointers_.clear();
+      return false;
+    }
+    ItemPointer location;
+    std::memcpy(
+        &location,
+        &min_cursor->buffer[min_cursor->buffer_offset * entry_width +
+                            key_width],
+        sizeof(ItemPointer));
+    sorted_pointers_.push_back(location);
+    min_cursor->buffer_offset++;
+    min_cursor->entries_left--;
+    if (min_cursor->buffer_offset * entry_width ==
+        min_cursor->buffer.size()) {
+      min_cursor->buffer.clear();
+      min_cursor->buffer_offset = 0;
+    }
+  }
+
+  std::fclose(spill_file);
+  return true;
+}
+
 }  // namespace executor
 }  // namespace peloton
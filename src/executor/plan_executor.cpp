@@ -17,11 +17,17 @@
 #include "codegen/query_cache.h"
 #include "codegen/query_compiler.h"
 #include "common/logger.h"
+#include "common/synchronization/spin_latch.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "executor/executors.h"
+#include "executor/query_progress_registry.h"
 #include "settings/settings_manager.h"
 #include "storage/tuple_iterator.h"
+#include "threadpool/mono_queue_pool.h"
+
+#include <algorithm>
+#include <unordered_set>
 
 namespace peloton {
 namespace executor {
@@ -32,51 +38,310 @@ executor::AbstractExecutor *BuildExecutorTree(
 
 void CleanExecutorTree(executor::AbstractExecutor *root);
 
+namespace {
+
+// Publish a query in the live registry for the duration of a scope, so it
+// leaves pg_query_progress on every path out of the executor, error paths
+// included
+class ProgressRegistration {
+ public:
+  explicit ProgressRegistration(const std::string &query_text)
+      : entry_(QueryProgressRegistry::GetInstance().Register(query_text)) {}
+
+  ~ProgressRegistration() {
+    QueryProgressRegistry::GetInstance().Unregister(entry_->query_id_);
+  }
+
+  const std::shared_ptr<QueryProgressRegistry::Entry> &GetEntry() const {
+    return entry_;
+  }
+
+ private:
+  std::shared_ptr<QueryProgressRegistry::Entry> entry_;
+};
+
+// Plan shapes whose compilation has been handed to a background worker but
+// has not landed in the query cache yet. Keyed like the query cache so a hot
+// query shape is only compiled once no matter how many executions race by.
+class InFlightCompilations {
+ public:
+  // Claim the plan for compilation. Returns false if a worker already has it.
+  bool TryBegin(const std::shared_ptr<planner::AbstractPlan> &plan) {
+    latch_.Lock();
+    bool claimed = compiling_.insert(plan).second;
+    latch_.Unlock();
+    return claimed;
+  }
+
+  void Finish(const std::shared_ptr<planner::AbstractPlan> &plan) {
+    latch_.Lock();
+    compiling_.erase(plan);
+    latch_.Unlock();
+  }
+
+ private:
+  common::synchronization::SpinLatch latch_;
+  std::unordered_set<std::shared_ptr<planner::AbstractPlan>, planner::Hash,
+                     planner::Equal> compiling_;
+};
+
+InFlightCompilations in_flight_compilations;
+
+// Plan shapes whose executors fully re-initialize themselves in DInit(),
+// making their trees safe to cache on the statement and run repeatedly.
+// This deliberately targets the read path of prepared statements (point
+// lookups in particular), where tree construction is a measurable share of
+// per-execution work.
+bool CacheableExecutorTree(const planner::AbstractPlan *plan) {
+  switch (plan->GetPlanNodeType()) {
+    case PlanNodeType::INDEXSCAN:
+    case PlanNodeType::SEQSCAN:
+    case PlanNodeType::PROJECTION:
+    case PlanNodeType::LIMIT:
+      break;
+    default:
+      return false;
+  }
+  for (auto &child : plan->GetChildren()) {
+    if (CacheableExecutorTree(child.get()) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The optimization tier new compilations start at. With tiered compilation
+// enabled, queries are first compiled fast and recompiled at the full tier
+// once they turn hot.
+codegen::OptimizationLevel FirstTierLevel() {
+  int recompile_threshold = settings::SettingsManager::GetInt(
+      settings::SettingId::codegen_recompile_threshold);
+  return (recompile_threshold > 0) ? codegen::OptimizationLevel::kFast
+                                   : codegen::OptimizationLevel::kFull;
+}
+
+// Recompile the plan at the full optimization tier on a MonoQueuePool worker
+// and hot-swap the result into the cached fast-tier query.
+void SubmitBackgroundRecompilation(
+    const std::shared_ptr<planner::AbstractPlan> &plan,
+    const std::vector<type::Value> &params) {
+  std::shared_ptr<planner::AbstractPlan> plan_copy{plan->Copy()};
+  threadpool::MonoQueuePool::GetInstance().SubmitTask([plan_copy, params]() {
+    try {
+      planner::BindingContext context;
+      plan_copy->PerformBinding(context);
+
+      std::vector<oid_t> columns;
+      plan_copy->GetOutputColumns(columns);
+      codegen::BufferingConsumer consumer{columns, context};
+
+      codegen::QueryParameters parameters(*plan_copy, params);
+
+      codegen::QueryCompiler compiler;
+      auto optimized = compiler.Compile(
+          *plan_copy, parameters.GetQueryParametersMap(), consumer, nullptr,
+          codegen::OptimizationLevel::kFull);
+
+      // The cache entry may have been evicted while we compiled; if it is
+      // still there, delegate its future executions to the optimized code
+      codegen::Query *cached = codegen::QueryCache::Instance().Find(plan_copy);
+      if (cached != nullptr && cached->IsFullyOptimized() == false) {
+        cached->TierUp(plan_copy, std::move(optimized));
+      }
+    } catch (Exception &e) {
+      LOG_ERROR("Background recompilation failed: %s", e.what());
+    }
+  });
+}
+
+// Compile a variant of the plan with the given parameter values folded in as
+// constants on a MonoQueuePool worker, and attach it to the cached query.
+// The cached query only routes executions whose parameters match the pinned
+// values to the variant, so stale profiles cost nothing but the compile.
+void SubmitBackgroundSpecialization(
+    const std::shared_ptr<planner::AbstractPlan> &plan,
+    const std::vector<type::Value> &params,
+    const codegen::ParameterCache::PinnedValues &pinned) {
+  std::shared_ptr<planner::AbstractPlan> plan_copy{plan->Copy()};
+  threadpool::MonoQueuePool::GetInstance().SubmitTask([plan_copy, params,
+                                                       pinned]() {
+    try {
+      planner::BindingContext context;
+      plan_copy->PerformBinding(context);
+
+      std::vector<oid_t> columns;
+      plan_copy->GetOutputColumns(columns);
+      codegen::BufferingConsumer consumer{columns, context};
+
+      codegen::QueryParameters parameters(*plan_copy, params);
+
+      codegen::QueryCompiler compiler;
+      auto specialized = compiler.Compile(
+          *plan_copy, parameters.GetQueryParametersMap(), consumer, nullptr,
+          codegen::OptimizationLevel::kFull, &pinned);
+
+      // The cache entry may have been evicted while we compiled; if it is
+      // still there, route matching executions to the specialized code
+      codegen::Query *cached = codegen::QueryCache::Instance().Find(plan_copy);
+      if (cached != nullptr) {
+        cached->Specialize(plan_copy, std::move(specialized), pinned);
+      }
+    } catch (Exception &e) {
+      LOG_ERROR("Background specialization failed: %s", e.what());
+    }
+  });
+}
+
+// Compile the plan on a MonoQueuePool worker and publish the result in the
+// query cache. The plan is copied so compilation-time binding never touches
+// the tree the caller is interpreting concurrently.
+void SubmitBackgroundCompilation(
+    const std::shared_ptr<planner::AbstractPlan> &plan,
+    const std::vector<type::Value> &params) {
+  if (in_flight_compilations.TryBegin(plan) == false) {
+    return;
+  }
+
+  std::shared_ptr<planner::AbstractPlan> plan_copy{plan->Copy()};
+  threadpool::MonoQueuePool::GetInstance().SubmitTask([plan, plan_copy,
+                                                       params]() {
+    try {
+      planner::BindingContext context;
+      plan_copy->PerformBinding(context);
+
+      std::vector<oid_t> columns;
+      plan_copy->GetOutputColumns(columns);
+      codegen::BufferingConsumer consumer{columns, context};
+
+      codegen::QueryParameters parameters(*plan_copy, params);
+
+      codegen::QueryCompiler compiler;
+      auto compiled_query = compiler.Compile(
+          *plan_copy, parameters.GetQueryParametersMap(), consumer, nullptr,
+          FirstTierLevel());
+      codegen::QueryCache::Instance().Add(plan_copy, std::move(compiled_query));
+    } catch (Exception &e) {
+      LOG_ERROR("Background compilation failed: %s", e.what());
+    }
+    in_flight_compilations.Finish(plan);
+  });
+}
+
+}  // namespace
+
 static void CompileAndExecutePlan(
     std::shared_ptr<planner::AbstractPlan> plan,
     concurrency::TransactionContext *txn,
     const std::vector<type::Value> &params,
+    const std::vector<int> &result_format,
     std::function<void(executor::ExecutionResult, std::vector<ResultValue> &&)>
-        on_complete) {
+        on_complete,
+    const std::shared_ptr<QueryProgressRegistry::Entry> &progress_entry) {
   LOG_TRACE("Compiling and executing query ...");
 
   // Perform binding
   planner::BindingContext context;
   plan->PerformBinding(context);
 
-  // Prepare output buffer
+  // Prepare output buffer. Batches of output tuples are marshalled into
+  // result values as the pipelines produce them, so only one batch of
+  // buffered tuples is alive at a time instead of the whole result set.
   std::vector<oid_t> columns;
   plan->GetOutputColumns(columns);
-  codegen::BufferingConsumer consumer{columns, context};
+
+  std::vector<ResultValue> values;
+  auto marshal_batch = [&values, &result_format, &progress_entry](
+      const std::vector<codegen::WrappedTuple> &batch) {
+    if (progress_entry != nullptr) {
+      progress_entry->rows_produced_.fetch_add(batch.size(),
+                                               std::memory_order_relaxed);
+    }
+    for (const auto &tuple : batch) {
+      for (uint32_t i = 0; i < tuple.tuple_.size(); i++) {
+        auto column_val = tuple.GetValue(i);
+        if (column_val.IsNull()) {
+          // materialize NULL values as 0B string
+          values.push_back("");
+        } else if (i < result_format.size() && result_format[i] != 0 &&
+                   column_val.GetTypeId() != type::TypeId::VARCHAR) {
+          // binary result format: the value's fixed-width storage form,
+          // byte-swapped to network order, like the interpreted path in
+          // LogicalTile::GetAllValuesAsStrings()
+          size_t data_length = type::Type::GetTypeSize(column_val.GetTypeId());
+          std::string binary(data_length, '\0');
+          column_val.SerializeTo(&binary[0], false, nullptr);
+          std::reverse(binary.begin(), binary.end());
+          values.push_back(std::move(binary));
+        } else {
+          auto str = column_val.ToString();
+          LOG_TRACE("column content: [%s]", str.c_str());
+          values.push_back(std::move(str));
+        }
+      }
+    }
+  };
+
+  int batch_size_setting = settings::SettingsManager::GetInt(
+      settings::SettingId::codegen_result_batch_size);
+  size_t batch_size =
+      (batch_size_setting > 0) ? static_cast<size_t>(batch_size_setting) : 0;
+  codegen::BufferingConsumer consumer{columns, context, batch_size,
+                                      marshal_batch};
 
   std::unique_ptr<executor::ExecutorContext> executor_context(
       new executor::ExecutorContext(txn,
                                     codegen::QueryParameters(*plan, params)));
+  executor_context->SetProgressEntry(progress_entry);
+  executor_context->SetExecutionPhase("compile");
 
   // Compile the query
   codegen::Query *query = codegen::QueryCache::Instance().Find(plan);
   if (query == nullptr) {
     codegen::QueryCompiler compiler;
     auto compiled_query = compiler.Compile(
-        *plan, executor_context->GetParams().GetQueryParametersMap(), consumer);
+        *plan, executor_context->GetParams().GetQueryParametersMap(), consumer,
+        nullptr, FirstTierLevel());
     query = compiled_query.get();
     codegen::QueryCache::Instance().Add(plan, std::move(compiled_query));
   }
 
-  auto on_query_result =
-      [&on_complete, &consumer](executor::ExecutionResult result) {
-        std::vector<ResultValue> values;
-        for (const auto &tuple : consumer.GetOutputTuples()) {
-          for (uint32_t i = 0; i < tuple.tuple_.size(); i++) {
-            auto column_val = tuple.GetValue(i);
-            auto str = column_val.IsNull() ? "" : column_val.ToString();
-            LOG_TRACE("column content: [%s]", str.c_str());
-            values.push_back(std::move(str));
-          }
-        }
-        on_complete(result, std::move(values));
-      };
+  // Tiered compilation: once a fast-tier query has proven hot, recompile it
+  // at the full optimization tier in the background and hot-swap the result
+  int recompile_threshold = settings::SettingsManager::GetInt(
+      settings::SettingId::codegen_recompile_threshold);
+  uint64_t executions = query->IncrementExecutionCount();
+  if (recompile_threshold > 0 && query->IsFullyOptimized() == false &&
+      executions >= static_cast<uint64_t>(recompile_threshold) &&
+      query->BeginRecompilation()) {
+    SubmitBackgroundRecompilation(plan, params);
+  }
+
+  // Parameter specialization: profile the parameter values this query is
+  // executed with, and once one value dominates a parameter, compile a
+  // variant with it folded in as a constant. Executions still carrying the
+  // hot values run the specialized code; the rest keep the generic code.
+  int specialization_threshold = settings::SettingsManager::GetInt(
+      settings::SettingId::codegen_specialization_threshold);
+  if (specialization_threshold > 0 && !query->SpecializationClaimed()) {
+    query->RecordParameterValues(executor_context->GetParams());
+    codegen::ParameterCache::PinnedValues pinned;
+    if (query->HasStableParameterProfile(
+            static_cast<uint64_t>(specialization_threshold), pinned) &&
+        query->BeginSpecialization()) {
+      SubmitBackgroundSpecialization(plan, params, pinned);
+    }
+  }
 
+  auto on_query_result = [&on_complete, &consumer, &marshal_batch,
+                          &values](executor::ExecutionResult result) {
+    // drain the final partial batch the callback has not seen yet
+    marshal_batch(consumer.GetOutputTuples());
+    on_complete(result, std::move(values));
+  };
+
+  if (progress_entry != nullptr) {
+    progress_entry->phase_.store("execute", std::memory_order_relaxed);
+  }
   query->Execute(std::move(executor_context), consumer, on_query_result);
 }
 
@@ -86,28 +351,58 @@ static void InterpretPlan(
     const std::vector<type::Value> &params,
     const std::vector<int> &result_format,
     std::function<void(executor::ExecutionResult, std::vector<ResultValue> &&)>
-        on_complete) {
+        on_complete,
+    const std::shared_ptr<Statement> &statement,
+    const std::shared_ptr<QueryProgressRegistry::Entry> &progress_entry) {
   executor::ExecutionResult result;
   std::vector<ResultValue> values;
 
-  std::unique_ptr<executor::ExecutorContext> executor_context(
-      new executor::ExecutorContext(txn, params));
-
-  bool status;
-  std::unique_ptr<executor::AbstractExecutor> executor_tree(
-      BuildExecutorTree(nullptr, plan.get(), executor_context.get()));
+  // Reuse the executor tree cached on the prepared statement when there is
+  // one; otherwise build a fresh tree and, when its plan shape supports
+  // re-initialization, cache it on the statement for later executions
+  std::shared_ptr<executor::ExecutorContext> executor_context;
+  std::shared_ptr<executor::AbstractExecutor> executor_tree;
+  if (statement != nullptr && statement->GetCachedExecutorTree() != nullptr &&
+      statement->GetPlanTree() == plan) {
+    executor_tree = statement->GetCachedExecutorTree();
+    executor_context = statement->GetCachedExecutorContext();
+    executor_context->Reset(txn, params);
+    executor_tree->Reset();
+  } else {
+    executor_context.reset(new executor::ExecutorContext(txn, params));
+    executor_tree.reset(
+        BuildExecutorTree(nullptr, plan.get(), executor_context.get()),
+        [](executor::AbstractExecutor *root) {
+          CleanExecutorTree(root);
+          delete root;
+        });
+    if (statement != nullptr && statement->GetPlanTree() == plan &&
+        CacheableExecutorTree(plan.get())) {
+      statement->SetCachedExecutorTree(executor_tree, executor_context);
+    }
+  }
+  executor_context->SetProgressEntry(progress_entry);
+  executor_context->SetExecutionPhase("execute");
 
-  status = executor_tree->Init();
+  bool status = executor_tree->Init();
   if (status != true) {
     result.m_result = ResultType::FAILURE;
     result.m_error_message = "Failed initialization of query execution tree";
-    CleanExecutorTree(executor_tree.get());
+    // don't hand a half-initialized tree to the next execution
+    if (statement != nullptr) {
+      statement->ClearCachedExecutorTree();
+    }
     on_complete(result, std::move(values));
     return;
   }
 
   // Execute the tree until we get values tiles from root node
   while (status == true) {
+    // cooperative cancellation: between output tiles a kill_query() or an
+    // expired statement timeout unwinds the whole plan tree through the
+    // normal error path
+    executor_context->ThrowIfExecutionAborted();
+
     status = executor_tree->Execute();
     std::unique_ptr<executor::LogicalTile> tile(executor_tree->GetOutput());
 
@@ -125,12 +420,15 @@ static void InterpretPlan(
           values.push_back(std::move(tuple[i]));
         }
       }
+      executor_context->AddRowsProduced(tuples.size());
     }
+    executor_context->RefreshTrackedMemoryUsage();
   }
 
   result.m_processed = executor_context->num_processed;
   result.m_result = ResultType::SUCCESS;
-  CleanExecutorTree(executor_tree.get());
+  // an uncached tree is torn down here by the shared_ptr deleter; a cached
+  // one stays alive on the statement for the next execution
   on_complete(result, std::move(values));
 }
 
@@ -140,18 +438,41 @@ void PlanExecutor::ExecutePlan(
     const std::vector<type::Value> &params,
     const std::vector<int> &result_format,
     std::function<void(executor::ExecutionResult, std::vector<ResultValue> &&)>
-        on_complete) {
+        on_complete,
+    std::shared_ptr<Statement> statement) {
   PL_ASSERT(plan != nullptr && txn != nullptr);
   LOG_TRACE("PlanExecutor Start (Txn ID=%" PRId64 ")", txn->GetTransactionId());
 
   bool codegen_enabled =
       settings::SettingsManager::GetBool(settings::SettingId::codegen);
 
+  // Publish this execution in the live query registry; it stays visible in
+  // pg_query_progress and reachable by kill_query() until the guard
+  // unregisters it on the way out
+  ProgressRegistration registration(
+      (statement != nullptr)
+          ? statement->GetQueryString()
+          : PlanNodeTypeToString(plan->GetPlanNodeType()) + " (internal)");
+  const auto &progress_entry = registration.GetEntry();
+
   try {
     if (codegen_enabled && codegen::QueryCompiler::IsSupported(*plan)) {
-      CompileAndExecutePlan(plan, txn, params, on_complete);
+      bool async_compile = settings::SettingsManager::GetBool(
+          settings::SettingId::codegen_async_compile);
+      if (async_compile && !codegen::QueryCache::Instance().Contains(plan)) {
+        // Start compiling in the background and answer this execution on the
+        // interpreted executor tree; once the compiled query lands in the
+        // cache, later executions take the compiled path.
+        SubmitBackgroundCompilation(plan, params);
+        InterpretPlan(plan, txn, params, result_format, on_complete, statement,
+                      progress_entry);
+      } else {
+        CompileAndExecutePlan(plan, txn, params, result_format, on_complete,
+                              progress_entry);
+      }
     } else {
-      InterpretPlan(plan, txn, params, result_format, on_complete);
+      InterpretPlan(plan, txn, params, result_format, on_complete, statement,
+                    progress_entry);
     }
   } catch (Exception &e) {
     ExecutionResult result;
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "catalog/manager.h"
 #include "common/logger.h"
 #include "type/value.h"
 #include "executor/logical_tile.h"
@@ -48,18 +49,28 @@ bool PopulateIndexExecutor::DInit() {
   return true;
 }
 
+/**
+ * @brief Populate the new index online: snapshot scan, then a catch-up pass
+ * over the side log of inserts that raced with the scan. Writers never
+ * block; the index entry in pg_index becomes visible atomically when the
+ * CREATE INDEX transaction commits, after catch-up has completed.
+ */
 bool PopulateIndexExecutor::DExecute() {
   LOG_TRACE("Populate Index Executor");
   PL_ASSERT(executor_context_ != nullptr);
   auto current_txn = executor_context_->GetTransaction();
   auto executor_pool = executor_context_->GetPool();
   if (done_ == false) {
+    // Record concurrent insert locations while the snapshot scan runs
+    target_table_->BeginIndexBuildLogging();
+
     //Get the output from seq_scan
     while (children_[0]->Execute()) {
       child_tiles_.emplace_back(children_[0]->GetOutput());
     }
 
     if (child_tiles_.size() == 0) {
+      target_table_->EndIndexBuildLogging();
       LOG_TRACE("PopulateIndex Executor : false -- no child tiles ");
       return false;
     }
@@ -95,6 +106,38 @@ bool PopulateIndexExecutor::DExecute() {
       }
     }
 
+    // Catch-up phase: drain the side log until it comes back empty. A
+    // writer that appends after the final drain has already inserted into
+    // the attached index itself, and re-inserting a <key, location> pair
+    // an index already holds is a no-op, so the loop converges without
+    // ever blocking writers.
+    auto &manager = catalog::Manager::GetInstance();
+    while (true) {
+      auto pending = target_table_->DrainIndexBuildLog();
+      if (pending.empty()) {
+        break;
+      }
+      for (auto &location : pending) {
+        auto tile_group = manager.GetTileGroup(location.block);
+        if (tile_group == nullptr) {
+          continue;
+        }
+
+        // Materialize the raced tuple straight from its tile group
+        for (oid_t column_itr = 0; column_itr < column_ids_.size();
+             column_itr++) {
+          type::Value val = tile_group->GetValue(location.offset,
+                                                 column_ids_[column_itr]);
+          tuple->SetValue(column_ids_[column_itr], val, executor_pool);
+        }
+
+        ItemPointer *index_entry_ptr = nullptr;
+        target_table_->InsertInIndexes(tuple.get(), location, current_txn,
+                                       &index_entry_ptr);
+      }
+    }
+    target_table_->EndIndexBuildLogging();
+
     done_ = true;
   }
   LOG_TRACE("Populate Index Executor : false -- done ");
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_progress_registry.cpp
+//
+// Identification: src/executor/query_progress_registry.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/query_progress_registry.h"
+
+#include <chrono>
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+int64_t WallClockMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+QueryProgressRegistry::Entry::Entry(uint64_t query_id,
+                                    const std::string &query_text)
+    : query_id_(query_id),
+      query_text_(query_text),
+      start_time_us_(WallClockMicroseconds()),
+      rows_produced_(0),
+      phase_("init"),
+      memory_bytes_(0),
+      cancel_requested_(false) {}
+
+QueryProgressRegistry &QueryProgressRegistry::GetInstance() {
+  static QueryProgressRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<QueryProgressRegistry::Entry> QueryProgressRegistry::Register(
+    const std::string &query_text) {
+  uint64_t query_id = next_query_id_.fetch_add(1);
+  std::shared_ptr<Entry> entry(new Entry(query_id, query_text));
+
+  registry_lock_.Lock();
+  entries_[query_id] = entry;
+  registry_lock_.Unlock();
+
+  return entry;
+}
+
+void QueryProgressRegistry::Unregister(uint64_t query_id) {
+  registry_lock_.Lock();
+  entries_.erase(query_id);
+  registry_lock_.Unlock();
+}
+
+bool QueryProgressRegistry::RequestCancel(uint64_t query_id) {
+  // hold the entry instead of the latch while flipping the flag; entries
+  // stay valid after removal, so a kill racing with query completion is a
+  // harmless no-op
+  std::shared_ptr<Entry> entry = nullptr;
+
+  registry_lock_.Lock();
+  auto entry_itr = entries_.find(query_id);
+  if (entry_itr != entries_.end()) {
+    entry = entry_itr->second;
+  }
+  registry_lock_.Unlock();
+
+  if (entry == nullptr) {
+    return false;
+  }
+  entry->cancel_requested_.store(true);
+  return true;
+}
+
+std::vector<QueryProgressRegistry::ProgressRow>
+QueryProgressRegistry::GetSnapshot() {
+  int64_t now_us = WallClockMicroseconds();
+
+  std::vector<ProgressRow> rows;
+
+  registry_lock_.Lock();
+  rows.reserve(entries_.size());
+  for (auto &entry_itr : entries_) {
+    auto &entry = *entry_itr.second;
+    ProgressRow row;
+    row.query_id = entry.query_id_;
+    row.query_text = entry.query_text_;
+    row.start_time_us = entry.start_time_us_;
+    row.elapsed_us = now_us - entry.start_time_us_;
+    row.rows_produced = entry.rows_produced_.load();
+    row.phase = entry.phase_.load();
+    row.memory_bytes = entry.memory_bytes_.load();
+    row.cancel_requested = entry.cancel_requested_.load();
+    rows.push_back(std::move(row));
+  }
+  registry_lock_.Unlock();
+
+  return rows;
+}
+
+size_t QueryProgressRegistry::GetLiveQueryCount() {
+  registry_lock_.Lock();
+  size_t count = entries_.size();
+  registry_lock_.Unlock();
+  return count;
+}
+
+}  // namespace executor
+}  // namespace peloton
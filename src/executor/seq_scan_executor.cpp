@@ -12,6 +12,9 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include "brain/aux_structure_tuner.h"
+#include "brain/sample.h"
+#include "catalog/catalog_defaults.h"
 #include "common/internal_types.h"
 #include "type/value_factory.h"
 #include "executor/logical_tile.h"
@@ -22,17 +25,44 @@
 #include "expression/conjunction_expression.h"
 #include "expression/constant_value_expression.h"
 #include "expression/comparison_expression.h"
+#include "expression/comparison_simd_kernels.h"
+#include "function/string_functions.h"
 #include "common/container_tuple.h"
 #include "planner/create_plan.h"
 #include "storage/data_table.h"
+#include "storage/dictionary_encoded_column.h"
+#include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "settings/settings_manager.h"
+#include "threadpool/mono_queue_pool.h"
 #include "common/logger.h"
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// Flip a comparison operator so that "constant op column" can be evaluated
+// as "column op' constant".
+ExpressionType FlipComparison(ExpressionType cmp_type) {
+  switch (cmp_type) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return ExpressionType::COMPARE_GREATERTHAN;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return ExpressionType::COMPARE_LESSTHAN;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+    default:
+      return cmp_type;
+  }
+}
+
+}  // namespace
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -59,6 +89,13 @@ bool SeqScanExecutor::DInit() {
 
   old_predicate_ = predicate_;
 
+  // Flatten the predicate once; later re-initializations of a cached
+  // executor tree reuse the program
+  if (predicate_program_compiled_ == false) {
+    predicate_program_ = expression::ExpressionProgram::Compile(predicate_);
+    predicate_program_compiled_ = true;
+  }
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
@@ -66,11 +103,277 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    vectorized_scan_ = PrepareVectorizedPredicate();
+
+    PrepareZoneMapPredicates();
+
+    // Feed the layout tuner a real access sample for this scan; catalog
+    // tables are never layout-tuned
+    if (settings::SettingsManager::GetBool(
+            settings::SettingId::layout_tuner) &&
+        target_table_->GetDatabaseOid() != CATALOG_DATABASE_OID) {
+      std::vector<double> columns_accessed(column_ids_.begin(),
+                                           column_ids_.end());
+      target_table_->RecordLayoutSample(brain::Sample(columns_accessed));
+    }
+
+    // Count the scan; adaptive tile group sizing reads this when the
+    // table allocates its next tile group
+    target_table_->RecordScan();
+
+    parallel_scan_ = settings::SettingsManager::GetBool(
+        settings::SettingId::parallel_seq_scan);
+
+    // Shared scans: attach where concurrent scans of this table are already
+    // reading and wrap around, so N simultaneous scans make one memory pass
+    shared_scan_ =
+        settings::SettingsManager::GetBool(settings::SettingId::shared_scan);
+    scan_start_offset_ = 0;
+    if (shared_scan_ && table_tile_group_count_ > 0) {
+      scan_start_offset_ =
+          target_table_->GetSharedScanPosition() % table_tile_group_count_;
+    }
   }
 
   return true;
 }
 
+void SeqScanExecutor::PrepareZoneMapPredicates() {
+  zone_map_predicates_.clear();
+
+  if (predicate_ == nullptr || target_table_ == nullptr) return;
+
+  auto *predicate = const_cast<expression::AbstractExpression *>(predicate_);
+  if (!predicate->IsZoneMappable()) return;
+
+  // The parsed predicates also feed auxiliary structure selection and the
+  // bloom filter skip check, so they are extracted even before the zone
+  // map catalog table exists
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  bool aux_tuner_enabled =
+      settings::SettingsManager::GetBool(settings::SettingId::aux_tuner) &&
+      target_table_->GetDatabaseOid() != CATALOG_DATABASE_OID;
+  if (!zone_map_manager->ZoneMapTableExists() && !aux_tuner_enabled) return;
+
+  zone_map_predicates_ = *predicate->GetParsedPredicates();
+  predicate->ClearParsedPredicates();
+
+  // Tell the tuner which columns this scan filters on, so it can decide
+  // which zone maps and bloom filters are worth building
+  if (aux_tuner_enabled) {
+    brain::AuxStructureTuner::GetInstance().RecordFilters(target_table_,
+                                                          zone_map_predicates_);
+  }
+}
+
+bool SeqScanExecutor::CanSkipTileGroup(oid_t tile_group_offset) const {
+  if (zone_map_predicates_.empty()) return false;
+
+  auto *zone_map_manager = storage::ZoneMapManager::GetInstance();
+  if (zone_map_manager->ZoneMapTableExists() &&
+      !zone_map_manager->ShouldScanTileGroup(
+          const_cast<storage::PredicateInfo *>(zone_map_predicates_.data()),
+          static_cast<int32_t>(zone_map_predicates_.size()), target_table_,
+          tile_group_offset)) {
+    return true;
+  }
+
+  // A tuner-built bloom filter can prove an equality filter matches no
+  // tuple in this tile group even when its zone map range covers the value
+  if (settings::SettingsManager::GetBool(settings::SettingId::aux_tuner)) {
+    return brain::AuxStructureTuner::GetInstance().ShouldSkipTileGroup(
+        target_table_, tile_group_offset, zone_map_predicates_);
+  }
+  return false;
+}
+
+bool SeqScanExecutor::PrepareVectorizedPredicate() {
+  if (predicate_ == nullptr || target_table_ == nullptr) return false;
+
+  // Only plain comparisons qualify; conjunctions and other expression types
+  // fall back to tuple-at-a-time evaluation.
+  auto cmp_type = predicate_->GetExpressionType();
+  switch (cmp_type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+    case ExpressionType::COMPARE_LIKE:
+      break;
+    default:
+      return false;
+  }
+
+  if (predicate_->GetChildrenSize() != 2) return false;
+  auto *left = predicate_->GetChild(0);
+  auto *right = predicate_->GetChild(1);
+
+  // Accept both "column op constant" and "constant op column".
+  const expression::TupleValueExpression *tve = nullptr;
+  const expression::ConstantValueExpression *cve = nullptr;
+  if (left->GetExpressionType() == ExpressionType::VALUE_TUPLE &&
+      right->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+    tve = static_cast<const expression::TupleValueExpression *>(left);
+    cve = static_cast<const expression::ConstantValueExpression *>(right);
+  } else if (left->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+             right->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    cve = static_cast<const expression::ConstantValueExpression *>(left);
+    tve = static_cast<const expression::TupleValueExpression *>(right);
+    // LIKE is not symmetric; only "column LIKE pattern" qualifies.
+    if (cmp_type == ExpressionType::COMPARE_LIKE) return false;
+    cmp_type = FlipComparison(cmp_type);
+  } else {
+    return false;
+  }
+
+  oid_t column_id = tve->GetColumnId();
+  auto *schema = target_table_->GetSchema();
+  if (column_id >= schema->GetColumnCount()) return false;
+
+  auto constant = cve->GetValue();
+  if (constant.IsNull()) return false;
+
+  auto column_type = schema->GetType(column_id);
+
+  // VARCHAR equality and LIKE can run over dictionary codes when the tile
+  // carries a dictionary encoding; CanVectorizeTileGroup() checks that per
+  // tile group.
+  if (column_type == type::TypeId::VARCHAR) {
+    if (cmp_type != ExpressionType::COMPARE_EQUAL &&
+        cmp_type != ExpressionType::COMPARE_LIKE) {
+      return false;
+    }
+    if (cmp_type == ExpressionType::COMPARE_LIKE) {
+      // The pattern is constant for the whole scan; keep its bare bytes so
+      // each tile group's dictionary can be matched once per distinct entry.
+      simple_like_pattern_ = constant.ToString();
+    }
+    simple_cmp_type_ = cmp_type;
+    simple_cmp_column_ = column_id;
+    simple_cmp_on_dictionary_ = true;
+    simple_cmp_value_ = constant.CastAs(column_type);
+    return true;
+  }
+
+  // LIKE only makes sense on strings
+  if (cmp_type == ExpressionType::COMPARE_LIKE) return false;
+
+  // Raw comparisons cannot handle NULL sentinels, so nullable columns take
+  // the fallback path.
+  if (schema->AllowNull(column_id)) return false;
+
+  switch (column_type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+      break;
+    default:
+      return false;
+  }
+
+  simple_cmp_type_ = cmp_type;
+  simple_cmp_column_ = column_id;
+  simple_cmp_on_dictionary_ = false;
+  simple_cmp_value_ = constant.CastAs(column_type);
+  return true;
+}
+
+bool SeqScanExecutor::CanVectorizeTileGroup(storage::TileGroup *tile_group,
+                                            oid_t active_tuple_count) const {
+  if (!simple_cmp_on_dictionary_) return true;
+
+  oid_t tile_offset, tile_column_id;
+  tile_group->LocateTileAndColumn(simple_cmp_column_, tile_offset,
+                                  tile_column_id);
+  auto *dict = tile_group->GetTile(tile_offset)
+                   ->GetDictionaryEncodedColumn(tile_column_id);
+  return dict != nullptr && dict->GetTupleCount() >= active_tuple_count;
+}
+
+std::vector<uint8_t> SeqScanExecutor::BuildLikeCodeMatches(
+    storage::TileGroup *tile_group) const {
+  oid_t tile_offset, tile_column_id;
+  tile_group->LocateTileAndColumn(simple_cmp_column_, tile_offset,
+                                  tile_column_id);
+  auto *dict = tile_group->GetTile(tile_offset)
+                   ->GetDictionaryEncodedColumn(tile_column_id);
+  PL_ASSERT(dict != nullptr);
+
+  // Match the pattern once per distinct entry rather than once per row;
+  // the classified fast paths in StringFunctions::Like make each of these
+  // a bounded compare for the prefix/suffix/contains pattern shapes.
+  std::vector<uint8_t> code_matches(dict->GetCardinality(), 0);
+  for (uint32_t code = 0; code < code_matches.size(); code++) {
+    const std::string &entry = dict->DecodeString(code);
+    code_matches[code] = function::StringFunctions::Like(
+        *executor_context_, entry.data(), static_cast<uint32_t>(entry.size()),
+        simple_like_pattern_.data(),
+        static_cast<uint32_t>(simple_like_pattern_.size()));
+  }
+  return code_matches;
+}
+
+void SeqScanExecutor::EvaluatePredicateVectorized(
+    storage::TileGroup *tile_group, oid_t batch_start, oid_t batch_end,
+    uint64_t *selection_bitmap, const std::vector<uint8_t> &like_code_matches) {
+  oid_t tile_offset, tile_column_id;
+  tile_group->LocateTileAndColumn(simple_cmp_column_, tile_offset,
+                                  tile_column_id);
+  storage::Tile *tile = tile_group->GetTile(tile_offset);
+  const catalog::Schema *tile_schema = tile->GetSchema();
+
+  if (simple_cmp_on_dictionary_) {
+    // Equality over dictionary codes: probe the constant once, then compare
+    // fixed-width codes in a tight loop.
+    auto *dict = tile->GetDictionaryEncodedColumn(tile_column_id);
+    PL_ASSERT(dict != nullptr);
+
+    PL_MEMSET(selection_bitmap, 0,
+              expression::ComparisonSIMDKernels::BitmapWordCount(
+                  batch_end - batch_start) *
+                  sizeof(uint64_t));
+
+    if (simple_cmp_type_ == ExpressionType::COMPARE_LIKE) {
+      // The pattern was matched once per distinct entry up front; just fan
+      // the verdicts out over the fixed-width codes.
+      const uint32_t *codes = dict->GetCodes();
+      for (oid_t slot = batch_start; slot < batch_end; slot++) {
+        if (like_code_matches[codes[slot]] != 0) {
+          selection_bitmap[(slot - batch_start) >> 6] |=
+              static_cast<uint64_t>(1) << ((slot - batch_start) & 63);
+        }
+      }
+      return;
+    }
+
+    uint32_t code;
+    if (!dict->TryGetCode(simple_cmp_value_, code)) {
+      // Constant never occurs in this tile; nothing matches
+      return;
+    }
+
+    const uint32_t *codes = dict->GetCodes();
+    for (oid_t slot = batch_start; slot < batch_end; slot++) {
+      if (codes[slot] == code) {
+        selection_bitmap[(slot - batch_start) >> 6] |=
+            static_cast<uint64_t>(1) << ((slot - batch_start) & 63);
+      }
+    }
+    return;
+  }
+
+  expression::ComparisonSIMDKernels::EvaluateComparison(
+      tile_schema->GetType(tile_column_id), simple_cmp_type_,
+      tile->GetTupleLocation(0), tile_schema->GetLength(),
+      tile_schema->GetOffset(tile_column_id), batch_start, batch_end,
+      simple_cmp_value_, selection_bitmap);
+}
+
 /**
  * @brief Creates logical tile from tile group and applies scan predicate.
  * @return true on success, false otherwise.
@@ -99,7 +402,11 @@ bool SeqScanExecutor::DExecute() {
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
           ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+          auto eval =
+              (predicate_program_ != nullptr)
+                  ? predicate_program_->Evaluate(&tuple, nullptr,
+                                                 executor_context_)
+                  : predicate_->Evaluate(&tuple, nullptr, executor_context_);
           if (eval.IsFalse()) {
             // if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
             //        .IsFalse()) {
@@ -150,10 +457,60 @@ bool SeqScanExecutor::DExecute() {
     bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
     auto current_txn = executor_context_->GetTransaction();
 
-    // Retrieve next tile group.
+    // Morsel-driven parallel scan: workers buffer qualifying tiles, and the
+    // transaction read bookkeeping happens here, serially, as the tiles are
+    // handed out.
+    if (parallel_scan_) {
+      if (!parallel_scan_done_) {
+        parallel_scan_done_ = RunParallelScan();
+      }
+
+      while (parallel_output_cursor_ < parallel_output_tiles_.size()) {
+        std::unique_ptr<LogicalTile> tile(
+            std::move(parallel_output_tiles_[parallel_output_cursor_++]));
+
+        storage::TileGroup *tile_group = tile->GetBaseTile(0)->GetTileGroup();
+        const oid_t tile_group_id = tile_group->GetTileGroupId();
+        auto &position_list = tile->GetPositionList(0);
+
+        for (oid_t tuple_id : *tile) {
+          ItemPointer location(tile_group_id, position_list[tuple_id]);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return res;
+          }
+        }
+
+        SetOutput(tile.release());
+        return true;
+      }
+      return false;
+    }
+
+    // Retrieve next tile group, scanning circularly from the start offset.
     while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
+      // a tile group is this scan's morsel: honor an admin kill_query() or
+      // an expired statement timeout between morsels, never inside one
+      executor_context_->ThrowIfExecutionAborted();
+
+      const oid_t tile_group_offset =
+          (scan_start_offset_ + current_tile_group_offset_++) %
+          table_tile_group_count_;
+
+      if (shared_scan_) {
+        // let scans arriving now attach where we are reading
+        target_table_->SetSharedScanPosition(tile_group_offset);
+      }
+
+      // Consult the zone map before touching any tuple data
+      if (CanSkipTileGroup(tile_group_offset)) {
+        continue;
+      }
+
+      auto tile_group = target_table_->GetTileGroup(tile_group_offset);
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -161,6 +518,76 @@ bool SeqScanExecutor::DExecute() {
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
+
+      if (vectorized_scan_ &&
+          CanVectorizeTileGroup(tile_group.get(), active_tuple_count)) {
+        // Vectorized path: evaluate the predicate over fixed-size batches of
+        // tuple slots in a tight loop, then run visibility checks and reads
+        // only for the qualifying slots.
+        std::vector<uint8_t> like_code_matches;
+        if (simple_cmp_type_ == ExpressionType::COMPARE_LIKE) {
+          like_code_matches = BuildLikeCodeMatches(tile_group.get());
+        }
+        std::vector<uint64_t> selection_bitmap(
+            expression::ComparisonSIMDKernels::BitmapWordCount(
+                kScanVectorSize));
+        std::vector<uint64_t> visibility_bitmap(
+            expression::ComparisonSIMDKernels::BitmapWordCount(
+                kScanVectorSize));
+        for (oid_t batch_start = 0; batch_start < active_tuple_count;
+             batch_start += kScanVectorSize) {
+          oid_t batch_end =
+              std::min(batch_start + kScanVectorSize, active_tuple_count);
+          EvaluatePredicateVectorized(tile_group.get(), batch_start, batch_end,
+                                      selection_bitmap.data(),
+                                      like_code_matches);
+          transaction_manager.IsVisibleBatch(current_txn, tile_group_header,
+                                             batch_start, batch_end,
+                                             visibility_bitmap.data());
+
+          for (oid_t tuple_id = batch_start; tuple_id < batch_end;
+               tuple_id++) {
+            if (!expression::ComparisonSIMDKernels::TestBit(
+                    selection_bitmap.data(), tuple_id - batch_start)) {
+              continue;
+            }
+
+            if (!expression::ComparisonSIMDKernels::TestBit(
+                    visibility_bitmap.data(), tuple_id - batch_start)) {
+              continue;
+            }
+
+            position_list.push_back(tuple_id);
+            ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+            auto res = transaction_manager.PerformRead(current_txn, location,
+                                                       acquire_owner);
+            if (!res) {
+              transaction_manager.SetTransactionResult(current_txn,
+                                                       ResultType::FAILURE);
+              return res;
+            }
+          }
+        }
+
+        // Don't return empty tiles
+        if (position_list.size() == 0) {
+          continue;
+        }
+
+        std::unique_ptr<LogicalTile> logical_tile(
+            LogicalTileFactory::GetTile());
+        logical_tile->AddColumns(tile_group, column_ids_);
+        logical_tile->AddPositionList(std::move(position_list));
+
+        SetOutput(logical_tile.release());
+        return true;
+      }
+
+      // tracks whether every slot examined so far is visible. as long as
+      // this holds on a predicate-free scan, the explicit position list is
+      // elided and the tile group is passed through as an identity tile.
+      bool dense_visible = (predicate_ == nullptr);
+
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
@@ -171,7 +598,9 @@ bool SeqScanExecutor::DExecute() {
         if (visibility == VisibilityType::OK) {
           // if the tuple is visible, then perform predicate evaluation.
           if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
+            if (dense_visible == false) {
+              position_list.push_back(tuple_id);
+            }
             auto res = transaction_manager.PerformRead(current_txn, location,
                                                        acquire_owner);
             if (!res) {
@@ -184,7 +613,10 @@ bool SeqScanExecutor::DExecute() {
                                                      tuple_id);
             LOG_TRACE("Evaluate predicate for a tuple");
             auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
+                (predicate_program_ != nullptr)
+                    ? predicate_program_->Evaluate(&tuple, nullptr,
+                                                   executor_context_)
+                    : predicate_->Evaluate(&tuple, nullptr, executor_context_);
             LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
             if (eval.IsTrue()) {
               position_list.push_back(tuple_id);
@@ -199,18 +631,34 @@ bool SeqScanExecutor::DExecute() {
               }
             }
           }
+        } else if (dense_visible == true) {
+          // first invisible slot: backfill the dense prefix into the
+          // explicit position list and fall off the pass-through path
+          position_list.reserve(active_tuple_count);
+          for (oid_t prev_tuple_id = 0; prev_tuple_id < tuple_id;
+               prev_tuple_id++) {
+            position_list.push_back(prev_tuple_id);
+          }
+          dense_visible = false;
         }
       }
 
       // Don't return empty tiles
-      if (position_list.size() == 0) {
+      if (position_list.size() == 0 &&
+          (dense_visible == false || active_tuple_count == 0)) {
         continue;
       }
 
       // Construct logical tile.
       std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
       logical_tile->AddColumns(tile_group, column_ids_);
-      logical_tile->AddPositionList(std::move(position_list));
+      if (dense_visible == true) {
+        // every slot is visible: hand the tile group through without
+        // materializing a position list
+        logical_tile->AddIdentityPositionList(active_tuple_count);
+      } else {
+        logical_tile->AddPositionList(std::move(position_list));
+      }
 
       LOG_TRACE("Information %s", logical_tile->GetInfo().c_str());
       SetOutput(logical_tile.release());
@@ -221,6 +669,146 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+bool SeqScanExecutor::RunParallelScan() {
+  if (table_tile_group_count_ == 0) return true;
+
+  executor_context_->SetExecutionPhase("parallel seq scan");
+
+  size_t worker_pool_size = static_cast<size_t>(settings::SettingsManager::
+      GetInt(settings::SettingId::monoqueue_worker_pool_size));
+  size_t num_workers =
+      std::min<size_t>(worker_pool_size, table_tile_group_count_);
+  if (num_workers == 0) num_workers = 1;
+
+  std::atomic<oid_t> cursor(0);
+  std::vector<std::vector<std::unique_ptr<LogicalTile>>> worker_outputs(
+      num_workers);
+
+  // Workers dispatched to the pool; this thread handles worker slot zero
+  std::vector<threadpool::TaskFuture> worker_futures;
+
+  auto &pool = threadpool::MonoQueuePool::GetInstance();
+  // All morsel workers of one table share a home worker queue, so they run
+  // where the table's data is already cache-resident unless stolen
+  size_t affinity_hint = static_cast<size_t>(target_table_->GetOid());
+  for (size_t worker_itr = 1; worker_itr < num_workers; worker_itr++) {
+    auto *output = &worker_outputs[worker_itr];
+    worker_futures.push_back(pool.SubmitTaskWithFuture(
+        affinity_hint,
+        [this, &cursor, output] { ParallelWorkerScan(&cursor, output); }));
+  }
+
+  // Participate in the scan on the calling thread so the scan finishes even
+  // when every pool worker is busy with other queries.
+  ParallelWorkerScan(&cursor, &worker_outputs[0]);
+
+  threadpool::TaskFuture::WhenAll(worker_futures).Wait();
+
+  // workers bail out of the morsel loop on a kill or timeout; raise the
+  // error here on the coordinating thread instead of inside the pool
+  executor_context_->ThrowIfExecutionAborted();
+
+  // Merge per-worker buffers in worker order
+  for (auto &worker_output : worker_outputs) {
+    for (auto &tile : worker_output) {
+      parallel_output_tiles_.push_back(std::move(tile));
+    }
+  }
+
+  LOG_TRACE("Parallel scan produced %lu tiles with %lu workers",
+            parallel_output_tiles_.size(), num_workers);
+  return true;
+}
+
+void SeqScanExecutor::ParallelWorkerScan(
+    std::atomic<oid_t> *cursor,
+    std::vector<std::unique_ptr<LogicalTile>> *output_tiles) {
+  while (true) {
+    // stop claiming morsels once an admin kill_query() comes in or the
+    // statement times out; the coordinating thread raises the error after
+    // the workers drain
+    if (executor_context_->IsCancelRequested() ||
+        executor_context_->IsStatementTimeoutExpired()) {
+      break;
+    }
+
+    const oid_t tile_group_itr = cursor->fetch_add(1);
+    if (tile_group_itr >= table_tile_group_count_) break;
+
+    // Consult the zone map before touching any tuple data
+    if (CanSkipTileGroup(tile_group_itr)) continue;
+
+    auto tile_group = target_table_->GetTileGroup(tile_group_itr);
+
+    std::vector<oid_t> position_list;
+    BuildPositionList(tile_group.get(), position_list);
+
+    // Don't buffer empty tiles
+    if (position_list.size() == 0) continue;
+
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    logical_tile->AddColumns(tile_group, column_ids_);
+    logical_tile->AddPositionList(std::move(position_list));
+    output_tiles->push_back(std::move(logical_tile));
+  }
+}
+
+void SeqScanExecutor::BuildPositionList(storage::TileGroup *tile_group,
+                                        std::vector<oid_t> &position_list) {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto tile_group_header = tile_group->GetHeader();
+  const oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  if (vectorized_scan_ &&
+      CanVectorizeTileGroup(tile_group, active_tuple_count)) {
+    std::vector<uint8_t> like_code_matches;
+    if (simple_cmp_type_ == ExpressionType::COMPARE_LIKE) {
+      like_code_matches = BuildLikeCodeMatches(tile_group);
+    }
+    std::vector<uint64_t> selection_bitmap(
+        expression::ComparisonSIMDKernels::BitmapWordCount(kScanVectorSize));
+    for (oid_t batch_start = 0; batch_start < active_tuple_count;
+         batch_start += kScanVectorSize) {
+      oid_t batch_end =
+          std::min(batch_start + kScanVectorSize, active_tuple_count);
+      EvaluatePredicateVectorized(tile_group, batch_start, batch_end,
+                                  selection_bitmap.data(), like_code_matches);
+
+      for (oid_t tuple_id = batch_start; tuple_id < batch_end; tuple_id++) {
+        if (!expression::ComparisonSIMDKernels::TestBit(
+                selection_bitmap.data(), tuple_id - batch_start)) {
+          continue;
+        }
+        if (transaction_manager.IsVisible(current_txn, tile_group_header,
+                                          tuple_id) != VisibilityType::OK) {
+          continue;
+        }
+        position_list.push_back(tuple_id);
+      }
+    }
+    return;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    if (transaction_manager.IsVisible(current_txn, tile_group_header,
+                                      tuple_id) != VisibilityType::OK) {
+      continue;
+    }
+    if (predicate_ != nullptr) {
+      ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+      auto eval =
+          (predicate_program_ != nullptr)
+              ? predicate_program_->Evaluate(&tuple, nullptr,
+                                             executor_context_)
+              : predicate_->Evaluate(&tuple, nullptr, executor_context_);
+      if (eval.IsFalse()) continue;
+    }
+    position_list.push_back(tuple_id);
+  }
+}
+
 // Update Predicate expression
 // this is used in the NLJoin executor
 void SeqScanExecutor::UpdatePredicate(const std::vector<oid_t> &column_ids,
@@ -254,6 +842,14 @@ void SeqScanExecutor::UpdatePredicate(const std::vector<oid_t> &column_ids,
   // we should eventually make prediate_ a unique_ptr
   new_predicate_.reset(new_predicate);
   predicate_ = new_predicate;
+
+  // The predicate changed, so re-check whether it qualifies for the
+  // vectorized scan path, re-extract the zone map predicates and re-flatten
+  // the evaluation program.
+  vectorized_scan_ = PrepareVectorizedPredicate();
+  PrepareZoneMapPredicates();
+  predicate_program_ = expression::ExpressionProgram::Compile(predicate_);
+  predicate_program_compiled_ = true;
 }
 
 // Transfer a list of equality predicate
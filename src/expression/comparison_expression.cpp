@@ -12,6 +12,9 @@
 
 #include "expression/comparison_expression.h"
 
+#include "executor/executor_context.h"
+#include "function/string_functions.h"
+
 namespace peloton {
 namespace expression {
 
@@ -40,6 +43,29 @@ type::Value ComparisonExpression::Evaluate(
     case (ExpressionType::COMPARE_GREATERTHANOREQUALTO):
       return type::ValueFactory::GetBooleanValue(
           vl.CompareGreaterThanEquals(vr));
+    case (ExpressionType::COMPARE_LIKE):
+    case (ExpressionType::COMPARE_NOTLIKE): {
+      if (vl.IsNull() || vr.IsNull()) {
+        return type::ValueFactory::GetNullValueByType(type::TypeId::BOOLEAN);
+      }
+      // Varlen lengths count the terminating NUL; the matcher works over
+      // the bare bytes.
+      bool matched;
+      if (context != nullptr) {
+        matched = function::StringFunctions::Like(
+            *context, vl.GetData(), vl.GetLength() - 1, vr.GetData(),
+            vr.GetLength() - 1);
+      } else {
+        executor::ExecutorContext dummy_context{nullptr};
+        matched = function::StringFunctions::Like(
+            dummy_context, vl.GetData(), vl.GetLength() - 1, vr.GetData(),
+            vr.GetLength() - 1);
+      }
+      if (exp_type_ == ExpressionType::COMPARE_NOTLIKE) {
+        matched = !matched;
+      }
+      return type::ValueFactory::GetBooleanValue(matched);
+    }
     case (ExpressionType::COMPARE_DISTINCT_FROM): {
       if (vl.IsNull() && vr.IsNull()) {
         return type::ValueFactory::GetBooleanValue(false);
@@ -0,0 +1,440 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// comparison_simd_kernels.cpp
+//
+// Identification: src/expression/comparison_simd_kernels.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/comparison_simd_kernels.h"
+
+#include <cstring>
+
+#include "common/logger.h"
+#include "common/macros.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+// Every supported comparison decomposes into a union of the three primitive
+// lane outcomes EQ, GT and LT. The SIMD kernels compute the EQ and GT lane
+// masks once per vector and combine them according to these flags, which
+// keeps the operator dispatch out of the inner loop.
+struct ComparisonDecomposition {
+  bool use_eq;
+  bool use_gt;
+  bool use_lt;
+};
+
+ComparisonDecomposition DecomposeComparison(ExpressionType cmp_type) {
+  switch (cmp_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return {true, false, false};
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return {false, true, true};
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return {false, true, false};
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return {true, true, false};
+    case ExpressionType::COMPARE_LESSTHAN:
+      return {false, false, true};
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return {true, false, true};
+    default:
+      PL_ASSERT(false);
+      return {false, false, false};
+  }
+}
+
+inline void SetBit(uint64_t *bitmap, size_t position) {
+  bitmap[position >> 6] |= static_cast<uint64_t>(1) << (position & 63);
+}
+
+// Scalar strided kernel used for narrow types, non-contiguous layouts and
+// vector tails. The predicate decomposition keeps this a branch-predictable
+// tight loop.
+template <typename T>
+void CompareStridedScalar(const char *tuple_base, size_t tuple_stride,
+                          size_t column_offset, oid_t start, oid_t end,
+                          const ComparisonDecomposition &decomp,
+                          const T constant, uint64_t *bitmap) {
+  const char *cursor =
+      tuple_base + static_cast<size_t>(start) * tuple_stride + column_offset;
+  for (oid_t slot = start; slot < end; slot++, cursor += tuple_stride) {
+    const T value = *reinterpret_cast<const T *>(cursor);
+    bool match = (decomp.use_eq && value == constant) ||
+                 (decomp.use_gt && value > constant) ||
+                 (decomp.use_lt && value < constant);
+    if (match) SetBit(bitmap, slot - start);
+  }
+}
+
+template <typename T>
+void BetweenStridedScalar(const char *tuple_base, size_t tuple_stride,
+                          size_t column_offset, oid_t start, oid_t end,
+                          const T lo, const T hi, uint64_t *bitmap) {
+  const char *cursor =
+      tuple_base + static_cast<size_t>(start) * tuple_stride + column_offset;
+  for (oid_t slot = start; slot < end; slot++, cursor += tuple_stride) {
+    const T value = *reinterpret_cast<const T *>(cursor);
+    if (lo <= value && value <= hi) SetBit(bitmap, slot - start);
+  }
+}
+
+#if defined(__AVX2__)
+
+// Contiguous AVX2 kernel for 32-bit integers: 8 lanes per iteration, lane
+// masks extracted with movemask and merged into the bitmap a byte at a time.
+void CompareContiguousInt32(const int32_t *values, size_t count,
+                            const ComparisonDecomposition &decomp,
+                            const int32_t constant, uint64_t *bitmap) {
+  const __m256i c = _mm256_set1_epi32(constant);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    const uint32_t eq_mask = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, c))));
+    const uint32_t gt_mask = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, c))));
+    const uint32_t lt_mask = ~(eq_mask | gt_mask) & 0xffu;
+
+    uint32_t mask = 0;
+    if (decomp.use_eq) mask |= eq_mask;
+    if (decomp.use_gt) mask |= gt_mask;
+    if (decomp.use_lt) mask |= lt_mask;
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  // Scalar tail
+  for (; i < count; i++) {
+    const int32_t value = values[i];
+    bool match = (decomp.use_eq && value == constant) ||
+                 (decomp.use_gt && value > constant) ||
+                 (decomp.use_lt && value < constant);
+    if (match) SetBit(bitmap, i);
+  }
+}
+
+// Contiguous AVX2 kernel for 64-bit integers: 4 lanes per iteration
+void CompareContiguousInt64(const int64_t *values, size_t count,
+                            const ComparisonDecomposition &decomp,
+                            const int64_t constant, uint64_t *bitmap) {
+  const __m256i c = _mm256_set1_epi64x(constant);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    const uint32_t eq_mask = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, c))));
+    const uint32_t gt_mask = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, c))));
+    const uint32_t lt_mask = ~(eq_mask | gt_mask) & 0xfu;
+
+    uint32_t mask = 0;
+    if (decomp.use_eq) mask |= eq_mask;
+    if (decomp.use_gt) mask |= gt_mask;
+    if (decomp.use_lt) mask |= lt_mask;
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  for (; i < count; i++) {
+    const int64_t value = values[i];
+    bool match = (decomp.use_eq && value == constant) ||
+                 (decomp.use_gt && value > constant) ||
+                 (decomp.use_lt && value < constant);
+    if (match) SetBit(bitmap, i);
+  }
+}
+
+// Contiguous AVX2 kernel for doubles (DECIMAL columns): 4 lanes per
+// iteration using ordered, non-signaling comparisons
+void CompareContiguousDouble(const double *values, size_t count,
+                             const ComparisonDecomposition &decomp,
+                             const double constant, uint64_t *bitmap) {
+  const __m256d c = _mm256_set1_pd(constant);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256d v = _mm256_loadu_pd(values + i);
+    uint32_t mask = 0;
+    if (decomp.use_eq) {
+      mask |= static_cast<uint32_t>(
+          _mm256_movemask_pd(_mm256_cmp_pd(v, c, _CMP_EQ_OQ)));
+    }
+    if (decomp.use_gt) {
+      mask |= static_cast<uint32_t>(
+          _mm256_movemask_pd(_mm256_cmp_pd(v, c, _CMP_GT_OQ)));
+    }
+    if (decomp.use_lt) {
+      mask |= static_cast<uint32_t>(
+          _mm256_movemask_pd(_mm256_cmp_pd(v, c, _CMP_LT_OQ)));
+    }
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  for (; i < count; i++) {
+    const double value = values[i];
+    bool match = (decomp.use_eq && value == constant) ||
+                 (decomp.use_gt && value > constant) ||
+                 (decomp.use_lt && value < constant);
+    if (match) SetBit(bitmap, i);
+  }
+}
+
+void BetweenContiguousInt32(const int32_t *values, size_t count,
+                            const int32_t lo, const int32_t hi,
+                            uint64_t *bitmap) {
+  const __m256i vlo = _mm256_set1_epi32(lo);
+  const __m256i vhi = _mm256_set1_epi32(hi);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    // lo <= v && v <= hi  ==  !(lo > v) && !(v > hi)
+    const uint32_t below = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vlo, v))));
+    const uint32_t above = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, vhi))));
+    const uint32_t mask = ~(below | above) & 0xffu;
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  for (; i < count; i++) {
+    if (lo <= values[i] && values[i] <= hi) SetBit(bitmap, i);
+  }
+}
+
+void BetweenContiguousInt64(const int64_t *values, size_t count,
+                            const int64_t lo, const int64_t hi,
+                            uint64_t *bitmap) {
+  const __m256i vlo = _mm256_set1_epi64x(lo);
+  const __m256i vhi = _mm256_set1_epi64x(hi);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    const uint32_t below = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vlo, v))));
+    const uint32_t above = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, vhi))));
+    const uint32_t mask = ~(below | above) & 0xfu;
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  for (; i < count; i++) {
+    if (lo <= values[i] && values[i] <= hi) SetBit(bitmap, i);
+  }
+}
+
+void BetweenContiguousDouble(const double *values, size_t count,
+                             const double lo, const double hi,
+                             uint64_t *bitmap) {
+  const __m256d vlo = _mm256_set1_pd(lo);
+  const __m256d vhi = _mm256_set1_pd(hi);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256d v = _mm256_loadu_pd(values + i);
+    const uint32_t mask = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(v, vlo, _CMP_GE_OQ),
+                                         _mm256_cmp_pd(v, vhi, _CMP_LE_OQ))));
+    bitmap[i >> 6] |= static_cast<uint64_t>(mask) << (i & 63);
+  }
+  for (; i < count; i++) {
+    if (lo <= values[i] && values[i] <= hi) SetBit(bitmap, i);
+  }
+}
+
+#endif  // __AVX2__
+
+}  // namespace
+
+bool ComparisonSIMDKernels::IsSupportedComparison(ExpressionType cmp_type) {
+  switch (cmp_type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ComparisonSIMDKernels::IsSupportedType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ComparisonSIMDKernels::EvaluateComparison(
+    type::TypeId type_id, ExpressionType cmp_type, const char *tuple_base,
+    size_t tuple_stride, size_t column_offset, oid_t start, oid_t end,
+    const type::Value &constant, uint64_t *bitmap) {
+  PL_ASSERT(IsSupportedComparison(cmp_type));
+  PL_ASSERT(end >= start);
+
+  const size_t count = end - start;
+  PL_MEMSET(bitmap, 0, BitmapWordCount(end - start) * sizeof(uint64_t));
+  if (count == 0) return;
+
+  const ComparisonDecomposition decomp = DecomposeComparison(cmp_type);
+  const char *column_base =
+      tuple_base + static_cast<size_t>(start) * tuple_stride + column_offset;
+
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      CompareStridedScalar<int8_t>(tuple_base, tuple_stride, column_offset,
+                                   start, end, decomp,
+                                   constant.GetAs<int8_t>(), bitmap);
+      break;
+    case type::TypeId::SMALLINT:
+      CompareStridedScalar<int16_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, decomp,
+                                    constant.GetAs<int16_t>(), bitmap);
+      break;
+    case type::TypeId::INTEGER:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(int32_t)) {
+        CompareContiguousInt32(reinterpret_cast<const int32_t *>(column_base),
+                               count, decomp, constant.GetAs<int32_t>(),
+                               bitmap);
+        break;
+      }
+#endif
+      CompareStridedScalar<int32_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, decomp,
+                                    constant.GetAs<int32_t>(), bitmap);
+      break;
+    case type::TypeId::BIGINT:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(int64_t)) {
+        CompareContiguousInt64(reinterpret_cast<const int64_t *>(column_base),
+                               count, decomp, constant.GetAs<int64_t>(),
+                               bitmap);
+        break;
+      }
+#endif
+      CompareStridedScalar<int64_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, decomp,
+                                    constant.GetAs<int64_t>(), bitmap);
+      break;
+    case type::TypeId::DECIMAL:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(double)) {
+        CompareContiguousDouble(reinterpret_cast<const double *>(column_base),
+                                count, decomp, constant.GetAs<double>(),
+                                bitmap);
+        break;
+      }
+#endif
+      CompareStridedScalar<double>(tuple_base, tuple_stride, column_offset,
+                                   start, end, decomp, constant.GetAs<double>(),
+                                   bitmap);
+      break;
+    default:
+      PL_ASSERT(false);
+      break;
+  }
+}
+
+void ComparisonSIMDKernels::EvaluateBetween(
+    type::TypeId type_id, const char *tuple_base, size_t tuple_stride,
+    size_t column_offset, oid_t start, oid_t end, const type::Value &lo,
+    const type::Value &hi, uint64_t *bitmap) {
+  PL_ASSERT(end >= start);
+
+  const size_t count = end - start;
+  PL_MEMSET(bitmap, 0, BitmapWordCount(end - start) * sizeof(uint64_t));
+  if (count == 0) return;
+
+  const char *column_base =
+      tuple_base + static_cast<size_t>(start) * tuple_stride + column_offset;
+
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      BetweenStridedScalar<int8_t>(tuple_base, tuple_stride, column_offset,
+                                   start, end, lo.GetAs<int8_t>(),
+                                   hi.GetAs<int8_t>(), bitmap);
+      break;
+    case type::TypeId::SMALLINT:
+      BetweenStridedScalar<int16_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, lo.GetAs<int16_t>(),
+                                    hi.GetAs<int16_t>(), bitmap);
+      break;
+    case type::TypeId::INTEGER:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(int32_t)) {
+        BetweenContiguousInt32(reinterpret_cast<const int32_t *>(column_base),
+                               count, lo.GetAs<int32_t>(), hi.GetAs<int32_t>(),
+                               bitmap);
+        break;
+      }
+#endif
+      BetweenStridedScalar<int32_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, lo.GetAs<int32_t>(),
+                                    hi.GetAs<int32_t>(), bitmap);
+      break;
+    case type::TypeId::BIGINT:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(int64_t)) {
+        BetweenContiguousInt64(reinterpret_cast<const int64_t *>(column_base),
+                               count, lo.GetAs<int64_t>(), hi.GetAs<int64_t>(),
+                               bitmap);
+        break;
+      }
+#endif
+      BetweenStridedScalar<int64_t>(tuple_base, tuple_stride, column_offset,
+                                    start, end, lo.GetAs<int64_t>(),
+                                    hi.GetAs<int64_t>(), bitmap);
+      break;
+    case type::TypeId::DECIMAL:
+#if defined(__AVX2__)
+      if (tuple_stride == sizeof(double)) {
+        BetweenContiguousDouble(reinterpret_cast<const double *>(column_base),
+                                count, lo.GetAs<double>(), hi.GetAs<double>(),
+                                bitmap);
+        break;
+      }
+#endif
+      BetweenStridedScalar<double>(tuple_base, tuple_stride, column_offset,
+                                   start, end, lo.GetAs<double>(),
+                                   hi.GetAs<double>(), bitmap);
+      break;
+    default:
+      PL_ASSERT(false);
+      break;
+  }
+}
+
+void ComparisonSIMDKernels::SelectionBitmapToPositionList(
+    const uint64_t *bitmap, oid_t tuple_count, oid_t base_offset,
+    std::vector<oid_t> &position_list) {
+  const size_t num_words = BitmapWordCount(tuple_count);
+  for (size_t word_idx = 0; word_idx < num_words; word_idx++) {
+    uint64_t word = bitmap[word_idx];
+    while (word != 0) {
+      const int bit = __builtin_ctzll(word);
+      const oid_t position = static_cast<oid_t>((word_idx << 6) + bit);
+      if (position >= tuple_count) return;
+      position_list.push_back(base_offset + position);
+      word &= word - 1;
+    }
+  }
+}
+
+}  // namespace expression
+}  // namespace peloton
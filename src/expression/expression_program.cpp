@@ -0,0 +1,715 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// expression_program.cpp
+//
+// Identification: src/expression/expression_program.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/expression_program.h"
+
+#include "common/abstract_tuple.h"
+#include "executor/executor_context.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "type/value_factory.h"
+#include "type/value_peeker.h"
+
+// Computed-goto dispatch: each opcode handler jumps straight to the next
+// step's handler instead of going back through a shared switch, so the
+// branch predictor sees one indirect branch per handler rather than a
+// single shared one that every opcode pair aliases on
+#if defined(__GNUC__) || defined(__clang__)
+#define EXPRESSION_PROGRAM_COMPUTED_GOTO 1
+#endif
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+// Static operand classification for the typed comparison fast path.
+// Timestamps ride the integer lane: they are raw 64-bit counts and order
+// the same way.
+enum class NumericClass { kNone, kInt, kDec };
+
+NumericClass ClassifyNumeric(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::TIMESTAMP:
+      return NumericClass::kInt;
+    case type::TypeId::DECIMAL:
+      return NumericClass::kDec;
+    default:
+      return NumericClass::kNone;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<ExpressionProgram> ExpressionProgram::Compile(
+    const AbstractExpression *expression) {
+  if (expression == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<ExpressionProgram> program(new ExpressionProgram());
+  Lane produced = Lane::kValue;
+  if (program->Flatten(expression, produced) == false ||
+      program->max_stack_height_ > kMaxStackDepth) {
+    return nullptr;
+  }
+  program->returns_bool_lane_ = (produced == Lane::kBool);
+  return program;
+}
+
+void ExpressionProgram::Emit(OpCode op, uint32_t arg, int stack_delta) {
+  steps_.push_back(Step{op, arg});
+  stack_height_ += stack_delta;
+  if (stack_height_ > max_stack_height_) {
+    max_stack_height_ = stack_height_;
+  }
+}
+
+bool ExpressionProgram::FlattenBoxed(const AbstractExpression *expression) {
+  Lane produced = Lane::kValue;
+  if (Flatten(expression, produced) == false) {
+    return false;
+  }
+  if (produced == Lane::kBool) {
+    Emit(OpCode::BoxBool, 0, 0);
+  }
+  return true;
+}
+
+bool ExpressionProgram::FlattenAsBool(const AbstractExpression *expression) {
+  Lane produced = Lane::kValue;
+  if (Flatten(expression, produced) == false) {
+    return false;
+  }
+  if (produced == Lane::kValue) {
+    Emit(OpCode::UnboxBool, 0, 0);
+  }
+  return true;
+}
+
+bool ExpressionProgram::FlattenAsLane(const AbstractExpression *expression,
+                                      bool as_decimal) {
+  const type::TypeId type_id = expression->GetValueType();
+  switch (expression->GetExpressionType()) {
+    case ExpressionType::VALUE_TUPLE: {
+      auto *tve = static_cast<const TupleValueExpression *>(expression);
+      if (tve->GetColumnId() < 0 ||
+          (tve->GetTupleId() != 0 && tve->GetTupleId() != 1)) {
+        return false;
+      }
+      const bool left = (tve->GetTupleId() == 0);
+      OpCode op;
+      switch (type_id) {
+        case type::TypeId::TINYINT:
+          op = left ? OpCode::LoadLeftTinyInt : OpCode::LoadRightTinyInt;
+          break;
+        case type::TypeId::SMALLINT:
+          op = left ? OpCode::LoadLeftSmallInt : OpCode::LoadRightSmallInt;
+          break;
+        case type::TypeId::INTEGER:
+          op = left ? OpCode::LoadLeftInteger : OpCode::LoadRightInteger;
+          break;
+        case type::TypeId::BIGINT:
+          op = left ? OpCode::LoadLeftBigInt : OpCode::LoadRightBigInt;
+          break;
+        case type::TypeId::TIMESTAMP:
+          op = left ? OpCode::LoadLeftTimestamp : OpCode::LoadRightTimestamp;
+          break;
+        case type::TypeId::DECIMAL:
+          op = left ? OpCode::LoadLeftDecimal : OpCode::LoadRightDecimal;
+          break;
+        default:
+          return false;
+      }
+      Emit(op, tve->GetColumnId(), 1);
+      if (as_decimal && type_id != type::TypeId::DECIMAL) {
+        Emit(OpCode::CastIntToDec, 0, 0);
+      }
+      return true;
+    }
+    case ExpressionType::VALUE_CONSTANT: {
+      auto *cve = static_cast<const ConstantValueExpression *>(expression);
+      const type::Value &value = cve->GetValue();
+      // Non-null numeric constants are unboxed once here instead of per
+      // row; null constants fall through to the boxed bridge below, which
+      // preserves their null flag
+      if (value.IsNull() == false &&
+          ClassifyNumeric(value.GetTypeId()) != NumericClass::kNone) {
+        if (as_decimal) {
+          dec_constants_.push_back(type::ValuePeeker::PeekDouble(
+              value.CastAs(type::TypeId::DECIMAL)));
+          Emit(OpCode::LoadConstantDec, dec_constants_.size() - 1, 1);
+        } else {
+          int_constants_.push_back(
+              type::ValuePeeker::PeekBigInt(value.CastAs(type::TypeId::BIGINT)));
+          Emit(OpCode::LoadConstantInt, int_constants_.size() - 1, 1);
+        }
+        return true;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  // Anything else -- parameters, nested operators, null constants -- is
+  // evaluated boxed and bridged onto the lane each row
+  if (FlattenBoxed(expression) == false) {
+    return false;
+  }
+  Emit(as_decimal ? OpCode::UnboxDec : OpCode::UnboxInt, 0, 0);
+  return true;
+}
+
+bool ExpressionProgram::Flatten(const AbstractExpression *expression,
+                                Lane &produced) {
+  produced = Lane::kValue;
+  switch (expression->GetExpressionType()) {
+    case ExpressionType::VALUE_TUPLE: {
+      auto *tve = static_cast<const TupleValueExpression *>(expression);
+      if (tve->GetColumnId() < 0) {
+        // unbound column reference
+        return false;
+      }
+      if (tve->GetTupleId() == 0) {
+        Emit(OpCode::PushLeftTupleValue, tve->GetColumnId(), 1);
+      } else if (tve->GetTupleId() == 1) {
+        Emit(OpCode::PushRightTupleValue, tve->GetColumnId(), 1);
+      } else {
+        return false;
+      }
+      return true;
+    }
+    case ExpressionType::VALUE_CONSTANT: {
+      auto *cve = static_cast<const ConstantValueExpression *>(expression);
+      constants_.push_back(cve->GetValue());
+      Emit(OpCode::PushConstant, constants_.size() - 1, 1);
+      return true;
+    }
+    case ExpressionType::VALUE_PARAMETER: {
+      auto *pve = static_cast<const ParameterValueExpression *>(expression);
+      Emit(OpCode::PushParameter, pve->GetValueIdx(), 1);
+      return true;
+    }
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
+      if (expression->GetChildrenSize() != 2) {
+        return false;
+      }
+      const auto *left = expression->GetChild(0);
+      const auto *right = expression->GetChild(1);
+      const auto left_class = ClassifyNumeric(left->GetValueType());
+      const auto right_class = ClassifyNumeric(right->GetValueType());
+      if (left_class != NumericClass::kNone &&
+          right_class != NumericClass::kNone) {
+        // Both operand types are statically numeric: lower to a typed
+        // comparison over the unboxed lanes, promoting to the decimal
+        // lane when the operands mix integers and decimals
+        const bool as_decimal = (left_class == NumericClass::kDec ||
+                                 right_class == NumericClass::kDec);
+        if (FlattenAsLane(left, as_decimal) == false ||
+            FlattenAsLane(right, as_decimal) == false) {
+          return false;
+        }
+        OpCode op;
+        switch (expression->GetExpressionType()) {
+          case ExpressionType::COMPARE_EQUAL:
+            op = as_decimal ? OpCode::CmpDecEqual : OpCode::CmpIntEqual;
+            break;
+          case ExpressionType::COMPARE_NOTEQUAL:
+            op = as_decimal ? OpCode::CmpDecNotEqual : OpCode::CmpIntNotEqual;
+            break;
+          case ExpressionType::COMPARE_LESSTHAN:
+            op = as_decimal ? OpCode::CmpDecLessThan : OpCode::CmpIntLessThan;
+            break;
+          case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            op = as_decimal ? OpCode::CmpDecLessThanEquals
+                            : OpCode::CmpIntLessThanEquals;
+            break;
+          case ExpressionType::COMPARE_GREATERTHAN:
+            op = as_decimal ? OpCode::CmpDecGreaterThan
+                            : OpCode::CmpIntGreaterThan;
+            break;
+          default:
+            op = as_decimal ? OpCode::CmpDecGreaterThanEquals
+                            : OpCode::CmpIntGreaterThanEquals;
+            break;
+        }
+        Emit(op, 0, -1);
+        produced = Lane::kBool;
+        return true;
+      }
+      // Operand types unknown or non-numeric: boxed comparison
+      if (FlattenBoxed(left) == false || FlattenBoxed(right) == false) {
+        return false;
+      }
+      OpCode op;
+      switch (expression->GetExpressionType()) {
+        case ExpressionType::COMPARE_EQUAL:
+          op = OpCode::CompareEqual;
+          break;
+        case ExpressionType::COMPARE_NOTEQUAL:
+          op = OpCode::CompareNotEqual;
+          break;
+        case ExpressionType::COMPARE_LESSTHAN:
+          op = OpCode::CompareLessThan;
+          break;
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+          op = OpCode::CompareLessThanEquals;
+          break;
+        case ExpressionType::COMPARE_GREATERTHAN:
+          op = OpCode::CompareGreaterThan;
+          break;
+        default:
+          op = OpCode::CompareGreaterThanEquals;
+          break;
+      }
+      Emit(op, 0, -1);
+      return true;
+    }
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR: {
+      if (expression->GetChildrenSize() != 2 ||
+          FlattenAsBool(expression->GetChild(0)) == false ||
+          FlattenAsBool(expression->GetChild(1)) == false) {
+        return false;
+      }
+      Emit(expression->GetExpressionType() == ExpressionType::CONJUNCTION_AND
+               ? OpCode::AndBool
+               : OpCode::OrBool,
+           0, -1);
+      produced = Lane::kBool;
+      return true;
+    }
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE: {
+      if (expression->GetChildrenSize() != 2 ||
+          FlattenBoxed(expression->GetChild(0)) == false ||
+          FlattenBoxed(expression->GetChild(1)) == false) {
+        return false;
+      }
+      OpCode op;
+      switch (expression->GetExpressionType()) {
+        case ExpressionType::OPERATOR_PLUS:
+          op = OpCode::OperatorPlus;
+          break;
+        case ExpressionType::OPERATOR_MINUS:
+          op = OpCode::OperatorMinus;
+          break;
+        case ExpressionType::OPERATOR_MULTIPLY:
+          op = OpCode::OperatorMultiply;
+          break;
+        default:
+          op = OpCode::OperatorDivide;
+          break;
+      }
+      Emit(op, 0, -1);
+      return true;
+    }
+    case ExpressionType::OPERATOR_NOT: {
+      if (expression->GetChildrenSize() != 1 ||
+          FlattenAsBool(expression->GetChild(0)) == false) {
+        return false;
+      }
+      Emit(OpCode::NotBool, 0, 0);
+      produced = Lane::kBool;
+      return true;
+    }
+    case ExpressionType::OPERATOR_IS_NULL:
+    case ExpressionType::OPERATOR_IS_NOT_NULL: {
+      if (expression->GetChildrenSize() != 1) {
+        return false;
+      }
+      const bool is_null =
+          (expression->GetExpressionType() == ExpressionType::OPERATOR_IS_NULL);
+      Lane child_lane = Lane::kValue;
+      if (Flatten(expression->GetChild(0), child_lane) == false) {
+        return false;
+      }
+      if (child_lane == Lane::kBool) {
+        Emit(is_null ? OpCode::IsNullSlot : OpCode::IsNotNullSlot, 0, 0);
+        produced = Lane::kBool;
+      } else {
+        Emit(is_null ? OpCode::OperatorIsNull : OpCode::OperatorIsNotNull, 0,
+             0);
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+type::Value ExpressionProgram::Evaluate(
+    const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+    executor::ExecutorContext *context) const {
+  // The two stacks are positionally aligned: every step knows statically
+  // whether a given slot holds a boxed value or raw lanes, so only one of
+  // the two entries at a position is ever live
+  struct Slot {
+    union {
+      int64_t i;
+      double d;
+    };
+    int8_t b;  // three-valued boolean lane (PELOTON_BOOLEAN_NULL = unknown)
+    bool null;
+  };
+  Slot slots[kMaxStackDepth];
+  type::Value values[kMaxStackDepth];
+  uint32_t top = 0;
+
+  PL_ASSERT(steps_.empty() == false);
+  const Step *ip = steps_.data();
+  const Step *const ip_end = ip + steps_.size();
+
+#ifdef EXPRESSION_PROGRAM_COMPUTED_GOTO
+  // Must list one label per OpCode, in enum order
+  static const void *const kDispatch[] = {
+      &&op_PushLeftTupleValue,
+      &&op_PushRightTupleValue,
+      &&op_PushConstant,
+      &&op_PushParameter,
+      &&op_CompareEqual,
+      &&op_CompareNotEqual,
+      &&op_CompareLessThan,
+      &&op_CompareLessThanEquals,
+      &&op_CompareGreaterThan,
+      &&op_CompareGreaterThanEquals,
+      &&op_OperatorIsNull,
+      &&op_OperatorIsNotNull,
+      &&op_OperatorPlus,
+      &&op_OperatorMinus,
+      &&op_OperatorMultiply,
+      &&op_OperatorDivide,
+      &&op_LoadLeftTinyInt,
+      &&op_LoadLeftSmallInt,
+      &&op_LoadLeftInteger,
+      &&op_LoadLeftBigInt,
+      &&op_LoadLeftTimestamp,
+      &&op_LoadLeftDecimal,
+      &&op_LoadRightTinyInt,
+      &&op_LoadRightSmallInt,
+      &&op_LoadRightInteger,
+      &&op_LoadRightBigInt,
+      &&op_LoadRightTimestamp,
+      &&op_LoadRightDecimal,
+      &&op_LoadConstantInt,
+      &&op_LoadConstantDec,
+      &&op_UnboxInt,
+      &&op_UnboxDec,
+      &&op_UnboxBool,
+      &&op_BoxBool,
+      &&op_CastIntToDec,
+      &&op_CmpIntEqual,
+      &&op_CmpIntNotEqual,
+      &&op_CmpIntLessThan,
+      &&op_CmpIntLessThanEquals,
+      &&op_CmpIntGreaterThan,
+      &&op_CmpIntGreaterThanEquals,
+      &&op_CmpDecEqual,
+      &&op_CmpDecNotEqual,
+      &&op_CmpDecLessThan,
+      &&op_CmpDecLessThanEquals,
+      &&op_CmpDecGreaterThan,
+      &&op_CmpDecGreaterThanEquals,
+      &&op_AndBool,
+      &&op_OrBool,
+      &&op_NotBool,
+      &&op_IsNullSlot,
+      &&op_IsNotNullSlot,
+  };
+  static_assert(sizeof(kDispatch) / sizeof(kDispatch[0]) ==
+                    static_cast<size_t>(OpCode::kOpCodeCount),
+                "dispatch table must cover every opcode");
+#define OP_CASE(name) op_##name
+#define OP_NEXT()                                  \
+  do {                                             \
+    if (++ip == ip_end) goto evaluation_done;      \
+    goto *kDispatch[static_cast<uint8_t>(ip->op)]; \
+  } while (0)
+  goto *kDispatch[static_cast<uint8_t>(ip->op)];
+#else
+#define OP_CASE(name) case OpCode::name
+#define OP_NEXT() break
+  for (; ip != ip_end; ++ip) {
+    switch (ip->op) {
+#endif
+
+// The boxed comparison / typed comparison handlers differ only in the
+// comparison they apply; generate them from one body each
+#define BOXED_COMPARE_CASE(name, method)                    \
+  OP_CASE(name) : {                                         \
+    top--;                                                  \
+    values[top - 1] = type::ValueFactory::GetBooleanValue(  \
+        values[top - 1].method(values[top]));               \
+    OP_NEXT();                                              \
+  }
+#define TYPED_COMPARE_CASE(name, lane, cmp_op)                        \
+  OP_CASE(name) : {                                                   \
+    top--;                                                            \
+    Slot &lhs = slots[top - 1];                                       \
+    const Slot &rhs = slots[top];                                     \
+    lhs.null = lhs.null || rhs.null;                                  \
+    lhs.b = lhs.null ? type::PELOTON_BOOLEAN_NULL                     \
+                     : static_cast<int8_t>(lhs.lane cmp_op rhs.lane); \
+    OP_NEXT();                                                        \
+  }
+#define TYPED_LOAD_CASE(name, tuple, lane, peeker)              \
+  OP_CASE(name) : {                                             \
+    const type::Value value = (tuple)->GetValue(ip->arg);       \
+    Slot &slot = slots[top++];                                  \
+    slot.null = value.IsNull();                                 \
+    if (!slot.null) slot.lane = type::ValuePeeker::peeker(value); \
+    OP_NEXT();                                                  \
+  }
+
+  OP_CASE(PushLeftTupleValue) : {
+    values[top++] = tuple1->GetValue(ip->arg);
+    OP_NEXT();
+  }
+  OP_CASE(PushRightTupleValue) : {
+    values[top++] = tuple2->GetValue(ip->arg);
+    OP_NEXT();
+  }
+  OP_CASE(PushConstant) : {
+    values[top++] = constants_[ip->arg];
+    OP_NEXT();
+  }
+  OP_CASE(PushParameter) : {
+    values[top++] = context->GetParamValues().at(ip->arg);
+    OP_NEXT();
+  }
+  BOXED_COMPARE_CASE(CompareEqual, CompareEquals)
+  BOXED_COMPARE_CASE(CompareNotEqual, CompareNotEquals)
+  BOXED_COMPARE_CASE(CompareLessThan, CompareLessThan)
+  BOXED_COMPARE_CASE(CompareLessThanEquals, CompareLessThanEquals)
+  BOXED_COMPARE_CASE(CompareGreaterThan, CompareGreaterThan)
+  BOXED_COMPARE_CASE(CompareGreaterThanEquals, CompareGreaterThanEquals)
+  OP_CASE(OperatorIsNull) : {
+    values[top - 1] =
+        type::ValueFactory::GetBooleanValue(values[top - 1].IsNull());
+    OP_NEXT();
+  }
+  OP_CASE(OperatorIsNotNull) : {
+    values[top - 1] =
+        type::ValueFactory::GetBooleanValue(!values[top - 1].IsNull());
+    OP_NEXT();
+  }
+  OP_CASE(OperatorPlus) : {
+    top--;
+    values[top - 1] = values[top - 1].Add(values[top]);
+    OP_NEXT();
+  }
+  OP_CASE(OperatorMinus) : {
+    top--;
+    values[top - 1] = values[top - 1].Subtract(values[top]);
+    OP_NEXT();
+  }
+  OP_CASE(OperatorMultiply) : {
+    top--;
+    values[top - 1] = values[top - 1].Multiply(values[top]);
+    OP_NEXT();
+  }
+  OP_CASE(OperatorDivide) : {
+    top--;
+    values[top - 1] = values[top - 1].Divide(values[top]);
+    OP_NEXT();
+  }
+  TYPED_LOAD_CASE(LoadLeftTinyInt, tuple1, i, PeekTinyInt)
+  TYPED_LOAD_CASE(LoadLeftSmallInt, tuple1, i, PeekSmallInt)
+  TYPED_LOAD_CASE(LoadLeftInteger, tuple1, i, PeekInteger)
+  TYPED_LOAD_CASE(LoadLeftBigInt, tuple1, i, PeekBigInt)
+  TYPED_LOAD_CASE(LoadLeftTimestamp, tuple1, i, PeekTimestamp)
+  TYPED_LOAD_CASE(LoadLeftDecimal, tuple1, d, PeekDouble)
+  TYPED_LOAD_CASE(LoadRightTinyInt, tuple2, i, PeekTinyInt)
+  TYPED_LOAD_CASE(LoadRightSmallInt, tuple2, i, PeekSmallInt)
+  TYPED_LOAD_CASE(LoadRightInteger, tuple2, i, PeekInteger)
+  TYPED_LOAD_CASE(LoadRightBigInt, tuple2, i, PeekBigInt)
+  TYPED_LOAD_CASE(LoadRightTimestamp, tuple2, i, PeekTimestamp)
+  TYPED_LOAD_CASE(LoadRightDecimal, tuple2, d, PeekDouble)
+  OP_CASE(LoadConstantInt) : {
+    Slot &slot = slots[top++];
+    slot.i = int_constants_[ip->arg];
+    slot.null = false;
+    OP_NEXT();
+  }
+  OP_CASE(LoadConstantDec) : {
+    Slot &slot = slots[top++];
+    slot.d = dec_constants_[ip->arg];
+    slot.null = false;
+    OP_NEXT();
+  }
+  OP_CASE(UnboxInt) : {
+    const type::Value &value = values[top - 1];
+    Slot &slot = slots[top - 1];
+    slot.null = value.IsNull();
+    if (!slot.null) {
+      switch (value.GetTypeId()) {
+        case type::TypeId::TINYINT:
+          slot.i = type::ValuePeeker::PeekTinyInt(value);
+          break;
+        case type::TypeId::SMALLINT:
+          slot.i = type::ValuePeeker::PeekSmallInt(value);
+          break;
+        case type::TypeId::INTEGER:
+          slot.i = type::ValuePeeker::PeekInteger(value);
+          break;
+        case type::TypeId::BIGINT:
+          slot.i = type::ValuePeeker::PeekBigInt(value);
+          break;
+        case type::TypeId::TIMESTAMP:
+          slot.i =
+              static_cast<int64_t>(type::ValuePeeker::PeekTimestamp(value));
+          break;
+        default:
+          slot.i = type::ValuePeeker::PeekBigInt(
+              value.CastAs(type::TypeId::BIGINT));
+          break;
+      }
+    }
+    OP_NEXT();
+  }
+  OP_CASE(UnboxDec) : {
+    const type::Value &value = values[top - 1];
+    Slot &slot = slots[top - 1];
+    slot.null = value.IsNull();
+    if (!slot.null) {
+      if (value.GetTypeId() == type::TypeId::DECIMAL) {
+        slot.d = type::ValuePeeker::PeekDouble(value);
+      } else {
+        slot.d = type::ValuePeeker::PeekDouble(
+            value.CastAs(type::TypeId::DECIMAL));
+      }
+    }
+    OP_NEXT();
+  }
+  OP_CASE(UnboxBool) : {
+    const type::Value &value = values[top - 1];
+    Slot &slot = slots[top - 1];
+    if (value.IsTrue()) {
+      slot.b = 1;
+    } else if (value.IsFalse()) {
+      slot.b = 0;
+    } else {
+      slot.b = type::PELOTON_BOOLEAN_NULL;
+    }
+    slot.null = (slot.b == type::PELOTON_BOOLEAN_NULL);
+    OP_NEXT();
+  }
+  OP_CASE(BoxBool) : {
+    values[top - 1] = type::ValueFactory::GetBooleanValue(slots[top - 1].b);
+    OP_NEXT();
+  }
+  OP_CASE(CastIntToDec) : {
+    Slot &slot = slots[top - 1];
+    if (!slot.null) {
+      slot.d = static_cast<double>(slot.i);
+    }
+    OP_NEXT();
+  }
+  TYPED_COMPARE_CASE(CmpIntEqual, i, ==)
+  TYPED_COMPARE_CASE(CmpIntNotEqual, i, !=)
+  TYPED_COMPARE_CASE(CmpIntLessThan, i, <)
+  TYPED_COMPARE_CASE(CmpIntLessThanEquals, i, <=)
+  TYPED_COMPARE_CASE(CmpIntGreaterThan, i, >)
+  TYPED_COMPARE_CASE(CmpIntGreaterThanEquals, i, >=)
+  TYPED_COMPARE_CASE(CmpDecEqual, d, ==)
+  TYPED_COMPARE_CASE(CmpDecNotEqual, d, !=)
+  TYPED_COMPARE_CASE(CmpDecLessThan, d, <)
+  TYPED_COMPARE_CASE(CmpDecLessThanEquals, d, <=)
+  TYPED_COMPARE_CASE(CmpDecGreaterThan, d, >)
+  TYPED_COMPARE_CASE(CmpDecGreaterThanEquals, d, >=)
+  OP_CASE(AndBool) : {
+    top--;
+    Slot &lhs = slots[top - 1];
+    const Slot &rhs = slots[top];
+    if (lhs.b == 1 && rhs.b == 1) {
+      lhs.b = 1;
+    } else if (lhs.b == 0 || rhs.b == 0) {
+      lhs.b = 0;
+    } else {
+      lhs.b = type::PELOTON_BOOLEAN_NULL;
+    }
+    lhs.null = (lhs.b == type::PELOTON_BOOLEAN_NULL);
+    OP_NEXT();
+  }
+  OP_CASE(OrBool) : {
+    top--;
+    Slot &lhs = slots[top - 1];
+    const Slot &rhs = slots[top];
+    if (lhs.b == 0 && rhs.b == 0) {
+      lhs.b = 0;
+    } else if (lhs.b == 1 || rhs.b == 1) {
+      lhs.b = 1;
+    } else {
+      lhs.b = type::PELOTON_BOOLEAN_NULL;
+    }
+    lhs.null = (lhs.b == type::PELOTON_BOOLEAN_NULL);
+    OP_NEXT();
+  }
+  OP_CASE(NotBool) : {
+    Slot &slot = slots[top - 1];
+    if (slot.b == 1) {
+      slot.b = 0;
+    } else if (slot.b == 0) {
+      slot.b = 1;
+    } else {
+      slot.b = type::PELOTON_BOOLEAN_NULL;
+    }
+    slot.null = (slot.b == type::PELOTON_BOOLEAN_NULL);
+    OP_NEXT();
+  }
+  OP_CASE(IsNullSlot) : {
+    Slot &slot = slots[top - 1];
+    slot.b = slot.null ? 1 : 0;
+    slot.null = false;
+    OP_NEXT();
+  }
+  OP_CASE(IsNotNullSlot) : {
+    Slot &slot = slots[top - 1];
+    slot.b = slot.null ? 0 : 1;
+    slot.null = false;
+    OP_NEXT();
+  }
+
+#ifdef EXPRESSION_PROGRAM_COMPUTED_GOTO
+evaluation_done:;
+#else
+      case OpCode::kOpCodeCount:
+        break;
+    }
+  }
+#endif
+#undef OP_CASE
+#undef OP_NEXT
+#undef BOXED_COMPARE_CASE
+#undef TYPED_COMPARE_CASE
+#undef TYPED_LOAD_CASE
+
+  PL_ASSERT(top == 1);
+  if (returns_bool_lane_) {
+    return type::ValueFactory::GetBooleanValue(slots[0].b);
+  }
+  return values[0];
+}
+
+}  // namespace expression
+}  // namespace peloton
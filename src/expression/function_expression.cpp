@@ -12,9 +12,53 @@
 
 #include "expression/function_expression.h"
 
+#include "codegen/code_context.h"
+#include "type/value_factory.h"
+
 namespace peloton {
 namespace expression {
 
+namespace {
+
+// Call a JIT-compiled function whose arguments and return value all share a
+// single C type, which is how UDFHandler lays out plpgsql signatures
+template <typename CType>
+CType InvokeUniformUDF(void *raw_fn, const std::vector<CType> &args) {
+  typedef CType T;
+  switch (args.size()) {
+    case 0:
+      return reinterpret_cast<T (*)()>(raw_fn)();
+    case 1:
+      return reinterpret_cast<T (*)(T)>(raw_fn)(args[0]);
+    case 2:
+      return reinterpret_cast<T (*)(T, T)>(raw_fn)(args[0], args[1]);
+    case 3:
+      return reinterpret_cast<T (*)(T, T, T)>(raw_fn)(args[0], args[1],
+                                                      args[2]);
+    case 4:
+      return reinterpret_cast<T (*)(T, T, T, T)>(raw_fn)(args[0], args[1],
+                                                         args[2], args[3]);
+    case 5:
+      return reinterpret_cast<T (*)(T, T, T, T, T)>(raw_fn)(
+          args[0], args[1], args[2], args[3], args[4]);
+    case 6:
+      return reinterpret_cast<T (*)(T, T, T, T, T, T)>(raw_fn)(
+          args[0], args[1], args[2], args[3], args[4], args[5]);
+    case 7:
+      return reinterpret_cast<T (*)(T, T, T, T, T, T, T)>(raw_fn)(
+          args[0], args[1], args[2], args[3], args[4], args[5], args[6]);
+    case 8:
+      return reinterpret_cast<T (*)(T, T, T, T, T, T, T, T)>(raw_fn)(
+          args[0], args[1], args[2], args[3], args[4], args[5], args[6],
+          args[7]);
+    default:
+      throw Exception(ExceptionType::EXPRESSION,
+                      "Too many arguments in compiled UDF call.");
+  }
+}
+
+}  // namespace
+
 expression::FunctionExpression::FunctionExpression(
     const char *func_name, const std::vector<AbstractExpression *> &children)
     : AbstractExpression(ExpressionType::FUNCTION),
@@ -45,11 +89,17 @@ type::Value FunctionExpression::Evaluate(
     UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
   std::vector<type::Value> child_values;
 
-  PL_ASSERT(func_.impl != nullptr);
   for (auto &child : children_) {
     child_values.push_back(child->Evaluate(tuple1, tuple2, context));
   }
 
+  // UDFs were compiled to native code at CREATE FUNCTION time; call the
+  // compiled body instead of interpreting it
+  if (is_udf_) {
+    return EvaluateUDF(child_values);
+  }
+
+  PL_ASSERT(func_.impl != nullptr);
   type::Value ret = func_.impl(child_values);
 
   // TODO: Checking this every time is not necessary, but it prevents crashing
@@ -61,6 +111,52 @@ type::Value FunctionExpression::Evaluate(
   return ret;
 }
 
+type::Value FunctionExpression::EvaluateUDF(
+    const std::vector<type::Value> &child_values) const {
+  PL_ASSERT(func_context_ != nullptr);
+
+  auto *compiled_func = func_context_->GetUDF();
+  if (compiled_func == nullptr) {
+    throw Exception(ExceptionType::EXPRESSION,
+                    "UDF " + func_name_ + " has no compiled body.");
+  }
+
+  auto *raw_fn = func_context_->GetRawFunctionPointer(compiled_func);
+  PL_ASSERT(raw_fn != nullptr);
+
+  // UDFHandler maps DECIMAL to double and INTEGER to int32; a signature
+  // that sticks to one of them can be called through a plain C function
+  // pointer without any per-argument marshalling
+  bool uniform_decimal = (return_value_type_ == type::TypeId::DECIMAL);
+  bool uniform_integer = (return_value_type_ == type::TypeId::INTEGER);
+  for (auto arg_type : func_arg_types_) {
+    uniform_decimal = uniform_decimal && (arg_type == type::TypeId::DECIMAL);
+    uniform_integer = uniform_integer && (arg_type == type::TypeId::INTEGER);
+  }
+
+  if (uniform_decimal) {
+    std::vector<double> raw_args;
+    for (auto &value : child_values) {
+      raw_args.push_back(value.GetAs<double>());
+    }
+    return type::ValueFactory::GetDecimalValue(
+        InvokeUniformUDF<double>(raw_fn, raw_args));
+  }
+
+  if (uniform_integer) {
+    std::vector<int32_t> raw_args;
+    for (auto &value : child_values) {
+      raw_args.push_back(value.GetAs<int32_t>());
+    }
+    return type::ValueFactory::GetIntegerValue(
+        InvokeUniformUDF<int32_t>(raw_fn, raw_args));
+  }
+
+  throw Exception(ExceptionType::EXPRESSION,
+                  "UDF " + func_name_ +
+                      " has a signature that cannot be called directly.");
+}
+
 void FunctionExpression::SetBuiltinFunctionExpressionParameters(
     function::BuiltInFuncType func_ptr, type::TypeId val_type,
     const std::vector<type::TypeId> &arg_types) {
@@ -17,7 +17,7 @@
 #include <string>
 
 #include "executor/executor_context.h"
-#include "function/string_functions.h"
+#include "function/builtin_registry.h"
 #include "type/value_factory.h"
 
 namespace peloton {
@@ -32,8 +32,8 @@ type::Value OldEngineStringFunctions::Ascii(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  uint32_t ret = StringFunctions::Ascii(ctx, args[0].GetAs<const char *>(),
-                                        args[0].GetLength());
+  uint32_t ret = RawBuiltin<OperatorId::Ascii>::Get()(
+      ctx, args[0].GetAs<const char *>(), args[0].GetLength());
   return type::ValueFactory::GetIntegerValue(ret);
 }
 
@@ -45,7 +45,7 @@ type::Value OldEngineStringFunctions::Like(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  bool ret = StringFunctions::Like(
+  bool ret = RawBuiltin<OperatorId::Like>::Get()(
       ctx, args[0].GetAs<const char *>(), args[0].GetLength(),
       args[1].GetAs<const char *>(), args[1].GetLength());
   return type::ValueFactory::GetBooleanValue(ret);
@@ -70,11 +70,21 @@ type::Value OldEngineStringFunctions::Substr(
   if (args[0].IsNull() || args[1].IsNull() || args[2].IsNull()) {
     return type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR);
   }
-  std::string str = args[0].ToString();
-  int32_t from = args[1].GetAs<int32_t>() - 1;
-  int32_t len = args[2].GetAs<int32_t>();
+  executor::ExecutorContext ctx{nullptr};
+  auto ret = RawBuiltin<OperatorId::Substr>::Get()(
+      ctx, args[0].GetAs<const char *>(), args[0].GetLength(),
+      args[1].GetAs<int32_t>(), args[2].GetAs<int32_t>());
 
-  return type::ValueFactory::GetVarcharValue(str.substr(from, len));
+  if (ret.str == nullptr) {
+    return type::ValueFactory::GetVarcharValue("");
+  }
+  // the raw length counts one terminator slot, and the substring can still
+  // cover the input's terminator when it runs off the end of the input
+  uint32_t length = ret.length > 0 ? ret.length - 1 : 0;
+  if (length > 0 && ret.str[length - 1] == '\0') {
+    length--;
+  }
+  return type::ValueFactory::GetVarcharValue(std::string(ret.str, length));
 }
 
 // Number of characters in string
@@ -161,7 +171,7 @@ type::Value OldEngineStringFunctions::LTrim(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  auto ret = StringFunctions::LTrim(
+  auto ret = RawBuiltin<OperatorId::LTrim>::Get()(
       ctx, args.at(0).GetData(), strlen(args.at(0).GetData()) + 1,
       args.at(1).GetData(), strlen(args.at(1).GetData()) + 1);
 
@@ -179,7 +189,7 @@ type::Value OldEngineStringFunctions::RTrim(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  auto ret = StringFunctions::RTrim(
+  auto ret = RawBuiltin<OperatorId::RTrim>::Get()(
       ctx, args.at(0).GetData(), strlen(args.at(0).GetData()) + 1,
       args.at(1).GetData(), strlen(args.at(1).GetData()) + 1);
 
@@ -203,7 +213,7 @@ type::Value OldEngineStringFunctions::BTrim(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  auto ret = StringFunctions::BTrim(
+  auto ret = RawBuiltin<OperatorId::BTrim>::Get()(
       ctx, args.at(0).GetData(), strlen(args.at(0).GetData()) + 1,
       args.at(1).GetData(), strlen(args.at(1).GetData()) + 1);
 
@@ -220,8 +230,8 @@ type::Value OldEngineStringFunctions::Length(
   }
 
   executor::ExecutorContext ctx{nullptr};
-  uint32_t ret = StringFunctions::Length(ctx, args[0].GetAs<const char *>(),
-                                         args[0].GetLength());
+  uint32_t ret = RawBuiltin<OperatorId::Length>::Get()(
+      ctx, args[0].GetAs<const char *>(), args[0].GetLength());
   return type::ValueFactory::GetIntegerValue(ret);
 }
 
@@ -12,6 +12,9 @@
 
 #include "function/string_functions.h"
 
+#include <cctype>
+#include <cstring>
+
 #include "common/macros.h"
 #include "executor/executor_context.h"
 
@@ -24,13 +27,14 @@ uint32_t StringFunctions::Ascii(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
   return length <= 1 ? 0 : static_cast<uint32_t>(str[0]);
 }
 
+namespace {
+
 #define NextByte(p, plen) ((p)++, (plen)--)
 
-bool StringFunctions::Like(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
-                           const char *t, uint32_t tlen, const char *p,
-                           uint32_t plen) {
-  PL_ASSERT(t != nullptr);
-  PL_ASSERT(p != nullptr);
+// The general recursive matcher, handling every wildcard shape. Patterns
+// that reduce to a single literal probe are routed around it by Like().
+bool LikeRecursive(const char *t, uint32_t tlen, const char *p,
+                   uint32_t plen) {
   if (plen == 1 && *p == '%') return true;
 
   while (tlen > 0 && plen > 0) {
@@ -63,7 +67,7 @@ bool StringFunctions::Like(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
 
       while (tlen > 0) {
         if (tolower(*t) == firstpat) {
-          int matched = Like(ctx, t, tlen, p, plen);
+          int matched = LikeRecursive(t, tlen, p, plen);
 
           if (matched != false) return matched;
         }
@@ -92,6 +96,113 @@ bool StringFunctions::Like(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
 
 #undef NextByte
 
+// Case-insensitive equality over len bytes, folding each byte the same way
+// the recursive matcher does so the two agree on every input.
+inline bool EqualsIgnoreCase(const char *a, const char *b, uint32_t len) {
+  for (uint32_t i = 0; i < len; i++) {
+    if (tolower(a[i]) != tolower(b[i])) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+StringFunctions::LikePatternType StringFunctions::ClassifyLikePattern(
+    const char *p, uint32_t plen, const char **literal,
+    uint32_t *literal_length) {
+  // Only '%' runs at the pattern's ends reduce to a literal probe; '_' and
+  // escapes keep their per-character handling in the recursive matcher. A
+  // trailing '%' that is really escaped leaves its '\\' inside the literal
+  // span, which the scan below rejects.
+  uint32_t begin = 0;
+  while (begin < plen && p[begin] == '%') begin++;
+  uint32_t end = plen;
+  while (end > begin && p[end - 1] == '%') end--;
+
+  for (uint32_t i = begin; i < end; i++) {
+    if (p[i] == '%' || p[i] == '_' || p[i] == '\\') {
+      return LikePatternType::General;
+    }
+  }
+
+  *literal = p + begin;
+  *literal_length = end - begin;
+  const bool leading = (begin > 0);
+  const bool trailing = (end < plen);
+  if (leading && trailing) return LikePatternType::Contains;
+  if (trailing) return LikePatternType::Prefix;
+  if (leading) return LikePatternType::Suffix;
+  return LikePatternType::Exact;
+}
+
+bool StringFunctions::LikeLiteralMatch(LikePatternType pattern_type,
+                                       const char *t, uint32_t tlen,
+                                       const char *literal,
+                                       uint32_t literal_length) {
+  switch (pattern_type) {
+    case LikePatternType::Exact:
+      return tlen == literal_length &&
+             EqualsIgnoreCase(t, literal, literal_length);
+    case LikePatternType::Prefix:
+      return tlen >= literal_length &&
+             EqualsIgnoreCase(t, literal, literal_length);
+    case LikePatternType::Suffix:
+      return tlen >= literal_length &&
+             EqualsIgnoreCase(t + tlen - literal_length, literal,
+                              literal_length);
+    case LikePatternType::Contains: {
+      if (literal_length == 0) return true;
+      if (tlen < literal_length) return false;
+      const char first = static_cast<char>(tolower(literal[0]));
+      const char *last = t + (tlen - literal_length);
+      if (isalpha(static_cast<unsigned char>(first)) == 0) {
+        // Case folding cannot produce a non-alphabetic byte from a
+        // different one, so memchr can jump straight to the candidates
+        const char *cursor = t;
+        while (cursor <= last) {
+          cursor = static_cast<const char *>(
+              memchr(cursor, first, last - cursor + 1));
+          if (cursor == nullptr) return false;
+          if (EqualsIgnoreCase(cursor + 1, literal + 1, literal_length - 1)) {
+            return true;
+          }
+          cursor++;
+        }
+        return false;
+      }
+      for (const char *cursor = t; cursor <= last; cursor++) {
+        if (tolower(*cursor) == first &&
+            EqualsIgnoreCase(cursor + 1, literal + 1, literal_length - 1)) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case LikePatternType::General:
+      break;
+  }
+  PL_ASSERT(false);
+  return false;
+}
+
+bool StringFunctions::Like(UNUSED_ATTRIBUTE executor::ExecutorContext &ctx,
+                           const char *t, uint32_t tlen, const char *p,
+                           uint32_t plen) {
+  PL_ASSERT(t != nullptr);
+  PL_ASSERT(p != nullptr);
+
+  // Patterns generated by search endpoints are overwhelmingly a literal
+  // with '%' at one or both ends; those take a single bounded compare or
+  // substring search instead of the recursive walk.
+  const char *literal;
+  uint32_t literal_length;
+  auto pattern_type = ClassifyLikePattern(p, plen, &literal, &literal_length);
+  if (pattern_type != LikePatternType::General) {
+    return LikeLiteralMatch(pattern_type, t, tlen, literal, literal_length);
+  }
+  return LikeRecursive(t, tlen, p, plen);
+}
+
 StringFunctions::StrWithLen StringFunctions::Substr(
     UNUSED_ATTRIBUTE executor::ExecutorContext &ctx, const char *str,
     uint32_t str_length, int32_t from, int32_t len) {
@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// system_functions.cpp
+//
+// Identification: src/function/system_functions.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "function/system_functions.h"
+
+#include "executor/query_progress_registry.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace function {
+
+type::Value SystemFunctions::KillQuery(const std::vector<type::Value> &args) {
+  PL_ASSERT(args.size() == 1);
+  if (args[0].IsNull()) {
+    return type::ValueFactory::GetNullValueByType(type::TypeId::BOOLEAN);
+  }
+
+  uint64_t query_id = static_cast<uint64_t>(args[0].GetAs<int64_t>());
+  bool found =
+      executor::QueryProgressRegistry::GetInstance().RequestCancel(query_id);
+  return type::ValueFactory::GetBooleanValue(found);
+}
+
+}  // namespace function
+}  // namespace peloton
@@ -17,6 +17,7 @@
 #include <inttypes.h>
 
 #include "common/logger.h"
+#include "function/builtin_registry.h"
 #include "type/limits.h"
 #include "type/value_factory.h"
 
@@ -153,7 +154,7 @@ type::Value TimestampFunctions::_DateTrunc(
     return type::ValueFactory::GetNullValueByType(type::TypeId::TIMESTAMP);
   }
 
-  uint64_t ret = DateTrunc(date_part, timestamp);
+  uint64_t ret = RawBuiltin<OperatorId::DateTrunc>::Get()(date_part, timestamp);
   return type::ValueFactory::GetTimestampValue(ret);
 }
 
@@ -286,7 +287,7 @@ type::Value TimestampFunctions::_DatePart(
     return type::ValueFactory::GetNullValueByType(type::TypeId::TIMESTAMP);
   }
 
-  double ret = DatePart(date_part, timestamp);
+  double ret = RawBuiltin<OperatorId::DatePart>::Get()(date_part, timestamp);
   return type::ValueFactory::GetDecimalValue(ret);
 }
 }  // namespace function
@@ -0,0 +1,295 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// timestamp_vector_functions.cpp
+//
+// Identification: src/function/timestamp_vector_functions.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "function/timestamp_vector_functions.h"
+
+#include <date/date.h>
+#include <date/iso_week.h>
+
+#include "common/macros.h"
+#include "type/limits.h"
+
+namespace peloton {
+namespace function {
+
+namespace {
+
+// The integer fields packed into a Peloton timestamp; see
+// DateFunctions::Now() for the encoding
+struct DecodedTimestamp {
+  uint32_t micro;
+  uint16_t sec;
+  uint16_t min;
+  uint16_t hour;
+  uint16_t year;
+  uint16_t tz;
+  uint16_t day;
+  uint16_t month;
+};
+
+inline DecodedTimestamp Decode(uint64_t value) {
+  DecodedTimestamp ts;
+  uint64_t timestamp = value;
+  ts.micro = timestamp % 1000000;
+  timestamp /= 1000000;
+  uint32_t hour_min_sec = timestamp % 100000;
+  ts.sec = hour_min_sec % 60;
+  hour_min_sec /= 60;
+  ts.min = hour_min_sec % 60;
+  hour_min_sec /= 60;
+  ts.hour = hour_min_sec % 24;
+  timestamp /= 100000;
+  ts.year = timestamp % 10000;
+  timestamp /= 10000;
+  ts.tz = timestamp % 27;
+  timestamp /= 27;  // skip time zone
+  ts.day = timestamp % 32;
+  timestamp /= 32;
+  ts.month = timestamp;
+  return ts;
+}
+
+// Day of week (0 = Sunday), needed only by the week/day-of-year family
+inline uint16_t DayOfWeek(const DecodedTimestamp &ts) {
+  date::year_month_day ymd = date::year_month_day{
+      date::year{ts.year}, date::month{ts.month}, date::day{ts.day}};
+  iso_week::year_weeknum_weekday yww = iso_week::year_weeknum_weekday{ymd};
+  return ((unsigned)yww.weekday()) == 7 ? 0 : (unsigned)yww.weekday();
+}
+
+// Per-part truncation of one decoded timestamp; the date part is a template
+// argument so every branch below folds away at instantiation time
+template <DatePartType Part>
+inline uint64_t DateTruncOne(uint64_t value, const DecodedTimestamp &ts) {
+  switch (Part) {
+    case DatePartType::CENTURY:
+      return ((((uint64_t)32 + 1) * 27 + ts.tz) * 10000 + ts.year -
+              ts.year % 100 + 1) *
+             100000 * 1000000;
+    case DatePartType::DAY:
+      return ((((uint64_t)ts.month * 32 + ts.day) * 27 + ts.tz) * 10000 +
+              ts.year) *
+             100000 * 1000000;
+    case DatePartType::DECADE:
+      return ((((uint64_t)32 + 1) * 27 + ts.tz) * 10000 + ts.year -
+              ts.year % 10) *
+             100000 * 1000000;
+    case DatePartType::HOUR:
+      return (((((uint64_t)ts.month * 32 + ts.day) * 27 + ts.tz) * 10000 +
+               ts.year) *
+                  100000 +
+              ts.hour * 3600) *
+             1000000;
+    case DatePartType::MICROSECOND:
+      return value;
+    case DatePartType::MILLENNIUM:
+      return ((((uint64_t)32 + 1) * 27 + ts.tz) * 10000 + ts.year -
+              ts.year % 1000 + 1) *
+             100000 * 1000000;
+    case DatePartType::MILLISECOND:
+      return value - ts.micro % 1000;
+    case DatePartType::MINUTE:
+      return value - ts.micro - ts.sec * 1000000;
+    case DatePartType::MONTH:
+      return ((((uint64_t)ts.month * 32 + 1) * 27 + ts.tz) * 10000 + ts.year) *
+             100000 * 1000000;
+    case DatePartType::QUARTER: {
+      uint64_t quarter = (ts.month - 1) / 3 + 1;
+      return (((((quarter - 1) * 3 + 1) * 32 + 1) * 27 + ts.tz) * 10000 +
+              ts.year) *
+             100000 * 1000000;
+    }
+    case DatePartType::SECOND:
+      return value - ts.micro;
+    case DatePartType::WEEK: {
+      uint16_t dow = DayOfWeek(ts);
+      return ((((uint64_t)ts.month * 32 + ts.day -
+                (dow == 0 ? 6 : (dow - 1))) *
+                   27 +
+               ts.tz) *
+                  10000 +
+              ts.year) *
+             100000 * 1000000;
+    }
+    case DatePartType::YEAR:
+      return ((((uint64_t)32 + 1) * 27 + ts.tz) * 10000 + ts.year) * 100000 *
+             1000000;
+    default:
+      return type::PELOTON_TIMESTAMP_NULL;
+  }
+}
+
+// Per-part extraction of one decoded timestamp
+template <DatePartType Part>
+inline double DatePartOne(const DecodedTimestamp &ts) {
+  switch (Part) {
+    case DatePartType::CENTURY:
+      return (ts.year - 1) / 100 + 1;
+    case DatePartType::DAY:
+      return ts.day;
+    case DatePartType::DECADE:
+      return ts.year / 10;
+    case DatePartType::DOW:
+      return DayOfWeek(ts);
+    case DatePartType::DOY: {
+      date::year_month_day ymd = date::year_month_day{
+          date::year{ts.year}, date::month{ts.month}, date::day{ts.day}};
+      date::year_month_day year_begin = date::year_month_day{
+          date::year{ts.year}, date::month{1}, date::day{1}};
+      date::days duration = date::sys_days{ymd} - date::sys_days{year_begin};
+      return duration.count() + 1;
+    }
+    case DatePartType::HOUR:
+      return ts.hour;
+    case DatePartType::MICROSECOND:
+      return ts.sec * 1000000 + ts.micro;
+    case DatePartType::MILLENNIUM:
+      return (ts.year - 1) / 1000 + 1;
+    case DatePartType::MILLISECOND:
+      return ts.sec * 1000 + ts.micro / 1000.0;
+    case DatePartType::MINUTE:
+      return ts.min;
+    case DatePartType::MONTH:
+      return ts.month;
+    case DatePartType::QUARTER:
+      return (ts.month - 1) / 3 + 1;
+    case DatePartType::SECOND:
+      return ts.sec + ts.micro / 1000000.0;
+    case DatePartType::WEEK: {
+      date::year_month_day ymd = date::year_month_day{
+          date::year{ts.year}, date::month{ts.month}, date::day{ts.day}};
+      iso_week::year_weeknum_weekday yww = iso_week::year_weeknum_weekday{ymd};
+      return (unsigned)yww.weeknum();
+    }
+    case DatePartType::YEAR:
+      return ts.year;
+    default:
+      return type::PELOTON_DECIMAL_NULL;
+  }
+}
+
+template <DatePartType Part>
+void DateTruncLoop(const uint64_t *timestamps, uint64_t *results,
+                   size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    uint64_t value = timestamps[i];
+    if (unlikely_branch(value == type::PELOTON_TIMESTAMP_NULL)) {
+      results[i] = type::PELOTON_TIMESTAMP_NULL;
+      continue;
+    }
+    results[i] = DateTruncOne<Part>(value, Decode(value));
+  }
+}
+
+template <DatePartType Part>
+void DatePartLoop(const uint64_t *timestamps, double *results, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    uint64_t value = timestamps[i];
+    if (unlikely_branch(value == type::PELOTON_TIMESTAMP_NULL)) {
+      results[i] = type::PELOTON_DECIMAL_NULL;
+      continue;
+    }
+    results[i] = DatePartOne<Part>(Decode(value));
+  }
+}
+
+}  // namespace
+
+void TimestampVectorFunctions::DateTruncBatch(DatePartType date_part,
+                                              const uint64_t *timestamps,
+                                              uint64_t *results,
+                                              size_t count) {
+  switch (date_part) {
+    case DatePartType::CENTURY:
+      return DateTruncLoop<DatePartType::CENTURY>(timestamps, results, count);
+    case DatePartType::DAY:
+      return DateTruncLoop<DatePartType::DAY>(timestamps, results, count);
+    case DatePartType::DECADE:
+      return DateTruncLoop<DatePartType::DECADE>(timestamps, results, count);
+    case DatePartType::HOUR:
+      return DateTruncLoop<DatePartType::HOUR>(timestamps, results, count);
+    case DatePartType::MICROSECOND:
+      return DateTruncLoop<DatePartType::MICROSECOND>(timestamps, results,
+                                                      count);
+    case DatePartType::MILLENNIUM:
+      return DateTruncLoop<DatePartType::MILLENNIUM>(timestamps, results,
+                                                     count);
+    case DatePartType::MILLISECOND:
+      return DateTruncLoop<DatePartType::MILLISECOND>(timestamps, results,
+                                                      count);
+    case DatePartType::MINUTE:
+      return DateTruncLoop<DatePartType::MINUTE>(timestamps, results, count);
+    case DatePartType::MONTH:
+      return DateTruncLoop<DatePartType::MONTH>(timestamps, results, count);
+    case DatePartType::QUARTER:
+      return DateTruncLoop<DatePartType::QUARTER>(timestamps, results, count);
+    case DatePartType::SECOND:
+      return DateTruncLoop<DatePartType::SECOND>(timestamps, results, count);
+    case DatePartType::WEEK:
+      return DateTruncLoop<DatePartType::WEEK>(timestamps, results, count);
+    case DatePartType::YEAR:
+      return DateTruncLoop<DatePartType::YEAR>(timestamps, results, count);
+    default: {
+      for (size_t i = 0; i < count; i++) {
+        results[i] = type::PELOTON_TIMESTAMP_NULL;
+      }
+    }
+  }
+}
+
+void TimestampVectorFunctions::DatePartBatch(DatePartType date_part,
+                                             const uint64_t *timestamps,
+                                             double *results, size_t count) {
+  switch (date_part) {
+    case DatePartType::CENTURY:
+      return DatePartLoop<DatePartType::CENTURY>(timestamps, results, count);
+    case DatePartType::DAY:
+      return DatePartLoop<DatePartType::DAY>(timestamps, results, count);
+    case DatePartType::DECADE:
+      return DatePartLoop<DatePartType::DECADE>(timestamps, results, count);
+    case DatePartType::DOW:
+      return DatePartLoop<DatePartType::DOW>(timestamps, results, count);
+    case DatePartType::DOY:
+      return DatePartLoop<DatePartType::DOY>(timestamps, results, count);
+    case DatePartType::HOUR:
+      return DatePartLoop<DatePartType::HOUR>(timestamps, results, count);
+    case DatePartType::MICROSECOND:
+      return DatePartLoop<DatePartType::MICROSECOND>(timestamps, results,
+                                                     count);
+    case DatePartType::MILLENNIUM:
+      return DatePartLoop<DatePartType::MILLENNIUM>(timestamps, results,
+                                                    count);
+    case DatePartType::MILLISECOND:
+      return DatePartLoop<DatePartType::MILLISECOND>(timestamps, results,
+                                                     count);
+    case DatePartType::MINUTE:
+      return DatePartLoop<DatePartType::MINUTE>(timestamps, results, count);
+    case DatePartType::MONTH:
+      return DatePartLoop<DatePartType::MONTH>(timestamps, results, count);
+    case DatePartType::QUARTER:
+      return DatePartLoop<DatePartType::QUARTER>(timestamps, results, count);
+    case DatePartType::SECOND:
+      return DatePartLoop<DatePartType::SECOND>(timestamps, results, count);
+    case DatePartType::WEEK:
+      return DatePartLoop<DatePartType::WEEK>(timestamps, results, count);
+    case DatePartType::YEAR:
+      return DatePartLoop<DatePartType::YEAR>(timestamps, results, count);
+    default: {
+      for (size_t i = 0; i < count; i++) {
+        results[i] = type::PELOTON_DECIMAL_NULL;
+      }
+    }
+  }
+}
+
+}  // namespace function
+}  // namespace peloton
@@ -16,12 +16,18 @@
 #include "concurrency/transaction_context.h"
 #include "type/value.h"
 #include "type/abstract_pool.h"
+#include "storage/data_table.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 
 namespace peloton {
 namespace gc {
 
+// Without a background GC the dropped table is torn down right here
+void GCManager::RecycleDroppedTable(storage::DataTable *table) {
+  delete table;
+}
+
 // Check a tuple and reclaim all varlen field
 void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id) {
     oid_t tile_count = tg->tile_count;
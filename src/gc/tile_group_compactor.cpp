@@ -0,0 +1,244 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/gc/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "gc/tile_group_compactor.h"
+
+#include "catalog/manager.h"
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace gc {
+
+TileGroupCompactor::TileGroupCompactor() {
+  // Nothing to do here !
+}
+
+TileGroupCompactor::~TileGroupCompactor() {}
+
+TileGroupCompactor &TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor compactor;
+  return compactor;
+}
+
+void TileGroupCompactor::Start() {
+  // Set signal
+  compaction_stop_ = false;
+
+  // Launch thread
+  compactor_thread_ = std::thread(&gc::TileGroupCompactor::Compact, this);
+
+  LOG_INFO("Started tile group compactor");
+}
+
+void TileGroupCompactor::Compact() {
+  // Continue till signal is not false
+  while (compaction_stop_ == false) {
+    {
+      std::lock_guard<std::mutex> lock(compactor_mutex_);
+      for (auto table : tables_) {
+        CompactTable(table);
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(pause_duration_));
+  }
+}
+
+void TileGroupCompactor::Stop() {
+  // Stop compaction
+  compaction_stop_ = true;
+
+  // Stop thread
+  compactor_thread_.join();
+
+  LOG_INFO("Stopped tile group compactor");
+}
+
+void TileGroupCompactor::AddTable(storage::DataTable *table) {
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  tables_.push_back(table);
+}
+
+void TileGroupCompactor::ClearTables() {
+  std::lock_guard<std::mutex> lock(compactor_mutex_);
+  tables_.clear();
+}
+
+size_t TileGroupCompactor::CompactTable(storage::DataTable *table) {
+  auto &compactor = GetInstance();
+  oid_t threshold = static_cast<oid_t>(settings::SettingsManager::GetInt(
+      settings::SettingId::tile_group_compaction_threshold));
+
+  size_t actions = 0;
+  size_t tile_group_count = table->GetTileGroupCount();
+  for (size_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t allocated_count = tile_group->GetAllocatedTupleCount();
+    bool sparse = tile_group_header->GetDeadTupleCount() * 100 >=
+                  allocated_count * threshold;
+
+    if (tile_group_header->GetImmutability() == true) {
+      // Retired shells (no slot ever handed out) are done; other
+      // immutable tile groups (frozen by us or made cold by the tiering
+      // service) are only touched once deletes have made them sparse
+      if (tile_group->GetNextTupleSlot() == 0 || sparse == false) {
+        continue;
+      }
+      if (tile_group_header->GetActiveTupleCount() == 0) {
+        // The GC has reclaimed every version: swap in a shell and let the
+        // epoch mechanism free the storage
+        RetireTileGroup(table, tile_group);
+        compactor.tile_groups_retired_.fetch_add(1);
+        actions++;
+      } else {
+        // Survivors remain: either a move aborted by a concurrent writer,
+        // or moved-out versions the GC has not reset yet (those are
+        // invisible, so retrying the move is cheap and idempotent)
+        MoveTuplesOutOfTileGroup(table, tile_group);
+      }
+      continue;
+    }
+
+    // Only full tile groups are candidates: the active ones still take
+    // fresh inserts
+    if (tile_group->GetNextTupleSlot() < allocated_count || sparse == false) {
+      continue;
+    }
+
+    // Freeze the tile group so its slots stop being recycled, then move
+    // the survivors into fresh tile groups
+    if (tile_group_header->SetImmutability() == false) {
+      continue;
+    }
+
+    if (MoveTuplesOutOfTileGroup(table, tile_group) == true) {
+      compactor.tile_groups_compacted_.fetch_add(1);
+      actions++;
+    }
+  }
+
+  return actions;
+}
+
+bool TileGroupCompactor::MoveTuplesOutOfTileGroup(
+    storage::DataTable *table, std::shared_ptr<storage::TileGroup> tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  oid_t used_slots = tile_group->GetNextTupleSlot();
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+
+  auto *txn = txn_manager.BeginTransaction();
+
+  // Moving a version never changes its contents, so the empty target list
+  // makes InstallVersion skip every secondary index: the indexes keep
+  // pointing at the indirection, which PerformUpdate redirects
+  TargetList empty_targets;
+
+  for (oid_t physical_tuple_id = 0; physical_tuple_id < used_slots;
+       physical_tuple_id++) {
+    if (txn_manager.IsVisible(txn, tile_group_header, physical_tuple_id) !=
+        VisibilityType::OK) {
+      continue;
+    }
+
+    bool is_owner =
+        txn_manager.IsOwner(txn, tile_group_header, physical_tuple_id);
+    if (is_owner == false) {
+      if (txn_manager.IsOwnable(txn, tile_group_header, physical_tuple_id) ==
+              false ||
+          txn_manager.AcquireOwnership(txn, tile_group_header,
+                                       physical_tuple_id) == false) {
+        // A concurrent writer holds this version: give up and retry the
+        // whole tile group on a later pass
+        LOG_TRACE("Tile group %u move blocked by a concurrent writer",
+                  tile_group_id);
+        txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+        txn_manager.AbortTransaction(txn);
+        return false;
+      }
+    }
+
+    ItemPointer old_location(tile_group_id, physical_tuple_id);
+
+    // acquire a version slot from the table.
+    ItemPointer new_location = table->AcquireVersion();
+
+    auto new_tile_group = manager.GetTileGroup(new_location.block);
+
+    ContainerTuple<storage::TileGroup> new_tuple(new_tile_group.get(),
+                                                 new_location.offset);
+    ContainerTuple<storage::TileGroup> old_tuple(tile_group.get(),
+                                                 physical_tuple_id);
+
+    // identity projection: the new version is a verbatim copy
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      new_tuple.SetValue(column_itr, old_tuple.GetValue(column_itr));
+    }
+
+    ItemPointer *indirection =
+        tile_group_header->GetIndirection(physical_tuple_id);
+
+    if (table->InstallVersion(&new_tuple, &empty_targets, txn, indirection) ==
+        false) {
+      // the write lock acquired above is not in the write set yet, so it
+      // must be released here before aborting
+      if (is_owner == false) {
+        txn_manager.YieldOwnership(txn, tile_group_header, physical_tuple_id);
+      }
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      txn_manager.AbortTransaction(txn);
+      return false;
+    }
+
+    txn_manager.PerformUpdate(txn, old_location, new_location);
+  }
+
+  return txn_manager.CommitTransaction(txn) == ResultType::SUCCESS;
+}
+
+void TileGroupCompactor::RetireTileGroup(
+    storage::DataTable *table, std::shared_ptr<storage::TileGroup> tile_group) {
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+
+  // Tiles cannot be allocated with zero slots, so the shell keeps one;
+  // it is never handed out because the shell's next slot stays at zero
+  // and its header is immutable
+  std::shared_ptr<storage::TileGroup> shell(
+      storage::TileGroupFactory::GetTileGroup(
+          table->GetDatabaseOid(), table->GetOid(), tile_group_id, table,
+          tile_group->GetTileSchemas(), tile_group->GetColumnMap(), 1));
+  shell->GetHeader()->SetImmutability();
+
+  // The shell takes the emptied tile group's place under the same oid, so
+  // the offsets a concurrent scan iterates over stay stable; the old
+  // storage is freed once every epoch active at this point has expired
+  catalog::Manager::GetInstance().ReplaceTileGroup(tile_group_id, shell);
+
+  LOG_TRACE("Retired tile group %u", tile_group_id);
+}
+
+}  // namespace gc
+}  // namespace peloton
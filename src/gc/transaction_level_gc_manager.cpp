@@ -19,8 +19,11 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "settings/settings_manager.h"
 #include "index/index.h"
+#include "storage/data_table.h"
 #include "storage/database.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
+#include "type/ephemeral_pool.h"
 #include "storage/tuple.h"
 #include "storage/storage_manager.h"
 #include "threadpool/mono_queue_pool.h"
@@ -48,6 +51,10 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   // Reclaim the varlen pool
   CheckAndReclaimVarlenColumns(tile_group, location.offset);
 
+  // Account the slot as dead until it is recycled; the compaction service
+  // reads this to find sparse tile groups
+  tile_group_header->IncrementDeadTupleCount();
+
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
 }
@@ -69,6 +76,11 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
     int reclaimed_count = Reclaim(thread_id, expired_eid);
     int unlinked_count = Unlink(thread_id, expired_eid);
 
+    // The first dedicated thread doubles as the scaling controller
+    if (thread_id == 0) {
+      AdjustWorkerCount();
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -100,11 +112,89 @@ void TransactionLevelGCManager::RecycleTransaction(
 
   // Add the transaction context to the lock-free queue
   unlink_queues_[HashToThread(txn->GetThreadId())]->Enqueue(txn);
+  unlink_backlog_.fetch_add(1);
+
+  // Gentle admission backpressure: when unlinking has fallen far behind even
+  // with all helpers active, make the writer that produced the garbage absorb
+  // a short pause so version chains stay bounded instead of growing without
+  // limit. Readers are never throttled.
+  if (is_running_ == true &&
+      txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY &&
+      txn->IsGCSetEmpty() == false) {
+    const int backlog = unlink_backlog_.load();
+    const int backpressure_point =
+        2 * active_worker_count_.load() * BACKLOG_PER_WORKER;
+    if (backlog > backpressure_point) {
+      // ramp from 0 up to at most 1 ms as the overshoot grows
+      uint64_t sleep_duration =
+          std::min<uint64_t>(1000, (backlog - backpressure_point) / 16);
+      if (sleep_duration > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+      }
+    }
+  }
+}
+
+void TransactionLevelGCManager::AdjustWorkerCount() {
+  const int active = active_worker_count_.load();
+  const int backlog = unlink_backlog_.load();
+  const int max_worker_count = gc_thread_count_ + MAX_HELPER_WORKER_COUNT;
+
+  if (backlog > active * BACKLOG_PER_WORKER && active < max_worker_count) {
+    // Scale up: open the next helper slot and hand it to the shared worker
+    // pool. Writers start hashing into the slot as soon as the count is
+    // bumped.
+    const int slot = active;
+    active_worker_count_.fetch_add(1);
+    threadpool::MonoQueuePool::GetInstance().SubmitTask(
+        [this, slot] { HelperLoop(slot); });
+    LOG_TRACE("GC scaled up to %d workers (backlog %d)", active + 1, backlog);
+  } else if (active > gc_thread_count_ &&
+             backlog < (active - 1) * BACKLOG_PER_WORKER / 2) {
+    // Scale down: retire the most recently opened helper. The helper notices
+    // the shrunken count, drains what is left in its slot and exits.
+    active_worker_count_.fetch_sub(1);
+    LOG_TRACE("GC scaled down to %d workers (backlog %d)", active - 1,
+              backlog);
+  }
+}
+
+void TransactionLevelGCManager::HelperLoop(const int slot) {
+  uint32_t backoff_shifts = 0;
+  while (is_running_ == true && slot < active_worker_count_.load()) {
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+    auto expired_eid = epoch_manager.GetExpiredEpochId();
+
+    if (expired_eid == MAX_EID) {
+      continue;
+    }
+
+    int reclaimed_count = Reclaim(slot, expired_eid);
+    int unlinked_count = Unlink(slot, expired_eid);
+
+    if (reclaimed_count == 0 && unlinked_count == 0) {
+      // sleep at most 0.8192 s
+      if (backoff_shifts < 13) {
+        ++backoff_shifts;
+      }
+      uint64_t sleep_duration = 1UL << backoff_shifts;
+      sleep_duration *= 100;
+      std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+    } else {
+      backoff_shifts >>= 1;
+    }
+  }
+
+  // Writers no longer feed this slot; drain what is parked here before
+  // handing the worker back to the pool
+  ClearGarbage(slot);
 }
 
 int TransactionLevelGCManager::Unlink(const int &thread_id,
                                       const eid_t &expired_eid) {
   int tuple_counter = 0;
+  bool queries_logged = false;
 
   // check if any garbage can be unlinked from indexes.
   // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
@@ -114,13 +204,15 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
   local_unlink_queues_[thread_id].remove_if(
       [&garbages, &tuple_counter, expired_eid,
        this](concurrency::TransactionContext *txn_ctx) -> bool {
-        bool res = txn_ctx->GetEpochId() <= expired_eid;
+        bool res = txn_ctx->GetEpochId() <= expired_eid &&
+                   IsSnapshotProtected(txn_ctx) == false;
         if (res == true) {
           // unlink versions from version chain and indexes
           UnlinkVersions(txn_ctx);
           // Add to the garbage map
           garbages.push_back(txn_ctx);
           tuple_counter++;
+          unlink_backlog_.fetch_sub(1);
         }
         return res;
       });
@@ -137,12 +229,12 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
       std::vector<std::string> query_strings = txn_ctx->GetQueryStrings();
       if(query_strings.size() != 0) {
         uint64_t timestamp = txn_ctx->GetTimestamp();
-        auto &pool = threadpool::MonoQueuePool::GetBrainInstance();
+        // recording is just a lock-free enqueue; the batch is written by a
+        // single flush task below instead of one pool task per query
         for(auto query_string: query_strings) {
-          pool.SubmitTask([this, query_string, timestamp] {
-            brain::QueryLogger::LogQuery(query_string, timestamp);
-          });        
+          brain::QueryLogger::LogQuery(query_string, timestamp);
         }
+        queries_logged = true;
       }
     }
 
@@ -150,21 +242,24 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
     // any garbage collection
     if (txn_ctx->GetIsolationLevel() == IsolationLevelType::READ_ONLY || \
         txn_ctx->IsGCSetEmpty()) {
-      delete txn_ctx;
+      concurrency::TransactionContext::RecycleInstance(txn_ctx);
+      unlink_backlog_.fetch_sub(1);
       continue;
     }
 
-    if (txn_ctx->GetEpochId() <= expired_eid) {
+    if (txn_ctx->GetEpochId() <= expired_eid &&
+        IsSnapshotProtected(txn_ctx) == false) {
       // as the global expired epoch id is no less than the garbage version's
-      // epoch id, it means that no active transactions can read the version. As
-      // a result, we can delete all the tuples from the indexes to which it
-      // belongs.
+      // epoch id, it means that no active transactions can read the version
+      // and no pinned export snapshot can see it. As a result, we can delete
+      // all the tuples from the indexes to which it belongs.
 
       // unlink versions from version chain and indexes
       UnlinkVersions(txn_ctx);
       // Add to the garbage map
       garbages.push_back(txn_ctx);
       tuple_counter++;
+      unlink_backlog_.fetch_sub(1);
 
     } else {
       // if a tuple cannot be reclaimed, then add it back to the list.
@@ -172,6 +267,12 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
     }
   }  // end for
 
+  // flush everything this pass recorded as one batch on a pool thread
+  if (queries_logged) {
+    threadpool::MonoQueuePool::GetBrainInstance().SubmitTask(
+        [] { brain::QueryLogger::Flush(); });
+  }
+
   // once the current epoch id is expired, then we know all the transactions
   // that are active at this time point will be committed/aborted.
   // at that time point, it is safe to recycle the version.
@@ -190,6 +291,19 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
                                        const eid_t &expired_eid) {
   int gc_counter = 0;
 
+  // varlen pools retired by compaction become deletable on the same
+  // condition as garbage versions: no active transaction can still hold a
+  // pointer into them
+  DeleteRetiredVarlenPools(expired_eid);
+
+  // same rule for dropped tile groups parked for epoch-protected raw
+  // readers (catalog::Manager::GetTileGroupRaw)
+  catalog::Manager::GetInstance().ReclaimRetiredTileGroups(expired_eid);
+
+  // dropped tables are drained a bounded slice of tile groups at a time, so
+  // one huge DROP TABLE cannot monopolize the pass
+  gc_counter += static_cast<int>(ReleaseDroppedTables(expired_eid));
+
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
   while (garbage_ctx_entry != reclaim_maps_[thread_id].end()) {
@@ -223,7 +337,7 @@ void TransactionLevelGCManager::AddToRecycleMap(
     // During the resetting, a table may be deconstructed because of the DROP
     // TABLE request
     if (tile_group == nullptr) {
-      delete txn_ctx;
+      concurrency::TransactionContext::RecycleInstance(txn_ctx);
       return;
     }
 
@@ -253,6 +367,13 @@ void TransactionLevelGCManager::AddToRecycleMap(
         recycle_queue_map_[table_id]->Enqueue(location);
       }
     }
+
+    // Immutable tile groups receive no further inserts (their slots are not
+    // recycled above), so their varlen pools only lose entries from here on
+    // and can be compacted safely.
+    if (immutable) {
+      CheckAndCompactTileGroup(tile_group.get());
+    }
   }
 
   auto storage_manager = storage::StorageManager::GetInstance();
@@ -279,7 +400,167 @@ void TransactionLevelGCManager::AddToRecycleMap(
     table->DropIndexWithOid(index_oid);
   }
 
-  delete txn_ctx;
+  concurrency::TransactionContext::RecycleInstance(txn_ctx);
+}
+
+void TransactionLevelGCManager::CheckAndCompactTileGroup(
+    storage::TileGroup *tile_group) {
+  oid_t tile_count = tile_group->GetTileCount();
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    storage::Tile *tile = tile_group->GetTile(tile_itr);
+    PL_ASSERT(tile != nullptr);
+    // Tiles only ever carry EphemeralPools (see the Tile constructor)
+    auto *pool = static_cast<type::EphemeralPool *>(tile->GetPool());
+    if (pool == nullptr) {
+      continue;
+    }
+
+    // Compact once enough bytes are dead that the copying pays off, and at
+    // least half of everything ever allocated is dead so short-lived churn
+    // does not trigger repeated copying
+    uint64_t freed_bytes = pool->GetFreedBytes();
+    if (freed_bytes < COMPACTION_MIN_FREED_BYTES ||
+        freed_bytes * 2 < pool->GetAllocatedBytes()) {
+      continue;
+    }
+
+    auto *retired_pool = tile->CompactVarlenPool();
+    if (retired_pool == nullptr) {
+      continue;
+    }
+
+    eid_t current_eid =
+        concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+    retired_pools_.Retire(std::unique_ptr<type::AbstractPool>(retired_pool),
+                          current_eid);
+    LOG_TRACE("Compacted varlen pool of tile %u in tile group %u", tile_itr,
+              tile_group->GetTileGroupId());
+  }
+}
+
+void TransactionLevelGCManager::DeleteRetiredVarlenPools(
+    const eid_t &expired_eid) {
+  retired_pools_.Reclaim(expired_eid);
+}
+
+void TransactionLevelGCManager::RecycleDroppedTable(
+    storage::DataTable *table) {
+  PL_ASSERT(table != nullptr);
+
+  // the table is already unlinked from its database, so the epoch current
+  // right now bounds the last reader that can still reach it
+  eid_t current_eid =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+  retired_tables_lock_.Lock();
+  retired_tables_.emplace_back(table, current_eid);
+  retired_tables_lock_.Unlock();
+
+  LOG_TRACE("Retired dropped table %u for background teardown",
+            table->GetOid());
+}
+
+size_t TransactionLevelGCManager::ReleaseDroppedTables(
+    const eid_t &expired_eid) {
+  // Claim the front entry so concurrent workers never tear down the same
+  // table twice; the latch is dropped while the tile groups are released.
+  retired_tables_lock_.Lock();
+  if (retired_tables_.empty() ||
+      retired_tables_.front().retire_eid > expired_eid) {
+    retired_tables_lock_.Unlock();
+    return 0;
+  }
+  RetiredTable entry = retired_tables_.front();
+  retired_tables_.pop_front();
+  retired_tables_lock_.Unlock();
+
+  size_t consumed_count = entry.table->DropTileGroups(
+      entry.next_tile_group_offset, DROPPED_TABLE_GROUPS_PER_PASS);
+
+  if (consumed_count == 0) {
+    // every tile group has been retired by earlier passes; the destructor
+    // has only cheap metadata cleanup left (the indexes were dropped
+    // separately before the table itself)
+    LOG_TRACE("Deleting dropped table %u", entry.table->GetOid());
+    delete entry.table;
+    return 0;
+  }
+
+  entry.next_tile_group_offset += consumed_count;
+  retired_tables_lock_.Lock();
+  retired_tables_.push_front(entry);
+  retired_tables_lock_.Unlock();
+
+  return consumed_count;
+}
+
+void TransactionLevelGCManager::PinSnapshot(const cid_t snapshot_cid) {
+  pinned_snapshots_lock_.Lock();
+  pinned_snapshots_.insert(snapshot_cid);
+  pinned_snapshots_lock_.Unlock();
+  pinned_snapshot_count_.fetch_add(1);
+
+  LOG_TRACE("Pinned export snapshot at cid %lu", snapshot_cid);
+}
+
+void TransactionLevelGCManager::UnpinSnapshot(const cid_t snapshot_cid) {
+  pinned_snapshots_lock_.Lock();
+  auto pin_itr = pinned_snapshots_.find(snapshot_cid);
+  PL_ASSERT(pin_itr != pinned_snapshots_.end());
+  pinned_snapshots_.erase(pin_itr);
+  pinned_snapshots_lock_.Unlock();
+  pinned_snapshot_count_.fetch_sub(1);
+
+  LOG_TRACE("Unpinned export snapshot at cid %lu", snapshot_cid);
+}
+
+bool TransactionLevelGCManager::IsSnapshotProtected(
+    concurrency::TransactionContext *txn_ctx) {
+  if (pinned_snapshot_count_.load() == 0) {
+    return false;
+  }
+
+  pinned_snapshots_lock_.Lock();
+  std::vector<cid_t> pins(pinned_snapshots_.begin(), pinned_snapshots_.end());
+  pinned_snapshots_lock_.Unlock();
+  if (pins.empty()) {
+    return false;
+  }
+
+  // A transaction's invalidations all carry its commit id, whose high bits
+  // are its epoch. A snapshot at cid S only cares about versions that died
+  // after S, i.e. about transactions from epochs above S's epoch; garbage
+  // from at or below it is reclaimable as usual, so GC keeps running above
+  // a pinned snapshot instead of stalling at it.
+  const eid_t txn_eid = txn_ctx->GetEpochId();
+  if (txn_eid <= (pins.front() >> 32)) {
+    return false;
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &entry : *(txn_ctx->GetGCSetPtr().get())) {
+    auto tile_group = manager.GetTileGroup(entry.first);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    for (auto &element : entry.second) {
+      // only versions a committed reader could ever have seen matter;
+      // aborted versions and insert-then-delete versions were never visible
+      if (element.second != GCVersionType::COMMIT_UPDATE &&
+          element.second != GCVersionType::COMMIT_DELETE) {
+        continue;
+      }
+      cid_t begin_cid = tile_group_header->GetBeginCommitId(element.first);
+      for (auto &pin : pins) {
+        // visible at the pin: created at or before it, invalidated after it
+        if (begin_cid <= pin && txn_eid > (pin >> 32)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
 }
 
 // this function returns a free tuple slot, if one exists
@@ -301,6 +582,25 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   return INVALID_ITEMPOINTER;
 }
 
+// batched variant of ReturnFreeSlot: one table lookup, many dequeues.
+size_t TransactionLevelGCManager::ReturnFreeSlots(
+    const oid_t &table_id, size_t max_count, std::vector<ItemPointer> &slots) {
+  auto recycle_queue_itr = recycle_queue_map_.find(table_id);
+  if (recycle_queue_itr == recycle_queue_map_.end()) {
+    return 0;
+  }
+  auto recycle_queue = recycle_queue_itr->second;
+
+  size_t dequeued_count = 0;
+  ItemPointer location;
+  while (dequeued_count < max_count &&
+         recycle_queue->Dequeue(location) == true) {
+    slots.push_back(location);
+    dequeued_count++;
+  }
+  return dequeued_count;
+}
+
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
   while (!unlink_queues_[thread_id]->IsEmpty() ||
          !local_unlink_queues_[thread_id].empty()) {
@@ -311,16 +611,29 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
     Reclaim(thread_id, MAX_CID);
   }
 
+  // drain dropped tables that were still being torn down incrementally
+  while (true) {
+    retired_tables_lock_.Lock();
+    bool empty = retired_tables_.empty();
+    retired_tables_lock_.Unlock();
+    if (empty) {
+      break;
+    }
+    ReleaseDroppedTables(MAX_EID);
+  }
+
   return;
 }
 
 void TransactionLevelGCManager::StopGC() {
   LOG_TRACE("Stopping GC");
   this->is_running_ = false;
-  // clear the garbage in each GC thread
-  for (int thread_id = 0; thread_id < gc_thread_count_; ++thread_id) {
+  // clear the garbage in each GC worker slot, helper slots included
+  const int total_worker_count = gc_thread_count_ + MAX_HELPER_WORKER_COUNT;
+  for (int thread_id = 0; thread_id < total_worker_count; ++thread_id) {
     ClearGarbage(thread_id);
   }
+  active_worker_count_ = gc_thread_count_;
 }
 
 void TransactionLevelGCManager::UnlinkVersions(
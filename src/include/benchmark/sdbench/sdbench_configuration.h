@@ -138,6 +138,17 @@ class configuration {
   bool holistic_indexing;
 
   oid_t multi_stage_idx = 0;
+
+  // HOT/COLD SKEW PARAMETERS
+
+  // whether to run the hot/cold skew experiment or not.
+  bool hot_cold;
+
+  // skew of the zipfian write distribution (0 = uniform, -> 1 = extreme)
+  double zipf_theta;
+
+  // fraction of the table covered by the moving hot window
+  double hot_window_fraction;
 };
 
 void Usage(FILE *out);
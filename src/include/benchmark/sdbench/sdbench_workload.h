@@ -23,6 +23,7 @@ extern configuration state;
 
 void RunSDBenchTest();
 void RunMultiStageBenchmark();
+void RunHotColdBenchmark();
 
 }  // namespace sdbench
 }  // namespace benchmark
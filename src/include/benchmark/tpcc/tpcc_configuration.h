@@ -203,6 +203,13 @@ class configuration {
   // abort rate
   double abort_rate = 0;
 
+  // fraction of transactions touching a warehouse outside the home
+  // partition
+  double cross_partition_rate = 0;
+
+  // per-partition throughput, only populated in affinity mode
+  std::vector<double> partition_throughput;
+
   std::vector<double> profile_throughput;
 
   std::vector<double> profile_abort_rate;
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "common/macros.h"
+#include "benchmark/benchmark_common.h"
 #include "benchmark/tpcc/tpcc_configuration.h"
 #include "benchmark/tpcc/tpcc_loader.h"
 #include "executor/abstract_executor.h"
@@ -29,6 +30,10 @@ namespace tpcc {
 
 extern configuration state;
 
+// per-thread count of committed transactions that touched a warehouse
+// outside the executing thread's home partition (affinity mode)
+extern PadInt *cross_partition_counts;
+
 void RunWorkload();
 
 bool RunNewOrder(const size_t &thread_id);
@@ -85,6 +85,17 @@ struct Configuration {
   // The number of runs to average over
   uint32_t num_runs = 10;
 
+  // The number of concurrent query streams. One stream runs the queries
+  // serially; more than one runs the TPC-H throughput test, each stream
+  // executing every enabled query in a rotated order.
+  uint32_t num_streams = 1;
+
+  // Do we compile per-pipeline cycle/row counters into the queries?
+  bool pipeline_metrics = false;
+
+  // File to write the per-query results to as JSON; empty disables it
+  std::string json_path;
+
   // The directory where all the data files are
   std::string data_dir;
 
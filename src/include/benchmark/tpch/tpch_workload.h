@@ -17,6 +17,7 @@
 
 #include "codegen/compilation_context.h"
 #include "codegen/query_result_consumer.h"
+#include "statistics/query_metric.h"
 
 namespace peloton {
 namespace benchmark {
@@ -47,8 +48,36 @@ class TPCHBenchmark {
     std::function<std::unique_ptr<planner::AbstractPlan>()> PlanConstructor;
   };
 
-  // Run the given query
-  void RunQuery(const QueryConfig &query_config);
+  // Everything measured for one query on one stream. Timings are summed
+  // over the configured number of runs; averages are computed at report
+  // time.
+  struct QueryMetrics {
+    std::string query_name;
+    uint32_t runs = 0;
+    uint64_t result_tuples = 0;
+    codegen::QueryCompiler::CompileStats compile_stats;
+    codegen::Query::RuntimeStats runtime_stats;
+    double wall_ms = 0.0;
+    double cpu_ms = 0.0;
+    // Per-pipeline cycle/row counters of the last run; populated only when
+    // pipeline metrics are enabled
+    std::vector<stats::QueryMetric::PipelineStat> pipelines;
+  };
+
+  // Compile and run the given query num_runs times, collecting metrics
+  QueryMetrics RunQuery(const QueryConfig &query_config);
+
+  // Run every enabled query once per stream on config_.num_streams
+  // concurrent threads (the TPC-H throughput test), each stream visiting
+  // the queries in a rotated order
+  std::vector<QueryMetrics> RunStreams(
+      const std::vector<const QueryConfig *> &queries);
+
+  // Print the per-query breakdown, and write it as JSON when requested
+  void ReportResults(const std::vector<QueryMetrics> &results,
+                     double elapsed_ms) const;
+  void WriteJSON(const std::vector<QueryMetrics> &results,
+                 double elapsed_ms) const;
 
   // Plan constructors
   std::unique_ptr<planner::AbstractPlan> ConstructQ1Plan() const;
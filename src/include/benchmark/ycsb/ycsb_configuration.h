@@ -94,6 +94,22 @@ class configuration {
 
   std::vector<int> profile_memory;
 
+  // latency percentiles (in ms) for one operation type
+  struct LatencyPercentiles {
+    double p50 = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double p999 = 0;
+  };
+
+  // per-operation-type latency percentiles, computed after the run
+  LatencyPercentiles read_latency;
+
+  LatencyPercentiles update_latency;
+
+  // when non-empty, write the per-round profile as CSV to this file
+  std::string csv_file_name = "";
+
 };
 
 extern configuration state;
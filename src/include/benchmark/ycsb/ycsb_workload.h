@@ -31,6 +31,13 @@ extern configuration state;
 
 extern storage::DataTable* user_table;
 
+// record the latency (in ms) of a single read / update operation executed
+// by the given backend thread. samples land in per-thread buffers and are
+// summarized into percentiles when the workload finishes.
+void RecordReadLatency(const size_t thread_id, double latency_ms);
+
+void RecordUpdateLatency(const size_t thread_id, double latency_ms);
+
 void RunWorkload();
 
 bool RunMixed(const size_t thread_id, ZipfDistribution &zipf, FastRandom &rng);
@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// aux_structure_tuner.h
+//
+// Identification: src/include/brain/aux_structure_tuner.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/synchronization/spin_latch.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+struct PredicateInfo;
+}  // namespace storage
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Auxiliary Structure Tuner
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Stats-driven per-column selection of scan-acceleration structures.
+ *
+ * Sequential scans report every zone-mappable predicate they apply, keyed
+ * by table and column and split into range and equality filters. A
+ * background thread periodically turns those observations into auxiliary
+ * structures on the immutable tile groups:
+ *
+ *  - columns filtered by range predicates get zone map entries, so the
+ *    scan's min/max check can skip whole tile groups;
+ *  - columns filtered by equality predicates that no index covers get a
+ *    small per-tile-group bloom filter over the column's values, so a
+ *    probe miss proves the tile group holds no matching tuple.
+ *
+ * Bloom filters are only built while their total size stays under a byte
+ * budget read from the settings manager; zone maps live in the catalog and
+ * are not counted against it. Filters are built only for immutable tile
+ * groups -- the flag is sticky and blocks inserts, so a filter can never
+ * go stale in the direction that would cause a wrong skip.
+ */
+class AuxStructureTuner {
+ public:
+  AuxStructureTuner(const AuxStructureTuner &) = delete;
+  AuxStructureTuner &operator=(const AuxStructureTuner &) = delete;
+  AuxStructureTuner(AuxStructureTuner &&) = delete;
+  AuxStructureTuner &operator=(AuxStructureTuner &&) = delete;
+
+  AuxStructureTuner();
+
+  ~AuxStructureTuner();
+
+  /**
+   * Singleton
+   *
+   * @return     The instance.
+   */
+  static AuxStructureTuner &GetInstance();
+
+  /**
+   * Start the background tuning thread
+   */
+  void Start();
+
+  /**
+   * Tuning loop
+   */
+  void Tune();
+
+  /**
+   * Stop the background tuning thread
+   */
+  void Stop();
+
+  /**
+   * Record the parsed predicates a sequential scan applied to a table.
+   * Called from the scan's initialization, so the counts reflect executed
+   * queries rather than planned ones.
+   */
+  void RecordFilters(storage::DataTable *table,
+                     const std::vector<storage::PredicateInfo> &predicates);
+
+  /**
+   * True when a bloom filter proves that no tuple in the tile group can
+   * match one of the equality predicates, so the scan may skip it. Tile
+   * groups without a filter, non-equality predicates and NULL literals
+   * never cause a skip.
+   */
+  bool ShouldSkipTileGroup(
+      storage::DataTable *table, oid_t tile_group_offset,
+      const std::vector<storage::PredicateInfo> &predicates);
+
+  /**
+   * Bytes currently held by tuner-built bloom filters
+   */
+  uint64_t GetBloomFilterBytes() const { return bloom_bytes_.load(); }
+
+  /**
+   * Number of tuning passes the tuner has completed
+   */
+  uint64_t GetPassCount() const { return pass_count_.load(); }
+
+  /**
+   * A column must be seen in this many filters before a structure is
+   * built for it
+   */
+  static const uint64_t kMinObservations = 8;
+
+  /**
+   * Bloom filter bits per tuple slot; two probes at this density give
+   * roughly a 5% false positive rate
+   */
+  static const uint64_t kBloomBitsPerTuple = 8;
+
+ private:
+  /**
+   * Observed filter counts for one column
+   */
+  struct FilterStats {
+    uint64_t range_count = 0;
+    uint64_t equality_count = 0;
+  };
+
+  /**
+   * Bloom filter over the values one column holds in one tile group. Two
+   * probes per value, both derived from the value's hash; the bit count
+   * is a power of two so probes reduce with a mask.
+   */
+  struct TileGroupBloomFilter {
+    std::vector<uint8_t> bits;
+    uint64_t bit_mask = 0;
+
+    void Insert(size_t hash);
+    bool MayContain(size_t hash) const;
+  };
+
+  // database oid, table oid, column id
+  using ColumnKey = std::tuple<oid_t, oid_t, oid_t>;
+
+  // database oid, table oid, tile group offset, column id
+  using StructureKey = std::tuple<oid_t, oid_t, oid_t, oid_t>;
+
+  /**
+   * One pass: turn the observation counts collected so far into zone maps
+   * and bloom filters on immutable tile groups, within the bloom budget.
+   */
+  void BuildStructures();
+
+  /**
+   * Build the bloom filter for one column of one tile group and charge it
+   * against the budget. Returns false when the budget is exhausted.
+   */
+  bool BuildBloomFilter(storage::DataTable *table, oid_t tile_group_offset,
+                        oid_t col_id, uint64_t budget_bytes);
+
+ private:
+  /**
+   * Observation counts, fed concurrently by scans
+   */
+  mutable common::synchronization::SpinLatch stats_latch_;
+  std::map<ColumnKey, FilterStats> filter_stats_;
+
+  /**
+   * Built bloom filters; entries are never removed, so probes can hold a
+   * pointer across the latch
+   */
+  mutable common::synchronization::SpinLatch bloom_latch_;
+  std::map<StructureKey, TileGroupBloomFilter> bloom_filters_;
+
+  /**
+   * Zone map entries this tuner already created; only the tuner thread
+   * touches it
+   */
+  std::set<StructureKey> built_zone_maps_;
+
+  /**
+   * Stop signal
+   */
+  std::atomic<bool> tuner_stop_;
+
+  /**
+   * Tuning thread
+   */
+  std::thread tuner_thread_;
+
+  /**
+   * Tuning statistics
+   */
+  std::atomic<uint64_t> bloom_bytes_;
+  std::atomic<uint64_t> pass_count_;
+};
+
+}  // namespace brain
+}  // namespace peloton
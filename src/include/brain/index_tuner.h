@@ -143,6 +143,16 @@ class IndexTuner {
     index_utility_threshold = index_utility_threshold_;
   }
 
+  /**
+   * @brief      Sets the index build utility threshold.
+   *
+   * @param[in]  index_build_utility_threshold_  The index build utility threshold
+   */
+  void SetIndexBuildUtilityThreshold(
+      const double &index_build_utility_threshold_) {
+    index_build_utility_threshold = index_build_utility_threshold_;
+  }
+
   /**
    * @brief      Sets the index count threshold.
    *
@@ -187,11 +197,16 @@ class IndexTuner {
   /**
    * Add indexes to table
    *
-   * @param      table              The table
-   * @param[in]  suggested_indices  The suggested indices
+   * At most one index is added per call, and only when its workload share
+   * clears the utility threshold indexes are dropped at.
+   *
+   * @param      table                 The table
+   * @param[in]  suggested_indices     The suggested indices
+   * @param[in]  suggested_utilities   The workload share of each suggestion
    */
   void AddIndexes(storage::DataTable *table,
-                  const std::vector<std::vector<double>> &suggested_indices);
+                  const std::vector<std::vector<double>> &suggested_indices,
+                  const std::vector<double> &suggested_utilities);
 
   // Index tuning helper
   //
@@ -281,6 +296,14 @@ class IndexTuner {
   /** index utility threshold below which it will be dropped */
   double index_utility_threshold = 0.25;
 
+  //===--------------------------------------------------------------------===//
+  // BUILD Thresholds
+  //===--------------------------------------------------------------------===//
+
+  /** workload share a suggested index must have before its build expense
+   * is considered worthwhile; filters the long tail of suggestions */
+  double index_build_utility_threshold = 0.01;
+
   /** maximum # of indexes per table */
   oid_t index_count_threshold = 10;
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -90,13 +91,48 @@ class LayoutTuner {
    */
   std::string GetColumnMapInfo(const column_map_type &column_map);
 
+  /** Progress counter: tile groups actually rewritten to the default layout */
+  uint64_t GetTileGroupsTransformed() const {
+    return tile_groups_transformed_.load();
+  }
+
+  /** Impact counter: default-layout changes that survived hysteresis */
+  uint64_t GetLayoutUpdateCount() const { return layout_update_count_.load(); }
+
  protected:
   /**
-   * Update layout of table
+   * Per-table tuning state, touched only by the tuner thread
+   */
+  struct TableTunerState {
+    /** clock cursor for incremental tile group transformation */
+    oid_t next_tile_group_offset = 0;
+
+    /** layout proposal awaiting confirmation, empty if none */
+    column_map_type pending_layout;
+
+    /** consecutive rounds the pending proposal has been re-derived */
+    oid_t rounds_pending = 0;
+  };
+
+  /**
+   * Update layout of table from its recorded access samples, with
+   * hysteresis: a new layout is adopted only after it has been proposed
+   * for hysteresis_rounds consecutive rounds and differs from the current
+   * layout by more than layout_change_threshold
    *
    * @param      table  The table
+   * @param      state  The table's tuning state
+   */
+  void UpdateDefaultPartition(storage::DataTable *table,
+                              TableTunerState &state);
+
+  /**
+   * Normalized distance between two layouts: the fraction of column pairs
+   * co-located in one layout but split in the other. Insensitive to tile id
+   * permutation, 0 for equivalent layouts, 1 for maximally different ones.
    */
-  void UpdateDefaultPartition(storage::DataTable *table);
+  double GetLayoutDifference(const column_map_type &layout,
+                             const column_map_type &other) const;
 
  private:
   /**
@@ -104,8 +140,19 @@ class LayoutTuner {
    */
   std::vector<storage::DataTable *> tables;
 
+  /**
+   * Per-table tuning state, keyed by table
+   */
+  std::map<storage::DataTable *, TableTunerState> table_states_;
+
   std::mutex layout_tuner_mutex;
 
+  /** Tile groups actually rewritten */
+  std::atomic<uint64_t> tile_groups_transformed_{0};
+
+  /** Default-layout changes applied */
+  std::atomic<uint64_t> layout_update_count_{0};
+
   /**
    * Stop signal
    */
@@ -142,6 +189,21 @@ class LayoutTuner {
   /** Desired layout tile count */
   oid_t tile_count = 2;
 
+  /** Tile groups transformed per table per tuning epoch */
+  oid_t transform_batch_size = 8;
+
+  /** Minimum recorded samples before a layout update is considered */
+  size_t min_sample_count = 16;
+
+  /**
+   * Hysteresis: proposals closer than this to the current layout are
+   * ignored, and a proposal must re-appear for hysteresis_rounds
+   * consecutive rounds before it is adopted
+   */
+  double layout_change_threshold = 0.1;
+
+  /** Consecutive confirmations required before adopting a new layout */
+  oid_t hysteresis_rounds = 3;
 };
 
 }  // namespace brain
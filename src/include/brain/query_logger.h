@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <string>
 
+#include "common/container/lock_free_queue.h"
 #include "parser/pg_query.h"
 
 namespace peloton {
@@ -48,12 +49,31 @@ class QueryLogger {
   };
 
   /**
-   * @brief This function logs the query into query_history_catalog
+   * @brief This function records the query for logging
+   *
+   * The query is only appended to a lock-free queue here; the fingerprint
+   * computation and the catalog insert happen in Flush() on a background
+   * pool thread, so callers never pay for a transaction per query.
    *
    * @param the sql string corresponding to the query
    * @param timestamp of the transaction that executed the query
    */
   static void LogQuery(std::string query_string, uint64_t timestamp);
+
+  /**
+   * @brief This function drains the queued queries into
+   * query_history_catalog as one batch under a single transaction
+   */
+  static void Flush();
+
+ private:
+  struct QueryLogEntry {
+    std::string query_string;
+    uint64_t timestamp;
+  };
+
+  // queries recorded by LogQuery but not yet written to the catalog
+  static LockFreeQueue<QueryLogEntry> query_queue_;
 };
 
 }  // namespace brain
@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tiering_service.h
+//
+// Identification: src/include/brain/tiering_service.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Tiering Service
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Background hot/cold tile group tiering.
+ *
+ * Every tile group header records the epoch of its last read on the scan
+ * path. This service periodically walks all tile groups in the system and
+ * freezes the ones that are full and have not been read for a configurable
+ * number of epochs: the tile group is marked immutable and its VARCHAR tile
+ * columns are dictionary encoded, giving cold data a compact, read-optimized
+ * representation. Frozen tile groups stay transparently readable through
+ * LogicalTile; reads decode through the dictionary only when a consumer
+ * materializes a value.
+ *
+ * The pass interval and the cold threshold are read from the settings
+ * manager on every pass, so both can be tuned at runtime.
+ */
+class TieringService {
+ public:
+  TieringService(const TieringService &) = delete;
+  TieringService &operator=(const TieringService &) = delete;
+  TieringService(TieringService &&) = delete;
+  TieringService &operator=(TieringService &&) = delete;
+
+  TieringService();
+
+  ~TieringService();
+
+  /**
+   * Singleton
+   *
+   * @return     The instance.
+   */
+  static TieringService &GetInstance();
+
+  /**
+   * Start the background tiering thread
+   */
+  void Start();
+
+  /**
+   * Tiering loop
+   */
+  void Tier();
+
+  /**
+   * Stop the background tiering thread
+   */
+  void Stop();
+
+  /**
+   * Total number of tile groups frozen by this service
+   */
+  uint64_t GetTotalFrozenCount() const { return total_frozen_count_.load(); }
+
+  /**
+   * Number of tiering passes the service has completed
+   */
+  uint64_t GetPassCount() const { return pass_count_.load(); }
+
+ private:
+  /**
+   * Walk every tile group in the system and freeze the full, cold ones.
+   * Tile groups read within the last cold_epoch_count epochs are left alone.
+   */
+  void FreezeColdTileGroups(int cold_epoch_count);
+
+  /**
+   * Freeze a single tile group: mark it immutable and dictionary-encode its
+   * VARCHAR tile columns. Returns false if another thread froze it first.
+   */
+  bool FreezeTileGroup(const std::shared_ptr<storage::TileGroup> &tile_group);
+
+ private:
+  /**
+   * Stop signal
+   */
+  std::atomic<bool> tiering_stop_;
+
+  /**
+   * Tiering thread
+   */
+  std::thread tiering_thread_;
+
+  /**
+   * Tiering statistics
+   */
+  std::atomic<uint64_t> total_frozen_count_;
+  std::atomic<uint64_t> pass_count_;
+};
+
+}  // namespace brain
+}  // namespace peloton
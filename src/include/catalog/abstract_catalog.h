@@ -67,6 +67,16 @@ class AbstractCatalog {
                          std::vector<type::Value> values,
                          concurrency::TransactionContext *txn) const;
 
+  /* Hand-written point lookup for hot catalog reads: probes the index with
+   * ScanKey and materializes the requested columns straight from the tile
+   * group, skipping plan and executor construction entirely. Only full-key
+   * equality lookups are supported; each returned row holds the requested
+   * column values of one visible tuple. */
+  std::vector<std::vector<type::Value>> GetRowsWithIndexLookup(
+      const std::vector<oid_t> &column_offsets, oid_t index_offset,
+      const std::vector<type::Value> &values,
+      concurrency::TransactionContext *txn) const;
+
   std::unique_ptr<std::vector<std::unique_ptr<executor::LogicalTile>>>
   GetResultWithSeqScan(std::vector<oid_t> column_offsets,
                        expression::AbstractExpression *predicate,
@@ -20,6 +20,7 @@
 namespace peloton {
 
 namespace catalog {
+class Column;
 class Schema;
 class DatabaseCatalogObject;
 class TableCatalogObject;
@@ -114,6 +115,18 @@ class Catalog {
                          concurrency::TransactionContext *txn,
                          bool is_catalog = false);
 
+  //===--------------------------------------------------------------------===//
+  // ALTER FUNCTIONS
+  //===--------------------------------------------------------------------===//
+  // Metadata-only ALTER TABLE ADD COLUMN fast path for a nullable,
+  // unconstrained column: the table schema is widened and pg_attribute
+  // updated, but no existing tile group is rewritten -- old rows read the
+  // column back as NULL and materialize it lazily when next written
+  ResultType AddDefaultNullColumn(const std::string &database_name,
+                                  const std::string &table_name,
+                                  const catalog::Column &column,
+                                  concurrency::TransactionContext *txn);
+
   //===--------------------------------------------------------------------===//
   // DROP FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -38,6 +38,13 @@ class CatalogCache {
   CatalogCache(CatalogCache const &) = delete;
   CatalogCache &operator=(CatalogCache const &) = delete;
 
+  // Drop all cached catalog objects. Called when the owning transaction
+  // context is recycled so a later transaction never sees stale entries.
+  void Clear() {
+    database_objects_cache.clear();
+    database_name_cache.clear();
+  }
+
  private:
   std::shared_ptr<DatabaseCatalogObject> GetDatabaseObject(oid_t database_oid);
   std::shared_ptr<DatabaseCatalogObject> GetDatabaseObject(
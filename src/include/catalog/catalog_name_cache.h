@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// catalog_name_cache.h
+//
+// Identification: src/include/catalog/catalog_name_cache.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "common/container/cuckoo_map.h"
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace catalog {
+
+/**
+ * @brief A resolved qualified name, stamped with the catalog epoch it was
+ * observed under. table_oid is INVALID_OID for a database-level entry.
+ */
+struct NameCacheEntry {
+  uint64_t epoch;
+  oid_t database_oid;
+  oid_t table_oid;
+};
+
+/**
+ * @brief Process-wide versioned cache of name -> oid catalog resolutions.
+ *
+ * The per-transaction CatalogCache starts empty on every statement, so hot
+ * name lookups (Catalog::GetTableWithName and friends) re-scan the catalog
+ * tables at every statement. This cache remembers resolutions across
+ * transactions: reads are lock-free CuckooMap lookups, and every entry
+ * carries the catalog epoch it was filled under. Any DDL that creates or
+ * drops a database, table or index bumps the epoch, which invalidates every
+ * entry at once without touching the map - a stale-epoch hit is treated as
+ * a miss and refilled from the slow path. Because every schema-changing DDL
+ * goes through the bump, the epoch doubles as a process-wide schema
+ * fingerprint: the traffic cop stamps prepared statements with the epoch
+ * they were bound under and revalidates them with a single compare.
+ *
+ * Fill() takes the epoch its caller read *before* running the catalog scan;
+ * if a DDL slipped in between, the epochs differ and the entry is dropped
+ * rather than cached, so a resolution can never outlive the schema it was
+ * read from. The cached payload is oids only - catalog objects stay
+ * transaction-bound - so a hit still goes through the storage manager,
+ * which rechecks that the oids exist.
+ *
+ * Caveat: a transaction that creates a table and then resolves it by name
+ * publishes the mapping before it commits. A concurrent reader hitting that
+ * entry sees the storage handle a statement earlier than the catalog scan
+ * would have shown it; its column lookups still go through the catalog
+ * under its own snapshot. DDL this cache can mislead about is already
+ * serialized through catalog_mutex elsewhere, so we accept the window
+ * instead of threading commit hooks through the transaction manager.
+ */
+class CatalogNameCache {
+ public:
+  static CatalogNameCache &GetInstance() {
+    static CatalogNameCache name_cache;
+    return name_cache;
+  }
+
+  CatalogNameCache(CatalogNameCache const &) = delete;
+  CatalogNameCache &operator=(CatalogNameCache const &) = delete;
+
+  inline uint64_t GetEpoch() const { return epoch_.load(); }
+
+  // Called by schema-changing DDL; atomically invalidates all entries
+  inline void BumpEpoch() { epoch_.fetch_add(1); }
+
+  // Look up a database name; false on miss or stale entry
+  bool ResolveDatabase(const std::string &database_name, oid_t &database_oid);
+
+  // Look up a qualified table name; false on miss or stale entry
+  bool ResolveTable(const std::string &database_name,
+                    const std::string &table_name, oid_t &database_oid,
+                    oid_t &table_oid);
+
+  // Remember a resolution observed under the given epoch; dropped if a DDL
+  // has bumped the epoch since the caller read it
+  void FillDatabase(uint64_t epoch, const std::string &database_name,
+                    oid_t database_oid);
+  void FillTable(uint64_t epoch, const std::string &database_name,
+                 const std::string &table_name, oid_t database_oid,
+                 oid_t table_oid);
+
+ private:
+  CatalogNameCache() {}
+
+  bool Resolve(const std::string &key, NameCacheEntry &entry);
+  void Fill(const std::string &key, const NameCacheEntry &entry);
+
+  static std::string TableKey(const std::string &database_name,
+                              const std::string &table_name) {
+    return database_name + "." + table_name;
+  }
+
+  // catalog epoch; incremented by DDL, stamped into every entry
+  std::atomic<uint64_t> epoch_{0};
+
+  CuckooMap<std::string, std::shared_ptr<NameCacheEntry>> entries_;
+};
+
+}  // namespace catalog
+}  // namespace peloton
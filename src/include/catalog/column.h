@@ -41,7 +41,7 @@ class Column : public Printable {
         fixed_length(INVALID_OID),
         is_inlined(is_inlined),
         column_offset(column_offset) {
-    SetInlined();
+    SetInlined(column_length);
 
     // We should not have an inline value of length 0
     if (is_inlined && column_length == 0) {
@@ -55,8 +55,13 @@ class Column : public Printable {
   // ACCESSORS
   //===--------------------------------------------------------------------===//
 
+  // Varchar/varbinary columns declared at most this many bytes long are
+  // stored inline in the tuple behind a length prefix instead of behind a
+  // varlen pool pointer, saving the pointer chase on every access
+  static const size_t kMaxInlinedVarlenLength = 64;
+
   // Set inlined
-  void SetInlined();
+  void SetInlined(size_t column_length);
 
   // Set the appropriate column length
   void SetLength(size_t column_length);
@@ -44,6 +44,10 @@ class DatabaseCatalogObject {
  public:
   DatabaseCatalogObject(executor::LogicalTile *tile,
                         concurrency::TransactionContext *txn);
+  // Construct from a value row produced by GetRowsWithIndexLookup, with one
+  // value per pg_database column
+  DatabaseCatalogObject(const std::vector<type::Value> &row,
+                        concurrency::TransactionContext *txn);
 
   void EvictAllTableObjects();
   std::shared_ptr<TableCatalogObject> GetTableObject(oid_t table_oid,
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_metrics_catalog.h
+//
+// Identification: src/include/catalog/latency_metrics_catalog.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+//
+//
+// Schema: (column offset: column_name)
+// 0: query_type
+// 1: count
+// 2: p50_ms
+// 3: p95_ms
+// 4: p99_ms
+// 5: p999_ms
+// 6: max_ms
+// 7: time_stamp
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/abstract_catalog.h"
+
+#define LATENCY_METRICS_CATALOG_NAME "pg_latency_metrics"
+
+namespace peloton {
+namespace catalog {
+
+/**
+ * Per-query-type latency percentiles harvested from the backend latency
+ * histograms on each stats aggregation interval, so tail latency can be
+ * monitored (and alerted on) with a plain SQL query.
+ */
+class LatencyMetricsCatalog : public AbstractCatalog {
+ public:
+  ~LatencyMetricsCatalog();
+
+  // Global Singleton
+  static LatencyMetricsCatalog *GetInstance(
+      concurrency::TransactionContext *txn = nullptr);
+
+  //===--------------------------------------------------------------------===//
+  // write Related API
+  //===--------------------------------------------------------------------===//
+  bool InsertLatencyMetrics(const std::string &query_type, int64_t count,
+                            double p50_ms, double p95_ms, double p99_ms,
+                            double p999_ms, double max_ms, int64_t time_stamp,
+                            type::AbstractPool *pool,
+                            concurrency::TransactionContext *txn);
+
+  enum ColumnId {
+    QUERY_TYPE = 0,
+    COUNT = 1,
+    P50_MS = 2,
+    P95_MS = 3,
+    P99_MS = 4,
+    P999_MS = 5,
+    MAX_MS = 6,
+    TIME_STAMP = 7,
+    // Add new columns here in creation order
+  };
+
+ private:
+  LatencyMetricsCatalog(concurrency::TransactionContext *txn);
+};
+
+}  // namespace catalog
+}  // namespace peloton
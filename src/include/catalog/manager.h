@@ -22,6 +22,7 @@
 #include "common/macros.h"
 #include "common/internal_types.h"
 #include "common/container/lock_free_array.h"
+#include "common/synchronization/epoch_retire_list.h"
 
 namespace peloton {
 
@@ -60,8 +61,25 @@ class Manager {
 
   void DropTileGroup(const oid_t oid);
 
+  // Swap in a replacement tile group under the same oid and epoch-retire
+  // the displaced one; used by compaction to retire an emptied tile group
+  // without disturbing the offsets concurrent scans iterate over
+  void ReplaceTileGroup(const oid_t oid,
+                        std::shared_ptr<storage::TileGroup> location);
+
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Epoch-protected raw access: no refcount traffic, so this is the variant
+  // for per-tuple lookups on scan and visibility-check paths. The caller
+  // must be inside an epoch (i.e. executing on behalf of an active
+  // transaction); a dropped tile group is retired rather than freed and is
+  // only deleted once every epoch active at drop time has expired.
+  storage::TileGroup *GetTileGroupRaw(const oid_t oid);
+
+  // Free retired tile groups whose retire epoch has expired; called from
+  // the GC reclaim pass
+  void ReclaimRetiredTileGroups(const eid_t &expired_eid);
+
   void ClearTileGroup(void);
 
 
@@ -96,6 +114,15 @@ class Manager {
 
   LockFreeArray<std::shared_ptr<storage::TileGroup>> tile_group_locator_;
 
+  // raw mirror of tile_group_locator_, read by GetTileGroupRaw without
+  // touching the shared_ptr control block
+  LockFreeArray<storage::TileGroup *> tile_group_raw_locator_;
+
+  // dropped tile groups parked until their retire epoch expires; the
+  // shared_ptr here is what keeps a group alive for raw-pointer readers
+  common::synchronization::EpochRetireList<std::shared_ptr<storage::TileGroup>>
+      retired_tile_groups_;
+
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
 
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_progress_catalog.h
+//
+// Identification: src/include/catalog/query_progress_catalog.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+// pg_query_progress
+//
+// Schema: (column offset: column_name)
+// 0: query_id (pkey)
+// 1: query_text
+// 2: start_time_us
+// 3: elapsed_us
+// 4: rows_produced
+// 5: phase
+// 6: memory_bytes
+// 7: cancel_requested
+//
+// Indexes: (index offset: indexed columns)
+// 0: query_id (unique & primary key)
+//
+// The stats aggregator replaces the table's contents with a snapshot of
+// the live query registry every aggregation interval, so the table always
+// shows the queries that were running as of the last interval.
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/abstract_catalog.h"
+
+#define QUERY_PROGRESS_CATALOG_NAME "pg_query_progress"
+
+namespace peloton {
+namespace catalog {
+
+class QueryProgressCatalog : public AbstractCatalog {
+ public:
+  ~QueryProgressCatalog();
+
+  // Global Singleton
+  static QueryProgressCatalog *GetInstance(
+      concurrency::TransactionContext *txn = nullptr);
+
+  //===--------------------------------------------------------------------===//
+  // write Related API
+  //===--------------------------------------------------------------------===//
+  bool InsertQueryProgress(uint64_t query_id, const std::string &query_text,
+                           int64_t start_time_us, int64_t elapsed_us,
+                           int64_t rows_produced, const std::string &phase,
+                           int64_t memory_bytes, bool cancel_requested,
+                           type::AbstractPool *pool,
+                           concurrency::TransactionContext *txn);
+  bool DeleteQueryProgress(uint64_t query_id,
+                           concurrency::TransactionContext *txn);
+
+  enum ColumnId {
+    QUERY_ID = 0,
+    QUERY_TEXT = 1,
+    START_TIME_US = 2,
+    ELAPSED_US = 3,
+    ROWS_PRODUCED = 4,
+    PHASE = 5,
+    MEMORY_BYTES = 6,
+    CANCEL_REQUESTED = 7,
+    // Add new columns here in creation order
+  };
+
+ private:
+  QueryProgressCatalog(concurrency::TransactionContext *txn);
+
+  enum IndexId {
+    SECONDARY_KEY_0 = 0,
+    // Add new indexes here in creation order
+  };
+};
+
+}  // namespace catalog
+}  // namespace peloton
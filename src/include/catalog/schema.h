@@ -22,6 +22,8 @@
 namespace peloton {
 namespace catalog {
 
+class TupleAccessor;
+
 //===--------------------------------------------------------------------===//
 // Schema
 //===--------------------------------------------------------------------===//
@@ -225,6 +227,12 @@ class Schema : public Printable {
     return multi_constraints;
   }
 
+  // Typed column accessor table built when the tuple schema was created;
+  // never null for schemas that went through CreateTupleSchema
+  inline const TupleAccessor *GetTupleAccessor() const {
+    return tuple_accessor_.get();
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -251,6 +259,10 @@ class Schema : public Printable {
 
   // keeps track of indexed columns in original table
   std::vector<oid_t> indexed_columns_;
+
+  // direct typed load/store functions with precomputed offsets, shared by
+  // schema copies since they describe the same physical layout
+  std::shared_ptr<const TupleAccessor> tuple_accessor_;
 };
 
 }  // namespace catalog
@@ -47,6 +47,10 @@ class TableCatalogObject {
  public:
   TableCatalogObject(executor::LogicalTile *tile, concurrency::TransactionContext *txn,
                      int tupleId = 0);
+  // Construct from a value row produced by GetRowsWithIndexLookup, with one
+  // value per pg_table column
+  TableCatalogObject(const std::vector<type::Value> &row,
+                     concurrency::TransactionContext *txn);
 
  public:
   // Get indexes
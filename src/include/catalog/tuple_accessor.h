@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tuple_accessor.h
+//
+// Identification: src/include/catalog/tuple_accessor.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/internal_types.h"
+#include "type/value.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace catalog {
+
+class Schema;
+
+//===--------------------------------------------------------------------===//
+// Tuple Accessor
+//===--------------------------------------------------------------------===//
+
+// Direct typed load/store bundle for one inlined fixed-width column type.
+// Each specialization reads or writes the raw field bytes the same way the
+// corresponding Type singleton's DeserializeFrom/SerializeTo does, but as a
+// non-virtual call resolved at compile time. Null sentinels pass through
+// unchanged because the Value constructors recognize them from the raw bits.
+template <type::TypeId ColumnTypeId>
+struct InlinedColumnOps;
+
+template <>
+struct InlinedColumnOps<type::TypeId::BOOLEAN> {
+  typedef int8_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetBooleanValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::TINYINT> {
+  typedef int8_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetTinyIntValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::SMALLINT> {
+  typedef int16_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetSmallIntValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::INTEGER> {
+  typedef int32_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetIntegerValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::BIGINT> {
+  typedef int64_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetBigIntValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::DECIMAL> {
+  typedef double cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetDecimalValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::TIMESTAMP> {
+  typedef uint64_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetTimestampValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+template <>
+struct InlinedColumnOps<type::TypeId::DATE> {
+  typedef uint32_t cpp_type;
+  static type::Value Load(const char *field) {
+    return type::ValueFactory::GetDateValue(
+        *reinterpret_cast<const cpp_type *>(field));
+  }
+  static void Store(const type::Value &value, char *field) {
+    *reinterpret_cast<cpp_type *>(field) = value.GetAs<cpp_type>();
+  }
+};
+
+// Per-schema table of typed column accessors with precomputed offsets,
+// built once when the schema is created. Columns whose type has an
+// InlinedColumnOps bundle get direct load/store function pointers; varlen
+// and uninlined columns are left without one and keep going through the
+// Type singleton dispatch.
+class TupleAccessor {
+ public:
+  typedef type::Value (*ColumnLoadFunction)(const char *field);
+  typedef void (*ColumnStoreFunction)(const type::Value &value, char *field);
+
+  explicit TupleAccessor(const Schema &schema);
+
+  // Does this column have a direct typed accessor?
+  inline bool HasDirectAccess(const oid_t column_id) const {
+    return columns_[column_id].load_function != nullptr;
+  }
+
+  // Load the column straight from the tuple bytes. The caller must have
+  // checked HasDirectAccess.
+  inline type::Value LoadValue(const char *tuple_data,
+                               const oid_t column_id) const {
+    const auto &column = columns_[column_id];
+    return column.load_function(tuple_data + column.offset);
+  }
+
+  // Store the value straight into the tuple bytes. Returns false when the
+  // column has no direct accessor or the value's runtime type does not
+  // match the column type; the caller then falls back to the casting path.
+  inline bool StoreValue(char *tuple_data, const oid_t column_id,
+                         const type::Value &value) const {
+    const auto &column = columns_[column_id];
+    if (column.store_function == nullptr || value.GetTypeId() != column.type) {
+      return false;
+    }
+    column.store_function(value, tuple_data + column.offset);
+    return true;
+  }
+
+ private:
+  struct ColumnAccessor {
+    ColumnLoadFunction load_function = nullptr;
+    ColumnStoreFunction store_function = nullptr;
+    uint32_t offset = 0;
+    type::TypeId type = type::TypeId::INVALID;
+  };
+
+  // One entry per schema column, indexed by column id
+  std::vector<ColumnAccessor> columns_;
+};
+
+}  // namespace catalog
+}  // namespace peloton
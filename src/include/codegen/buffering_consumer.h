@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
 #include "codegen/compilation_context.h"
@@ -46,18 +47,36 @@ class WrappedTuple : public ContainerTuple<std::vector<peloton::type::Value>> {
 };
 
 //===----------------------------------------------------------------------===//
-// A query consumer that buffers tuples into a local memory location
+// A query consumer that buffers tuples into a local memory location. In
+// streaming mode, the buffer is drained through a callback every time it
+// reaches the configured batch size, so result-set memory stays bounded by
+// one batch. The callback runs synchronously on the producing thread, so a
+// slow consumer naturally applies backpressure to execution.
 //===----------------------------------------------------------------------===//
 class BufferingConsumer : public QueryResultConsumer {
  public:
+  // Invoked with each full batch of output tuples; the batch is cleared
+  // after the callback returns
+  using BatchCallback = std::function<void(std::vector<WrappedTuple> &batch)>;
+
   struct BufferingState {
     std::vector<WrappedTuple> *output;
+    // tuples buffered before the batch callback fires; 0 disables streaming
+    size_t batch_size;
+    const BatchCallback *batch_callback;
   };
 
-  // Constructor
+  // Constructor. Buffers the entire result set.
   BufferingConsumer(const std::vector<oid_t> &cols,
                     const planner::BindingContext &context);
 
+  // Streaming constructor. Output is delivered to the callback in batches
+  // of batch_size tuples; only the final partial batch remains in
+  // GetOutputTuples(). A batch_size of 0 buffers the whole result.
+  BufferingConsumer(const std::vector<oid_t> &cols,
+                    const planner::BindingContext &context, size_t batch_size,
+                    BatchCallback batch_callback);
+
   void Prepare(CompilationContext &compilation_context) override;
   void InitializeState(CompilationContext &) override {}
   void TearDownState(CompilationContext &) override {}
@@ -87,6 +106,9 @@ class BufferingConsumer : public QueryResultConsumer {
   // Buffered output tuples
   std::vector<WrappedTuple> tuples_;
 
+  // Streaming-mode batch callback, or an empty function when buffering
+  BatchCallback batch_callback_;
+
   // Running buffering state
   BufferingState state;
 
@@ -34,6 +34,12 @@ namespace codegen {
 
 class FunctionBuilder;
 
+// How aggressively the functions in a context are optimized before they are
+// JIT compiled. The fast tier skips IR optimization and instruction-selection
+// optimization to minimize time-to-first-execution; hot queries are later
+// recompiled at the full tier.
+enum class OptimizationLevel { kFast, kFull };
+
 //===----------------------------------------------------------------------===//
 // The context where all generated LLVM query code resides. We create a context
 // instance for every query we see.  We keep instances of these around in the
@@ -48,9 +54,13 @@ class CodeContext {
  public:
   using FuncPtr = void *;
 
-  CodeContext();
+  explicit CodeContext(
+      OptimizationLevel opt_level = OptimizationLevel::kFull);
   ~CodeContext();
 
+  /// The optimization tier this context compiles at
+  OptimizationLevel GetOptimizationLevel() const { return opt_level_; }
+
   /// Register a function that will be defined in this context
   void RegisterFunction(llvm::Function *func);
 
@@ -102,6 +112,15 @@ class CodeContext {
   // Get the module
   llvm::Module &GetModule() const { return *module_; }
 
+  // Number of bytes of machine code and data the JIT allocated for this
+  // context. Only meaningful after Compile().
+  uint64_t GetMemoryFootprint() const { return memory_footprint_; }
+
+  // Dump this context's IR with the context-unique id scrubbed from the
+  // generated symbol names, so two contexts that generated structurally
+  // identical code produce byte-identical text
+  std::string GetCanonicalIR() const;
+
  private:
   // Get the raw IR in text form
   std::string GetIR() const;
@@ -122,6 +141,9 @@ class CodeContext {
   // The ID/version of code
   uint64_t id_;
 
+  // The optimization tier this context compiles at
+  const OptimizationLevel opt_level_;
+
   // The main context
   std::unique_ptr<llvm::LLVMContext> context_;
 
@@ -144,6 +166,9 @@ class CodeContext {
   std::string err_str_;
   std::unique_ptr<llvm::ExecutionEngine> engine_;
 
+  // Bytes of code and data sections allocated by the JIT engine
+  uint64_t memory_footprint_ = 0;
+
   // Handy types we reuse often enough to cache here
   llvm::Type *bool_type_;
   llvm::Type *int8_type_;
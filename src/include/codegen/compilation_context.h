@@ -51,8 +51,10 @@ class CompilationContext {
 
  public:
   // Constructor
-  CompilationContext(Query &query, const QueryParametersMap &parameters_map,
-                     QueryResultConsumer &result_consumer);
+  CompilationContext(
+      Query &query, const QueryParametersMap &parameters_map,
+      QueryResultConsumer &result_consumer,
+      const ParameterCache::PinnedValues *pinned_parameters = nullptr);
 
   // Prepare a translator in this context
   void Prepare(const planner::AbstractPlan &op, Pipeline &pipeline);
@@ -94,13 +96,29 @@ class CompilationContext {
   // Get a pointer to the query parameter instance
   llvm::Value *GetQueryParametersPtr();
 
+  // Emit a load of the given host pointer through the query's relocatable
+  // pointer table rather than baking the raw address into the code, so that
+  // structurally identical queries generate byte-identical IR and can share
+  // compiled code. The loaded value is cast to the given pointer type.
+  llvm::Value *LoadRelocatablePointer(const void *pointer,
+                                      llvm::Type *pointer_type);
+
   // Get the parameter index to be used to get value for the given expression
   size_t GetParameterIdx(
       const expression::AbstractExpression *expression) const {
     return parameters_map_.GetIndex(expression);
   }
 
+  // Are we emitting per-pipeline cycle/row counters into the generated code?
+  bool InstrumentingPipelines() const { return instrument_pipelines_; }
+
  private:
+  // Emit the instrumentation calls delimiting one pipeline function, if
+  // instrumentation is enabled. Begin must be called inside the function
+  // being generated, before the pipeline's logic; End after it.
+  uint32_t EmitPipelineBegin(const std::string &pipeline_info);
+  void EmitPipelineEnd(uint32_t pipeline_id);
+
   // Generate any auxiliary helper functions that the query needs
   void GenerateHelperFunctions();
 
@@ -144,6 +162,12 @@ class CompilationContext {
   RuntimeState::StateID storage_manager_state_id_;
   RuntimeState::StateID executor_context_state_id_;
   RuntimeState::StateID query_parameters_state_id_;
+  RuntimeState::StateID host_pointers_state_id_;
+
+  // The host pointers the generated code references through the relocatable
+  // pointer table, in slot order. Handed over to the query after IR
+  // generation, which passes the table in at execution time.
+  std::vector<const void *> host_pointers_;
 
   // The mapping of an operator in the tree to its translator
   std::unordered_map<const planner::AbstractPlan *,
@@ -158,6 +182,11 @@ class CompilationContext {
   // Pre-declared producer functions and their root plan nodes
   std::unordered_map<const planner::AbstractPlan *, FunctionDeclaration>
       auxiliary_producers_;
+
+  // Whether per-pipeline counters are compiled into the query, and the id
+  // handed to the next instrumented pipeline function
+  bool instrument_pipelines_;
+  uint32_t next_pipeline_id_ = 0;
 };
 
 }  // namespace codegen
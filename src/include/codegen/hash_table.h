@@ -167,8 +167,11 @@ class HashTable {
                                  Vector &selection_vector,
                                  VectorizedIterateCallback &callback) const = 0;
 
-  // Generate code that iterates all the matches
+  // Generate code that iterates all the matches. If the caller has already
+  // computed the key's hash (e.g. in a group-prefetch pass), it is passed
+  // through hash; otherwise hash is null and the key is hashed here.
   virtual void FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+                       llvm::Value *hash,
                        const std::vector<codegen::Value> &key,
                        IterateCallback &callback) const = 0;
 
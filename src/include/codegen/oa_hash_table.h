@@ -94,13 +94,14 @@ class OAHashTable : public HashTable {
       CodeGen &codegen, llvm::Value *ht_ptr, Vector &selection_vector,
       HashTable::VectorizedIterateCallback &callback) const override;
 
-  // Generate code that iterates all the matches
-  void FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
+  // Generate code that iterates all the matches, reusing the caller's hash
+  // value if one is provided
+  void FindAll(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
                const std::vector<codegen::Value> &key,
                HashTable::IterateCallback &callback) const override;
 
   // An enum class indicating the type of prefetch (i.e., read or write)
-  enum class PrefetchType : uint32_t { Read = 0, Write = 0 };
+  enum class PrefetchType : uint32_t { Read = 0, Write = 1 };
 
   // An enum class indicating the temporal locality of the prefetched address
   enum class Locality : uint32_t { None = 0, High = 1, Medium = 2, Low = 3 };
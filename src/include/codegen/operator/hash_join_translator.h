@@ -75,6 +75,7 @@ class HashJoinTranslator : public OperatorTranslator {
                      std::vector<codegen::Value> &values) const;
 
   void CodegenHashProbe(ConsumerContext &context, RowBatch::Row &row,
+                        llvm::Value *hash,
                         std::vector<codegen::Value> &key) const;
 
   // Estimate the size of the constructed hash table
@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "codegen/codegen.h"
 #include "codegen/query_parameters_map.h"
 #include "codegen/value.h"
 #include "expression/parameter.h"
 #include "type/type.h"
+#include "type/value.h"
 
 namespace peloton {
 namespace codegen {
@@ -26,9 +29,21 @@ namespace codegen {
 //===----------------------------------------------------------------------===//
 class ParameterCache {
  public:
+  // Parameter indices pinned to a literal value for a specialized
+  // compilation. Pinned parameters are emitted as compile-time constants
+  // instead of runtime loads, so LLVM can fold and eliminate around them;
+  // the resulting code is only valid when the runtime parameters match
+  // the pinned values, which Query::Execute guards
+  using PinnedValues = std::unordered_map<uint32_t, peloton::type::Value>;
+
   // Constructor
-  explicit ParameterCache(const QueryParametersMap &map)
-      : parameters_map_(map) {}
+  explicit ParameterCache(const QueryParametersMap &map,
+                          const PinnedValues *pinned_values = nullptr)
+      : parameters_map_(map) {
+    if (pinned_values != nullptr) {
+      pinned_values_ = *pinned_values;
+    }
+  }
 
   // Set the parameter values
   void Populate(CodeGen &codegen, llvm::Value *query_parameters_ptr);
@@ -46,10 +61,19 @@ class ParameterCache {
                                              peloton::type::TypeId type_id,
                                              bool is_nullable);
 
+  // Emit a pinned parameter's value as a compile-time literal
+  static codegen::Value DeriveConstantValue(CodeGen &codegen,
+                                            const peloton::type::Value &value,
+                                            peloton::type::TypeId type_id,
+                                            bool is_nullable);
+
  private:
   // Parameter information
   const QueryParametersMap &parameters_map_;
 
+  // Values the specialized compilation folds in as constants
+  PinnedValues pinned_values_;
+
   // Parameter value storage
   std::vector<codegen::Value> values_;
 };
@@ -52,6 +52,28 @@ class Pipeline {
   uint32_t GetNumStages() const;
   uint32_t GetTranslatorStage(const OperatorTranslator *translator) const;
 
+  //===--------------------------------------------------------------------===//
+  // Parallelism
+  //
+  // A pipeline can be executed by several workers over disjoint morsels of
+  // its source (see RuntimeFunctions::ExecuteTileGroupsParallel) only when
+  // every operator in it tolerates concurrent invocation -- in particular,
+  // whatever the pipeline materializes into must take a concurrent build.
+  // Serial is the safe default; a translator whose state supports
+  // concurrent writes flips its pipeline with MarkParallelizable().
+  //===--------------------------------------------------------------------===//
+
+  // Declare that every operator in this pipeline is safe to run from
+  // multiple workers at once
+  void MarkParallelizable() { parallelizable_ = true; }
+
+  // Force this pipeline back to single-threaded execution
+  void MarkSerial() { parallelizable_ = false; }
+
+  // Should this pipeline be launched on multiple workers? True only when
+  // the operators allow it and codegen_parallel_pipelines is enabled
+  bool IsParallelizable() const;
+
   // Get a stringified version of this pipeline
   std::string GetInfo() const;
 
@@ -66,6 +88,9 @@ class Pipeline {
   // A value, i, in this list means there is a stage boundary between operators
   // i-1 and i in the pipeline.
   std::vector<uint32_t> stage_boundaries_;
+
+  // Whether every operator in the pipeline supports concurrent execution
+  bool parallelizable_ = false;
 };
 
 }  // namespace codegen
@@ -41,6 +41,11 @@ PROXY(RuntimeFunctions) {
   DECLARE_METHOD(FillPredicateArray);
   DECLARE_METHOD(ThrowDivideByZeroException);
   DECLARE_METHOD(ThrowOverflowException);
+  DECLARE_METHOD(ThrowIfQueryCanceled);
+  DECLARE_METHOD(PipelineBegin);
+  DECLARE_METHOD(PipelineRow);
+  DECLARE_METHOD(PipelineEnd);
+  DECLARE_METHOD(ExecuteTileGroupsParallel);
 };
 
 TYPE_BUILDER(ColumnLayoutInfo, codegen::RuntimeFunctions::ColumnLayoutInfo);
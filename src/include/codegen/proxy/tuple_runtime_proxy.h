@@ -21,6 +21,7 @@ namespace codegen {
 
 PROXY(TupleRuntime) {
   DECLARE_METHOD(CreateVarlen);
+  DECLARE_METHOD(CreateInlineVarlen);
 };
 
 }  // namespace codegen
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "common/synchronization/spin_latch.h"
 #include "codegen/code_context.h"
 #include "codegen/runtime_state.h"
 #include "codegen/query_parameters.h"
@@ -79,6 +82,96 @@ class Query {
   // Return the query plan
   const planner::AbstractPlan &GetPlan() const { return query_plan_; }
 
+  //===--------------------------------------------------------------------===//
+  // Tiered compilation
+  //===--------------------------------------------------------------------===//
+
+  // Bump and return the number of times this query has been executed
+  uint64_t IncrementExecutionCount() {
+    return num_executions_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // Is this query already running fully optimized code? True if it was
+  // compiled at the full tier, or if a fully optimized version has been
+  // swapped in.
+  bool IsFullyOptimized() const {
+    return code_context_.GetOptimizationLevel() == OptimizationLevel::kFull ||
+           optimized_query_.load(std::memory_order_acquire) != nullptr;
+  }
+
+  // Claim the (single) recompilation of this query. Returns true exactly once.
+  bool BeginRecompilation() {
+    bool expected = false;
+    return recompiling_.compare_exchange_strong(expected, true);
+  }
+
+  // Delegate all future executions to the given fully optimized version of
+  // this query. This query stays alive as the cache entry, so in-flight
+  // executions through the fast-tier code are never invalidated. The plan the
+  // optimized query was compiled against is kept alive alongside it.
+  void TierUp(std::shared_ptr<planner::AbstractPlan> optimized_plan,
+              std::unique_ptr<Query> optimized_query);
+
+  //===--------------------------------------------------------------------===//
+  // Cross-query code sharing
+  //===--------------------------------------------------------------------===//
+
+  // Run this query on the compiled functions of another query whose generated
+  // IR is byte-identical, skipping JIT compilation entirely. The donor is
+  // kept alive for as long as this query can call into its code.
+  bool AdoptCompiledCode(std::shared_ptr<Query> donor);
+
+  // Record the canonical IR text and its hash, under which the query cache
+  // publishes this query's code for adoption
+  void SetIRSignature(uint64_t ir_hash, std::string &&ir_text) {
+    ir_hash_ = ir_hash;
+    ir_text_ = std::move(ir_text);
+  }
+
+  uint64_t GetIRHash() const { return ir_hash_; }
+  const std::string &GetIRText() const { return ir_text_; }
+
+  // Record the host pointers the generated code references through the
+  // relocatable pointer table; they are passed in at execution time
+  void SetHostPointers(std::vector<const void *> &&host_pointers) {
+    host_pointers_ = std::move(host_pointers);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Parameter specialization
+  //===--------------------------------------------------------------------===//
+
+  // Fold this execution's parameter values into the per-parameter profile
+  void RecordParameterValues(const QueryParameters &params);
+
+  // Check whether the parameter profile has stabilized: at least min_samples
+  // executions recorded, and at least one parameter whose majority value
+  // held a dominant share of them. On success the values to pin for the
+  // specialized compilation are returned.
+  bool HasStableParameterProfile(uint64_t min_samples,
+                                 ParameterCache::PinnedValues &pinned);
+
+  // Claim the (single) specialization of this query. Returns true exactly
+  // once.
+  bool BeginSpecialization() {
+    bool expected = false;
+    return specializing_.compare_exchange_strong(expected, true);
+  }
+
+  // Has a specialization already been claimed? Used to skip the profile
+  // check on the execution path once the decision has been made.
+  bool SpecializationClaimed() const {
+    return specializing_.load(std::memory_order_relaxed);
+  }
+
+  // Delegate future executions whose parameters match the pinned values to
+  // the given specialized variant; all other executions keep running the
+  // parameter-generic code. Like TierUp, the plan the variant was compiled
+  // against is kept alive alongside it.
+  void Specialize(std::shared_ptr<planner::AbstractPlan> specialized_plan,
+                  std::unique_ptr<Query> specialized_query,
+                  ParameterCache::PinnedValues pinned_values);
+
   // Get the holder of the code
   CodeContext &GetCodeContext() { return code_context_; }
 
@@ -89,7 +182,8 @@ class Query {
   friend class QueryCompiler;
 
   // Constructor
-  Query(const planner::AbstractPlan &query_plan);
+  Query(const planner::AbstractPlan &query_plan,
+        OptimizationLevel opt_level = OptimizationLevel::kFull);
 
  private:
   // The query plan
@@ -103,9 +197,57 @@ class Query {
 
   // The init(), plan() and tearDown() functions
   typedef void (*compiled_function_t)(char *);
-  compiled_function_t init_func_;
-  compiled_function_t plan_func_;
-  compiled_function_t tear_down_func_;
+  compiled_function_t init_func_ = nullptr;
+  compiled_function_t plan_func_ = nullptr;
+  compiled_function_t tear_down_func_ = nullptr;
+
+  // The canonical IR signature under which this query's code is shared
+  uint64_t ir_hash_ = 0;
+  std::string ir_text_;
+
+  // The host pointers the generated code reaches through the relocatable
+  // pointer table. Each query passes its own table at execution time, which
+  // is what makes the code shareable across queries in the first place.
+  std::vector<const void *> host_pointers_;
+
+  // The query whose compiled functions this query runs, when compilation was
+  // skipped in favor of an identical cached module
+  std::shared_ptr<Query> code_donor_;
+
+  // Number of times this query has been executed
+  std::atomic<uint64_t> num_executions_{0};
+
+  // Set once a recompilation at the full tier has been claimed
+  std::atomic<bool> recompiling_{false};
+
+  // The fully optimized version of this query, once tier-up has happened.
+  // Executions observe the atomic pointer; the owner keeps it alive.
+  std::atomic<Query *> optimized_query_{nullptr};
+  std::unique_ptr<Query> optimized_query_owner_;
+  std::shared_ptr<planner::AbstractPlan> optimized_query_plan_;
+
+  // Does the current execution's parameters match the specialized variant's
+  // pinned values?
+  bool MatchesPinnedValues(const QueryParameters &params) const;
+
+  // Per-parameter majority-vote profile (Boyer-Moore): the current majority
+  // candidate and its vote counter. The counter is a lower bound on the
+  // candidate's lead over all other values, so requiring a large counter
+  // share guarantees an even larger true share.
+  common::synchronization::SpinLatch profile_latch_;
+  std::vector<peloton::type::Value> profile_candidates_;
+  std::vector<int64_t> profile_votes_;
+  uint64_t profile_samples_ = 0;
+
+  // Set once a parameter specialization has been claimed
+  std::atomic<bool> specializing_{false};
+
+  // The parameter-specialized variant of this query and the values guarding
+  // it, once specialization has happened
+  std::atomic<Query *> specialized_query_{nullptr};
+  std::unique_ptr<Query> specialized_query_owner_;
+  std::shared_ptr<planner::AbstractPlan> specialized_query_plan_;
+  ParameterCache::PinnedValues pinned_values_;
 
  private:
   // This class cannot be copy or move-constructed
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 
 #include "codegen/query.h"
@@ -37,6 +38,16 @@ class QueryCache : public Singleton<QueryCache> {
   // Find the cached query object with the given plan
   Query *Find(const std::shared_ptr<planner::AbstractPlan> &key);
 
+  // Find a cached query whose canonical IR is byte-identical to the given
+  // text, keyed by its hash. Returns shared ownership so the adopting query
+  // can pin the donor's code beyond the donor's cache lifetime.
+  std::shared_ptr<Query> FindCompiledByIR(uint64_t ir_hash,
+                                          const std::string &ir_text);
+
+  // Check whether a compiled query exists for the given plan, without
+  // touching the LRU order or the hit/miss counters
+  bool Contains(const std::shared_ptr<planner::AbstractPlan> &key);
+
   // Add a plan and a query object to the cache
   void Add(const std::shared_ptr<planner::AbstractPlan> &key,
            std::unique_ptr<Query> &&val);
@@ -56,6 +67,17 @@ class QueryCache : public Singleton<QueryCache> {
   // Set the total capacity of the cache
   void SetCapacity(size_t capacity) { Resize(capacity); }
 
+  // Total JIT code and data bytes held by the cached queries
+  size_t GetMemoryBytes() const { return memory_bytes_; }
+
+  // Number of lookups that found, resp. missed, a compiled query
+  uint64_t GetHitCount() const { return num_hits_.load(); }
+  uint64_t GetMissCount() const { return num_misses_.load(); }
+
+  // Number of compilations that adopted another cached query's code instead
+  // of JIT compiling their own
+  uint64_t GetSharedCount() const { return num_shared_.load(); }
+
  private:
   friend class Singleton<QueryCache>;
 
@@ -64,20 +86,49 @@ class QueryCache : public Singleton<QueryCache> {
   // Resize the cache in the LRU manner
   void Resize(size_t target_size);
 
+  // Evict least-recently-used entries until the cache respects both the
+  // entry capacity (when nonzero) and the byte budget from the settings
+  // manager. The caller must hold the write latch.
+  void EnforceBudget();
+
+  // Drop the least-recently-used entry. The caller must hold the write
+  // latch.
+  void EvictLast();
+
+  // Drop the query's IR index entry, unless the hash has since been taken
+  // over by another query. The caller must hold the write latch.
+  void DropIRIndexEntry(const std::shared_ptr<Query> &query);
+
   // Get the table Oid from the plan given
   oid_t GetOidFromPlan(const planner::AbstractPlan &plan) const;
 
  private:
   std::list<std::pair<std::shared_ptr<planner::AbstractPlan>,
-                      std::unique_ptr<Query>>> query_list_;
+                      std::shared_ptr<Query>>> query_list_;
 
   std::unordered_map<std::shared_ptr<planner::AbstractPlan>,
                      decltype(query_list_.begin()), planner::Hash,
                      planner::Equal> cache_map_;
 
+  // Canonical IR hash of each cached query, so structurally identical
+  // compilations can find a donor without a matching plan. The weak
+  // references expire with the cache entries; adoptees hold their own
+  // shared reference to the donor.
+  std::unordered_map<uint64_t, std::weak_ptr<Query>> ir_index_;
+
   common::synchronization::ReadWriteLatch cache_lock_;
 
   size_t capacity_ = 0;
+
+  // JIT bytes held by the cached queries
+  size_t memory_bytes_ = 0;
+
+  // Lookup counters
+  std::atomic<uint64_t> num_hits_{0};
+  std::atomic<uint64_t> num_misses_{0};
+
+  // Compilations served by adopting an identical cached module
+  std::atomic<uint64_t> num_shared_{0};
 };
 
 }  // namespace codegen
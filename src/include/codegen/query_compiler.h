@@ -53,11 +53,17 @@ class QueryCompiler {
   // Compile the provided query, returning the compiled plan that can be invoked
   // to return results. Callers can also pass in an (optional) CompileStats
   // object pointer if they want to collect statistics on the compilation
-  // process.
-  std::unique_ptr<Query> Compile(const planner::AbstractPlan &query_plan,
-                                 const QueryParametersMap &parameters_map,
-                                 QueryResultConsumer &consumer,
-                                 CompileStats *stats = nullptr);
+  // process, and choose the optimization tier the query is compiled at.
+  // Passing pinned parameter values compiles a variant specialized on them:
+  // those parameters are folded in as constants, and the caller is
+  // responsible for only executing the variant when the runtime parameters
+  // match.
+  std::unique_ptr<Query> Compile(
+      const planner::AbstractPlan &query_plan,
+      const QueryParametersMap &parameters_map, QueryResultConsumer &consumer,
+      CompileStats *stats = nullptr,
+      OptimizationLevel opt_level = OptimizationLevel::kFull,
+      const ParameterCache::PinnedValues *pinned_parameters = nullptr);
 
   // Get the next available query plan ID
   uint64_t NextId() { return next_id_++; }
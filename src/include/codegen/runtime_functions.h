@@ -25,6 +25,10 @@ class ZoneMapManager;
 struct PredicateInfo;
 }  // namespace storage
 
+namespace executor {
+class ExecutorContext;
+}  // namespace executor
+
 namespace expression {
 class AbstractExpression;
 }  // namespace storage
@@ -71,6 +75,51 @@ class RuntimeFunctions {
   static void ThrowDivideByZeroException();
 
   static void ThrowOverflowException();
+
+  // Cancellation point for compiled loops. The compiler emits this once
+  // per tile group of a scan, so a kill_query() or an expired
+  // statement_timeout_ms deadline unwinds a compiled query just like an
+  // interpreted one. The fast path is one relaxed load of the cancel flag.
+  static void ThrowIfQueryCanceled(executor::ExecutorContext *executor_context);
+
+  //===--------------------------------------------------------------------===//
+  // Per-pipeline instrumentation. The compiler emits a Begin/End pair around
+  // each pipeline function and a Row call where rows leave the pipeline;
+  // cycle and row counts are accumulated in a thread-local stack and exported
+  // through the backend's statistics context when the pipeline ends. None of
+  // these calls are emitted unless the codegen_pipeline_metrics setting is on.
+  //===--------------------------------------------------------------------===//
+
+  // Start timing the given pipeline on this thread
+  static void PipelineBegin(uint32_t pipeline_id, const char *pipeline_info);
+
+  // Count one row leaving the innermost active pipeline
+  static void PipelineRow();
+
+  // Stop timing the given pipeline and export its counters
+  static void PipelineEnd(uint32_t pipeline_id);
+
+  //===--------------------------------------------------------------------===//
+  // Parallel pipeline execution. A parallelizable pipeline is compiled as a
+  // morsel function that processes tile groups [begin, end) of its source
+  // table; this dispatcher hands out fixed-size tile group ranges from a
+  // shared cursor to the worker pool, so a skewed morsel does not stall the
+  // other workers. The runtime state pointer is shared by every worker --
+  // a pipeline is only marked parallelizable when the state it writes
+  // (e.g. a hash table in concurrent-build mode) tolerates that.
+  //===--------------------------------------------------------------------===//
+
+  // Signature of a compiled pipeline morsel body
+  typedef void (*MorselFunction)(void *runtime_state,
+                                 uint64_t tile_group_begin,
+                                 uint64_t tile_group_end);
+
+  // Run the morsel function over every tile group of the table, using up to
+  // monoqueue_worker_pool_size workers (including the calling thread).
+  // Falls back to one serial invocation for small tables or a size-one pool
+  static void ExecuteTileGroupsParallel(storage::DataTable *table,
+                                        void *runtime_state,
+                                        MorselFunction morsel_func);
 };
 
 }  // namespace codegen
@@ -39,10 +39,13 @@ class Table {
 
   // Generate code to perform a scan over the given table. The table pointer
   // is provided as the second argument. The scan consumer (third argument)
-  // should be notified when ready to generate the scan loop body.
+  // should be notified when ready to generate the scan loop body. The
+  // executor context pointer feeds the per-tile-group cancellation poll
+  // emitted at the top of the scan loop.
   void GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                     uint32_t batch_size, ScanCallback &consumer,
-                    llvm::Value *predicate_array, size_t num_predicates) const;
+                    llvm::Value *predicate_array, size_t num_predicates,
+                    llvm::Value *executor_context_ptr) const;
 
   // Given a table instance, return the number of tile groups in the table.
   llvm::Value *GetTileGroupCount(CodeGen &codegen,
@@ -26,6 +26,9 @@ class TupleRuntime {
  public:
   static void CreateVarlen(char *data, uint32_t len, char *buf,
                            peloton::type::AbstractPool *pool);
+
+  // Write an inlined varlen value ([length][bytes]) directly into buf
+  static void CreateInlineVarlen(char *data, uint32_t len, char *buf);
 };
 
 }  // namespace codegen
@@ -42,6 +42,12 @@ class Sorter {
   // We (arbitrarily) allocate 32KB of buffer space upon initialization
   static constexpr uint64_t kInitialBufferSize = 32 * 1024;
 
+  // Below this many tuples a serial sort beats the thread fork/join cost
+  static constexpr uint64_t kParallelSortThreshold = 64 * 1024;
+
+  // Cap on the number of sort workers (and hence initial sorted runs)
+  static constexpr uint64_t kMaxSortWorkers = 8;
+
  public:
   typedef int (*ComparisonFunction)(const char *left_tuple,
                                     const char *right_tuple);
@@ -70,7 +76,11 @@ class Sorter {
   char *StoreInputTuple();
 
   /**
-   * Sort all tuples stored in this sorter.
+   * Sort all tuples stored in this sorter. Small inputs are sorted serially
+   * in place; large inputs are split into runs sorted by parallel workers
+   * and then merged (pairwise, with the merges of each round also running
+   * in parallel). Either way the sorted result ends up contiguous, so
+   * iteration is unaffected.
    */
   void Sort();
 
@@ -126,6 +136,13 @@ class Sorter {
   // Resize the given array to a larger size
   void Resize();
 
+  // Parallel sort path: sort runs on worker threads, then merge
+  void ParallelSort();
+
+  // Stable two-way merge of the sorted runs at left/right into dest
+  void MergeRuns(const char *left, uint64_t left_count, const char *right,
+                 uint64_t right_count, char *dest) const;
+
  private:
   // The three pointers below track the buffer space where tuples are stored.
   //
@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <vector>
 
 #include "libcuckoo/cuckoohash_map.hh"
 
@@ -37,6 +38,12 @@ class CuckooMap {
  public:
 
   CuckooMap();
+
+  // Sizes the table for initial_size elements up front, so hot maps with a
+  // known working set skip the incremental rehashes of the default
+  // configuration
+  explicit CuckooMap(size_t initial_size);
+
   ~CuckooMap();
 
   // Inserts a item
@@ -48,6 +55,19 @@ class CuckooMap {
   // Extracts the corresponding value
   bool Find(const KeyType &key, ValueType &value) const;
 
+  // Resolves all keys in one pass. values is resized to match keys; a miss
+  // leaves the slot default-constructed. Returns the number of keys found.
+  size_t FindBulk(const std::vector<KeyType> &keys,
+                  std::vector<ValueType> &values) const;
+
+  // Materializes the current contents into snapshot under a single table
+  // lock. Read-mostly scans that resolve thousands of keys can then probe
+  // the local copy instead of taking per-bucket locks on every lookup.
+  void GetSnapshot(std::vector<std::pair<KeyType, ValueType>> &snapshot);
+
+  // Grows the table to hold at least new_size elements
+  bool Reserve(size_t new_size);
+
   // Delete key from the cuckoo_map
   bool Erase(const KeyType &key);
 
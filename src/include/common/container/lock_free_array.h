@@ -16,7 +16,6 @@
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
-#include <array>
 #include <atomic>
 #include <memory>
 
@@ -66,13 +65,31 @@ class LockFreeArray {
 
  private:
 
-  // lock free array type
-  typedef std::array<ValueType, LOCK_FREE_ARRAY_MAX_SIZE> lock_free_array_t;
+  // Entries live in fixed-size segments that are allocated lazily and
+  // published with a CAS. A published segment never moves, so growth
+  // neither copies entries nor stalls concurrent readers, and the only
+  // memory paid for up front is the segment directory itself.
+  static const std::size_t kSegmentBits = 10;
+  static const std::size_t kSegmentSize = std::size_t(1) << kSegmentBits;
+  static const std::size_t kSegmentMask = kSegmentSize - 1;
+  static const std::size_t kSegmentCount =
+      LOCK_FREE_ARRAY_MAX_SIZE / kSegmentSize;
+
+  struct Segment {
+    ValueType items[kSegmentSize];
+  };
+
+  // Segment holding offset, allocating and publishing it if no thread
+  // has yet
+  Segment *EnsureSegment(const std::size_t offset);
+
+  // Segment holding offset, or nullptr if nothing was ever stored there
+  Segment *GetSegment(const std::size_t offset) const;
 
   std::atomic<std::size_t> lock_free_array_offset {0};
 
-  // lock free array
-  std::unique_ptr<lock_free_array_t> lock_free_array;
+  // segment directory; slots start null and are published at most once
+  std::atomic<Segment *> segments_[kSegmentCount];
 };
 
 }  // namespace peloton
@@ -0,0 +1,242 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// oa_hash_table.h
+//
+// Identification: src/include/common/container/oa_hash_table.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Open-addressing Hash Table -- A runtime (non-JIT) counterpart to the
+// codegen engine's OAHashTable. Keys live once in a contiguous key vector,
+// slots are a flat power-of-two array probed linearly, and duplicate values
+// for a key are chained through a flat value-node vector, so a probe touches
+// a couple of cache lines instead of chasing per-node heap allocations.
+//
+// Not thread-safe. References and iterators returned by lookups are
+// invalidated by subsequent inserts.
+//===--------------------------------------------------------------------===//
+
+template <typename Key, typename Value, typename Hasher, typename Comparator>
+class OAHashTable {
+  static const int32_t kInvalidIndex = -1;
+
+  // A slot points at its key and at the head of its value chain; a slot
+  // with no key index is empty
+  struct Slot {
+    uint64_t hash = 0;
+    int32_t key_index = kInvalidIndex;
+    int32_t value_head = kInvalidIndex;
+  };
+
+  // One value in a key's chain
+  struct ValueNode {
+    Value value;
+    int32_t next;
+  };
+
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+
+  explicit OAHashTable(size_t initial_num_keys = 256) {
+    size_t num_slots = kMinSlots;
+    while (num_slots * kMaxLoadNum < initial_num_keys * kMaxLoadDen) {
+      num_slots <<= 1;
+    }
+    slots_.resize(num_slots);
+    slot_mask_ = num_slots - 1;
+  }
+
+  DISALLOW_COPY(OAHashTable);
+
+  /** @brief Iterates the value chain of one key */
+  class ValueIterator {
+   public:
+    ValueIterator() : nodes_(nullptr), current_(kInvalidIndex) {}
+
+    bool HasNext() const { return current_ != kInvalidIndex; }
+
+    const Value &Next() {
+      const ValueNode &node = (*nodes_)[current_];
+      current_ = node.next;
+      return node.value;
+    }
+
+   private:
+    friend class OAHashTable;
+
+    ValueIterator(const std::vector<ValueNode> *nodes, int32_t head)
+        : nodes_(nodes), current_(head) {}
+
+    const std::vector<ValueNode> *nodes_;
+    int32_t current_;
+  };
+
+  /** @brief Grow the slot array up front for an expected number of keys */
+  void Reserve(size_t num_keys) {
+    size_t num_slots = slots_.size();
+    while (num_slots * kMaxLoadNum < num_keys * kMaxLoadDen) {
+      num_slots <<= 1;
+    }
+    if (num_slots != slots_.size()) {
+      Rehash(num_slots);
+    }
+    keys_.reserve(num_keys);
+  }
+
+  /**
+   * @brief Append a value to the key's chain, creating the key on first
+   * sight. Returns true if the key was already present.
+   */
+  bool Insert(const Key &key, const Value &value) {
+    const uint64_t hash = Hasher()(key);
+    Slot *slot = &FindSlot(key, hash);
+    const bool existed = (slot->key_index != kInvalidIndex);
+    if (existed == false) {
+      slot = &NewKey(key, hash);
+    }
+    values_.push_back(ValueNode{value, slot->value_head});
+    slot->value_head = static_cast<int32_t>(values_.size()) - 1;
+    return existed;
+  }
+
+  /**
+   * @brief Find the key's single value, default-constructing it on first
+   * sight. Meant for tables with one value per key (e.g. counters).
+   */
+  Value &FindOrCreate(const Key &key) {
+    const uint64_t hash = Hasher()(key);
+    Slot *slot = &FindSlot(key, hash);
+    if (slot->key_index == kInvalidIndex) {
+      slot = &NewKey(key, hash);
+      values_.push_back(ValueNode{Value(), kInvalidIndex});
+      slot->value_head = static_cast<int32_t>(values_.size()) - 1;
+    }
+    return values_[slot->value_head].value;
+  }
+
+  /** @brief Return the key's first value, or nullptr if the key is absent */
+  Value *Find(const Key &key) {
+    Slot &slot = FindSlot(key, Hasher()(key));
+    if (slot.key_index == kInvalidIndex) return nullptr;
+    return &values_[slot.value_head].value;
+  }
+
+  /** @brief Same as Find(), additionally exposing the stored key */
+  Value *Find(const Key &key, const Key *&stored_key) {
+    Slot &slot = FindSlot(key, Hasher()(key));
+    if (slot.key_index == kInvalidIndex) return nullptr;
+    stored_key = &keys_[slot.key_index];
+    return &values_[slot.value_head].value;
+  }
+
+  /**
+   * @brief Probe for a key; on a hit, expose the stored key (useful when
+   * the caller needs the build side's representative tuple) and an
+   * iterator over the key's value chain.
+   */
+  bool Probe(const Key &key, const Key *&stored_key,
+             ValueIterator &values) const {
+    const Slot &slot = FindSlot(key, Hasher()(key));
+    if (slot.key_index == kInvalidIndex) return false;
+    stored_key = &keys_[slot.key_index];
+    values = ValueIterator(&values_, slot.value_head);
+    return true;
+  }
+
+  /** @brief Apply a function to every (key, first chain value) pair */
+  template <typename Function>
+  void ForEach(Function function) {
+    for (auto &slot : slots_) {
+      if (slot.key_index != kInvalidIndex) {
+        function(keys_[slot.key_index], values_[slot.value_head].value);
+      }
+    }
+  }
+
+  size_t NumKeys() const { return keys_.size(); }
+
+  size_t NumValues() const { return values_.size(); }
+
+ private:
+  // Linear probing; returns the key's slot, or the empty slot where it
+  // belongs
+  Slot &FindSlot(const Key &key, uint64_t hash) {
+    size_t slot_idx = hash & slot_mask_;
+    while (true) {
+      Slot &slot = slots_[slot_idx];
+      if (slot.key_index == kInvalidIndex ||
+          (slot.hash == hash && Comparator()(keys_[slot.key_index], key))) {
+        return slot;
+      }
+      slot_idx = (slot_idx + 1) & slot_mask_;
+    }
+  }
+
+  const Slot &FindSlot(const Key &key, uint64_t hash) const {
+    return const_cast<OAHashTable *>(this)->FindSlot(key, hash);
+  }
+
+  // Claim the slot for a new key, growing the slot array first when the
+  // load factor would be exceeded. Earlier Slot references are invalid
+  // after this call since growing replaces the slot array.
+  Slot &NewKey(const Key &key, uint64_t hash) {
+    if ((keys_.size() + 1) * kMaxLoadDen > slots_.size() * kMaxLoadNum) {
+      Rehash(slots_.size() << 1);
+    }
+    keys_.push_back(key);
+    Slot &slot = FindSlot(key, hash);
+    slot.hash = hash;
+    slot.key_index = static_cast<int32_t>(keys_.size()) - 1;
+    return slot;
+  }
+
+  // Re-bucket the slots; keys and value chains stay where they are
+  void Rehash(size_t new_num_slots) {
+    std::vector<Slot> old_slots;
+    old_slots.swap(slots_);
+    slots_.resize(new_num_slots);
+    slot_mask_ = new_num_slots - 1;
+    for (auto &old_slot : old_slots) {
+      if (old_slot.key_index == kInvalidIndex) continue;
+      size_t slot_idx = old_slot.hash & slot_mask_;
+      while (slots_[slot_idx].key_index != kInvalidIndex) {
+        slot_idx = (slot_idx + 1) & slot_mask_;
+      }
+      slots_[slot_idx] = old_slot;
+    }
+  }
+
+  static const size_t kMinSlots = 64;
+  // Maximum load factor of 70%
+  static const size_t kMaxLoadNum = 7;
+  static const size_t kMaxLoadDen = 10;
+
+  /** @brief Flat, linearly probed slot array; size is a power of two */
+  std::vector<Slot> slots_;
+
+  size_t slot_mask_;
+
+  /** @brief One entry per distinct key, in insertion order */
+  std::vector<Key> keys_;
+
+  /** @brief Value chains, index-linked per key */
+  std::vector<ValueNode> values_;
+};
+
+}  // namespace peloton
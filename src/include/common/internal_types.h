@@ -469,6 +469,7 @@ enum class IndexType {
   HASH = 2,                   // hash
   SKIPLIST = 3,               // skiplist
   ART = 4,                    // ART
+  BITMAP = 5,                 // bitmap over low-cardinality columns
 };
 std::string IndexTypeToString(IndexType type);
 IndexType StringToIndexType(const std::string &str);
@@ -723,7 +724,8 @@ enum class JoinType {
   RIGHT = 2,                  // right
   INNER = 3,                  // inner
   OUTER = 4,                  // outer
-  SEMI = 5                    // IN+Subquery is SEMI
+  SEMI = 5,                   // IN+Subquery is SEMI
+  ANTI = 6                    // NOT EXISTS+Subquery is ANTI
 };
 std::string JoinTypeToString(JoinType type);
 JoinType StringToJoinType(const std::string &str);
@@ -928,6 +930,9 @@ enum class LogRecordType {
   TUPLE_INSERT = 11,
   TUPLE_DELETE = 12,
   TUPLE_UPDATE = 13,
+  // Update carrying only the modified column ids and values; full-image
+  // TUPLE_UPDATE remains the fallback (e.g. during schema changes)
+  TUPLE_UPDATE_DELTA = 14,
 
   // Epoch related records
   EPOCH_BEGIN = 21,
@@ -1041,6 +1046,8 @@ enum class MetricType {
   QUERY = 9,
   // Statistics for CPU
   PROCESSOR = 10,
+  // Log-bucketed latency histogram
+  HISTOGRAM = 11,
 };
 
 // All builtin operators we currently support
@@ -1075,6 +1082,7 @@ enum class OperatorId : uint32_t {
   DateTrunc,
   Like,
   Now,
+  KillQuery,
 
   // Add more operators here, before the last "Invalid" entry
   Invalid
@@ -1126,6 +1134,9 @@ static const oid_t MAX_OID = std::numeric_limits<oid_t>::max() - 1;
 
 #define NULL_OID MAX_OID
 
+// NUMA node id; INVALID_NUMA_NODE means "no affinity requested"
+static const int INVALID_NUMA_NODE = -1;
+
 // For transaction id
 
 typedef uint64_t txn_id_t;
@@ -1196,9 +1207,133 @@ std::string RWTypeToString(RWType type);
 RWType StringToRWType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const RWType &type);
 
+//===--------------------------------------------------------------------===//
+// Per-tile-group slice of a transaction's read/write set.
+//
+// Entries live in one flat (offset, type) vector -- eight bytes apiece,
+// scanned in recording order by commit and abort -- instead of one hash map
+// node per touched tuple. The offset lookup starts as a hash index and is
+// swapped for a direct-mapped slot array once the transaction has touched
+// enough of the tile group (the bulk UPDATE pattern), so the bookkeeping
+// for a maintenance transaction that rewrites whole tile groups stays at a
+// few bytes per touched tuple instead of dwarfing the data it modifies.
+//
+// The interface mirrors the std::unordered_map<oid_t, RWType> it replaces;
+// entries are never erased, only added or retyped, which is all the
+// transaction context ever does.
+//===--------------------------------------------------------------------===//
+class TileGroupRWSet {
+ public:
+  typedef std::pair<oid_t, RWType> value_type;
+  typedef std::vector<value_type>::iterator iterator;
+  typedef std::vector<value_type>::const_iterator const_iterator;
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  iterator find(oid_t tuple_id) {
+    int64_t pos = FindPos(tuple_id);
+    return pos < 0 ? entries_.end() : entries_.begin() + pos;
+  }
+
+  const_iterator find(oid_t tuple_id) const {
+    int64_t pos = FindPos(tuple_id);
+    return pos < 0 ? entries_.end() : entries_.begin() + pos;
+  }
+
+  RWType &at(oid_t tuple_id) {
+    int64_t pos = FindPos(tuple_id);
+    PL_ASSERT(pos >= 0);
+    return entries_[pos].second;
+  }
+
+  const RWType &at(oid_t tuple_id) const {
+    int64_t pos = FindPos(tuple_id);
+    PL_ASSERT(pos >= 0);
+    return entries_[pos].second;
+  }
+
+  RWType &operator[](oid_t tuple_id) {
+    int64_t pos = FindPos(tuple_id);
+    if (pos >= 0) {
+      return entries_[pos].second;
+    }
+    entries_.emplace_back(tuple_id, RWType::INVALID);
+    RecordPos(tuple_id, entries_.size() - 1);
+    return entries_.back().second;
+  }
+
+  // Drop every entry recorded at position new_size or later. Entries are
+  // appended in recording order, so this is how partial rollback discards
+  // exactly the work done after a savepoint.
+  void Truncate(size_t new_size) {
+    for (size_t pos = new_size; pos < entries_.size(); pos++) {
+      oid_t tuple_id = entries_[pos].first;
+      if (!direct_map_.empty()) {
+        direct_map_[tuple_id] = -1;
+      } else {
+        index_.erase(tuple_id);
+      }
+    }
+    entries_.resize(new_size);
+  }
+
+ private:
+  // Switch the lookup to the direct-mapped slot array once this many
+  // tuples are in the set; a transaction this deep into one tile group is
+  // rewriting most of it
+  static const size_t kDirectMapThreshold = 256;
+
+  // Entry position for a tuple offset, or -1 when absent
+  int64_t FindPos(oid_t tuple_id) const {
+    if (!direct_map_.empty()) {
+      if (tuple_id >= direct_map_.size()) return -1;
+      return direct_map_[tuple_id];
+    }
+    auto itr = index_.find(tuple_id);
+    return itr == index_.end() ? -1 : static_cast<int64_t>(itr->second);
+  }
+
+  void RecordPos(oid_t tuple_id, size_t pos) {
+    if (!direct_map_.empty() || entries_.size() >= kDirectMapThreshold) {
+      if (tuple_id >= direct_map_.size()) {
+        direct_map_.resize(tuple_id + 1, -1);
+      }
+      if (index_.size() != 0) {
+        // Crossing the threshold: fold the hash index into the slot array
+        // and drop it for good
+        for (const auto &indexed : index_) {
+          if (indexed.first >= direct_map_.size()) {
+            direct_map_.resize(indexed.first + 1, -1);
+          }
+          direct_map_[indexed.first] = indexed.second;
+        }
+        std::unordered_map<oid_t, uint32_t>().swap(index_);
+      }
+      direct_map_[tuple_id] = static_cast<int32_t>(pos);
+    } else {
+      index_[tuple_id] = static_cast<uint32_t>(pos);
+    }
+  }
+
+  // The entries themselves, in recording order
+  std::vector<value_type> entries_;
+
+  // Sparse phase: tuple offset -> entry position
+  std::unordered_map<oid_t, uint32_t> index_;
+
+  // Dense phase: entry position indexed by tuple offset, -1 when absent;
+  // non-empty only after the threshold is crossed
+  std::vector<int32_t> direct_map_;
+};
+
 // block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
+typedef std::unordered_map<oid_t, TileGroupRWSet> ReadWriteSet;
 
 // this enum is to identify why the version should be GC'd.
 enum class GCVersionType {
@@ -1322,6 +1457,9 @@ enum class RuleType : uint32_t {
   AGGREGATE_TO_PLAIN_AGGREGATE,
   INNER_JOIN_TO_NL_JOIN,
   INNER_JOIN_TO_HASH_JOIN,
+  INNER_JOIN_TO_MERGE_JOIN,
+  SEMI_JOIN_TO_HASH_JOIN,
+  ANTI_JOIN_TO_HASH_JOIN,
   IMPLEMENT_DISTINCT,
   IMPLEMENT_LIMIT,
 
@@ -1330,11 +1468,13 @@ enum class RuleType : uint32_t {
 
   // Rewrite rules (logical -> logical)
   PUSH_FILTER_THROUGH_JOIN,
+  PUSH_FILTER_THROUGH_SEMI_JOIN,
+  PUSH_FILTER_THROUGH_ANTI_JOIN,
   COMBINE_CONSECUTIVE_FILTER,
   EMBED_FILTER_INTO_GET,
-  MARK_JOIN_GET_TO_INNER_JOIN,
-  MARK_JOIN_INNER_JOIN_TO_INNER_JOIN,
-  MARK_JOIN_FILTER_TO_INNER_JOIN,
+  MARK_JOIN_GET_TO_SEMI_JOIN,
+  MARK_JOIN_INNER_JOIN_TO_SEMI_JOIN,
+  MARK_JOIN_FILTER_TO_SEMI_JOIN,
   PULL_FILTER_THROUGH_MARK_JOIN,
 
   // Place holder to generate number of rules compile time
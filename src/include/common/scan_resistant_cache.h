@@ -0,0 +1,203 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// scan_resistant_cache.h
+//
+// Identification: src/include/common/scan_resistant_cache.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Scan Resistant Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Byte-budgeted cache with midpoint insertion and
+ * promotion-on-second-touch (2Q-style).
+ *
+ * Entries enter a probationary segment and only move into the protected
+ * segment when they are touched a second time, so a single large scan can
+ * at most churn the probationary segment: the working set that earned
+ * protection survives it. The protected segment is capped at a fraction
+ * of the budget; overflowing protected entries are demoted back to the
+ * probationary side rather than evicted outright, giving them one more
+ * chance to be re-touched.
+ *
+ * Unlike common::Cache, which counts entries, the budget here is in bytes:
+ * every entry carries a caller-supplied charge, so the cache can manage
+ * variable-sized blocks. Eviction hands the victims back to the caller,
+ * which owns whatever cleanup an eviction implies (the cache never owns
+ * the values). All operations are latched; hit/miss/eviction counters are
+ * kept for observability.
+ */
+template <typename Key, typename Value>
+class ScanResistantCache {
+ public:
+  ScanResistantCache(const ScanResistantCache &) = delete;
+  ScanResistantCache &operator=(const ScanResistantCache &) = delete;
+  ScanResistantCache(ScanResistantCache &&) = delete;
+  ScanResistantCache &operator=(ScanResistantCache &&) = delete;
+
+  explicit ScanResistantCache(size_t budget_bytes)
+      : budget_bytes_(budget_bytes) {}
+
+  /**
+   * Record a reference to the given key. Returns true on a hit; promoted
+   * is set when this was the entry's second touch, i.e. it just moved
+   * from the probationary to the protected segment.
+   */
+  bool Touch(const Key &key, bool &promoted) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    promoted = false;
+    auto index_entry = index_.find(key);
+    if (index_entry == index_.end()) {
+      miss_count_++;
+      return false;
+    }
+    hit_count_++;
+    auto entry_itr = index_entry->second;
+    if (entry_itr->in_protected == false) {
+      // second touch: promote into the protected segment
+      entry_itr->in_protected = true;
+      protected_bytes_ += entry_itr->charge;
+      protected_.splice(protected_.begin(), probation_, entry_itr);
+      promoted = true;
+      // overflowing protected entries get demoted, not evicted
+      while (protected_bytes_ > ProtectedCap() && protected_.empty() == false) {
+        auto demote_itr = std::prev(protected_.end());
+        demote_itr->in_protected = false;
+        protected_bytes_ -= demote_itr->charge;
+        probation_.splice(probation_.begin(), protected_, demote_itr);
+      }
+    } else {
+      protected_.splice(protected_.begin(), protected_, entry_itr);
+    }
+    return true;
+  }
+
+  /**
+   * Insert a new entry at the midpoint: the head of the probationary
+   * segment, below every protected entry. Victims pushed out of the
+   * budget are appended to evicted for the caller to clean up. A key that
+   * is already cached is left untouched.
+   */
+  void Insert(const Key &key, const Value &value, size_t charge,
+              std::vector<Value> &evicted) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (index_.find(key) != index_.end()) {
+      return;
+    }
+    probation_.push_front({key, value, charge, false});
+    index_[key] = probation_.begin();
+    occupied_bytes_ += charge;
+
+    while (occupied_bytes_ > budget_bytes_ && index_.empty() == false) {
+      if (probation_.empty() == true) {
+        // nothing probationary left: the oldest protected entry loses its
+        // status and becomes the next victim
+        auto demote_itr = std::prev(protected_.end());
+        demote_itr->in_protected = false;
+        protected_bytes_ -= demote_itr->charge;
+        probation_.splice(probation_.end(), protected_, demote_itr);
+      }
+      auto victim_itr = std::prev(probation_.end());
+      occupied_bytes_ -= victim_itr->charge;
+      eviction_count_++;
+      evicted.push_back(victim_itr->value);
+      index_.erase(victim_itr->key);
+      probation_.erase(victim_itr);
+    }
+  }
+
+  /** Drop an entry, e.g. because the cached object is being destroyed */
+  bool Erase(const Key &key) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto index_entry = index_.find(key);
+    if (index_entry == index_.end()) {
+      return false;
+    }
+    auto entry_itr = index_entry->second;
+    occupied_bytes_ -= entry_itr->charge;
+    if (entry_itr->in_protected == true) {
+      protected_bytes_ -= entry_itr->charge;
+      protected_.erase(entry_itr);
+    } else {
+      probation_.erase(entry_itr);
+    }
+    index_.erase(index_entry);
+    return true;
+  }
+
+  void SetBudget(size_t budget_bytes) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    budget_bytes_ = budget_bytes;
+  }
+
+  size_t GetOccupiedBytes() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return occupied_bytes_;
+  }
+
+  size_t GetSize() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return index_.size();
+  }
+
+  uint64_t GetHitCount() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return hit_count_;
+  }
+
+  uint64_t GetMissCount() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return miss_count_;
+  }
+
+  uint64_t GetEvictionCount() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return eviction_count_;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    Value value;
+    size_t charge;
+    bool in_protected;
+  };
+
+  // The protected segment may grow to this fraction of the budget before
+  // its tail is demoted; 5/8 mirrors the usual midpoint split
+  size_t ProtectedCap() const { return budget_bytes_ * 5 / 8; }
+
+  // LRU-ordered segments; splicing between them keeps iterators valid
+  std::list<Entry> probation_;
+  std::list<Entry> protected_;
+
+  std::unordered_map<Key, typename std::list<Entry>::iterator> index_;
+
+  size_t budget_bytes_;
+  size_t occupied_bytes_ = 0;
+  size_t protected_bytes_ = 0;
+
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  uint64_t eviction_count_ = 0;
+
+  mutable std::mutex mutex_;
+};
+
+}  // namespace peloton
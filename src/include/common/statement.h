@@ -20,11 +20,16 @@
 #include "common/printable.h"
 #include "internal_types.h"
 #include "parser/sql_statement.h"
+#include "type/value.h"
 
 namespace peloton {
 namespace planner {
 class AbstractPlan;
 }
+namespace executor {
+class AbstractExecutor;
+class ExecutorContext;
+}
 
 // Contains the value of a column in a tuple of the result set.
 // std::string since the result is sent to the client over the network.
@@ -85,6 +90,52 @@ class Statement : public Printable {
 
   inline void SetNeedsReplan(bool replan) { needs_replan_ = replan; }
 
+  // Catalog epoch (CatalogNameCache) this statement's plan was bound under.
+  // If it still matches the current epoch, no DDL has run since binding and
+  // the plan can be reused without another binder/optimizer pass.
+  inline uint64_t GetBoundCatalogEpoch() const { return bound_catalog_epoch_; }
+
+  inline void SetBoundCatalogEpoch(uint64_t epoch) {
+    bound_catalog_epoch_ = epoch;
+  }
+
+  // Constants that the traffic cop's plan cache stripped out of the query
+  // and replaced with parameter slots. They are handed to the executor as
+  // this statement's parameter values.
+  inline void SetCachedPlanParams(std::vector<type::Value> param_values) {
+    cached_plan_params_ = std::move(param_values);
+  }
+
+  inline const std::vector<type::Value> &GetCachedPlanParams() const {
+    return cached_plan_params_;
+  }
+
+  // Interpreted executor tree the plan executor built for plan_tree_, kept
+  // on the statement so repeated executions reuse it instead of rebuilding
+  // it (see PlanExecutor). The context the tree was built against travels
+  // with it. Dropped whenever the plan tree changes.
+  inline void SetCachedExecutorTree(
+      std::shared_ptr<executor::AbstractExecutor> executor_tree,
+      std::shared_ptr<executor::ExecutorContext> executor_context) {
+    cached_executor_tree_ = std::move(executor_tree);
+    cached_executor_context_ = std::move(executor_context);
+  }
+
+  inline const std::shared_ptr<executor::AbstractExecutor>
+      &GetCachedExecutorTree() const {
+    return cached_executor_tree_;
+  }
+
+  inline const std::shared_ptr<executor::ExecutorContext>
+      &GetCachedExecutorContext() const {
+    return cached_executor_context_;
+  }
+
+  inline void ClearCachedExecutorTree() {
+    cached_executor_tree_.reset();
+    cached_executor_context_.reset();
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -119,7 +170,23 @@ class Statement : public Printable {
   // this may be empty
   std::set<oid_t> table_ids_;
 
+  // constant values extracted when the plan was parameterized by the
+  // traffic cop's plan cache
+  std::vector<type::Value> cached_plan_params_;
+
+  // executor tree built for plan_tree_, reused across executions; the
+  // deleter set by the plan executor tears the whole tree down
+  std::shared_ptr<executor::AbstractExecutor> cached_executor_tree_;
+
+  // context cached_executor_tree_ holds pointers into; Reset() between
+  // executions
+  std::shared_ptr<executor::ExecutorContext> cached_executor_context_;
+
   // If this flag is true, then somebody wants us to replan this query
   bool needs_replan_ = false;
+
+  // catalog epoch read before the plan was bound; compared against the
+  // current epoch to decide whether a flagged replan is actually needed
+  uint64_t bound_catalog_epoch_ = 0;
 };
 }  // namespace peloton
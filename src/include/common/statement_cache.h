@@ -15,15 +15,18 @@
 #include <unordered_map>
 
 #include "common/internal_types.h"
-#include "container/lock_free_queue.h"
 #include "statement.h"
 
 namespace peloton {
 
-#define DEFAULT_STATEMENT_CACHE_INVALID_QUEUE_SIZE 5
+class StatementCacheManager;
 
-// The statement cache that caches statement.
-// It would also mark statement if it need to replan
+// The per-connection level of the two-level statement cache.
+// It caches statements and marks them for replan when the tables they
+// reference are invalidated. Invalidations are pulled lazily from the
+// manager's registry: a hit performs one relaxed atomic version check and
+// needs no synchronization unless a DDL was published since the last look.
+// The cache itself is single-threaded, owned by its connection.
 class StatementCache {
   typedef std::shared_ptr<Statement> StatementPtr;
   typedef std::unordered_map<std::string, StatementPtr> NameMap;
@@ -37,16 +40,22 @@ class StatementCache {
   // entries. This would make table_ref_ not up-to-date.
   NameMap statement_map_;
 
+  // PlanFingerprint -> Statement
+  // Used by the traffic cop's plan cache: queries that differ only in
+  // literal constants share a fingerprint and thus an optimized plan.
+  NameMap fingerprint_map_;
+
   // TableOid -> Statements
   TableRef table_ref_;
 
-  // Queue to receive invalid table oids from executor
-  LockFreeQueue<oid_t> invalid_table_queue_;
+  // The manager whose invalidation registry this cache follows; null while
+  // detached (before registration or after connection teardown)
+  StatementCacheManager *manager_ = nullptr;
 
- public:
-  StatementCache()
-      : invalid_table_queue_(DEFAULT_STATEMENT_CACHE_INVALID_QUEUE_SIZE) {}
+  // Newest registry version this cache has applied
+  uint64_t last_seen_version_ = 0;
 
+ public:
   // Add a statement to the cache
   void AddStatement(std::shared_ptr<Statement> stmt);
 
@@ -56,13 +65,30 @@ class StatementCache {
   // Delete the statement
   void DeleteStatement(std::string name);
 
-  // Notify the Statement Cache a table id that is invalidated
+  // Add a statement under a plan fingerprint, replacing any previous entry
+  void AddFingerprintedStatement(const std::string &fingerprint,
+                                 std::shared_ptr<Statement> stmt);
+
+  // Get the statement cached under a plan fingerprint; nullptr if absent
+  std::shared_ptr<Statement> GetStatementByFingerprint(
+      const std::string &fingerprint);
+
+  // Mark the statements referencing the given table for replan immediately.
+  // Connection-local; cross-connection invalidation flows through the
+  // manager's registry instead.
   void NotifyInvalidTable(oid_t table_id);
 
+  // Follow the given manager's invalidation registry from its current
+  // version onwards; called on connection registration
+  void Attach(StatementCacheManager *manager);
+
+  // Stop observing invalidations; called on connection teardown
+  void Detach();
+
   // Clear the cache
   void Clear();
 
  private:
-  void UpdateFromInvalidTableQueue();
+  void RefreshInvalidations();
 };
 }  // namespace peloton
@@ -12,8 +12,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
 #include "common/statement_cache.h"
-#include "container/cuckoo_map.h"
+#include "common/synchronization/spin_latch.h"
 
 namespace peloton {
 
@@ -23,12 +28,36 @@ class StatementCacheManager;
 static std::shared_ptr<StatementCacheManager> statement_cache_manager;
 
 /**
- * The manager that stores all the registered statement caches.
- * Those registered statement caches would be notify when some
- * table is no longer valid.
+ * The global level of the two-level statement cache.
+ *
+ * Instead of walking every registered per-connection cache on DDL (which
+ * serialized invalidation against connection setup and teardown on a shared
+ * map), the manager maintains an immutable invalidation registry: a
+ * versioned log of invalidated table oids that is copy-on-write swapped on
+ * each DDL. Per-connection caches pull from it lazily -- a cache hit costs
+ * one relaxed atomic version check and touches no shared state unless a DDL
+ * happened since the cache last looked.
  */
 class StatementCacheManager {
  public:
+  /**
+   * An immutable snapshot of the invalidation history. Writers never mutate
+   * a published registry; they swap in a copy with the new entries appended.
+   * Entries older than base_version have been pruned; a cache that has not
+   * caught up past the pruning horizon must conservatively invalidate
+   * everything it holds.
+   */
+  struct InvalidationRegistry {
+    // Version of the newest entry in the log
+    uint64_t version = 0;
+
+    // Entries with version <= base_version have been pruned from the log
+    uint64_t base_version = 0;
+
+    // (version, invalidated table oid), oldest first
+    std::vector<std::pair<uint64_t, oid_t>> entries;
+  };
+
   /**
    * @brief Register a statement cache to this statement manager
    *  Called by protocol handler when building up a connection
@@ -38,26 +67,17 @@ class StatementCacheManager {
 
   /**
    * @brief Remove the statement cache from this statement manager
-   *  Called by protocol handler when tearing down a connection
+   *  Called by protocol handler when tearing down a connection.
+   *  A detached cache no longer observes invalidations.
    * @param stmt_cache the statement cache to be unregister
    */
   void UnRegisterStatementCache(StatementCache *stmt_cache);
 
-
-  /* WARNING:
-   * Be conservative to call the following functions:
-   * InvalidateTableOid()  InvalidateTableOids()
-   * as they would block the whole statement caches map and prevent them 
-   * from register and unregister to the manager. It would therefore block new
-   * connections coming in and old connection tearing down.
-   * However, current connections can still retrieve updated plans from their
-   * plan cache.
-   */
-
   /**
    * @brief Notify the manager that the statements with table id is no longer
-   * valid now
-   * 
+   * valid now. Publishes a new registry snapshot; never blocks readers,
+   * registration or unregistration.
+   *
    * @param table_id The table that is no longer valid
    */
   void InvalidateTableOid(oid_t table_id);
@@ -65,11 +85,21 @@ class StatementCacheManager {
   /**
    * @brief Notify the manager that the statements with table ids is no longer
    * valid now
-   * 
+   *
    * @param table_ids The tables that are no longer valid
    */
   void InvalidateTableOids(std::set<oid_t> &table_ids);
 
+  /** @brief Version of the newest published invalidation; the zero-cost
+   *         check caches perform on every hit */
+  uint64_t GetInvalidationVersion() const {
+    return invalidation_version_.load(std::memory_order_relaxed);
+  }
+
+  /** @brief The current registry snapshot; may be null before the first
+   *         invalidation */
+  std::shared_ptr<const InvalidationRegistry> GetInvalidationRegistry() const;
+
   // TODO (Tianyi) : remove this singleton to peloton instance
   /**
    *  Initialize an statement cache manager instance
@@ -88,10 +118,22 @@ class StatementCacheManager {
   }
 
  private:
-  /**
-   * The registered statement caches
-   */
-  CuckooMap<StatementCache *, StatementCache *> statement_caches_;
+  // Keep at most this many invalidation entries; caches further behind than
+  // the pruning horizon invalidate wholesale
+  static const size_t kMaxRetainedInvalidations = 1024;
+
+  // Append the given oids as one new version and publish the new snapshot
+  void PublishInvalidations(const std::set<oid_t> &table_ids);
+
+  // Serializes writers only; readers go through the atomic snapshot
+  common::synchronization::SpinLatch write_latch_;
+
+  // Hint mirroring registry_->version, readable with a relaxed load. Caches
+  // resynchronize their position from the snapshot itself, so a stale hint
+  // only delays (never loses) invalidation pickup.
+  std::atomic<uint64_t> invalidation_version_{0};
+
+  std::shared_ptr<const InvalidationRegistry> registry_;
 };
 
-}  // namespace peloton
\ No newline at end of file
+}  // namespace peloton
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// distributed_readwrite_latch.h
+//
+// Identification: src/include/common/synchronization/distributed_readwrite_latch.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "common/platform.h"
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+
+//===--------------------------------------------------------------------===//
+// Distributed Read-Write Latch
+//===--------------------------------------------------------------------===//
+
+namespace peloton {
+namespace common {
+namespace synchronization {
+
+// Reader-biased read-write latch for read-mostly shared metadata.
+//
+// Readers mark a per-thread counter slot on its own cache line, so
+// concurrent readers on different threads never write the same line the
+// way they do on a centralized reader count (or on a pthread rwlock's
+// internal state). Writers flip a global bit and then wait for every
+// reader slot to drain. The write path is therefore much more expensive
+// than ReadWriteLatch's; use this only for latches that are read nearly
+// always and written rarely. Each instance carries one cache line per
+// reader slot, so it is also meant for a few hot, long-lived latches,
+// not for per-tuple state.
+class DistributedReadWriteLatch {
+ public:
+  DistributedReadWriteLatch(DistributedReadWriteLatch const &) = delete;
+  DistributedReadWriteLatch &operator=(DistributedReadWriteLatch const &) =
+      delete;
+
+  DistributedReadWriteLatch() {}
+
+  void ReadLock() {
+    auto &slot_count = slots_[ThreadSlot()].count;
+    while (true) {
+      // Publish the read mark first, then check for a writer; the
+      // sequentially consistent RMW orders the mark before the flag load
+      slot_count.fetch_add(1, std::memory_order_seq_cst);
+      if (!writer_present_.load(std::memory_order_seq_cst)) {
+        return;
+      }
+      // A writer is active or draining readers; back off so it does not
+      // wait on us, and retry once it is done
+      slot_count.fetch_sub(1, std::memory_order_seq_cst);
+      uint64_t spins = 0;
+      while (writer_present_.load(std::memory_order_acquire)) {
+        _mm_pause();
+        if ((++spins & kSpinsBeforeYield) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  void ReadUnlock() {
+    slots_[ThreadSlot()].count.fetch_sub(1, std::memory_order_release);
+  }
+
+  void WriteLock() {
+    // Writers serialize among themselves first, then block out new
+    // readers and wait for the marked ones to drain
+    writer_latch_.Lock();
+    writer_present_.store(true, std::memory_order_seq_cst);
+    for (std::size_t slot_itr = 0; slot_itr < kNumSlots; slot_itr++) {
+      uint64_t spins = 0;
+      while (slots_[slot_itr].count.load(std::memory_order_acquire) != 0) {
+        _mm_pause();
+        if ((++spins & kSpinsBeforeYield) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  void WriteUnlock() {
+    writer_present_.store(false, std::memory_order_release);
+    writer_latch_.Unlock();
+  }
+
+ private:
+  // Reader slots; more slots cost memory per latch, fewer raise the odds
+  // of two reader threads sharing a line
+  static const std::size_t kNumSlots = 8;
+
+  // Spin iterations (mask) between yields while waiting
+  static const uint64_t kSpinsBeforeYield = 63;
+
+  struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> count{0};
+  };
+
+  // Stable per-thread slot index; hashed once per thread so a reader's
+  // unlock always hits the slot its lock marked
+  static std::size_t ThreadSlot() {
+    static thread_local const std::size_t thread_slot =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    return thread_slot & (kNumSlots - 1);
+  }
+
+  ReaderSlot slots_[kNumSlots];
+
+  // Set while a writer holds or is acquiring the latch
+  std::atomic<bool> writer_present_{false};
+
+  // Writer-writer exclusion
+  SpinLatch writer_latch_;
+};
+
+}  // namespace synchronization
+}  // namespace common
+}  // namespace peloton
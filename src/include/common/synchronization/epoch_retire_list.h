@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// epoch_retire_list.h
+//
+// Identification: src/include/common/synchronization/epoch_retire_list.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <thread>
+#include <utility>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+
+//===--------------------------------------------------------------------===//
+// Epoch Retire List
+//===--------------------------------------------------------------------===//
+
+namespace peloton {
+namespace common {
+namespace synchronization {
+
+// Reusable epoch-based reclamation: objects that may still be referenced by
+// in-flight readers are retired with the epoch id current at retire time and
+// destroyed only once that epoch has expired (i.e. every reader that could
+// have observed the object has left). Epoch ids come from
+// concurrency::EpochManager; the caller passes them in so this component
+// stays independent of the concurrency layer.
+//
+// Reclamation is by value semantics: destroying the stored GarbageType is
+// what frees the object, so callers park an owning handle (shared_ptr,
+// unique_ptr with a custom deleter, ...) rather than a raw pointer.
+//
+// Retire appends to a shard picked by the calling thread's id, so concurrent
+// retirers do not contend on a single latch; Reclaim sweeps all shards and
+// is expected to run on a background (GC) thread.
+template <typename GarbageType>
+class EpochRetireList {
+ public:
+  EpochRetireList() {}
+
+  EpochRetireList(const EpochRetireList &) = delete;
+  EpochRetireList &operator=(const EpochRetireList &) = delete;
+
+  // Park garbage until retire_eid expires. retire_eid must be the epoch id
+  // current at (or after) the moment the object became unreachable for new
+  // readers.
+  void Retire(GarbageType garbage, const eid_t retire_eid) {
+    auto &shard = shards_[GetShardIndex()];
+    shard.lock.Lock();
+    shard.retired.emplace_back(retire_eid, std::move(garbage));
+    shard.lock.Unlock();
+  }
+
+  // Destroy every entry whose retire epoch is at most expired_eid; returns
+  // the number of entries reclaimed. Entries within a shard are not strictly
+  // epoch-ordered (two threads can interleave between reading the epoch and
+  // appending), so the whole shard is scanned.
+  size_t Reclaim(const eid_t expired_eid) {
+    size_t reclaimed_count = 0;
+    for (size_t shard_itr = 0; shard_itr < SHARD_COUNT; shard_itr++) {
+      auto &shard = shards_[shard_itr];
+      shard.lock.Lock();
+      auto itr = shard.retired.begin();
+      while (itr != shard.retired.end()) {
+        if (itr->first <= expired_eid) {
+          itr = shard.retired.erase(itr);
+          reclaimed_count++;
+        } else {
+          itr++;
+        }
+      }
+      shard.lock.Unlock();
+    }
+    return reclaimed_count;
+  }
+
+  // Destroy everything regardless of epoch; only safe once no reader can
+  // hold a reference (e.g. shutdown)
+  size_t ReclaimAll() { return Reclaim(MAX_EID); }
+
+  bool IsEmpty() {
+    for (size_t shard_itr = 0; shard_itr < SHARD_COUNT; shard_itr++) {
+      auto &shard = shards_[shard_itr];
+      shard.lock.Lock();
+      bool empty = shard.retired.empty();
+      shard.lock.Unlock();
+      if (empty == false) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static const size_t SHARD_COUNT = 16;
+
+  struct Shard {
+    SpinLatch lock;
+    std::list<std::pair<eid_t, GarbageType>> retired;
+  };
+
+  size_t GetShardIndex() const {
+    return std::hash<std::thread::id>()(std::this_thread::get_id()) %
+           SHARD_COUNT;
+  }
+
+  Shard shards_[SHARD_COUNT];
+};
+
+}  // namespace synchronization
+}  // namespace common
+}  // namespace peloton
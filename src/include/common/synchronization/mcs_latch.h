@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// mcs_latch.h
+//
+// Identification: src/include/common/synchronization/mcs_latch.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+
+//===--------------------------------------------------------------------===//
+// Queued (MCS) Latch
+//===--------------------------------------------------------------------===//
+
+namespace peloton {
+namespace common {
+namespace synchronization {
+
+// Per-acquirer queue node. It lives on the acquirer's stack (see
+// ScopedMcsLatch), so every waiter spins on its own cache line instead of
+// all of them bouncing the latch word between cores the way a
+// test-and-set spinner does.
+struct alignas(64) McsQueueNode {
+  std::atomic<McsQueueNode *> next{nullptr};
+  std::atomic<bool> ready{false};
+};
+
+class McsLatch {
+ public:
+  McsLatch(McsLatch const &) = delete;
+  McsLatch &operator=(McsLatch const &) = delete;
+
+  // name labels this latch in the contention report published by the
+  // stats aggregator. Only latches with static storage duration should be
+  // named: registered latches are never unregistered. Unnamed latches are
+  // not registered and only pay for their own counters.
+  explicit McsLatch(const char *name = nullptr) : name_(name) {
+    if (name_ != nullptr) {
+      Registry().Register(this);
+    }
+  }
+
+  void Lock(McsQueueNode &node) {
+    node.next.store(nullptr, std::memory_order_relaxed);
+    node.ready.store(false, std::memory_order_relaxed);
+
+    McsQueueNode *predecessor =
+        tail_.exchange(&node, std::memory_order_acq_rel);
+    uint64_t spins = 0;
+    if (predecessor != nullptr) {
+      // Enqueue behind the predecessor, then spin locally until it hands
+      // the latch over
+      predecessor->next.store(&node, std::memory_order_release);
+      while (!node.ready.load(std::memory_order_acquire)) {
+        _mm_pause();
+        spins++;
+        // The handover is FIFO, so if the predecessor was preempted no
+        // amount of spinning helps; yield periodically to let it run
+        if ((spins & kSpinsBeforeYield) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    acquisition_count_.fetch_add(1, std::memory_order_relaxed);
+    if (spins > 0) {
+      contended_count_.fetch_add(1, std::memory_order_relaxed);
+      spin_cycle_count_.fetch_add(spins, std::memory_order_relaxed);
+    }
+  }
+
+  bool TryLock(McsQueueNode &node) {
+    node.next.store(nullptr, std::memory_order_relaxed);
+    node.ready.store(false, std::memory_order_relaxed);
+
+    McsQueueNode *expected = nullptr;
+    if (!tail_.compare_exchange_strong(expected, &node,
+                                       std::memory_order_acq_rel)) {
+      return false;
+    }
+    acquisition_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void Unlock(McsQueueNode &node) {
+    McsQueueNode *successor = node.next.load(std::memory_order_acquire);
+    if (successor == nullptr) {
+      // No known successor; try to swing the tail back to empty
+      McsQueueNode *expected = &node;
+      if (tail_.compare_exchange_strong(expected, nullptr,
+                                        std::memory_order_acq_rel)) {
+        return;
+      }
+      // A successor is between its tail exchange and its next store;
+      // wait for the link to appear
+      uint64_t spins = 0;
+      while ((successor = node.next.load(std::memory_order_acquire)) ==
+             nullptr) {
+        _mm_pause();
+        if ((++spins & kSpinsBeforeYield) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    successor->ready.store(true, std::memory_order_release);
+  }
+
+  bool IsLocked() const {
+    return tail_.load(std::memory_order_acquire) != nullptr;
+  }
+
+  const char *GetName() const { return name_; }
+
+  uint64_t GetAcquisitionCount() const {
+    return acquisition_count_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetContendedCount() const {
+    return contended_count_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetSpinCycleCount() const {
+    return spin_cycle_count_.load(std::memory_order_relaxed);
+  }
+
+  // Contention report over every named latch, one metric line per
+  // counter in the flat label format the metrics export endpoint uses
+  static std::string GetStatsInfo() {
+    std::stringstream ss;
+    auto &registry = Registry();
+    registry.latch_.Lock();
+    for (auto *latch : registry.latches_) {
+      std::string labels = "{latch=\"" + std::string(latch->GetName()) + "\"}";
+      ss << "latch_acquisitions" << labels << " "
+         << latch->GetAcquisitionCount() << "\n";
+      ss << "latch_contended_acquisitions" << labels << " "
+         << latch->GetContendedCount() << "\n";
+      ss << "latch_spin_cycles" << labels << " "
+         << latch->GetSpinCycleCount() << "\n";
+    }
+    registry.latch_.Unlock();
+    return ss.str();
+  }
+
+ private:
+  // Spin iterations (mask) between yields while waiting
+  static const uint64_t kSpinsBeforeYield = 63;
+
+  struct LatchRegistry {
+    void Register(McsLatch *registered_latch) {
+      latch_.Lock();
+      latches_.push_back(registered_latch);
+      latch_.Unlock();
+    }
+
+    std::vector<McsLatch *> latches_;
+    SpinLatch latch_;
+  };
+
+  static LatchRegistry &Registry() {
+    static LatchRegistry registry;
+    return registry;
+  }
+
+  // Tail of the waiter queue; null when the latch is free
+  std::atomic<McsQueueNode *> tail_{nullptr};
+
+  const char *name_;
+
+  std::atomic<uint64_t> acquisition_count_{0};
+  std::atomic<uint64_t> contended_count_{0};
+  std::atomic<uint64_t> spin_cycle_count_{0};
+};
+
+// RAII guard carrying the queue node on the caller's stack for the
+// duration of the critical section
+class ScopedMcsLatch {
+ public:
+  ScopedMcsLatch(ScopedMcsLatch const &) = delete;
+  ScopedMcsLatch &operator=(ScopedMcsLatch const &) = delete;
+
+  explicit ScopedMcsLatch(McsLatch &latch) : latch_(latch) {
+    latch_.Lock(node_);
+  }
+
+  ~ScopedMcsLatch() { latch_.Unlock(node_); }
+
+ private:
+  McsLatch &latch_;
+  McsQueueNode node_;
+};
+
+}  // namespace synchronization
+}  // namespace common
+}  // namespace peloton
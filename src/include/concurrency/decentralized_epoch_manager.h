@@ -32,10 +32,12 @@ class DecentralizedEpochManager : public EpochManager {
   DecentralizedEpochManager(const DecentralizedEpochManager&) = delete;
 
 public:
-  DecentralizedEpochManager() : 
-    current_global_epoch_id_(1), 
+  DecentralizedEpochManager() :
+    current_global_epoch_id_(1),
     next_txn_id_(0),
+    txn_id_generation_(0),
     snapshot_global_epoch_id_(1),
+    published_watermark_(0),
     is_running_(false) {
       // register a default thread for handling catalog stuffs.
       RegisterThread(0);
@@ -55,15 +57,19 @@ public:
     PL_ASSERT(current_epoch_id != 0);
     current_global_epoch_id_ = current_epoch_id;
     next_txn_id_ = 0;
+    // invalidate the transaction id batches cached by the worker threads.
+    txn_id_generation_.fetch_add(1);
     snapshot_global_epoch_id_ = 1;
+    published_watermark_ = 0;
     local_epochs_.clear();
-    
+
     RegisterThread(0);
   }
 
   virtual void SetCurrentEpochId(const uint64_t current_epoch_id) override {
     current_global_epoch_id_ = current_epoch_id;
     next_txn_id_ = 0;
+    txn_id_generation_.fetch_add(1);
   }
 
   virtual void StartEpoch(std::unique_ptr<std::thread> &epoch_thread) override {
@@ -124,8 +130,36 @@ public:
 private:
 
 
-  inline uint32_t GetNextTransactionId() {
-    return next_txn_id_.fetch_add(1, std::memory_order_relaxed);
+  inline uint32_t GetNextTransactionId(const eid_t epoch_id) {
+    // every transaction used to bump the shared counter, which turns the
+    // counter's cache line into a ping-pong target at high core counts.
+    // instead, each worker reserves a batch of ids with a single fetch_add
+    // and hands them out locally. the generation tag invalidates cached
+    // batches whenever the counter is reset.
+    //
+    // epoch-boundary reconciliation: a leased batch is only valid within
+    // the epoch it was taken in. once the global epoch advances, the
+    // remainder of the batch is discarded and a fresh one is leased, so
+    // the low word of a commit timestamp always stems from a lease taken
+    // in its own epoch. this bounds the skew between timestamp order and
+    // arrival order to one batch within a single epoch, while the shared
+    // counter stays monotonic so ids remain globally unique.
+    static thread_local uint32_t cached_txn_id = 0;
+    static thread_local uint32_t cached_txn_id_count = 0;
+    static thread_local uint64_t cached_generation = UINT64_MAX;
+    static thread_local eid_t cached_lease_epoch_id = INVALID_EID;
+
+    uint64_t generation = txn_id_generation_.load(std::memory_order_acquire);
+    if (cached_txn_id_count == 0 || cached_generation != generation ||
+        cached_lease_epoch_id != epoch_id) {
+      cached_txn_id =
+          next_txn_id_.fetch_add(kTxnIdBatchSize, std::memory_order_relaxed);
+      cached_txn_id_count = kTxnIdBatchSize;
+      cached_generation = generation;
+      cached_lease_epoch_id = epoch_id;
+    }
+    cached_txn_id_count--;
+    return cached_txn_id++;
   }
 
 
@@ -142,6 +176,10 @@ private:
 
 private:
 
+  // number of transaction ids a worker reserves per fetch_add on the
+  // shared counter.
+  static const uint32_t kTxnIdBatchSize = 32;
+
   // each thread holds a pointer to a local epoch.
   // it updates the local epoch to report their local time.
   common::synchronization::SpinLatch local_epoch_lock_;
@@ -150,11 +188,20 @@ private:
   // the global epoch reflects the true time of the system.
   std::atomic<eid_t> current_global_epoch_id_;
   std::atomic<uint32_t> next_txn_id_;
+
+  // bumped whenever next_txn_id_ is reset so that batches of transaction
+  // ids cached by worker threads are discarded.
+  std::atomic<uint64_t> txn_id_generation_;
   
   // snapshot epoch is an epoch where the corresponding tuples may be still
   // visible to on-the-fly transactions
   eid_t snapshot_global_epoch_id_;
 
+  // the latest reclamation watermark this manager computed. a thread
+  // unparking its local epoch checks its entered epoch against this value,
+  // since the reducer does not visit parked threads.
+  std::atomic<eid_t> published_watermark_;
+
   bool is_running_;
 
 };
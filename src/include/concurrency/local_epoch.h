@@ -13,14 +13,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <queue>
 #include <vector>
 #include <unordered_map>
 #include <functional>
 #include <cstdint>
+#include <cstdlib>
+#include <new>
 
 #include "common/internal_types.h"
+#include "common/platform.h"
 #include "common/synchronization/spin_latch.h"
 
 namespace peloton {
@@ -46,26 +50,80 @@ struct EpochCompare {
   }
 };
 
-class LocalEpoch {
+// each local epoch is aligned to its own cache line so that one thread's
+// epoch traffic never invalidates the line another thread spins on.
+//
+// idle-thread parking: a lower bound of UINT64_MAX marks a parked thread,
+// the same state a freshly registered thread starts in. a local epoch
+// parks itself the moment its last transaction exits, so the epoch
+// reducer can skip idle threads entirely instead of latching and
+// re-arming each of them on every pass -- an idle connection then never
+// holds back the reclamation horizon. the next transaction unparks the
+// thread by entering normally; the epoch manager validates that entry
+// against the published reclamation watermark.
+class CACHE_ALIGNED LocalEpoch {
 
 public:
-  LocalEpoch(const size_t thread_id) : 
-    epoch_id_lower_bound_(UINT64_MAX), 
+  LocalEpoch(const size_t thread_id) :
+    epoch_id_lower_bound_(UINT64_MAX),
+    published_lower_bound_(UINT64_MAX),
     thread_id_(thread_id) {}
 
-  bool EnterEpoch(const eid_t epoch_id, const TimestampType ts_type);
+  // plain new does not honor the class's cache-line alignment before
+  // C++17 (and gcc warns about it), so heap allocations over-align
+  // explicitly; local epochs are only ever allocated with new
+  static void *operator new(size_t size) {
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, CACHELINE_SIZE, size) != 0) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  static void operator delete(void *ptr) { free(ptr); }
+
+  // was_parked reports whether this entry unparked the thread, so the
+  // caller can validate the entered epoch against the reclamation
+  // watermark the reducer may have advanced past this thread.
+  bool EnterEpoch(const eid_t epoch_id, const TimestampType ts_type,
+                  bool &was_parked);
+
+  inline bool EnterEpoch(const eid_t epoch_id, const TimestampType ts_type) {
+    bool was_parked = false;
+    return EnterEpoch(epoch_id, ts_type, was_parked);
+  }
 
   void ExitEpoch(const eid_t epoch_id);
-  
+
+  // returns UINT64_MAX when the thread is (or just became) parked, in
+  // which case it does not constrain the reclamation horizon.
   uint64_t GetExpiredEpochId(const uint64_t current_epoch_id);
 
+  // read this thread's last published lower bound without taking the latch.
+  // the epoch reducer uses it to skip parked threads and threads that have
+  // already caught up with the current global epoch.
+  inline uint64_t GetPublishedLowerBound() const {
+    return published_lower_bound_.load();
+  }
+
 private:
+  // sequentially consistent on purpose: the unpark handshake relies on
+  // either the reducer observing the unparking thread's published bound or
+  // the unparking thread observing the reducer's published watermark.
+  inline void PublishLowerBound() {
+    published_lower_bound_.store(epoch_id_lower_bound_);
+  }
+
   common::synchronization::SpinLatch epoch_lock_;
-  
+
   uint64_t epoch_id_lower_bound_;
 
+  // mirror of epoch_id_lower_bound_, updated under the latch but readable
+  // without it.
+  std::atomic<uint64_t> published_lower_bound_;
+
   size_t thread_id_;
-  
+
   std::priority_queue<std::shared_ptr<Epoch>, std::vector<std::shared_ptr<Epoch>>, EpochCompare> epoch_queue_;
   std::unordered_map<uint64_t, std::shared_ptr<Epoch>> epoch_map_;
 };
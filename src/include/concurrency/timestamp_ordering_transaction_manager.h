@@ -101,6 +101,12 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual ResultType AbortTransaction(TransactionContext *const current_txn);
 
+  // Undo only the writes recorded after the named savepoint -- the abort
+  // processing applied to a suffix of the read/write set -- and leave the
+  // transaction running
+  virtual bool RollbackToSavepoint(TransactionContext *const current_txn,
+                                   const std::string &name);
+
 
 private:
   static const int LOCK_OFFSET = 0;
@@ -124,6 +130,15 @@ private:
   void InitTupleReserved(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t tuple_id);
+
+  // Physically undo one read/write set entry during partial rollback.
+  // restored_type is the type the entry reverts to -- which decides
+  // whether ownership is kept -- or RWType::INVALID when the entry is
+  // dropped outright.
+  void RollbackTupleEntry(TransactionContext *const current_txn,
+                          const oid_t &tile_group_id, const oid_t &tuple_slot,
+                          const RWType current_type,
+                          const RWType restored_type);
 };
 }
 }
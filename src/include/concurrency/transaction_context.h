@@ -49,6 +49,24 @@ class TransactionContext : public Printable {
 
   ~TransactionContext();
 
+  // Obtain a context from the thread-cached recycling pool, falling back to
+  // heap allocation when the pool is empty. Recycled contexts keep the
+  // capacity of their internal containers, so steady-state transaction
+  // processing performs no per-transaction allocation for the context itself.
+  static TransactionContext *GetInstance(const size_t thread_id,
+                                         const IsolationLevelType isolation,
+                                         const cid_t &read_id);
+
+  static TransactionContext *GetInstance(const size_t thread_id,
+                                         const IsolationLevelType isolation,
+                                         const cid_t &read_id,
+                                         const cid_t &commit_id);
+
+  // Return a context to the recycling pool once no component holds a
+  // reference to it anymore. Clears the transaction-private state but keeps
+  // the underlying container memory for reuse.
+  static void RecycleInstance(TransactionContext *txn);
+
  private:
   void Init(const size_t thread_id, const IsolationLevelType isolation,
             const cid_t &read_id) {
@@ -111,6 +129,63 @@ class TransactionContext : public Printable {
 
   RWType GetRWType(const ItemPointer &);
 
+  //===--------------------------------------------------------------------===//
+  // Savepoints
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * @brief A mark in the transaction's append-only read/write set.
+   *
+   * Rollback to the mark drops every entry recorded after it and restores
+   * the type of entries that were retyped in place (e.g. a pre-mark READ
+   * upgraded to UPDATE), so only the suffix of the transaction is undone.
+   */
+  struct Savepoint {
+    std::string name;
+
+    // Per-tile-group entry counts when the mark was taken; tile groups
+    // absent here were first touched after it
+    std::unordered_map<oid_t, size_t> bucket_sizes;
+
+    // In-place type changes after the mark, in the order they happened:
+    // the entry's location and the type to restore
+    std::vector<std::pair<ItemPointer, RWType>> retyped;
+
+    // Length of the compact write list when the mark was taken
+    size_t write_set_size;
+
+    size_t insert_count;
+    bool is_written;
+  };
+
+  // Mark the current extent of the read/write set under the given name
+  void SetSavepoint(const std::string &name);
+
+  // Index of the most recent savepoint with the given name, or -1
+  int64_t FindSavepoint(const std::string &name) const;
+
+  // Drop the named savepoint and every one set after it, folding their
+  // retype logs into the enclosing savepoint so an outer rollback still
+  // sees them. Returns false if the name is unknown.
+  bool ReleaseSavepoint(const std::string &name);
+
+  const std::vector<Savepoint> &GetSavepoints() const { return savepoints_; }
+
+  // Restore the recorded type of an existing entry; used by the
+  // transaction manager while processing a partial rollback
+  void RestoreRWType(const ItemPointer &location, RWType type) {
+    rw_set_.at(location.block).at(location.offset) = type;
+  }
+
+  /**
+   * @brief Truncate the read/write set back to the given savepoint,
+   * restore the counters taken with it, and pop every savepoint above it
+   * (the mark itself survives, as SQL ROLLBACK TO SAVEPOINT requires).
+   * Physical undo of the dropped entries is the transaction manager's job
+   * and must happen before this is called.
+   */
+  void TruncateToSavepoint(size_t savepoint_index);
+
   void AddOnCommitTrigger(trigger::TriggerData &trigger_data);
 
   void ExecOnCommitTriggers();
@@ -129,6 +204,13 @@ class TransactionContext : public Printable {
   }
 
   inline const ReadWriteSet &GetReadWriteSet() { return rw_set_; }
+
+  // The compact write list: the location of every entry that performed a
+  // physical write (took ownership, installed a version or inserted a
+  // tuple), in recording order. Abort undoes exactly these entries instead
+  // of scanning the full read/write set.
+  inline const std::vector<ItemPointer> &GetWriteSet() { return write_set_; }
+
   inline const CreateDropSet &GetCreateDropSet() { return rw_object_set_; }
 
   inline std::shared_ptr<GCSet> GetGCSetPtr() { return gc_set_; }
@@ -192,9 +274,32 @@ class TransactionContext : public Printable {
   // timestamp when the transaction began
   uint64_t timestamp_;
 
+  // Record an in-place retype so rollback to a savepoint can restore it;
+  // free when no savepoint is set
+  inline void LogSavepointRetype(const ItemPointer &location, RWType type) {
+    if (!savepoints_.empty()) {
+      savepoints_.back().retyped.emplace_back(location, type);
+    }
+  }
+
+  // Append a location to the compact write list. Called exactly once per
+  // entry, when it first transitions from absent or plain READ to a type
+  // that leaves a physical trace; in-place retypes between write types
+  // (e.g. UPDATE -> DELETE) do not append again
+  inline void LogWrite(const ItemPointer &location) {
+    write_set_.push_back(location);
+  }
+
   ReadWriteSet rw_set_;
+
+  // Locations of the write entries in rw_set_, in recording order
+  std::vector<ItemPointer> write_set_;
+
   CreateDropSet rw_object_set_;
 
+  // Active savepoints, innermost last
+  std::vector<Savepoint> savepoints_;
+
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<GCSet> gc_set_;
   std::shared_ptr<GCObjectSet> gc_object_set_;
@@ -65,6 +65,32 @@ class TransactionManager {
       const oid_t &tuple_id,
       const VisibilityIdType type = VisibilityIdType::READ_ID);
 
+  // Batched visibility kernel for scans: sets one bit in visibility_bitmap
+  // (little-endian, 64 slots per word, bit i for slot start_slot + i) for
+  // every slot in [start_slot, end_slot) whose visibility is
+  // VisibilityType::OK. The common case -- a committed version owned by no
+  // transaction -- reduces to two timestamp compares against the reader's
+  // snapshot with the per-tuple invariants hoisted out of the loop; owned
+  // or uncommitted slots fall back to
+  // IsVisible for the exact protocol semantics. Scans that only need to
+  // qualify tuples (not distinguish deleted from aborted versions) should
+  // prefer this over per-tuple IsVisible calls.
+  void IsVisibleBatch(
+      TransactionContext *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t start_slot, const oid_t end_slot,
+      uint64_t *visibility_bitmap);
+
+  // Cooperative version chain pruning, called by readers while traversing a
+  // version chain. If the version behind the given one is already invisible
+  // to every active transaction (its end timestamp lies below the epoch
+  // low-watermark), the chain pointer is CASed to bypass it, bounding chain
+  // lengths on hot rows between background GC cycles. The bypassed version
+  // itself is still reclaimed by the GC manager as usual.
+  void PruneVersionChain(
+      const storage::TileGroupHeader *const tile_group_header,
+      const ItemPointer &location);
+
   // This method test whether the current transaction is the owner of this version.
   virtual bool IsOwner(
       TransactionContext *const current_txn,
@@ -143,6 +169,22 @@ class TransactionManager {
 
   virtual ResultType AbortTransaction(TransactionContext *const current_txn) = 0;
 
+  /**
+   * Roll the transaction back to a savepoint set earlier through
+   * TransactionContext::SetSavepoint, undoing only the writes recorded
+   * after it; the transaction stays alive and can continue. Protocols that
+   * cannot undo a suffix of the write set keep this default, which refuses
+   * and leaves the transaction untouched.
+   *
+   * @return true on success, false if the savepoint does not exist or the
+   * protocol does not support partial rollback.
+   */
+  virtual bool RollbackToSavepoint(
+      UNUSED_ATTRIBUTE TransactionContext *const current_txn,
+      UNUSED_ATTRIBUTE const std::string &name) {
+    return false;
+  }
+
   // this function generates the maximum commit id of committed transactions.
   // please note that this function only returns a "safe" value instead of a
   // precise value.
@@ -41,6 +41,8 @@ class AbstractExecutor {
 
   bool Execute();
 
+  void Reset();
+
   //===--------------------------------------------------------------------===//
   // Children + Parent Helpers
   //===--------------------------------------------------------------------===//
@@ -48,6 +48,10 @@ class AbstractJoinExecutor : public AbstractExecutor {
         return "JoinType::INNER";
       case JoinType::OUTER:
         return "JoinType::OUTER";
+      case JoinType::SEMI:
+        return "JoinType::SEMI";
+      case JoinType::ANTI:
+        return "JoinType::ANTI";
       case JoinType::INVALID:
       default:
         return "JoinType::INVALID";
@@ -137,6 +141,8 @@ class AbstractJoinExecutor : public AbstractExecutor {
     switch (join_type_) {
       case JoinType::LEFT:
       case JoinType::OUTER:
+      case JoinType::SEMI:
+      case JoinType::ANTI:
         no_matching_left_row_sets_[tile_idx].erase(row_idx);
         break;
       default:
@@ -144,6 +150,15 @@ class AbstractJoinExecutor : public AbstractExecutor {
     }
   }
 
+  /**
+   * Check whether a left row has been matched before. Semi joins use this
+   * to emit each left row at most once, anti joins to emit only the
+   * left rows that never matched
+   */
+  inline bool IsLeftRowMatched(size_t tile_idx, oid_t row_idx) const {
+    return no_matching_left_row_sets_[tile_idx].count(row_idx) == 0;
+  }
+
   /**
    * Record a matched right row, which should not be constructed
    * when building join outputs
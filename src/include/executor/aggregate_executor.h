@@ -14,16 +14,23 @@
 
 #include "executor/abstract_executor.h"
 
+#include <memory>
 #include <vector>
 
 namespace peloton {
 
+namespace planner {
+class AggregatePlan;
+}
+
 namespace storage {
 class DataTable;
 }
 
 namespace executor {
 
+class AbstractAggregator;
+
 /**
  * The actual executor class templated on the type of aggregation that
  * should be performed.
@@ -57,6 +64,28 @@ class AggregateExecutor : public AbstractExecutor {
 
   bool DExecute();
 
+  /** @brief Aggregate the buffered input tiles into per-worker hash tables
+   *         on the thread pool and merge the partial tables. Returns the
+   *         merged aggregator, or nullptr if a worker failed. */
+  AbstractAggregator *ParallelHashAggregate(
+      std::vector<std::unique_ptr<LogicalTile>> &input_tiles);
+
+  /** @brief Try to answer a global MIN/MAX over a bare seq scan from the
+   *         zone map catalog, scanning rows only in the mutable tail and in
+   *         tile groups whose zone map bounds could still change the answer.
+   *         On success the result row is already in output_table and the
+   *         child executor is never pulled. Returns false (leaving no state
+   *         behind) when the plan shape or coverage does not allow it. */
+  bool TryZoneMapMinMax(const planner::AggregatePlan &node);
+
+  /** @brief Try to answer a global COUNT(DISTINCT col) over a bare seq
+   *         scan by walking a BWTree index that leads with col: entries
+   *         come back in key order, so duplicate runs collapse with one
+   *         comparison per entry and only run boundaries reach the
+   *         aggregator's distinct set. Returns false (leaving no state
+   *         behind) when the plan shape or the indexes do not allow it. */
+  bool TryIndexDistinctCount(const planner::AggregatePlan &node);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
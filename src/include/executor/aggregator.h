@@ -12,12 +12,16 @@
 
 #pragma once
 
+#include <cstdio>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/container_tuple.h"
 #include "executor/abstract_executor.h"
 #include "planner/aggregate_plan.h"
+#include "type/decimal128.h"
 #include "type/value_factory.h"
 #include "type/value_peeker.h"
 
@@ -31,8 +35,14 @@ namespace storage {
 class AbstractTable;
 }
 
+namespace type {
+class QueryMemoryTracker;
+}
+
 namespace executor {
 
+class DistinctSpillArena;
+
 /*
  * Base class for an individual aggregate that aggregates a specific
  * column for a group
@@ -43,25 +53,68 @@ class AbstractAttributeAggregator {
 
   void SetDistinct(bool distinct) { is_distinct_ = distinct; }
 
+  /** Attach the spill arena shared by this aggregation's DISTINCT
+   *  aggregates; buffered distinct values then count against the arena's
+   *  budget and are spilled as hash-partitioned runs when it is exceeded */
+  void SetDistinctSpillArena(std::shared_ptr<DistinctSpillArena> arena);
+
   void Advance(const type::Value val);
   type::Value Finalize();
 
+  /** Fold the partial state of another aggregator of the same type into
+   *  this one; used when merging per-worker aggregation tables */
+  void Merge(const AbstractAttributeAggregator &other);
+
   virtual void DAdvance(const type::Value &val) = 0;
   virtual type::Value DFinalize() = 0;
+  virtual void DMerge(const AbstractAttributeAggregator &other) = 0;
 
  private:
   typedef std::unordered_set<type::Value, type::Value::hash,
                              type::Value::equal_to>
       DistinctSetType;
 
+  // Number of hash partitions a spilled distinct set is split into. Each
+  // partition is re-deduplicated on its own at finalize time, so peak
+  // memory is bounded by the largest partition's distinct cardinality
+  // rather than the whole value set
+  static const size_t kDistinctPartitions = 16;
+
+  // One spilled partition: 'count' serialized values at 'file_offset'
+  struct DistinctRun {
+    size_t partition;
+    size_t file_offset;
+    size_t length;
+    size_t count;
+  };
+
+  /** Approximate in-memory footprint of a buffered distinct value */
+  static size_t DistinctValueBytes(const type::Value &val);
+
+  /** Serialize the buffered distinct set to the arena as one run per
+   *  hash partition and drop it from memory; returns the bytes freed */
+  size_t SpillDistinctSet();
+
+  /** Deserialize a spilled run's values into the given set */
+  void ReadRunInto(const DistinctRun &run, DistinctSetType &set) const;
+
   DistinctSetType distinct_set_;
 
   bool is_distinct_ = false;
+
+  /** Shared spill bookkeeping; null when spilling is not wired up */
+  std::shared_ptr<DistinctSpillArena> spill_arena_;
+
+  /** Bytes of distinct_set_ currently accounted with the arena */
+  size_t distinct_buffered_bytes_ = 0;
+
+  /** Partition runs this aggregator has spilled so far */
+  std::vector<DistinctRun> distinct_runs_;
 };
 
 class SumAggregator : public AbstractAttributeAggregator {
  public:
-  SumAggregator() : have_advanced(false) {
+  SumAggregator() : have_advanced(false), exact(false) {
     // aggregate initialized on first advance
   }
 
@@ -69,6 +122,16 @@ class SumAggregator : public AbstractAttributeAggregator {
     if (val.IsNull()) {
       return;
     }
+    // DECIMAL sums accumulate in 128-bit fixed point: integer adds are
+    // associative, so the running sum picks up no floating-point drift and
+    // partial sums merge exactly
+    if (val.GetTypeId() == type::TypeId::DECIMAL) {
+      exact_sum.Add(
+          type::Decimal128::FromDouble(type::ValuePeeker::PeekDouble(val)));
+      exact = true;
+      have_advanced = true;
+      return;
+    }
     if (!have_advanced) {
       aggregate = val.Copy();
       have_advanced = true;
@@ -80,13 +143,33 @@ class SumAggregator : public AbstractAttributeAggregator {
   type::Value DFinalize() {
     if (!have_advanced)
       return type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER);
+    if (exact) return type::ValueFactory::GetDecimalValue(exact_sum.ToDouble());
     return aggregate;
   }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    const auto &other_sum = static_cast<const SumAggregator &>(other);
+    if (!other_sum.have_advanced) return;
+    if (other_sum.exact) {
+      exact_sum.Add(other_sum.exact_sum);
+      exact = true;
+      have_advanced = true;
+    } else {
+      DAdvance(other_sum.aggregate);
+    }
+  }
+
  private:
   type::Value aggregate;
 
+  // Fixed-point accumulator for DECIMAL inputs
+  type::Decimal128 exact_sum;
+
   bool have_advanced;
+
+  // True once a DECIMAL value has been folded in; a SUM input column has
+  // one type, so the two accumulators never mix
+  bool exact;
 };
 
 class AvgAggregator : public AbstractAttributeAggregator {
@@ -130,6 +213,19 @@ class AvgAggregator : public AbstractAttributeAggregator {
     return final_result;
   }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    const auto &other_avg = static_cast<const AvgAggregator &>(other);
+    if (other_avg.count == 0) {
+      return;
+    }
+    if (count == 0) {
+      aggregate = other_avg.aggregate.Copy();
+    } else {
+      aggregate = aggregate.Add(other_avg.aggregate);
+    }
+    count += other_avg.count;
+  }
+
  private:
   /** @brief aggregate initialized on first advance. */
   type::Value aggregate;
@@ -157,6 +253,10 @@ class CountAggregator : public AbstractAttributeAggregator {
 
   type::Value DFinalize() { return type::ValueFactory::GetBigIntValue(count); }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    count += static_cast<const CountAggregator &>(other).count;
+  }
+
  private:
   int64_t count;
 };
@@ -169,6 +269,10 @@ class CountStarAggregator : public AbstractAttributeAggregator {
 
   type::Value DFinalize() { return type::ValueFactory::GetBigIntValue(count); }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    count += static_cast<const CountStarAggregator &>(other).count;
+  }
+
  private:
   int64_t count;
 };
@@ -193,6 +297,11 @@ class MaxAggregator : public AbstractAttributeAggregator {
 
   type::Value DFinalize() { return aggregate; }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    const auto &other_max = static_cast<const MaxAggregator &>(other);
+    if (other_max.have_advanced) DAdvance(other_max.aggregate);
+  }
+
  private:
   type::Value aggregate;
 
@@ -220,6 +329,11 @@ class MinAggregator : public AbstractAttributeAggregator {
 
   type::Value DFinalize() { return aggregate; }
 
+  void DMerge(const AbstractAttributeAggregator &other) {
+    const auto &other_min = static_cast<const MinAggregator &>(other);
+    if (other_min.have_advanced) DAdvance(other_min.aggregate);
+  }
+
  private:
   type::Value aggregate;
 
@@ -230,6 +344,54 @@ class MinAggregator : public AbstractAttributeAggregator {
 AbstractAttributeAggregator *GetAttributeAggregatorInstance(
     ExpressionType agg_type);
 
+/*
+ * Shared spill bookkeeping for the DISTINCT aggregates of one aggregation.
+ *
+ * Every distinct value set accounts its buffered bytes here against the
+ * agg_distinct_spill_budget_mb setting, and all spilled partition runs
+ * share one temp file. Buffered bytes are also charged to the query
+ * memory tracker, so distinct state shows up in the query-wide budget.
+ * Attribute aggregators keep the arena alive through a shared_ptr because
+ * merging per-worker hash tables can adopt aggregators (and with them
+ * spilled runs) that outlive the worker aggregator they were built by.
+ */
+class DistinctSpillArena {
+ public:
+  explicit DistinctSpillArena(type::QueryMemoryTracker *tracker);
+  ~DistinctSpillArena();
+
+  /** Account newly buffered distinct bytes; returns true when the total
+   *  is over budget and the caller should spill its buffered values */
+  bool Consume(size_t bytes);
+
+  void Release(size_t bytes);
+
+  /** Append one serialized partition run; false when the temp file cannot
+   *  be created or written, in which case callers keep their values
+   *  buffered in memory */
+  bool AppendRun(const char *data, size_t length, size_t &file_offset);
+
+  bool ReadRun(size_t file_offset, size_t length, char *buffer) const;
+
+ private:
+  /** Query-wide memory tracker (not owned, may be null) */
+  type::QueryMemoryTracker *tracker_;
+
+  /** Backing temp file for all spilled runs, opened on first spill */
+  FILE *spill_file_ = nullptr;
+
+  size_t spill_file_size_ = 0;
+
+  /** Bytes currently buffered across all attached aggregators */
+  size_t buffered_bytes_ = 0;
+
+  /** Spill threshold in bytes; 0 disables budget-triggered spilling */
+  size_t budget_bytes_ = 0;
+
+  /** Set on the first temp file failure; disables further spilling */
+  bool spill_failed_ = false;
+};
+
 /*
  * Interface for an aggregator (not an an individual attribute aggregate)
  *
@@ -250,6 +412,10 @@ class AbstractAggregator {
   virtual ~AbstractAggregator() {}
 
  protected:
+  /** Lazily created spill bookkeeping shared by this aggregation's
+   *  DISTINCT aggregates */
+  std::shared_ptr<DistinctSpillArena> GetDistinctSpillArena();
+
   /** @brief Plan node */
   const planner::AggregatePlan *node;
 
@@ -258,6 +424,9 @@ class AbstractAggregator {
 
   /** @brief Executor Context */
   executor::ExecutorContext *executor_context = nullptr;
+
+ private:
+  std::shared_ptr<DistinctSpillArena> distinct_spill_arena_;
 };
 
 /**
@@ -274,6 +443,10 @@ class HashAggregator : public AbstractAggregator {
 
   bool Finalize() override;
 
+  /** Fold another (partial) hash aggregator built from the same plan node
+   *  into this one; groups unseen here are adopted wholesale */
+  void Merge(HashAggregator &partial);
+
   ~HashAggregator();
 
  private:
@@ -322,6 +495,16 @@ class HashAggregator : public AbstractAggregator {
 
   /** @brief Hash table */
   HashAggregateMapType aggregates_map;
+
+  // Direct-array fast path for the most common aggregation shape: GROUP BY
+  // on one integer-family column. Keys in [0, kDenseGroupLimit) map straight
+  // to a slot in dense_groups_, so the per-row cost is an array index
+  // instead of hashing and key-vector comparison; every other key (or key
+  // type) takes the hash table as before. The hash table remains the owner
+  // of every group, so Finalize, Merge and the destructor are unchanged.
+  static const int64_t kDenseGroupLimit = 64 * 1024;
+
+  std::vector<AggregateList *> dense_groups_;
 };
 
 /**
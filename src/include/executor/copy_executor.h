@@ -12,13 +12,31 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "executor/abstract_executor.h"
 #include "catalog/query_metrics_catalog.h"
+#include "storage/tuple.h"
+#include "threadpool/task_future.h"
+#include "type/ephemeral_pool.h"
 
 #define COPY_BUFFER_SIZE 65536
 #define INVALID_COL_ID -1
 
+// Number of parsed tuples handed to one batched table insert during imports
+#define COPY_INSERT_BATCH_SIZE 1024
+
+// Size of each of the two direct-export write buffers: one fills while the
+// worker pool writes the other out
+#define COPY_WRITE_BUFFER_SIZE (1 << 20)
+
 namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
 namespace executor {
 
 class CopyExecutor : public AbstractExecutor {
@@ -53,6 +71,87 @@ class CopyExecutor : public AbstractExecutor {
   // Copy and escape the content of column to local buffer
   void Copy(const char *data, int len, bool end_of_line);
 
+  //===--------------------------------------------------------------------===//
+  // Import (COPY FROM)
+  //===--------------------------------------------------------------------===//
+
+  // Tuples produced by one parse worker, together with the varlen pool
+  // backing them. The pool must outlive the batched inserts.
+  struct ParsedBatch {
+    std::vector<std::unique_ptr<storage::Tuple>> tuples;
+    std::unique_ptr<type::EphemeralPool> varlen_pool;
+    bool failed = false;
+    std::string error;
+  };
+
+  // Read the input file, parse it into tuples across the worker pool and
+  // bulk-load them into the target table
+  bool ImportTable();
+
+  // Parse the rows in data[begin, end) into batch. A backslash escapes the
+  // following character; an unescaped bare \N field is NULL.
+  void ParseChunk(const char *data, size_t begin, size_t end,
+                  const catalog::Schema *schema, ParsedBatch *batch);
+
+  //===--------------------------------------------------------------------===//
+  // Direct export (COPY TO fast path)
+  //===--------------------------------------------------------------------===//
+
+  // Serialize a predicate-free full-table scan straight from the tile
+  // groups, bypassing the logical-tile materialization and the per-value
+  // ToString path
+  bool DirectExport(storage::DataTable *target_table);
+
+  // Append raw bytes to the active write buffer, flushing full buffers to
+  // the worker pool as needed
+  void DirectWrite(const char *data, size_t len);
+
+  // Like DirectWrite, but escapes delimiter, newline and backslash
+  void DirectWriteEscaped(const char *data, size_t len);
+
+  // Hand the filled buffer to the worker pool for writing and switch to the
+  // other one, waiting for its previous write first
+  void SwapWriteBuffer();
+
+  //===--------------------------------------------------------------------===//
+  // Columnar export (COPY TO '<file>.arrow')
+  //===--------------------------------------------------------------------===//
+
+  // One result column being assembled in Arrow buffer layout: an LSB-first
+  // validity bitmap plus a little-endian data buffer, with an int32 offsets
+  // buffer (n + 1 entries) in front of the data for varlen types. The
+  // buffers follow the Arrow columnar spec byte for byte, so a consumer can
+  // wrap them zero-copy; only the file framing is Peloton's own.
+  struct ArrowColumnBuilder {
+    std::string name;
+    type::TypeId type_id;
+    std::vector<uint8_t> validity;
+    std::vector<int32_t> offsets;
+    std::vector<char> data;
+    uint64_t row_count = 0;
+    uint64_t null_count = 0;
+  };
+
+  // Drain the child plan into per-column Arrow-layout buffers and write
+  // them out as one record batch
+  bool ArrowExport();
+
+  // Append one value to its column's buffers; NULLs clear the validity bit
+  // and contribute a zero / empty slot so the data buffer stays aligned
+  // with the row index
+  void ArrowAppendValue(ArrowColumnBuilder &builder, const type::Value &value);
+
+  // Write the assembled columns: a fixed header, per-column metadata, then
+  // each column's buffers padded to 64-byte boundaries
+  void WriteArrowFile(std::vector<ArrowColumnBuilder> &builders);
+
+  // Raw writes for the columnar file; the CSV-oriented Copy() escaping must
+  // never touch binary buffers
+  void ArrowWrite(const void *data, size_t len);
+
+  // Pad the file position up to the next multiple of 64 bytes
+  void ArrowWritePadding();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -81,6 +180,21 @@ class CopyExecutor : public AbstractExecutor {
   // Total number of bytes written
   size_t total_bytes_written = 0;
 
+  // Whether the export target is a columnar .arrow file
+  bool arrow_export_ = false;
+
+  // Double buffers of the direct export path (allocated lazily)
+  std::unique_ptr<char[]> direct_buffers_[2];
+
+  // Fill level of the active direct buffer
+  size_t direct_buffer_fill_ = 0;
+
+  // Which direct buffer is filling
+  int direct_buffer_itr_ = 0;
+
+  // Outstanding write of the inactive direct buffer
+  threadpool::TaskFuture pending_write_;
+
   // The special column ids in query_metric table
   unsigned int num_param_col_id =
       catalog::QueryMetricsCatalog::ColumnId::NUM_PARAMS;
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "codegen/query_parameters.h"
+#include "executor/query_progress_registry.h"
 #include "type/ephemeral_pool.h"
+#include "type/memory_tracker.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -36,6 +40,14 @@ class ExecutorContext {
 
   ~ExecutorContext() = default;
 
+  /**
+   * @brief Rebind this context to a new execution. The transaction and
+   * parameters are replaced and per-execution state is dropped, so a cached
+   * executor tree can run again without a fresh context allocation.
+   */
+  void Reset(concurrency::TransactionContext *transaction,
+             codegen::QueryParameters parameters = {});
+
   concurrency::TransactionContext *GetTransaction() const;
 
   const std::vector<type::Value> &GetParamValues() const;
@@ -44,6 +56,83 @@ class ExecutorContext {
 
   type::EphemeralPool *GetPool();
 
+  /**
+   * @brief Sub-pool scoped to one operator (keyed by the operator's
+   * address). Allocations made here live until the operator releases the
+   * scope, not until query end, so transient per-operator state -- sort
+   * keys, build-side scratch -- stops inflating a deep plan's peak memory.
+   * Created on first use.
+   */
+  type::EphemeralPool *GetScopedPool(const void *scope);
+
+  /** @brief Drop a scope's sub-pool and every allocation in it at once;
+   *  a no-op when the scope never allocated */
+  void ReleaseScopedPool(const void *scope);
+
+  /**
+   * @brief Memory tracker charged for this query's pool allocations. The
+   * budget comes from the query_memory_budget_mb setting; operators with
+   * a spill path register hooks here so an over-budget query sheds memory
+   * instead of failing.
+   */
+  type::QueryMemoryTracker &GetMemoryTracker() { return memory_tracker_; }
+
+  /**
+   * @brief Attach the live-query registry entry describing this execution.
+   * The entry carries the cooperative cancellation flag and the progress
+   * counters the pg_query_progress table is built from.
+   */
+  void SetProgressEntry(
+      std::shared_ptr<QueryProgressRegistry::Entry> progress_entry) {
+    progress_entry_ = std::move(progress_entry);
+  }
+
+  /** @brief Whether an administrator requested cancellation of this query.
+   *  Executors check this at morsel / output-tile boundaries. */
+  bool IsCancelRequested() const {
+    return progress_entry_ != nullptr &&
+           progress_entry_->cancel_requested_.load(std::memory_order_relaxed);
+  }
+
+  /** @brief Whether this execution ran past the statement_timeout_ms
+   *  deadline computed when the context was (re)bound */
+  bool IsStatementTimeoutExpired() const {
+    return has_deadline_ && std::chrono::steady_clock::now() >= deadline_;
+  }
+
+  /**
+   * @brief Fail the query when it was killed or timed out. Executors call
+   * this at morsel boundaries, and compiled scan loops poll it through
+   * RuntimeFunctions::ThrowIfQueryCanceled, so cancellation never
+   * interrupts work mid-tuple.
+   */
+  void ThrowIfExecutionAborted() const;
+
+  /** @brief Account tuples the root of the plan produced */
+  void AddRowsProduced(uint64_t row_count) {
+    if (progress_entry_ != nullptr) {
+      progress_entry_->rows_produced_.fetch_add(row_count,
+                                                std::memory_order_relaxed);
+    }
+  }
+
+  /** @brief Report what the query is currently doing; must be a string
+   *  literal */
+  void SetExecutionPhase(const char *phase) {
+    if (progress_entry_ != nullptr) {
+      progress_entry_->phase_.store(phase, std::memory_order_relaxed);
+    }
+  }
+
+  /** @brief Mirror the memory tracker's usage into the registry entry, so
+   *  registry readers never touch this context */
+  void RefreshTrackedMemoryUsage() {
+    if (progress_entry_ != nullptr) {
+      progress_entry_->memory_bytes_.store(memory_tracker_.GetUsageBytes(),
+                                           std::memory_order_relaxed);
+    }
+  }
+
   // Number of processed tuples during execution
   uint32_t num_processed = 0;
 
@@ -54,6 +143,18 @@ class ExecutorContext {
   codegen::QueryParameters parameters_;
   // Temporary memory pool for allocations done during execution
   std::unique_ptr<type::EphemeralPool> pool_;
+  // Operator-scoped sub-pools, released wholesale when their operator
+  // finishes
+  std::unordered_map<const void *, std::unique_ptr<type::EphemeralPool>>
+      scoped_pools_;
+  // Per-query memory accounting and budget enforcement
+  type::QueryMemoryTracker memory_tracker_;
+  // Live-query registry entry for this execution; null for executions the
+  // plan executor did not publish (e.g. internal catalog queries)
+  std::shared_ptr<QueryProgressRegistry::Entry> progress_entry_;
+  // Deadline from the statement_timeout_ms setting; unset when disabled
+  bool has_deadline_ = false;
+  std::chrono::steady_clock::time_point deadline_;
 };
 
 }  // namespace executor
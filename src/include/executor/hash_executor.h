@@ -12,15 +12,12 @@
 
 #pragma once
 
-#include <unordered_map>
-
+#include "common/container/oa_hash_table.h"
 #include "common/internal_types.h"
 #include "executor/abstract_executor.h"
 #include "executor/logical_tile.h"
 #include "common/container_tuple.h"
 
-#include <boost/functional/hash.hpp>
-
 namespace peloton {
 namespace executor {
 
@@ -41,28 +38,127 @@ class HashExecutor : public AbstractExecutor {
   explicit HashExecutor(const planner::AbstractPlan *node,
                         ExecutorContext *executor_context);
 
-  /** @brief Type definitions for hash table */
-  typedef std::unordered_map<
-      ContainerTuple<LogicalTile>,
-      std::unordered_set<std::pair<size_t, oid_t>,
-                         boost::hash<std::pair<size_t, oid_t>>>,
-      ContainerTupleHasher<LogicalTile>,
-      ContainerTupleComparator<LogicalTile>> HashMapType;
+  /** @brief Type definitions for hash table. Values are
+   *         < child_tile offset, tuple offset > locations chained per key. */
+  typedef OAHashTable<ContainerTuple<LogicalTile>, std::pair<size_t, oid_t>,
+                      ContainerTupleHasher<LogicalTile>,
+                      ContainerTupleComparator<LogicalTile>> HashMapType;
+
+  inline HashMapType &GetHashTable() { return this->partitions_[0]; }
+
+  /** @brief Number of radix partitions the build side was split into;
+   *         one when radix partitioning is off */
+  inline size_t GetPartitionCount() const { return partitions_.size(); }
+
+  inline HashMapType &GetPartitionTable(size_t partition) {
+    return partitions_[partition];
+  }
 
-  inline HashMapType &GetHashTable() { return this->hash_table_; }
+  /** @brief Radix partition a key belongs to, from the high bits of its
+   *         hash so the partition tables' low slot bits stay uniform */
+  inline size_t GetPartitionFor(const HashMapType::key_type &key) const {
+    if (partitions_.size() == 1) return 0;
+    return GetPartitionForHash(ContainerTupleHasher<LogicalTile>()(key));
+  }
 
   inline const std::vector<oid_t> &GetHashKeyIds() const {
     return this->column_ids_;
   }
 
+  /**
+   * @brief Probe the bloom filter built over the build-side keys. Returns
+   * false only if the key is guaranteed not to be in the hash table, so
+   * callers (the hash join) can skip the hash table walk entirely. The
+   * filter is block-structured: all of a key's bits live in one 32-byte
+   * block, so a probe touches a single cache line no matter how many bits
+   * are tested.
+   */
+  inline bool MayContainKey(const HashMapType::key_type &key) const {
+    if (bloom_lanes_ == nullptr) return true;
+    return BloomBlockTest(ContainerTupleHasher<LogicalTile>()(key));
+  }
+
+  /**
+   * @brief Batch form of MayContainKey over precomputed key hashes. The
+   * probe loop is a straight run of block tests with no hash table or
+   * tuple access interleaved, so the SIMD block test stays hot and block
+   * loads overlap. With the filter disabled every key may match.
+   */
+  void MayContainHashes(const uint64_t *hashes, bool *matches,
+                        size_t count) const;
+
+  /**
+   * @brief Drop the hash tables and the bloom filter wholesale. The hash
+   * join calls this the moment probing is over, so the build side's memory
+   * does not sit around until the whole plan tears down; only outer-join
+   * bookkeeping, which lives in the join itself, is needed after that.
+   */
+  void ReleaseHashTables() {
+    partitions_.clear();
+    bloom_storage_.clear();
+    bloom_storage_.shrink_to_fit();
+    bloom_lanes_ = nullptr;
+    bloom_block_mask_ = 0;
+  }
+
+  /**
+   * @brief True when the build side ran past the hash_build_row_cap
+   * setting. No hash table or bloom filter was built -- the child tiles
+   * were only materialized and passed through -- and the hash join reacts
+   * by building over its other input instead.
+   */
+  inline bool IsBuildCapped() const { return build_capped_; }
+
+  /** @brief Partition for a key whose hash is already known; hash must
+   *         come from ContainerTupleHasher over the build key columns */
+  inline size_t GetPartitionForHash(uint64_t hash) const {
+    if (partitions_.size() == 1) return 0;
+    return (hash * UINT64_C(0x9e3779b97f4a7c15)) >> partition_shift_;
+  }
+
  protected:
   bool DInit();
 
   bool DExecute();
 
  private:
-  /** @brief Hash table */
-  HashMapType hash_table_;
+  // Size the bloom filter from the build-side cardinality (~10 bits per
+  // key for a ~1% false positive rate) and insert one entry per key
+  void InitBloomFilter(size_t build_tuple_count);
+
+  // Choose the radix fan-out from the build-side cardinality so each
+  // partition's table stays cache-sized
+  void InitPartitions(size_t build_tuple_count);
+
+  inline void AddToBloomFilter(const HashMapType::key_type &key) {
+    if (bloom_lanes_ == nullptr) return;
+    BloomBlockSet(ContainerTupleHasher<LogicalTile>()(key));
+  }
+
+  // Set / test one key's bits inside its 32-byte filter block. The block
+  // index comes from the hash's high half, the per-lane bit positions from
+  // its low half, so the two stay independent. Implementations live in the
+  // translation unit so the SIMD block test can sit behind a target check.
+  void BloomBlockSet(uint64_t hash);
+  bool BloomBlockTest(uint64_t hash) const;
+
+  /** @brief Hash tables, one per radix partition (a single table when
+   *         radix partitioning is off) */
+  std::vector<HashMapType> partitions_ = std::vector<HashMapType>(1);
+
+  /** @brief Right shift mapping a scrambled key hash to its partition */
+  size_t partition_shift_ = 0;
+
+  /** @brief Backing store for the filter blocks, with slack so the block
+   *         array can be aligned to a 32-byte boundary */
+  std::vector<uint32_t> bloom_storage_;
+
+  /** @brief Aligned start of the filter's 8-lane blocks; nullptr when the
+   *         filter is disabled */
+  uint32_t *bloom_lanes_ = nullptr;
+
+  /** @brief Block index mask (block count is a power of two) */
+  uint64_t bloom_block_mask_ = 0;
 
   /** @brief Input tiles from child node */
   std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
@@ -73,6 +169,9 @@ class HashExecutor : public AbstractExecutor {
 
   bool done_ = false;
 
+  /** @brief Build side exceeded the defensive row cap; see IsBuildCapped */
+  bool build_capped_ = false;
+
   size_t result_itr = 0;
 };
 
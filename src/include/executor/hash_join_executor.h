@@ -40,6 +40,15 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  // Drain the left child and build a hash table over its tuples, keyed by
+  // the left hash keys. Only used after the planned build side ran past
+  // the defensive row cap (see HashExecutor::IsBuildCapped).
+  void BuildSwitchedHashTable();
+
+  // Probe the switched (left-keyed) hash table with every tuple of one
+  // buffered right tile, appending join tiles to the output buffer.
+  void ProbeSwitchedHashTable(size_t right_tile_idx);
+
   HashExecutor *hash_executor_ = nullptr;
 
   bool hashed_ = false;
@@ -50,6 +59,22 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   // logical tile iterators
   size_t left_logical_tile_itr_ = 0;
   size_t right_logical_tile_itr_ = 0;
+
+  //===--------------------------------------------------------------------===//
+  // Switched-side (defensive) execution state
+  //===--------------------------------------------------------------------===//
+
+  // hash table over the left input; non-null only in switched mode
+  std::unique_ptr<HashExecutor::HashMapType> switched_table_;
+
+  bool switched_build_done_ = false;
+
+  // next buffered right tile to probe in switched mode
+  size_t switched_probe_itr_ = 0;
+
+  // key column ids for the two sides in switched mode
+  std::vector<oid_t> switched_left_col_ids_;
+  std::vector<oid_t> switched_right_col_ids_;
 };
 
 }  // namespace executor
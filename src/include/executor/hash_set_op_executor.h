@@ -12,8 +12,7 @@
 
 #pragma once
 
-#include <unordered_map>
-
+#include "common/container/oa_hash_table.h"
 #include "common/internal_types.h"
 #include "executor/abstract_executor.h"
 #include "executor/logical_tile.h"
@@ -38,6 +37,14 @@ namespace executor {
  * and forward the (logical tiles) upwards.
  * This avoids materialization.
  *
+ * When the plan advertises sorted children (SetOpPlan::AreChildrenSorted()),
+ * the executor instead merges the two inputs in one linear pass with
+ * constant memory: tiles are pulled from the children as needed, visibility
+ * is decided per run of equal left tuples against the matching right run,
+ * and no hash table is built. INTERSECT (ALL) additionally stops pulling
+ * the left child as soon as the right side is exhausted, since nothing
+ * later on the left can match.
+ *
  * 2018-01-07: This is <b>deprecated</b>. Do not modify these classes.
  * The old interpreted engine will be removed.
  * @deprecated
@@ -63,11 +70,10 @@ class HashSetOpExecutor : public AbstractExecutor {
     size_t right = 0;
   } counter_pair_t;
 
-  /** @brief Type definitions for hash table */
-  typedef std::unordered_map<
-      ContainerTuple<LogicalTile>, counter_pair_t,
-      ContainerTupleHasher<LogicalTile>,
-      ContainerTupleComparator<LogicalTile>> HashSetOpMapType;
+  /** @brief Type definitions for hash table; one counter pair per key */
+  typedef OAHashTable<ContainerTuple<LogicalTile>, counter_pair_t,
+                      ContainerTupleHasher<LogicalTile>,
+                      ContainerTupleComparator<LogicalTile>> HashSetOpMapType;
 
   /* Helper functions */
 
@@ -76,6 +82,19 @@ class HashSetOpExecutor : public AbstractExecutor {
   template <SetOpType SETOP>
   bool CalculateCopies(HashSetOpMapType &htable);
 
+  /* Streaming (sorted-children) mode */
+
+  bool ExecuteStreaming();
+
+  void ProcessSortedLeftTile(LogicalTile *tile);
+
+  size_t CountMatchingRightTuples(LogicalTile *left_tile, oid_t left_id);
+
+  bool EnsureRightTuple();
+
+  static int CompareTuples(LogicalTile *left_tile, oid_t left_id,
+                           LogicalTile *right_tile, oid_t right_id);
+
   /** @brief Hash table */
   HashSetOpMapType htable_;
 
@@ -90,6 +109,38 @@ class HashSetOpExecutor : public AbstractExecutor {
 
   /** @brief Next tile Id in the vector to return */
   size_t next_tile_to_return_ = 0;
+
+  /* Streaming mode state */
+
+  /** @brief Fully decided left tile waiting to be returned */
+  std::unique_ptr<LogicalTile> pending_output_;
+
+  /** @brief Last processed left tile; held back because the current run
+   *  key may still point into it */
+  std::unique_ptr<LogicalTile> held_left_tile_;
+
+  /** @brief Representative tuple of the current run of equal left tuples */
+  LogicalTile *run_tile_ = nullptr;
+  oid_t run_tuple_id_ = INVALID_OID;
+
+  /** @brief Position of the next left tuple within the current run */
+  size_t run_index_ = 0;
+
+  /** @brief Number of right tuples equal to the current run's key */
+  size_t run_right_matches_ = 0;
+
+  /** @brief Right-side cursor: current tile and its visible tuple ids */
+  std::unique_ptr<LogicalTile> right_tile_;
+  std::vector<oid_t> right_ids_;
+  size_t right_pos_ = 0;
+  bool right_exhausted_ = false;
+
+  /** @brief INTERSECT early-out: the right side ran dry, so no left tuple
+   *  from here on can appear in the result */
+  bool early_out_ = false;
+
+  /** @brief Left side exhausted (or early-out), nothing left to pull */
+  bool streaming_done_ = false;
 };
 
 }  // namespace executor
@@ -92,6 +92,43 @@ class HybridScanExecutor : public AbstractScanExecutor {
   std::set<ItemPointer> item_pointers_;
 
   oid_t block_threshold = 0;
+
+  //===--------------------------------------------------------------------===//
+  // Runtime Adaptivity
+  //===--------------------------------------------------------------------===//
+
+  // The strategy split (index part vs. sequential part) is fixed at Init,
+  // but the index keeps being backfilled while the query runs. During the
+  // sequential phase we track observed predicate selectivity; if it turns
+  // out to be low -- the cardinality estimate that justified a sequential
+  // phase was wrong -- and the index has since advanced past the current
+  // scan position, the executor switches back to index probing for the
+  // newly covered tile groups and resumes the sequential scan behind them.
+
+  // Re-probe the index for tile groups in (current position,
+  // newly indexed offset], advancing the sequential scan position past them.
+  // Returns true if the probe produced output tiles.
+  bool AdaptToIndexProbe();
+
+  // Tuples examined and qualifying during the sequential phase
+  size_t seq_scanned_tuples_ = 0;
+  size_t seq_qualified_tuples_ = 0;
+
+  // Tile groups finished in the sequential phase since the last
+  // adaptivity check
+  oid_t seq_tile_groups_scanned_ = 0;
+
+  // Check observed selectivity after this many sequentially scanned
+  // tile groups
+  oid_t adapt_tile_group_window_ = 10;
+
+  // Switch back to index probing only below this observed selectivity
+  double adapt_selectivity_threshold_ = 0.01;
+
+  // Block id range [adapt_lower_block_, adapt_upper_block_] an adaptive
+  // re-probe is restricted to; INVALID_OID when no re-probe is running
+  oid_t adapt_lower_block_ = INVALID_OID;
+  oid_t adapt_upper_block_ = INVALID_OID;
 };
 
 }  // namespace executor
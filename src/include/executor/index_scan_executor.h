@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -25,6 +26,7 @@ class Index;
 
 namespace storage {
 class AbstractTable;
+class Tuple;
 }
 
 namespace executor {
@@ -72,6 +74,11 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // conditions on key columns
   bool CheckKeyConditions(const ItemPointer &tuple_location);
 
+  // Materialize the result of a covering (index-only) scan from the visible
+  // entries' key copies, without reading base tuples
+  void BuildIndexOnlyResult(
+      const std::vector<std::shared_ptr<storage::Tuple>> &visible_keys);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -114,6 +121,18 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   bool key_ready_ = false;
 
+  // whether the scan can be answered from index keys alone: primary key
+  // index, every output column indexed, no residual predicate
+  bool index_only_scan_ = false;
+
+  // for each output column, its position in the index key schema
+  std::vector<oid_t> key_output_positions_;
+
+  // whether the index may answer a conjunction by skip scan, in which case
+  // entries violating an open bound can surface at every prefix-group
+  // boundary instead of only at the two ends of the result
+  bool skip_scan_ = false;
+
   // whether the index scan range is left open
   bool left_open_ = false;
 
@@ -77,12 +77,43 @@ class LogicalTile : public Printable {
 
   int AddPositionList(PositionList &&position_list);
 
+  // pass-through mode for simple scans: every base tuple in [0, tuple_count)
+  // is visible, so no explicit position list is constructed and lookups use
+  // the tuple position directly. consumers that ask for the explicit lists
+  // via GetPositionList(s) trigger a lazy materialization.
+  void AddIdentityPositionList(const oid_t tuple_count);
+
+  inline bool HasIdentityPositionList() const {
+    return identity_position_list_;
+  }
+
   void RemoveVisibility(oid_t tuple_id);
 
   storage::Tile *GetBaseTile(oid_t column_id);
 
   type::Value GetValue(oid_t tuple_id, oid_t column_id);
 
+  // default number of positions the prefetching accessors run ahead of
+  // the consumer
+  static const oid_t kDefaultPrefetchDistance = 8;
+
+  // batch accessor: append the values of column_id for positions
+  // [start_pos, end_pos) to values in one pass. the base-tile row backing
+  // the position prefetch_distance entries ahead is software-prefetched,
+  // hiding the dependent position-list and row loads behind the copy of
+  // the current value.
+  void GetValues(const oid_t column_id, const oid_t start_pos,
+                 const oid_t end_pos, std::vector<type::Value> &values,
+                 const oid_t prefetch_distance = kDefaultPrefetchDistance);
+
+  // issue a software prefetch for the base-tile row backing the given
+  // field; a no-op for out-of-range positions
+  void PrefetchValue(const oid_t column_id, const oid_t tuple_id);
+
+  // prefetch the base-tile rows backing every column of the given tuple
+  // position; a no-op for out-of-range positions
+  void PrefetchTuple(const oid_t tuple_id);
+
   void SetValue(type::Value &value, oid_t tuple_id, oid_t column_id);
 
   size_t GetTupleCount();
@@ -293,6 +324,10 @@ class LogicalTile : public Printable {
   // the future
   //===--------------------------------------------------------------------===//
 
+  // Materialize the implicit identity position list into position_lists_
+  // when a consumer demands the explicit representation
+  void MaterializeIdentityPositionList() const;
+
   // Column-oriented materialization
   void MaterializeColumnAtATime(
       const std::unordered_map<oid_t, oid_t> &old_to_new_cols,
@@ -348,8 +383,15 @@ class LogicalTile : public Printable {
   /**
    * @brief Lists of position lists.
    * Each list contains positions corresponding to particular tiles/columns.
+   * Mutable so that an identity position list can be materialized lazily
+   * from the const getters.
    */
-  PositionLists position_lists_;
+  mutable PositionLists position_lists_;
+
+  /** @brief True if the tile is in pass-through mode: the position list is
+   *  the identity over [0, total_tuples_) and is only materialized when a
+   *  consumer asks for the explicit lists. */
+  bool identity_position_list_ = false;
 
   /**
    * @brief Bit-vector storing visibility of each row in the position lists.
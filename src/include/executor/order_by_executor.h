@@ -16,6 +16,12 @@
 #include "executor/abstract_executor.h"
 #include "storage/tuple.h"
 
+namespace peloton {
+namespace planner {
+class OrderByPlan;
+}  // namespace planner
+}  // namespace peloton
+
 namespace peloton {
 namespace executor {
 
@@ -51,6 +57,8 @@ class OrderByExecutor : public AbstractExecutor {
  private:
   bool DoSort();
 
+  bool SortNormalized(const planner::OrderByPlan &node, size_t count);
+
   bool sort_done_ = false;
 
   /**
@@ -91,6 +99,10 @@ class OrderByExecutor : public AbstractExecutor {
   /** All valid tuples in sorted order */
   std::vector<sort_buffer_entry_t> sort_buffer_;
 
+  /** Input tuple positions in output order; filled by whichever sort path
+   *  ran and the only thing DExecute consults */
+  std::vector<ItemPointer> sorted_pointers_;
+
   /** Tuples in sort_buffer only contains the sort keys */
   std::unique_ptr<catalog::Schema> sort_key_tuple_schema_;
 
@@ -54,6 +54,10 @@ class PlanExecutor {
    * for network
    * Before ExecutePlan, a node first receives value list, so we should
    * pass value list directly rather than passing Postgres's ParamListInfo
+   *
+   * When the owning prepared statement is passed along, the interpreted
+   * executor tree is cached on it and reused by later executions instead
+   * of being rebuilt per execution.
    */
   static void ExecutePlan(
       std::shared_ptr<planner::AbstractPlan> plan,
@@ -61,7 +65,8 @@ class PlanExecutor {
       const std::vector<type::Value> &params,
       const std::vector<int> &result_format,
       std::function<void(executor::ExecutionResult,
-                         std::vector<ResultValue> &&)> on_complete);
+                         std::vector<ResultValue> &&)> on_complete,
+      std::shared_ptr<Statement> statement = nullptr);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
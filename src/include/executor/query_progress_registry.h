@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_progress_registry.h
+//
+// Identification: src/include/executor/query_progress_registry.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Query Progress Registry
+//
+// A registry of the queries currently executing on this node. The plan
+// executor registers every execution before it starts and removes it when
+// the execution finishes, so at any moment the registry holds one entry
+// per in-flight query: its statement text, start time, rows produced so
+// far, the phase it is running and its tracked memory usage.
+//
+// The stats aggregator publishes a snapshot of the registry into the
+// pg_query_progress catalog table each aggregation interval, and the
+// kill_query() builtin uses the registry to request cooperative
+// cancellation: it sets the entry's cancel flag, and the executing query
+// checks the flag at morsel / output-tile boundaries and unwinds through
+// the normal error path.
+//===--------------------------------------------------------------------===//
+
+class QueryProgressRegistry {
+ public:
+  // Live progress state of one executing query. The counters are updated
+  // by the query's own threads and read by the stats aggregator and by
+  // kill_query(), so everything mutable is atomic and the entry holds no
+  // pointers into the execution context it describes.
+  struct Entry {
+    Entry(uint64_t query_id, const std::string &query_text);
+
+    const uint64_t query_id_;
+
+    const std::string query_text_;
+
+    // wall clock at registration, microseconds since the epoch
+    const int64_t start_time_us_;
+
+    // tuples the root of the plan has produced so far
+    std::atomic<uint64_t> rows_produced_;
+
+    // what the query is currently doing; the interpreted engine's analog
+    // of a compiled query's current pipeline. Always a string literal, so
+    // readers can hold the pointer without lifetime concerns.
+    std::atomic<const char *> phase_;
+
+    // refreshed from the query's memory tracker by the query's own
+    // threads, so snapshot readers never reach into a foreign execution
+    // context
+    std::atomic<uint64_t> memory_bytes_;
+
+    // set by kill_query(); checked cooperatively by the executing query
+    std::atomic<bool> cancel_requested_;
+  };
+
+  // One materialized row of the pg_query_progress table
+  struct ProgressRow {
+    uint64_t query_id;
+    std::string query_text;
+    int64_t start_time_us;
+    int64_t elapsed_us;
+    uint64_t rows_produced;
+    const char *phase;
+    uint64_t memory_bytes;
+    bool cancel_requested;
+  };
+
+  QueryProgressRegistry(const QueryProgressRegistry &) = delete;
+  QueryProgressRegistry &operator=(const QueryProgressRegistry &) = delete;
+
+  static QueryProgressRegistry &GetInstance();
+
+  // Publish a new execution. The returned entry stays valid for as long
+  // as the caller holds it; Unregister only removes it from the registry.
+  std::shared_ptr<Entry> Register(const std::string &query_text);
+
+  // Remove a finished execution from the registry
+  void Unregister(uint64_t query_id);
+
+  // Set the cancel flag of a live query. Returns false when no query with
+  // the given id is registered.
+  bool RequestCancel(uint64_t query_id);
+
+  // Copy the current registry contents into materialized rows
+  std::vector<ProgressRow> GetSnapshot();
+
+  size_t GetLiveQueryCount();
+
+ private:
+  QueryProgressRegistry() : next_query_id_(1) {}
+
+  common::synchronization::SpinLatch registry_lock_;
+
+  std::map<uint64_t, std::shared_ptr<Entry>> entries_;
+
+  std::atomic<uint64_t> next_query_id_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,10 +12,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <string>
+
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
+#include "expression/expression_program.h"
+#include "storage/zone_map_manager.h"
 
 namespace peloton {
+
+namespace storage {
+class Tile;
+class TileGroup;
+}  // namespace storage
+
 namespace executor {
 
 /**
@@ -36,7 +47,12 @@ class SeqScanExecutor : public AbstractScanExecutor {
   void UpdatePredicate(const std::vector<oid_t> &column_ids,
                        const std::vector<type::Value> &values) override;
 
-  void ResetState() override { current_tile_group_offset_ = START_OID; }
+  void ResetState() override {
+    current_tile_group_offset_ = START_OID;
+    parallel_scan_done_ = false;
+    parallel_output_tiles_.clear();
+    parallel_output_cursor_ = 0;
+  }
 
  protected:
   bool DInit() override ;
@@ -55,13 +71,119 @@ class SeqScanExecutor : public AbstractScanExecutor {
   expression::AbstractExpression *ColumnValueToCmpExpr(
       const oid_t column_id, const type::Value &value);
 
+  // Check whether the current predicate is a simple comparison between a
+  // fixed-length, non-nullable column and a constant. If so, cache the
+  // comparison operator, column id and constant so that DExecute() can
+  // evaluate the predicate over whole batches in a tight loop.
+  bool PrepareVectorizedPredicate();
+
+  // Check whether the vectorized path can handle the given tile group. For
+  // dictionary-code comparisons this requires the target column's tile to
+  // carry a dictionary covering all active slots.
+  bool CanVectorizeTileGroup(storage::TileGroup *tile_group,
+                             oid_t active_tuple_count) const;
+
+  // Match the cached LIKE pattern against every distinct entry of the tile
+  // group's dictionary, returning one verdict per dictionary code. Called
+  // once per tile group; safe to call from the parallel scan workers.
+  std::vector<uint8_t> BuildLikeCodeMatches(
+      storage::TileGroup *tile_group) const;
+
+  // Scan the whole table with morsel-driven work distribution: tile groups
+  // are handed to MonoQueuePool workers through a shared atomic cursor, and
+  // each worker buffers its output tiles. The calling thread participates
+  // as a worker so progress is guaranteed even when the pool is saturated.
+  // Returns false if the scan could not be parallelized.
+  bool RunParallelScan();
+
+  // Worker loop: claim tile groups off the shared cursor and emit one
+  // logical tile per qualifying tile group into output_tiles. Only
+  // visibility checks and predicate evaluation happen here; transaction
+  // read bookkeeping is done by the parent when tiles are handed out.
+  void ParallelWorkerScan(
+      std::atomic<oid_t> *cursor,
+      std::vector<std::unique_ptr<LogicalTile>> *output_tiles);
+
+  // Build the position list of visible, qualifying tuples for one tile
+  // group. Used by the parallel workers.
+  void BuildPositionList(storage::TileGroup *tile_group,
+                         std::vector<oid_t> &position_list);
+
+  // Extract zone-map-checkable predicates so tile groups can be skipped on
+  // their min/max statistics before being scanned
+  void PrepareZoneMapPredicates();
+
+  // True if the tile group's zone map rules out every tuple for the current
+  // predicate
+  bool CanSkipTileGroup(oid_t tile_group_offset) const;
+
+  // Evaluate the cached simple predicate over the batch of tuple slots
+  // [batch_start, batch_end) in the given tile group, setting one bit in
+  // the selection bitmap per qualifying slot. For LIKE predicates,
+  // like_code_matches carries the tile group's per-code verdicts from
+  // BuildLikeCodeMatches(); it is ignored otherwise.
+  void EvaluatePredicateVectorized(storage::TileGroup *tile_group,
+                                   oid_t batch_start, oid_t batch_end,
+                                   uint64_t *selection_bitmap,
+                                   const std::vector<uint8_t> &like_code_matches);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
 
+  /** @brief Number of tuple slots examined per batch in the vectorized
+   *  scan path. */
+  static const oid_t kScanVectorSize = 1024;
+
+  /** @brief True if the predicate qualifies for the vectorized scan path. */
+  bool vectorized_scan_ = false;
+
+  /** @brief Comparison operator of the vectorizable predicate. */
+  ExpressionType simple_cmp_type_ = ExpressionType::INVALID;
+
+  /** @brief Column the vectorizable predicate references. */
+  oid_t simple_cmp_column_ = INVALID_OID;
+
+  /** @brief True if the predicate is a VARCHAR equality or LIKE that is
+   *  evaluated over dictionary codes instead of raw column data. */
+  bool simple_cmp_on_dictionary_ = false;
+
+  /** @brief Constant the vectorizable predicate compares against, already
+   *  cast to the column type. */
+  type::Value simple_cmp_value_;
+
+  /** @brief Bare pattern bytes when the vectorizable predicate is a LIKE. */
+  std::string simple_like_pattern_;
+
+  /** @brief True if the scan distributes tile groups across the worker
+   *  pool. */
+  bool parallel_scan_ = false;
+
+  /** @brief True once the parallel workers have scanned the whole table. */
+  bool parallel_scan_done_ = false;
+
+  /** @brief Tiles produced by the parallel workers, handed out one per
+   *  DExecute() call. */
+  std::vector<std::unique_ptr<LogicalTile>> parallel_output_tiles_;
+
+  /** @brief Next parallel output tile to hand out. */
+  size_t parallel_output_cursor_ = 0;
+
+  /** @brief Predicates usable for zone map skipping; empty if the predicate
+   *  is not zone mappable. */
+  std::vector<storage::PredicateInfo> zone_map_predicates_;
+
   /** @brief Keeps track of current tile group id being scanned. */
   oid_t current_tile_group_offset_ = INVALID_OID;
 
+  /** @brief Offset the scan started at; nonzero when attached to scans
+   *         already in progress on the table (shared scan). The scan visits
+   *         all tile groups circularly from here. */
+  oid_t scan_start_offset_ = 0;
+
+  /** @brief Whether this scan cooperates with concurrent scans */
+  bool shared_scan_ = false;
+
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
@@ -74,6 +196,13 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
 
+  // Predicate flattened into a postfix program when its shape allows it;
+  // the scalar evaluation paths use it in place of the virtual tree walk
+  std::unique_ptr<expression::ExpressionProgram> predicate_program_;
+
+  // Whether the flattening has been attempted for the current predicate
+  bool predicate_program_compiled_ = false;
+
   // TODO make predicate_ a unique_ptr
   // this is a hack that prevents memory leak
   std::unique_ptr<expression::AbstractExpression> new_predicate_ = nullptr;
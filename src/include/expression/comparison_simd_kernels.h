@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// comparison_simd_kernels.h
+//
+// Identification: src/include/expression/comparison_simd_kernels.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// Explicitly vectorized comparison kernels.
+//
+// These kernels evaluate "column cmp constant" and
+// "lo <= column AND column <= hi" predicates over a range of tuple slots in
+// a storage::Tile and produce a selection bitmap (one bit per slot, set when
+// the predicate holds). When the column data is contiguous (stride equals
+// the value width, i.e. the tile stores a single column) the integer and
+// decimal kernels use AVX2 instructions when the build target supports
+// them; otherwise they fall back to a tight scalar strided loop.
+//
+// The resulting bitmap can be turned into a position list consumable by
+// executor::LogicalTile via SelectionBitmapToPositionList().
+//===----------------------------------------------------------------------===//
+
+class ComparisonSIMDKernels {
+ public:
+  // Comparison operators supported by the SIMD path
+  static bool IsSupportedComparison(ExpressionType cmp_type);
+
+  // Column types supported by the SIMD path
+  static bool IsSupportedType(type::TypeId type_id);
+
+  // Evaluate "column cmp_type constant" over tuple slots [start, end).
+  // Column values of the given type live at column_offset inside each
+  // tuple, and consecutive tuples are tuple_stride bytes apart. Bit
+  // (slot - start) of the bitmap is set for each qualifying slot. The
+  // bitmap must hold at least (end - start) bits; callers size it with
+  // BitmapWordCount().
+  static void EvaluateComparison(type::TypeId type_id, ExpressionType cmp_type,
+                                 const char *tuple_base, size_t tuple_stride,
+                                 size_t column_offset, oid_t start, oid_t end,
+                                 const type::Value &constant,
+                                 uint64_t *bitmap);
+
+  // Evaluate "lo <= column AND column <= hi" (i.e. BETWEEN) over tuple
+  // slots [start, end), with the same layout contract as
+  // EvaluateComparison().
+  static void EvaluateBetween(type::TypeId type_id, const char *tuple_base,
+                              size_t tuple_stride, size_t column_offset,
+                              oid_t start, oid_t end, const type::Value &lo,
+                              const type::Value &hi, uint64_t *bitmap);
+
+  // Number of 64-bit words needed for a bitmap covering the given number
+  // of tuple slots
+  static size_t BitmapWordCount(oid_t tuple_count) {
+    return (static_cast<size_t>(tuple_count) + 63) / 64;
+  }
+
+  // Test a single bit in a selection bitmap
+  static bool TestBit(const uint64_t *bitmap, oid_t position) {
+    return (bitmap[position >> 6] >> (position & 63)) & 1;
+  }
+
+  // Append the tuple ids of all set bits to the given position list,
+  // offsetting each bit index by base_offset
+  static void SelectionBitmapToPositionList(const uint64_t *bitmap,
+                                            oid_t tuple_count,
+                                            oid_t base_offset,
+                                            std::vector<oid_t> &position_list);
+};
+
+}  // namespace expression
+}  // namespace peloton
@@ -0,0 +1,188 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// expression_program.h
+//
+// Identification: src/include/expression/expression_program.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "type/value.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace executor {
+class ExecutorContext;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===--------------------------------------------------------------------===//
+// Expression Program -- a predicate or projection expression flattened
+// into a postfix sequence of non-virtual steps.
+//
+// The interpreted executors evaluate expressions by walking the
+// AbstractExpression tree, paying a virtual Evaluate() call per node per
+// tuple. Flattening the tree once into a flat step array turns per-tuple
+// evaluation into a tight loop over a small value stack -- the runtime
+// counterpart of what the codegen expression translators produce for
+// compiled queries, without requiring full query compilation.
+//
+// Compile() understands the node types that dominate interpreted
+// UPDATE/DELETE and scan predicates -- tuple values, constants,
+// parameters, comparisons, AND/OR conjunctions, NOT, IS [NOT] NULL and
+// the basic arithmetic operators -- and returns nullptr for anything
+// else, in which case callers keep the tree walk.
+//
+// Comparisons whose operand types are statically integral or decimal are
+// lowered to type-specialized opcodes that run on unboxed slots (a raw
+// int64_t/double plus a null flag) instead of boxed type::Values, and the
+// boolean connectives run three-valued logic on a raw byte lane. The
+// dispatch loop itself uses computed goto on GCC/Clang so each opcode
+// jumps straight to its successor's handler, keeping the interpreter's
+// branches predictable and its hot code contiguous.
+//===--------------------------------------------------------------------===//
+
+class ExpressionProgram {
+ public:
+  // Flatten the expression into a program. Returns nullptr when the
+  // expression contains nodes the program cannot run.
+  static std::unique_ptr<ExpressionProgram> Compile(
+      const AbstractExpression *expression);
+
+  // Evaluate against the given tuples, with the same semantics as
+  // AbstractExpression::Evaluate() on the flattened tree
+  type::Value Evaluate(const AbstractTuple *tuple1,
+                       const AbstractTuple *tuple2,
+                       executor::ExecutorContext *context) const;
+
+ private:
+  enum class OpCode : uint8_t {
+    // Boxed opcodes -- operands are type::Values on the value stack
+    PushLeftTupleValue,   // arg = column id in tuple1
+    PushRightTupleValue,  // arg = column id in tuple2
+    PushConstant,         // arg = index into constants_
+    PushParameter,        // arg = parameter index
+    CompareEqual,
+    CompareNotEqual,
+    CompareLessThan,
+    CompareLessThanEquals,
+    CompareGreaterThan,
+    CompareGreaterThanEquals,
+    OperatorIsNull,
+    OperatorIsNotNull,
+    OperatorPlus,
+    OperatorMinus,
+    OperatorMultiply,
+    OperatorDivide,
+    // Typed loads -- push a column unboxed onto the slot lanes, widened
+    // to int64_t (integer family) or double (decimal)
+    LoadLeftTinyInt,  // arg = column id in tuple1
+    LoadLeftSmallInt,
+    LoadLeftInteger,
+    LoadLeftBigInt,
+    LoadLeftTimestamp,
+    LoadLeftDecimal,
+    LoadRightTinyInt,  // arg = column id in tuple2
+    LoadRightSmallInt,
+    LoadRightInteger,
+    LoadRightBigInt,
+    LoadRightTimestamp,
+    LoadRightDecimal,
+    LoadConstantInt,  // arg = index into int_constants_
+    LoadConstantDec,  // arg = index into dec_constants_
+    // Bridges between the boxed value stack and the unboxed lanes
+    UnboxInt,   // boxed top of stack -> integer lane
+    UnboxDec,   // boxed top of stack -> decimal lane
+    UnboxBool,  // boxed top of stack -> three-valued boolean lane
+    BoxBool,    // boolean lane -> boxed top of stack
+    CastIntToDec,  // widen the integer lane to the decimal lane in place
+    // Typed comparisons over the lanes; the result lands in the boolean
+    // lane, null when either operand is null
+    CmpIntEqual,
+    CmpIntNotEqual,
+    CmpIntLessThan,
+    CmpIntLessThanEquals,
+    CmpIntGreaterThan,
+    CmpIntGreaterThanEquals,
+    CmpDecEqual,
+    CmpDecNotEqual,
+    CmpDecLessThan,
+    CmpDecLessThanEquals,
+    CmpDecGreaterThan,
+    CmpDecGreaterThanEquals,
+    // Three-valued logic and null tests on the boolean lane
+    AndBool,
+    OrBool,
+    NotBool,
+    IsNullSlot,
+    IsNotNullSlot,
+    kOpCodeCount
+  };
+
+  struct Step {
+    OpCode op;
+    uint32_t arg;
+  };
+
+  // What a flattened sub-expression leaves on top of the stack: a boxed
+  // type::Value, or a raw byte on the three-valued boolean lane
+  enum class Lane : uint8_t { kValue, kBool };
+
+  ExpressionProgram() = default;
+
+  // Append the steps for the sub-expression in postfix order, tracking the
+  // evaluation stack height. Returns false when the node is unsupported.
+  // `produced` reports which representation the sub-expression's result
+  // uses, so parents can bridge between the boxed and unboxed worlds.
+  bool Flatten(const AbstractExpression *expression, Lane &produced);
+
+  // Flatten a comparison operand onto the integer or decimal lane,
+  // emitting a typed load when the node is a column or constant and an
+  // unbox bridge otherwise
+  bool FlattenAsLane(const AbstractExpression *expression, bool as_decimal);
+
+  // Flatten and force a boxed result / a boolean-lane result on top of
+  // the stack
+  bool FlattenBoxed(const AbstractExpression *expression);
+  bool FlattenAsBool(const AbstractExpression *expression);
+
+  void Emit(OpCode op, uint32_t arg, int stack_delta);
+
+  // Evaluation never needs more slots than this; deeper expressions fall
+  // back to the tree walk
+  static const uint32_t kMaxStackDepth = 16;
+
+  std::vector<Step> steps_;
+
+  // Constant operands, referenced by index from PushConstant steps
+  std::vector<type::Value> constants_;
+
+  // Constants pre-unboxed at compile time, referenced by LoadConstantInt /
+  // LoadConstantDec steps
+  std::vector<int64_t> int_constants_;
+  std::vector<double> dec_constants_;
+
+  // Whether the program's final result lives on the boolean lane (and is
+  // boxed once on the way out) rather than on the value stack
+  bool returns_bool_lane_ = false;
+
+  // Stack height bookkeeping during Flatten()
+  uint32_t stack_height_ = 0;
+  uint32_t max_stack_height_ = 0;
+};
+
+}  // namespace expression
+}  // namespace peloton
@@ -88,6 +88,11 @@ class FunctionExpression : public AbstractExpression {
   // throws an exception if children return unexpected types
   void CheckChildrenTypes() const;
 
+  // call the JIT-compiled body of a UDF directly through its raw function
+  // pointer, so interpreted evaluation pays a plain call instead of
+  // re-interpreting the function body per row
+  type::Value EvaluateUDF(const std::vector<type::Value> &child_values) const;
+
  private:
   // The name of the function
   std::string func_name_;
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// builtin_registry.h
+//
+// Identification: src/include/function/builtin_registry.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/internal_types.h"
+#include "function/string_functions.h"
+#include "function/timestamp_functions.h"
+
+namespace peloton {
+namespace function {
+
+//===----------------------------------------------------------------------===//
+// Compile-time registry of raw, unboxed builtin implementations keyed by
+// OperatorId. Each specialization binds an operator to its raw function at
+// compile time, so both the codegen translators and the interpreted
+// wrappers reach the implementation through a direct call on primitive
+// arguments - no string-keyed map lookup and no intermediate type::Value
+// boxing. Get() is constexpr, so the bound pointer folds into the caller.
+//
+// Only hot builtins with a raw implementation are registered here; anything
+// else keeps going through BuiltInFunctions::GetFuncByName.
+//===----------------------------------------------------------------------===//
+
+template <OperatorId Op>
+struct RawBuiltin;
+
+template <>
+struct RawBuiltin<OperatorId::Ascii> {
+  static constexpr decltype(&StringFunctions::Ascii) Get() {
+    return &StringFunctions::Ascii;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::Like> {
+  static constexpr decltype(&StringFunctions::Like) Get() {
+    return &StringFunctions::Like;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::Substr> {
+  static constexpr decltype(&StringFunctions::Substr) Get() {
+    return &StringFunctions::Substr;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::Length> {
+  static constexpr decltype(&StringFunctions::Length) Get() {
+    return &StringFunctions::Length;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::Repeat> {
+  static constexpr decltype(&StringFunctions::Repeat) Get() {
+    return &StringFunctions::Repeat;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::LTrim> {
+  static constexpr decltype(&StringFunctions::LTrim) Get() {
+    return &StringFunctions::LTrim;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::RTrim> {
+  static constexpr decltype(&StringFunctions::RTrim) Get() {
+    return &StringFunctions::RTrim;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::BTrim> {
+  static constexpr decltype(&StringFunctions::BTrim) Get() {
+    return &StringFunctions::BTrim;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::Trim> {
+  static constexpr decltype(&StringFunctions::Trim) Get() {
+    return &StringFunctions::Trim;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::DatePart> {
+  static constexpr decltype(&TimestampFunctions::DatePart) Get() {
+    return &TimestampFunctions::DatePart;
+  }
+};
+
+template <>
+struct RawBuiltin<OperatorId::DateTrunc> {
+  static constexpr decltype(&TimestampFunctions::DateTrunc) Get() {
+    return &TimestampFunctions::DateTrunc;
+  }
+};
+
+}  // namespace function
+}  // namespace peloton
@@ -37,6 +37,30 @@ class StringFunctions {
   static uint32_t Ascii(executor::ExecutorContext &ctx, const char *str,
                         uint32_t length);
 
+  // How a LIKE pattern can be matched. Every shape but General reduces to
+  // a single probe with the pattern's literal part.
+  enum class LikePatternType : uint32_t {
+    General = 0,  // arbitrary wildcards; takes the recursive matcher
+    Exact,        // no wildcards: one bounded compare
+    Prefix,       // literal then '%': bounded compare at the front
+    Suffix,       // '%' then literal: bounded compare at the back
+    Contains,     // '%', literal, '%': substring search
+  };
+
+  // Classify a LIKE pattern. For every result but General, *literal and
+  // *literal_length are set to the pattern's literal part, pointing into
+  // the pattern itself. Patterns containing '_' or an escape classify as
+  // General.
+  static LikePatternType ClassifyLikePattern(const char *p, uint32_t plen,
+                                             const char **literal,
+                                             uint32_t *literal_length);
+
+  // Match text against a classified (non-General) pattern's literal.
+  // Comparisons are case-insensitive, like the recursive matcher.
+  static bool LikeLiteralMatch(LikePatternType pattern_type, const char *t,
+                               uint32_t tlen, const char *literal,
+                               uint32_t literal_length);
+
   // Like
   static bool Like(executor::ExecutorContext &ctx, const char *t, uint32_t tlen,
                    const char *p, uint32_t plen);
@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// system_functions.h
+//
+// Identification: src/include/function/system_functions.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/value.h"
+
+namespace peloton {
+namespace function {
+
+class SystemFunctions {
+ public:
+  // kill_query(query_id) -- request cooperative cancellation of a live
+  // query. The query checks the flag at morsel / output-tile boundaries
+  // and fails with an executor error, so the kill never interrupts work
+  // mid-tuple. Returns true when the id matched a registered query.
+  static type::Value KillQuery(const std::vector<type::Value> &args);
+};
+
+}  // namespace function
+}  // namespace peloton
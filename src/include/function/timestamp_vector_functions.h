@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// timestamp_vector_functions.h
+//
+// Identification: src/include/function/timestamp_vector_functions.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace function {
+
+//===----------------------------------------------------------------------===//
+// Batch variants of TimestampFunctions::DateTrunc and DatePart.
+//
+// The scalar functions re-parse the date-part string and branch on
+// DatePartType once per row, and decode the full calendar representation
+// even for parts that only need simple arithmetic. The batch kernels
+// dispatch on the date part once per batch into a loop instantiated per
+// DatePartType, so the per-row work is a branch-free decode plus exactly
+// the computation the part requires; the calendar library is only
+// consulted for the week/day-of-year family. Time-bucketing GROUP BYs and
+// vectorized scans hand these a raw timestamp array instead of calling
+// through type::Value per row.
+//
+// NULL timestamps (PELOTON_TIMESTAMP_NULL) map to PELOTON_TIMESTAMP_NULL
+// and PELOTON_DECIMAL_NULL respectively, matching the scalar functions.
+//===----------------------------------------------------------------------===//
+
+class TimestampVectorFunctions {
+ public:
+  // Truncate count timestamps to the given precision. results may alias
+  // timestamps.
+  static void DateTruncBatch(DatePartType date_part,
+                             const uint64_t *timestamps, uint64_t *results,
+                             size_t count);
+
+  // Extract the given part of count timestamps. results must not alias
+  // timestamps.
+  static void DatePartBatch(DatePartType date_part, const uint64_t *timestamps,
+                            double *results, size_t count);
+};
+
+}  // namespace function
+}  // namespace peloton
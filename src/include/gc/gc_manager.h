@@ -28,6 +28,7 @@ class TransactionContext;
 }
 
 namespace storage {
+class DataTable;
 class TileGroup;
 }
 
@@ -69,10 +70,33 @@ class GCManager {
     return INVALID_ITEMPOINTER;
   }
 
+  // Dequeue up to max_count recycled slots for the table in one call, so a
+  // caller refilling a local cache pays the table lookup only once. Returns
+  // the number of slots appended.
+  virtual size_t ReturnFreeSlots(const oid_t &table_id UNUSED_ATTRIBUTE,
+                                 size_t max_count UNUSED_ATTRIBUTE,
+                                 std::vector<ItemPointer> &slots
+                                     UNUSED_ATTRIBUTE) {
+    return 0;
+  }
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
+  // Take ownership of a table that has been unlinked from its database.
+  // The default implementation tears the table down inline; the
+  // transaction-level manager overrides this to epoch-retire the table and
+  // release its tile groups incrementally on the GC workers.
+  virtual void RecycleDroppedTable(storage::DataTable *table);
+
+  // Hold back garbage versions still visible at the given snapshot commit
+  // id (see storage::SnapshotExporter). Without a background GC nothing is
+  // ever reclaimed anyway, so the base implementation is a no-op.
+  virtual void PinSnapshot(const cid_t snapshot_cid UNUSED_ATTRIBUTE) {}
+
+  virtual void UnpinSnapshot(const cid_t snapshot_cid UNUSED_ATTRIBUTE) {}
+
   virtual size_t GetTableCount() { return 0; }
 
   virtual void RecycleTransaction(
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/gc/tile_group_compactor.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace gc {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Background service that squeezes sparse tile groups after heavy
+ * deletes.
+ *
+ * Full tile groups whose dead-slot fraction (maintained incrementally on
+ * the TileGroupHeader by the GC) crosses the
+ * tile_group_compaction_threshold setting are first made immutable, so
+ * their slots stop being recycled, then their surviving tuples are moved
+ * into fresh tile groups under a regular transaction using the update
+ * machinery. The move swaps each tuple's indirection, so no index entry
+ * changes. Once the GC has unlinked and reclaimed the moved-out versions
+ * the emptied tile group is retired: a one-slot shell replaces it under
+ * the same tile group oid -- concurrent scans iterate valid offsets of the
+ * table's tile group array, so the entry must stay in place -- and the old
+ * storage is epoch-deferred freed by the catalog manager.
+ */
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor();
+
+  ~TileGroupCompactor();
+
+  // Singleton
+  static TileGroupCompactor &GetInstance();
+
+  // Start the compactor thread
+  void Start();
+
+  // Compactor thread loop
+  void Compact();
+
+  // Stop the compactor thread
+  void Stop();
+
+  // Add table to the list of tables to compact
+  void AddTable(storage::DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+  /**
+   * One compaction pass over the table: freezes sparse full tile groups
+   * and moves their survivors out, and retires frozen tile groups the GC
+   * has fully reclaimed since an earlier pass. Returns the number of tile
+   * groups acted on.
+   */
+  static size_t CompactTable(storage::DataTable *table);
+
+  /**
+   * Move every visible tuple of the (immutable) tile group into a fresh
+   * slot under one transaction, reusing the update machinery with an
+   * empty target list: the indirection is redirected and the indexes are
+   * untouched. Returns false when a concurrent writer forced an abort;
+   * the tile group is simply retried on a later pass.
+   */
+  static bool MoveTuplesOutOfTileGroup(
+      storage::DataTable *table,
+      std::shared_ptr<storage::TileGroup> tile_group);
+
+  /** Progress counter: tile groups frozen and moved out */
+  uint64_t GetTileGroupsCompacted() const {
+    return tile_groups_compacted_.load();
+  }
+
+  /** Progress counter: emptied tile groups replaced by shells */
+  uint64_t GetTileGroupsRetired() const { return tile_groups_retired_.load(); }
+
+ private:
+  /**
+   * Replace the emptied tile group with a one-slot immutable shell under
+   * the same oid; the displaced storage is epoch-retired by the catalog
+   * manager.
+   */
+  static void RetireTileGroup(storage::DataTable *table,
+                              std::shared_ptr<storage::TileGroup> tile_group);
+
+  // Tables to compact
+  std::vector<storage::DataTable *> tables_;
+
+  std::mutex compactor_mutex_;
+
+  std::atomic<bool> compaction_stop_{true};
+
+  std::thread compactor_thread_;
+
+  std::atomic<uint64_t> tile_groups_compacted_{0};
+
+  std::atomic<uint64_t> tile_groups_retired_{0};
+
+  // Duration between passes (ms)
+  uint32_t pause_duration_ = 100;
+};
+
+}  // namespace gc
+}  // namespace peloton
@@ -12,39 +12,69 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
+#include <set>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "common/init.h"
 #include "common/logger.h"
+#include "common/synchronization/epoch_retire_list.h"
+#include "common/synchronization/spin_latch.h"
 #include "common/thread_pool.h"
 #include "concurrency/transaction_context.h"
 #include "gc/gc_manager.h"
 #include "common/internal_types.h"
 
 #include "common/container/lock_free_queue.h"
+// complete type needed: retired_pools_ owns pools through unique_ptr
+#include "type/abstract_pool.h"
 
 namespace peloton {
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
 
+// Extra unlink workers that can be borrowed from the shared worker pool when
+// the unlink backlog outgrows the dedicated GC threads
+#define MAX_HELPER_WORKER_COUNT 4
+
+// Rough per-worker backlog budget (pending transaction contexts) used by the
+// scaling and backpressure thresholds
+#define BACKLOG_PER_WORKER 4096
+
+// A varlen pool of an immutable tile group is compacted once at least this
+// many bytes have been freed from it (and at least half of everything ever
+// allocated from it is dead)
+#define COMPACTION_MIN_FREED_BYTES (256 * 1024)
+
+// At most this many tile groups of a dropped table are released per reclaim
+// pass, so tearing down a huge table never monopolizes a GC worker
+#define DROPPED_TABLE_GROUPS_PER_PASS 64
+
 class TransactionLevelGCManager : public GCManager {
  public:
   TransactionLevelGCManager(const int thread_count)
-      : gc_thread_count_(thread_count), reclaim_maps_(thread_count) {
-    unlink_queues_.reserve(thread_count);
-    for (int i = 0; i < gc_thread_count_; ++i) {
+      : gc_thread_count_(thread_count),
+        reclaim_maps_(thread_count + MAX_HELPER_WORKER_COUNT) {
+    // Allocate the helper slots up front; only the first
+    // active_worker_count_ slots are fed by writers at any time
+    const int total_worker_count = thread_count + MAX_HELPER_WORKER_COUNT;
+    unlink_queues_.reserve(total_worker_count);
+    for (int i = 0; i < total_worker_count; ++i) {
       std::shared_ptr<LockFreeQueue<concurrency::TransactionContext* >>
           unlink_queue(new LockFreeQueue<concurrency::TransactionContext* >(
               MAX_QUEUE_LENGTH));
       unlink_queues_.push_back(unlink_queue);
       local_unlink_queues_.emplace_back();
     }
+    active_worker_count_ = thread_count;
+    unlink_backlog_ = 0;
   }
 
   virtual ~TransactionLevelGCManager() {}
@@ -54,8 +84,9 @@ class TransactionLevelGCManager : public GCManager {
     unlink_queues_.clear();
     local_unlink_queues_.clear();
 
-    unlink_queues_.reserve(gc_thread_count_);
-    for (int i = 0; i < gc_thread_count_; ++i) {
+    const int total_worker_count = gc_thread_count_ + MAX_HELPER_WORKER_COUNT;
+    unlink_queues_.reserve(total_worker_count);
+    for (int i = 0; i < total_worker_count; ++i) {
       std::shared_ptr<LockFreeQueue<concurrency::TransactionContext* >>
           unlink_queue(new LockFreeQueue<concurrency::TransactionContext* >(
               MAX_QUEUE_LENGTH));
@@ -64,9 +95,12 @@ class TransactionLevelGCManager : public GCManager {
     }
 
     reclaim_maps_.clear();
-    reclaim_maps_.resize(gc_thread_count_);
+    reclaim_maps_.resize(total_worker_count);
     recycle_queue_map_.clear();
 
+    active_worker_count_ = gc_thread_count_;
+    unlink_backlog_ = 0;
+
     is_running_ = false;
   }
 
@@ -107,6 +141,9 @@ class TransactionLevelGCManager : public GCManager {
 
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual size_t ReturnFreeSlots(const oid_t &table_id, size_t max_count,
+                                 std::vector<ItemPointer> &slots) override;
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
@@ -125,13 +162,19 @@ class TransactionLevelGCManager : public GCManager {
 
   virtual size_t GetTableCount() override { return recycle_queue_map_.size(); }
 
+  virtual void RecycleDroppedTable(storage::DataTable *table) override;
+
+  virtual void PinSnapshot(const cid_t snapshot_cid) override;
+
+  virtual void UnpinSnapshot(const cid_t snapshot_cid) override;
+
   int Unlink(const int &thread_id, const eid_t &expired_eid);
 
   int Reclaim(const int &thread_id, const eid_t &expired_eid);
 
  private:
   inline unsigned int HashToThread(const size_t &thread_id) {
-    return (unsigned int)thread_id % gc_thread_count_;
+    return (unsigned int)thread_id % active_worker_count_.load();
   }
 
   /**
@@ -144,10 +187,38 @@ class TransactionLevelGCManager : public GCManager {
 
   void Running(const int &thread_id);
 
+  // Drain loop of a borrowed helper worker; exits once the helper's slot is
+  // retired (or GC stops) after clearing what is left in the slot
+  void HelperLoop(const int slot);
+
+  // Open or retire helper slots based on the unlink backlog. Called from the
+  // first dedicated GC thread only.
+  void AdjustWorkerCount();
+
   void AddToRecycleMap(concurrency::TransactionContext *txn_ctx);
 
   bool ResetTuple(const ItemPointer &);
 
+  // Compact the varlen pools of an immutable tile group whose fragmentation
+  // crosses the compaction thresholds. The retired pools are parked in
+  // retired_pools_ until their epoch expires, since concurrent readers may
+  // still hold raw pointers into them.
+  void CheckAndCompactTileGroup(storage::TileGroup *tile_group);
+
+  // Delete retired varlen pools whose epoch has expired
+  void DeleteRetiredVarlenPools(const eid_t &expired_eid);
+
+  // Release up to DROPPED_TABLE_GROUPS_PER_PASS tile groups of the oldest
+  // dropped table whose retire epoch has expired; the table itself is
+  // deleted by the pass that finds no tile group left. Returns the number
+  // of tile group slots processed in this pass.
+  size_t ReleaseDroppedTables(const eid_t &expired_eid);
+
+  // true if some pinned export snapshot can still see a version this
+  // transaction invalidated; such garbage is deferred even though every
+  // active transaction has moved past it.
+  bool IsSnapshotProtected(concurrency::TransactionContext *txn_ctx);
+
   // this function iterates the gc context and unlinks every version
   // from the indexes.
   // this function will call the UnlinkVersion() function.
@@ -163,8 +234,16 @@ class TransactionLevelGCManager : public GCManager {
 
   int gc_thread_count_;
 
+  // number of worker slots writers currently hash into:
+  // gc_thread_count_ dedicated threads plus any active helpers
+  std::atomic<int> active_worker_count_;
+
+  // approximate number of transaction contexts awaiting unlinking, across
+  // the shared and local unlink queues
+  std::atomic<int> unlink_backlog_;
+
   // queues for to-be-unlinked tuples.
-  // # unlink_queues == # gc_threads
+  // # unlink_queues == # gc_threads + # helper slots
   std::vector<std::shared_ptr<
       peloton::LockFreeQueue<concurrency::TransactionContext* >>>
       unlink_queues_;
@@ -186,6 +265,34 @@ class TransactionLevelGCManager : public GCManager {
   std::unordered_map<oid_t,
                      std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>>
       recycle_queue_map_;
+
+  // varlen pools retired by compaction, parked until the epoch current when
+  // the pool was swapped out has expired. Shared across GC workers.
+  common::synchronization::EpochRetireList<std::unique_ptr<type::AbstractPool>>
+      retired_pools_;
+
+  // A dropped table parked for incremental teardown. next_tile_group_offset
+  // is the table-local offset the next release pass resumes from.
+  struct RetiredTable {
+    RetiredTable(storage::DataTable *table_p, const eid_t retire_eid_p)
+        : table(table_p), retire_eid(retire_eid_p), next_tile_group_offset(0) {}
+
+    storage::DataTable *table;
+    eid_t retire_eid;
+    std::size_t next_tile_group_offset;
+  };
+
+  // dropped tables awaiting teardown, oldest first. A release pass pops the
+  // front entry, so only one worker tears a given table down at a time.
+  std::list<RetiredTable> retired_tables_;
+  common::synchronization::SpinLatch retired_tables_lock_;
+
+  // commit ids of the export snapshots currently pinned (a multiset: two
+  // concurrent exports may freeze the same commit id). The atomic count
+  // keeps the no-snapshot fast path in Unlink() latch-free.
+  std::multiset<cid_t> pinned_snapshots_;
+  common::synchronization::SpinLatch pinned_snapshots_lock_;
+  std::atomic<size_t> pinned_snapshot_count_{0};
 };
 }
 }  // namespace peloton
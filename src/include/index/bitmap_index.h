@@ -0,0 +1,205 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index.h
+//
+// Identification: src/include/index/bitmap_index.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/synchronization/readwrite_latch.h"
+#include "index/index.h"
+
+namespace peloton {
+namespace index {
+
+//===----------------------------------------------------------------------===//
+//
+// A bitmap index for low-cardinality columns (status, region, type, ...).
+//
+// The index keeps one bitmap per distinct key value, organized as one
+// container per tile group so that bit positions line up with tuple slots:
+// bit (block, offset) stands for the tuple slot the entry was inserted at.
+// Containers start out as sorted offset lists and flip to packed bit words
+// once a value becomes frequent inside a tile group, so rare values stay
+// small and hot values cost one bit per row.
+//
+// Multi-predicate analytic filters combine key bitmaps with bitwise
+// AND/OR through BitmapSelection before a single tuple is fetched; the
+// combined selection then materializes the surviving slots' entry
+// pointers, which is the same result shape every other index scan
+// produces.
+//
+// Writers serialize on a read-write latch. This index targets read-mostly
+// analytic columns; it is not meant for write-hot primary keys.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * A selection of tuple slots grouped by tile group, produced from one or
+ * more key bitmaps. Supports bitwise combination with other selections
+ * and materialization into the item pointer vector an index scan returns.
+ */
+class BitmapSelection {
+ public:
+  /** @brief Keep only the slots present in both selections. */
+  void And(const BitmapSelection &other);
+
+  /** @brief Add all slots present in the other selection. */
+  void Or(const BitmapSelection &other);
+
+  /** @brief True if no slot is selected. */
+  bool IsEmpty() const;
+
+  /** @brief Number of selected slots. */
+  size_t GetCardinality() const;
+
+ private:
+  friend class BitmapIndex;
+
+  // packed bit words per tile group; bit i of word w in block b selects
+  // tuple slot (b, w * 64 + i)
+  std::map<oid_t, std::vector<uint64_t>> blocks_;
+};
+
+class BitmapIndex : public Index {
+  friend class IndexFactory;
+
+ public:
+  explicit BitmapIndex(IndexMetadata *metadata);
+
+  ~BitmapIndex() override;
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value) override;
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate) override;
+
+  /**
+   * BitmapIndex throws away the first three arguments and only uses the
+   * conjuncts from the scan predicate. Point queries read one key bitmap;
+   * bounded ranges union the bitmaps of the qualifying distinct keys.
+   *
+   * @param scan_predicate The only predicate that's actually used.
+   * @param[out] result Where the results of the scan are stored
+   */
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction,
+            std::vector<ItemPointer *> &result,
+            const ConjunctionScanPredicate *scan_predicate) override;
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ItemPointer *> &result,
+                 const ConjunctionScanPredicate *scan_predicate, uint64_t limit,
+                 uint64_t offset) override;
+
+  void ScanAllKeys(std::vector<ItemPointer *> &result) override;
+
+  void ScanKey(const storage::Tuple *key,
+               std::vector<ItemPointer *> &result) override;
+
+  /**
+   * @brief Copy the key's bitmap into the given selection (bitwise OR).
+   *        Returns false when the key value has no entries; the selection
+   *        is left untouched in that case.
+   */
+  bool ReadKeyBitmap(const storage::Tuple *key, BitmapSelection &selection);
+
+  /** @brief Union the bitmaps of every distinct key into the selection. */
+  void ReadFullBitmap(BitmapSelection &selection);
+
+  /**
+   * @brief Append the entry pointer of every selected slot to the result
+   *        vector. Any bitmap index over the same table can materialize a
+   *        combined selection, since the same slot maps to the same entry
+   *        pointer in each of them.
+   */
+  void Materialize(const BitmapSelection &selection,
+                   std::vector<ItemPointer *> &result);
+
+  /// Return the index type
+  std::string GetTypeName() const override {
+    return IndexTypeToString(GetIndexMethodType());
+  }
+
+  size_t GetMemoryFootprint() override;
+
+  bool NeedGC() override { return false; }
+
+  void PerformGC() override {}
+
+ private:
+  // Past this many scattered offsets a container flips to packed words;
+  // below it the sorted offset list is smaller than the word array of a
+  // whole tile group.
+  static const size_t kDenseThreshold = 64;
+
+  /**
+   * Per-(key value, tile group) bitmap container. Sparse containers hold
+   * the sorted slot offsets directly; dense containers pack them into bit
+   * words indexed by offset.
+   */
+  struct Container {
+    std::vector<uint32_t> sparse;
+    std::vector<uint64_t> words;
+
+    bool IsDense() const { return words.empty() == false; }
+
+    void SetBit(uint32_t offset);
+    bool ClearBit(uint32_t offset);
+    void OrInto(std::vector<uint64_t> &dense_words) const;
+    size_t GetCardinality() const;
+  };
+
+  /** Bitmap of one distinct key value across all tile groups. */
+  struct KeyBitmap {
+    // materialized key copy, used to qualify distinct keys on range scans
+    std::unique_ptr<storage::Tuple> key_tuple;
+    std::map<oid_t, Container> blocks;
+    size_t cardinality = 0;
+  };
+
+  // canonical string form of a key, used to identify distinct key values
+  std::string CanonicalKey(const storage::Tuple *key) const;
+
+  // union one key's containers into a selection; caller holds the latch
+  void UnionIntoSelection(const KeyBitmap &bitmap,
+                          BitmapSelection &selection) const;
+
+  // guards bitmaps_, slot_of_entry_ and entry_of_slot_
+  common::synchronization::ReadWriteLatch latch_;
+
+  // one bitmap per distinct key value
+  std::unordered_map<std::string, KeyBitmap> bitmaps_;
+
+  // The slot each live entry's bit occupies, keyed by the entry's
+  // indirection pointer. An entry is inserted at its version's own slot
+  // but deleted by pointer identity after the head location has moved on,
+  // so the original slot has to be remembered.
+  std::unordered_map<ItemPointer *, ItemPointer> slot_of_entry_;
+
+  // reverse mapping used to materialize selections, keyed by the packed
+  // slot (block << 32 | offset); shared by every key's bitmaps
+  std::unordered_map<uint64_t, ItemPointer *> entry_of_slot_;
+};
+
+}  // namespace index
+}  // namespace peloton
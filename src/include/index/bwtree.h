@@ -9039,6 +9039,87 @@ class BwTree : public BwTreeBase {
     return;
   }
 
+  /*
+   * IsQuiescentDeltaChain() - Returns true if the delta chain only carries
+   *                           data deltas (insert/delete)
+   *
+   * Chains carrying SMO deltas (split/merge/remove/abort) must first be
+   * completed by the foreground traversal machinery, so the background
+   * consolidation pass leaves them alone.
+   */
+  static bool IsQuiescentDeltaChain(const BaseNode *node_p) {
+    while (node_p->IsDeltaNode() == true) {
+      switch (node_p->GetType()) {
+        case NodeType::InnerInsertType:
+        case NodeType::InnerDeleteType:
+        case NodeType::LeafInsertType:
+        case NodeType::LeafDeleteType:
+          node_p = static_cast<const DeltaNode *>(node_p)->child_node_p;
+          break;
+        default:
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /*
+   * ConsolidateLongChains() - Scans the mapping table and consolidates every
+   *                           delta chain whose length reaches the given
+   *                           thresholds
+   *
+   * This is the entry point of the background consolidation service. It
+   * performs the same consolidation a foreground thread would otherwise do
+   * inline in TryConsolidateNode(), but off the critical path. Losing the
+   * install CAS to a concurrent thread is harmless, exactly as it is on the
+   * foreground path.
+   *
+   * Returns the number of chains consolidated.
+   */
+  size_t ConsolidateLongChains(int leaf_chain_threshold,
+                               int inner_chain_threshold) {
+    size_t consolidated_count = 0;
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    NodeID max_node_id = next_unused_node_id.load();
+    if (max_node_id > MAPPING_TABLE_SIZE) {
+      max_node_id = MAPPING_TABLE_SIZE;
+    }
+
+    for (NodeID node_id = 1; node_id < max_node_id; node_id++) {
+      const BaseNode *node_p = mapping_table[node_id].load();
+
+      if (node_p == nullptr || node_p->IsDeltaNode() == false) {
+        continue;
+      }
+
+      int depth = node_p->GetDepth();
+      if (node_p->IsOnLeafDeltaChain() == true) {
+        if (depth < leaf_chain_threshold) {
+          continue;
+        }
+      } else {
+        if (depth < inner_chain_threshold) {
+          continue;
+        }
+      }
+
+      if (IsQuiescentDeltaChain(node_p) == false) {
+        continue;
+      }
+
+      NodeSnapshot snapshot{node_id, node_p};
+      ConsolidateNode(&snapshot);
+      consolidated_count++;
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return consolidated_count;
+  }
+
 };  // class BwTree
 
 }  // End index/bwtree namespace
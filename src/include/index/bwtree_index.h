@@ -20,6 +20,7 @@
 #include "common/platform.h"
 #include "common/internal_types.h"
 #include "index/index.h"
+#include "storage/slab_allocator.h"
 
 #include "index/bwtree.h"
 
@@ -67,6 +68,16 @@ class BWTreeIndex : public Index {
 
   ~BWTreeIndex();
 
+  // The multi-megabyte mapping table lives inline in the tree, so the
+  // whole index object is placed in a dedicated huge-page-backed mapping
+  static void *operator new(std::size_t size) {
+    return storage::SlabAllocator::GetInstance().AllocateHuge(size);
+  }
+
+  static void operator delete(void *address) {
+    storage::SlabAllocator::GetInstance().Release(address);
+  }
+
   bool InsertEntry(const storage::Tuple *key, ItemPointer *value) override;
 
   bool DeleteEntry(const storage::Tuple *key, ItemPointer *value) override;
@@ -91,11 +102,24 @@ class BWTreeIndex : public Index {
                  uint64_t limit,
                  uint64_t offset) override;
 
+  bool ScanKeyValues(
+      const std::vector<type::Value> &value_list,
+      const std::vector<oid_t> &tuple_column_id_list,
+      const std::vector<ExpressionType> &expr_list,
+      ScanDirectionType scan_direction,
+      std::vector<std::pair<std::shared_ptr<storage::Tuple>, ItemPointer *>>
+          &result,
+      const ConjunctionScanPredicate *csp_p,
+      type::AbstractPool *pool) override;
+
   void ScanAllKeys(std::vector<ValueType> &result) override;
 
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result) override;
 
+  void ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                std::vector<ValueType> &result) override;
+
   std::string GetTypeName() const override;
 
   // TODO: Implement this
@@ -112,6 +136,29 @@ class BWTreeIndex : public Index {
     return;
   }
 
+  size_t ConsolidateLongChains(int chain_length_threshold) override {
+    return container.ConsolidateLongChains(chain_length_threshold,
+                                           chain_length_threshold);
+  }
+
+ private:
+  // Walks the key range [index_low_key, index_high_key] in descending key
+  // order by stepping the iterator backward along the leaf sibling chain,
+  // starting from the last qualifying entry. The callback is invoked once
+  // per entry and stops the walk by returning false
+  template <typename Callback>
+  void ScanRangeDescending(const KeyType &index_low_key,
+                           const KeyType &index_high_key, Callback &&callback);
+
+  // Forward walk over [low key, high key] that enumerates the distinct
+  // values of the given unconstrained key prefix via leaf-level jumps,
+  // probing the bounded suffix range under each of them. Returns false
+  // without touching the result if the key type cannot reproduce key
+  // values, in which case the caller falls back to the plain range walk
+  bool ScanSkip(const storage::Tuple *low_key_p,
+                const storage::Tuple *high_key_p, oid_t prefix_column_count,
+                std::vector<ValueType> &result);
+
  protected:
   // equality checker and comparator
   KeyComparator comparator;
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "util/string_util.h"
@@ -40,6 +42,14 @@ namespace index {
  * For details of how and why integers must be stored in a big-endian and
  * sign-magnitude format, please refer to adaptive radix tree's key format
  *
+ * Bounded-length VARCHAR fields may be packed alongside the integers: the
+ * string is stored as a zero padded byte run sized by the column's declared
+ * maximum length, which preserves order under memcmp (the padding ranks a
+ * short string before every longer string sharing its prefix, exactly like
+ * VARCHAR comparison). Since the run always covers the whole bounded string,
+ * a tie on the packed bytes is a true tie and no fallback comparison on the
+ * full key is ever needed
+ *
  * Note: CompactIntsKey should always be aligned to 64 bit boundaries; There
  * are static assertion to enforce this rule
  */
@@ -264,6 +274,28 @@ class CompactIntsKey {
     return;
   }
 
+  /*
+   * AddString() - Adds a zero padded, order-preserving byte run for a
+   *               bounded-length string
+   *
+   * The run occupies exactly width bytes no matter how long the actual
+   * string is, so the layout of later fields does not depend on the data
+   */
+  inline void AddString(const char *data, size_t length, size_t offset,
+                        size_t width) {
+    PL_ASSERT(length <= width);
+
+    if (data != nullptr && length > 0) {
+      memcpy(key_data + offset, data, length);
+    }
+
+    // ZeroOut() has been called before packing starts, but the key object
+    // might be reused for a longer string, so always pad explicitly
+    memset(key_data + offset + length, 0x00, width - length);
+
+    return;
+  }
+
   /*
    * GetInteger() - Extracts an integer from the given offset
    *
@@ -409,6 +441,21 @@ class CompactIntsKey {
 
         break;
       }
+      case type::TypeId::VARCHAR: {
+        // The packed width is the declared maximum length, so the run
+        // always covers the whole string; the factory has verified that
+        // every key column fits into the key before choosing this class
+        size_t width = key_schema->GetColumn(key_column_id).GetLength();
+
+        type::Value value = tuple->GetValue(tuple_column_id);
+        const char *data = value.IsNull() ? nullptr : value.GetData();
+        size_t length = (data == nullptr) ? 0 : strlen(data);
+
+        AddString(data, std::min(length, width), offset, width);
+        offset += width;
+
+        break;
+      }
       default: {
         throw IndexException(
             "We currently only support a specific set of "
@@ -438,7 +485,8 @@ class CompactIntsKey {
     ZeroOut();
 
     // This returns schema of the tuple
-    // Note that the schema must contain only integral type
+    // Note that the schema must contain only integral types and
+    // bounded-length VARCHARs
     const catalog::Schema *key_schema = tuple->GetSchema();
 
     // Need this to loop through columns
@@ -557,6 +605,19 @@ class CompactIntsKey {
 
           break;
         }
+        case type::TypeId::VARCHAR: {
+          size_t width = key_schema->GetColumn(column_id).GetLength();
+
+          const char *data = reinterpret_cast<const char *>(key_data + offset);
+          size_t length = strnlen(data, width);
+
+          tuple.SetValue(column_id, type::ValueFactory::GetVarcharValue(
+                                        std::string(data, length)));
+
+          offset += width;
+
+          break;
+        }
         default: {
           throw IndexException(
               "We currently only support a specific set of "
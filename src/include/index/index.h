@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/internal_types.h"
@@ -226,6 +227,21 @@ class Index : public Printable {
   virtual bool InsertEntry(const storage::Tuple *key,
                            ItemPointer *location_ptr) = 0;
 
+  /**
+   * Insert a batch of key-value pairs into the index. The entries must be
+   * sorted by key. The default implementation inserts them one at a time,
+   * which for tree and skip-list indexes still benefits from the locality of
+   * the sorted order; index implementations may override this with a
+   * bottom-up bulk build. This is designed for bulk loads into secondary
+   * indexes and performs no uniqueness checks.
+   *
+   * @param entries The key-value pairs to insert, sorted by key
+   * @return True if every entry was inserted successfully
+   */
+  virtual bool BulkInsertEntries(
+      const std::vector<std::pair<std::unique_ptr<storage::Tuple>,
+                                  ItemPointer *>> &entries);
+
   /**
    * Delete the given key-value pair from the index
    *
@@ -301,6 +317,33 @@ class Index : public Printable {
                          const ConjunctionScanPredicate *csp_p, uint64_t limit,
                          uint64_t offset) = 0;
 
+  /**
+   * Like Scan(), but additionally returns a materialized copy of each
+   * matching entry's index key, so a covering (index-only) scan can build
+   * its output without fetching base tuples. Returns false when the index
+   * cannot reproduce key values (callers must then fall back to Scan()).
+   *
+   * @param value_list A list of bound key column values
+   * @param tuple_column_id_list A list of column IDs to bind values to
+   * @param expr_list A list of expressions used to when performing the
+   * comparison of the key column and the value from the provided list
+   * @param scan_direction The direction to perform the scan
+   * @param[out] result Key copies paired with the entries' item pointers
+   * @param scan_predicate The only predicate that's actually used.
+   * @param pool Pool to allocate the key copies' variable-length data from
+   */
+  virtual bool ScanKeyValues(
+      UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+      UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+      UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+      UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
+      UNUSED_ATTRIBUTE std::vector<
+          std::pair<std::shared_ptr<storage::Tuple>, ItemPointer *>> &result,
+      UNUSED_ATTRIBUTE const ConjunctionScanPredicate *scan_predicate,
+      UNUSED_ATTRIBUTE type::AbstractPool *pool) {
+    return false;
+  }
+
   /**
    * This is the version used to test the basic scan operation. Since it does a
    * scan planning every time it is invoked, it will be slower than the regular
@@ -334,6 +377,19 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  /**
+   * Batched point lookup: finds the values for every key in the batch and
+   * appends them to the result vector. The base implementation probes the
+   * keys one by one through ScanKey(); concrete indexes override it to sort
+   * the batch first so that adjacent probes share upper-level traversal
+   * paths in cache.
+   *
+   * @param keys Keys to probe; the batch may be reordered internally
+   * @param[out] result Where the results of all probes are stored
+   */
+  virtual void ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                        std::vector<ItemPointer *> &result);
+
   //////////////////////////////////////////////////////////////////////////////
   /// Garbage Collection
   //////////////////////////////////////////////////////////////////////////////
@@ -352,6 +408,20 @@ class Index : public Printable {
    */
   virtual void PerformGC() = 0;
 
+  /**
+   * @brief Consolidate delta chains that have grown to at least the given
+   * length, off the critical path of readers and writers. Only meaningful
+   * for delta-chain based indexes (e.g. the Bw-Tree); the default
+   * implementation does nothing.
+   *
+   * @param chain_length_threshold Minimum chain length to consolidate
+   * @return The number of chains consolidated
+   */
+  virtual size_t ConsolidateLongChains(
+      UNUSED_ATTRIBUTE int chain_length_threshold) {
+    return 0;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// Stats
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_consolidator.h
+//
+// Identification: src/include/index/index_consolidator.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace index {
+
+//===--------------------------------------------------------------------===//
+// Index Consolidator
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Background delta-chain consolidation service.
+ *
+ * Delta-based indexes (the Bw-Tree) normally consolidate a long delta chain
+ * inline on whichever reader or writer happens to notice it, injecting
+ * latency spikes into foreground operations. This service periodically walks
+ * every index in the system and hands per-index consolidation work to the
+ * MonoQueuePool workers, so long chains are collapsed off the critical path.
+ *
+ * The chain-length threshold and the pass interval are read from the
+ * settings manager on every pass, so both can be tuned at runtime.
+ */
+class IndexConsolidator {
+ public:
+  IndexConsolidator(const IndexConsolidator &) = delete;
+  IndexConsolidator &operator=(const IndexConsolidator &) = delete;
+  IndexConsolidator(IndexConsolidator &&) = delete;
+  IndexConsolidator &operator=(IndexConsolidator &&) = delete;
+
+  IndexConsolidator();
+
+  ~IndexConsolidator();
+
+  /**
+   * Singleton
+   *
+   * @return     The instance.
+   */
+  static IndexConsolidator &GetInstance();
+
+  /**
+   * Start the background consolidation thread
+   */
+  void Start();
+
+  /**
+   * Consolidation loop
+   */
+  void Consolidate();
+
+  /**
+   * Stop the background consolidation thread
+   */
+  void Stop();
+
+  /**
+   * Total number of delta chains consolidated by this service
+   */
+  uint64_t GetTotalConsolidatedCount() const {
+    return total_consolidated_count_.load();
+  }
+
+  /**
+   * Number of scan passes the service has completed
+   */
+  uint64_t GetPassCount() const { return pass_count_.load(); }
+
+ private:
+  /**
+   * Submit one consolidation task per index in the system to the worker
+   * pool, using the given chain-length threshold
+   */
+  void SubmitConsolidationTasks(int chain_length_threshold);
+
+ private:
+  /**
+   * Stop signal
+   */
+  std::atomic<bool> consolidation_stop_;
+
+  /**
+   * Consolidator thread
+   */
+  std::thread consolidator_thread_;
+
+  /**
+   * Consolidation statistics
+   */
+  std::atomic<uint64_t> total_consolidated_count_;
+  std::atomic<uint64_t> pass_count_;
+};
+
+}  // namespace index
+}  // namespace peloton
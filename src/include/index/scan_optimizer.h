@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 #include "catalog/schema.h"
@@ -85,6 +87,14 @@ class ConjunctionScanPredicate {
   // filter tuples using its full predicate
   bool full_index_scan_;
 
+  // The number of leading index key columns that the predicate leaves
+  // completely unconstrained while constraining at least one later column.
+  // Such an interval degenerates to (almost) the whole index, but the index
+  // can instead enumerate the distinct values of the unconstrained prefix
+  // and probe the bounded suffix range under each of them (a "skip scan").
+  // Zero means the interval is not skip-scannable
+  oid_t skip_prefix_column_count_;
+
   // These two represents low key and high key of the predicate scan
   // We fill in these two values using the information available as much as
   // we can, and if there are still values missing (that needs to be bound at
@@ -171,6 +181,9 @@ class ConjunctionScanPredicate {
 
       // This must hold since full table scan could not be point query
       is_point_query_ = false;
+
+      // There is no interval, so there is no skip-scannable prefix either
+      skip_prefix_column_count_ = 0;
     }
 
     return;
@@ -188,9 +201,17 @@ class ConjunctionScanPredicate {
     high_key_bind_list_ = other.high_key_bind_list_;
     is_point_query_ = other.is_point_query_;
     full_index_scan_ = other.full_index_scan_;
+    skip_prefix_column_count_ = other.skip_prefix_column_count_;
 
-    low_key_p_ = new storage::Tuple(*(other.low_key_p_));
-    high_key_p_ = new storage::Tuple(*(other.high_key_p_));
+    // A full index scan conjunction never allocated its keys, so there
+    // is nothing to copy in that case
+    if (other.low_key_p_ != nullptr) {
+      low_key_p_ = new storage::Tuple(*(other.low_key_p_));
+      high_key_p_ = new storage::Tuple(*(other.high_key_p_));
+    } else {
+      low_key_p_ = nullptr;
+      high_key_p_ = nullptr;
+    }
   }
 
   /*
@@ -204,9 +225,20 @@ class ConjunctionScanPredicate {
     high_key_bind_list_ = other.high_key_bind_list_;
     is_point_query_ = other.is_point_query_;
     full_index_scan_ = other.full_index_scan_;
+    skip_prefix_column_count_ = other.skip_prefix_column_count_;
 
-    low_key_p_ = new storage::Tuple(*(other.low_key_p_));
-    high_key_p_ = new storage::Tuple(*(other.high_key_p_));
+    // Drop this instance's own keys before taking copies of the other's;
+    // for a full index scan conjunction there is nothing to copy
+    delete low_key_p_;
+    delete high_key_p_;
+
+    if (other.low_key_p_ != nullptr) {
+      low_key_p_ = new storage::Tuple(*(other.low_key_p_));
+      high_key_p_ = new storage::Tuple(*(other.high_key_p_));
+    } else {
+      low_key_p_ = nullptr;
+      high_key_p_ = nullptr;
+    }
 
     return *this;
   }
@@ -392,6 +424,8 @@ class ConjunctionScanPredicate {
 
     LOG_TRACE("Constructing scan interval. Point query = %d", is_point_query_);
 
+    skip_prefix_column_count_ = 0;
+
     // For each column in the index key, if there is not a bound
     // representable as Value object then we use min and max of the
     // corresponding type
@@ -451,6 +485,23 @@ class ConjunctionScanPredicate {
       }  // if is point query == false
     }    // for index_pair in the list
 
+    // Detect a skip-scannable prefix: leading key columns with neither
+    // bound specified (filled with -Inf/+Inf above), followed by at least
+    // one column that has a bound. The loop stops at the first constrained
+    // column, so prefix_itr < size guarantees one exists
+    if (is_point_query_ == false) {
+      oid_t prefix_itr = 0;
+      while (prefix_itr < value_index_list_.size() &&
+             value_index_list_[prefix_itr].first == INVALID_OID &&
+             value_index_list_[prefix_itr].second == INVALID_OID) {
+        prefix_itr++;
+      }
+
+      if (prefix_itr > 0 && prefix_itr < value_index_list_.size()) {
+        skip_prefix_column_count_ = prefix_itr;
+      }
+    }
+
     return;
   }
 
@@ -533,6 +584,24 @@ class ConjunctionScanPredicate {
    */
   inline bool IsPointQuery() const { return is_point_query_; }
 
+  /*
+   * IsSkipScannable() - Returns whether the scan interval leaves a key
+   *                     prefix unconstrained while constraining the suffix
+   *
+   * For such intervals the index may enumerate the distinct prefix values
+   * and probe the bounded suffix range under each, instead of walking the
+   * degenerate whole-index interval entry by entry
+   */
+  inline bool IsSkipScannable() const { return skip_prefix_column_count_ > 0; }
+
+  /*
+   * GetSkipPrefixColumnCount() - Returns the length of the unconstrained
+   *                              key prefix, 0 if not skip-scannable
+   */
+  inline oid_t GetSkipPrefixColumnCount() const {
+    return skip_prefix_column_count_;
+  }
+
   /*
    * GetLowKey() - Returns the scan low key if this is not a point query
    *
@@ -581,6 +650,61 @@ class ConjunctionScanPredicate {
   inline size_t GetBindingCount() const {
     return low_key_bind_list_.size() + high_key_bind_list_.size();
   }
+
+  /*
+   * CompareLowKeys() - Three way comparison between this conjunction's
+   *                    low key and another conjunction's low key
+   *
+   * Both conjunctions must come from the same index, and neither could be
+   * a full index scan since in that case there is no key to compare
+   */
+  int CompareLowKeys(const ConjunctionScanPredicate &other) const {
+    PL_ASSERT(full_index_scan_ == false);
+    PL_ASSERT(other.full_index_scan_ == false);
+
+    return low_key_p_->Compare(*other.low_key_p_);
+  }
+
+  /*
+   * TryAbsorb() - Merges another conjunction's scan interval into this one
+   *
+   * The caller must guarantee that both conjunctions are fully bound, that
+   * neither is a full index scan, and that this conjunction's low key is
+   * not greater than the other's, i.e. intervals are absorbed in low key
+   * order.
+   *
+   * Returns true if the other interval overlaps with this one and has been
+   * absorbed, such that this conjunction's interval now covers both.
+   * Returns false if the two intervals are disjoint and the other one must
+   * stay as a separate probe
+   */
+  bool TryAbsorb(const ConjunctionScanPredicate &other) {
+    PL_ASSERT(full_index_scan_ == false);
+    PL_ASSERT(other.full_index_scan_ == false);
+    PL_ASSERT(GetBindingCount() == 0 && other.GetBindingCount() == 0);
+    PL_ASSERT(low_key_p_->Compare(*other.low_key_p_) <= 0);
+
+    // Disjoint: the other interval begins after this one ends
+    if (other.low_key_p_->Compare(*high_key_p_) > 0) {
+      return false;
+    }
+
+    // Overlap: extend this interval if the other one reaches further
+    if (other.high_key_p_->Compare(*high_key_p_) > 0) {
+      delete high_key_p_;
+      high_key_p_ = new storage::Tuple(*(other.high_key_p_));
+
+      // The interval now covers more than a single key
+      is_point_query_ = false;
+    }
+
+    // The merged interval no longer reflects this conjunction's per-column
+    // bounds, so per-prefix probing with the original suffix bounds would
+    // not cover it; fall back to the plain range walk
+    skip_prefix_column_count_ = 0;
+
+    return true;
+  }
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -686,6 +810,136 @@ class IndexScanPredicate {
     return;
   }
 
+  /*
+   * MergeConjunctions() - Coalesces overlapping scan intervals
+   *
+   * The conjunctions on the list are connected by disjunctions, so two
+   * probes whose intervals overlap would return the same keys more than
+   * once. This function sorts the intervals on their low key and absorbs
+   * every interval into an overlapping predecessor, which leaves a minimal
+   * list of disjoint probes ordered by low key - executing them front to
+   * back then yields the sorted union of all matches without any
+   * deduplication.
+   *
+   * Intervals that still wait for late binding are unknown until execution
+   * time, so the list is left untouched if any binding is pending (the
+   * same value placeholders may be bound again for the next execution).
+   * The same holds if the predicate has already degraded into a full index
+   * scan. In both cases ScanUnion() deduplicates the probe results instead
+   */
+  void MergeConjunctions() {
+    if (full_index_scan_ == true || conjunction_list_.size() <= 1) {
+      return;
+    }
+
+    for (const ConjunctionScanPredicate &conjunction_item :
+         conjunction_list_) {
+      if (conjunction_item.GetBindingCount() != 0) {
+        return;
+      }
+    }
+
+    // ConjunctionScanPredicate is not move-assignable, so sort an index
+    // array rather than the list itself
+    std::vector<size_t> order{};
+    for (size_t i = 0; i < conjunction_list_.size(); i++) {
+      order.push_back(i);
+    }
+
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return conjunction_list_[a].CompareLowKeys(conjunction_list_[b]) < 0;
+    });
+
+    std::vector<ConjunctionScanPredicate> merged_list{};
+    for (size_t index : order) {
+      if (merged_list.size() > 0 &&
+          merged_list.back().TryAbsorb(conjunction_list_[index]) == true) {
+        continue;
+      }
+
+      merged_list.push_back(conjunction_list_[index]);
+    }
+
+    LOG_TRACE("Merged %lu scan intervals into %lu disjoint probes",
+              conjunction_list_.size(), merged_list.size());
+
+    conjunction_list_.swap(merged_list);
+
+    return;
+  }
+
+  /*
+   * ScanUnion() - Executes one index probe per conjunction and collects
+   *               the union of all matches
+   *
+   * For a single conjunction (or a predicate that has degraded into a
+   * full index scan) this is exactly the scan the index already knows how
+   * to do. Otherwise every conjunction is probed in list order; since
+   * MergeConjunctions() leaves fully bound probes disjoint and sorted on
+   * their low key, the concatenation of probe results is already the
+   * sorted union. Probes that were late bound may still overlap, so
+   * repeated locations are dropped while preserving order.
+   *
+   * For a backward scan the disjoint probes are executed back to front,
+   * each probe itself running backward, so the concatenation comes out in
+   * descending key order
+   */
+  void ScanUnion(Index *index_p, const std::vector<type::Value> &value_list,
+                 const std::vector<oid_t> &tuple_column_id_list,
+                 const std::vector<ExpressionType> &expr_list,
+                 ScanDirectionType scan_direction,
+                 std::vector<ItemPointer *> &result) const {
+    PL_ASSERT(conjunction_list_.size() > 0);
+
+    if (conjunction_list_.size() == 1 || full_index_scan_ == true) {
+      // For a degraded predicate the conjunction handed to the index must
+      // be the one that requires the full scan
+      const ConjunctionScanPredicate *csp_p = &conjunction_list_[0];
+      if (full_index_scan_ == true) {
+        for (const ConjunctionScanPredicate &conjunction_item :
+             conjunction_list_) {
+          if (conjunction_item.IsFullIndexScan() == true) {
+            csp_p = &conjunction_item;
+            break;
+          }
+        }
+      }
+
+      index_p->Scan(value_list, tuple_column_id_list, expr_list,
+                    scan_direction, result, csp_p);
+
+      return;
+    }
+
+    if (scan_direction == ScanDirectionType::BACKWARD) {
+      for (auto conjunction_itr = conjunction_list_.rbegin();
+           conjunction_itr != conjunction_list_.rend(); conjunction_itr++) {
+        index_p->Scan(value_list, tuple_column_id_list, expr_list,
+                      scan_direction, result, &(*conjunction_itr));
+      }
+    } else {
+      for (const ConjunctionScanPredicate &conjunction_item :
+           conjunction_list_) {
+        index_p->Scan(value_list, tuple_column_id_list, expr_list,
+                      scan_direction, result, &conjunction_item);
+      }
+    }
+
+    // Keep only the first occurrence of every location so the order of
+    // probe results is preserved
+    std::unordered_set<ItemPointer *> seen_locations{};
+    size_t kept = 0;
+    for (ItemPointer *location_p : result) {
+      if (seen_locations.insert(location_p).second == true) {
+        result[kept++] = location_p;
+      }
+    }
+
+    result.resize(kept);
+
+    return;
+  }
+
   /*
    * GetConjunctionList() - Returns the conjunction list to caller
    *
@@ -12,6 +12,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/internal_types.h"
+#include "concurrency/epoch_manager_factory.h"
+
 namespace peloton {
 namespace index {
 
@@ -21,10 +30,594 @@ namespace index {
 #define SKIPLIST_TEMPLATE_ARGUMENTS                                       \
   template <typename KeyType, typename ValueType, typename KeyComparator, \
             typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class SkipList - Lock-free skiplist mapping keys to values
+ *
+ * The list is a multi-level linked list with towers of atomically updated
+ * forward pointers. Deletion follows the Harris/Herlihy-Shavit scheme: a
+ * node is logically deleted by setting the mark bit (the low pointer bit)
+ * in its forward pointers from the top level down, with the bottom-level
+ * mark deciding the winner among racing deleters; traversals physically
+ * unlink marked nodes as they pass by, so no operation ever blocks.
+ *
+ * Duplicate keys are supported - the index layer stores one node per
+ * (key, ItemPointer) pair, and nodes with equal keys form a run at the
+ * bottom level. Same-key insertions serialize on the run's predecessor
+ * pointer, which makes ConditionalInsert() atomic with respect to
+ * concurrent insertions of the same key.
+ *
+ * Memory reclamation is tied to the transactional epoch: an unlinked node
+ * is stamped with concurrency::EpochManager's current epoch id and only
+ * freed once GetExpiredEpochId() has passed it - the same rule the garbage
+ * collector applies to tuple versions. Index operations always run inside
+ * a registered transaction epoch, so a traversal can never hold a pointer
+ * to memory freed underneath it.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
           typename KeyEqualityChecker, typename ValueEqualityChecker>
 class SkipList {
-  // TODO: Add your declarations here
+ public:
+  // Tall enough for tens of millions of entries at p = 1/2
+  static const int kMaxLevel = 16;
+
+ private:
+  /*
+   * struct Node - Skiplist node with an embedded tower of forward pointers
+   */
+  struct Node {
+    KeyType key;
+    ValueType value;
+
+    // Number of levels this node participates in (1 .. kMaxLevel)
+    int level_count;
+
+    // Epoch the node was retired in; only meaningful on the garbage list
+    eid_t retire_epoch;
+
+    // Chains retired nodes on the garbage list
+    Node *garbage_next;
+
+    // Forward pointers; the low bit marks the node logically deleted at
+    // that level
+    std::atomic<Node *> next[kMaxLevel];
+
+    Node(const KeyType &node_key, const ValueType &node_value, int levels)
+        : key(node_key),
+          value(node_value),
+          level_count(levels),
+          retire_epoch(INVALID_EID),
+          garbage_next(nullptr) {
+      for (int i = 0; i < kMaxLevel; i++) {
+        next[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // Marked pointer helpers
+  ///////////////////////////////////////////////////////////////////
+
+  static inline Node *GetAddress(Node *p) {
+    return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(p) &
+                                    ~static_cast<uintptr_t>(1));
+  }
+
+  static inline bool IsMarked(Node *p) {
+    return (reinterpret_cast<uintptr_t>(p) & 1) != 0;
+  }
+
+  static inline Node *Marked(Node *p) {
+    return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(p) | 1);
+  }
+
+ public:
+  SkipList(KeyComparator p_key_cmp_obj = KeyComparator{},
+           KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+           ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_cmp_obj{p_key_cmp_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        head_{new Node{KeyType{}, ValueType{}, kMaxLevel}},
+        node_count_{0},
+        garbage_head_{nullptr},
+        garbage_count_{0},
+        garbage_draining_{false} {}
+
+  ~SkipList() {
+    // Single threaded at this point: free the bottom level chain, marked
+    // or not, and then whatever sits on the garbage list (retired nodes
+    // are already unlinked, so there is no double free)
+    Node *node_p = GetAddress(head_->next[0].load());
+    while (node_p != nullptr) {
+      Node *next_p = GetAddress(node_p->next[0].load());
+      delete node_p;
+      node_p = next_p;
+    }
+
+    Node *garbage_p = garbage_head_.load();
+    while (garbage_p != nullptr) {
+      Node *next_p = garbage_p->garbage_next;
+      delete garbage_p;
+      garbage_p = next_p;
+    }
+
+    delete head_;
+  }
+
+  SkipList(const SkipList &) = delete;
+  SkipList &operator=(const SkipList &) = delete;
+
+  ///////////////////////////////////////////////////////////////////
+  // Mutators
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * Insert() - Insert a key-value pair
+   *
+   * Returns false without inserting if the exact pair already exists.
+   */
+  bool Insert(const KeyType &key, const ValueType &value) {
+    return InsertInternal(key, value, nullptr, nullptr);
+  }
+
+  /*
+   * ConditionalInsert() - Insert a key-value pair only if no existing value
+   * under the key satisfies the predicate
+   *
+   * Sets *predicate_satisfied and returns false when an existing value
+   * under the key passes the predicate. The check and the insertion are
+   * atomic with respect to concurrent same-key insertions.
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    *predicate_satisfied = false;
+    return InsertInternal(key, value, &predicate, predicate_satisfied);
+  }
+
+  /*
+   * Delete() - Remove the node holding the exact key-value pair
+   *
+   * Returns false if no live node holds the pair.
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+
+    while (true) {
+      // Locate a live node holding the pair inside the key's run
+      Find(key, nullptr, preds, succs);
+      Node *victim_p = nullptr;
+      for (Node *curr_p = succs[0];
+           curr_p != nullptr && key_eq_obj(curr_p->key, key);
+           curr_p = GetAddress(curr_p->next[0].load())) {
+        if (value_eq_obj(curr_p->value, value) &&
+            IsMarked(curr_p->next[0].load()) == false) {
+          victim_p = curr_p;
+          break;
+        }
+      }
+
+      if (victim_p == nullptr) {
+        return false;
+      }
+
+      // Mark the upper levels top-down; nobody contends for the outcome
+      // here - the bottom level decides
+      for (int level = victim_p->level_count - 1; level >= 1; level--) {
+        Node *succ_p = victim_p->next[level].load();
+        while (IsMarked(succ_p) == false) {
+          victim_p->next[level].compare_exchange_weak(succ_p, Marked(succ_p));
+        }
+      }
+
+      // Mark the bottom level; the winning CAS owns the deletion
+      Node *succ_p = victim_p->next[0].load();
+      while (true) {
+        if (IsMarked(succ_p)) {
+          // Another deleter won this node; retry in case a different
+          // live node holds the same pair
+          break;
+        }
+
+        if (victim_p->next[0].compare_exchange_strong(succ_p,
+                                                      Marked(succ_p))) {
+          // Physically unlink at every level, then hand the node to the
+          // epoch based garbage list
+          Find(key, victim_p, preds, succs);
+          node_count_.fetch_sub(1, std::memory_order_relaxed);
+          RetireNode(victim_p);
+          return true;
+        }
+      }
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Lookup
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * GetValue() - Collect all values stored under the key
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+
+    Find(key, nullptr, preds, succs);
+    for (Node *curr_p = succs[0];
+         curr_p != nullptr && key_eq_obj(curr_p->key, key);
+         curr_p = GetAddress(curr_p->next[0].load())) {
+      if (IsMarked(curr_p->next[0].load()) == false) {
+        value_list.push_back(curr_p->value);
+      }
+    }
+
+    return;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Iteration
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * class ForwardIterator - Bottom level traversal in key order, skipping
+   * logically deleted nodes
+   *
+   * The iterator is only safe inside the epoch of the transaction that
+   * created it, like any other index traversal.
+   */
+  class ForwardIterator {
+   public:
+    ForwardIterator() : node_p_(nullptr) {}
+
+    bool IsEnd() const { return node_p_ == nullptr; }
+
+    const KeyType &GetKey() const { return node_p_->key; }
+
+    const ValueType &GetValue() const { return node_p_->value; }
+
+    ForwardIterator &operator++() {
+      node_p_ = SkipMarked(GetAddress(node_p_->next[0].load()));
+      return *this;
+    }
+
+    ForwardIterator operator++(int) {
+      ForwardIterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+   private:
+    friend class SkipList;
+
+    explicit ForwardIterator(Node *node_p) : node_p_(SkipMarked(node_p)) {}
+
+    static Node *SkipMarked(Node *node_p) {
+      while (node_p != nullptr && IsMarked(node_p->next[0].load())) {
+        node_p = GetAddress(node_p->next[0].load());
+      }
+      return node_p;
+    }
+
+    Node *node_p_;
+  };
+
+  /*
+   * Begin() - Iterator positioned on the smallest key
+   */
+  ForwardIterator Begin() {
+    return ForwardIterator{GetAddress(head_->next[0].load())};
+  }
+
+  /*
+   * Begin() - Iterator positioned on the first key >= start_key
+   */
+  ForwardIterator Begin(const KeyType &start_key) {
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+
+    Find(start_key, nullptr, preds, succs);
+    return ForwardIterator{succs[0]};
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Key comparison wrappers
+  ///////////////////////////////////////////////////////////////////
+
+  inline bool KeyCmpLess(const KeyType &key1, const KeyType &key2) const {
+    return key_cmp_obj(key1, key2);
+  }
+
+  inline bool KeyCmpEqual(const KeyType &key1, const KeyType &key2) const {
+    return key_eq_obj(key1, key2);
+  }
+
+  inline bool KeyCmpLessEqual(const KeyType &key1, const KeyType &key2) const {
+    return KeyCmpLess(key1, key2) || KeyCmpEqual(key1, key2);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Statistics & maintenance
+  ///////////////////////////////////////////////////////////////////
+
+  size_t GetNodeCount() const {
+    return node_count_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetMemoryFootprint() const { return GetNodeCount() * sizeof(Node); }
+
+  size_t GetGarbageCount() const {
+    return garbage_count_.load(std::memory_order_relaxed);
+  }
+
+  /*
+   * PerformGarbageCollection() - Free retired nodes whose epoch the
+   * transactional epoch manager has expired
+   */
+  void PerformGarbageCollection() { DrainGarbage(); }
+
+ private:
+  /*
+   * Find() - Compute the predecessor/successor window of a key at every
+   * level, physically unlinking marked nodes along the way
+   *
+   * With stop_node_p == nullptr the successor at each level is the first
+   * node whose key is >= the search key. With stop_node_p set, traversal
+   * within the key's run continues until the given node, so the window
+   * brackets that exact node - used to unlink a specific victim or to
+   * re-link a partially inserted tower among duplicate keys.
+   */
+  void Find(const KeyType &key, const Node *stop_node_p, Node **preds,
+            Node **succs) {
+  retry:
+    Node *pred_p = head_;
+    for (int level = kMaxLevel - 1; level >= 0; level--) {
+      Node *curr_p = GetAddress(pred_p->next[level].load());
+      while (curr_p != nullptr) {
+        Node *succ_p = curr_p->next[level].load();
+
+        // Unlink any run of marked nodes in front of us
+        while (IsMarked(succ_p)) {
+          Node *unmarked_succ_p = GetAddress(succ_p);
+          Node *expected_p = curr_p;
+          if (pred_p->next[level].compare_exchange_strong(
+                  expected_p, unmarked_succ_p) == false) {
+            goto retry;
+          }
+
+          curr_p = unmarked_succ_p;
+          if (curr_p == nullptr) {
+            break;
+          }
+          succ_p = curr_p->next[level].load();
+        }
+
+        if (curr_p == nullptr) {
+          break;
+        }
+
+        if (key_cmp_obj(curr_p->key, key) ||
+            (stop_node_p != nullptr && curr_p != stop_node_p &&
+             key_eq_obj(curr_p->key, key))) {
+          pred_p = curr_p;
+          curr_p = GetAddress(succ_p);
+        } else {
+          break;
+        }
+      }
+
+      preds[level] = pred_p;
+      succs[level] = curr_p;
+    }
+
+    return;
+  }
+
+  /*
+   * InsertInternal() - Shared implementation of Insert() and
+   * ConditionalInsert()
+   */
+  bool InsertInternal(const KeyType &key, const ValueType &value,
+                      std::function<bool(const void *)> *predicate,
+                      bool *predicate_satisfied) {
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    Node *node_p = nullptr;
+    const int node_level = GetRandomLevel();
+
+    while (true) {
+      Find(key, nullptr, preds, succs);
+
+      // Walk the key's run: reject exact duplicates, and for conditional
+      // insertion test the predicate against every live value
+      bool rejected = false;
+      for (Node *curr_p = succs[0];
+           curr_p != nullptr && key_eq_obj(curr_p->key, key);
+           curr_p = GetAddress(curr_p->next[0].load())) {
+        if (IsMarked(curr_p->next[0].load())) {
+          continue;
+        }
+
+        if (predicate != nullptr && (*predicate)(curr_p->value)) {
+          *predicate_satisfied = true;
+          rejected = true;
+          break;
+        }
+
+        if (value_eq_obj(curr_p->value, value)) {
+          rejected = true;
+          break;
+        }
+      }
+
+      if (rejected == true) {
+        delete node_p;
+        return false;
+      }
+
+      if (node_p == nullptr) {
+        node_p = new Node{key, value, node_level};
+      }
+      for (int level = 0; level < node_level; level++) {
+        node_p->next[level].store(succs[level], std::memory_order_relaxed);
+      }
+
+      // Linking the bottom level publishes the node. Same-key insertions
+      // race on the same predecessor pointer, so losing this CAS re-runs
+      // the duplicate/predicate checks above before trying again.
+      Node *expected_p = succs[0];
+      if (preds[0]->next[0].compare_exchange_strong(expected_p, node_p) ==
+          false) {
+        continue;
+      }
+
+      node_count_.fetch_add(1, std::memory_order_relaxed);
+
+      // Link the upper levels; a concurrent deletion of the fresh node
+      // marks its pointers, at which point we stop linking
+      for (int level = 1; level < node_level; level++) {
+        while (true) {
+          Node *succ_p = succs[level];
+          Node *current_next_p = node_p->next[level].load();
+          if (IsMarked(current_next_p)) {
+            return true;
+          }
+
+          if (current_next_p != succ_p) {
+            if (node_p->next[level].compare_exchange_strong(
+                    current_next_p, succ_p) == false) {
+              continue;
+            }
+          }
+
+          Node *link_expected_p = succ_p;
+          if (preds[level]->next[level].compare_exchange_strong(
+                  link_expected_p, node_p)) {
+            break;
+          }
+
+          // The window moved under us; recompute it around our node
+          Find(key, node_p, preds, succs);
+        }
+      }
+
+      return true;
+    }
+  }
+
+  /*
+   * GetRandomLevel() - Geometric tower height with p = 1/2
+   *
+   * Uses a cheap per-thread xorshift generator; statistical quality is
+   * irrelevant here.
+   */
+  static int GetRandomLevel() {
+    static thread_local uint64_t state =
+        0x9E3779B97F4A7C15ULL ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    int level = 1;
+    uint64_t bits = state;
+    while ((bits & 1) == 1 && level < kMaxLevel) {
+      level++;
+      bits >>= 1;
+    }
+
+    return level;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Epoch-based reclamation
+  ///////////////////////////////////////////////////////////////////
+
+  // Accumulate this many retired nodes before trying to free any
+  static const size_t kGarbageDrainThreshold = 1024;
+
+  /*
+   * RetireNode() - Stamp an unlinked node with the current transactional
+   * epoch and park it on the garbage list
+   */
+  void RetireNode(Node *node_p) {
+    node_p->retire_epoch =
+        concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+    Node *head_node_p = garbage_head_.load();
+    do {
+      node_p->garbage_next = head_node_p;
+    } while (garbage_head_.compare_exchange_weak(head_node_p, node_p) ==
+             false);
+
+    if (garbage_count_.fetch_add(1, std::memory_order_relaxed) + 1 >=
+        kGarbageDrainThreshold) {
+      DrainGarbage();
+    }
+
+    return;
+  }
+
+  /*
+   * DrainGarbage() - Free retired nodes whose epoch has expired
+   *
+   * Detaches the whole garbage list, frees what the epoch manager allows
+   * and pushes the remainder back. Only one drainer runs at a time.
+   */
+  void DrainGarbage() {
+    bool expected = false;
+    if (garbage_draining_.compare_exchange_strong(expected, true) == false) {
+      return;
+    }
+
+    Node *node_p = garbage_head_.exchange(nullptr);
+    eid_t expired_eid =
+        concurrency::EpochManagerFactory::GetInstance().GetExpiredEpochId();
+
+    size_t freed_count = 0;
+    while (node_p != nullptr) {
+      Node *next_p = node_p->garbage_next;
+      if (node_p->retire_epoch <= expired_eid) {
+        delete node_p;
+        freed_count++;
+      } else {
+        // Still potentially visible to a live transaction; push it back
+        Node *head_node_p = garbage_head_.load();
+        do {
+          node_p->garbage_next = head_node_p;
+        } while (garbage_head_.compare_exchange_weak(head_node_p, node_p) ==
+                 false);
+      }
+      node_p = next_p;
+    }
+
+    garbage_count_.fetch_sub(freed_count, std::memory_order_relaxed);
+    garbage_draining_.store(false);
+
+    return;
+  }
+
+ private:
+  // Key comparator
+  const KeyComparator key_cmp_obj;
+
+  // Raw key eq checker
+  const KeyEqualityChecker key_eq_obj;
+
+  // Check whether values are equivalent
+  const ValueEqualityChecker value_eq_obj;
+
+  // Sentinel whose tower spans every level; its key is never inspected
+  Node *head_;
+
+  // Number of live (inserted and not yet deleted) nodes
+  std::atomic<size_t> node_count_;
+
+  // Retired nodes awaiting epoch expiry
+  std::atomic<Node *> garbage_head_;
+  std::atomic<size_t> garbage_count_;
+  std::atomic<bool> garbage_draining_;
 };
 
 }  // namespace index
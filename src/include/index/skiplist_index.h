@@ -76,16 +76,16 @@ class SkipListIndex : public Index {
 
   void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
 
+  void ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                std::vector<ValueType> &result);
+
   std::string GetTypeName() const;
 
-  // TODO: Implement this
-  size_t GetMemoryFootprint() { return 0; }
+  size_t GetMemoryFootprint() { return container.GetMemoryFootprint(); }
 
-  // TODO: Implement this
-  bool NeedGC() { return false; }
+  bool NeedGC() { return container.GetGarbageCount() > 0; }
 
-  // TODO: Implement this
-  void PerformGC() { return; }
+  void PerformGC() { container.PerformGarbageCollection(); }
 
  protected:
   // equality checker and comparator
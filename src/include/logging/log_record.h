@@ -15,6 +15,8 @@
 #include "common/internal_types.h"
 #include "common/item_pointer.h"
 #include "common/macros.h"
+#include "type/serializeio.h"
+#include "type/value.h"
 
 namespace peloton {
 namespace logging {
@@ -26,13 +28,23 @@ namespace logging {
 class LogRecord {
   friend class LogRecordFactory;
 private:
-  LogRecord(LogRecordType log_type, const ItemPointer &pos, 
+  LogRecord(LogRecordType log_type, const ItemPointer &pos,
             const eid_t epoch_id, const cid_t commit_id)
-    : log_record_type_(log_type), 
-      tuple_pos_(pos), 
-      eid_(epoch_id), 
+    : log_record_type_(log_type),
+      tuple_pos_(pos),
+      eid_(epoch_id),
       cid_(commit_id) {}
 
+  LogRecord(LogRecordType log_type, const ItemPointer &pos,
+            const eid_t epoch_id, const cid_t commit_id,
+            const oid_t database_oid, const oid_t table_oid)
+    : log_record_type_(log_type),
+      tuple_pos_(pos),
+      eid_(epoch_id),
+      cid_(commit_id),
+      database_oid_(database_oid),
+      table_oid_(table_oid) {}
+
 public:
   virtual ~LogRecord() {}
 
@@ -44,12 +56,70 @@ public:
 
   inline void SetCommitId(const cid_t commit_id) { cid_ = commit_id; }
 
+  inline void SetOids(const oid_t database_oid, const oid_t table_oid) {
+    database_oid_ = database_oid;
+    table_oid_ = table_oid;
+  }
+
   inline const ItemPointer &GetItemPointer() { return tuple_pos_; }
 
   inline eid_t GetEpochId() { return eid_; }
 
   inline cid_t GetCommitId() { return cid_; }
 
+  inline oid_t GetDatabaseOid() const { return database_oid_; }
+
+  inline oid_t GetTableOid() const { return table_oid_; }
+
+  // Replay partition this record belongs to. Records are partitioned by
+  // table/tile-group affinity, so all records touching one tile group land
+  // in the same partition and can be replayed without coordination against
+  // the other partitions.
+  inline size_t GetPartitionId(const size_t partition_count) const {
+    return ((static_cast<size_t>(table_oid_) << 16) ^ tuple_pos_.block) %
+           partition_count;
+  }
+
+  // Fixed-size record header as it appears in the log file; any payload
+  // (e.g. tuple column values) is appended by the caller right behind it
+  inline void SerializeHeaderTo(SerializeOutput &output) const {
+    output.WriteEnumInSingleByte(
+        static_cast<int>(log_record_type_));
+    output.WriteLong(static_cast<int64_t>(cid_));
+    output.WriteInt(static_cast<int32_t>(database_oid_));
+    output.WriteInt(static_cast<int32_t>(table_oid_));
+    output.WriteInt(static_cast<int32_t>(tuple_pos_.block));
+    output.WriteInt(static_cast<int32_t>(tuple_pos_.offset));
+  }
+
+  // Delta update payload: the count of modified columns followed by
+  // (column id, value) pairs. Updates touching a few columns of a wide row
+  // log a fraction of the full image; writers fall back to a full-image
+  // TUPLE_UPDATE whenever the delta cannot be interpreted against a single
+  // schema version (e.g. inside a schema-change window).
+  inline static void SerializeDeltaPayloadTo(
+      SerializeOutput &output, const std::vector<oid_t> &column_ids,
+      const std::vector<type::Value> &values) {
+    PL_ASSERT(column_ids.size() == values.size());
+    output.WriteInt(static_cast<int32_t>(column_ids.size()));
+    for (size_t itr = 0; itr < column_ids.size(); itr++) {
+      output.WriteInt(static_cast<int32_t>(column_ids[itr]));
+      values[itr].SerializeTo(output);
+    }
+  }
+
+  inline static LogRecord DeserializeHeaderFrom(SerializeInput &input) {
+    LogRecordType log_type =
+        static_cast<LogRecordType>(input.ReadEnumInSingleByte());
+    cid_t commit_id = static_cast<cid_t>(input.ReadLong());
+    oid_t database_oid = static_cast<oid_t>(input.ReadInt());
+    oid_t table_oid = static_cast<oid_t>(input.ReadInt());
+    oid_t block = static_cast<oid_t>(input.ReadInt());
+    oid_t offset = static_cast<oid_t>(input.ReadInt());
+    return LogRecord(log_type, ItemPointer(block, offset), INVALID_EID,
+                     commit_id, database_oid, table_oid);
+  }
+
 private:
   LogRecordType log_record_type_;
 
@@ -58,18 +128,36 @@ private:
   eid_t eid_;
 
   cid_t cid_;
+
+  // Affinity tags used to partition records for parallel replay
+  oid_t database_oid_ = INVALID_OID;
+
+  oid_t table_oid_ = INVALID_OID;
 };
 
 
 class LogRecordFactory {
 public:
   static LogRecord CreateTupleRecord(const LogRecordType log_type, const ItemPointer &pos) {
-    PL_ASSERT(log_type == LogRecordType::TUPLE_INSERT || 
-              log_type == LogRecordType::TUPLE_DELETE || 
-              log_type == LogRecordType::TUPLE_UPDATE);
+    PL_ASSERT(log_type == LogRecordType::TUPLE_INSERT ||
+              log_type == LogRecordType::TUPLE_DELETE ||
+              log_type == LogRecordType::TUPLE_UPDATE ||
+              log_type == LogRecordType::TUPLE_UPDATE_DELTA);
     return LogRecord(log_type, pos, INVALID_EID, INVALID_CID);
   }
 
+  static LogRecord CreateTupleRecord(const LogRecordType log_type,
+                                     const ItemPointer &pos,
+                                     const oid_t database_oid,
+                                     const oid_t table_oid) {
+    PL_ASSERT(log_type == LogRecordType::TUPLE_INSERT ||
+              log_type == LogRecordType::TUPLE_DELETE ||
+              log_type == LogRecordType::TUPLE_UPDATE ||
+              log_type == LogRecordType::TUPLE_UPDATE_DELTA);
+    return LogRecord(log_type, pos, INVALID_EID, INVALID_CID, database_oid,
+                     table_oid);
+  }
+
   static LogRecord CreateTxnRecord(const LogRecordType log_type, const cid_t commit_id) {
     PL_ASSERT(log_type == LogRecordType::TRANSACTION_BEGIN || 
               log_type == LogRecordType::TRANSACTION_COMMIT);
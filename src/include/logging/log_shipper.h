@@ -0,0 +1,39 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_shipper.h
+//
+// Identification: src/include/logging/log_shipper.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Log Shipper
+//===--------------------------------------------------------------------===//
+
+// Follower endpoint of the log-shipping pipeline. The leader's log writer
+// hands every group-commit batch it has made durable to the registered
+// shippers, in commit order; an implementation forwards the bytes to a
+// follower instance (e.g. through the network service's SendData RPC),
+// where LogicalLogManager::ApplyShippedBatch() installs them.
+class LogShipper {
+ public:
+  virtual ~LogShipper() {}
+
+  // Deliver one durable group-commit batch. Batches arrive in commit order
+  // and carry the same length-prefixed records the log file holds.
+  virtual void ShipLogBatch(const std::string &batch) = 0;
+};
+
+}  // namespace logging
+}  // namespace peloton
@@ -12,15 +12,40 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
 #include "logging/checkpoint_manager.h"
 
 namespace peloton {
+
+namespace storage {
+class DataTable;
+}  // namespace storage
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
 // logical checkpoint Manager
 //===--------------------------------------------------------------------===//
 
+/**
+ * checkpoint file name layout :
+ *
+ * dir_name + "/" + prefix + "_" + epoch_id + "/" + database_id + "_" +
+ * table_id + "_" + partition_id
+ *
+ * checkpoint file layout :
+ *
+ *  ----------------------------------------------------------
+ *  | tuple_count | tuple_1 column values | tuple_2 ... | ...
+ *  ----------------------------------------------------------
+ *
+ * All the files of one checkpoint sit in one epoch-stamped directory, so
+ * the newest complete directory is the restore candidate.
+ */
 class LogicalCheckpointManager : public CheckpointManager {
  public:
   LogicalCheckpointManager(const LogicalCheckpointManager &) = delete;
@@ -37,23 +62,139 @@ class LogicalCheckpointManager : public CheckpointManager {
     return checkpoint_manager;
   }
 
-  virtual void Reset() { is_running_ = false; }
+  virtual void Reset() override { is_running_ = false; }
+
+  virtual void StartCheckpointing(
+      std::vector<std::unique_ptr<std::thread>> &checkpointer_threads) override;
+
+  virtual void StartCheckpointing() override;
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) {}
+  virtual void StopCheckpointing() override;
 
-  virtual void StartLogging() {}
+  // Take one checkpoint immediately on the calling thread. Exposed
+  // separately from the background loop for tests and manual triggering.
+  void PerformCheckpoint();
+
+  // Load the newest complete checkpoint back into the tables registered
+  // in the storage manager, hottest table first per the access ranking
+  // persisted with the checkpoint, using checkpointer_thread_count_
+  // parallel readers. Inserts go through the regular transactional path,
+  // so indexes are rebuilt as the rows stream in. Returns false when no
+  // checkpoint directory exists.
+  bool PerformRestore();
+
+  // Has the given table finished restoring? Admission logic can release
+  // a query as soon as the tables it touches are resident instead of
+  // waiting for the whole restore
+  bool IsTableRestored(const oid_t table_id) {
+    std::lock_guard<std::mutex> lock(restore_lock_);
+    return restore_done_ || restored_tables_.count(table_id) != 0;
+  }
+
+  // Block until the given table is resident (or the restore finishes)
+  void WaitForTableRestored(const oid_t table_id) {
+    std::unique_lock<std::mutex> lock(restore_lock_);
+    restore_cv_.wait(lock, [&] {
+      return restore_done_ || restored_tables_.count(table_id) != 0;
+    });
+  }
 
-  virtual void StopLogging() {}
+  virtual void RegisterTable(const oid_t &table_id) override {
+    std::lock_guard<std::mutex> lock(table_lock_);
+    table_ids_.insert(table_id);
+  }
 
-  virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  virtual void DeregisterTable(const oid_t &table_id) override {
+    std::lock_guard<std::mutex> lock(table_lock_);
+    table_ids_.erase(table_id);
+  }
 
-  virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
+  virtual size_t GetTableCount() override {
+    std::lock_guard<std::mutex> lock(table_lock_);
+    return table_ids_.size();
+  }
 
-  virtual size_t GetTableCount() { return 0; }
+ private:
+  // background loop: sleep for the configured interval, then checkpoint
+  void Run();
+
+  // One unit of checkpoint work: a table whose tile groups the workers
+  // claim through a shared cursor
+  struct CheckpointJob {
+    oid_t database_oid;
+    oid_t table_oid;
+    storage::DataTable *table;
+    oid_t tile_group_count;
+
+    // accesses observed by the stats machinery; orders the checkpoint
+    // hot-first and is persisted as the restore priority
+    int64_t accesses;
+
+    // next tile group to claim
+    std::atomic<oid_t> cursor;
+
+    CheckpointJob(oid_t db_oid, oid_t tb_oid, storage::DataTable *table_p,
+                  oid_t tg_count)
+        : database_oid(db_oid),
+          table_oid(tb_oid),
+          table(table_p),
+          tile_group_count(tg_count),
+          accesses(0),
+          cursor(0) {}
+  };
+
+  // One unit of restore work: every partition file of one table
+  struct RestoreJob {
+    oid_t database_oid;
+    oid_t table_oid;
+    int64_t accesses;
+  };
+
+  // Worker loop: claim tile groups off the job list and stream the latest
+  // committed version of every tuple into this worker's partition files
+  void CheckpointWorker(const std::string &checkpoint_dir, int worker_id,
+                        std::vector<std::unique_ptr<CheckpointJob>> *jobs);
+
+  // Worker loop: claim whole tables off the priority-ordered job list and
+  // insert their checkpointed tuples back, marking each table resident
+  // when its last file is consumed
+  void RestoreWorker(const std::string &checkpoint_dir,
+                     std::vector<RestoreJob> *jobs,
+                     std::atomic<uint32_t> *job_cursor);
+
+  // Restore every partition file of one table; returns the tuple count
+  size_t RestoreTable(const std::string &checkpoint_dir,
+                      const RestoreJob &job);
+
+  std::string GetCheckpointDirFullPath(const size_t epoch_id) {
+    return checkpoint_dir_ + "/" + checkpoint_dirname_prefix_ + "_" +
+           std::to_string(epoch_id);
+  }
 
  private:
   int checkpointer_thread_count_;
 
+  // background checkpointer; only spawned by the threadless
+  // StartCheckpointing()
+  std::unique_ptr<std::thread> checkpointer_thread_;
+
+  // wakes the background loop up early on shutdown
+  std::mutex run_lock_;
+  std::condition_variable run_cv_;
+
+  // tables to checkpoint; empty means every table in the storage manager
+  std::mutex table_lock_;
+  std::unordered_set<oid_t> table_ids_;
+
+  std::string checkpoint_dir_ = ".";
+
+  const std::string checkpoint_dirname_prefix_ = "checkpoint";
+
+  // restore progress, published table by table
+  std::mutex restore_lock_;
+  std::condition_variable restore_cv_;
+  std::unordered_set<oid_t> restored_tables_;
+  bool restore_done_ = false;
 };
 
 }  // namespace logging
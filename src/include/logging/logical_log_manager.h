@@ -12,7 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "logging/log_buffer.h"
+#include "logging/log_buffer_pool.h"
 #include "logging/log_manager.h"
+#include "logging/log_shipper.h"
 
 namespace peloton {
 namespace logging {
@@ -85,11 +94,11 @@ class LogicalLogManager : public LogManager {
   // }
 
 
-  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> & UNUSED_ATTRIBUTE) override {}
+  virtual void StartLogging(std::vector<std::unique_ptr<std::thread>> &logger_threads) override;
 
-  virtual void StartLogging() override {}
+  virtual void StartLogging() override;
 
-  virtual void StopLogging() override {}
+  virtual void StopLogging() override;
 
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) override {}
 
@@ -99,17 +108,122 @@ class LogicalLogManager : public LogManager {
 
   virtual void LogBegin() override {}
 
-  virtual void LogEnd() override {}
+  // Block the committing transaction until the log writer has made its
+  // batch durable. With group commit enabled this parks the caller on a
+  // condition variable; the writer wakes the whole batch after one fsync.
+  virtual void LogEnd() override;
 
   virtual void LogInsert(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
+
   virtual void LogUpdate(const ItemPointer & UNUSED_ATTRIBUTE) override {}
-  
+
   virtual void LogDelete(const ItemPointer & UNUSED_ATTRIBUTE) override { }
 
+  // Hand a filled log buffer over to the log writer. The buffer is
+  // returned to its owning pool once its contents have been persisted.
+  void SubmitLogBuffer(LogBufferPool *pool, std::unique_ptr<LogBuffer> buffer);
+
+  // Replay the persisted log files with a pool of worker threads. Files
+  // are processed in epoch order; within one file the records are
+  // partitioned by table/tile-group affinity (LogRecord::GetPartitionId)
+  // and the partitions replay concurrently. The epoch boundary is the only
+  // cross-partition dependency, so workers synchronize at a barrier
+  // between files and run free inside one.
+  void StartRecovery(const size_t recovery_thread_count);
+
+  void WaitForRecovery();
+
+  // Register a follower endpoint. Every batch the log writer makes durable
+  // from now on is also streamed to the follower, in commit order; the
+  // shipper thread is started lazily with the first follower. Replication
+  // is asynchronous with bounded lag: once the backlog reaches
+  // MAX_REPLICATION_BACKLOG batches the writer blocks until the shipper
+  // catches up, instead of letting a slow follower fall arbitrarily behind.
+  void AddFollower(std::shared_ptr<LogShipper> follower);
+
+  // Follower-side apply: parse one shipped batch (same framing as the log
+  // file) and install its records through the recovery replay path. Each
+  // batch is applied in full before the next one starts, and the replayed
+  // versions keep their leader commit ids, so follower reads see
+  // batch-wise-consistent snapshots through the ordinary MVCC visibility
+  // checks while the epoch machinery covers reclamation as usual.
+  void ApplyShippedBatch(const char *data, size_t size);
+
+  // Number of shipped batches this instance has applied as a follower
+  uint64_t GetAppliedBatchCount() const { return applied_batch_count_.load(); }
+
+ private:
+  // dedicated log writer: coalesce the buffers submitted during each group
+  // commit window, flush them with a single fsync, then wake every
+  // transaction parked in that window.
+  void Run();
+
+  // recovery driver: walks the log files in epoch order and fans each
+  // file's records out to the replay workers.
+  void RunRecovery(const size_t recovery_thread_count);
+
+  // shipper thread: drains the replication backlog and forwards each batch
+  // to every registered follower, preserving commit order.
+  void RunShipper();
+
+  // replay one partition's records; each entry points at one framed
+  // record (header plus payload) inside the file image.
+  void ReplayPartition(
+      const std::vector<std::pair<const char *, size_t>> &records);
+
+  std::string GetLogFileFullPath(const size_t epoch_id) {
+    return log_dir_ + "/" + logging_filename_prefix_ + "_" +
+           std::to_string(epoch_id);
+  }
+
  private:
   int logger_thread_count_;
 
+  // log writer thread; only spawned by the threadless StartLogging().
+  std::unique_ptr<std::thread> writer_thread_;
+
+  // recovery driver thread; spawned by StartRecovery().
+  std::unique_ptr<std::thread> recovery_thread_;
+
+  // protects the pending buffers and the commit tickets.
+  std::mutex group_commit_lock_;
+  std::condition_variable group_commit_cv_;
+
+  // buffers waiting for the next fsync window, paired with the pool each
+  // one has to be returned to.
+  std::vector<std::pair<LogBufferPool *, std::unique_ptr<LogBuffer>>>
+      pending_buffers_;
+
+  // ticket counters: a commit is durable once the persisted count has
+  // passed the ticket it drew when parking.
+  uint64_t enqueued_commit_count_ = 0;
+  uint64_t persisted_commit_count_ = 0;
+
+  std::string log_dir_ = ".";
+
+  const std::string logging_filename_prefix_ = "logical_log";
+
+  // bound on the batches a follower may lag behind before the log writer
+  // is backpressured
+  static const size_t MAX_REPLICATION_BACKLOG = 64;
+
+  // shipper thread; spawned with the first AddFollower().
+  std::unique_ptr<std::thread> shipper_thread_;
+
+  // protects the follower list, the backlog and shipper_running_.
+  std::mutex replication_lock_;
+  std::condition_variable replication_cv_;
+
+  std::vector<std::shared_ptr<LogShipper>> followers_;
+
+  // durable batches awaiting shipment, oldest first.
+  std::deque<std::string> replication_backlog_;
+
+  bool shipper_running_ = false;
+
+  // follower-side progress counter.
+  std::atomic<uint64_t> applied_batch_count_{0};
+
   // std::atomic<oid_t> worker_count_;
 
   // std::vector<std::string> logger_dirs_;
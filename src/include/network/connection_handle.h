@@ -58,6 +58,8 @@ namespace network {
  */
 class ConnectionHandle {
  public:
+  ~ConnectionHandle();
+
   /**
    * Update the existing event to listen to the passed flags
    */
@@ -171,6 +173,21 @@ class ConnectionHandle {
    */
   WriteState FlushWriteBuffer();
 
+  /**
+   * Send the staged write buffer and the remaining body of the given packet
+   * together with one writev, without copying the body into the buffer.
+   * Non-SSL connections only. Partial writes leave progress in the buffer's
+   * flush pointer and the packet's write pointer, so the state machine can
+   * re-enter here after the socket becomes writable again.
+   */
+  WriteState FlushWriteBufferAndBody(OutputPacket *pkt);
+
+  /**
+   * Give the pooled read/write buffers back to the NetworkBufferPool.
+   * Idempotent; called on close and again defensively on destruction.
+   */
+  void ReturnBuffers();
+
   /**
    * Set the socket to non-blocking mode
    */
@@ -204,6 +221,19 @@ class ConnectionHandle {
   std::shared_ptr<Buffer> rbuf_;    // Socket's read buffer
   std::shared_ptr<Buffer> wbuf_;    // Socket's write buffer
   unsigned int next_response_ = 0;  // The next response in the response buffer
+
+  // A forced flush was postponed because the read buffer still held further
+  // pipelined messages; flush before waiting on the socket again
+  bool flush_deferred_ = false;
+
+  // Packet bodies at least this large skip the copy into wbuf_ and go out
+  // with one writev alongside whatever is already staged
+  static const size_t kDirectWritevThreshold = 4096;
+
+  // Stop coalescing deferred responses once this many bytes are staged;
+  // small (sub-512-byte) responses keep accumulating, bursts of larger ones
+  // flush early to bound latency and buffer growth
+  static const size_t kCoalesceByteThreshold = 8192;
   Client client_;
   StateMachine state_machine_;
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "network/connection_handle.h"
+#include "network/network_buffer_pool.h"
 #include "peloton_server.h"
 
 namespace peloton {
@@ -22,7 +23,8 @@ namespace network {
  * @brief Factory class for constructing ConnectionHandles
  * The rationale behind using a factory is that buffers are expensive to
  * allocate and allocating new
- * ones every time is a bottleneck for throughput.
+ * ones every time is a bottleneck for throughput; handles draw their
+ * buffers from the shared NetworkBufferPool.
  */
 class ConnectionHandleFactory {
  public:
@@ -39,25 +41,19 @@ class ConnectionHandleFactory {
     // VILE. Fix this in a later refactor
     // (probably also to-do: beat up the person who wrote this)
     PelotonServer::recent_connfd = conn_fd;
-    auto it = reusable_handles_.find(conn_fd);
     bool ssl_able = (PelotonServer::GetSSLLevel() != SSLLevel::SSL_DISABLE);
-    if (it == reusable_handles_.end()) {
-      // We are not using std::make_shared here because we want to keep
-      // ConnectionHandle constructor
-      // private to avoid unintentional use.
-      auto handle = std::shared_ptr<ConnectionHandle>(
-          new ConnectionHandle(conn_fd, handler, std::make_shared<Buffer>(),
-                               std::make_shared<Buffer>(), ssl_able));
-      reusable_handles_[conn_fd] = handle;
-      return handle;
-    }
-
-    it->second->rbuf_->Reset();
-    it->second->wbuf_->Reset();
-    std::shared_ptr<ConnectionHandle> new_handle(new ConnectionHandle(
-        conn_fd, handler, it->second->rbuf_, it->second->wbuf_, ssl_able));
-    reusable_handles_[conn_fd] = new_handle;
-    return new_handle;
+    // Buffers come from the global tiered pool rather than being retained
+    // per-fd, so closed connections give their memory back instead of each
+    // fd pinning a pair of (possibly upgraded) buffers forever.
+    auto &buffer_pool = NetworkBufferPool::GetInstance();
+    // We are not using std::make_shared here because we want to keep
+    // ConnectionHandle constructor
+    // private to avoid unintentional use.
+    auto handle = std::shared_ptr<ConnectionHandle>(new ConnectionHandle(
+        conn_fd, handler, buffer_pool.BorrowBuffer(),
+        buffer_pool.BorrowBuffer(), ssl_able));
+    reusable_handles_[conn_fd] = handle;
+    return handle;
   }
 
   // TODO(tianyu) Again, this is VILE. Fix this in a later refactor.
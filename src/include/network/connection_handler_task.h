@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <event2/buffer.h>
 #include <event2/bufferevent.h>
 #include <event2/event.h>
@@ -64,14 +68,76 @@ class ConnectionHandlerTask : public NotifiableTask {
    * register its event base to receive updates with appropriate callbacks
    * when the client writes to the socket.
    *
+   * The handler first drains its own pending-connection queue; if that is
+   * empty (a sibling already stole the connection), it tries to steal a
+   * queued connection from the most backlogged sibling instead.
+   *
    * @param new_conn_recv_fd the socket fd of the new connection
    * @param flags unused. For compliance with libevent callback interface.
    */
   void HandleDispatch(int new_conn_recv_fd, short flags);
 
+  /**
+   * @brief Gives this handler access to its sibling handlers for work
+   * stealing. Called once by the dispatcher after all handlers exist.
+   */
+  void SetSiblings(
+      const std::vector<std::shared_ptr<ConnectionHandlerTask>> *siblings) {
+    siblings_ = siblings;
+  }
+
+  /**
+   * @brief Dequeues one of this handler's queued connections, if any.
+   * Safe to call from other handler threads (work stealing).
+   *
+   * @param conn_fd set to the dequeued connection's socket fd on success
+   * @return true if a queued connection was dequeued
+   */
+  bool TryGetPendingConnection(int &conn_fd) {
+    if (pending_conns_.Dequeue(conn_fd)) {
+      num_pending_.fetch_sub(1);
+      return true;
+    }
+    return false;
+  }
+
+  /** Number of dispatched connections not yet picked up by an event loop */
+  size_t GetPendingCount() const { return num_pending_.load(); }
+
+  /**
+   * @brief Pending dispatches plus live connections; the dispatcher sends
+   * new connections to the handler where this is smallest.
+   */
+  size_t GetLoad() const { return num_pending_.load() + num_connections_.load(); }
+
+  /** Called when a connection served by this handler closes its socket */
+  void ConnectionClosed() { num_connections_.fetch_sub(1); }
+
  private:
+  /**
+   * Try to steal a queued connection from the sibling with the deepest
+   * pending queue.
+   *
+   * @param conn_fd set to the stolen connection's socket fd on success
+   * @return true if a connection was stolen
+   */
+  bool StealPendingConnection(int &conn_fd);
+
   // Notify new connection pipe(send end)
   int new_conn_send_fd_;
+
+  // Connections dispatched to this handler but not yet registered with its
+  // event base
+  LockFreeQueue<int> pending_conns_;
+
+  // Depth of pending_conns_, readable without draining the queue
+  std::atomic<size_t> num_pending_;
+
+  // Connections currently registered with this handler's event base
+  std::atomic<size_t> num_connections_;
+
+  // All handler tasks, for work stealing; owned by the dispatcher
+  const std::vector<std::shared_ptr<ConnectionHandlerTask>> *siblings_;
 };
 
 }  // namespace network
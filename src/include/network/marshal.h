@@ -29,11 +29,15 @@ struct Buffer {
   size_t buf_ptr;        // buffer cursor
   size_t buf_size;       // buffer size
   size_t buf_flush_ptr;  // buffer cursor for write
+  size_t buf_capacity;   // fixed capacity the buffer was allocated with
   ByteBuf buf;
 
-  inline Buffer() : buf_ptr(0), buf_size(0), buf_flush_ptr(0) {
+  inline Buffer() : Buffer(SOCKET_BUFFER_SIZE) {}
+
+  explicit inline Buffer(size_t capacity)
+      : buf_ptr(0), buf_size(0), buf_flush_ptr(0), buf_capacity(capacity) {
     // capacity of the buffer
-    buf.reserve(SOCKET_BUFFER_SIZE);
+    buf.reserve(capacity);
   }
 
   inline void Reset() {
@@ -52,7 +56,7 @@ struct Buffer {
 
   inline ByteBuf::const_iterator End() { return std::end(buf); }
 
-  inline size_t GetMaxSize() { return SOCKET_BUFFER_SIZE; }
+  inline size_t GetMaxSize() { return buf_capacity; }
 
   // Get the 4 bytes Big endian uint32 and convert it to little endian
   size_t GetUInt32BigEndian();
@@ -185,6 +189,10 @@ extern void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len);
 /* packet_put_bytes - used to write a uchar vector into a packet */
 extern void PacketPutString(OutputPacket *pkt, const std::string &data);
 
+// reserve space for len more bytes in the packet buffer, so a sequence of
+// puts of known total size fills it without intermediate reallocations
+extern void PacketReserveBytes(OutputPacket *pkt, size_t len);
+
 /*
 * Unmarshallers
 */
@@ -207,6 +215,14 @@ extern void PacketGetString(InputPacket *pkt, size_t len, std::string &result);
 /* packet_get_bytes - Parse out "len" bytes of pkt as raw bytes */
 extern void PacketGetBytes(InputPacket *pkt, size_t len, ByteBuf &result);
 
+/*
+* packet_get_bytes_view - advance past "len" bytes of pkt and return an
+* 		iterator to their start, without copying them out. The view is
+* 		only valid until the packet's underlying buffer is refilled, so
+* 		callers must consume it before the next packet is read.
+*/
+extern ByteBuf::const_iterator PacketGetBytesView(InputPacket *pkt, size_t len);
+
 /* packet_get_byte - Parse out a single bytes from pkt */
 extern void PacketGetByte(InputPacket *rpkt, uchar &result);
 
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metrics_export_task.h
+//
+// Identification: src/include/network/metrics_export_task.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "network/notifiable_task.h"
+
+namespace peloton {
+namespace network {
+
+/**
+ * @brief A lightweight pull endpoint that serves the stats aggregator's
+ * current counters in a flat text format.
+ *
+ * The task listens on its own port and runs its event loop on a dedicated
+ * thread, so scrapes never touch the connection dispatcher or the query
+ * worker threads. Each request is answered with the snapshot the aggregator
+ * published at the end of its last aggregation interval and the connection
+ * is closed, which keeps the handler free of any per-connection state.
+ */
+class MetricsExportTask : public NotifiableTask {
+ public:
+  /**
+   * Constructs a new MetricsExportTask listening on the given port.
+   * @param task_id a unique id assigned to this task
+   * @param port the port to listen on
+   */
+  MetricsExportTask(int task_id, int port);
+
+  ~MetricsExportTask() override;
+
+  /**
+   * @brief Accepts a pending connection, writes the current metrics
+   * snapshot, and closes the connection.
+   * Conforms to the libevent callback signature via METHOD_AS_CALLBACK.
+   */
+  void HandleRequest(int fd, short flags);
+
+ private:
+  // server socket fd this task is listening on
+  int listen_fd_ = -1;
+};
+
+}  // namespace network
+}  // namespace peloton
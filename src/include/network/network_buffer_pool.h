@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// network_buffer_pool.h
+//
+// Identification: src/include/network/network_buffer_pool.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "network/marshal.h"
+
+namespace peloton {
+namespace network {
+
+/**
+ * @brief A global pool of socket buffers, tiered by capacity.
+ *
+ * ConnectionHandles borrow their read/write buffers from here instead of
+ * allocating per connection, so buffer memory is shared across the whole
+ * server rather than retained by every connection that ever grew one. The
+ * small tier matches the default socket buffer; the larger tiers let the
+ * result-send path upgrade its write buffer during large result bursts
+ * instead of ping-ponging between fill and flush.
+ *
+ * The medium and large tiers cap how many buffers may be lent out at once.
+ * When a tier is exhausted, BorrowBuffer() backs off to the next smaller
+ * tier instead of blocking or allocating, so a burst of wide results cannot
+ * balloon memory; the caller just flushes more often.
+ */
+class NetworkBufferPool {
+ public:
+  // Tier capacities. The small tier keeps SOCKET_BUFFER_SIZE so the default
+  // per-connection behavior is unchanged.
+  static const size_t kSmallBufferSize = SOCKET_BUFFER_SIZE;
+  static const size_t kMediumBufferSize = 64 * 1024;
+  static const size_t kLargeBufferSize = 1024 * 1024;
+
+  // TODO(tianyu): This should be removed with the rest of the singletons
+  static NetworkBufferPool &GetInstance();
+
+  /**
+   * Borrow a buffer with capacity at least min_capacity, falling back to
+   * smaller tiers when the requested one has reached its lending cap. The
+   * small tier never refuses, so the result is always non-null.
+   */
+  std::shared_ptr<Buffer> BorrowBuffer(size_t min_capacity = kSmallBufferSize);
+
+  /**
+   * Return a buffer previously handed out by BorrowBuffer(). The buffer is
+   * reset and kept for reuse, or freed if the tier already retains enough.
+   */
+  void ReturnBuffer(std::shared_ptr<Buffer> buffer);
+
+ private:
+  NetworkBufferPool();
+
+  struct Tier {
+    Tier(size_t buffer_size, size_t max_outstanding, size_t max_pooled)
+        : buffer_size(buffer_size),
+          max_outstanding(max_outstanding),
+          outstanding_count(0),
+          max_pooled(max_pooled) {}
+
+    // capacity of every buffer in this tier
+    size_t buffer_size;
+    // lending cap; 0 means unlimited
+    size_t max_outstanding;
+    // buffers currently lent out
+    size_t outstanding_count;
+    // how many returned buffers to retain for reuse
+    size_t max_pooled;
+    // returned buffers awaiting reuse
+    std::vector<std::shared_ptr<Buffer>> free_buffers;
+  };
+
+  // smallest tier first
+  std::vector<Tier> tiers_;
+  std::mutex pool_mutex_;
+};
+
+}  // namespace network
+}  // namespace peloton
@@ -26,12 +26,14 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 #include "common/container/lock_free_queue.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "connection_dispatcher_task.h"
+#include "metrics_export_task.h"
 #include "network_state.h"
 #include "notifiable_task.h"
 #include "protocol_handler.h"
@@ -137,6 +139,10 @@ class PelotonServer {
 
   // For testing purposes
   std::shared_ptr<ConnectionDispatcherTask> dispatcher_task_;
+
+  // Metrics export endpoint, running its event loop on a dedicated thread
+  std::shared_ptr<MetricsExportTask> metrics_export_task_;
+  std::thread metrics_export_thread_;
 };
 }  // namespace network
 }  // namespace peloton
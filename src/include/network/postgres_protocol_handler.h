@@ -44,6 +44,8 @@ class PostgresProtocolHandler : public ProtocolHandler {
 
   ProcessResult Process(Buffer &rbuf, const size_t thread_id);
 
+  bool HasCompletePacket(Buffer &rbuf) override;
+
   /* Main switch case wrapper to process every packet apart from the startup
    * packet. Avoid flushing the response for extended protocols. */
   ProcessResult ProcessPacket(InputPacket *pkt, const size_t thread_id);
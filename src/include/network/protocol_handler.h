@@ -42,6 +42,14 @@ class ProtocolHandler {
 
   virtual ProcessResult Process(Buffer &rbuf, const size_t thread_id);
 
+  /* Whether rbuf already holds a complete, unprocessed protocol message.
+   * Used by the connection to keep buffering responses while a pipelined
+   * burst of messages is drained. Conservative default: protocols that
+   * cannot tell report false and flush as usual. */
+  virtual bool HasCompletePacket(UNUSED_ATTRIBUTE Buffer &rbuf) {
+    return false;
+  }
+
   virtual void Reset();
 
   virtual void GetResult();
@@ -47,6 +47,9 @@ class ChildPropertyDeriver : public OperatorVisitor {
   void Visit(const PhysicalRightNLJoin *) override;
   void Visit(const PhysicalOuterNLJoin *) override;
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerMergeJoin *) override;
+  void Visit(const PhysicalSemiHashJoin *) override;
+  void Visit(const PhysicalAntiHashJoin *) override;
   void Visit(const PhysicalLeftHashJoin *) override;
   void Visit(const PhysicalRightHashJoin *) override;
   void Visit(const PhysicalOuterHashJoin *) override;
@@ -37,6 +37,7 @@ class ChildStatsDeriver : public OperatorVisitor {
   void Visit(const LogicalRightJoin *) override;
   void Visit(const LogicalOuterJoin *) override;
   void Visit(const LogicalSemiJoin *) override;
+  void Visit(const LogicalAntiJoin *) override;
   void Visit(const LogicalAggregateAndGroupBy *) override;
 
  private:
@@ -15,6 +15,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/synchronization/spin_latch.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/property.h"
@@ -54,22 +55,44 @@ class Group {
     return table_aliases_;
   }
 
-  // TODO: thread safety?
+  // Copied out under the latch so that exploration workers can iterate a
+  // stable snapshot while others append to the group
   const std::vector<std::shared_ptr<GroupExpression>> GetLogicalExpressions()
       const {
-    return logical_expressions_;
+    latch_.Lock();
+    auto logical_expressions = logical_expressions_;
+    latch_.Unlock();
+    return logical_expressions;
   }
 
-  // TODO: thread safety?
   const std::vector<std::shared_ptr<GroupExpression>> GetPhysicalExpressions()
       const {
-    return physical_expressions_;
+    latch_.Lock();
+    auto physical_expressions = physical_expressions_;
+    latch_.Unlock();
+    return physical_expressions;
   }
 
   inline double GetCostLB() { return cost_lower_bound_; }
 
-  inline void SetExplorationFlag() { has_explored_ = true; }
-  inline bool HasExplored() { return has_explored_; }
+  inline void SetExplorationFlag() {
+    latch_.Lock();
+    has_explored_ = true;
+    latch_.Unlock();
+  }
+  inline bool HasExplored() {
+    latch_.Lock();
+    bool has_explored = has_explored_;
+    latch_.Unlock();
+    return has_explored;
+  }
+
+  // Whether implementation rules have been scheduled for the logical
+  // expressions of this group. Tracked separately from the exploration flag
+  // so that a parallel exploration pass (transformation rules only) does not
+  // make the costing pass skip implementation.
+  inline void SetImplementationFlag() { has_implemented_ = true; }
+  inline bool HasImplemented() { return has_implemented_; }
 
   std::shared_ptr<ColumnStats> GetStats(std::string column_name);
 
@@ -111,6 +134,13 @@ class Group {
   // Whether equivalent logical expressions have been explored for this group
   bool has_explored_;
 
+  // Whether implementation rules have been scheduled for this group
+  bool has_implemented_;
+
+  // Guards the expression vectors and the exploration flag; only contended
+  // during the parallel exploration pass
+  mutable common::synchronization::SpinLatch latch_;
+
   std::vector<std::shared_ptr<GroupExpression>> logical_expressions_;
   std::vector<std::shared_ptr<GroupExpression>> physical_expressions_;
   std::vector<std::shared_ptr<GroupExpression>> enforced_exprs_;
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "common/synchronization/spin_latch.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/stats.h"
 #include "optimizer/util.h"
@@ -80,6 +81,9 @@ class GroupExpression {
   std::bitset<static_cast<uint32_t>(RuleType::NUM_RULES)> rule_mask_;
   bool stats_derived_;
 
+  // Guards the rule mask, which exploration workers test and set concurrently
+  mutable common::synchronization::SpinLatch rule_mask_latch_;
+
   // Mapping from output properties to the corresponding best cost, statistics,
   // and child properties
   std::unordered_map<std::shared_ptr<PropertySet>,
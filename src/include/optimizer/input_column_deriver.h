@@ -68,6 +68,11 @@ class InputColumnDeriver : public OperatorVisitor {
   void Visit(const PhysicalOuterNLJoin *) override;
 
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerMergeJoin *) override;
+
+  void Visit(const PhysicalSemiHashJoin *) override;
+
+  void Visit(const PhysicalAntiHashJoin *) override;
 
   void Visit(const PhysicalLeftHashJoin *) override;
 
@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_order_enumerator.h
+//
+// Identification: src/include/optimizer/join_order_enumerator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "optimizer/operator_expression.h"
+
+namespace peloton {
+namespace optimizer {
+
+/**
+ * @brief Dynamic-programming join order enumerator for select-project-join
+ *  blocks. The cascades rule set only flips join sides (commutativity), so
+ *  the join order that leaves the query-to-operator transformer is largely
+ *  the order that gets implemented; for star-schema queries over many
+ *  tables that as-written order can be arbitrarily bad. When the logical
+ *  tree contains a block of inner joins over base table gets, this
+ *  enumerator rebuilds the join tree bottom-up over connected sub-plans
+ *  (DPsub over relation bitsets) using base table cardinalities and a
+ *  simple equi-join selectivity model, then hands the reordered logical
+ *  tree back to cascades for physical implementation.
+ */
+class JoinOrderEnumerator {
+ public:
+  /**
+   * @brief Reorder the inner-join blocks of a logical operator tree.
+   * @returns the tree with each eligible join block rebuilt in the order
+   *  the dynamic program chose, or the input subtrees unchanged where no
+   *  block is eligible (too few tables to benefit, too many to enumerate
+   *  exhaustively, non-get inputs, or no connected plan)
+   */
+  std::shared_ptr<OperatorExpression> Enumerate(
+      std::shared_ptr<OperatorExpression> root);
+
+ private:
+  // Bitset of the leaf relations covered by a sub-plan
+  using RelSet = uint64_t;
+
+  struct SubPlan {
+    std::shared_ptr<OperatorExpression> expr;
+    double cardinality;
+    double cost;
+  };
+
+  // Collect the leaves and join predicates of the inner-join block rooted
+  // at node. Returns false if any input below the joins is not a base
+  // table get
+  bool CollectJoinBlock(
+      const std::shared_ptr<OperatorExpression> &node,
+      std::vector<std::shared_ptr<OperatorExpression>> &leaves,
+      std::vector<AnnotatedExpression> &predicates);
+
+  // Run the dynamic program over the collected block. Returns nullptr if
+  // no connected plan covering every relation was found
+  std::shared_ptr<OperatorExpression> BuildJoinTree(
+      const std::vector<std::shared_ptr<OperatorExpression>> &leaves,
+      const std::vector<AnnotatedExpression> &predicates);
+
+  double EstimateLeafCardinality(
+      const std::shared_ptr<OperatorExpression> &leaf);
+
+  // DPsub is exponential in the block size; blocks larger than this are
+  // left in their original order
+  static const size_t kMaxRelations = 15;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -16,6 +16,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "common/synchronization/spin_latch.h"
 #include "operator_expression.h"
 #include "optimizer/group.h"
 
@@ -40,6 +41,22 @@ class Memo {
  public:
   Memo();
 
+  // The latch member suppresses the implicit move operations, which
+  // Optimizer::Reset() relies on to rebuild its metadata. Moving only the
+  // memo contents and default-constructing the latch is safe: a memo is
+  // never moved while exploration tasks are sharing it
+  Memo(Memo&& other)
+      : group_expressions_(std::move(other.group_expressions_)),
+        groups_(std::move(other.groups_)),
+        rule_set_size_(other.rule_set_size_) {}
+
+  Memo& operator=(Memo&& other) {
+    group_expressions_ = std::move(other.group_expressions_);
+    groups_ = std::move(other.groups_);
+    rule_set_size_ = other.rule_set_size_;
+    return *this;
+  }
+
   /* InsertExpression - adds a group expression into the proper group in the
    * memo, checking for duplicates
    *
@@ -88,6 +105,12 @@ class Memo {
       group_expressions_;
   std::vector<std::unique_ptr<Group>> groups_;
   size_t rule_set_size_;
+
+  // Serializes expression insertion and group creation so that exploration
+  // tasks running on different workers can share the memo. Group objects are
+  // stable once created (the vector stores owning pointers), so readers only
+  // need the latch while the group table itself is looked up or grown.
+  mutable common::synchronization::SpinLatch latch_;
 };
 
 }  // namespace optimizer
@@ -38,6 +38,7 @@ enum class OpType {
   RightJoin,
   OuterJoin,
   SemiJoin,
+  AntiJoin,
   LogicalAggregateAndGroupBy,
   LogicalInsert,
   LogicalInsertSelect,
@@ -60,6 +61,9 @@ enum class OpType {
   RightNLJoin,
   OuterNLJoin,
   InnerHashJoin,
+  InnerMergeJoin,
+  SemiHashJoin,
+  AntiHashJoin,
   LeftHashJoin,
   RightHashJoin,
   OuterHashJoin,
@@ -37,6 +37,9 @@ class OperatorVisitor {
   virtual void Visit(const PhysicalRightNLJoin *) {}
   virtual void Visit(const PhysicalOuterNLJoin *) {}
   virtual void Visit(const PhysicalInnerHashJoin *) {}
+  virtual void Visit(const PhysicalInnerMergeJoin *) {}
+  virtual void Visit(const PhysicalSemiHashJoin *) {}
+  virtual void Visit(const PhysicalAntiHashJoin *) {}
   virtual void Visit(const PhysicalLeftHashJoin *) {}
   virtual void Visit(const PhysicalRightHashJoin *) {}
   virtual void Visit(const PhysicalOuterHashJoin *) {}
@@ -63,6 +66,7 @@ class OperatorVisitor {
   virtual void Visit(const LogicalRightJoin *) {}
   virtual void Visit(const LogicalOuterJoin *) {}
   virtual void Visit(const LogicalSemiJoin *) {}
+  virtual void Visit(const LogicalAntiJoin *) {}
   virtual void Visit(const LogicalAggregateAndGroupBy *) {}
   virtual void Visit(const LogicalInsert *) {}
   virtual void Visit(const LogicalInsertSelect *) {}
@@ -135,7 +135,7 @@ class LogicalDependentJoin : public OperatorNode<LogicalDependentJoin> {
 //===--------------------------------------------------------------------===//
 class LogicalMarkJoin : public OperatorNode<LogicalMarkJoin> {
  public:
-  static Operator make();
+  static Operator make(bool anti_join = false);
 
   static Operator make(std::vector<AnnotatedExpression> &conditions);
 
@@ -144,6 +144,11 @@ class LogicalMarkJoin : public OperatorNode<LogicalMarkJoin> {
   hash_t Hash() const override;
 
   std::vector<AnnotatedExpression> join_predicates;
+
+  // a mark join generated for NOT EXISTS keeps only the unmatched outer
+  // rows; the unnesting rewrites turn it into an anti join instead of a
+  // semi join
+  bool anti_join = false;
 };
 
 //===--------------------------------------------------------------------===//
@@ -213,9 +218,31 @@ class LogicalOuterJoin : public OperatorNode<LogicalOuterJoin> {
 //===--------------------------------------------------------------------===//
 class LogicalSemiJoin : public OperatorNode<LogicalSemiJoin> {
  public:
-  static Operator make(expression::AbstractExpression *condition = nullptr);
+  static Operator make();
 
-  std::shared_ptr<expression::AbstractExpression> join_predicate;
+  static Operator make(std::vector<AnnotatedExpression> &conditions);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  std::vector<AnnotatedExpression> join_predicates;
+};
+
+//===--------------------------------------------------------------------===//
+// AntiJoin
+//===--------------------------------------------------------------------===//
+class LogicalAntiJoin : public OperatorNode<LogicalAntiJoin> {
+ public:
+  static Operator make();
+
+  static Operator make(std::vector<AnnotatedExpression> &conditions);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  std::vector<AnnotatedExpression> join_predicates;
 };
 
 //===--------------------------------------------------------------------===//
@@ -474,6 +501,66 @@ class PhysicalInnerHashJoin : public OperatorNode<PhysicalInnerHashJoin> {
   std::vector<AnnotatedExpression> join_predicates;
 };
 
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+class PhysicalInnerMergeJoin : public OperatorNode<PhysicalInnerMergeJoin> {
+ public:
+  static Operator make(
+      std::vector<AnnotatedExpression> conditions,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &left_keys,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &right_keys);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  std::vector<AnnotatedExpression> join_predicates;
+};
+
+//===--------------------------------------------------------------------===//
+// SemiHashJoin
+//===--------------------------------------------------------------------===//
+class PhysicalSemiHashJoin : public OperatorNode<PhysicalSemiHashJoin> {
+ public:
+  static Operator make(
+      std::vector<AnnotatedExpression> conditions,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &left_keys,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &right_keys);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  std::vector<AnnotatedExpression> join_predicates;
+};
+
+//===--------------------------------------------------------------------===//
+// AntiHashJoin
+//===--------------------------------------------------------------------===//
+class PhysicalAntiHashJoin : public OperatorNode<PhysicalAntiHashJoin> {
+ public:
+  static Operator make(
+      std::vector<AnnotatedExpression> conditions,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &left_keys,
+      std::vector<std::unique_ptr<expression::AbstractExpression>> &right_keys);
+
+  bool operator==(const BaseOperatorNode &r) override;
+
+  hash_t Hash() const override;
+
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  std::vector<AnnotatedExpression> join_predicates;
+};
+
 //===--------------------------------------------------------------------===//
 // LeftHashJoin
 //===--------------------------------------------------------------------===//
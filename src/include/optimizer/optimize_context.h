@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "optimizer/property_set.h"
 #include "optimizer/optimizer_task.h"
 #include "optimizer/optimizer_task_pool.h"
@@ -21,18 +23,60 @@ namespace optimizer {
 
 class OptimizerMetadata;
 
+/**
+ * @brief Search budget for one optimization run, expressed as a maximum
+ *  number of executed tasks and a maximum wall time. Zero means unlimited.
+ *  When the budget is exhausted the optimizer abandons further exploration
+ *  and falls back to greedily implementing the plan from the expressions
+ *  already in the memo, so optimization latency stays bounded.
+ */
+class OptimizerSearchBudget {
+ public:
+  OptimizerSearchBudget(uint32_t max_tasks, uint64_t max_time_ms)
+      : max_tasks_(max_tasks),
+        max_time_ms_(max_time_ms),
+        executed_tasks_(0),
+        start_time_(std::chrono::steady_clock::now()) {}
+
+  inline void CountTask() { executed_tasks_++; }
+
+  bool Exhausted() const {
+    if (max_tasks_ != 0 && executed_tasks_ >= max_tasks_) return true;
+    if (max_time_ms_ != 0) {
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - start_time_)
+                         .count();
+      if (static_cast<uint64_t>(elapsed) >= max_time_ms_) return true;
+    }
+    return false;
+  }
+
+ private:
+  uint32_t max_tasks_;
+  uint64_t max_time_ms_;
+  uint32_t executed_tasks_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
 class OptimizeContext {
  public:
   OptimizeContext(OptimizerMetadata *metadata,
                   std::shared_ptr<PropertySet> required_prop,
-                  double cost_upper_bound = std::numeric_limits<double>::max())
+                  double cost_upper_bound = std::numeric_limits<double>::max(),
+                  bool implementation_only = false)
       : metadata(metadata),
         required_prop(required_prop),
-        cost_upper_bound(cost_upper_bound) {}
+        cost_upper_bound(cost_upper_bound),
+        implementation_only(implementation_only) {}
 
   OptimizerMetadata *metadata;
   std::shared_ptr<PropertySet> required_prop;
   double cost_upper_bound;
+
+  // When set, transformation rules are skipped so that tasks only implement
+  // and cost the logical expressions already in the memo. Used by the budget
+  // fallback to complete a valid plan without further plan space exploration.
+  bool implementation_only;
 };
 
 }  // namespace optimizer
@@ -78,6 +78,8 @@ class OptimizerTask {
 
   virtual void execute() = 0;
 
+  inline OptimizerTaskType GetType() const { return type_; }
+
   void PushTask(OptimizerTask *task);
 
   inline Memo &GetMemo() const;
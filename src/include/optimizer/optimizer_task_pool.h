@@ -13,8 +13,12 @@
 #pragma once
 
 #include "optimizer/optimizer_task.h"
-#include <stack>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <stack>
+#include <vector>
 
 namespace peloton {
 namespace optimizer {
@@ -52,5 +56,79 @@ class OptimizerTaskStack : public OptimizerTaskPool {
   std::stack<std::unique_ptr<OptimizerTask>> task_stack_;
 };
 
+/**
+ * @brief Shared task pool for the parallel exploration pass. Workers block in
+ *  WaitAndPop() until a task is available, and the in-flight counter lets them
+ *  distinguish a temporarily empty pool (a running task may still push more
+ *  work) from a drained one. Stats derivation tasks generated during
+ *  exploration are set aside and replayed serially by the optimizer, since
+ *  they mutate per-group statistics that are not latched.
+ */
+class OptimizerTaskQueue : public OptimizerTaskPool {
+ public:
+  virtual std::unique_ptr<OptimizerTask> Pop() {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto task = std::move(task_queue_.front());
+    task_queue_.pop_front();
+    return task;
+  }
+
+  virtual void Push(OptimizerTask *task) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (task->GetType() == OptimizerTaskType::DERIVE_STATS) {
+      deferred_tasks_.emplace_back(task);
+      return;
+    }
+    task_queue_.emplace_back(task);
+    cv_.notify_one();
+  }
+
+  virtual bool Empty() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return task_queue_.empty();
+  }
+
+  /**
+   * @brief Blocks until a task is available or the pool is drained.
+   * @returns true and the popped task, or false once the pool is empty and
+   *  no task is in flight anywhere
+   */
+  bool WaitAndPop(std::unique_ptr<OptimizerTask> &task) {
+    std::unique_lock<std::mutex> guard(lock_);
+    while (task_queue_.empty() && in_flight_ > 0) {
+      cv_.wait(guard);
+    }
+    if (task_queue_.empty()) return false;
+    task = std::move(task_queue_.front());
+    task_queue_.pop_front();
+    in_flight_++;
+    return true;
+  }
+
+  // Must be called after executing a task handed out by WaitAndPop()
+  void MarkTaskCompleted() {
+    std::lock_guard<std::mutex> guard(lock_);
+    in_flight_--;
+    if (task_queue_.empty() && in_flight_ == 0) {
+      // Wake the workers blocked in WaitAndPop() so they can exit
+      cv_.notify_all();
+    }
+  }
+
+  // Hands the deferred stats derivation tasks back for serial replay
+  std::vector<std::unique_ptr<OptimizerTask>> TakeDeferredTasks() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return std::move(deferred_tasks_);
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<OptimizerTask>> task_queue_;
+  std::vector<std::unique_ptr<OptimizerTask>> deferred_tasks_;
+  // Number of tasks handed out by WaitAndPop() and not yet completed
+  size_t in_flight_ = 0;
+};
+
 }  // namespace optimizer
 }  // namespace peloton
@@ -69,6 +69,11 @@ class PlanGenerator : public OperatorVisitor {
   void Visit(const PhysicalOuterNLJoin *) override;
 
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerMergeJoin *) override;
+
+  void Visit(const PhysicalSemiHashJoin *) override;
+
+  void Visit(const PhysicalAntiHashJoin *) override;
 
   void Visit(const PhysicalLeftHashJoin *) override;
 
@@ -144,6 +149,25 @@ class PlanGenerator : public OperatorVisitor {
    *  the output plan produciing output columns is generated
    */
   void BuildProjectionPlan();
+
+  /**
+   * @brief Generate a hash join plan together with the hash plan hashing the
+   *  right child, shared by the inner/semi/anti hash join operators which only
+   *  differ in the join type they hand to the executor
+   *
+   * @param join_type The join type of the generated plan
+   * @param join_predicates The annotated join predicates
+   * @param left_keys The left child's join keys
+   * @param right_keys The right child's join keys, also used as hash keys
+   */
+  void BuildHashJoinPlan(
+      JoinType join_type,
+      const std::vector<AnnotatedExpression> &join_predicates,
+      const std::vector<std::unique_ptr<expression::AbstractExpression>>
+          &left_keys,
+      const std::vector<std::unique_ptr<expression::AbstractExpression>>
+          &right_keys);
+
   void BuildAggregatePlan(
       AggregateType aggr_type,
       const std::vector<std::shared_ptr<expression::AbstractExpression>>
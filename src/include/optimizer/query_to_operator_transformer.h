@@ -92,6 +92,7 @@ class QueryToOperatorTransformer : public SqlNodeVisitor {
    * @param expr The potential sub-query expression
    * @param select_list The select list of the sub-query we generate
    * @param single_join A boolean to tell if
+   * @param anti_join Generate an anti mark-join (NOT EXISTS sub-queries)
    *
    * @return If the expression could be transformed into sub-query, return true,
    *  return false otherwise
@@ -99,7 +100,7 @@ class QueryToOperatorTransformer : public SqlNodeVisitor {
   bool GenerateSubquerytree(
       expression::AbstractExpression *expr,
       std::vector<expression::AbstractExpression *> &select_list,
-      bool single_join = false);
+      bool single_join = false, bool anti_join = false);
 
   static bool RequireAggregation(const parser::SelectStatement *op);
 
@@ -223,6 +223,51 @@ class InnerJoinToInnerHashJoin : public Rule {
                  OptimizeContext *context) const override;
 };
 
+/**
+ * @brief (Logical Inner Join -> Inner Merge Join)
+ */
+class InnerJoinToInnerMergeJoin : public Rule {
+ public:
+  InnerJoinToInnerMergeJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
+/**
+ * @brief (Logical Semi Join -> Semi Hash Join)
+ */
+class SemiJoinToSemiHashJoin : public Rule {
+ public:
+  SemiJoinToSemiHashJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
+/**
+ * @brief (Logical Anti Join -> Anti Hash Join)
+ */
+class AntiJoinToAntiHashJoin : public Rule {
+ public:
+  AntiJoinToAntiHashJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
 /**
  * @brief (Logical Distinct -> Physical Distinct)
  */
@@ -275,6 +320,41 @@ class PushFilterThroughJoin : public Rule {
                  OptimizeContext *context) const override;
 };
 
+/**
+ * @brief Predicate push-down through a semi join. Single-side predicates
+ *  are pushed into the matching child; predicates referencing both sides
+ *  become the semi join's match condition
+ */
+class PushFilterThroughSemiJoin : public Rule {
+ public:
+  PushFilterThroughSemiJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
+/**
+ * @brief Predicate push-down through an anti join. Like the semi join
+ *  variant, except that predicates referencing only the inner (null-padded)
+ *  side stay in a filter above the join: they are the NOT EXISTS marker
+ *  predicates and must be evaluated on the join's padded output
+ */
+class PushFilterThroughAntiJoin : public Rule {
+ public:
+  PushFilterThroughAntiJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
 /**
  * @brief Combine multiple filters into one single filter using conjunction
  */
@@ -308,10 +388,24 @@ class EmbedFilterIntoGet : public Rule {
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-/// MarkJoinGetToInnerJoin
-class MarkJoinGetToInnerJoin : public Rule {
+/// MarkJoinGetToSemiJoin
+class MarkJoinGetToSemiJoin : public Rule {
+ public:
+  MarkJoinGetToSemiJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan,
+             OptimizeContext *context) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+                 OptimizeContext *context) const override;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// MarkJoinInnerJoinToSemiJoin
+class MarkJoinInnerJoinToSemiJoin : public Rule {
  public:
-  MarkJoinGetToInnerJoin();
+  MarkJoinInnerJoinToSemiJoin();
 
   bool Check(std::shared_ptr<OperatorExpression> plan,
              OptimizeContext *context) const override;
@@ -322,10 +416,10 @@ class MarkJoinGetToInnerJoin : public Rule {
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-/// MarkJoinInnerJoinToInnerJoin
-class MarkJoinInnerJoinToInnerJoin : public Rule {
+/// MarkJoinFilterToSemiJoin
+class MarkJoinFilterToSemiJoin : public Rule {
  public:
-  MarkJoinInnerJoinToInnerJoin();
+  MarkJoinFilterToSemiJoin();
 
   bool Check(std::shared_ptr<OperatorExpression> plan,
              OptimizeContext *context) const override;
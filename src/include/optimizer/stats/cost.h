@@ -32,6 +32,11 @@ static constexpr double DEFAULT_TUPLE_COST = 0.01;
 // Estimate the cost of processing each index entry during an index scan.
 static constexpr double DEFAULT_INDEX_TUPLE_COST = 0.005;
 
+// Estimate the cost of materializing each row into a hash-join build table.
+// Building is priced above probing so that, between two join orders with the
+// same output, the one with the smaller build side wins.
+static constexpr double DEFAULT_BUILD_TUPLE_COST = 4 * DEFAULT_TUPLE_COST;
+
 // Estimate the cost of processing each operator or function executed during a
 // query.
 static constexpr double DEFAULT_OPERATOR_COST = 0.0025;
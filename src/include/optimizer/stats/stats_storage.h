@@ -71,6 +71,8 @@ class StatsStorage {
 
   ResultType AnalyzeStatsForAllTables(concurrency::TransactionContext *txn = nullptr);
 
+  ResultType AnalyzeStaleTables(concurrency::TransactionContext *txn = nullptr);
+
   ResultType AnalyzeStatsForTable(storage::DataTable *table,
                                   concurrency::TransactionContext *txn = nullptr);
 
@@ -36,6 +36,15 @@ class TableStatsCollector {
 
   inline size_t GetColumnCount() { return column_count_; }
 
+  // Ratio of visited to sampled tuples; > 1 when ANALYZE ran on a sample.
+  // Sample-local frequencies multiplied by this estimate full-table counts.
+  inline double GetSampleRatio() {
+    return sampled_tuple_count_ == 0
+               ? 1.0
+               : static_cast<double>(visited_tuple_count_) /
+                     sampled_tuple_count_;
+  }
+
   ColumnStatsCollector* GetColumnStats(oid_t column_id);
 
  private:
@@ -44,11 +53,18 @@ class TableStatsCollector {
   std::vector<std::unique_ptr<ColumnStatsCollector>> column_stats_collectors_;
   size_t active_tuple_count_;
   size_t column_count_;
+  size_t visited_tuple_count_ = 0;
+  size_t sampled_tuple_count_ = 0;
 
   TableStatsCollector(const TableStatsCollector&);
   void operator=(const TableStatsCollector&);
 
   void InitColumnStatsCollectors();
+
+  // Scan only a random subset of tile groups covering sample_percent of the
+  // table, in full, and scale the table-level counts up from the visited
+  // fraction. Skipped tile groups are never touched.
+  void CollectBlockSampledStats(int sample_percent);
 };
 
 }  // namespace optimizer
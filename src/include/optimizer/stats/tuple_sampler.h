@@ -39,6 +39,14 @@ class TupleSampler {
   }
 
   size_t AcquireSampleTuples(size_t target_sample_count);
+
+  // Block-level sampling: visit tile groups in a random order and drain
+  // each one front to back until the target is met. Costs roughly
+  // target / tuples-per-tile-group block reads instead of one random
+  // block read per sampled tuple, at the price of clustering the sample
+  // by tile group.
+  size_t AcquireBlockSampleTuples(size_t target_sample_count);
+
   bool GetTupleInTileGroup(storage::TileGroup *tile_group, size_t tuple_offset,
                            std::unique_ptr<storage::Tuple> &tuple);
 
@@ -36,6 +36,7 @@ class StatsCalculator : public OperatorVisitor {
   void Visit(const LogicalRightJoin *) override;
   void Visit(const LogicalOuterJoin *) override;
   void Visit(const LogicalSemiJoin *) override;
+  void Visit(const LogicalAntiJoin *) override;
   void Visit(const LogicalAggregateAndGroupBy *) override;
   void Visit(const LogicalLimit *) override;
   void Visit(const LogicalDistinct *) override;
@@ -62,6 +63,21 @@ class StatsCalculator : public OperatorVisitor {
    * @param predicate_stats The stats for columns in the expression
    * @param predicates conjunction predicates
    */
+  /**
+   * @brief Derive the output row count and column stats of a two-way join
+   * from the children groups' stats, shared by the inner/semi/anti join
+   * visits. The inner estimate is the cross product scaled down by the
+   * equi-join conditions; a semi join caps it by the left row count since
+   * each left row is emitted at most once, and an anti join keeps the left
+   * rows the semi join would drop
+   *
+   * @param join_predicates The join's annotated predicates
+   * @param join_type The logical join type (INNER, SEMI or ANTI)
+   */
+  void CalculateJoinStats(
+      const std::vector<AnnotatedExpression> &join_predicates,
+      JoinType join_type);
+
   void UpdateStatsForFilter(
       size_t num_rows,
       std::unordered_map<std::string, std::shared_ptr<ColumnStats>>
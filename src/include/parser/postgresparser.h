@@ -119,7 +119,7 @@ class PostgresParser {
 
   // transform helper for select targets
   static std::vector<std::unique_ptr<expression::AbstractExpression>>
-      *TargetTransform(List *root);
+      TargetTransform(List *root);
 
   // transform helper for all expr nodes
   static expression::AbstractExpression *ExprTransform(Node *root);
@@ -204,12 +204,12 @@ class PostgresParser {
   static parser::SQLStatement *CreateViewTransform(ViewStmt *root);
 
   // transform helper for column name (for insert statement)
-  static std::vector<std::string> *ColumnNameTransform(List *root);
+  static std::vector<std::string> ColumnNameTransform(List *root);
 
   // transform helper for ListsTransform (insert multiple rows)
   static std::vector<
       std::vector<std::unique_ptr<expression::AbstractExpression>>>
-      *ValueListsTransform(List *root);
+      ValueListsTransform(List *root);
 
   // transform helper for insert statements
   static parser::SQLStatement *InsertTransform(InsertStmt *root);
@@ -231,7 +231,7 @@ class PostgresParser {
 
   // transform helper for update statement
   static std::vector<std::unique_ptr<parser::UpdateClause>>
-      *UpdateTargetTransform(List *root);
+      UpdateTargetTransform(List *root);
 
   // transform helper for drop statement
   static parser::DropStatement *DropTransform(DropStmt *root);
@@ -32,11 +32,24 @@ class CopyPlan : public AbstractPlan {
  public:
   CopyPlan() = delete;
 
+  // Export plan (COPY table TO file); the tuple source is attached as a
+  // seq scan child
   explicit CopyPlan(std::string file_path, bool deserialize_parameters)
       : file_path(file_path), deserialize_parameters(deserialize_parameters) {
     LOG_DEBUG("Creating a Copy Plan");
   }
 
+  // Import plan (COPY table FROM file); no child, the executor parses the
+  // file and bulk-loads the target table directly
+  CopyPlan(storage::DataTable *target_table, std::string file_path,
+           char delimiter)
+      : file_path(file_path),
+        is_import(true),
+        target_table(target_table),
+        delimiter(delimiter) {
+    LOG_DEBUG("Creating a Copy (import) Plan");
+  }
+
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::COPY; }
 
   const std::string GetInfo() const { return "CopyPlan"; }
@@ -50,6 +63,15 @@ class CopyPlan : public AbstractPlan {
   // Whether the copying requires deserialization of parameters
   bool deserialize_parameters = false;
 
+  // Whether this is an import (COPY FROM) rather than an export
+  bool is_import = false;
+
+  // The table being loaded (imports only)
+  storage::DataTable *target_table = nullptr;
+
+  // Field delimiter of the input file (imports only)
+  char delimiter = ',';
+
  private:
   DISALLOW_COPY_AND_MOVE(CopyPlan);
 };
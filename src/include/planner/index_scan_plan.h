@@ -60,12 +60,14 @@ class IndexScanPlan : public AbstractScan {
         const std::vector<oid_t> &p_tuple_column_id_list,
         const std::vector<ExpressionType> &expr_list_p,
         const std::vector<type::Value> &p_value_list,
-        const std::vector<expression::AbstractExpression *> &p_runtime_key_list)
+        const std::vector<expression::AbstractExpression *> &p_runtime_key_list,
+        const std::vector<std::vector<type::Value>> &p_or_value_list = {})
         : index_obj(p_index_obj),
           tuple_column_id_list(p_tuple_column_id_list),
           expr_list(expr_list_p),
           value_list(p_value_list),
-          runtime_key_list(p_runtime_key_list) {}
+          runtime_key_list(p_runtime_key_list),
+          or_value_list(p_or_value_list) {}
 
     ~IndexScanDesc() {
       // for (auto val : value_list)
@@ -94,6 +96,17 @@ class IndexScanPlan : public AbstractScan {
 
     // ???
     std::vector<expression::AbstractExpression *> runtime_key_list;
+
+    // Extra value lists connected to value_list by disjunctions, each over
+    // the same columns and operators: an IN list decomposes into one list
+    // per element and OR-connected ranges into one list per branch. Every
+    // list becomes one more probe interval in the scan predicate, and
+    // overlapping intervals are coalesced at plan construction.
+    //
+    // Strict comparisons (< and >) are not allowed here since the
+    // executor's open range handling only knows one global boundary pair;
+    // encode such branches as closed intervals before handing them in
+    std::vector<std::vector<type::Value>> or_value_list;
   };
 
   ///////////////////////////////////////////////////////////////////
@@ -168,7 +181,7 @@ class IndexScanPlan : public AbstractScan {
     }
 
     IndexScanDesc desc(index_, key_column_ids_, expr_types_, values_,
-                       new_runtime_keys);
+                       new_runtime_keys, or_values_);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
     return std::unique_ptr<AbstractPlan>(new_plan);
@@ -202,12 +215,15 @@ class IndexScanPlan : public AbstractScan {
   // the original copy of values with all the value parameters (bind them later)
   std::vector<type::Value> values_with_params_;
 
+  // The OR'd value lists, kept the same way as values_ so that the key
+  // templates built from them stay valid for the plan's whole lifetime
+  std::vector<std::vector<type::Value>> or_values_;
+  std::vector<std::vector<type::Value>> or_values_with_params_;
+
   const std::vector<expression::AbstractExpression *> runtime_keys_;
 
-  // Currently we just support single conjunction predicate
-  //
-  // In the future this might be extended into an array of conjunctive
-  // predicates connected by disjunction
+  // One conjunction per value list: the base list plus one for every
+  // entry of the descriptor's or_value_list, all connected by disjunction
   index::IndexScanPredicate index_predicate_;
 
   // whether the index scan range is left open
@@ -77,6 +77,10 @@ class InsertPlan : public AbstractPlan {
 
   type::Value GetValue(uint32_t idx) const { return values_.at(idx); }
 
+  // Reference access for the insert executor; values were already cast to
+  // the column types at bind time, so they can be stored without a copy
+  const type::Value &GetValueRef(uint32_t idx) const { return values_.at(idx); }
+
   oid_t GetBulkInsertCount() const { return bulk_insert_count_; }
 
   const storage::Tuple *GetTuple(int tuple_idx) const {
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "expression/abstract_expression.h"
+#include "expression/expression_program.h"
 #include "storage/tuple.h"
 #include "util/hash_util.h"
 
@@ -58,7 +59,9 @@ class ProjectInfo {
   ProjectInfo(TargetList &tl, DirectMapList &dml) = delete;
 
   ProjectInfo(TargetList &&tl, DirectMapList &&dml)
-      : target_list_(tl), direct_map_list_(dml) {}
+      : target_list_(tl), direct_map_list_(dml) {
+    CompileTargetPrograms();
+  }
 
   ~ProjectInfo();
 
@@ -117,11 +120,20 @@ class ProjectInfo {
 
   hash_t Hash(const planner::DerivedAttribute &attribute) const;
 
+  // Flatten each target-list expression whose shape allows it, so the
+  // per-tuple Evaluate() calls skip the virtual tree walk
+  void CompileTargetPrograms();
+
  private:
   TargetList target_list_;
 
   DirectMapList direct_map_list_;
 
+  // Evaluation programs, index-aligned with target_list_; null entries
+  // fall back to the expression tree
+  std::vector<std::unique_ptr<const expression::ExpressionProgram>>
+      target_programs_;
+
  private:
   DISALLOW_COPY_AND_MOVE(ProjectInfo);
 };
@@ -29,20 +29,35 @@ class SetOpPlan : public AbstractPlan {
  public:
   SetOpPlan(SetOpType set_op) : set_op_(set_op) {}
 
+  /**
+   * @param children_sorted Both children produce their output sorted
+   * ascending on the full column list (e.g. ordered index scans or an
+   * enforced sort), so the executor can run a streaming merge instead of
+   * building hash tables.
+   */
+  SetOpPlan(SetOpType set_op, bool children_sorted)
+      : set_op_(set_op), children_sorted_(children_sorted) {}
+
   SetOpType GetSetOp() const { return set_op_; }
 
+  bool AreChildrenSorted() const { return children_sorted_; }
+
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::SETOP; }
 
   const std::string GetInfo() const { return "SetOp"; }
 
   std::unique_ptr<AbstractPlan> Copy() const {
-    return std::unique_ptr<AbstractPlan>(new SetOpPlan(set_op_));
+    return std::unique_ptr<AbstractPlan>(
+        new SetOpPlan(set_op_, children_sorted_));
   }
 
  private:
   /** @brief Set Operation of this node */
   SetOpType set_op_;
 
+  /** @brief Children advertise sorted output; enables the streaming mode */
+  bool children_sorted_ = false;
+
  private:
   DISALLOW_COPY_AND_MOVE(SetOpPlan);
 };
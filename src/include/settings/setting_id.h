@@ -21,6 +21,8 @@ enum class SettingId {
   #include "settings/settings_macro.h"
   #include "settings/settings.h"
   #undef __SETTING_ENUM__
+  // sentinel used to size the per-type arrays in SettingsSnapshot
+  NUM_SETTINGS
 };
 
 }  // namespace settings
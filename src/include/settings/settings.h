@@ -83,6 +83,214 @@ SETTING_int(monoqueue_worker_pool_size,
             4,
             false, false)
 
+// Admission control at the traffic cop: each statement takes a slot of
+// its session's priority class before reaching the worker pool, and
+// queues when the class is at its cap. Freed capacity is handed out
+// highest class first, so capping the analytics classes below the worker
+// pool size keeps workers free for short high-priority transactions
+SETTING_bool(admission_control,
+            "Enable per-class admission control for statement execution (default: false)",
+            false,
+            true, true)
+
+SETTING_int(admission_high_limit,
+            "Concurrent statements admitted for the high priority class, 0 = unlimited (default: 0)",
+            0,
+            true, true)
+
+SETTING_int(admission_normal_limit,
+            "Concurrent statements admitted for the normal priority class, 0 = unlimited (default: 0)",
+            0,
+            true, true)
+
+SETTING_int(admission_low_limit,
+            "Concurrent statements admitted for the low priority class, 0 = unlimited (default: 2)",
+            2,
+            true, true)
+
+// Per-socket execution pools on NUMA machines: the MonoQueue worker budget
+// is split into one pool pinned per node, and statements targeting a table
+// whose insert partitions are bound to a single node run on that node's
+// pool. Work without a single home node stays on the shared pool.
+SETTING_bool(numa_partition_mode,
+            "Partition the MonoQueue worker pool per NUMA node (default: false)",
+            false,
+            false, false)
+
+// Back tile and index memory with explicit 2MB huge pages. Regions fall
+// back to transparent-huge-page advice when no huge pages are reserved.
+SETTING_bool(huge_pages,
+            "Back tile and index memory with 2MB huge pages (default: true)",
+            true,
+            false, false)
+
+// Morsel-driven parallel sequential scan
+SETTING_bool(parallel_seq_scan,
+            "Enable morsel-driven parallel sequential scan (default: false)",
+            false,
+            true, true)
+
+// Reuse optimized plans for queries that differ only in literal constants
+SETTING_bool(plan_cache,
+            "Cache optimized plans for unparameterized queries (default: true)",
+            true,
+            true, true)
+
+// Serve repeated read-only statements from cached result rows, invalidated
+// by per-relation write epochs
+SETTING_bool(result_cache,
+            "Cache read-only statement results at the traffic cop (default: false)",
+            false,
+            true, true)
+
+// Server-side retries for single-statement implicit transactions that
+// abort on a write conflict, instead of bouncing the abort to the client
+SETTING_int(single_statement_txn_retries,
+            "Automatic retries for conflict-aborted single-statement transactions, 0 disables (default: 3)",
+            3,
+            true, true)
+
+// Fraction of rows (in percent) ANALYZE feeds to the stats collectors
+SETTING_int(analyze_sample_percent,
+            "Percentage of rows sampled by ANALYZE when collecting column stats (default: 100)",
+            100,
+            true, true)
+
+SETTING_bool(analyze_block_sampling,
+             "Sample whole tile groups instead of individual rows when ANALYZE samples (default: true)",
+             true,
+             true, true)
+
+// Per-pipeline cycle/row counters emitted into compiled queries
+SETTING_bool(codegen_pipeline_metrics,
+            "Instrument compiled queries with per-pipeline cycle and row counters (default: false)",
+            false,
+            true, true)
+
+// New tile groups are sized by the table's observed scan/insert mix
+SETTING_bool(adaptive_tile_group_size,
+            "Adapt each table's tile group size to its scan/insert mix (default: false)",
+            false,
+            true, true)
+
+// Hash joins and aggregations hash a group of keys and prefetch all their
+// buckets before resolving the probes, hiding memory latency on
+// out-of-cache hash tables
+SETTING_bool(codegen_group_prefetch,
+            "Software-pipelined group prefetching for compiled hash probes (default: false)",
+            false,
+            true, true)
+
+// Parallelizable compiled pipelines run as morsels on the worker pool
+SETTING_bool(codegen_parallel_pipelines,
+            "Execute parallelizable compiled pipelines with multiple workers (default: false)",
+            false,
+            true, true)
+
+// Statements past the deadline fail at the next cancellation poll, which
+// both the interpreted and the compiled scan loops hit once per tile group
+SETTING_int(statement_timeout_ms,
+            "Abort statements running longer than this many milliseconds, 0 disables (default: 0)",
+            0,
+            true, true)
+
+// Covering primary-key scans answered from index keys without base tuples
+SETTING_bool(index_only_scan,
+            "Answer covering primary-key index scans from index keys alone (default: true)",
+            true,
+            true, true)
+
+// Composite-index scans that constrain only a key suffix enumerate the
+// distinct values of the unconstrained prefix and probe the suffix range
+// under each, instead of walking the whole index
+SETTING_bool(index_skip_scan,
+            "Skip-scan composite indexes whose key prefix is unconstrained (default: true)",
+            true,
+            true, true)
+
+// Radix-partition large hash-join build sides into cache-sized tables
+SETTING_bool(radix_hash_join,
+            "Enable radix-partitioned hash joins (default: false)",
+            false,
+            true, true)
+
+// Defensive cap on hash-join build rows: when a cardinality misestimate
+// makes the planned build side exceed the cap, the join builds over the
+// other side instead (0 disables the cap)
+SETTING_int(hash_build_row_cap,
+            "Hash-join build rows above which the join switches build sides (default: 0)",
+            0,
+            true, true)
+
+// Per-worker hash tables with a merge of the partial aggregation results
+SETTING_bool(parallel_aggregation,
+            "Enable parallel partitioned hash aggregation (default: false)",
+            false,
+            true, true)
+
+// Sort entries beyond this budget are spilled to disk as sorted runs
+SETTING_int(sort_buffer_mb,
+            "Memory budget in MB for ORDER BY sort runs before spilling to disk (default: 256)",
+            256,
+            true, true)
+
+// Temp-table tile groups beyond this budget are spilled to temp files
+SETTING_int(temp_table_spill_budget_mb,
+            "Memory budget in MB for temp table intermediate results before spilling to disk, 0 = never spill (default: 256)",
+            256,
+            true, true)
+
+// DISTINCT aggregate value sets beyond this budget are spilled to disk as
+// hash-partitioned runs and re-deduplicated one partition at a time
+SETTING_int(agg_distinct_spill_budget_mb,
+            "Memory budget in MB for DISTINCT aggregate value sets before spilling to disk, 0 = never spill (default: 256)",
+            256,
+            true, true)
+
+// An over-budget query triggers operator spill paths, then fails with an
+// executor error instead of exhausting process memory
+SETTING_int(query_memory_budget_mb,
+            "Memory budget in MB for a single query's tracked allocations, 0 = unlimited (default: 0)",
+            0,
+            true, true)
+
+// Concurrent sequential scans of a table share one circular pass over it
+SETTING_bool(shared_scan,
+            "Let concurrent sequential scans share a circular table pass (default: false)",
+            false,
+            true, true)
+
+// Single-statement SELECTs skip read-set maintenance and commit validation
+SETTING_bool(read_only_fast_path,
+            "Run single-statement SELECTs as read-only transactions (default: true)",
+            true,
+            true, true)
+
+// Batch commit durability through the dedicated log writer
+SETTING_bool(group_commit,
+            "Enable group commit in the log manager (default: true)",
+            true,
+            true, true)
+
+// How long the log writer accumulates commits before issuing one fsync
+SETTING_int(group_commit_window_us,
+            "Group commit window in microseconds (default: 1000)",
+            1000,
+            true, true)
+
+// How often the background checkpointer takes a checkpoint
+SETTING_int(checkpoint_interval_s,
+            "Interval between checkpoints in seconds (default: 30)",
+            30,
+            true, true)
+
+// Per-worker write rate cap so checkpointing does not disturb foreground
+// latency; 0 disables throttling
+SETTING_int(checkpoint_rate_mb_s,
+            "Checkpoint writer throughput cap in MB/s per worker, 0 = unthrottled (default: 64)",
+            64,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -111,6 +319,19 @@ SETTING_int(stats_mode,
            static_cast<int>(peloton::StatsType::INVALID),
            true, true)
 
+// Serve aggregated metrics over a plain-text pull endpoint so that
+// monitoring does not have to query the stats catalog tables
+SETTING_bool(metrics_export,
+            "Enable the metrics export endpoint (default: false)",
+            false,
+            false, false)
+
+// Port of the metrics export endpoint
+SETTING_int(metrics_export_port,
+           "Metrics export port (default: 15725)",
+           15725,
+           false, false)
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
@@ -127,6 +348,79 @@ SETTING_bool(layout_tuner,
             false,
             true, true)
 
+// Enable or disable background index delta-chain consolidation
+SETTING_bool(index_consolidator,
+            "Enable background index consolidation (default: false)",
+            false,
+            true, true)
+
+// Delta chains at least this long are consolidated by the background service
+SETTING_int(index_consolidator_threshold,
+            "Delta chain length that triggers background consolidation (default: 4)",
+            4,
+            true, true)
+
+// How long the background consolidator sleeps between passes
+SETTING_int(index_consolidator_interval_ms,
+            "Background index consolidation pass interval in ms (default: 10)",
+            10,
+            true, true)
+
+// Enable or disable background hot/cold tile group tiering
+SETTING_bool(tiering,
+            "Enable background tiering of cold tile groups (default: false)",
+            false,
+            true, true)
+
+// How long the tiering service sleeps between passes
+SETTING_int(tiering_interval_ms,
+            "Background tiering pass interval in ms (default: 1000)",
+            1000,
+            true, true)
+
+// Full tile groups not read for this many epochs are frozen
+SETTING_int(tiering_cold_epoch_count,
+            "Epochs without a read before a tile group is cold (default: 1500)",
+            1500,
+            true, true)
+
+// Per-table page cache budget for memory-mapped cold tiles; scanned-once
+// tiles are dropped before twice-touched ones (see storage::ColdTierCache)
+SETTING_int(cold_tier_cache_budget_mb,
+            "Per-table residency budget in MB for memory-mapped cold tiles, 0 = leave residency to the OS (default: 0)",
+            0,
+            true, true)
+
+// Enable or disable background compaction of sparse tile groups
+SETTING_bool(tile_group_compaction,
+            "Enable background tile group compaction (default: false)",
+            false,
+            true, true)
+
+// Full tile groups at least this dead are compacted by the background service
+SETTING_int(tile_group_compaction_threshold,
+            "Percent of dead tuple slots above which a full tile group is compacted (default: 90)",
+            90,
+            true, true)
+
+// Enable or disable stats-driven per-column auxiliary structure selection
+SETTING_bool(aux_tuner,
+            "Enable stats-driven zone map and bloom filter selection (default: false)",
+            false,
+            true, true)
+
+// How long the auxiliary structure tuner sleeps between passes
+SETTING_int(aux_tuner_interval_ms,
+            "Auxiliary structure tuning pass interval in ms (default: 1000)",
+            1000,
+            true, true)
+
+// Total size the tuner-built bloom filters may grow to
+SETTING_int(aux_tuner_bloom_budget_mb,
+            "Memory budget for tuner-built bloom filters in MB (default: 64)",
+            64,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // BRAIN
 //===----------------------------------------------------------------------===//
@@ -158,6 +452,47 @@ SETTING_bool(codegen,
             true,
             true, true)
 
+// Compile on a background worker while the first execution runs on the
+// interpreted executor tree
+SETTING_bool(codegen_async_compile,
+            "Compile queries asynchronously, interpreting until ready (default: false)",
+            false,
+            true, true)
+
+// Executions after which a fast-tier compiled query is recompiled at the
+// full optimization tier on a background worker
+SETTING_int(codegen_recompile_threshold,
+            "Executions before recompiling a query at full optimization, 0 = always compile at full optimization (default: 10)",
+            10,
+            true, true)
+
+// Executions a cached query's parameters are profiled over before a
+// variant specialized on the dominant parameter values is compiled
+SETTING_int(codegen_specialization_threshold,
+            "Executions before compiling a parameter-specialized query variant, 0 = disabled (default: 100)",
+            100,
+            true, true)
+
+// Share JIT-compiled function bodies across cached queries whose generated
+// IR is byte-identical, skipping compilation entirely for the adopter
+SETTING_bool(codegen_code_sharing,
+            "Share compiled code across queries with identical IR (default: true)",
+            true,
+            true, true)
+
+// Tuples the buffering consumer accumulates before draining them into the
+// marshalled result, bounding result-set memory during execution
+SETTING_int(codegen_result_batch_size,
+            "Tuples buffered before streaming a result batch, 0 = buffer the whole result (default: 1024)",
+            1024,
+            true, true)
+
+// Byte budget of the compiled query cache; oldest entries are evicted first
+SETTING_int(query_cache_size_kb,
+            "Compiled query cache budget in KB, 0 = unlimited (default: 65536)",
+            65536,
+            true, true)
+
 
 //===----------------------------------------------------------------------===//
 // Optimizer
@@ -172,6 +507,47 @@ SETTING_bool(hash_join_bloom_filter,
              true,
              true, true)
 
+// Run the cascades exploration pass on a worker pool so that large join
+// queries enumerate the plan space in parallel
+SETTING_bool(parallel_optimizer,
+             "Enable parallel plan space exploration (default: false)",
+             false,
+             true, true)
+
+// Number of workers draining the optimizer task pool when parallel
+// exploration is enabled
+SETTING_int(optimizer_worker_pool_size,
+            "Optimizer exploration worker pool size (default: 4)",
+            4,
+            true, true)
+
+// Maximum number of optimizer tasks executed for one query before the
+// search falls back to greedily implementing the plans found so far
+SETTING_int(optimizer_task_limit,
+            "Optimizer task budget per query, 0 = unlimited (default: 0)",
+            0,
+            true, true)
+
+// Maximum wall time the optimizer may spend searching for one query
+SETTING_int(optimizer_timeout_ms,
+            "Optimizer wall time budget in ms per query, 0 = unlimited (default: 0)",
+            0,
+            true, true)
+
+// Choose join orders for large select-project-join blocks with a
+// dynamic-programming enumerator before the cascades search
+SETTING_bool(optimizer_dp_join_enumeration,
+             "Enable DP join order enumeration for SPJ blocks (default: false)",
+             false,
+             true, true)
+
+// Inner-join blocks with at least this many base tables go through the
+// DP enumerator
+SETTING_int(optimizer_dp_join_threshold,
+            "Minimum joined tables before DP join enumeration runs (default: 4)",
+            4,
+            true, true)
+
 //===----------------------------------------------------------------------===//
 // GENERAL
 //===----------------------------------------------------------------------===//
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 #include "common/internal_types.h"
 #include "type/value.h"
@@ -23,6 +25,30 @@
 namespace peloton {
 namespace settings {
 
+// SettingsSnapshot:
+// read-only copy of all scalar setting values, rebuilt and atomically
+// swapped whenever a setting changes. Hot paths (GC, network, codegen)
+// read it through SettingsManager's accessors, which turns a settings
+// lookup into a version check plus an array load instead of a latched
+// map lookup. String settings are not snapshotted; they stay on the
+// slow path through the internal map.
+struct SettingsSnapshot {
+  uint64_t version;
+  int32_t int_values[static_cast<size_t>(SettingId::NUM_SETTINGS)];
+  double double_values[static_cast<size_t>(SettingId::NUM_SETTINGS)];
+  bool bool_values[static_cast<size_t>(SettingId::NUM_SETTINGS)];
+
+  inline int32_t GetInt(SettingId id) const {
+    return int_values[static_cast<size_t>(id)];
+  }
+  inline double GetDouble(SettingId id) const {
+    return double_values[static_cast<size_t>(id)];
+  }
+  inline bool GetBool(SettingId id) const {
+    return bool_values[static_cast<size_t>(id)];
+  }
+};
+
 // SettingsManager:
 // provide ability to define, get_value and set_value of setting parameters
 // It stores information in an internal map as well as catalog pg_settings
@@ -38,6 +64,11 @@ class SettingsManager : public Printable {
   static void SetString(SettingId id, const std::string &value);
   static SettingsManager &GetInstance();
 
+  // Return the current read-only snapshot. A thread-local pointer is
+  // revalidated against the published version, so repeated calls on the
+  // same thread are a version check plus a field load.
+  static const SettingsSnapshot *GetCurrentSnapshot();
+
   // Call this method in Catalog->Bootstrap
   // to store information into pg_settings
   void InitializeCatalog();
@@ -89,6 +120,16 @@ class SettingsManager : public Printable {
   void SetValue(SettingId id, const type::Value &value);
 
   bool InsertIntoCatalog(const Param &param);
+
+  // Rebuild the read-only snapshot from the internal map and publish it.
+  void RebuildSnapshot();
+
+  // current snapshot, swapped atomically on every SET
+  std::shared_ptr<SettingsSnapshot> snapshot_;
+
+  // version of the published snapshot, used by readers to revalidate
+  // their thread-local pointer
+  std::atomic<uint64_t> snapshot_version_;
 };
 
 }  // namespace settings
@@ -24,6 +24,7 @@
 #include "statistics/table_metric.h"
 #include "statistics/index_metric.h"
 #include "statistics/latency_metric.h"
+#include "statistics/histogram_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
 
@@ -79,6 +80,17 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the latency histogram for the given query type, creating it on
+  // first use. Unlike the sampled latency metric, the histograms capture
+  // every completed query, so tail percentiles are exact.
+  HistogramMetric* GetQueryLatencyHistogram(QueryType query_type);
+
+  // Returns the per-query-type latency histograms collected so far
+  const std::map<QueryType, std::unique_ptr<HistogramMetric>>&
+  GetQueryLatencyHistograms() const {
+    return query_latency_histograms_;
+  }
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -114,6 +126,10 @@ class BackendStatsContext {
   void InitQueryMetric(const std::shared_ptr<Statement> statement,
                        const std::shared_ptr<QueryMetric::QueryParams> params);
 
+  // Record one pipeline's cycle/row counters against the on going query
+  void RecordPipelineStat(uint32_t pipeline_id, const char *pipeline_info,
+                          uint64_t cycles, uint64_t rows);
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -161,9 +177,46 @@ class BackendStatsContext {
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
+  // Hot-path metric slots. Without them, every Increment* call pays two
+  // catalog tile-group lookups (table path) or a CuckooMap find with
+  // shared_ptr refcounting (index path) before touching a counter. The
+  // slots pin the last resolved metric, so repeated operations against the
+  // same tile group or index are plain per-thread counter bumps with no
+  // shared state. Cache-line aligned so the aggregator's interval harvest
+  // of neighboring members never false-shares with the hot slots. The
+  // cached raw pointers stay valid because metric maps only ever reset
+  // counters in place and never erase entries.
+  struct CACHE_ALIGNED TableMetricSlot {
+    oid_t tile_group_id = INVALID_OID;
+    TableMetric* metric = nullptr;
+  };
+
+  struct CACHE_ALIGNED IndexMetricSlot {
+    const index::IndexMetadata* metadata = nullptr;
+    IndexMetric* metric = nullptr;
+  };
+
+  TableMetricSlot table_metric_slot_;
+
+  IndexMetricSlot index_metric_slot_;
+
+  // Resolve the table metric for a tile group through the slot cache
+  TableMetric* GetCachedTableMetric(oid_t tile_group_id);
+
+  // Resolve the index metric for an index through the slot cache
+  IndexMetric* GetCachedIndexMetric(index::IndexMetadata* metadata);
+
+  // Latency histograms per query type
+  std::map<QueryType, std::unique_ptr<HistogramMetric>>
+      query_latency_histograms_;
+
   // The query metric for the on going metric
   std::shared_ptr<QueryMetric> ongoing_query_metric_ = nullptr;
 
+  // The query type of the on going query, recorded into the latency
+  // histograms when the query completes
+  QueryType ongoing_query_type_ = QueryType::QUERY_INVALID;
+
   // The thread ID of this worker
   std::thread::id thread_id_;
 
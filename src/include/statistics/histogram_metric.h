@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// histogram_metric.h
+//
+// Identification: src/include/statistics/histogram_metric.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric that records latencies into log-bucketed (HDR-style) histograms.
+ * Values are bucketed by their highest set bit with kSubBucketCount linear
+ * sub-buckets per power of two, so the relative error of any percentile is
+ * bounded by 1/kSubBucketCount while the whole histogram is a fixed-size
+ * array of plain counters. Recording is a single counter bump, and two
+ * histograms merge by adding their buckets, which is what lets the
+ * aggregator combine per-backend histograms into exact global percentiles -
+ * unlike sampled averages, nothing is lost in aggregation.
+ */
+class HistogramMetric : public AbstractMetric {
+ public:
+  HistogramMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Record a latency in milliseconds
+  void RecordLatency(double latency_ms);
+
+  inline int64_t GetTotalCount() const { return total_count_; }
+
+  // The latency (in milliseconds) at the given percentile fraction,
+  // e.g. 0.99 for P99. Accurate to one sub-bucket.
+  double GetPercentile(double fraction) const;
+
+  // The largest latency (in milliseconds) recorded
+  inline double GetMaxLatency() const {
+    return static_cast<double>(max_value_us_) / 1000.0;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  // Adds the source histogram's buckets into this histogram
+  void Aggregate(AbstractMetric &source);
+
+  // Returns a string representation of this histogram metric
+  const std::string GetInfo() const;
+
+ private:
+  // linear sub-buckets per power of two; bounds relative error to 12.5%
+  static const size_t kSubBucketBits = 3;
+  static const size_t kSubBucketCount = 1 << kSubBucketBits;
+
+  // bucket groups (powers of two); covers values up to ~2^42 microseconds
+  static const size_t kBucketGroups = 40;
+  static const size_t kNumBuckets = kBucketGroups * kSubBucketCount;
+
+  // The bucket a microsecond value falls into
+  static size_t BucketFor(uint64_t value_us);
+
+  // The lowest microsecond value mapping to the given bucket
+  static uint64_t BucketLowerBound(size_t bucket);
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Per-bucket counts. Plain integers: each histogram is owned by a single
+  // backend thread and only merged copies are read by the aggregator.
+  int64_t counts_[kNumBuckets];
+
+  // Total number of recorded values
+  int64_t total_count_;
+
+  // The largest value recorded, in microseconds
+  uint64_t max_value_us_;
+};
+
+}  // namespace stats
+}  // namespace peloton
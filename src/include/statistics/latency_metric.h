@@ -84,6 +84,11 @@ class LatencyMetric : public AbstractMetric {
   // collected so far.
   void ComputeLatencies();
 
+  // Returns the result of the last call to ComputeLatencies()
+  inline const LatencyMeasurements &GetMeasurements() const {
+    return latency_measurements_;
+  }
+
   // Combines the source latency metric with this latency metric
   void Aggregate(AbstractMetric &source);
 
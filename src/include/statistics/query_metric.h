@@ -63,6 +63,15 @@ class QueryMetric : public AbstractMetric {
     int num_params = 0;
   };
 
+  // Counters for one pipeline of a compiled query, reported by the
+  // instrumentation emitted into the generated code
+  struct PipelineStat {
+    uint32_t pipeline_id;
+    std::string pipeline_info;
+    uint64_t cycles;
+    uint64_t rows;
+  };
+
   QueryMetric(MetricType type, const std::string &query_name,
               std::shared_ptr<QueryParams> query_params,
               const oid_t database_id);
@@ -85,6 +94,17 @@ class QueryMetric : public AbstractMetric {
     return query_params_;
   }
 
+  inline const std::vector<PipelineStat> &GetPipelineStats() const {
+    return pipeline_stats_;
+  }
+
+  inline void RecordPipelineStat(uint32_t pipeline_id,
+                                 const std::string &pipeline_info,
+                                 uint64_t cycles, uint64_t rows) {
+    pipeline_stats_.push_back(
+        PipelineStat{pipeline_id, pipeline_info, cycles, rows});
+  }
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -124,6 +144,9 @@ class QueryMetric : public AbstractMetric {
 
   // Processor metric
   ProcessorMetric processor_metric_{MetricType::PROCESSOR};
+
+  // Per-pipeline cycle/row counters of the compiled query, if instrumented
+  std::vector<PipelineStat> pipeline_stats_;
 };
 
 }  // namespace stats
@@ -77,6 +77,11 @@ class StatsAggregator {
   // Get the current aggregated stats of all threads (including history)
   inline BackendStatsContext &GetAggregatedStats() { return aggregated_stats_; }
 
+  // Get the flat text rendering of the aggregated counters published at the
+  // end of the last aggregation interval. Safe to call from any thread; may
+  // return nullptr before the first interval completes.
+  std::shared_ptr<const std::string> GetExportSnapshot();
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -145,10 +150,22 @@ class StatsAggregator {
   // Abstract Pool to hold query strings
   std::unique_ptr<type::AbstractPool> pool_;
 
+  // Flat text rendering of the aggregated counters, swapped atomically at
+  // the end of each aggregation interval and served by the metrics export
+  // endpoint without touching the live metric containers
+  std::shared_ptr<const std::string> export_snapshot_;
+
+  // Query ids published into pg_query_progress last interval; these rows
+  // get deleted before the next snapshot is inserted
+  std::vector<uint64_t> published_progress_ids_;
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
 
+  // Render the aggregated counters into a flat text snapshot and publish it
+  void PublishExportSnapshot();
+
   // Write all metrics to metric tables
   void UpdateMetrics();
 
@@ -164,6 +181,13 @@ class StatsAggregator {
   // Write all query metrics to a metric table
   void UpdateQueryMetrics(int64_t time_stamp, concurrency::TransactionContext *txn);
 
+  void UpdateLatencyMetrics(int64_t time_stamp,
+                            concurrency::TransactionContext *txn);
+
+  // Replace the pg_query_progress contents with a snapshot of the live
+  // query registry
+  void UpdateQueryProgress(concurrency::TransactionContext *txn);
+
   // Aggregate stats periodically
   void RunAggregator();
 };
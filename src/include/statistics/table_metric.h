@@ -18,6 +18,7 @@
 #include "common/internal_types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
+#include "statistics/counter_metric.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -38,6 +39,10 @@ class TableMetric : public AbstractMetric {
 
   inline AccessMetric &GetTableAccess() { return table_access_; }
 
+  inline CounterMetric &GetColdTierHits() { return cold_tier_hits_; }
+
+  inline CounterMetric &GetColdTierMisses() { return cold_tier_misses_; }
+
   inline std::string GetName() { return table_name_; }
 
   inline oid_t GetDatabaseId() { return database_id_; }
@@ -48,12 +53,18 @@ class TableMetric : public AbstractMetric {
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { table_access_.Reset(); }
+  inline void Reset() {
+    table_access_.Reset();
+    cold_tier_hits_.Reset();
+    cold_tier_misses_.Reset();
+  }
 
   inline bool operator==(const TableMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
            table_name_ == other.table_name_ &&
-           table_access_ == other.table_access_;
+           table_access_ == other.table_access_ &&
+           cold_tier_hits_ == other.cold_tier_hits_ &&
+           cold_tier_misses_ == other.cold_tier_misses_;
   }
 
   inline bool operator!=(const TableMetric &other) { return !(*this == other); }
@@ -68,6 +79,8 @@ class TableMetric : public AbstractMetric {
     ;
     ss << peloton::GETINFO_SINGLE_LINE << std::endl;
     ss << table_access_.GetInfo();
+    ss << "[ cold tier hits=" << cold_tier_hits_.GetInfo()
+       << ", misses=" << cold_tier_misses_.GetInfo() << " ]" << std::endl;
     return ss.str();
   }
 
@@ -87,6 +100,10 @@ class TableMetric : public AbstractMetric {
 
   // The number of tuple accesses
   AccessMetric table_access_{MetricType::ACCESS};
+
+  // Cold tier cache references for this table (see storage::ColdTierCache)
+  CounterMetric cold_tier_hits_{MetricType::COUNTER};
+  CounterMetric cold_tier_misses_{MetricType::COUNTER};
 };
 
 }  // namespace stats
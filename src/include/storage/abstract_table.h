@@ -143,7 +143,8 @@ class AbstractTable : public Printable {
 
   TileGroup *GetTileGroupWithLayout(oid_t database_id, oid_t tile_group_id,
                                     const column_map_type &partitioning,
-                                    const size_t num_tuples);
+                                    const size_t num_tuples,
+                                    const int numa_node = INVALID_NUMA_NODE);
 
   column_map_type GetTileGroupLayout() const;
 
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cold_tier_cache.h
+//
+// Identification: src/include/storage/cold_tier_cache.h
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/internal_types.h"
+#include "common/scan_resistant_cache.h"
+
+namespace peloton {
+namespace storage {
+
+class Tile;
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Cold Tier Cache
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Scan-resistant residency management for memory-mapped cold tiles.
+ *
+ * Memory-mapped tiles (spilled TempTable tile groups today, any future
+ * mmap-backed cold tier) are paged in by the OS on access, so the page
+ * cache is their buffer tier -- and by default a single large scan of
+ * cold data can flush the hot working set out of it. This cache applies
+ * a midpoint-insertion / promotion-on-second-touch policy at tile
+ * granularity: a tile touched once sits in the probationary segment and
+ * is the first eviction victim, its resident pages dropped with
+ * madvise(DONTNEED); a tile touched again is promoted and prefetched
+ * with madvise(WILLNEED). One-pass scans therefore recycle probationary
+ * pages among themselves while repeatedly-read tiles stay resident.
+ *
+ * Partitions are per table, each with its own byte budget from the
+ * cold_tier_cache_budget_mb setting (0 leaves residency entirely to the
+ * OS). Hits and misses are recorded per table in statistics::TableMetric
+ * when stats collection is on.
+ */
+class ColdTierCache {
+ public:
+  ColdTierCache(const ColdTierCache &) = delete;
+  ColdTierCache &operator=(const ColdTierCache &) = delete;
+  ColdTierCache(ColdTierCache &&) = delete;
+  ColdTierCache &operator=(ColdTierCache &&) = delete;
+
+  // Singleton
+  static ColdTierCache &GetInstance();
+
+  /**
+   * Record a scan touching the tile group; only its memory-mapped tiles
+   * are considered. Called once per tile group as it enters the executor
+   * through a LogicalTile.
+   */
+  void OnTileGroupAccess(TileGroup *tile_group);
+
+  /**
+   * Forget a memory-mapped tile that is being destroyed, so the cache
+   * never hands a dangling tile out as an eviction victim.
+   */
+  void OnTileRelease(Tile *tile);
+
+  // Per-table counters, e.g. for tests; zero for unknown tables
+  uint64_t GetHitCount(const oid_t table_id);
+  uint64_t GetMissCount(const oid_t table_id);
+
+ private:
+  ColdTierCache() {}
+
+  using Partition = ScanResistantCache<oid_t, Tile *>;
+
+  // The table's partition, created on first use with the given budget
+  Partition &GetPartition(const oid_t table_id, const size_t budget_bytes);
+
+  std::unordered_map<oid_t, std::unique_ptr<Partition>> partitions_;
+
+  std::mutex partition_mutex_;
+};
+
+}  // namespace storage
+}  // namespace peloton
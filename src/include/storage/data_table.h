@@ -21,6 +21,7 @@
 #include "common/item_pointer.h"
 #include "common/platform.h"
 #include "common/container/lock_free_array.h"
+#include "common/container/lock_free_queue.h"
 #include "storage/abstract_table.h"
 #include "storage/indirection_array.h"
 #include "trigger/trigger.h"
@@ -56,6 +57,7 @@ class TransactionContext;
 namespace storage {
 
 class Tuple;
+class Tile;
 class TileGroup;
 class IndirectionArray;
 
@@ -128,6 +130,19 @@ class DataTable : public AbstractTable {
       concurrency::TransactionContext *transaction, ItemPointer **index_entry_ptr,
       bool check_fk = true);
 
+  // bulk-load a batch of tuples. tuple slots are allocated and constraints
+  // checked per tuple, but index maintenance is buffered per index, sorted
+  // by key and applied through Index::BulkInsertEntries, so each index is
+  // traversed with high locality instead of paying a cold traversal per row.
+  // on success, locations[i] and index_entry_ptrs[i] hold the slot and the
+  // index entry of the i-th tuple; the caller performs the transactional
+  // bookkeeping (e.g. PerformInsert) per tuple as usual.
+  bool InsertTupleBatch(const std::vector<const storage::Tuple *> &tuples,
+                        concurrency::TransactionContext *transaction,
+                        std::vector<ItemPointer> &locations,
+                        std::vector<ItemPointer *> &index_entry_ptrs,
+                        bool check_fk = true);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -147,8 +162,69 @@ class DataTable : public AbstractTable {
 
   size_t GetTileGroupCount() const;
 
+  // Drop up to max_count tile groups starting at the given table-local
+  // offset. Returns the number of offsets consumed (0 once the offset is
+  // past the end). Used by the GC manager to tear a dropped table down
+  // incrementally.
+  size_t DropTileGroups(const std::size_t tile_group_offset,
+                        const std::size_t max_count);
+
   // Get a tile group with given layout
-  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
+  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning,
+                                    const int numa_node = INVALID_NUMA_NODE);
+
+  //===--------------------------------------------------------------------===//
+  // ADAPTIVE TILE GROUP SIZING
+  //===--------------------------------------------------------------------===//
+
+  // Note one sequential scan over this table; new tile groups are sized
+  // by the scan/insert mix observed since the previous one
+  inline void RecordScan() { scan_count_++; }
+
+  uint64_t GetScanCount() const { return scan_count_.load(); }
+
+  //===--------------------------------------------------------------------===//
+  // SCHEMA EVOLUTION
+  //===--------------------------------------------------------------------===//
+
+  // Metadata-only ADD COLUMN fast path for nullable, unconstrained
+  // columns. The widened schema is published and the active tile groups
+  // are retired so new slots use the new layout; existing tile groups are
+  // never rewritten -- reads of the column against them resolve to NULL,
+  // and updates materialize it when they write a new version into a
+  // new-layout tile group. Returns false when the column does not qualify
+  // (constraints, or the table does not own its schema). Inserts racing
+  // with the swap may land in an old-layout tile group and keep the
+  // column NULL, which is the declared default.
+  bool AddDefaultNullColumn(const catalog::Column &column);
+
+  // Version of the table schema, bumped once per AddDefaultNullColumn()
+  oid_t GetSchemaVersion() const { return schema_version_.load(); }
+
+  // Shared single-column tile filled with NULLs, attached by scans in
+  // place of the given column when a tile group predates it
+  std::shared_ptr<Tile> GetNullFillTile(oid_t column_id, oid_t tuple_count);
+
+  //===--------------------------------------------------------------------===//
+  // NUMA AFFINITY
+  //===--------------------------------------------------------------------===//
+
+  // Bind the given insert partition (active tile group slot) to a NUMA
+  // node. Tile groups allocated for that partition from now on have their
+  // tuple storage placed on that node.
+  void SetPartitionNumaNode(const size_t active_tile_group_id,
+                            const int numa_node);
+
+  // NUMA node the given insert partition is bound to, or INVALID_NUMA_NODE
+  // if unbound
+  int GetPartitionNumaNode(const size_t active_tile_group_id) const;
+
+  // The table's home socket: the single NUMA node every bound insert
+  // partition shares, used to route the table's statements to that node's
+  // worker pool in NUMA partition mode. Tables with no affinity, or with
+  // partitions spread across several nodes, have no home and return
+  // INVALID_NUMA_NODE.
+  int GetHomeNumaNode() const;
 
   //===--------------------------------------------------------------------===//
   // TRIGGER
@@ -233,6 +309,24 @@ class DataTable : public AbstractTable {
 
   size_t GetTupleCount() const;
 
+  // recycled-slot reuse statistics: inserts served from a recycled slot vs.
+  // inserts that had to claim a fresh one
+  size_t GetRecycledSlotHitCount() const { return recycled_slot_hits_.load(); }
+
+  size_t GetRecycledSlotMissCount() const {
+    return recycled_slot_misses_.load();
+  }
+
+  // tuples inserted or deleted since the stats for this table were last
+  // collected; drives incremental (stale-only) ANALYZE
+  size_t GetTuplesModifiedSinceAnalyze() const {
+    return tuples_modified_since_analyze_.load();
+  }
+
+  void ResetTuplesModifiedSinceAnalyze() {
+    tuples_modified_since_analyze_ = 0;
+  }
+
   bool IsDirty() const;
 
   void ResetDirty();
@@ -261,6 +355,21 @@ class DataTable : public AbstractTable {
 
   void ClearIndexSamples();
 
+  //===--------------------------------------------------------------------===//
+  // ONLINE INDEX BUILD
+  //===--------------------------------------------------------------------===//
+
+  // While an index is being populated online, InsertInIndexes records every
+  // insert location in a side log so the builder can catch up on writes
+  // that raced with its snapshot scan instead of missing or blocking them.
+
+  void BeginIndexBuildLogging();
+
+  // Atomically take the locations recorded since the last drain
+  std::vector<ItemPointer> DrainIndexBuildLog();
+
+  void EndIndexBuildLogging();
+
   //===--------------------------------------------------------------------===//
   // UTILITIES
   //===--------------------------------------------------------------------===//
@@ -286,6 +395,10 @@ class DataTable : public AbstractTable {
                        concurrency::TransactionContext *transaction,
                        ItemPointer **index_entry_ptr);
 
+  // allocate an indirection pointing to the given tuple slot from the active
+  // indirection arrays.
+  ItemPointer *AllocateIndirection(ItemPointer location);
+
   static void SetActiveTileGroupCount(const size_t active_tile_group_count) {
     default_active_tilegroup_count_ = active_tile_group_count;
   }
@@ -298,6 +411,27 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Claim a slot for every tuple in the batch, reserving runs of
+  // consecutive slots from the active tile group with one atomic
+  // operation per run instead of one per tuple
+  bool GetEmptyTupleSlots(const std::vector<const storage::Tuple *> &tuples,
+                          std::vector<ItemPointer> &locations);
+
+  //===--------------------------------------------------------------------===//
+  // SHARED SCANS
+  //===--------------------------------------------------------------------===//
+
+  // tile group offset where concurrent sequential scans are currently
+  // reading. A newly attaching scan starts here and wraps around, so
+  // simultaneous scans share one pass over the table instead of evicting
+  // each other from cache.
+  size_t GetSharedScanPosition() const { return shared_scan_position_.load(); }
+
+  // publish the tile group offset a sequential scan is about to read
+  void SetSharedScanPosition(const size_t tile_group_offset) {
+    shared_scan_position_.store(tile_group_offset, std::memory_order_relaxed);
+  }
+
   hash_t Hash() const;
 
   bool Equals(const storage::DataTable &other) const;
@@ -327,8 +461,31 @@ class DataTable : public AbstractTable {
   // tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // tuple capacity for the next default tile group. the CREATE TABLE size
+  // unless adaptive_tile_group_size is on, in which case the size drifts
+  // with the table's scan/insert mix.
+  size_t ComputeTileGroupSize();
+
+  // the active tile group this thread inserts into. each inserting thread is
+  // assigned its own stripe so concurrent inserters do not contend on one
+  // tile group's slot counter.
+  size_t GetActiveTileGroupId() const;
+
+  // pop a recycled slot from this thread's shard, refilling it in a batch
+  // from the GC manager's per-table queue when empty. returns an invalid
+  // item pointer if no recycled slot is available.
+  ItemPointer GetRecycledTupleSlot();
+
+  // grow the number of active tile groups up to target_count (capped at
+  // max_active_tilegroup_count_) in response to observed insert concurrency
+  void GrowActiveTileGroups(size_t target_count);
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  // build the replacement indirection array for the given slot ahead of
+  // time, so that crossing the array boundary only swaps in a pointer
+  oid_t PrepareIndirectionArray(const size_t &active_indirection_array_id);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
@@ -355,7 +512,52 @@ class DataTable : public AbstractTable {
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  size_t active_tilegroup_count_;
+  // number of active tile groups currently striped across. grows towards
+  // max_active_tilegroup_count_ as insert concurrency is observed
+  std::atomic<size_t> active_tilegroup_count_;
+
+  // upper bound for active_tilegroup_count_; active_tile_groups_ and
+  // active_tilegroup_numa_nodes_ are pre-sized to this so growing never
+  // reallocates under concurrent readers
+  size_t max_active_tilegroup_count_;
+
+  // number of threads currently claiming a tuple slot, sampled to decide
+  // when to grow the active tile group count
+  std::atomic<size_t> active_inserter_count_ = ATOMIC_VAR_INIT(0);
+
+  // serializes growth of the active tile group set
+  std::mutex tilegroup_grow_mutex_;
+
+  // where concurrent sequential scans are currently reading
+  std::atomic<size_t> shared_scan_position_ = ATOMIC_VAR_INIT(0);
+
+  // recycled slots cached per inserter-thread shard, so slot reuse does not
+  // funnel every insert through the GC manager's shared per-table queue
+  std::vector<std::shared_ptr<LockFreeQueue<ItemPointer>>>
+      recycled_slot_shards_;
+
+  // # inserts served from a recycled slot / from a fresh slot
+  std::atomic<size_t> recycled_slot_hits_ = ATOMIC_VAR_INIT(0);
+  std::atomic<size_t> recycled_slot_misses_ = ATOMIC_VAR_INIT(0);
+
+  // # tuples modified since the last stats collection
+  std::atomic<size_t> tuples_modified_since_analyze_ = ATOMIC_VAR_INIT(0);
+
+  // schema version, bumped by AddDefaultNullColumn(); tile groups record
+  // the version they were laid out with
+  std::atomic<oid_t> schema_version_ = ATOMIC_VAR_INIT(0);
+
+  // schemas replaced by AddDefaultNullColumn(), kept alive for readers
+  // that fetched the pointer before the swap
+  std::vector<std::unique_ptr<catalog::Schema>> retired_schemas_;
+
+  // lazily built NULL-filled fill tiles, one per late-added column,
+  // shared by every tile group that predates that column
+  std::map<oid_t, std::shared_ptr<Tile>> null_fill_tiles_;
+
+  // serializes schema changes and fill tile construction
+  std::mutex schema_change_mutex_;
+
   size_t active_indirection_array_count_;
 
   const oid_t database_oid;
@@ -366,17 +568,38 @@ class DataTable : public AbstractTable {
   // number of tuples allocated per tilegroup
   size_t tuples_per_tilegroup_;
 
+  // ADAPTIVE TILE GROUP SIZING
+
+  // Sequential scans observed on this table
+  std::atomic<uint64_t> scan_count_ = ATOMIC_VAR_INIT(0);
+
+  // Scan count when the last default tile group was allocated
+  std::atomic<uint64_t> scans_at_last_tilegroup_ = ATOMIC_VAR_INIT(0);
+
+  // Current adaptive size; starts at the CREATE TABLE size and drifts
+  // between an eighth and eight times of it (see ComputeTileGroupSize)
+  std::atomic<size_t> adaptive_tuples_per_tilegroup_;
+
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
   std::vector<std::shared_ptr<storage::TileGroup>> active_tile_groups_;
 
+  // Per insert-partition NUMA affinity, indexed by active tile group slot;
+  // INVALID_NUMA_NODE entries have no affinity
+  std::vector<int> active_tilegroup_numa_nodes_;
+
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
   // INDIRECTIONS
   std::vector<std::shared_ptr<storage::IndirectionArray>>
       active_indirection_arrays_;
 
+  // replacement indirection arrays built ahead of the boundary, one per
+  // active slot; published and consumed with shared_ptr atomics
+  std::vector<std::shared_ptr<storage::IndirectionArray>>
+      prepared_indirection_arrays_;
+
   // data table mutex
   std::mutex data_table_mutex_;
 
@@ -429,6 +652,15 @@ class DataTable : public AbstractTable {
   // index samples mutex
   std::mutex index_samples_mutex_;
 
+  // whether inserts must be recorded for an in-progress online index build
+  std::atomic<bool> index_build_logging_{false};
+
+  // side log of insert locations that raced with an online index build
+  std::vector<ItemPointer> index_build_log_;
+
+  // index build log mutex
+  std::mutex index_build_log_mutex_;
+
   static oid_t invalid_tile_group_id;
 
   // trigger list
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary_encoded_column.h
+//
+// Identification: src/include/storage/dictionary_encoded_column.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/macros.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+class Tile;
+
+//===--------------------------------------------------------------------===//
+// DictionaryEncodedColumn
+//===--------------------------------------------------------------------===//
+
+/**
+ * Dictionary encoding for a VARCHAR column of a Tile.
+ *
+ * Low-cardinality string columns (status codes, country names, ...) store
+ * one VarlenPool pointer per tuple, which scatters reads across the pool
+ * during scans. This encoding keeps a single copy of each distinct string
+ * plus one fixed-width 32-bit code per tuple slot, so scans touch a dense
+ * code array and equality predicates compare integer codes instead of
+ * strings. Dictionary lookups are deferred until a consumer actually needs
+ * the string, e.g. during materialization.
+ *
+ * The encoding is built from an existing tile column via
+ * Tile::DictionaryEncodeColumn() and is immutable afterwards, so it is only
+ * attached to tiles whose tile group no longer accepts inserts.
+ */
+class DictionaryEncodedColumn {
+  DictionaryEncodedColumn(DictionaryEncodedColumn const &) = delete;
+  DictionaryEncodedColumn &operator=(DictionaryEncodedColumn const &) = delete;
+
+ public:
+  DictionaryEncodedColumn() {}
+
+  // Build the encoding from the given VARCHAR column of the tile, covering
+  // tuple slots [0, tuple_count)
+  void Build(Tile *tile, const oid_t column_itr, const oid_t tuple_count);
+
+  // Code stored for the given tuple slot
+  inline uint32_t GetCode(const oid_t tuple_offset) const {
+    PL_ASSERT(tuple_offset < codes_.size());
+    return codes_[tuple_offset];
+  }
+
+  // Dense code array, one entry per encoded tuple slot
+  inline const uint32_t *GetCodes() const { return codes_.data(); }
+
+  // String a code decodes to
+  inline const std::string &DecodeString(const uint32_t code) const {
+    PL_ASSERT(code < dictionary_.size());
+    return dictionary_[code];
+  }
+
+  // Decode a code into a VARCHAR value. The value references the
+  // dictionary's copy of the string, so no per-lookup allocation happens.
+  type::Value Decode(const uint32_t code) const;
+
+  // Look up the code of the given string value. Returns false if the value
+  // does not occur in the column, in which case an equality predicate can
+  // skip the whole tile.
+  bool TryGetCode(const type::Value &value, uint32_t &code) const;
+
+  // Number of distinct strings in the column
+  inline size_t GetCardinality() const { return dictionary_.size(); }
+
+  // Number of encoded tuple slots
+  inline size_t GetTupleCount() const { return codes_.size(); }
+
+ private:
+  // Distinct strings, indexed by code
+  std::vector<std::string> dictionary_;
+
+  // String -> code index used while building and for predicate probes
+  std::unordered_map<std::string, uint32_t> code_index_;
+
+  // Per-tuple-slot codes
+  std::vector<uint32_t> codes_;
+};
+
+}  // namespace storage
+}  // namespace peloton
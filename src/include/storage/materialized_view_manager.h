@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// materialized_view_manager.h
+//
+// Identification: src/include/storage/materialized_view_manager.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/synchronization/spin_latch.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace concurrency {
+class TransactionContext;
+}
+
+namespace storage {
+
+class DataTable;
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// MaterializedView
+//===--------------------------------------------------------------------===//
+
+/**
+ * An incrementally maintained GROUP BY rollup over one base table.
+ *
+ * The view keeps, per group-by key, the running state of a fixed list of
+ * aggregate terms. Only aggregates that are invertible under deletes are
+ * supported -- COUNT(*), COUNT(col) and SUM(col) -- so committed inserts
+ * add to a group's state, committed deletes subtract from it, and updates
+ * are a delete of the old version plus an insert of the new one. A group
+ * whose row count drops to zero is removed. AVG can be derived by the
+ * reader from SUM and COUNT; MIN/MAX cannot be maintained this way because
+ * deleting the current extremum would require a rescan.
+ *
+ * Deltas are applied on the transaction commit path, after the new
+ * versions have been installed, so the view only ever reflects committed
+ * data. Readers get a latched snapshot copy of the group table.
+ */
+class MaterializedView {
+ public:
+  /** One aggregate column of the view */
+  struct AggTerm {
+    // AGGREGATE_COUNT_STAR, AGGREGATE_COUNT or AGGREGATE_SUM
+    ExpressionType aggtype;
+
+    // Base table column the aggregate reads; ignored for COUNT(*)
+    oid_t column_id;
+  };
+
+  MaterializedView(DataTable *table, std::vector<oid_t> group_by_column_ids,
+                   std::vector<AggTerm> agg_terms);
+
+  MaterializedView(const MaterializedView &) = delete;
+  MaterializedView &operator=(const MaterializedView &) = delete;
+
+  /** @brief Fold a committed insert of the tuple at the given slot into the
+   *         view */
+  void ApplyInsert(TileGroup *tile_group, oid_t tuple_offset);
+
+  /** @brief Fold a committed delete of the tuple at the given slot out of
+   *         the view */
+  void ApplyDelete(TileGroup *tile_group, oid_t tuple_offset);
+
+  /** @brief Copy out the current view contents under the latch. Each row
+   *         holds the group-by values followed by one value per aggregate
+   *         term, in declaration order. */
+  void GetRows(std::vector<std::vector<type::Value>> &rows);
+
+  /** @brief Does this view answer the given aggregation shape over the
+   *         given table? */
+  bool Matches(oid_t table_oid, const std::vector<oid_t> &group_by_column_ids,
+               const std::vector<AggTerm> &agg_terms) const;
+
+  oid_t GetTableOid() const;
+
+  const std::vector<oid_t> &GetGroupByColumnIds() const {
+    return group_by_column_ids_;
+  }
+
+  const std::vector<AggTerm> &GetAggTerms() const { return agg_terms_; }
+
+ private:
+  /** Running aggregate state of one group */
+  struct GroupState {
+    // Number of live base rows in the group; the group dies at zero
+    int64_t row_count = 0;
+
+    // Per aggregate term: COUNT state (also backs COUNT(*))
+    std::vector<int64_t> counts;
+
+    // Per aggregate term: SUM state; invalid Value for non-SUM terms
+    std::vector<type::Value> sums;
+  };
+
+  struct ValueVectorHasher {
+    size_t operator()(const std::vector<type::Value> &values) const {
+      size_t seed = 0;
+      for (auto v : values) {
+        v.HashCombine(seed);
+      }
+      return seed;
+    }
+  };
+
+  struct ValueVectorCmp {
+    bool operator()(const std::vector<type::Value> &lhs,
+                    const std::vector<type::Value> &rhs) const {
+      if (lhs.size() != rhs.size()) return false;
+      for (size_t i = 0; i < lhs.size(); i++) {
+        if (lhs[i].CompareNotEquals(rhs[i]) == CmpBool::TRUE) return false;
+      }
+      return true;
+    }
+  };
+
+  // Build the group-by key of the tuple at the given slot
+  std::vector<type::Value> ExtractKey(TileGroup *tile_group,
+                                      oid_t tuple_offset) const;
+
+  // Apply one tuple with weight +1 (insert) or -1 (delete); caller holds
+  // the latch
+  void ApplyTuple(TileGroup *tile_group, oid_t tuple_offset, int64_t weight);
+
+  DataTable *table_;
+
+  std::vector<oid_t> group_by_column_ids_;
+
+  std::vector<AggTerm> agg_terms_;
+
+  common::synchronization::SpinLatch latch_;
+
+  std::unordered_map<std::vector<type::Value>, GroupState, ValueVectorHasher,
+                     ValueVectorCmp> groups_;
+};
+
+//===--------------------------------------------------------------------===//
+// MaterializedViewManager
+//===--------------------------------------------------------------------===//
+
+/**
+ * Process-wide registry of materialized views, keyed by base table oid.
+ *
+ * The transaction manager calls ApplyTransactionDelta with a committing
+ * transaction's write set right after version installation; the call is a
+ * single atomic-load no-op while no views exist, so tables without views
+ * pay nothing on commit.
+ */
+class MaterializedViewManager {
+ public:
+  MaterializedViewManager(const MaterializedViewManager &) = delete;
+  MaterializedViewManager &operator=(const MaterializedViewManager &) = delete;
+
+  static MaterializedViewManager &GetInstance();
+
+  /** @brief Register a view over the given table and populate it from the
+   *         rows visible to the given transaction. Like zone map creation,
+   *         the initial build is not synchronized against concurrent
+   *         writers; create views before the table takes writes. */
+  std::shared_ptr<MaterializedView> CreateView(
+      DataTable *table, std::vector<oid_t> group_by_column_ids,
+      std::vector<MaterializedView::AggTerm> agg_terms,
+      concurrency::TransactionContext *txn);
+
+  /** @brief Find a registered view answering the given aggregation shape,
+   *         or nullptr */
+  std::shared_ptr<MaterializedView> FindView(
+      oid_t table_oid, const std::vector<oid_t> &group_by_column_ids,
+      const std::vector<MaterializedView::AggTerm> &agg_terms);
+
+  /** @brief Drop every view registered over the given table */
+  void DropViews(oid_t table_oid);
+
+  /** @brief Fold a committed transaction's write set into all affected
+   *         views. Must be called after new versions are installed and
+   *         before their prev-version pointers are recycled. */
+  void ApplyTransactionDelta(const ReadWriteSet &rw_set);
+
+ private:
+  MaterializedViewManager() : view_count_(0) {}
+
+  // Commit-path fast-path guard; tracks the total number of views
+  std::atomic<size_t> view_count_;
+
+  common::synchronization::SpinLatch latch_;
+
+  std::unordered_map<oid_t, std::vector<std::shared_ptr<MaterializedView>>>
+      views_;
+};
+
+}  // namespace storage
+}  // namespace peloton
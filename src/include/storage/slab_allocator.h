@@ -0,0 +1,212 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_allocator.h
+//
+// Identification: src/include/storage/slab_allocator.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Slab Allocator
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Size-classed slab allocator for tile-sized allocations.
+ *
+ * Tile group churn (GC, tiering, temp tables) allocates and frees
+ * multi-megabyte buffers at a high rate. Routing those through the global
+ * heap allocator fragments large heaps and makes allocation latency
+ * unpredictable. This allocator instead carves power-of-two size classes
+ * out of large anonymous regions that are aligned for and advised towards
+ * huge pages, so repeated tile allocations recycle the same physical
+ * memory and scans benefit from fewer TLB misses.
+ *
+ * Regions are bound to the NUMA node of the requesting thread when the
+ * system supports it, giving each node its own pools and free lists.
+ * Allocations outside the supported size range fall back to the global
+ * heap, as do allocations made when no more regions can be reserved.
+ */
+class SlabAllocator {
+ public:
+  // Smallest and largest chunk sizes served from slabs. Requests outside
+  // this range go straight to the global heap.
+  static const size_t kMinChunkSize = 1ul << 12;  // 4 KB
+  static const size_t kMaxChunkSize = 1ul << 24;  // 16 MB
+
+  // Size of one memory region carved into chunks of a single size class
+  static const size_t kRegionSize = 1ul << 26;  // 64 MB
+
+  // Alignment granule for transparent huge pages
+  static const size_t kHugePageSize = 1ul << 21;  // 2 MB
+
+  // Number of power-of-two size classes between the chunk size bounds
+  static const uint32_t kNumSizeClasses = 13;
+
+  // Occupancy of one size class, aggregated over all pools
+  struct SizeClassStats {
+    // Chunk size of this class in bytes
+    size_t chunk_size;
+
+    // Number of chunks carved out so far
+    size_t total_chunks;
+
+    // Number of carved chunks currently sitting on free lists
+    size_t free_chunks;
+  };
+
+  // Allocator-wide occupancy statistics
+  struct Stats {
+    // Number of reserved regions
+    size_t region_count;
+
+    // Regions backed by explicitly reserved 2MB huge pages
+    size_t hugetlb_region_count;
+
+    // Regions that fell back to transparent-huge-page advice
+    size_t thp_region_count;
+
+    // Bytes reserved from the OS across all regions
+    size_t reserved_bytes;
+
+    // Bytes handed out to callers and not yet released
+    size_t allocated_bytes;
+
+    // Per-class occupancy
+    std::vector<SizeClassStats> size_classes;
+  };
+
+  // Global singleton
+  static SlabAllocator &GetInstance();
+
+  SlabAllocator();
+  ~SlabAllocator();
+
+  /**
+   * @brief Allocate a buffer of at least the given size.
+   *
+   * Sizes within the supported range are rounded up to the next size
+   * class and served from the local pool's free list; everything else is
+   * served from the global heap.
+   */
+  void *Allocate(size_t size);
+
+  /**
+   * @brief Allocate a dedicated huge-page-backed mapping for one large
+   * object, e.g. an index whose multi-megabyte mapping table lives
+   * inline in the object.
+   *
+   * The mapping is rounded up to the huge page granule and released as a
+   * whole; it never joins a free list. Falls back to the global heap
+   * when no mapping can be reserved.
+   */
+  void *AllocateHuge(size_t size);
+
+  /**
+   * @brief Release a buffer obtained from Allocate() or AllocateHuge().
+   *
+   * Slab-managed chunks go back onto the free list of their size class,
+   * huge-object mappings are unmapped, and heap-backed buffers are
+   * returned to the global heap.
+   */
+  void Release(void *address);
+
+  // Current occupancy statistics
+  Stats GetStats() const;
+
+ private:
+  // Size class marker for regions mapped for one large object
+  static const uint32_t kHugeObjectClass = UINT32_MAX;
+
+  // One region reserved from the OS, dedicated to a single size class or
+  // to a single large object
+  struct Region {
+    // Length of the region in bytes
+    size_t length;
+
+    // Pool (NUMA node) the region belongs to
+    uint32_t pool_index;
+
+    // Size class the region is carved into, or kHugeObjectClass
+    uint32_t class_index;
+
+    // Whether the region is backed by explicit huge pages
+    bool hugetlb;
+  };
+
+  // Per-NUMA-node pool of free lists, one per size class
+  struct Pool {
+    Pool() {
+      for (uint32_t i = 0; i < kNumSizeClasses; i++) {
+        free_lists[i] = nullptr;
+        free_chunks[i] = 0;
+        total_chunks[i] = 0;
+      }
+    }
+
+    // Protects the free lists and counters below
+    common::synchronization::SpinLatch latch;
+
+    // Intrusive singly-linked free list heads, one per size class
+    void *free_lists[kNumSizeClasses];
+
+    // Chunks currently on each free list
+    size_t free_chunks[kNumSizeClasses];
+
+    // Chunks carved out for each size class
+    size_t total_chunks[kNumSizeClasses];
+  };
+
+  // Size class index serving the given size
+  static uint32_t SizeClassIndex(size_t size);
+
+  // Chunk size of the given size class
+  static size_t ChunkSize(uint32_t class_index);
+
+  // Pool of the NUMA node the calling thread runs on
+  uint32_t LocalPoolIndex() const;
+
+  // Map a huge-page-aligned region of the given length bound to the
+  // given pool's node. Tries explicit huge pages first when the
+  // huge_pages setting is on, then falls back to an advised mapping.
+  // Returns nullptr when the reservation fails.
+  void *MapRegion(size_t length, uint32_t pool_index, bool &used_hugetlb);
+
+  // Carve a fresh region into chunks of the given class and push them
+  // onto the pool's free list. Expects the pool latch to be held.
+  bool RefillFreeList(Pool &pool, uint32_t pool_index, uint32_t class_index);
+
+ private:
+  // Per-NUMA-node pools; a single pool when NUMA is unavailable
+  std::vector<std::unique_ptr<Pool>> pools_;
+
+  // Protects the region map
+  mutable common::synchronization::SpinLatch region_latch_;
+
+  // All reserved regions, keyed by start address, so Release() can tell
+  // slab-managed chunks apart from heap-backed buffers
+  std::map<uintptr_t, Region> regions_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(SlabAllocator);
+};
+
+}  // namespace storage
+}  // namespace peloton
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// snapshot_exporter.h
+//
+// Identification: src/include/storage/snapshot_exporter.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "common/internal_types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+//===--------------------------------------------------------------------===//
+// Snapshot Exporter
+//===--------------------------------------------------------------------===//
+
+/**
+ * Consistent logical table dumps without a long-running transaction.
+ *
+ * A backup taken through the executor stack has to hold one transaction
+ * open for the whole dump, which pins the epoch low-watermark and stalls
+ * garbage collection for everything. The exporter instead freezes a
+ * snapshot commit id below the expired epoch (every transaction at or
+ * below it has finished, so visibility at that point is race-free) and
+ * pins only that snapshot in the garbage collector: versions the snapshot
+ * can still see are held back, while garbage created and superseded after
+ * the snapshot keeps being reclaimed as usual.
+ *
+ * ExportTable() then walks the table's tile groups directly, checking
+ * visibility against the frozen commit id per slot, and renders the rows
+ * with the same raw-storage kernels and escaping as the direct COPY TO
+ * path, so the segment files can be reloaded with COPY FROM. The tile
+ * group range is split across the worker pool; each worker writes its own
+ * segment file, "<prefix>.part-<n>".
+ */
+class SnapshotExporter {
+ public:
+  SnapshotExporter(const SnapshotExporter &) = delete;
+  SnapshotExporter &operator=(const SnapshotExporter &) = delete;
+
+  static SnapshotExporter &GetInstance();
+
+  // Freeze the export snapshot: pick a commit id below the expired epoch
+  // and pin it in the garbage collector. Every version visible at the
+  // returned commit id stays readable until Release() is called on it.
+  cid_t Freeze();
+
+  // Unpin a snapshot obtained from Freeze(). The versions it held back
+  // become reclaimable on the next GC pass.
+  void Release(const cid_t snapshot_cid);
+
+  // Dump every tuple visible at snapshot_cid into worker_count segment
+  // files named "<file_prefix>.part-<n>". Returns the number of tuples
+  // written, or 0 with a logged error if a segment file cannot be opened.
+  size_t ExportTable(DataTable *table, const std::string &file_prefix,
+                     const cid_t snapshot_cid, size_t worker_count);
+
+ private:
+  SnapshotExporter() {}
+
+  // Dump tile groups [tile_group_begin, tile_group_end) of table into the
+  // segment file at segment_path. Returns the tuple count, or 0 on error
+  // with *success cleared.
+  size_t DumpTileGroupRange(DataTable *table, const size_t tile_group_begin,
+                            const size_t tile_group_end,
+                            const cid_t snapshot_cid,
+                            const std::string &segment_path, bool *success);
+};
+
+}  // namespace storage
+}  // namespace peloton
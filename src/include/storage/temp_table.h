@@ -22,6 +22,10 @@ namespace catalog {
 class Schema;
 }
 
+namespace type {
+class QueryMemoryTracker;
+}
+
 namespace storage {
 
 class Tuple;
@@ -42,6 +46,15 @@ const oid_t TEMPTABLE_TILEGROUP_ID = 99999;
  * A TempTable is a non-thread-safe place to store tuples that don't
  * need to be durable, don't need indexes, don't need constraints.
  * This is designed to be faster than DataTable.
+ *
+ * Intermediate results do not have to fit in memory: once the heap bytes
+ * held by the table's tile groups exceed the spill budget (the
+ * temp_table_spill_budget_mb setting, overridable per instance), full tile
+ * groups are written to temp files oldest-first and remapped read-only, so
+ * the OS pages them back in with sequential readahead when they are
+ * scanned. Spilling is transparent to GetTileGroup() and TupleIterator;
+ * tables whose schema has uninlined varlen columns never spill, since
+ * their varlen pools cannot be remapped.
  */
 class TempTable : public AbstractTable {
   TempTable() = delete;
@@ -115,6 +128,32 @@ class TempTable : public AbstractTable {
 
   inline size_t GetTupleCount() const override { return number_of_tuples_; }
 
+  //===--------------------------------------------------------------------===//
+  // SPILLING
+  //===--------------------------------------------------------------------===//
+
+  // Override the spill budget of this table (bytes); 0 disables spilling
+  inline void SetSpillBudget(const size_t &budget_bytes) {
+    spill_budget_bytes_ = budget_bytes;
+  }
+
+  // Number of tile groups currently spilled to disk
+  inline size_t GetSpilledTileGroupCount() const {
+    return spilled_groups_.size();
+  }
+
+  // Charge this table's resident tile group bytes against a query memory
+  // tracker; pass nullptr to stop accounting
+  inline void SetMemoryTracker(type::QueryMemoryTracker *tracker) {
+    memory_tracker_ = tracker;
+  }
+
+  // Spill every full resident tile group regardless of the budget and
+  // return the heap bytes released. This is the table's memory-pressure
+  // valve: the owning executor registers it as a spill hook on the query
+  // memory tracker. Returns 0 when the schema cannot spill.
+  size_t SpillNow();
+
  protected:
   //===--------------------------------------------------------------------===//
   // INTERNAL METHODS
@@ -122,6 +161,14 @@ class TempTable : public AbstractTable {
 
   oid_t AddDefaultTileGroup();
 
+  // Spill full tile groups oldest-first while the heap bytes held by
+  // resident tile groups exceed the budget
+  void CheckSpill();
+
+  // Write the tile group's tiles to the spill directory and remap them
+  // read-only, releasing their heap memory
+  bool SpillTileGroup(const size_t tile_group_offset);
+
  private:
   // This is where we're actually going to store the data for this table
   std::vector<std::shared_ptr<storage::TileGroup>> tile_groups_;
@@ -130,6 +177,24 @@ class TempTable : public AbstractTable {
   // We don't need to protect this because a TempTable is not meant to be
   // concurrent.
   size_t number_of_tuples_ = 0;
+
+  // Heap bytes before tile groups start spilling; 0 disables spilling
+  size_t spill_budget_bytes_ = 0;
+
+  // Heap bytes currently held by resident (non-spilled) tile groups
+  size_t resident_bytes_ = 0;
+
+  // Offset of the next tile group to spill; everything before it is on disk
+  size_t spill_cursor_ = 0;
+
+  // Offsets of the tile groups spilled so far (for file cleanup)
+  std::vector<size_t> spilled_groups_;
+
+  // Directory holding this table's spill files, created on first spill
+  std::string spill_dir_;
+
+  // Query memory tracker charged for resident_bytes_, or null
+  type::QueryMemoryTracker *memory_tracker_ = nullptr;
 };
 
 }  // namespace storage
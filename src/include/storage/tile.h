@@ -13,6 +13,7 @@
 #pragma once
 
 #include <mutex>
+#include <unordered_map>
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
@@ -34,6 +35,7 @@ namespace storage {
 // Tile
 //===--------------------------------------------------------------------===//
 
+class DictionaryEncodedColumn;
 class Tuple;
 class TileGroup;
 class TileGroupHeader;
@@ -147,6 +149,10 @@ class Tile : public Printable {
 
   oid_t GetTileId() const { return tile_id; }
 
+  oid_t GetTableId() const { return table_id; }
+
+  oid_t GetDatabaseId() const { return database_id; }
+
   // Compare two tiles
   bool operator==(const Tile &other) const;
   bool operator!=(const Tile &other) const;
@@ -174,9 +180,87 @@ class Tile : public Printable {
 
   char *GetTupleLocation(const oid_t tuple_offset) const;
 
+  /**
+   * Re-pack the surviving uninlined varlen values of this tile into a fresh
+   * pool and swap it in, so the space of values the GC has already freed is
+   * given back instead of fragmenting the pool forever. Only safe once the
+   * owning tile group is immutable: no writer repoints fields concurrently,
+   * and each field update is a single pointer-sized store that concurrent
+   * readers see as either the old or the new (identical) value. Readers may
+   * still hold raw pointers into the old pool, so it is returned to the
+   * caller for deletion after an epoch grace period rather than deleted
+   * here. Returns nullptr if the tile has no varlen pool.
+   */
+  type::AbstractPool *CompactVarlenPool();
+
+  //===--------------------------------------------------------------------===//
+  // Dictionary encoding
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * Build a dictionary encoding for the given VARCHAR column, covering the
+   * currently active tuple slots. Should only be invoked once the owning
+   * tile group no longer accepts inserts, since the encoding is immutable.
+   * Returns false if the column type does not support dictionary encoding.
+   */
+  bool DictionaryEncodeColumn(const oid_t column_itr);
+
+  /**
+   * Dictionary encoding for the given column, or nullptr if the column has
+   * not been encoded.
+   */
+  const DictionaryEncodedColumn *GetDictionaryEncodedColumn(
+      const oid_t column_itr) const;
+
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Memory-mapped readonly storage
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * Write this tile's inlined data to the given file in its in-memory
+   * columnar layout, preceded by a page-sized header describing it. Only
+   * valid for fully-inlined schemas (uninlined values live in the varlen
+   * pool and cannot be remapped) and for tiles that no longer accept
+   * writes. Returns false if the tile is not eligible.
+   */
+  bool WriteToFile(const std::string &file_path) const;
+
+  /**
+   * Replace this tile's heap-allocated data with a read-only mapping of a
+   * file previously produced by WriteToFile(). The OS pages the data in
+   * lazily on first access, so a restarted node can serve queries without
+   * reloading tables through the logging path. The tile becomes immutable.
+   * Returns false if the file does not match this tile's layout.
+   */
+  bool MapFromFile(const std::string &file_path);
+
+  /** @brief True if the tile data is an mmap'ed read-only file. */
+  bool IsMemoryMapped() const { return mmap_base_ != nullptr; }
+
+  /**
+   * Tell the kernel the mapping will be read front to back, so it reads
+   * ahead aggressively and drops pages behind the scan. No-op for
+   * heap-backed tiles.
+   */
+  void AdviseSequentialAccess();
+
+  /**
+   * Ask the kernel to fault the whole mapping in, for tiles the cold tier
+   * cache just promoted to its protected segment. No-op for heap-backed
+   * tiles.
+   */
+  void AdviseWillNeed();
+
+  /**
+   * Drop the mapping's resident pages from the page cache, for tiles the
+   * cold tier cache evicted. The data stays readable; the next access
+   * simply faults it back in. No-op for heap-backed tiles.
+   */
+  void DropResidentPages();
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -197,6 +281,20 @@ class Tile : public Printable {
   // set of fixed-length tuple slots
   char *data;
 
+  // mmap'ed file image backing data, or nullptr for heap-backed tiles;
+  // data points kMmapHeaderSize bytes into it
+  char *mmap_base_ = nullptr;
+
+  // length of the mapping, header included
+  size_t mmap_length_ = 0;
+
+  // size of the file header preceding the data; page-sized so the data
+  // region stays page-aligned
+  static const size_t kMmapHeaderSize = 4096;
+
+  // magic number identifying tile files
+  static const uint32_t kTileFileMagic = 0x7445454C;  // "tEEL"
+
   // relevant tile group
   TileGroup *tile_group;
 
@@ -223,6 +321,11 @@ class Tile : public Printable {
 
   oid_t column_header_size;
 
+  // Dictionary encodings, keyed by column offset within this tile.
+  // Populated lazily via DictionaryEncodeColumn().
+  std::unordered_map<oid_t, std::unique_ptr<DictionaryEncodedColumn>>
+      dict_encoded_columns_;
+
   /**
    * NOTE : Tiles don't keep track of number of occupied slots.
    * This is maintained by shared Tile Header.
@@ -90,6 +90,14 @@ class TileGroup : public Printable {
   // insert tuple at next available slot in tile if a slot exists
   oid_t InsertTuple(const Tuple *tuple);
 
+  // insert a run of tuples starting at tuples[start_offset] into
+  // consecutive slots reserved with a single atomic operation.
+  // returns the number of tuples inserted (possibly fewer than max_count
+  // when the tile group fills up) and the first slot through first_slot
+  oid_t InsertTupleBatch(const std::vector<const Tuple *> &tuples,
+                         const size_t start_offset, const oid_t max_count,
+                         oid_t &first_slot);
+
   // insert tuple at specific tuple slot
   // used by recovery mode
   oid_t InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
@@ -147,6 +155,17 @@ class TileGroup : public Printable {
     return column_map;
   }
 
+  // True when this tile group physically stores the given table column;
+  // false for columns added to the table after this tile group was built
+  inline bool HasColumn(oid_t column_id) const {
+    return column_map.count(column_id) != 0;
+  }
+
+  // Version of the table schema this tile group was laid out with
+  oid_t GetSchemaVersion() const { return schema_version; }
+
+  void SetSchemaVersion(oid_t version) { schema_version = version; }
+
   oid_t GetTileGroupId() const;
 
   oid_t GetDatabaseId() const { return database_id; }
@@ -161,6 +180,16 @@ class TileGroup : public Printable {
 
   size_t GetTileCount() const { return tile_count; }
 
+  // Write every tile of this (immutable, fully-inlined) tile group to
+  // per-tile files under the given directory. Returns false if any tile is
+  // not eligible; see Tile::WriteToFile().
+  bool WriteTilesToDirectory(const std::string &dir_path) const;
+
+  // Replace the tiles' heap data with read-only mappings of the files
+  // previously produced by WriteTilesToDirectory(), letting the OS page
+  // them in lazily. Returns false if any tile file does not match.
+  bool MapTilesFromDirectory(const std::string &dir_path);
+
   // Sets the tile id and column id w.r.t that tile corresponding to
   // the specified tile group column id.
   inline void LocateTileAndColumn(oid_t column_offset, oid_t &tile_offset,
@@ -210,6 +239,10 @@ class TileGroup : public Printable {
   // associated table
   AbstractTable *table;  // this design is fantastic!!!
 
+  // version of the table schema this tile group was laid out with; tile
+  // groups predating a metadata-only ADD COLUMN keep their old layout
+  oid_t schema_version = 0;
+
   // number of tuple slots allocated
   oid_t num_tuple_slots;
 
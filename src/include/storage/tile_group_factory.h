@@ -33,7 +33,14 @@ class TileGroupFactory {
                                  oid_t tile_group_id, AbstractTable *table,
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
-                                 int tuple_count);
+                                 int tuple_count,
+                                 int numa_node = INVALID_NUMA_NODE);
+
+ private:
+  // Bind the tile group's tuple storage to the given NUMA node. No-op when
+  // the build has no libnuma support, NUMA is unavailable at runtime, or no
+  // affinity was requested.
+  static void BindToNumaNode(TileGroup *tile_group, int numa_node);
 };
 
 }  // namespace storage
@@ -19,6 +19,7 @@
 #include "common/macros.h"
 #include "common/synchronization/spin_latch.h"
 #include "common/printable.h"
+#include "storage/backend_manager.h"
 #include "storage/tuple.h"
 #include "common/internal_types.h"
 #include "type/value.h"
@@ -61,6 +62,20 @@ class TileGroup;
  *  TxnID != INITIAL_TXN_ID, BeginTS != MAX_CID --> to-be-updated old version
  *  TxnID != INITIAL_TXN_ID, BeginTS == MAX_CID, EndTS == MAX_CID --> to-be-installed new version
  *  TxnID != INITIAL_TXN_ID, BeginTS == MAX_CID, EndTS == INVALID_CID --> to-be-installed deleted version
+ *
+ *  COMPACT MODE:
+ *  ===================
+ *  On narrow tables the per-tuple MVCC header above (72 bytes) can exceed the
+ *  tuple itself. Once a tile group is immutable and every slot is all-visible
+ *  (committed, no writer, no bounded end timestamp), Freeze() collapses the
+ *  header to a one-bit-per-slot visibility bitmap plus a single begin
+ *  timestamp. In compact mode the getters synthesize the header fields:
+ *  visible slots read as committed versions that began at the frozen
+ *  timestamp, empty slots read as never-inserted. The first writer that
+ *  touches the tile group lazily re-expands the full header via Expand().
+ *  Freeze() must be driven from a quiescent point (e.g. the epoch-based GC
+ *  thread), since it frees the header storage that lock-free readers
+ *  dereference.
  */
 
 #define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
@@ -77,12 +92,30 @@ class TileGroupHeader : public Printable {
 
     header_size = other.header_size;
 
-    // copy over all the data
-    PL_MEMCPY(data, other.data, header_size);
+    compact_header = other.compact_header;
+    frozen_begin_cid = other.frozen_begin_cid;
+
+    if (other.compact_header == true) {
+      // copy over the visibility bitmap instead of the full header
+      size_t bitmap_size = (other.num_tuple_slots + 7) / 8;
+      if (visibility_bitmap == nullptr) {
+        visibility_bitmap = new char[bitmap_size];
+      }
+      PL_MEMCPY(visibility_bitmap, other.visibility_bitmap, bitmap_size);
+    } else {
+      // copy over all the data
+      if (data == nullptr) {
+        data = reinterpret_cast<char *>(
+            BackendManager::GetInstance().Allocate(backend_type, header_size));
+      }
+      PL_MEMCPY(data, other.data, header_size);
+    }
 
     num_tuple_slots = other.num_tuple_slots;
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
+    oid_t dead_count = other.dead_tuple_count;
+    dead_tuple_count = dead_count;
 
     return *this;
   }
@@ -105,6 +138,25 @@ class TileGroupHeader : public Printable {
     }
   }
 
+  // batched variant of GetNextEmptyTupleSlot(): a single atomic operation
+  // claims up to count consecutive slots for DataTable's batch insert path.
+  // returns the number of slots actually reserved (zero when the tile group
+  // is full) and the first reserved slot id through first_slot.
+  oid_t GetNextEmptyTupleSlots(const oid_t count, oid_t &first_slot) {
+    if (next_tuple_slot >= num_tuple_slots) {
+      return 0;
+    }
+
+    first_slot = next_tuple_slot.fetch_add(count, std::memory_order_relaxed);
+
+    if (first_slot >= num_tuple_slots) {
+      return 0;
+    }
+
+    oid_t available = num_tuple_slots - first_slot;
+    return available < count ? available : count;
+  }
+
   /**
    * Used by logging
    */
@@ -149,31 +201,52 @@ class TileGroupHeader : public Printable {
   // but the current transaction reads the txn_id.
   // the returned value seems to be uncertain.
   inline txn_id_t GetTransactionId(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      return GetFrozenVisibility(tuple_slot_id) ? INITIAL_TXN_ID
+                                                : INVALID_TXN_ID;
+    }
     return *((txn_id_t *)(TUPLE_HEADER_LOCATION));
   }
 
   inline cid_t GetBeginCommitId(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      return GetFrozenVisibility(tuple_slot_id) ? frozen_begin_cid : MAX_CID;
+    }
     return *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset));
   }
 
   inline cid_t GetEndCommitId(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      return MAX_CID;
+    }
     return *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset));
   }
 
   inline ItemPointer GetNextItemPointer(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      // frozen versions have no version chain
+      return INVALID_ITEMPOINTER;
+    }
     return *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset));
   }
 
   inline ItemPointer GetPrevItemPointer(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      return INVALID_ITEMPOINTER;
+    }
     return *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset));
   }
 
   inline ItemPointer *GetIndirection(const oid_t &tuple_slot_id) const {
+    if (compact_header == true) {
+      return nullptr;
+    }
     return *(ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset);
   }
 
   // constraint: at most 16 bytes.
   inline char *GetReservedFieldRef(const oid_t &tuple_slot_id) const {
+    ExpandIfCompact();
     return (char *)(TUPLE_HEADER_LOCATION + reserved_field_offset);
   }
 
@@ -184,31 +257,54 @@ class TileGroupHeader : public Printable {
   }
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) const {
+    ExpandIfCompact();
     *((txn_id_t *)(TUPLE_HEADER_LOCATION)) = transaction_id;
   }
 
   inline void SetBeginCommitId(const oid_t &tuple_slot_id,
                                const cid_t &begin_cid) {
+    ExpandIfCompact();
     *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset)) = begin_cid;
   }
 
   inline void SetEndCommitId(const oid_t &tuple_slot_id,
                              const cid_t &end_cid) const {
+    ExpandIfCompact();
     *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset)) = end_cid;
   }
 
   inline void SetNextItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
+    ExpandIfCompact();
     *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset)) = item;
   }
 
+  // atomically swing the next (older version) pointer from expected to
+  // replacement. used by cooperative version chain pruning on the read
+  // path, where concurrent readers may race to bypass the same version.
+  inline bool CASNextItemPointer(const oid_t &tuple_slot_id,
+                                 const ItemPointer &expected,
+                                 const ItemPointer &replacement) const {
+    ExpandIfCompact();
+    static_assert(sizeof(ItemPointer) == sizeof(uint64_t),
+                  "ItemPointer must be CAS-able as a single word");
+    uint64_t expected_val, replacement_val;
+    PL_MEMCPY(&expected_val, &expected, sizeof(uint64_t));
+    PL_MEMCPY(&replacement_val, &replacement, sizeof(uint64_t));
+    return __sync_bool_compare_and_swap(
+        (uint64_t *)(TUPLE_HEADER_LOCATION + next_pointer_offset),
+        expected_val, replacement_val);
+  }
+
   inline void SetPrevItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
+    ExpandIfCompact();
     *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset)) = item;
   }
 
   inline void SetIndirection(const oid_t &tuple_slot_id,
                              const ItemPointer *indirection) const {
+    ExpandIfCompact();
     *((const ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset)) =
         indirection;
   }
@@ -216,12 +312,14 @@ class TileGroupHeader : public Printable {
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
+    ExpandIfCompact();
     txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     return __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
   }
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
+    ExpandIfCompact();
     txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     return __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
                                         transaction_id);
@@ -245,6 +343,55 @@ class TileGroupHeader : public Printable {
 
   inline bool GetImmutability() const { return immutable; }
 
+  /*
+  * @brief Count of dead slots in this tile group, maintained incrementally:
+  * the GC bumps it when it resets a reclaimed version and the recycler
+  * drops it when the slot is handed back out for an insert. Lets the
+  * compaction service find sparse tile groups without scanning headers.
+  */
+  inline void IncrementDeadTupleCount() {
+    dead_tuple_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void DecrementDeadTupleCount() {
+    dead_tuple_count.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  inline oid_t GetDeadTupleCount() const {
+    return dead_tuple_count.load(std::memory_order_relaxed);
+  }
+
+  /*
+  * @brief Collapse the per-tuple MVCC header of an immutable, all-visible
+  * tile group into a one-bit visibility bitmap (see COMPACT MODE above).
+  * Returns false if the tile group is not immutable, is already compact,
+  * or still holds a slot that is write-locked or not all-visible.
+  * Must be called from a point where no concurrent reader can hold a raw
+  * pointer into the header storage.
+  */
+  bool Freeze();
+
+  /*
+  * @brief Rebuild the full per-tuple header from the visibility bitmap.
+  * Invoked lazily by the setters when a writer touches a compact tile
+  * group; safe to call on a non-compact header (no-op).
+  */
+  void Expand();
+
+  inline bool IsCompact() const { return compact_header; }
+
+  /*
+  * @brief Record that the tile group was read at the given epoch. Called on
+  * the scan path, so a plain relaxed store is used to keep it cheap.
+  */
+  inline void SetLastAccessEpochId(const eid_t epoch_id) {
+    last_access_epoch_id.store(epoch_id, std::memory_order_relaxed);
+  }
+
+  inline eid_t GetLastAccessEpochId() const {
+    return last_access_epoch_id.load(std::memory_order_relaxed);
+  }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -279,6 +426,18 @@ class TileGroupHeader : public Printable {
       indirection_offset + sizeof(ItemPointer);
 
  private:
+  inline void ExpandIfCompact() const {
+    if (compact_header == true) {
+      // the setters are const while mutating the header storage; expansion
+      // follows the same convention
+      const_cast<TileGroupHeader *>(this)->Expand();
+    }
+  }
+
+  inline bool GetFrozenVisibility(const oid_t &tuple_slot_id) const {
+    return (visibility_bitmap[tuple_slot_id >> 3] >> (tuple_slot_id & 7)) & 1;
+  }
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -307,6 +466,24 @@ class TileGroupHeader : public Printable {
   // Immmutable Flag. Should be set by the brain to be true.
   // By default it will be set to false.
   bool immutable;
+
+  // Epoch at which the tile group was last read. Used by the tiering
+  // service to identify cold tile groups.
+  std::atomic<eid_t> last_access_epoch_id;
+
+  // Number of dead (GC-reset, not yet recycled) tuple slots. Used by the
+  // compaction service to identify sparse tile groups.
+  std::atomic<oid_t> dead_tuple_count;
+
+  // True once Freeze() collapsed the header; data is null and the fields
+  // below describe the frozen state.
+  bool compact_header;
+
+  // One bit per tuple slot: set iff the slot holds a visible frozen version
+  char *visibility_bitmap;
+
+  // Begin timestamp reported for every visible slot while compact
+  cid_t frozen_begin_cid;
 };
 
 }  // namespace storage
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/internal_types.h"
 #include "common/iterator.h"
@@ -62,5 +63,61 @@ class TileGroupIterator : public Iterator<std::shared_ptr<TileGroup>> {
   oid_t tile_group_itr_;
 };
 
+//===--------------------------------------------------------------------===//
+// TileGroup Window Iterator
+//===--------------------------------------------------------------------===//
+
+/**
+ * Iterator for full-table sweeps that pins a window of tile groups at a
+ * time instead of fetching one shared_ptr per step from the catalog map.
+ * When a window is filled, a prefetch is issued for every pinned group's
+ * header and tile data start, so by the time the sweep reaches the later
+ * groups of the window their first lines are already in cache.
+ *
+ * The raw pointer handed out by Next() stays valid until the next window
+ * is filled - the window holds the pins. Like TileGroupIterator, this is
+ * neither thread-safe nor transactional.
+ **/
+class TileGroupWindowIterator {
+  TileGroupWindowIterator() = delete;
+
+ public:
+  /** default # of tile groups pinned per window */
+  static const size_t DEFAULT_WINDOW_SIZE = 8;
+
+  TileGroupWindowIterator(const DataTable *table,
+                          size_t window_size = DEFAULT_WINDOW_SIZE)
+      : table_(table),
+        window_size_(window_size),
+        tile_group_itr_(0),
+        window_pos_(0) {}
+
+  /**
+   * Updates the given pointer so that it points to the next tile group in
+   * the table; the pointee is pinned until the next window is filled.
+   * @return true if succeeded. false if no more tile groups are there.
+   */
+  bool Next(TileGroup *&tile_group);
+
+ private:
+  // Pin the next window of tile groups and prefetch their headers/data
+  bool FillWindow();
+
+  // Table
+  const DataTable *table_;
+
+  // # of tile groups pinned at once
+  size_t window_size_;
+
+  // Offset of the next tile group to pin
+  oid_t tile_group_itr_;
+
+  // Position of the next unserved group within the window
+  size_t window_pos_;
+
+  // Currently pinned tile groups
+  std::vector<std::shared_ptr<TileGroup>> window_;
+};
+
 }  // namespace storage
 }  // namespace peloton
@@ -49,10 +49,14 @@ class ZoneMapManager {
   void CreateZoneMapsForTable(storage::DataTable *table,
                               concurrency::TransactionContext *txn);
 
-  void CreateOrUpdateZoneMapForTileGroup(storage::DataTable *table, 
+  void CreateOrUpdateZoneMapForTileGroup(storage::DataTable *table,
                                          oid_t tile_group_idx,
                                         concurrency::TransactionContext *txn);
 
+  void CreateOrUpdateZoneMapForColumn(storage::DataTable *table,
+                                      oid_t tile_group_idx, oid_t col_id,
+                                      concurrency::TransactionContext *txn);
+
   void CreateOrUpdateZoneMapInCatalog(oid_t database_id, oid_t table_id,
                                       oid_t tile_group_id, oid_t col_itr,
                                       std::string min, std::string max,
@@ -69,6 +73,11 @@ class ZoneMapManager {
 
   bool ZoneMapTableExists();
 
+  // Column types min/max statistics are maintained for. Fixed-width
+  // numerics plus DECIMAL, DATE and TIMESTAMP; varlen types are excluded
+  // since their min/max are rarely selective and bloat the catalog.
+  static bool IsZoneMappableType(type::TypeId type_id);
+
  private:
   //===--------------------------------------------------------------------===//
   // Utilities
@@ -12,22 +12,28 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
 #include "settings/settings_manager.h"
-#include "worker_pool.h"
+#include "threadpool/task_future.h"
+#include "threadpool/work_stealing_pool.h"
 
 namespace peloton {
 namespace threadpool {
 
 /**
- * @brief Wrapper class for single queue and single pool.
- * One should use this if possible.
+ * @brief The server's shared task pool. Submissions go to per-worker
+ * work-stealing deques rather than one shared queue, so the queue head is
+ * no longer a contention hotspot and tasks submitted with an affinity hint
+ * keep cache locality on their home worker.
  */
 class MonoQueuePool {
  public:
-  MonoQueuePool(uint32_t task_queue_size, uint32_t worker_pool_size)
-      : task_queue_(task_queue_size),
-        worker_pool_(worker_pool_size, &task_queue_),
-        is_running_(false) {}
+  MonoQueuePool(UNUSED_ATTRIBUTE uint32_t task_queue_size,
+                uint32_t worker_pool_size, int numa_node = INVALID_NUMA_NODE)
+      : worker_pool_(worker_pool_size, numa_node), is_running_(false) {}
 
   ~MonoQueuePool() {
     if (is_running_) {
@@ -49,7 +55,49 @@ class MonoQueuePool {
     if (!is_running_) {
       Startup();
     }
-    task_queue_.Enqueue(std::move(func));
+    worker_pool_.SubmitTask(std::move(func));
+  }
+
+  // Submit a task with an affinity hint; tasks sharing a hint (e.g. the
+  // parallel-scan morsel workers of one table) share a home worker
+  void SubmitTask(size_t affinity_hint, std::function<void()> func) {
+    if (!is_running_) {
+      Startup();
+    }
+    worker_pool_.SubmitTask(affinity_hint, std::move(func));
+  }
+
+  /**
+   * Submit a task and get a TaskFuture back. Continuations chained with
+   * Then() and joins built with TaskFuture::WhenAll() run on the pool when
+   * their predecessors finish, so a multi-stage operator (e.g. partition,
+   * then build, then probe) never parks a worker to wait between stages;
+   * only a final Wait() blocks, and only its caller.
+   */
+  TaskFuture SubmitTaskWithFuture(std::function<void()> func) {
+    if (!is_running_) {
+      Startup();
+    }
+    auto state = TaskFuture::MakeState(&worker_pool_);
+    worker_pool_.SubmitTask([func, state]() {
+      func();
+      state->Complete();
+    });
+    return TaskFuture(state);
+  }
+
+  // As above, with an affinity hint (see SubmitTask)
+  TaskFuture SubmitTaskWithFuture(size_t affinity_hint,
+                                  std::function<void()> func) {
+    if (!is_running_) {
+      Startup();
+    }
+    auto state = TaskFuture::MakeState(&worker_pool_);
+    worker_pool_.SubmitTask(affinity_hint, [func, state]() {
+      func();
+      state->Complete();
+    });
+    return TaskFuture(state);
   }
 
   static MonoQueuePool &GetInstance() {
@@ -70,9 +118,28 @@ class MonoQueuePool {
     return brain_queue_pool;
   }
 
+  // Number of NUMA nodes the platform exposes; 1 without PELOTON_NUMA or on
+  // single-socket machines
+  static int NumaNodeCount();
+
+  /**
+   * The pool executing work homed on the given NUMA node. In NUMA partition
+   * mode (settings::SettingId::numa_partition_mode) the shared worker
+   * budget is split into one pool pinned per node, so work routed here
+   * stays on its home socket; with the mode off, an unknown home node, or a
+   * single-node machine this falls back to the shared instance.
+   */
+  static MonoQueuePool &GetInstance(int numa_node);
+
+  // Start/stop the per-node pools next to the shared one during server
+  // init/shutdown; no-ops unless NUMA partition mode is on
+  static void StartupNodeInstances();
+  static void ShutdownNodeInstances();
+
  private:
-  TaskQueue task_queue_;
-  WorkerPool worker_pool_;
+  static std::vector<std::unique_ptr<MonoQueuePool>> &GetNodeInstances();
+
+  WorkStealingPool worker_pool_;
   bool is_running_;
 };
 
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_future.h
+//
+// Identification: src/include/threadpool/task_future.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "threadpool/work_stealing_pool.h"
+
+namespace peloton {
+namespace threadpool {
+
+class MonoQueuePool;
+
+/**
+ * @brief Completion handle for a task submitted to the pool.
+ *
+ * A TaskFuture lets multi-stage parallel operators chain their stages
+ * instead of parking a worker thread on a condition variable between them:
+ * Then() schedules a continuation onto the pool once the task completes and
+ * returns a future for the continuation, so chains compose, and WhenAll()
+ * produces a future that completes once a whole set of tasks has finished
+ * (e.g. every partition worker of a build phase). No thread blocks unless
+ * it explicitly calls Wait(), which the final consumer of a chain does.
+ *
+ * Futures are cheap shared handles; copies observe the same completion.
+ */
+class TaskFuture {
+ public:
+  // An invalid future; observing it is a programming error
+  TaskFuture() = default;
+
+  bool IsValid() const { return state_ != nullptr; }
+
+  // True once the task has finished running
+  bool IsDone() const;
+
+  // Block the calling thread until the task has finished
+  void Wait() const;
+
+  /**
+   * Schedule a continuation to run on the pool after this task completes,
+   * immediately if it already has. Returns the continuation's future, so
+   * stages chain: SubmitTaskWithFuture(a).Then(b).Then(c).
+   */
+  TaskFuture Then(std::function<void()> continuation) const;
+
+  /**
+   * A future that completes once every given future has. Completion
+   * happens on whichever worker finishes last; no thread waits.
+   */
+  static TaskFuture WhenAll(const std::vector<TaskFuture> &futures);
+
+ private:
+  friend class MonoQueuePool;
+
+  // Shared completion state of one task
+  struct TaskState {
+    // Run the registered continuations; called exactly once, by the
+    // worker that finished the task
+    void Complete();
+
+    // Registered before completion, the continuation runs when the task
+    // completes; after completion it runs at once
+    void AddContinuation(std::function<void()> continuation);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::vector<std::function<void()>> continuations;
+    // pool the continuations are submitted to; inline when null
+    WorkStealingPool *pool = nullptr;
+  };
+
+  explicit TaskFuture(std::shared_ptr<TaskState> state)
+      : state_(std::move(state)) {}
+
+  // Create the state for a task about to be submitted to the given pool
+  static std::shared_ptr<TaskState> MakeState(WorkStealingPool *pool);
+
+  std::shared_ptr<TaskState> state_;
+};
+
+}  // namespace threadpool
+}  // namespace peloton
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// work_stealing_pool.h
+//
+// Identification: src/include/threadpool/work_stealing_pool.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/platform.h"
+#include "common/synchronization/spin_latch.h"
+
+namespace peloton {
+namespace threadpool {
+
+/**
+ * @brief A work-stealing worker pool.
+ *
+ * Every worker owns a deque on its own cache line. Submissions land on the
+ * deque picked by the affinity hint (or round-robin without one), the owner
+ * pops from the back for locality, and an idle worker steals the older half
+ * of a victim's deque from the front. Stealing half instead of one task
+ * amortizes the steal cost and rebalances bursts in one move, while the
+ * per-worker deques keep the common submit/pop path free of the shared
+ * MPMC queue head that every worker used to hammer.
+ *
+ * Affinity hints let related tasks - e.g. the parallel-scan morsels of one
+ * table - land on the same home worker, so they run where the table's data
+ * is already cache- (and on NUMA machines, socket-) resident unless the
+ * pool is imbalanced enough for stealing to migrate them.
+ */
+class WorkStealingPool {
+ public:
+  // Workers of a pool constructed with a NUMA node id pin themselves to
+  // that node on startup (a no-op without PELOTON_NUMA)
+  WorkStealingPool(size_t num_workers, int numa_node = INVALID_NUMA_NODE)
+      : num_workers_(num_workers > 0 ? num_workers : 1),
+        numa_node_(numa_node) {}
+
+  ~WorkStealingPool() { Shutdown(); }
+
+  void Startup();
+
+  // Drains the queues and joins the workers
+  void Shutdown();
+
+  // Submit a task with no placement preference; spread round-robin
+  void SubmitTask(std::function<void()> func);
+
+  // Submit a task to the home worker the hint maps to. Tasks sharing a hint
+  // share a home worker.
+  void SubmitTask(size_t affinity_hint, std::function<void()> func);
+
+ private:
+  // A worker's deque, padded so neighboring workers never share a line
+  struct CACHE_ALIGNED WorkerQueue {
+    common::synchronization::SpinLatch latch;
+    std::deque<std::function<void()>> tasks;
+    // maintained next to the deque so idle checks need no latch
+    std::atomic<size_t> approx_size{0};
+  };
+
+  void WorkerLoop(size_t worker_id);
+
+  // Pop the most recently pushed local task
+  bool PopLocal(size_t worker_id, std::function<void()> &task);
+
+  // Steal the older half of some victim's deque; one stolen task is
+  // returned, the rest land in the thief's own deque
+  bool StealHalf(size_t worker_id, std::function<void()> &task);
+
+  bool HasPendingTasks() const;
+
+  // Pin the calling worker to numa_node_, if one was requested
+  void BindToNumaNode();
+
+  size_t num_workers_;
+  int numa_node_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic_bool should_shutdown_{false};
+  std::atomic<size_t> submit_cursor_{0};
+};
+
+}  // namespace threadpool
+}  // namespace peloton
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// admission_controller.h
+//
+// Identification: src/include/traffic_cop/admission_controller.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace tcop {
+
+/** Priority class a session's statements are admitted under. A lower
+ *  numeric value means a higher priority */
+enum class AdmissionClass : uint32_t { HIGH = 0, NORMAL = 1, LOW = 2 };
+
+//===--------------------------------------------------------------------===//
+// ADMISSION CONTROLLER
+//
+// Caps how many statements of each priority class execute at once. A
+// statement submitted while its class is at its cap (settings-
+// configurable per class) is queued and dispatched when a slot of that
+// class frees; freed capacity is handed out highest class first. Capping
+// the analytics classes below the worker pool size keeps workers free
+// for short high-priority transactions without separate clusters.
+//===--------------------------------------------------------------------===//
+class AdmissionController {
+ public:
+  DISALLOW_COPY_AND_MOVE(AdmissionController);
+
+  static AdmissionController &GetInstance();
+
+  /** Run the submission now when the class has a free slot, otherwise
+   *  queue it. The submission hands the statement to a worker pool and
+   *  must arrange for Finish() to be called when the statement is done */
+  void Submit(AdmissionClass admission_class, std::function<void()> submit);
+
+  /** Release the slot held by a finished statement of the class and
+   *  dispatch queued submissions that now fit */
+  void Finish(AdmissionClass admission_class);
+
+  /** Statements currently queued for the class */
+  size_t QueuedCount(AdmissionClass admission_class);
+
+ private:
+  AdmissionController() = default;
+
+  static const size_t kNumClasses = 3;
+
+  /** Concurrency cap of the class from the settings; 0 = unlimited */
+  static size_t ClassLimit(AdmissionClass admission_class);
+
+  struct ClassState {
+    size_t running = 0;
+    std::deque<std::function<void()>> queued;
+  };
+
+  std::mutex mutex_;
+
+  ClassState classes_[kNumClasses];
+};
+
+}  // namespace tcop
+}  // namespace peloton
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// result_cache.h
+//
+// Identification: src/include/traffic_cop/result_cache.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/internal_types.h"
+#include "common/statement.h"
+#include "common/synchronization/readwrite_latch.h"
+
+namespace peloton {
+namespace tcop {
+
+//===--------------------------------------------------------------------===//
+// RESULT CACHE
+//
+// Process-wide cache of finished read-only statement results, shared by all
+// connections. The cached rows are the ResultValue strings handed to the
+// protocol layer, i.e. exactly the bytes a repeat execution would put on
+// the wire, so a hit skips the executor entirely.
+//
+// Consistency comes from per-relation write epochs: every commit of a
+// transaction that wrote a relation bumps that relation's epoch, and each
+// cache entry remembers the epochs of the relations its statement reads.
+// The reader snapshots those epochs BEFORE its transaction begins, so any
+// write committing after the snapshot — including one racing with the
+// cache fill — is guaranteed to make the entry stale. A stale entry is
+// simply a miss; the refill overwrites it.
+//
+// Opt-in via the result_cache setting (see TrafficCop for the wiring and
+// the eligibility rules).
+//===--------------------------------------------------------------------===//
+
+class ResultCache {
+ public:
+  ResultCache(ResultCache const &) = delete;
+  ResultCache &operator=(ResultCache const &) = delete;
+
+  static ResultCache &GetInstance();
+
+  // Relation oid paired with the write epoch observed for it.
+  using TableEpochVector = std::vector<std::pair<oid_t, uint64_t>>;
+
+  // Record the current write epoch of every given relation. Call this
+  // before beginning the transaction that computes the result to be
+  // cached.
+  TableEpochVector SnapshotTableEpochs(const std::set<oid_t> &table_oids);
+
+  // Advance the write epoch of every given relation. Call this after a
+  // transaction that wrote them commits.
+  void BumpTableEpochs(const std::set<oid_t> &table_oids);
+
+  // Look up a result by key. Returns true and copies the rows out only if
+  // the entry exists and none of its relations have been written since it
+  // was filled.
+  bool Get(const std::string &key, std::vector<ResultValue> &rows,
+           int &rows_affected);
+
+  // Insert or overwrite the result for a key, remembering the epochs the
+  // result was computed under.
+  void Put(const std::string &key, std::vector<ResultValue> rows,
+           int rows_affected, TableEpochVector table_epochs);
+
+  // Drop every cached result. Call this when a DDL transaction commits:
+  // schema changes are not attributable to table epochs (and a re-created
+  // relation may even reuse a name under a fresh oid), so the whole cache
+  // is invalidated.
+  void Clear();
+
+ private:
+  ResultCache() = default;
+
+  struct Entry {
+    std::vector<ResultValue> rows;
+    int rows_affected;
+    TableEpochVector table_epochs;
+  };
+
+  // Past this many entries the whole map is dropped on the next insert.
+  // The intended workload is a small set of hot dashboard queries, so the
+  // cap exists only to bound a pathological client; losing the cache is
+  // always safe.
+  static const size_t kMaxEntries = 1024;
+
+  // guards entries_ and table_epochs_; the hit path only ever reads
+  common::synchronization::ReadWriteLatch latch_;
+
+  std::unordered_map<std::string, Entry> entries_;
+
+  // relations absent from the map have never been written and are at
+  // epoch zero
+  std::unordered_map<oid_t, uint64_t> table_epochs_;
+};
+
+}  // namespace tcop
+}  // namespace peloton
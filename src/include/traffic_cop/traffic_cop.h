@@ -13,6 +13,7 @@
 #pragma once
 
 #include <mutex>
+#include <set>
 #include <stack>
 #include <vector>
 
@@ -23,9 +24,12 @@
 #include "common/internal_types.h"
 #include "common/portal.h"
 #include "common/statement.h"
+#include "common/statement_cache.h"
 #include "executor/plan_executor.h"
 #include "optimizer/abstract_optimizer.h"
 #include "parser/sql_statement.h"
+#include "traffic_cop/admission_controller.h"
+#include "traffic_cop/result_cache.h"
 #include "type/type.h"
 
 namespace peloton {
@@ -73,10 +77,13 @@ class TrafficCop {
       size_t thread_id = 0);
 
   // Helper to handle txn-specifics for the plan-tree of a statement.
+  // Passing the owning statement lets the plan executor cache the executor
+  // tree on it across executions.
   executor::ExecutionResult ExecuteHelper(
       std::shared_ptr<planner::AbstractPlan> plan,
       const std::vector<type::Value> &params, std::vector<ResultValue> &result,
-      const std::vector<int> &result_format, size_t thread_id = 0);
+      const std::vector<int> &result_format, size_t thread_id = 0,
+      std::shared_ptr<Statement> statement = nullptr);
 
   // Prepare a statement using the parse tree
   std::shared_ptr<Statement> PrepareStatement(
@@ -139,6 +146,15 @@ class TrafficCop {
 
   bool GetQueuing() { return is_queuing_; }
 
+  // Priority class this session's statements are admitted under when
+  // admission control is enabled; set by the protocol layer per
+  // role/session
+  void SetAdmissionClass(AdmissionClass admission_class) {
+    admission_class_ = admission_class;
+  }
+
+  AdmissionClass GetAdmissionClass() const { return admission_class_; }
+
   executor::ExecutionResult p_status_;
 
   void SetDefaultDatabaseName(std::string default_database_name) {
@@ -152,6 +168,9 @@ class TrafficCop {
  private:
   bool is_queuing_;
 
+  // Admission priority class of this session's statements
+  AdmissionClass admission_class_ = AdmissionClass::NORMAL;
+
   std::string error_message_;
 
   std::vector<type::Value> param_values_;
@@ -169,6 +188,11 @@ class TrafficCop {
   // The optimizer used for this connection
   std::unique_ptr<optimizer::AbstractOptimizer> optimizer_;
 
+  // Plan cache for this connection: optimized plans keyed by a fingerprint
+  // of the query with literal constants stripped, so repeated queries that
+  // differ only in constants skip the optimizer.
+  StatementCache plan_cache_;
+
   // flag of single statement txn
   bool single_statement_txn_;
 
@@ -191,6 +215,56 @@ class TrafficCop {
 
   ResultType AbortQueryHelper();
 
+  // Return the current transaction, materializing the deferred implicit
+  // transaction on first use. PrepareStatement only records that a
+  // single-statement transaction will be needed; the MVCC begin (taking
+  // a timestamp and entering the epoch) happens here, on the first data
+  // access, so trivial statements and cache hits never pay for it.
+  concurrency::TransactionContext *GetOrBeginTransaction(size_t thread_id);
+
+  // Whether the deferred implicit transaction should be declared
+  // read-only when it materializes
+  bool deferred_txn_read_only_ = false;
+
+  // Thread id to materialize the deferred transaction under when the
+  // access happens outside a call that carries one
+  size_t deferred_txn_thread_id_ = 0;
+
+  // Retry a conflict-aborted single-statement transaction from the
+  // retained plan: bounded attempts, each in a fresh transaction after a
+  // randomized backoff, executed synchronously on this thread. Returns
+  // true when the retry path concluded the statement (p_status_ holds the
+  // outcome and the state stack is clean); on false the last failed
+  // transaction is still on the state stack for the caller to abort.
+  bool RetrySingleStatementTxn();
+
+  // Execution context retained by ExecuteHelper so an aborted
+  // single-statement transaction can be retried without the client. The
+  // pointers refer to the protocol layer's storage, which stays alive
+  // until the statement's result is handed back.
+  std::shared_ptr<planner::AbstractPlan> retry_plan_;
+  const std::vector<type::Value> *retry_params_ = nullptr;
+  std::vector<ResultValue> *retry_result_ = nullptr;
+  const std::vector<int> *retry_result_format_ = nullptr;
+  size_t retry_thread_id_ = 0;
+  std::shared_ptr<Statement> retry_statement_;
+
+  // Result-cache bookkeeping for the statement in flight: the key and the
+  // relation epochs snapshotted before its transaction began. The entry is
+  // filled in ExecuteStatementPlanGetResult once the statement commits.
+  std::string result_cache_key_;
+  ResultCache::TableEpochVector result_cache_epochs_;
+  bool result_cache_fill_ = false;
+
+  // Relations written by transactions on the state stack; their result
+  // cache epochs are bumped at commit.
+  std::set<oid_t> txn_written_tables_;
+
+  // Whether a transaction on the state stack ran DDL. Schema changes are
+  // not attributable to table epochs, so the whole result cache is dropped
+  // at commit instead.
+  bool txn_ran_ddl_ = false;
+
   // Get all data tables from a TableRef.
   // For multi-way join
   // still a HACK
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include <boost/algorithm/string/join.hpp>
@@ -155,6 +156,10 @@ class TriggerList {
   // types_summary contains a boolean for each kind of EnumTriggerType, this is
   // used for facilitate checking weather there is a trigger to be invoked
   bool types_summary[TRIGGER_TYPE_MAX + 1] = {false};
+  // for each type that has triggers, the indexes into `triggers` that fire
+  // for it; lets per-row execution visit only the matching triggers instead
+  // of scanning the whole list with a mask check per trigger
+  std::unordered_map<int, std::vector<size_t>> type_index_;
   std::vector<Trigger> triggers;
 };
 
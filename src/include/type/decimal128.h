@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// decimal128.h
+//
+// Identification: src/include/type/decimal128.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace type {
+
+//===----------------------------------------------------------------------===//
+// A 128-bit fixed-point decimal, scaled to 10^8.
+//
+// The stored DECIMAL type is a C++ double, which both loses precision when
+// many values are accumulated (the classic SUM(amount) drift) and pays a
+// float<->int conversion at every boundary with integer columns. Decimal128
+// holds an amount as an integer count of 10^-8 units in a signed 128-bit
+// word: addition and subtraction are plain integer ops (associative, so
+// partial sums can be merged in any order with no drift), and values with
+// at most 8 fractional digits -- every currency format we care about --
+// round-trip exactly. The 128-bit width gives ~3.4e20 whole units of
+// headroom, enough to sum any realistic table without overflow.
+//
+// This is deliberately an accumulator-side representation: the stored type
+// and its double arithmetic remain for compatibility, and Decimal128 is
+// used where exactness matters, like SUM/AVG aggregation.
+//===----------------------------------------------------------------------===//
+
+class Decimal128 {
+ public:
+  // Fractional digits carried by the fixed point
+  static const int64_t kScale = 100000000;  // 10^8
+
+  Decimal128() : units_(0) {}
+
+  // Exact for inputs with at most 8 fractional digits; rounds to nearest
+  // unit otherwise
+  static Decimal128 FromDouble(double value) {
+    Decimal128 result;
+    // split so the integral part never loses unit precision inside the
+    // double multiply
+    double integral;
+    double fractional = std::modf(value, &integral);
+    result.units_ = static_cast<__int128>(integral) * kScale +
+                    static_cast<__int128>(std::llround(fractional * kScale));
+    return result;
+  }
+
+  static Decimal128 FromInteger(int64_t value) {
+    Decimal128 result;
+    result.units_ = static_cast<__int128>(value) * kScale;
+    return result;
+  }
+
+  void Add(const Decimal128 &other) { units_ += other.units_; }
+
+  void Subtract(const Decimal128 &other) { units_ -= other.units_; }
+
+  double ToDouble() const {
+    // split again so values within the double's exact integer range come
+    // back without rounding through the quotient
+    __int128 whole = units_ / kScale;
+    __int128 frac = units_ % kScale;
+    return static_cast<double>(whole) +
+           static_cast<double>(frac) / static_cast<double>(kScale);
+  }
+
+  bool IsZero() const { return units_ == 0; }
+
+  bool operator==(const Decimal128 &other) const {
+    return units_ == other.units_;
+  }
+
+ private:
+  __int128 units_;
+};
+
+}  // namespace type
+}  // namespace peloton
@@ -1,79 +1,136 @@
-//===----------------------------------------------------------------------===//
-//
-//                         Peloton
-//
-// ephemeral_pool.h
-//
-// Identification: src/include/type/ephemeral_pool.h
-//
-// Copyright (c) 2015-17, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#pragma once
-
-#include <stdint.h>
-#include <stdlib.h>
-#include <vector>
-#include <unordered_set>
-
-#include "common/macros.h"
-#include "common/synchronization/spin_latch.h"
-#include "type/abstract_pool.h"
-
-namespace peloton {
-namespace type {
-
-// A memory pool that can quickly allocate chunks of memory to clients.
-class EphemeralPool : public AbstractPool {
-public:
-
-  EphemeralPool(){
-
-  }
-
-  // Destroy this pool, and all memory it owns.
-  ~EphemeralPool(){
-
-    pool_lock_.Lock();
-    for(auto location: locations_){
-      delete[] location;
-    }
-    pool_lock_.Unlock();
-
-  }
-
-  // Allocate a contiguous block of memory of the given size. If the allocation
-  // is successful a non-null pointer is returned. If the allocation fails, a
-  // null pointer will be returned.
-  void *Allocate(size_t size){
-    auto location = new char[size];
-
-    pool_lock_.Lock();
-    locations_.insert(location);
-    pool_lock_.Unlock();
-
-    return location;
-  }
-
-  // Returns the provided chunk of memory back into the pool
-  void Free(UNUSED_ATTRIBUTE void *ptr) {
-    char *cptr = (char *) ptr;
-    pool_lock_.Lock();
-    locations_.erase(cptr);
-    pool_lock_.Unlock();
-    delete [] cptr;
-  }
-
-public:
-
-  // Location list
-  std::unordered_set<char*> locations_;
-
-  // Spin lock protecting location list
-  common::synchronization::SpinLatch pool_lock_;
-
-};
-
-}  // namespace type
-}  // namespace peloton
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ephemeral_pool.h
+//
+// Identification: src/include/type/ephemeral_pool.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <unordered_map>
+
+#include "common/macros.h"
+#include "common/synchronization/spin_latch.h"
+#include "type/abstract_pool.h"
+#include "type/memory_tracker.h"
+
+namespace peloton {
+namespace type {
+
+// A memory pool that can quickly allocate chunks of memory to clients.
+class EphemeralPool : public AbstractPool {
+public:
+
+  // An optional tracker charges this pool's allocations against a query
+  // memory budget
+  explicit EphemeralPool(QueryMemoryTracker *tracker = nullptr)
+      : tracker_(tracker) {
+
+  }
+
+  // Destroy this pool, and all memory it owns.
+  ~EphemeralPool(){
+
+    pool_lock_.Lock();
+    for(auto &entry: locations_){
+      if (tracker_ != nullptr) {
+        tracker_->Release(entry.second);
+      }
+      delete[] entry.first;
+    }
+    pool_lock_.Unlock();
+
+  }
+
+  // Allocate a contiguous block of memory of the given size. If the allocation
+  // is successful a non-null pointer is returned. If the allocation fails, a
+  // null pointer will be returned.
+  void *Allocate(size_t size){
+    // Charge the budget first: if the tracker throws, nothing leaks
+    if (tracker_ != nullptr) {
+      tracker_->Consume(size);
+    }
+    auto location = new char[size];
+
+    pool_lock_.Lock();
+    locations_[location] = size;
+    allocated_bytes_ += size;
+    pool_lock_.Unlock();
+
+    return location;
+  }
+
+  // Returns the provided chunk of memory back into the pool. Pointers that
+  // were not allocated from this pool (or were already freed) are ignored,
+  // so that callers racing with pool compaction cannot double-free.
+  void Free(void *ptr) {
+    char *cptr = (char *) ptr;
+    pool_lock_.Lock();
+    auto entry = locations_.find(cptr);
+    if (entry == locations_.end()) {
+      pool_lock_.Unlock();
+      return;
+    }
+    size_t size = entry->second;
+    freed_bytes_ += size;
+    locations_.erase(entry);
+    pool_lock_.Unlock();
+    if (tracker_ != nullptr) {
+      tracker_->Release(size);
+    }
+    delete [] cptr;
+  }
+
+  // Size of the live allocation starting at ptr, or 0 if ptr is not a live
+  // allocation from this pool
+  size_t AllocationSize(const char *ptr) {
+    pool_lock_.Lock();
+    auto entry = locations_.find(const_cast<char *>(ptr));
+    size_t size = (entry == locations_.end()) ? 0 : entry->second;
+    pool_lock_.Unlock();
+    return size;
+  }
+
+  // Bytes ever handed out by this pool
+  uint64_t GetAllocatedBytes() {
+    pool_lock_.Lock();
+    uint64_t bytes = allocated_bytes_;
+    pool_lock_.Unlock();
+    return bytes;
+  }
+
+  // Bytes handed out and since returned via Free()
+  uint64_t GetFreedBytes() {
+    pool_lock_.Lock();
+    uint64_t bytes = freed_bytes_;
+    pool_lock_.Unlock();
+    return bytes;
+  }
+
+public:
+
+  // Location map, keyed by allocation start, value is the allocation size
+  std::unordered_map<char *, size_t> locations_;
+
+  // Cumulative allocation / free volume, for fragmentation accounting
+  uint64_t allocated_bytes_ = 0;
+  uint64_t freed_bytes_ = 0;
+
+  // Spin lock protecting location map
+  common::synchronization::SpinLatch pool_lock_;
+
+  // Query memory tracker charged for this pool's live bytes, or null
+  QueryMemoryTracker *tracker_;
+
+};
+
+}  // namespace type
+}  // namespace peloton
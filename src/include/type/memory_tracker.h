@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_tracker.h
+//
+// Identification: src/include/type/memory_tracker.h
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "common/exception.h"
+
+namespace peloton {
+namespace type {
+
+//===--------------------------------------------------------------------===//
+// Query Memory Tracker -- per-query memory accountant with a budget.
+//
+// Pools and operators report their allocations here; when an allocation
+// pushes the query past its budget, registered spill hooks get a chance
+// to shed memory (flush sort runs, spill temp-table tile groups) before
+// the query fails with an executor error. Without a budget (the default)
+// the tracker only accounts, so the overhead is one atomic add per pool
+// allocation.
+//===--------------------------------------------------------------------===//
+
+class QueryMemoryTracker {
+ public:
+  // A spill hook releases whatever memory its operator can live without
+  // and returns the number of bytes it freed
+  typedef std::function<size_t()> SpillHook;
+
+  // Budget in bytes; 0 means unlimited
+  void SetBudget(uint64_t budget_bytes) { budget_bytes_ = budget_bytes; }
+
+  uint64_t GetBudget() const { return budget_bytes_; }
+
+  uint64_t GetUsageBytes() const { return usage_bytes_.load(); }
+
+  uint64_t GetPeakUsageBytes() const { return peak_usage_bytes_.load(); }
+
+  // Register / replace the spill hook for the given scope (keyed by the
+  // operator's address, like the executor context's scoped pools)
+  void RegisterSpillHook(const void *scope, SpillHook hook) {
+    std::lock_guard<std::mutex> lock(hooks_mutex_);
+    spill_hooks_[scope] = std::move(hook);
+  }
+
+  void UnregisterSpillHook(const void *scope) {
+    std::lock_guard<std::mutex> lock(hooks_mutex_);
+    spill_hooks_.erase(scope);
+  }
+
+  // Account an allocation. When the budget is exceeded the spill hooks
+  // run first; if usage still exceeds the budget afterwards, throws an
+  // ExecutorException so the query fails instead of the process
+  void Consume(uint64_t bytes) {
+    const uint64_t usage = usage_bytes_.fetch_add(bytes) + bytes;
+    uint64_t peak = peak_usage_bytes_.load();
+    while (usage > peak &&
+           peak_usage_bytes_.compare_exchange_weak(peak, usage) == false) {
+    }
+
+    if (budget_bytes_ == 0 || usage <= budget_bytes_ || in_spill_) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(hooks_mutex_);
+      // hooks release memory through this tracker; don't re-enter
+      in_spill_ = true;
+      for (auto &entry : spill_hooks_) {
+        entry.second();
+        if (usage_bytes_.load() <= budget_bytes_) {
+          break;
+        }
+      }
+      in_spill_ = false;
+    }
+
+    const uint64_t final_usage = usage_bytes_.load();
+    if (final_usage > budget_bytes_) {
+      // the rejected allocation never happens, so un-charge it
+      usage_bytes_ -= bytes;
+      throw ExecutorException(
+          "Query memory budget exceeded: " + std::to_string(final_usage) +
+          " bytes requested, budget is " + std::to_string(budget_bytes_) +
+          " bytes");
+    }
+  }
+
+  void Release(uint64_t bytes) { usage_bytes_ -= bytes; }
+
+  // Drop usage, peak and hooks for a new execution; the budget is kept
+  void Reset() {
+    usage_bytes_ = 0;
+    peak_usage_bytes_ = 0;
+    std::lock_guard<std::mutex> lock(hooks_mutex_);
+    spill_hooks_.clear();
+  }
+
+ private:
+  std::atomic<uint64_t> usage_bytes_{0};
+
+  std::atomic<uint64_t> peak_usage_bytes_{0};
+
+  uint64_t budget_bytes_ = 0;
+
+  // set while spill hooks run, so their own (re)allocations cannot
+  // trigger a second round
+  bool in_spill_ = false;
+
+  // Spill hooks keyed by operator address
+  std::map<const void *, SpillHook> spill_hooks_;
+
+  std::mutex hooks_mutex_;
+};
+
+}  // namespace type
+}  // namespace peloton
@@ -48,6 +48,9 @@ class SerializeInput {
   inline float ReadFloat() { return ReadPrimitive<float>(); }
   inline double ReadDouble() { return ReadPrimitive<double>(); }
 
+  /** Are there bytes left to read? */
+  inline bool HasRemaining() const { return current_ < end_; }
+
   /** Returns a pointer to the internal data buffer, advancing the read position by length. */
   const void* getRawPointer(size_t length) {
     const void* result = current_;
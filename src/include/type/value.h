@@ -111,33 +111,95 @@ class Value : public Printable {
   //     and since Value is a core component of the execution engine, we want to
   //     make it as performant as possible.
   // (2) Keep the interface consistent by making all functions purely virtual.
+  //
+  // Comparisons between two non-null values of the same hot fixed-width type
+  // additionally skip the virtual singleton dispatch entirely and compare the
+  // inlined representations directly (see TryFastCompare() below); the
+  // singletons only see mixed-type, null or varlen operands.
   inline CmpBool CompareEquals(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp == 0);
     return Type::GetInstance(type_id_)->CompareEquals(*this, o);
   }
   inline CmpBool CompareNotEquals(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp != 0);
     return Type::GetInstance(type_id_)->CompareNotEquals(*this, o);
   }
   inline CmpBool CompareLessThan(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp < 0);
     return Type::GetInstance(type_id_)->CompareLessThan(*this, o);
   }
   inline CmpBool CompareLessThanEquals(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp <= 0);
     return Type::GetInstance(type_id_)->CompareLessThanEquals(*this, o);
   }
   inline CmpBool CompareGreaterThan(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp > 0);
     return Type::GetInstance(type_id_)->CompareGreaterThan(*this, o);
   }
   inline CmpBool CompareGreaterThanEquals(const Value &o) const {
+    int cmp;
+    if (TryFastCompare(o, cmp)) return GetCmpBool(cmp >= 0);
     return Type::GetInstance(type_id_)->CompareGreaterThanEquals(*this, o);
   }
 
   // Other mathematical functions
+  //
+  // Same-type, non-null INTEGER/BIGINT/DECIMAL operands take a direct path
+  // mirroring what the per-type singleton would compute for them (including
+  // the domain-minimum-folds-to-null behavior of the typed constructors);
+  // everything else -- mixed types, nulls, the overflow-checked narrow
+  // integers, division and modulo -- still goes through the singletons.
   inline Value Add(const Value &o) const {
+    if (type_id_ == o.type_id_ && !IsNull() && !o.IsNull()) {
+      switch (type_id_) {
+        case TypeId::INTEGER:
+          return Value(type_id_,
+                       (int32_t)(value_.integer + o.value_.integer));
+        case TypeId::BIGINT:
+          return Value(type_id_, (int64_t)(value_.bigint + o.value_.bigint));
+        case TypeId::DECIMAL:
+          return Value(type_id_, value_.decimal + o.value_.decimal);
+        default:
+          break;
+      }
+    }
     return Type::GetInstance(type_id_)->Add(*this, o);
   }
   inline Value Subtract(const Value &o) const {
+    if (type_id_ == o.type_id_ && !IsNull() && !o.IsNull()) {
+      switch (type_id_) {
+        case TypeId::INTEGER:
+          return Value(type_id_,
+                       (int32_t)(value_.integer - o.value_.integer));
+        case TypeId::BIGINT:
+          return Value(type_id_, (int64_t)(value_.bigint - o.value_.bigint));
+        case TypeId::DECIMAL:
+          return Value(type_id_, value_.decimal - o.value_.decimal);
+        default:
+          break;
+      }
+    }
     return Type::GetInstance(type_id_)->Subtract(*this, o);
   }
   inline Value Multiply(const Value &o) const {
+    if (type_id_ == o.type_id_ && !IsNull() && !o.IsNull()) {
+      switch (type_id_) {
+        case TypeId::INTEGER:
+          return Value(type_id_,
+                       (int32_t)(value_.integer * o.value_.integer));
+        case TypeId::BIGINT:
+          return Value(type_id_, (int64_t)(value_.bigint * o.value_.bigint));
+        case TypeId::DECIMAL:
+          return Value(type_id_, value_.decimal * o.value_.decimal);
+        default:
+          break;
+      }
+    }
     return Type::GetInstance(type_id_)->Multiply(*this, o);
   }
   inline Value Divide(const Value &o) const {
@@ -315,6 +377,56 @@ class Value : public Printable {
 
   friend class ValueFactory;
 
+ private:
+  template <class T>
+  inline static int ThreeWayCompare(T lhs, T rhs) {
+    return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+  }
+
+  // Same-type, non-null comparison on the raw representation for the hot
+  // fixed-width types. Returns false when the virtual per-type path has to
+  // decide instead (mixed types, nulls, varlen, arrays).
+  inline bool TryFastCompare(const Value &o, int &cmp) const {
+    if (type_id_ != o.type_id_ || IsNull() || o.IsNull()) {
+      return false;
+    }
+    switch (type_id_) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        cmp = ThreeWayCompare(value_.tinyint, o.value_.tinyint);
+        return true;
+      case TypeId::SMALLINT:
+        cmp = ThreeWayCompare(value_.smallint, o.value_.smallint);
+        return true;
+      case TypeId::INTEGER:
+        cmp = ThreeWayCompare(value_.integer, o.value_.integer);
+        return true;
+      case TypeId::BIGINT:
+        cmp = ThreeWayCompare(value_.bigint, o.value_.bigint);
+        return true;
+      case TypeId::DECIMAL:
+        cmp = ThreeWayCompare(value_.decimal, o.value_.decimal);
+        return true;
+      case TypeId::DATE:
+        cmp = ThreeWayCompare(value_.date, o.value_.date);
+        return true;
+      case TypeId::TIMESTAMP:
+        cmp = ThreeWayCompare(value_.timestamp, o.value_.timestamp);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Small-varlen optimization: an owned VARCHAR/VARBINARY payload of at most
+  // kInlinedVarlenMax bytes lives inside the value itself instead of behind a
+  // heap allocation.
+  static const uint32_t kInlinedVarlenMax = 12;
+
+  inline bool HasInlinedVarlen() const {
+    return manage_data_ && size_.len <= kInlinedVarlenMax;
+  }
+
  protected:
   // The actual value item
   union Val {
@@ -329,6 +441,7 @@ class Value : public Printable {
     char *varlen;
     const char *const_varlen;
     char *array;
+    char inlined[kInlinedVarlenMax];
   } value_;
 
   union {
@@ -342,6 +455,25 @@ class Value : public Printable {
   TypeId type_id_;
 };
 
+// An owned small varlen payload lives inside the union itself, so
+// reinterpreting the union as a pointer would hand back garbage bytes; the
+// pointer specializations go through the inline-buffer check instead.
+template <>
+inline const char *Value::GetAs<const char *>() const {
+  if (HasInlinedVarlen()) {
+    return value_.inlined;
+  }
+  return value_.const_varlen;
+}
+
+template <>
+inline char *Value::GetAs<char *>() const {
+  if (HasInlinedVarlen()) {
+    return const_cast<char *>(value_.inlined);
+  }
+  return value_.varlen;
+}
+
 // ARRAY here to ease creation of templates
 // TODO: Fix the representation for a null array
 template <class T>
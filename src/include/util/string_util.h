@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -88,6 +89,14 @@ class StringUtil {
    */
   static std::string FormatSize(long bytes);
 
+  /**
+   * Render value into out without a terminator, emitting digits two at a
+   * time from a lookup table, and return the byte count. out must hold at
+   * least 20 bytes. Meant for the bulk export paths, where one conversion
+   * per integer field makes snprintf measurable.
+   */
+  static uint32_t FastIntToString(int64_t value, char *out);
+
   /**
    * Wrap the given string with the control characters
    * to make the text appear bold in the console
@@ -12,6 +12,8 @@
 
 #include "index/art_index.h"
 
+#include <algorithm>
+
 #include "common/container_tuple.h"
 #include "index/scan_optimizer.h"
 #include "settings/settings_manager.h"
@@ -139,8 +141,7 @@ void ArtIndex::Scan(
     UNUSED_ATTRIBUTE const std::vector<type::Value> &values,
     UNUSED_ATTRIBUTE const std::vector<oid_t> &key_column_ids,
     UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_types,
-    UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
-    std::vector<ItemPointer *> &result,
+    ScanDirectionType scan_direction, std::vector<ItemPointer *> &result,
     const ConjunctionScanPredicate *scan_predicate) {
   // Perform the appropriate scan based on the scan predicate
   if (scan_predicate->IsFullIndexScan()) {
@@ -152,6 +153,12 @@ void ArtIndex::Scan(
               result);
   }
 
+  // The trie only iterates in ascending key order, so backward scans
+  // reverse the forward pass to produce descending order
+  if (scan_direction == ScanDirectionType::BACKWARD) {
+    std::reverse(result.begin(), result.end());
+  }
+
   // Update stats
   if (static_cast<StatsType>(settings::SettingsManager::GetInt(
           settings::SettingId::stats_mode)) != StatsType::INVALID) {
@@ -167,15 +174,35 @@ void ArtIndex::ScanLimit(const std::vector<type::Value> &values,
                          std::vector<ItemPointer *> &result,
                          const ConjunctionScanPredicate *scan_predicate,
                          uint64_t limit, uint64_t offset) {
-  (void)values;
-  (void)key_column_ids;
-  (void)expr_types;
-  (void)scan_direction;
-  (void)result;
-  (void)scan_predicate;
-  (void)limit;
-  (void)offset;
-  // This fucking function takes seven fucking arguments ... The fuck?
+  // Special case "limit 1 offset 0" forward range scans: keys are stored in
+  // binary-comparable form, so the first match of a bounded range lookup is
+  // the minimum qualifying key. This mirrors the Bw-Tree's ScanLimit().
+  if (scan_predicate->IsPointQuery() == false &&
+      scan_predicate->IsFullIndexScan() == false && limit == 1 &&
+      offset == 0 && scan_direction == ScanDirectionType::FORWARD) {
+    art::Key start_key, end_key;
+    ConstructArtKey(*scan_predicate->GetLowKey(), start_key);
+    ConstructArtKey(*scan_predicate->GetHighKey(), end_key);
+
+    std::vector<TID> tmp_result;
+    art::Key next_start_key;
+    auto thread_info = container_.getThreadInfo();
+    container_.lookupRange(start_key, end_key, next_start_key, tmp_result,
+                           1 /* batch size */, thread_info);
+    if (tmp_result.empty() == false) {
+      result.push_back(reinterpret_cast<ItemPointer *>(tmp_result.front()));
+    }
+
+    // Update stats
+    if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+            settings::SettingId::stats_mode)) != StatsType::INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+          result.size(), GetMetadata());
+    }
+  } else {
+    Scan(values, key_column_ids, expr_types, scan_direction, result,
+         scan_predicate);
+  }
 }
 
 void ArtIndex::ScanAllKeys(std::vector<ItemPointer *> &result) {
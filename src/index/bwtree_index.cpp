@@ -12,6 +12,8 @@
 
 #include "index/bwtree_index.h"
 
+#include <algorithm>
+
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
@@ -130,12 +132,143 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * ScanRangeDescending() - Backward walk over a bounded key range
+ *
+ * Begin() positions the iterator on the first entry whose key >= the high
+ * key, so we first step forward over the run of entries equal to the high
+ * key (all of which qualify), leaving the iterator one past the last
+ * qualifying entry. From there the iterator is stepped backward, which
+ * follows the leaf sibling chain leftward, until the key drops below the
+ * low key or the callback asks to stop
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+template <typename Callback>
+void BWTREE_INDEX_TYPE::ScanRangeDescending(const KeyType &index_low_key,
+                                            const KeyType &index_high_key,
+                                            Callback &&callback) {
+  auto scan_itr = container.Begin(index_high_key);
+  while ((scan_itr.IsEnd() == false) &&
+         (container.KeyCmpLessEqual(scan_itr->first, index_high_key))) {
+    ++scan_itr;
+  }
+
+  for (--scan_itr; scan_itr.IsREnd() == false; --scan_itr) {
+    if (container.KeyCmpLess(scan_itr->first, index_low_key) == true) {
+      break;
+    }
+
+    if (callback(scan_itr->first, scan_itr->second) == false) {
+      break;
+    }
+  }
+
+  return;
+}
+
+/*
+ * ScanSkip() - Forward walk that skips between distinct key prefix values
+ *
+ * The scan interval constrains only a suffix of the index key, so the
+ * interval itself degenerates to (almost) the whole index. Instead of
+ * walking it entry by entry, we read the prefix value of the entry the
+ * iterator landed on, probe the bounded suffix range under that prefix,
+ * and then jump with Begin() to the first entry past the prefix group.
+ * Each distinct prefix value thus costs one range probe plus one
+ * leaf-level jump, which wins whenever the prefix cardinality is small
+ * relative to the entry count.
+ *
+ * Unlike the plain range walk, the probes enforce the suffix bounds
+ * exactly, so entries whose suffix falls outside them are never returned.
+ * Results still come out in ascending full-key order
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanSkip(const storage::Tuple *low_key_p,
+                                 const storage::Tuple *high_key_p,
+                                 oid_t prefix_column_count,
+                                 std::vector<ValueType> &result) {
+  const catalog::Schema *key_schema = metadata->GetKeySchema();
+  const oid_t column_count = key_schema->GetColumnCount();
+
+  PL_ASSERT(prefix_column_count > 0 && prefix_column_count < column_count);
+
+  KeyType index_low_key;
+  KeyType index_high_key;
+  index_low_key.SetFromKey(low_key_p);
+  index_high_key.SetFromKey(high_key_p);
+
+  // Probe templates: the suffix bounds stay fixed while the prefix columns
+  // are rewritten for every prefix group the walk lands on. The jump key
+  // carries +Inf in the suffix so that Begin() on it lands on the first
+  // entry of the next prefix group
+  storage::Tuple probe_low_key(key_schema, true);
+  storage::Tuple probe_high_key(key_schema, true);
+  storage::Tuple jump_key(key_schema, true);
+
+  for (oid_t column_itr = prefix_column_count; column_itr < column_count;
+       column_itr++) {
+    probe_low_key.SetValue(column_itr, low_key_p->GetValue(column_itr),
+                           GetPool());
+    probe_high_key.SetValue(column_itr, high_key_p->GetValue(column_itr),
+                            GetPool());
+
+    type::Value max_val =
+        type::Type::GetMaxValue(key_schema->GetType(column_itr));
+    jump_key.SetValue(column_itr, max_val, GetPool());
+  }
+
+  auto scan_itr = container.Begin(index_low_key);
+  while ((scan_itr.IsEnd() == false) &&
+         (container.KeyCmpLessEqual(scan_itr->first, index_high_key))) {
+    // Pull the prefix value of the group we landed on out of the entry's
+    // key. GetTupleForComparison() is not const-qualified on every key type
+    KeyType scan_key = scan_itr->first;
+    const storage::Tuple current_key =
+        scan_key.GetTupleForComparison(key_schema);
+
+    for (oid_t column_itr = 0; column_itr < prefix_column_count;
+         column_itr++) {
+      type::Value prefix_val = current_key.GetValue(column_itr);
+      probe_low_key.SetValue(column_itr, prefix_val, GetPool());
+      probe_high_key.SetValue(column_itr, prefix_val, GetPool());
+      jump_key.SetValue(column_itr, prefix_val, GetPool());
+    }
+
+    KeyType index_probe_low_key;
+    KeyType index_probe_high_key;
+    KeyType index_jump_key;
+    index_probe_low_key.SetFromKey(&probe_low_key);
+    index_probe_high_key.SetFromKey(&probe_high_key);
+    index_jump_key.SetFromKey(&jump_key);
+
+    // Probe the bounded suffix range under the current prefix value
+    for (auto probe_itr = container.Begin(index_probe_low_key);
+         (probe_itr.IsEnd() == false) &&
+             (container.KeyCmpLessEqual(probe_itr->first,
+                                        index_probe_high_key));
+         probe_itr++) {
+      result.push_back(probe_itr->second);
+    }
+
+    // Jump to the next prefix group; stepping past the run of entries equal
+    // to the jump key mirrors ScanRangeDescending()
+    scan_itr = container.Begin(index_jump_key);
+    while ((scan_itr.IsEnd() == false) &&
+           (container.KeyCmpLessEqual(scan_itr->first, index_jump_key))) {
+      ++scan_itr;
+    }
+  }
+
+  return true;
+}
+
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
  * The scan optimizer specifies whether a scan is point query, full scan
  * or interval scan. For all of these cases the corresponding functions from
- * the index is called, and all elements are returned in result vector
+ * the index is called, and all elements are returned in result vector.
+ * For backward scans the elements are returned in descending key order
  */
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::Scan(
@@ -144,7 +277,6 @@ void BWTREE_INDEX_TYPE::Scan(
     UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
     ScanDirectionType scan_direction, std::vector<ValueType> &result,
     const ConjunctionScanPredicate *csp_p) {
-  // This is a hack - we do not support backward scan
   if (scan_direction == ScanDirectionType::INVALID) {
     throw Exception("Invalid scan direction \n");
   }
@@ -162,6 +294,8 @@ void BWTREE_INDEX_TYPE::Scan(
     // (slightly less code), but since ScanKey() is a virtual function
     // this would induce an overhead for point query, which must be highly
     // optimized and super fast
+    //
+    // Scan direction is irrelevant here - all entries share the same key
     container.GetValue(point_query_key, result);
   } else if (csp_p->IsFullIndexScan() == true) {
     // If it is a full index scan, then just do the scan
@@ -171,6 +305,12 @@ void BWTREE_INDEX_TYPE::Scan(
          scan_itr++) {
       result.push_back(scan_itr->second);
     }  // for it from begin() to end()
+
+    // The tree offers no entry point at the rightmost leaf, so a full
+    // backward scan reverses the forward pass; both visit every entry
+    if (scan_direction == ScanDirectionType::BACKWARD) {
+      std::reverse(result.begin(), result.end());
+    }
   } else {
     const storage::Tuple *low_key_p = csp_p->GetLowKey();
     const storage::Tuple *high_key_p = csp_p->GetHighKey();
@@ -178,6 +318,25 @@ void BWTREE_INDEX_TYPE::Scan(
     LOG_TRACE("Partial scan low key: %s\n high key: %s",
               low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
 
+    // When the predicate leaves a key prefix unconstrained, enumerate the
+    // distinct prefix values and probe the bounded suffix range under each
+    // instead of walking the whole degenerate interval
+    if (scan_direction == ScanDirectionType::FORWARD &&
+        csp_p->IsSkipScannable() &&
+        settings::SettingsManager::GetBool(
+            settings::SettingId::index_skip_scan)) {
+      if (ScanSkip(low_key_p, high_key_p, csp_p->GetSkipPrefixColumnCount(),
+                   result)) {
+        if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+                settings::SettingId::stats_mode)) != StatsType::INVALID) {
+          stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+              result.size(), metadata);
+        }
+
+        return;
+      }
+    }
+
     // Construct low key and high key in KeyType form, rather than
     // the standard in-memory tuple
     KeyType index_low_key;
@@ -185,15 +344,26 @@ void BWTREE_INDEX_TYPE::Scan(
     index_low_key.SetFromKey(low_key_p);
     index_high_key.SetFromKey(high_key_p);
 
-    // We use bwtree Begin() to first reach the lower bound
-    // of the search key
-    // Also we keep scanning until we have reached the end of the index
-    // or we have seen a key higher than the high key
-    for (auto scan_itr = container.Begin(index_low_key);
-         (scan_itr.IsEnd() == false) &&
-             (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
-         scan_itr++) {
-      result.push_back(scan_itr->second);
+    if (scan_direction == ScanDirectionType::BACKWARD) {
+      // Walk the leaf chain backward from the high key so the result
+      // comes out in descending key order
+      ScanRangeDescending(index_low_key, index_high_key,
+                          [&result](UNUSED_ATTRIBUTE const KeyType &key,
+                                    ValueType value) {
+                            result.push_back(value);
+                            return true;
+                          });
+    } else {
+      // We use bwtree Begin() to first reach the lower bound
+      // of the search key
+      // Also we keep scanning until we have reached the end of the index
+      // or we have seen a key higher than the high key
+      for (auto scan_itr = container.Begin(index_low_key);
+           (scan_itr.IsEnd() == false) &&
+               (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
+           scan_itr++) {
+        result.push_back(scan_itr->second);
+      }
     }
   }  // if is full scan
 
@@ -210,10 +380,9 @@ void BWTREE_INDEX_TYPE::Scan(
  * ScanLimit() - Scan the index with predicate and limit/offset
  *
  * This function scans the index using the given index optimizer's low key and
- * high key. In addition to merely doing the scan, it checks scan direction
- * and uses either begin() or end() iterator to scan the index, and stops
- * after offset + limit elements are scanned, and limit elements are finally
- * returned
+ * high key. The only early-terminating case is the ascending limit-1
+ * minimum lookup; anything else falls back to Scan(), whose result the
+ * executor windows after its visibility pass
  */
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::ScanLimit(
@@ -246,6 +415,12 @@ void BWTREE_INDEX_TYPE::ScanLimit(
       result.push_back(scan_itr->second);
     }
   } else {
+    // No early termination for anything else, descending limits included:
+    // the index hands out entries without visibility checking, so stopping
+    // after limit + offset raw entries could exhaust the budget on dead or
+    // invisible versions and leave the executor short with no way to
+    // resume. The executor windows the full result after its visibility
+    // pass instead
     Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
          csp_p);
   }
@@ -253,6 +428,107 @@ void BWTREE_INDEX_TYPE::ScanLimit(
   return;
 }
 
+/*
+ * ScanKeyValues() - Scan() plus a materialized copy of each entry's key
+ *
+ * Used by covering (index-only) scans: the caller gets the key column
+ * values without ever touching the base tuples. Keys are deep-copied off
+ * the iterator, column by column, since the iterator's key storage does
+ * not outlive the scan.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanKeyValues(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction,
+    std::vector<std::pair<std::shared_ptr<storage::Tuple>, ItemPointer *>>
+        &result,
+    const ConjunctionScanPredicate *csp_p, type::AbstractPool *pool) {
+  // Same restriction as Scan()
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  const catalog::Schema *key_schema = metadata->GetKeySchema();
+  const oid_t column_count = key_schema->GetColumnCount();
+
+  auto copy_key = [&](const storage::Tuple &key_view) {
+    auto key_copy = std::make_shared<storage::Tuple>(key_schema, true);
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      key_copy->SetValue(column_itr, key_view.GetValue(column_itr), pool);
+    }
+    return key_copy;
+  };
+
+  if (csp_p->IsPointQuery() == true) {
+    // All matching entries carry the point query key itself
+    const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
+
+    KeyType point_query_key;
+    point_query_key.SetFromKey(point_query_key_p);
+
+    std::vector<ValueType> point_result;
+    container.GetValue(point_query_key, point_result);
+
+    for (auto value : point_result) {
+      result.push_back(std::make_pair(copy_key(*point_query_key_p), value));
+    }
+  } else if (csp_p->IsFullIndexScan() == true) {
+    for (auto scan_itr = container.Begin(); (scan_itr.IsEnd() == false);
+         scan_itr++) {
+      // GetTupleForComparison() is not const-qualified on every key type
+      KeyType scan_key = scan_itr->first;
+      result.push_back(std::make_pair(
+          copy_key(scan_key.GetTupleForComparison(key_schema)),
+          scan_itr->second));
+    }
+
+    // As in Scan(), full backward scans reverse the forward pass
+    if (scan_direction == ScanDirectionType::BACKWARD) {
+      std::reverse(result.begin(), result.end());
+    }
+  } else {
+    const storage::Tuple *low_key_p = csp_p->GetLowKey();
+    const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(low_key_p);
+    index_high_key.SetFromKey(high_key_p);
+
+    if (scan_direction == ScanDirectionType::BACKWARD) {
+      ScanRangeDescending(
+          index_low_key, index_high_key,
+          [&result, &copy_key, key_schema](const KeyType &key,
+                                           ValueType value) {
+            KeyType scan_key = key;
+            result.push_back(std::make_pair(
+                copy_key(scan_key.GetTupleForComparison(key_schema)), value));
+            return true;
+          });
+    } else {
+      for (auto scan_itr = container.Begin(index_low_key);
+           (scan_itr.IsEnd() == false) &&
+               (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
+           scan_itr++) {
+        KeyType scan_key = scan_itr->first;
+        result.push_back(std::make_pair(
+            copy_key(scan_key.GetTupleForComparison(key_schema)),
+            scan_itr->second));
+      }
+    }
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return true;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
   auto it = container.Begin();
@@ -289,9 +565,72 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeys() - Batched point lookup
+ *
+ * Sorts the key batch before probing so that adjacent probes descend
+ * through the same upper tree levels while they are still cache-resident,
+ * which is where most of the per-key traversal cost goes for IN (...)
+ * lookups with many keys. Stats are updated once for the whole batch.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                                 std::vector<ValueType> &result) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  std::sort(index_keys.begin(), index_keys.end(), comparator);
+
+  for (const KeyType &index_key : index_keys) {
+    container.GetValue(index_key, result);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
+// TupleKey entries reference base tuples rather than owning key data in the
+// key schema layout, so key values cannot be reproduced from the key alone
+template <>
+bool BWTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
+                 TupleKeyEqualityChecker, TupleKeyHasher,
+                 ItemPointerComparator, ItemPointerHashFunc>::
+    ScanKeyValues(
+        UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+        UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+        UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+        UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
+        UNUSED_ATTRIBUTE std::vector<
+            std::pair<std::shared_ptr<storage::Tuple>, ItemPointer *>> &result,
+        UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p,
+        UNUSED_ATTRIBUTE type::AbstractPool *pool) {
+  return false;
+}
+
+// Same limitation as above: without reproducible key values the prefix of
+// the current entry cannot be read back, so skip scans fall back to the
+// plain range walk
+template <>
+bool BWTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
+                 TupleKeyEqualityChecker, TupleKeyHasher,
+                 ItemPointerComparator, ItemPointerHashFunc>::
+    ScanSkip(UNUSED_ATTRIBUTE const storage::Tuple *low_key_p,
+             UNUSED_ATTRIBUTE const storage::Tuple *high_key_p,
+             UNUSED_ATTRIBUTE oid_t prefix_column_count,
+             UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result) {
+  return false;
+}
+
 // IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
 
 template class BWTreeIndex<CompactIntsKey<1>, ItemPointer *,
@@ -145,6 +145,20 @@ Index::~Index() {
   return;
 }
 
+// Insert a batch of sorted key-value pairs one at a time. Tree and skip-list
+// indexes still profit from the sorted order: consecutive insertions traverse
+// mostly the same path, so the upper levels stay hot in cache.
+bool Index::BulkInsertEntries(
+    const std::vector<std::pair<std::unique_ptr<storage::Tuple>,
+                                ItemPointer *>> &entries) {
+  for (const auto &entry : entries) {
+    if (InsertEntry(entry.first.get(), entry.second) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Converts a column ID in the table to a column ID in the index key
 //
 // This function accepts an oid_t which must be in the range of table column
@@ -187,6 +201,21 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+/*
+ * ScanKeys() - Fallback batched point lookup
+ *
+ * Probes the keys one at a time; concrete indexes override this with a
+ * sorted probe order so adjacent lookups share traversal paths in cache
+ */
+void Index::ScanKeys(const std::vector<const storage::Tuple *> &keys,
+                     std::vector<ItemPointer *> &result) {
+  for (const storage::Tuple *key : keys) {
+    ScanKey(key, result);
+  }
+
+  return;
+}
+
 // Check whether a given index key satisfies a predicate. The predicate has the
 // same specification as those in Scan()
 bool Index::Compare(const AbstractTuple &index_key,
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_consolidator.cpp
+//
+// Identification: src/index/index_consolidator.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/index_consolidator.h"
+
+#include <chrono>
+
+#include "common/logger.h"
+#include "index/index.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "threadpool/mono_queue_pool.h"
+
+namespace peloton {
+namespace index {
+
+IndexConsolidator::IndexConsolidator()
+    : consolidation_stop_(true),
+      total_consolidated_count_(0),
+      pass_count_(0) {}
+
+IndexConsolidator::~IndexConsolidator() {}
+
+IndexConsolidator &IndexConsolidator::GetInstance() {
+  static IndexConsolidator index_consolidator;
+  return index_consolidator;
+}
+
+void IndexConsolidator::Start() {
+  consolidation_stop_ = false;
+
+  consolidator_thread_ =
+      std::thread(&index::IndexConsolidator::Consolidate, this);
+
+  LOG_INFO("Started index consolidator");
+}
+
+void IndexConsolidator::Stop() {
+  consolidation_stop_ = true;
+
+  if (consolidator_thread_.joinable()) {
+    consolidator_thread_.join();
+  }
+
+  LOG_INFO("Stopped index consolidator");
+}
+
+void IndexConsolidator::Consolidate() {
+  while (consolidation_stop_ == false) {
+    // Both knobs are re-read every pass so they can be tuned at runtime
+    int interval_ms = settings::SettingsManager::GetInt(
+        settings::SettingId::index_consolidator_interval_ms);
+    int chain_length_threshold = settings::SettingsManager::GetInt(
+        settings::SettingId::index_consolidator_threshold);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+    SubmitConsolidationTasks(chain_length_threshold);
+
+    pass_count_.fetch_add(1);
+
+    LOG_TRACE("Index consolidation pass %" PRIu64
+              " submitted, %" PRIu64 " chains consolidated so far",
+              pass_count_.load(), total_consolidated_count_.load());
+  }
+}
+
+void IndexConsolidator::SubmitConsolidationTasks(int chain_length_threshold) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  oid_t database_count = storage_manager->GetDatabaseCount();
+  for (oid_t database_offset = 0; database_offset < database_count;
+       database_offset++) {
+    auto database = storage_manager->GetDatabaseWithOffset(database_offset);
+    if (database == nullptr) continue;
+
+    oid_t table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; table_offset++) {
+      auto table = database->GetTable(table_offset);
+      if (table == nullptr) continue;
+
+      oid_t index_count = table->GetIndexCount();
+      for (oid_t index_offset = 0; index_offset < index_count;
+           index_offset++) {
+        auto index = table->GetIndex(index_offset);
+        if (index == nullptr) continue;
+
+        // The shared pointer keeps the index alive until the worker is done
+        // with it, even if the index is dropped in the meantime
+        threadpool::MonoQueuePool::GetInstance().SubmitTask(
+            [this, index, chain_length_threshold]() {
+              size_t consolidated =
+                  index->ConsolidateLongChains(chain_length_threshold);
+              if (consolidated > 0) {
+                total_consolidated_count_.fetch_add(consolidated);
+              }
+            });
+      }
+    }
+  }
+}
+
+}  // namespace index
+}  // namespace peloton
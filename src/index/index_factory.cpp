@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "index/art_index.h"
+#include "index/bitmap_index.h"
 #include "index/bwtree_index.h"
 #include "index/index_key.h"
 #include "index/skiplist_index.h"
@@ -24,6 +25,27 @@
 namespace peloton {
 namespace index {
 
+namespace {
+
+/*
+ * GetCompactKeySize() - Returns the number of bytes a CompactIntsKey packs
+ *                       for the given key schema
+ *
+ * Integers take their natural width and VARCHAR columns their declared
+ * maximum length (the packed run is zero padded up to it), so this may
+ * differ from the schema's physical length for non-inlined columns
+ */
+size_t GetCompactKeySize(const catalog::Schema *key_schema) {
+  size_t packed_size = 0;
+  for (const auto &column : key_schema->GetColumns()) {
+    packed_size += column.GetLength();
+  }
+
+  return packed_size;
+}
+
+}  // namespace
+
 Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   LOG_TRACE("Creating index %s", metadata->GetName().c_str());
 
@@ -53,6 +75,37 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
     ints_only = false;
   }
 
+  // A key that mixes integers with bounded-length VARCHARs can still use
+  // the memcmp-comparable compact key: every string is packed as a zero
+  // padded, order-preserving byte run sized by its declared maximum
+  // length. Since the run always covers the whole bounded string, a tie
+  // on the packed bytes is a true tie and no fallback comparison on the
+  // full key is needed
+  bool compact_strings = false;
+  if (ints_only == false) {
+    compact_strings = true;
+    for (const auto &column : metadata->key_schema->GetColumns()) {
+      auto col_type = column.GetType();
+      if (col_type == type::TypeId::VARCHAR && column.GetLength() > 0) {
+        continue;
+      }
+      if (col_type != type::TypeId::TINYINT &&
+          col_type != type::TypeId::SMALLINT &&
+          col_type != type::TypeId::INTEGER &&
+          col_type != type::TypeId::BIGINT) {
+        compact_strings = false;
+        break;
+      }
+    }  // FOR
+
+    // The packed form must fit into the largest IntsKey we have
+    if (compact_strings &&
+        GetCompactKeySize(metadata->key_schema) >
+            sizeof(uint64_t) * INTSKEY_MAX_SLOTS) {
+      compact_strings = false;
+    }
+  }
+
   auto index_type = metadata->GetIndexType();
   Index *index = nullptr;
   LOG_TRACE("Index type : %s", IndexTypeToString(index_type).c_str());
@@ -61,7 +114,7 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   // BW-TREE
   // -----------------------
   if (index_type == IndexType::BWTREE) {
-    if (ints_only) {
+    if (ints_only || compact_strings) {
       index = IndexFactory::GetBwTreeIntsKeyIndex(metadata);
     } else {
       index = IndexFactory::GetBwTreeGenericKeyIndex(metadata);
@@ -71,7 +124,7 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
     // SKIP-LIST
     // -----------------------
   } else if (index_type == IndexType::SKIPLIST) {
-    if (ints_only) {
+    if (ints_only || compact_strings) {
       index = IndexFactory::GetSkipListIntsKeyIndex(metadata);
     } else {
       index = IndexFactory::GetSkipListGenericKeyIndex(metadata);
@@ -83,6 +136,12 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   } else if (index_type == IndexType::ART) {
     index = new ArtIndex(metadata);
 
+    // -----------------------
+    // BITMAP
+    // -----------------------
+  } else if (index_type == IndexType::BITMAP) {
+    index = new BitmapIndex(metadata);
+
     // -----------------------
     // ERROR
     // -----------------------
@@ -98,8 +157,8 @@ Index *IndexFactory::GetBwTreeIntsKeyIndex(IndexMetadata *metadata) {
   // Our new Index!
   Index *index = nullptr;
 
-  // The size of the key in bytes
-  const auto key_size = metadata->key_schema->GetLength();
+  // The size of the packed key in bytes
+  const auto key_size = GetCompactKeySize(metadata->key_schema);
 
 // Debug Output
 #ifdef LOG_TRACE_ENABLED
@@ -229,8 +288,8 @@ Index *IndexFactory::GetSkipListIntsKeyIndex(IndexMetadata *metadata) {
   // Our new Index!
   Index *index = nullptr;
 
-  // The size of the key in bytes
-  const auto key_size = metadata->key_schema->GetLength();
+  // The size of the packed key in bytes
+  const auto key_size = GetCompactKeySize(metadata->key_schema);
 
 // Debug Output
 #ifdef LOG_TRACE_ENABLED
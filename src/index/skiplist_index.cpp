@@ -11,9 +11,12 @@
 //===----------------------------------------------------------------------===//
 #include "index/skiplist_index.h"
 
+#include <algorithm>
+
 #include "common/logger.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
+#include "settings/settings_manager.h"
 #include "statistics/stats_aggregator.h"
 #include "storage/tuple.h"
 
@@ -27,8 +30,10 @@ SKIPLIST_INDEX_TYPE::SkipListIndex(IndexMetadata *metadata)
       // Key "less than" relation comparator
       comparator{},
       // Key equality checker
-      equals{} {
-  // TODO: Add your implementation here
+      equals{},
+      // NOTE: These two arguments need to be constructed in advance
+      // and do not have trivial constructor
+      container{comparator, equals} {
   return;
 }
 
@@ -41,11 +46,23 @@ SKIPLIST_INDEX_TYPE::~SkipListIndex() {}
  * If the key value pair already exists in the map, just return false
  */
 SKIPLIST_TEMPLATE_ARGUMENTS
-bool SKIPLIST_INDEX_TYPE::InsertEntry(
-    UNUSED_ATTRIBUTE const storage::Tuple *key,
-    UNUSED_ATTRIBUTE ItemPointer *value) {
-  bool ret = false;
-  // TODO: Add your implementation here
+bool SKIPLIST_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                      ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Insert(index_key, value);
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  LOG_TRACE("InsertEntry(key=%s, val=%s) [%s]",
+            index_key.GetInfo().c_str(),
+            IndexUtil::GetInfo(value).c_str(),
+            (ret ? "SUCCESS" : "FAIL"));
+
   return ret;
 }
 
@@ -55,69 +72,248 @@ bool SKIPLIST_INDEX_TYPE::InsertEntry(
  * If the key-value pair does not exists yet in the map return false
  */
 SKIPLIST_TEMPLATE_ARGUMENTS
-bool SKIPLIST_INDEX_TYPE::DeleteEntry(
-    UNUSED_ATTRIBUTE const storage::Tuple *key,
-    UNUSED_ATTRIBUTE ItemPointer *value) {
-  bool ret = false;
-  // TODO: Add your implementation here
+bool SKIPLIST_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                      ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  size_t delete_count = 0;
+
+  // In Delete() since we just use the value for comparison (i.e. read-only)
+  // it is unnecessary for us to allocate memory
+  bool ret = container.Delete(index_key, value);
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+
+  LOG_TRACE("DeleteEntry(key=%s, val=%s) [%s]",
+            index_key.GetInfo().c_str(),
+            IndexUtil::GetInfo(value).c_str(),
+            (ret ? "SUCCESS" : "FAIL"));
+
   return ret;
 }
 
 SKIPLIST_TEMPLATE_ARGUMENTS
 bool SKIPLIST_INDEX_TYPE::CondInsertEntry(
-    UNUSED_ATTRIBUTE const storage::Tuple *key,
-    UNUSED_ATTRIBUTE ItemPointer *value,
-    UNUSED_ATTRIBUTE std::function<bool(const void *)> predicate) {
-  bool ret = false;
-  // TODO: Add your implementation here
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool predicate_satisfied = false;
+
+  // This function will complete them in one step
+  // predicate will be set to nullptr if the predicate
+  // returns true for some value
+  bool ret = container.ConditionalInsert(index_key, value, predicate,
+                                         &predicate_satisfied);
+
+  // If predicate is not satisfied then we know insertion successes
+  if (predicate_satisfied == false) {
+    // So it should always succeed?
+    assert(ret == true);
+  } else {
+    assert(ret == false);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
   return ret;
 }
 
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
+ * The scan optimizer specifies whether a scan is point query, full scan
+ * or interval scan. For all of these cases the corresponding functions from
+ * the index is called, and all elements are returned in result vector
  */
 SKIPLIST_TEMPLATE_ARGUMENTS
 void SKIPLIST_INDEX_TYPE::Scan(
     UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
     UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
     UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
-    UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
-    UNUSED_ATTRIBUTE std::vector<ValueType> &result,
-    UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p) {
-  // TODO: Add your implementation here
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
+
+    KeyType point_query_key;
+    point_query_key.SetFromKey(point_query_key_p);
+
+    container.GetValue(point_query_key, result);
+  } else if (csp_p->IsFullIndexScan() == true) {
+    // If it is a full index scan, then just do the scan
+    // until we have reached the end of the bottom level
+    for (auto scan_itr = container.Begin(); (scan_itr.IsEnd() == false);
+         ++scan_itr) {
+      result.push_back(scan_itr.GetValue());
+    }  // for it from begin() to end()
+  } else {
+    const storage::Tuple *low_key_p = csp_p->GetLowKey();
+    const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+    LOG_TRACE("Partial scan low key: %s\n high key: %s",
+              low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
+
+    // Construct low key and high key in KeyType form, rather than
+    // the standard in-memory tuple
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(low_key_p);
+    index_high_key.SetFromKey(high_key_p);
+
+    // We use skiplist Begin() to first reach the lower bound
+    // of the search key
+    // Also we keep scanning until we have reached the end of the index
+    // or we have seen a key higher than the high key
+    for (auto scan_itr = container.Begin(index_low_key);
+         (scan_itr.IsEnd() == false) &&
+             (container.KeyCmpLessEqual(scan_itr.GetKey(), index_high_key));
+         ++scan_itr) {
+      result.push_back(scan_itr.GetValue());
+    }
+  }  // if is full scan
+
+  // The skip list's forward pointers only allow ascending iteration, so
+  // backward scans reverse the forward pass to produce descending order
+  if (scan_direction == ScanDirectionType::BACKWARD) {
+    std::reverse(result.begin(), result.end());
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
   return;
 }
 
 /*
  * ScanLimit() - Scan the index with predicate and limit/offset
  *
+ * This function scans the index using the given index optimizer's low key and
+ * high key. Only the (limit = 1, offset = 0, forward) special case is
+ * handled here; everything else falls back to Scan()
  */
 SKIPLIST_TEMPLATE_ARGUMENTS
 void SKIPLIST_INDEX_TYPE::ScanLimit(
-    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
-    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
-    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
-    UNUSED_ATTRIBUTE ScanDirectionType scan_direction,
-    UNUSED_ATTRIBUTE std::vector<ValueType> &result,
-    UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p,
-    UNUSED_ATTRIBUTE uint64_t limit, UNUSED_ATTRIBUTE uint64_t offset) {
-  // TODO: Add your implementation here
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, uint64_t limit, uint64_t offset) {
+  // Only work with limit == 1 and offset == 0
+  // Because that gets translated to "min"
+  // But still since we could not access tuples in the table
+  // the index just fetches the first qualified key without further checking
+  // including checking for non-exact bounds!!!
+  if (csp_p->IsPointQuery() == false && limit == 1 && offset == 0 &&
+      scan_direction == ScanDirectionType::FORWARD) {
+    const storage::Tuple *low_key_p = csp_p->GetLowKey();
+    const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+    LOG_TRACE("ScanLimit() special case (limit = 1; offset = 0; ASCENDING): %s",
+              low_key_p->GetInfo().c_str());
+
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(low_key_p);
+    index_high_key.SetFromKey(high_key_p);
+
+    auto scan_itr = container.Begin(index_low_key);
+    if ((scan_itr.IsEnd() == false) &&
+        (container.KeyCmpLessEqual(scan_itr.GetKey(), index_high_key))) {
+      result.push_back(scan_itr.GetValue());
+    }
+  } else {
+    Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+         csp_p);
+  }
+
+  return;
+}
+
+SKIPLIST_TEMPLATE_ARGUMENTS
+void SKIPLIST_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  auto it = container.Begin();
+
+  // scan all entries
+  while (it.IsEnd() == false) {
+    result.push_back(it.GetValue());
+    ++it;
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
   return;
 }
 
 SKIPLIST_TEMPLATE_ARGUMENTS
-void SKIPLIST_INDEX_TYPE::ScanAllKeys(
-    UNUSED_ATTRIBUTE std::vector<ValueType> &result) {
-  // TODO: Add your implementation here
+void SKIPLIST_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                                  std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // This function in SkipList fills a given vector
+  container.GetValue(index_key, result);
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
   return;
 }
 
+/*
+ * ScanKeys() - Batched point lookup
+ *
+ * Sorts the key batch before probing; since the skiplist's bottom level is
+ * key ordered, sorted probes walk the upper-level towers in monotonically
+ * increasing positions and keep them cache resident between probes. Stats
+ * are updated once for the whole batch.
+ */
 SKIPLIST_TEMPLATE_ARGUMENTS
-void SKIPLIST_INDEX_TYPE::ScanKey(
-    UNUSED_ATTRIBUTE const storage::Tuple *key,
-    UNUSED_ATTRIBUTE std::vector<ValueType> &result) {
-  // TODO: Add your implementation here
+void SKIPLIST_INDEX_TYPE::ScanKeys(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<ValueType> &result) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  std::sort(index_keys.begin(), index_keys.end(), comparator);
+
+  for (const KeyType &index_key : index_keys) {
+    container.GetValue(index_key, result);
+  }
+
+  if (static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
   return;
 }
 
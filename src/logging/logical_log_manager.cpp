@@ -0,0 +1,452 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// logical_log_manager.cpp
+//
+// Identification: src/logging/logical_log_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "logging/logical_log_manager.h"
+
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "logging/log_record.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace logging {
+
+void LogicalLogManager::StartLogging(
+    std::vector<std::unique_ptr<std::thread>> &logger_threads) {
+  is_running_ = true;
+  logger_threads.emplace_back(
+      new std::thread(&LogicalLogManager::Run, this));
+}
+
+void LogicalLogManager::StartLogging() {
+  is_running_ = true;
+  writer_thread_.reset(new std::thread(&LogicalLogManager::Run, this));
+}
+
+void LogicalLogManager::StopLogging() {
+  {
+    std::lock_guard<std::mutex> lock(group_commit_lock_);
+    is_running_ = false;
+  }
+  group_commit_cv_.notify_all();
+
+  if (writer_thread_ != nullptr) {
+    writer_thread_->join();
+    writer_thread_.reset();
+  }
+
+  // stop the shipper after the writer: the writer's final window may still
+  // enqueue a batch, and the shipper drains the backlog before exiting.
+  {
+    std::lock_guard<std::mutex> lock(replication_lock_);
+    shipper_running_ = false;
+  }
+  replication_cv_.notify_all();
+
+  if (shipper_thread_ != nullptr) {
+    shipper_thread_->join();
+    shipper_thread_.reset();
+  }
+}
+
+void LogicalLogManager::SubmitLogBuffer(LogBufferPool *pool,
+                                        std::unique_ptr<LogBuffer> buffer) {
+  PL_ASSERT(buffer.get() != nullptr);
+
+  std::lock_guard<std::mutex> lock(group_commit_lock_);
+  pending_buffers_.emplace_back(pool, std::move(buffer));
+}
+
+void LogicalLogManager::LogEnd() {
+  if (is_running_ == false) {
+    return;
+  }
+
+  if (settings::SettingsManager::GetBool(settings::SettingId::group_commit) ==
+      false) {
+    return;
+  }
+
+  // draw a ticket and park until the log writer has issued the fsync that
+  // covers it. the writer wakes the whole window at once.
+  std::unique_lock<std::mutex> lock(group_commit_lock_);
+  uint64_t ticket = ++enqueued_commit_count_;
+  group_commit_cv_.wait(lock, [&] {
+    return persisted_commit_count_ >= ticket || is_running_ == false;
+  });
+}
+
+void LogicalLogManager::Run() {
+  // one log file per logging session, stamped with the epoch the writer
+  // started in.
+  std::string file_path = GetLogFileFullPath(
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId());
+
+  FILE *log_file = fopen(file_path.c_str(), "ab");
+  if (log_file == nullptr) {
+    LOG_ERROR("Cannot open log file: %s", file_path.c_str());
+  }
+  int log_file_fd = (log_file != nullptr) ? fileno(log_file) : -1;
+
+  std::vector<std::pair<LogBufferPool *, std::unique_ptr<LogBuffer>>> batch;
+  std::string replication_batch;
+
+  while (true) {
+    // the window length bounds how long a commit waits for its fsync;
+    // re-read every round so it can be tuned at runtime.
+    int window_us = settings::SettingsManager::GetInt(
+        settings::SettingId::group_commit_window_us);
+    std::this_thread::sleep_for(std::chrono::microseconds(window_us));
+
+    bool stop = false;
+    uint64_t batch_commit_count = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(group_commit_lock_);
+      batch.swap(pending_buffers_);
+      batch_commit_count = enqueued_commit_count_;
+      stop = (is_running_ == false);
+    }
+
+    bool has_followers = false;
+    {
+      std::lock_guard<std::mutex> lock(replication_lock_);
+      has_followers = (followers_.empty() == false);
+    }
+
+    // coalesce every buffer submitted during the window into the log file
+    // and make the whole batch durable with a single fsync.
+    for (auto &entry : batch) {
+      LogBuffer *buffer = entry.second.get();
+      if (buffer->Empty() == false && log_file != nullptr) {
+        fwrite(buffer->GetData(), 1, buffer->GetSize(), log_file);
+        if (has_followers) {
+          replication_batch.append(buffer->GetData(), buffer->GetSize());
+        }
+      }
+      buffer->Reset();
+      if (entry.first != nullptr) {
+        entry.first->PutBuffer(std::move(entry.second));
+      }
+    }
+
+    if (log_file != nullptr &&
+        (batch.size() > 0 || batch_commit_count > persisted_commit_count_)) {
+      fflush(log_file);
+      fsync(log_file_fd);
+    }
+    batch.clear();
+
+    // stream the now-durable batch to the followers in commit order. The
+    // backlog bound keeps the replication lag finite: a writer that gets
+    // this far ahead waits for the shipper instead of piling up batches.
+    if (replication_batch.empty() == false) {
+      std::unique_lock<std::mutex> lock(replication_lock_);
+      replication_cv_.wait(lock, [&] {
+        return replication_backlog_.size() < MAX_REPLICATION_BACKLOG ||
+               shipper_running_ == false;
+      });
+      replication_backlog_.emplace_back(std::move(replication_batch));
+      lock.unlock();
+      replication_cv_.notify_all();
+    }
+    replication_batch.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(group_commit_lock_);
+      persisted_commit_count_ = batch_commit_count;
+    }
+    group_commit_cv_.notify_all();
+
+    if (stop == true) {
+      break;
+    }
+  }
+
+  if (log_file != nullptr) {
+    fclose(log_file);
+  }
+}
+
+void LogicalLogManager::StartRecovery(const size_t recovery_thread_count) {
+  recovery_thread_.reset(new std::thread(&LogicalLogManager::RunRecovery, this,
+                                         recovery_thread_count));
+}
+
+void LogicalLogManager::WaitForRecovery() {
+  if (recovery_thread_ != nullptr) {
+    recovery_thread_->join();
+    recovery_thread_.reset();
+  }
+}
+
+void LogicalLogManager::RunRecovery(const size_t recovery_thread_count) {
+  // Collect the epoch-stamped log files; each file covers one logging
+  // session and the epoch in its name orders the sessions
+  std::vector<std::pair<size_t, std::string>> log_files;
+
+  DIR *dir = opendir(log_dir_.c_str());
+  if (dir == nullptr) {
+    LOG_ERROR("Cannot open log directory: %s", log_dir_.c_str());
+    return;
+  }
+  std::string file_prefix = logging_filename_prefix_ + "_";
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string file_name(entry->d_name);
+    if (file_name.compare(0, file_prefix.size(), file_prefix) != 0) {
+      continue;
+    }
+    size_t epoch_id = std::stoul(file_name.substr(file_prefix.size()));
+    log_files.emplace_back(epoch_id, log_dir_ + "/" + file_name);
+  }
+  closedir(dir);
+
+  std::sort(log_files.begin(), log_files.end());
+
+  size_t partition_count = std::max<size_t>(recovery_thread_count, 1);
+
+  for (auto &log_file_entry : log_files) {
+    // Read the whole file image; the partition entries below point into it
+    FILE *log_file = fopen(log_file_entry.second.c_str(), "rb");
+    if (log_file == nullptr) {
+      LOG_ERROR("Cannot open log file: %s", log_file_entry.second.c_str());
+      continue;
+    }
+    fseek(log_file, 0, SEEK_END);
+    long file_size = ftell(log_file);
+    fseek(log_file, 0, SEEK_SET);
+
+    std::unique_ptr<char[]> file_data(new char[file_size]);
+    size_t read_size = fread(file_data.get(), 1, file_size, log_file);
+    fclose(log_file);
+
+    // Partition the framed records by table/tile-group affinity. Records
+    // in different partitions never touch the same tile group, so they
+    // replay concurrently without coordination.
+    std::vector<std::vector<std::pair<const char *, size_t>>> partitions(
+        partition_count);
+
+    size_t cursor = 0;
+    while (cursor + sizeof(int32_t) <= read_size) {
+      CopySerializeInput length_input(file_data.get() + cursor,
+                                      sizeof(int32_t));
+      size_t record_length = static_cast<size_t>(length_input.ReadInt());
+      cursor += sizeof(int32_t);
+      if (record_length == 0 || cursor + record_length > read_size) {
+        LOG_ERROR("Truncated log record in %s; stopping at offset %lu",
+                  log_file_entry.second.c_str(), cursor);
+        break;
+      }
+
+      const char *record_data = file_data.get() + cursor;
+      CopySerializeInput header_input(record_data, record_length);
+      LogRecord record = LogRecord::DeserializeHeaderFrom(header_input);
+      partitions[record.GetPartitionId(partition_count)]
+          .emplace_back(record_data, record_length);
+
+      cursor += record_length;
+    }
+
+    // Replay the partitions in parallel; joining them is the epoch
+    // barrier - the next file's records may depend on this file's
+    std::vector<std::unique_ptr<std::thread>> replay_threads;
+    for (size_t partition_itr = 1; partition_itr < partition_count;
+         partition_itr++) {
+      replay_threads.emplace_back(
+          new std::thread(&LogicalLogManager::ReplayPartition, this,
+                          std::cref(partitions[partition_itr])));
+    }
+    ReplayPartition(partitions[0]);
+
+    for (auto &replay_thread : replay_threads) {
+      replay_thread->join();
+    }
+
+    LOG_INFO("Replayed log file %s (epoch %lu)",
+             log_file_entry.second.c_str(), log_file_entry.first);
+  }
+}
+
+void LogicalLogManager::ReplayPartition(
+    const std::vector<std::pair<const char *, size_t>> &records) {
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  // Varlen values live here only until InsertTuple() copies them into the
+  // tile group's own pool
+  std::unique_ptr<type::EphemeralPool> pool(new type::EphemeralPool());
+
+  for (auto &record_entry : records) {
+    CopySerializeInput input(record_entry.first, record_entry.second);
+    LogRecord record = LogRecord::DeserializeHeaderFrom(input);
+
+    storage::DataTable *table = nullptr;
+    try {
+      table = storage_manager->GetTableWithOid(record.GetDatabaseOid(),
+                                               record.GetTableOid());
+    } catch (Exception &e) {
+      LOG_ERROR("Cannot find table %u in database %u during replay",
+                record.GetTableOid(), record.GetDatabaseOid());
+      continue;
+    }
+
+    switch (record.GetType()) {
+      case LogRecordType::TUPLE_DELETE: {
+        // Mark the recorded version dead as of the recorded commit id
+        auto tile_group = table->GetTileGroupById(record.GetItemPointer().block);
+        if (tile_group != nullptr) {
+          tile_group->GetHeader()->SetEndCommitId(
+              record.GetItemPointer().offset, record.GetCommitId());
+        }
+        break;
+      }
+      case LogRecordType::TUPLE_UPDATE_DELTA: {
+        // The payload holds only the modified columns; rebuild the new
+        // image from the recorded base version plus the delta
+        auto tile_group = table->GetTileGroupById(record.GetItemPointer().block);
+        if (tile_group == nullptr) {
+          break;
+        }
+        const catalog::Schema *schema = table->GetSchema();
+        storage::Tuple tuple(schema, true);
+        ContainerTuple<storage::TileGroup> base_tuple(
+            tile_group.get(), record.GetItemPointer().offset);
+        for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+             column_itr++) {
+          tuple.SetValue(column_itr, base_tuple.GetValue(column_itr),
+                         pool.get());
+        }
+
+        int32_t delta_count = input.ReadInt();
+        for (int32_t delta_itr = 0; delta_itr < delta_count; delta_itr++) {
+          oid_t column_id = static_cast<oid_t>(input.ReadInt());
+          type::Value value = type::Value::DeserializeFrom(
+              input, schema->GetType(column_id), pool.get());
+          tuple.SetValue(column_id, value, pool.get());
+        }
+
+        tile_group->GetHeader()->SetEndCommitId(record.GetItemPointer().offset,
+                                                record.GetCommitId());
+        table->InsertTuple(&tuple);
+        break;
+      }
+      case LogRecordType::TUPLE_UPDATE: {
+        // An update is a delete of the old version plus an insert of the
+        // new image carried in the payload
+        auto tile_group = table->GetTileGroupById(record.GetItemPointer().block);
+        if (tile_group != nullptr) {
+          tile_group->GetHeader()->SetEndCommitId(
+              record.GetItemPointer().offset, record.GetCommitId());
+        }
+      }  // fall through to install the new image
+      PELOTON_FALLTHROUGH;
+      case LogRecordType::TUPLE_INSERT: {
+        const catalog::Schema *schema = table->GetSchema();
+        storage::Tuple tuple(schema, true);
+        for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+             column_itr++) {
+          type::Value value = type::Value::DeserializeFrom(
+              input, schema->GetType(column_itr), pool.get());
+          tuple.SetValue(column_itr, value, pool.get());
+        }
+        table->InsertTuple(&tuple);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void LogicalLogManager::AddFollower(std::shared_ptr<LogShipper> follower) {
+  PL_ASSERT(follower.get() != nullptr);
+
+  std::lock_guard<std::mutex> lock(replication_lock_);
+  followers_.push_back(std::move(follower));
+
+  if (shipper_thread_ == nullptr) {
+    shipper_running_ = true;
+    shipper_thread_.reset(
+        new std::thread(&LogicalLogManager::RunShipper, this));
+  }
+}
+
+void LogicalLogManager::RunShipper() {
+  while (true) {
+    std::string shipped_batch;
+    std::vector<std::shared_ptr<LogShipper>> followers;
+
+    {
+      std::unique_lock<std::mutex> lock(replication_lock_);
+      replication_cv_.wait(lock, [&] {
+        return replication_backlog_.empty() == false ||
+               shipper_running_ == false;
+      });
+      if (replication_backlog_.empty()) {
+        // stopped and fully drained
+        break;
+      }
+      shipped_batch = std::move(replication_backlog_.front());
+      replication_backlog_.pop_front();
+      followers = followers_;
+    }
+    // wake a writer parked on the backlog bound
+    replication_cv_.notify_all();
+
+    // ship outside the lock; a slow follower delays the stream, not the
+    // writer's fsync loop
+    for (auto &follower : followers) {
+      follower->ShipLogBatch(shipped_batch);
+    }
+  }
+}
+
+void LogicalLogManager::ApplyShippedBatch(const char *data, size_t size) {
+  // Same framing as the log file: length-prefixed records back to back
+  std::vector<std::pair<const char *, size_t>> records;
+
+  size_t cursor = 0;
+  while (cursor + sizeof(int32_t) <= size) {
+    CopySerializeInput length_input(data + cursor, sizeof(int32_t));
+    size_t record_length = static_cast<size_t>(length_input.ReadInt());
+    cursor += sizeof(int32_t);
+    if (record_length == 0 || cursor + record_length > size) {
+      LOG_ERROR("Truncated log record in shipped batch at offset %lu", cursor);
+      break;
+    }
+    records.emplace_back(data + cursor, record_length);
+    cursor += record_length;
+  }
+
+  // Install the whole batch through the recovery replay path before the
+  // next one starts; the replayed versions keep their leader commit ids,
+  // so reads observe committed leader state batch by batch.
+  ReplayPartition(records);
+
+  applied_batch_count_.fetch_add(1);
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -40,7 +40,10 @@ void RunBenchmark() {
 
   epoch_manager.StartEpoch(epoch_thread);
 
-  if (state.multi_stage) {
+  if (state.hot_cold) {
+    // Run hot/cold skew benchmark for tiering and compression evaluation
+    RunHotColdBenchmark();
+  } else if (state.multi_stage) {
     // Run holistic indexing comparison benchmark
     RunMultiStageBenchmark();
   } else {
@@ -49,7 +49,11 @@ void Usage() {
       "   -w --write_ratio                    :  Fraction of writes\n"
       "   -x --index_count_threshold          :  Index count threshold\n"
       "   -y --index_utility_threshold        :  Index utility threshold\n"
-      "   -z --write_ratio_threshold          :  Write ratio threshold\n");
+      "   -z --write_ratio_threshold          :  Write ratio threshold\n"
+      "   -A --hot_cold                       :  Run hot/cold skew experiment\n"
+      "   -B --zipf_theta                     :  Skew of hot/cold writes\n"
+      "   -C --hot_window_fraction            :  Fraction of table that is "
+      "hot\n");
 
   exit(EXIT_FAILURE);
 }
@@ -79,6 +83,9 @@ static struct option opts[] = {
     {"write_ratio_threshold", optional_argument, NULL, 'z'},
     {"multi_stage", optional_argument, NULL, 'n'},
     {"holistic_indexing", optional_argument, NULL, 'r'},
+    {"hot_cold", optional_argument, NULL, 'A'},
+    {"zipf_theta", optional_argument, NULL, 'B'},
+    {"hot_window_fraction", optional_argument, NULL, 'C'},
     {NULL, 0, NULL, 0}};
 
 void GenerateSequence(oid_t column_count) {
@@ -374,6 +381,29 @@ static void ValidateHolisticIndexing(const configuration &state) {
   LOG_INFO("holistic_indexing : %d", state.holistic_indexing);
 }
 
+static void ValidateHotCold(const configuration &state) {
+  LOG_INFO("hot_cold : %d", state.hot_cold);
+}
+
+static void ValidateZipfTheta(const configuration &state) {
+  if (state.zipf_theta < 0 || state.zipf_theta >= 1) {
+    LOG_ERROR("Invalid zipf_theta :: %.2lf", state.zipf_theta);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %.2lf", "zipf_theta", state.zipf_theta);
+}
+
+static void ValidateHotWindowFraction(const configuration &state) {
+  if (state.hot_window_fraction <= 0 || state.hot_window_fraction > 1) {
+    LOG_ERROR("Invalid hot_window_fraction :: %.2lf",
+              state.hot_window_fraction);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %.2lf", "hot_window_fraction", state.hot_window_fraction);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   state.verbose = false;
 
@@ -421,17 +451,23 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.holistic_indexing = false;
   state.multi_stage_idx = 0;
 
+  // Hot/cold skew parameters
+  state.hot_cold = false;
+  state.zipf_theta = 0.9;
+  state.hot_window_fraction = 0.05;
+
   // Parse args
   while (1) {
     int idx = 0;
     int c = getopt_long(argc, argv,
-                        "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:",
+                        "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:"
+                        "A:B:C:",
                         opts, &idx);
 
     if (c == -1) break;
 
     switch (c) {
-      // AVAILABLE FLAGS: rABCDEFGHIJKLMNOPQRSTUVWXYZ
+      // AVAILABLE FLAGS: DEFGHIJKLMNOPQRSTUVWXYZ
       case 'a':
         state.attribute_count = atoi(optarg);
         break;
@@ -510,6 +546,15 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'z':
         state.write_ratio_threshold = atof(optarg);
         break;
+      case 'A':
+        state.hot_cold = atoi(optarg);
+        break;
+      case 'B':
+        state.zipf_theta = atof(optarg);
+        break;
+      case 'C':
+        state.hot_window_fraction = atof(optarg);
+        break;
 
       default:
         LOG_ERROR("Unknown option: -%c-", c);
@@ -559,6 +604,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateVariabilityThreshold(state);
   ValidateMultiStage(state);
   ValidateHolisticIndexing(state);
+  ValidateHotCold(state);
+  ValidateZipfTheta(state);
+  ValidateHotWindowFraction(state);
 }
 
 }  // namespace sdbench
@@ -24,6 +24,7 @@
 #include "brain/layout_tuner.h"
 #include "brain/sample.h"
 
+#include "benchmark/benchmark_common.h"
 #include "benchmark/sdbench/sdbench_loader.h"
 #include "benchmark/sdbench/sdbench_workload.h"
 
@@ -142,7 +143,18 @@ static std::vector<oid_t> GetPredicate() {
   return predicate;
 }
 
+// Hot/cold bound override. When armed, the scan predicates cover
+// [hot_bound_lower, hot_bound_upper) instead of the selectivity-derived
+// range, so a write can be aimed at an arbitrary key run.
+static bool hot_bounds_armed = false;
+static int hot_bound_lower = 0;
+static int hot_bound_upper = 0;
+
 static int GetLowerBound() {
+  if (hot_bounds_armed) {
+    return hot_bound_lower;
+  }
+
   int tuple_count = state.scale_factor * state.tuples_per_tilegroup;
   int predicate_offset = 0.1 * tuple_count;
 
@@ -153,6 +165,10 @@ static int GetLowerBound() {
 }
 
 static int GetUpperBound() {
+  if (hot_bounds_armed) {
+    return hot_bound_upper;
+  }
+
   int tuple_count = state.scale_factor * state.tuples_per_tilegroup;
   int selected_tuple_count = state.selectivity * tuple_count;
   int predicate_offset = 0.1 * tuple_count;
@@ -1539,6 +1555,128 @@ void RunSDBenchTest() {
   BenchmarkCleanUp();
 }
 
+/**
+ * @brief Physical footprint of the benchmark table in bytes, summed over
+ * every tile of every tile group. Frozen or compressed tiles report their
+ * compacted size, so the number reflects what tiering and compression
+ * actually save.
+ */
+static size_t GetTableFootprint() {
+  size_t footprint = 0;
+
+  auto tile_group_count = sdbench_table->GetTileGroupCount();
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = sdbench_table->GetTileGroup(tile_group_itr);
+    auto tile_count = tile_group->GetTileCount();
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      footprint += tile_group->GetTile(tile_itr)->GetSize();
+    }
+  }
+
+  return footprint;
+}
+
+/**
+ * @brief Run one zipfian update aimed at the hot window. Rank 1 of the
+ * distribution maps to the window start, so the tail of the distribution
+ * walks past the window into the cold corpus.
+ */
+static void RunHotColdWrite(ZipfDistribution &zipf, int tuple_count,
+                            int window_start, int run_length) {
+  std::vector<oid_t> update_attrs = {15, 16, 17};
+
+  oid_t first_attribute = rand() % state.variability_threshold;
+  std::vector<oid_t> tuple_key_attrs = {first_attribute};
+  std::vector<oid_t> index_key_attrs = {0};
+
+  int rank = (int)zipf.GetNextNumber() - 1;
+  int key = (window_start + rank) % tuple_count;
+
+  // Arm the bound override so the update targets the sampled key run
+  hot_bounds_armed = true;
+  hot_bound_lower = key;
+  hot_bound_upper = std::min(key + run_length, tuple_count);
+
+  UpdateHelper(tuple_key_attrs, index_key_attrs, update_attrs);
+
+  hot_bounds_armed = false;
+}
+
+void RunHotColdBenchmark() {
+  BenchmarkPrepare();
+
+  double write_ratio = state.write_ratio;
+
+  // Reset total duration
+  total_duration = 0;
+
+  // Reset query counter
+  query_itr = 0;
+
+  const int tuple_count = state.scale_factor * state.tuples_per_tilegroup;
+  const int window_size =
+      std::max(1, (int)(state.hot_window_fraction * tuple_count));
+  const int run_length = std::max(1, (int)(state.selectivity * tuple_count));
+
+  // The distribution spans the whole corpus, so a small fraction of the
+  // writes still lands in cold data the way production skew does
+  ZipfDistribution zipf(tuple_count, state.zipf_theta);
+
+  // cache original phase length
+  size_t original_phase_length = state.phase_length;
+
+  // run desired number of ops
+  oid_t phase_count = 0;
+  for (oid_t op_itr = 0; op_itr < state.total_ops;) {
+    size_t current_phase_length = original_phase_length;
+    if (current_phase_length > state.total_ops - op_itr) {
+      current_phase_length = state.total_ops - op_itr;
+    }
+
+    state.phase_length = current_phase_length;
+    op_itr += current_phase_length;
+    phase_count++;
+
+    // The hot window marches forward one window per phase and wraps, so
+    // every phase retires the previously hot tuples into the cold corpus
+    int window_start =
+        (int)(((phase_count - 1) * (size_t)window_size) % tuple_count);
+
+    double phase_start_duration = total_duration;
+
+    double rand_sample = (double)rand() / RAND_MAX;
+
+    // Do write
+    if (rand_sample < write_ratio) {
+      for (oid_t txn_itr = 0; txn_itr < current_phase_length; txn_itr++) {
+        RunHotColdWrite(zipf, tuple_count, window_start, run_length);
+      }
+    }
+    // Do read
+    else {
+      RunQuery();
+    }
+
+    double phase_duration = total_duration - phase_start_duration;
+    double throughput =
+        phase_duration > 0 ? current_phase_length / phase_duration : 0;
+    double footprint_mb = (double)GetTableFootprint() / (1024 * 1024);
+
+    LOG_INFO(
+        "Phase %u :: window start : %d :: duration : %.2lf s :: "
+        "throughput : %.2lf ops/s :: footprint : %.2lf MB",
+        phase_count, window_start, phase_duration, throughput, footprint_mb);
+  }
+
+  // Restore phase length
+  state.phase_length = original_phase_length;
+
+  LOG_INFO("Duration : %.2lf", total_duration);
+
+  BenchmarkCleanUp();
+}
+
 }  // namespace sdbench
 }  // namespace benchmark
 }  // namespace peloton
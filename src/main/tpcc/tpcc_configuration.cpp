@@ -252,6 +252,18 @@ void WriteOutput() {
   out << state.abort_rate << " ";
   out << total_profile_memory << "\n";
 
+  LOG_INFO("cross partition txn rate: %lf", state.cross_partition_rate);
+  out << "cross_partition_rate " << state.cross_partition_rate << "\n";
+
+  // per-partition throughput, reported when running with client affinity
+  for (size_t partition_itr = 0;
+       partition_itr < state.partition_throughput.size(); ++partition_itr) {
+    LOG_INFO("partition %d throughput: %lf", (int)partition_itr,
+             state.partition_throughput[partition_itr]);
+    out << "partition " << partition_itr << " "
+        << state.partition_throughput[partition_itr] << "\n";
+  }
+
   for (size_t round_id = 0; round_id < state.profile_throughput.size();
        ++round_id) {
     out << "[" << std::setw(3) << std::left
@@ -124,6 +124,10 @@ bool RunNewOrder(const size_t &thread_id){
     ol_qtys.push_back(GetRandomInteger(0, order_line_max_ol_quantity));
   }
 
+  if (o_all_local == false) {
+    cross_partition_counts[thread_id].data++;
+  }
+
   std::vector<expression::AbstractExpression *> runtime_keys;
 
   /////////////////////////////////////////////////////////
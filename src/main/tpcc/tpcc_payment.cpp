@@ -124,6 +124,7 @@ bool RunPayment(const size_t &thread_id){
     customer_warehouse_id = GetRandomIntegerExcluding(0, state.warehouse_count - 1, warehouse_id);
     PL_ASSERT(customer_warehouse_id != warehouse_id);
     customer_district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
+    cross_partition_counts[thread_id].data++;
   }
 
   // 60%: payment by last name
@@ -92,6 +92,7 @@ volatile bool is_running = true;
 
 PadInt *abort_counts;
 PadInt *commit_counts;
+PadInt *cross_partition_counts;
 
 size_t GenerateWarehouseId(const size_t &thread_id) {
   if (state.affinity) {
@@ -248,6 +249,9 @@ void RunWorkload() {
   commit_counts = new PadInt[num_threads];
   PL_MEMSET(commit_counts, 0, sizeof(PadInt) * num_threads);
 
+  cross_partition_counts = new PadInt[num_threads];
+  PL_MEMSET(cross_partition_counts, 0, sizeof(PadInt) * num_threads);
+
   size_t profile_round = (size_t)(state.duration / state.profile_duration);
 
   PadInt **abort_counts_profiles = new PadInt *[profile_round];
@@ -342,6 +346,26 @@ void RunWorkload() {
   state.throughput = total_commit_count * 1.0 / state.duration;
   state.abort_rate = total_abort_count * 1.0 / total_commit_count;
 
+  // partitioned execution reporting: with affinity enabled each thread owns
+  // a fixed warehouse range, so the per-thread commit counts are exactly
+  // per-partition throughput. a transaction is cross-partition when it
+  // touched a warehouse outside its home partition (remote payment customer
+  // or remote order line supply warehouse).
+  uint64_t total_cross_partition_count = 0;
+  for (size_t i = 0; i < num_threads; ++i) {
+    total_cross_partition_count += cross_partition_counts[i].data;
+  }
+  state.cross_partition_rate =
+      total_cross_partition_count * 1.0 / total_commit_count;
+
+  if (state.affinity) {
+    for (size_t i = 0; i < num_threads; ++i) {
+      state.partition_throughput.push_back(
+          commit_counts_profiles[profile_round - 1][i].data * 1.0 /
+          state.duration);
+    }
+  }
+
   // cleanup everything.
   for (size_t round_id = 0; round_id < profile_round; ++round_id) {
     delete[] abort_counts_profiles[round_id];
@@ -361,6 +385,8 @@ void RunWorkload() {
   abort_counts = nullptr;
   delete[] commit_counts;
   commit_counts = nullptr;
+  delete[] cross_partition_counts;
+  cross_partition_counts = nullptr;
 }
 
 /////////////////////////////////////////////////////////
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdio>
 #include <getopt.h>
 #include <string>
@@ -31,13 +32,19 @@ void Usage(FILE *out) {
           "   -n --num-runs          :  the number of runs to execute for each query \n"
           "   -s --suffix            :  input file suffix \n"
           "   -d --dict-encode       :  dictionary encode \n"
-          "   -q --queries           :  comma-separated list of queries to run (i.g., 1,14 for Q1 and Q14) \n");
+          "   -q --queries           :  comma-separated list of queries to run (i.g., 1,14 for Q1 and Q14) \n"
+          "   -t --streams           :  the number of concurrent query streams (> 1 runs the throughput test) \n"
+          "   -p --pipeline-metrics  :  compile per-pipeline cycle/row counters into the queries \n"
+          "   -j --json              :  file to write per-query results to as JSON \n");
 }
 
 static struct option opts[] = {
     {"input-dir", required_argument, NULL, 'i'},
     {"dict-encode", optional_argument, NULL, 'd'},
     {"queries", optional_argument, NULL, 'q'},
+    {"streams", required_argument, NULL, 't'},
+    {"pipeline-metrics", no_argument, NULL, 'p'},
+    {"json", required_argument, NULL, 'j'},
     {NULL, 0, NULL, 0}};
 
 void ParseArguments(int argc, char **argv, Configuration &config) {
@@ -46,7 +53,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hi:n:s:dq:", opts, &idx);
+    int c = getopt_long(argc, argv, "hi:n:s:dq:t:pj:", opts, &idx);
 
     if (c == -1) break;
 
@@ -59,6 +66,21 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
       case 'n': {
         char *input = optarg;
         config.num_runs = static_cast<uint32_t>(std::atoi(input));
+        break;
+      }
+      case 't': {
+        char *input = optarg;
+        config.num_streams =
+            std::max(1u, static_cast<uint32_t>(std::atoi(input)));
+        break;
+      }
+      case 'p': {
+        config.pipeline_metrics = true;
+        break;
+      }
+      case 'j': {
+        config.json_path = optarg;
+        break;
       }
       case 'd': {
         config.dictionary_encode = true;
@@ -89,6 +111,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   LOG_INFO("Input directory   : '%s'", config.data_dir.c_str());
   LOG_INFO("Dictionary encode : %s",
            config.dictionary_encode ? "true" : "false");
+  LOG_INFO("Query streams     : %u", config.num_streams);
   for (uint32_t i = 0; i < 22; i++) {
     LOG_INFO("Run query %u : %s", i + 1,
              config.queries_to_run[i] ? "true" : "false");
@@ -12,12 +12,25 @@
 
 #include "benchmark/tpch/tpch_workload.h"
 
+#include <cinttypes>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
 #include "codegen/query.h"
+#include "codegen/query_parameters.h"
+#include "common/statement.h"
+#include "common/timer.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
 #include "executor/plan_executor.h"
 #include "planner/abstract_plan.h"
 #include "planner/binding_context.h"
 #include "codegen/counting_consumer.h"
+#include "settings/settings_manager.h"
+#include "statistics/backend_stats_context.h"
+#include "statistics/processor_metric.h"
 
 namespace peloton {
 namespace benchmark {
@@ -138,24 +151,150 @@ TPCHBenchmark::TPCHBenchmark(const Configuration &config, TPCHDatabase &db)
   };
 }
 
+namespace {
+
+// Run the compiled query to completion on this thread. Execute() invokes a
+// completion callback; we block on it so the timers around this call bracket
+// exactly one execution.
+void ExecuteSync(codegen::Query &query,
+                 std::unique_ptr<executor::ExecutorContext> executor_context,
+                 codegen::QueryResultConsumer &consumer,
+                 codegen::Query::RuntimeStats *stats) {
+  std::mutex mu;
+  std::condition_variable cond;
+  bool finished = false;
+  query.Execute(std::move(executor_context), consumer,
+                [&](executor::ExecutionResult) {
+                  std::unique_lock<decltype(mu)> lock(mu);
+                  finished = true;
+                  cond.notify_one();
+                },
+                stats);
+  std::unique_lock<decltype(mu)> lock(mu);
+  cond.wait(lock, [&] { return finished; });
+}
+
+// Minimal JSON string escaping for pipeline info strings
+std::string JsonEscape(const std::string &s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (c == '\n') {
+      out.append("\\n");
+    } else {
+      out.push_back(c);
+    }
+  }
+  return out;
+}
+
+}  // anonymous namespace
+
 void TPCHBenchmark::RunBenchmark() {
+  // Pipeline counters are compiled into the queries, so the setting must be
+  // on before any compilation happens
+  if (config_.pipeline_metrics) {
+    settings::SettingsManager::SetBool(
+        settings::SettingId::codegen_pipeline_metrics, true);
+  }
+
+  // Collect the queries we were asked to run, and load every table they
+  // need up front: streams share the database and loading is not
+  // synchronized
+  std::vector<const QueryConfig *> queries;
   for (uint32_t i = 0; i < 22; i++) {
     const auto &query_config = query_configs_[i];
     if (config_.ShouldRunQuery(query_config.query_id)) {
-      RunQuery(query_config);
+      queries.push_back(&query_config);
+      for (auto tid : query_config.required_tables) {
+        db_.LoadTable(tid);
+      }
+    }
+  }
+  if (queries.empty()) {
+    LOG_INFO("No queries selected");
+    return;
+  }
+
+  Timer<std::ratio<1, 1000>> timer;
+  timer.Start();
+
+  std::vector<QueryMetrics> results;
+  if (config_.num_streams <= 1) {
+    for (const auto *query_config : queries) {
+      results.push_back(RunQuery(*query_config));
     }
+  } else {
+    results = RunStreams(queries);
   }
+
+  timer.Stop();
+  ReportResults(results, timer.GetDuration());
 }
 
-void TPCHBenchmark::RunQuery(const TPCHBenchmark::QueryConfig &query_config) {
-  LOG_INFO("Running TPCH %s", query_config.query_name.c_str());
+std::vector<TPCHBenchmark::QueryMetrics> TPCHBenchmark::RunStreams(
+    const std::vector<const QueryConfig *> &queries) {
+  const uint32_t num_streams = config_.num_streams;
+  LOG_INFO("Throughput test: %u streams x %zu queries", num_streams,
+           queries.size());
+
+  std::vector<std::vector<QueryMetrics>> stream_results(num_streams);
+  std::vector<std::thread> streams;
+  for (uint32_t s = 0; s < num_streams; s++) {
+    streams.emplace_back([this, s, &queries, &stream_results]() {
+      // Each stream visits the queries in a rotated order so the streams
+      // do not march through the database in lock step
+      for (size_t i = 0; i < queries.size(); i++) {
+        const auto *query_config = queries[(s + i) % queries.size()];
+        stream_results[s].push_back(RunQuery(*query_config));
+      }
+    });
+  }
+  for (auto &stream : streams) {
+    stream.join();
+  }
 
-  // Load all the necessary tables
-  for (auto tid : query_config.required_tables) {
-    db_.LoadTable(tid);
+  // Fold the per-stream results into one entry per query, in the order the
+  // queries were selected
+  std::vector<QueryMetrics> merged;
+  for (const auto *query_config : queries) {
+    QueryMetrics total;
+    total.query_name = query_config->query_name;
+    for (const auto &stream_result : stream_results) {
+      for (const auto &metrics : stream_result) {
+        if (metrics.query_name != total.query_name) continue;
+        if (total.runs == 0) {
+          total.compile_stats = metrics.compile_stats;
+        }
+        total.runs += metrics.runs;
+        total.result_tuples = metrics.result_tuples;
+        total.wall_ms += metrics.wall_ms;
+        total.cpu_ms += metrics.cpu_ms;
+        total.runtime_stats.init_ms += metrics.runtime_stats.init_ms;
+        total.runtime_stats.plan_ms += metrics.runtime_stats.plan_ms;
+        total.runtime_stats.tear_down_ms +=
+            metrics.runtime_stats.tear_down_ms;
+        if (total.pipelines.empty()) {
+          total.pipelines = metrics.pipelines;
+        }
+      }
+    }
+    merged.push_back(std::move(total));
   }
+  return merged;
+}
+
+TPCHBenchmark::QueryMetrics TPCHBenchmark::RunQuery(
+    const TPCHBenchmark::QueryConfig &query_config) {
+  LOG_INFO("Running TPCH %s", query_config.query_name.c_str());
+
+  QueryMetrics metrics;
+  metrics.query_name = query_config.query_name;
 
-  // Construct the plan for Q1
+  // Construct the plan
   std::unique_ptr<planner::AbstractPlan> plan = query_config.PlanConstructor();
 
   // Do attribute binding
@@ -166,48 +305,160 @@ void TPCHBenchmark::RunQuery(const TPCHBenchmark::QueryConfig &query_config) {
   codegen::CountingConsumer counter;
 
   // Compile
-  codegen::QueryCompiler::CompileStats compile_stats;
+  codegen::QueryParameters parameters(*plan, {});
   codegen::QueryCompiler compiler;
-  auto compiled_query = compiler.Compile(*plan, counter, &compile_stats);
+  auto compiled_query =
+      compiler.Compile(*plan, parameters.GetQueryParametersMap(), counter,
+                       &metrics.compile_stats);
+
+  // Pipeline counters land on this thread's ongoing query metric; arm one
+  // per run so each run's counters are collected in isolation
+  std::shared_ptr<Statement> statement;
+  if (config_.pipeline_metrics) {
+    statement.reset(
+        new Statement(query_config.query_name,
+                      "TPCH " + query_config.query_name));
+  }
 
-  codegen::Query::RuntimeStats overall_stats;
-  overall_stats.init_ms = 0.0;
-  overall_stats.plan_ms = 0.0;
-  overall_stats.tear_down_ms = 0.0;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   for (uint32_t i = 0; i < config_.num_runs; i++) {
     // Reset the counter for this run
     counter.ResetCount();
 
+    if (statement != nullptr) {
+      stats::BackendStatsContext::GetInstance()->InitQueryMetric(statement,
+                                                                 nullptr);
+    }
+
     // Begin a transaction
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     auto *txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> executor_context(
+        new executor::ExecutorContext(txn,
+                                      codegen::QueryParameters(*plan, {})));
+
+    // Execute the query in the transaction, timing this thread's wall
+    // clock and CPU consumption around it
+    Timer<std::ratio<1, 1000>> wall_timer;
+    stats::ProcessorMetric cpu_metric(MetricType::PROCESSOR);
+    wall_timer.Start();
+    cpu_metric.StartTimer();
 
-    // Execute query in a transaction
     codegen::Query::RuntimeStats runtime_stats;
-    compiled_query->Execute(*txn, counter.GetCountAsState(), &runtime_stats);
+    ExecuteSync(*compiled_query, std::move(executor_context), counter,
+                &runtime_stats);
+
+    cpu_metric.RecordTime();
+    wall_timer.Stop();
 
     // Commit transaction
     txn_manager.CommitTransaction(txn);
 
     // Collect stats
-    overall_stats.init_ms += runtime_stats.init_ms;
-    overall_stats.plan_ms += runtime_stats.plan_ms;
-    overall_stats.tear_down_ms += runtime_stats.tear_down_ms;
+    metrics.runs++;
+    metrics.wall_ms += wall_timer.GetDuration();
+    metrics.cpu_ms +=
+        cpu_metric.GetUserDuration() + cpu_metric.GetSystemDuration();
+    metrics.runtime_stats.init_ms += runtime_stats.init_ms;
+    metrics.runtime_stats.plan_ms += runtime_stats.plan_ms;
+    metrics.runtime_stats.tear_down_ms += runtime_stats.tear_down_ms;
+
+    if (statement != nullptr) {
+      auto *query_metric =
+          stats::BackendStatsContext::GetInstance()->GetOnGoingQueryMetric();
+      if (query_metric != nullptr) {
+        metrics.pipelines = query_metric->GetPipelineStats();
+      }
+    }
+  }
+  metrics.result_tuples = counter.GetCount();
+
+  return metrics;
+}
+
+void TPCHBenchmark::ReportResults(const std::vector<QueryMetrics> &results,
+                                  double elapsed_ms) const {
+  for (const auto &metrics : results) {
+    const double runs = metrics.runs > 0 ? metrics.runs : 1;
+    LOG_INFO("%s: %s", metrics.query_name.c_str(),
+             peloton::GETINFO_THICK_LINE.c_str());
+    LOG_INFO("# Runs: %u, # Result tuples: %lu", metrics.runs,
+             metrics.result_tuples);
+    LOG_INFO("Setup: %.2lf, IR Gen: %.2lf, Compile: %.2lf",
+             metrics.compile_stats.setup_ms, metrics.compile_stats.ir_gen_ms,
+             metrics.compile_stats.jit_ms);
+    LOG_INFO("Wall: %.2lf ms, CPU: %.2lf ms", metrics.wall_ms / runs,
+             metrics.cpu_ms / runs);
+    LOG_INFO("Init: %.2lf ms, Plan: %.2lf ms, TearDown: %.2lf ms",
+             metrics.runtime_stats.init_ms / runs,
+             metrics.runtime_stats.plan_ms / runs,
+             metrics.runtime_stats.tear_down_ms / runs);
+    for (const auto &pipeline : metrics.pipelines) {
+      LOG_INFO("Pipeline %u [%s]: %" PRIu64 " cycles, %" PRIu64 " rows",
+               pipeline.pipeline_id, pipeline.pipeline_info.c_str(),
+               pipeline.cycles, pipeline.rows);
+    }
+  }
+
+  uint32_t total_executions = 0;
+  for (const auto &metrics : results) {
+    total_executions += metrics.runs;
   }
+  LOG_INFO("%s", peloton::GETINFO_THICK_LINE.c_str());
+  LOG_INFO("Streams: %u, Executions: %u, Elapsed: %.2lf ms",
+           config_.num_streams, total_executions, elapsed_ms);
 
-  LOG_INFO("%s: %s",
-           query_config.query_name.c_str(), peloton::GETINFO_THICK_LINE.c_str());
-  LOG_INFO("# Runs: %u, # Result tuples: %lu", config_.num_runs,
-           counter.GetCount());
-  LOG_INFO("Setup: %.2lf, IR Gen: %.2lf, Compile: %.2lf",
-           compile_stats.setup_ms, compile_stats.ir_gen_ms,
-           compile_stats.jit_ms);
-  LOG_INFO("Init: %.2lf ms, Plan: %.2lf ms, TearDown: %.2lf ms",
-           overall_stats.init_ms / config_.num_runs,
-           overall_stats.plan_ms / config_.num_runs,
-           overall_stats.tear_down_ms / config_.num_runs);
+  if (!config_.json_path.empty()) {
+    WriteJSON(results, elapsed_ms);
+  }
 }
 
+void TPCHBenchmark::WriteJSON(const std::vector<QueryMetrics> &results,
+                              double elapsed_ms) const {
+  std::ofstream out(config_.json_path);
+  if (!out.is_open()) {
+    LOG_ERROR("Could not open '%s' for writing", config_.json_path.c_str());
+    return;
+  }
+
+  out << "{\n";
+  out << "  \"scale_factor\": " << config_.scale_factor << ",\n";
+  out << "  \"num_streams\": " << config_.num_streams << ",\n";
+  out << "  \"num_runs\": " << config_.num_runs << ",\n";
+  out << "  \"elapsed_ms\": " << elapsed_ms << ",\n";
+  out << "  \"queries\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &metrics = results[i];
+    const double runs = metrics.runs > 0 ? metrics.runs : 1;
+    out << "    {\n";
+    out << "      \"name\": \"" << JsonEscape(metrics.query_name) << "\",\n";
+    out << "      \"runs\": " << metrics.runs << ",\n";
+    out << "      \"result_tuples\": " << metrics.result_tuples << ",\n";
+    out << "      \"compile\": {\"setup_ms\": "
+        << metrics.compile_stats.setup_ms
+        << ", \"ir_gen_ms\": " << metrics.compile_stats.ir_gen_ms
+        << ", \"jit_ms\": " << metrics.compile_stats.jit_ms << "},\n";
+    out << "      \"avg\": {\"wall_ms\": " << metrics.wall_ms / runs
+        << ", \"cpu_ms\": " << metrics.cpu_ms / runs
+        << ", \"init_ms\": " << metrics.runtime_stats.init_ms / runs
+        << ", \"plan_ms\": " << metrics.runtime_stats.plan_ms / runs
+        << ", \"tear_down_ms\": "
+        << metrics.runtime_stats.tear_down_ms / runs << "},\n";
+    out << "      \"pipelines\": [";
+    for (size_t p = 0; p < metrics.pipelines.size(); p++) {
+      const auto &pipeline = metrics.pipelines[p];
+      out << (p > 0 ? ", " : "") << "{\"id\": " << pipeline.pipeline_id
+          << ", \"info\": \"" << JsonEscape(pipeline.pipeline_info)
+          << "\", \"cycles\": " << pipeline.cycles
+          << ", \"rows\": " << pipeline.rows << "}";
+    }
+    out << "]\n";
+    out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n";
+  out << "}\n";
+
+  LOG_INFO("Wrote results to '%s'", config_.json_path.c_str());
+}
 
 }  // namespace tpch
 }  // namespace benchmark
@@ -42,6 +42,7 @@ void Usage(FILE *out) {
           "   -n --gc_backend_count  :  # of gc backends \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -t --time_series       :  write per-round profile as CSV to this file \n"
   );
 }
 
@@ -61,6 +62,7 @@ static struct option opts[] = {
     { "gc_backend_count", optional_argument, NULL, 'n' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "time_series", optional_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -169,11 +171,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.gc_mode = false;
   state.gc_backend_count = 1;
   state.loader_count = 1;
+  state.csv_file_name = "";
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:t:", opts, &idx);
 
     if (c == -1) break;
 
@@ -237,7 +240,10 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atoi(optarg);
         break;
-        
+      case 't':
+        state.csv_file_name = optarg;
+        break;
+
       case 'h':
         Usage(stderr);
         exit(EXIT_FAILURE);
@@ -300,6 +306,21 @@ void WriteOutput() {
   out << state.abort_rate << " ";
   out << total_profile_memory << "\n";
 
+  // latency percentiles (ms) per operation type
+  LOG_INFO("read latency (ms): p50 %lf p95 %lf p99 %lf p999 %lf",
+           state.read_latency.p50, state.read_latency.p95,
+           state.read_latency.p99, state.read_latency.p999);
+  LOG_INFO("update latency (ms): p50 %lf p95 %lf p99 %lf p999 %lf",
+           state.update_latency.p50, state.update_latency.p95,
+           state.update_latency.p99, state.update_latency.p999);
+
+  out << "read_latency " << state.read_latency.p50 << " "
+      << state.read_latency.p95 << " " << state.read_latency.p99 << " "
+      << state.read_latency.p999 << "\n";
+  out << "update_latency " << state.update_latency.p50 << " "
+      << state.update_latency.p95 << " " << state.update_latency.p99 << " "
+      << state.update_latency.p999 << "\n";
+
   for (size_t round_id = 0; round_id < state.profile_throughput.size();
        ++round_id) {
     out << "[" << std::setw(3) << std::left
@@ -311,6 +332,25 @@ void WriteOutput() {
   }
   out.flush();
   out.close();
+
+  // time-series mode: dump the per-round profile as CSV, so throughput dips
+  // under GC or compaction interference stay visible instead of being
+  // averaged away
+  if (state.csv_file_name.empty() == false) {
+    std::ofstream csv_out(state.csv_file_name);
+    csv_out << "round_start_s,round_end_s,throughput,abort_rate,"
+               "memory_delta\n";
+    for (size_t round_id = 0; round_id < state.profile_throughput.size();
+         ++round_id) {
+      csv_out << state.profile_duration * round_id << ","
+              << state.profile_duration * (round_id + 1) << ","
+              << state.profile_throughput[round_id] << ","
+              << state.profile_abort_rate[round_id] << ","
+              << state.profile_memory[round_id] << "\n";
+    }
+    csv_out.flush();
+    csv_out.close();
+  }
 }
 
 }  // namespace ycsb
@@ -103,7 +103,10 @@ bool RunMixed(const size_t thread_id, ZipfDistribution &zipf, FastRandom &rng) {
   expr_types.push_back(ExpressionType::COMPARE_EQUAL);
 
   std::vector<expression::AbstractExpression *> runtime_keys;
-  
+
+  // per-operation latency timer
+  Timer<std::milli> timer;
+
   for (int i = 0; i < state.operation_count; i++) {
 
     auto rng_val = rng.NextUniform();
@@ -175,7 +178,11 @@ bool RunMixed(const size_t thread_id, ZipfDistribution &zipf, FastRandom &rng) {
 
       update_executor.AddChild(&index_scan_executor);
 
+      timer.Reset();
+      timer.Start();
       ExecuteUpdate(&update_executor);
+      timer.Stop();
+      RecordUpdateLatency(thread_id, timer.GetDuration());
 
       if (txn->GetResult() != ResultType::SUCCESS) {
         txn_manager.AbortTransaction(txn);
@@ -209,9 +216,11 @@ bool RunMixed(const size_t thread_id, ZipfDistribution &zipf, FastRandom &rng) {
       executor::IndexScanExecutor index_scan_executor(&index_scan_node,
                                                       context.get());
 
-      
-      
+      timer.Reset();
+      timer.Start();
       ExecuteRead(&index_scan_executor);
+      timer.Stop();
+      RecordReadLatency(thread_id, timer.GetDuration());
 
       if (txn->GetResult() != ResultType::SUCCESS) {
         txn_manager.AbortTransaction(txn);
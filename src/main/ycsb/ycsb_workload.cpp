@@ -84,6 +84,66 @@ volatile bool is_running = true;
 PadInt *abort_counts;
 PadInt *commit_counts;
 
+// per-thread operation latency samples (in ms), one buffer per operation
+// type. each buffer is bounded; once full, new samples overwrite the oldest
+// ones so long runs keep a recent window instead of growing without bound.
+struct OperationLatencySamples {
+  std::vector<double> read_latencies;
+  std::vector<double> update_latencies;
+  size_t read_cursor = 0;
+  size_t update_cursor = 0;
+};
+
+static OperationLatencySamples *operation_samples = nullptr;
+
+static const size_t max_latency_samples = 1 << 20;
+
+static void RecordLatencySample(std::vector<double> &samples, size_t &cursor,
+                                double latency_ms) {
+  if (samples.size() < max_latency_samples) {
+    samples.push_back(latency_ms);
+  } else {
+    samples[cursor] = latency_ms;
+    cursor = (cursor + 1) % max_latency_samples;
+  }
+}
+
+void RecordReadLatency(const size_t thread_id, double latency_ms) {
+  auto &samples = operation_samples[thread_id];
+  RecordLatencySample(samples.read_latencies, samples.read_cursor, latency_ms);
+}
+
+void RecordUpdateLatency(const size_t thread_id, double latency_ms) {
+  auto &samples = operation_samples[thread_id];
+  RecordLatencySample(samples.update_latencies, samples.update_cursor,
+                      latency_ms);
+}
+
+// merge the per-thread sample buffers for one operation type and compute
+// the latency percentiles over the merged, sorted samples
+static void ComputeLatencyPercentiles(
+    size_t num_threads, std::vector<double> OperationLatencySamples::*member,
+    configuration::LatencyPercentiles &percentiles) {
+  std::vector<double> merged;
+  for (size_t i = 0; i < num_threads; ++i) {
+    auto &samples = operation_samples[i].*member;
+    merged.insert(merged.end(), samples.begin(), samples.end());
+  }
+  if (merged.empty()) {
+    return;
+  }
+  std::sort(merged.begin(), merged.end());
+
+  auto percentile = [&merged](double fraction) {
+    size_t sample_itr = (size_t)(fraction * (merged.size() - 1));
+    return merged[sample_itr];
+  };
+  percentiles.p50 = percentile(0.50);
+  percentiles.p95 = percentile(0.95);
+  percentiles.p99 = percentile(0.99);
+  percentiles.p999 = percentile(0.999);
+}
+
 #ifndef __APPLE__
 void PinToCore(size_t core) {
   cpu_set_t cpuset;
@@ -148,6 +208,8 @@ void RunWorkload() {
   commit_counts = new PadInt[num_threads];
   PL_MEMSET(commit_counts, 0, sizeof(PadInt) * num_threads);
 
+  operation_samples = new OperationLatencySamples[num_threads];
+
   size_t profile_round = (size_t)(state.duration / state.profile_duration);
 
   PadInt **abort_counts_profiles = new PadInt *[profile_round];
@@ -244,6 +306,14 @@ void RunWorkload() {
   state.throughput = total_commit_count * 1.0 / state.duration;
   state.abort_rate = total_abort_count * 1.0 / total_commit_count;
 
+  // summarize the operation latency samples into per-type percentiles
+  ComputeLatencyPercentiles(num_threads,
+                            &OperationLatencySamples::read_latencies,
+                            state.read_latency);
+  ComputeLatencyPercentiles(num_threads,
+                            &OperationLatencySamples::update_latencies,
+                            state.update_latency);
+
   //////////////////////////////////////////////////
 
   // cleanup everything.
@@ -267,6 +337,9 @@ void RunWorkload() {
   delete[] commit_counts;
   commit_counts = nullptr;
 
+  delete[] operation_samples;
+  operation_samples = nullptr;
+
 }
 
 
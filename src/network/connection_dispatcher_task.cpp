@@ -40,6 +40,12 @@ ConnectionDispatcherTask::ConnectionDispatcherTask(int num_handlers,
   for (int task_id = 0; task_id < num_handlers; task_id++) {
     auto handler = std::make_shared<ConnectionHandlerTask>(task_id);
     handlers_.push_back(handler);
+  }
+
+  // hand every handler its siblings for work stealing, then start the event
+  // loops
+  for (auto &handler : handlers_) {
+    handler->SetSiblings(&handlers_);
     thread_pool.SubmitDedicatedTask([=] { handler->EventLoop(); });
   }
 }
@@ -53,11 +59,23 @@ void ConnectionDispatcherTask::DispatchConnection(int fd, short) {
     LOG_ERROR("Failed to accept");
   }
 
-  // Dispatch by rand number
-  int handler_id = next_handler_;
+  // Dispatch to the least loaded handler (pending dispatches plus live
+  // connections), starting the scan at a rotating offset so ties spread
+  // round-robin
+  int handler_count = static_cast<int>(handlers_.size());
+  int start = next_handler_;
+  next_handler_ = (next_handler_ + 1) % handler_count;
 
-  // update next threadID
-  next_handler_ = (next_handler_ + 1) % handlers_.size();
+  int handler_id = start;
+  size_t min_load = handlers_[handler_id]->GetLoad();
+  for (int i = 1; i < handler_count && min_load > 0; i++) {
+    int candidate = (start + i) % handler_count;
+    size_t load = handlers_[candidate]->GetLoad();
+    if (load < min_load) {
+      handler_id = candidate;
+      min_load = load;
+    }
+  }
 
   std::shared_ptr<ConnectionHandlerTask> handler = handlers_[handler_id];
   LOG_DEBUG("Dispatching connection to worker %d", handler_id);
@@ -10,11 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <sys/uio.h>
 #include <unistd.h>
 #include <cstring>
 
 #include "network/connection_dispatcher_task.h"
 #include "network/connection_handle.h"
+#include "network/network_buffer_pool.h"
 #include "network/peloton_server.h"
 #include "network/postgres_protocol_handler.h"
 #include "network/protocol_handler_factory.h"
@@ -156,6 +158,24 @@ ConnectionHandle::ConnectionHandle(int sock_fd, ConnectionHandlerTask *handler,
       workpool_event);
 }
 
+ConnectionHandle::~ConnectionHandle() {
+  // CloseSocket() normally returns the buffers already; this covers handles
+  // that are dropped without going through the CLOSING state
+  ReturnBuffers();
+}
+
+void ConnectionHandle::ReturnBuffers() {
+  auto &buffer_pool = NetworkBufferPool::GetInstance();
+  if (rbuf_ != nullptr && rbuf_.unique()) {
+    buffer_pool.ReturnBuffer(std::move(rbuf_));
+  }
+  rbuf_ = nullptr;
+  if (wbuf_ != nullptr && wbuf_.unique()) {
+    buffer_pool.ReturnBuffer(std::move(wbuf_));
+  }
+  wbuf_ = nullptr;
+}
+
 void ConnectionHandle::UpdateEventFlags(short flags) {
   // TODO(tianyu): The original network code seems to do this as an
   // optimization. I am leaving this out until we get numbers
@@ -190,6 +210,18 @@ WriteState ConnectionHandle::WritePackets() {
   next_response_ = 0;
 
   if (protocol_handler_->GetFlushFlag()) {
+    if (protocol_handler_->HasCompletePacket(*rbuf_) &&
+        wbuf_->buf_size < kCoalesceByteThreshold) {
+      // The client pipelined further messages behind this one. Keep the
+      // responses in the write buffer and emit everything with one write
+      // once the burst is drained, instead of one syscall per message. Once
+      // the staged bytes exceed the coalescing threshold, flush anyway to
+      // bound latency and buffer growth.
+      protocol_handler_->SetFlushFlag(false);
+      flush_deferred_ = true;
+      return WriteState::COMPLETE;
+    }
+    flush_deferred_ = false;
     return FlushWriteBuffer();
   }
 
@@ -415,6 +447,63 @@ WriteState ConnectionHandle::FlushWriteBuffer() {
   return WriteState::COMPLETE;
 }
 
+WriteState ConnectionHandle::FlushWriteBufferAndBody(OutputPacket *pkt) {
+  // This could be changed by unfinished write
+  // When we reenter, we need to recover it to read
+  UpdateEventFlags(EV_READ | EV_PERSIST);
+
+  PL_ASSERT(conn_SSL_context == nullptr);
+
+  while (wbuf_->buf_size > 0 || pkt->write_ptr < pkt->len) {
+    // gather whatever is staged in the write buffer plus the unsent body
+    struct iovec iov[2];
+    int iov_count = 0;
+    if (wbuf_->buf_size > 0) {
+      iov[iov_count].iov_base = &wbuf_->buf[wbuf_->buf_flush_ptr];
+      iov[iov_count].iov_len = wbuf_->buf_size;
+      iov_count++;
+    }
+    size_t body_remaining = pkt->len - pkt->write_ptr;
+    if (body_remaining > 0) {
+      iov[iov_count].iov_base = pkt->buf.data() + pkt->write_ptr;
+      iov[iov_count].iov_len = body_remaining;
+      iov_count++;
+    }
+
+    ssize_t written_bytes = writev(sock_fd_, iov, iov_count);
+    if (written_bytes < 0) {
+      if (errno == EINTR) {
+        // interrupts are ok, try again
+        continue;
+      } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Listen for socket being enabled for write; the buffer's flush
+        // pointer and the packet's write pointer hold our progress
+        UpdateEventFlags(EV_WRITE | EV_PERSIST);
+        LOG_TRACE("WRITEV NOT READY");
+        return WriteState::NOT_READY;
+      } else {
+        // fatal errors
+        LOG_ERROR("Error writing: %s", strerror(errno));
+        throw NetworkProcessException("Fatal error during write");
+      }
+    }
+
+    // update book keeping: staged bytes went out first, then body bytes
+    size_t consumed = written_bytes;
+    if (wbuf_->buf_size > 0) {
+      size_t from_buffer = std::min(consumed, wbuf_->buf_size);
+      wbuf_->buf_flush_ptr += from_buffer;
+      wbuf_->buf_size -= from_buffer;
+      consumed -= from_buffer;
+    }
+    pkt->write_ptr += consumed;
+  }
+  // buffer is empty and the body is fully sent
+  wbuf_->Reset();
+
+  return WriteState::COMPLETE;
+}
+
 std::string ConnectionHandle::WriteBufferToString() {
 #ifdef LOG_TRACE_ENABLED
   LOG_TRACE("Write Buffer:");
@@ -553,6 +642,37 @@ WriteState ConnectionHandle::BufferWriteBytesContent(OutputPacket *pkt) {
   // window is the size of remaining space in socket's wbuf
   size_t window = 0;
 
+  // Large bodies skip the staging copy entirely: the bytes already in wbuf_
+  // (including this packet's header) and the body go out together with one
+  // scatter-gather write. SSL connections have no writev equivalent and
+  // keep the copy path. The check is on the total body size so that a
+  // packet interrupted mid-writev resumes here, where the partially
+  // flushed buffer state is understood.
+  if (conn_SSL_context == nullptr && len >= kDirectWritevThreshold) {
+    return FlushWriteBufferAndBody(pkt);
+  }
+
+  // Large results would otherwise ping-pong between fill and flush on the
+  // default-sized buffer; upgrade to a larger pooled buffer instead, carrying
+  // over whatever is already batched. BorrowBuffer() backs off to a smaller
+  // tier when the requested one is exhausted, in which case we keep the
+  // current buffer and fall back to windowed flushing below.
+  if (len > wbuf_->GetMaxSize() - wbuf_->buf_ptr) {
+    auto &buffer_pool = NetworkBufferPool::GetInstance();
+    auto upgraded = buffer_pool.BorrowBuffer(wbuf_->buf_ptr + len);
+    if (upgraded->GetMaxSize() > wbuf_->GetMaxSize()) {
+      std::copy(std::begin(wbuf_->buf), std::begin(wbuf_->buf) + wbuf_->buf_ptr,
+                std::begin(upgraded->buf));
+      upgraded->buf_ptr = wbuf_->buf_ptr;
+      upgraded->buf_size = wbuf_->buf_size;
+      upgraded->buf_flush_ptr = wbuf_->buf_flush_ptr;
+      buffer_pool.ReturnBuffer(std::move(wbuf_));
+      wbuf_ = std::move(upgraded);
+    } else {
+      buffer_pool.ReturnBuffer(std::move(upgraded));
+    }
+  }
+
   // fill the contents
   while (len != 0) {
     // calculate the remaining space in wbuf
@@ -600,6 +720,13 @@ Transition ConnectionHandle::CloseSocket() {
   handler_->UnregisterEvent(network_event);
   handler_->UnregisterEvent(workpool_event);
 
+  // The dispatcher balances new connections on handler load
+  handler_->ConnectionClosed();
+
+  // Hand the pooled buffers back so they are available to live connections
+  // instead of sitting with this fd until it is reused
+  ReturnBuffers();
+
   if (conn_SSL_context != nullptr) {
     int shutdown_ret = 0;
     while (true) {
@@ -733,6 +860,14 @@ Transition ConnectionHandle::Process() {
 
     switch (status) {
       case ProcessResult::MORE_DATA_REQUIRED:
+        if (flush_deferred_) {
+          // the burst is drained; emit the responses postponed during it
+          // before waiting on the socket. The deferral cannot recur here
+          // since no complete message is buffered anymore.
+          flush_deferred_ = false;
+          protocol_handler_->SetFlushFlag(true);
+          return Transition::PROCEED;
+        }
         return Transition::NEED_DATA;
       case ProcessResult::COMPLETE:
         return Transition::PROCEED;
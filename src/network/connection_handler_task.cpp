@@ -18,7 +18,12 @@ namespace peloton {
 namespace network {
 
 ConnectionHandlerTask::ConnectionHandlerTask(const int task_id)
-    : NotifiableTask(task_id) {
+    : NotifiableTask(task_id),
+      // initial queue capacity; the underlying queue grows as needed
+      pending_conns_(32),
+      num_pending_(0),
+      num_connections_(0),
+      siblings_(nullptr) {
   int fds[2];
   if (pipe(fds)) {
     LOG_ERROR("Can't create notify pipe to accept connections");
@@ -31,6 +36,11 @@ ConnectionHandlerTask::ConnectionHandlerTask(const int task_id)
 }
 
 void ConnectionHandlerTask::Notify(int conn_fd) {
+  // The connection goes through the queue so that idle siblings can steal
+  // it; the pipe write only wakes this handler's event loop up
+  pending_conns_.Enqueue(conn_fd);
+  num_pending_.fetch_add(1);
+
   int buf[1];
   buf[0] = conn_fd;
   if (write(new_conn_send_fd_, buf, sizeof(int)) != sizeof(int)) {
@@ -38,16 +48,39 @@ void ConnectionHandlerTask::Notify(int conn_fd) {
   }
 }
 
+bool ConnectionHandlerTask::StealPendingConnection(int &conn_fd) {
+  if (siblings_ == nullptr) {
+    return false;
+  }
+
+  // Steal from the sibling with the deepest backlog first
+  ConnectionHandlerTask *victim = nullptr;
+  size_t victim_pending = 0;
+  for (auto &sibling : *siblings_) {
+    if (sibling.get() == this) continue;
+    size_t sibling_pending = sibling->GetPendingCount();
+    if (sibling_pending > victim_pending) {
+      victim = sibling.get();
+      victim_pending = sibling_pending;
+    }
+  }
+
+  if (victim == nullptr) {
+    return false;
+  }
+  return victim->TryGetPendingConnection(conn_fd);
+}
+
 void ConnectionHandlerTask::HandleDispatch(int new_conn_recv_fd, short) {
   // buffer used to receive messages from the main thread
-  char client_fd[sizeof(int)];
+  char wakeup_buf[sizeof(int)];
   std::shared_ptr<ConnectionHandle> conn;
   size_t bytes_read = 0;
 
   // read fully
   while (bytes_read < sizeof(int)) {
     ssize_t result = read(new_conn_recv_fd,
-                       client_fd + bytes_read,
+                       wakeup_buf + bytes_read,
                        sizeof(int) - bytes_read);
     if (result < 0) {
       LOG_ERROR("Error when reading from dispatch");
@@ -55,8 +88,17 @@ void ConnectionHandlerTask::HandleDispatch(int new_conn_recv_fd, short) {
     bytes_read += (size_t) result;
   }
 
-  conn = ConnectionHandleFactory::GetInstance().GetConnectionHandle(
-      *((int *) client_fd), this);
+  // Pick up our own dispatched connection, or - if a sibling already stole
+  // it - one queued at an overloaded sibling
+  int client_fd;
+  if (TryGetPendingConnection(client_fd) == false &&
+      StealPendingConnection(client_fd) == false) {
+    return;
+  }
+
+  conn = ConnectionHandleFactory::GetInstance().GetConnectionHandle(client_fd,
+                                                                    this);
+  num_connections_.fetch_add(1);
 }
 
 }  // namespace network
@@ -81,6 +81,16 @@ void PacketGetBytes(InputPacket *rpkt, size_t len, ByteBuf &result) {
   rpkt->ptr += len;
 }
 
+ByteBuf::const_iterator PacketGetBytesView(InputPacket *rpkt, size_t len) {
+  CheckOverflow(rpkt, len);
+
+  auto view = rpkt->Begin() + rpkt->ptr;
+
+  // move the pointer
+  rpkt->ptr += len;
+  return view;
+}
+
 void PacketGetByte(InputPacket *rpkt, uchar &result) {
   // access the current byte
   result = *(rpkt->Begin() + rpkt->ptr);
@@ -171,5 +181,9 @@ void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len) {
   pkt->len += len;
 }
 
+void PacketReserveBytes(OutputPacket *pkt, size_t len) {
+  pkt->buf.reserve(pkt->buf.size() + len);
+}
+
 }  // namespace network
 }  // namespace peloton
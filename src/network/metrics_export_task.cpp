@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metrics_export_task.cpp
+//
+// Identification: src/network/metrics_export_task.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "network/metrics_export_task.h"
+#include "statistics/stats_aggregator.h"
+
+namespace peloton {
+namespace network {
+
+MetricsExportTask::MetricsExportTask(int task_id, int port)
+    : NotifiableTask(task_id) {
+  struct sockaddr_in sin;
+  PL_MEMSET(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = INADDR_ANY;
+  sin.sin_port = htons(port);
+
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw ConnectionException("Failed to create metrics export socket");
+  }
+
+  int reuse = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  if (bind(listen_fd_, (struct sockaddr *)&sin, sizeof(sin)) < 0 ||
+      listen(listen_fd_, 12) < 0) {
+    close(listen_fd_);
+    throw ConnectionException("Failed to listen on metrics export port");
+  }
+
+  RegisterEvent(listen_fd_, EV_READ | EV_PERSIST,
+                METHOD_AS_CALLBACK(MetricsExportTask, HandleRequest), this);
+
+  LOG_INFO("Metrics export listening on port %d", port);
+}
+
+MetricsExportTask::~MetricsExportTask() {
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+  }
+}
+
+void MetricsExportTask::HandleRequest(int, UNUSED_ATTRIBUTE short flags) {
+  int conn_fd = accept(listen_fd_, nullptr, nullptr);
+  if (conn_fd < 0) {
+    LOG_ERROR("Failed to accept metrics export connection");
+    return;
+  }
+
+  // drain whatever request line the scraper sent; its content is irrelevant
+  char request[1024];
+  recv(conn_fd, request, sizeof(request), 0);
+
+  std::string body;
+  auto snapshot =
+      stats::StatsAggregator::GetInstance().GetExportSnapshot();
+  if (snapshot != nullptr) {
+    body = *snapshot;
+  }
+
+  std::string response =
+      "HTTP/1.0 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " +
+      std::to_string(body.size()) + "\r\n\r\n" + body;
+
+  size_t written = 0;
+  while (written < response.size()) {
+    ssize_t ret = send(conn_fd, response.data() + written,
+                       response.size() - written, 0);
+    if (ret <= 0) {
+      LOG_ERROR("Failed to write metrics export response");
+      break;
+    }
+    written += ret;
+  }
+  close(conn_fd);
+}
+
+}  // namespace network
+}  // namespace peloton
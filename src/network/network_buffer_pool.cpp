@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// network_buffer_pool.cpp
+//
+// Identification: src/network/network_buffer_pool.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "network/network_buffer_pool.h"
+
+namespace peloton {
+namespace network {
+
+const size_t NetworkBufferPool::kSmallBufferSize;
+const size_t NetworkBufferPool::kMediumBufferSize;
+const size_t NetworkBufferPool::kLargeBufferSize;
+
+NetworkBufferPool::NetworkBufferPool() {
+  // Every connection holds two small buffers, so the small tier is never
+  // capped and retains generously. The large tiers are bounded: 512 medium
+  // (32 MB) and 64 large (64 MB) buffers in flight at most, so concurrent
+  // result bursts degrade to smaller windows instead of growing the heap.
+  tiers_.emplace_back(kSmallBufferSize, 0, 4096);
+  tiers_.emplace_back(kMediumBufferSize, 512, 256);
+  tiers_.emplace_back(kLargeBufferSize, 64, 32);
+}
+
+NetworkBufferPool &NetworkBufferPool::GetInstance() {
+  static NetworkBufferPool pool;
+  return pool;
+}
+
+std::shared_ptr<Buffer> NetworkBufferPool::BorrowBuffer(size_t min_capacity) {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+
+  // find the smallest tier that fits the request; requests beyond the
+  // largest tier are served from it and the caller flushes in windows
+  size_t tier_itr = tiers_.size() - 1;
+  for (size_t itr = 0; itr < tiers_.size(); itr++) {
+    if (tiers_[itr].buffer_size >= min_capacity) {
+      tier_itr = itr;
+      break;
+    }
+  }
+
+  // back off to smaller tiers when the requested one is fully lent out
+  for (;; tier_itr--) {
+    Tier &tier = tiers_[tier_itr];
+    if (tier.max_outstanding == 0 ||
+        tier.outstanding_count < tier.max_outstanding) {
+      tier.outstanding_count++;
+      if (tier.free_buffers.empty() == false) {
+        std::shared_ptr<Buffer> buffer = std::move(tier.free_buffers.back());
+        tier.free_buffers.pop_back();
+        return buffer;
+      }
+      return std::make_shared<Buffer>(tier.buffer_size);
+    }
+    PL_ASSERT(tier_itr > 0);
+  }
+}
+
+void NetworkBufferPool::ReturnBuffer(std::shared_ptr<Buffer> buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  buffer->Reset();
+
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  for (auto &tier : tiers_) {
+    if (tier.buffer_size == buffer->GetMaxSize()) {
+      if (tier.outstanding_count > 0) {
+        tier.outstanding_count--;
+      }
+      if (tier.free_buffers.size() < tier.max_pooled) {
+        tier.free_buffers.emplace_back(std::move(buffer));
+      }
+      return;
+    }
+  }
+  // a buffer not allocated by the pool is simply dropped
+}
+
+}  // namespace network
+}  // namespace peloton
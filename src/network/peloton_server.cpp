@@ -253,6 +253,17 @@ PelotonServer &PelotonServer::SetupServer() {
   dispatcher_task_ = std::make_shared<ConnectionDispatcherTask>(
       CONNECTION_THREAD_COUNT, listen_fd_);
 
+  // Spin up the metrics export endpoint on its own thread so that scrapes
+  // never compete with connection handling
+  if (settings::SettingsManager::GetBool(settings::SettingId::metrics_export)) {
+    metrics_export_task_ = std::make_shared<MetricsExportTask>(
+        CONNECTION_THREAD_COUNT + 1,
+        settings::SettingsManager::GetInt(
+            settings::SettingId::metrics_export_port));
+    metrics_export_thread_ =
+        std::thread([this] { metrics_export_task_->EventLoop(); });
+  }
+
   LOG_INFO("Listening on port %llu", (unsigned long long)port_);
   return *this;
 }
@@ -271,6 +282,11 @@ void PelotonServer::ServerLoop() {
 
 void PelotonServer::Close() {
   LOG_INFO("Begin to stop server");
+  if (metrics_export_task_ != nullptr) {
+    metrics_export_task_->ExitLoop();
+    metrics_export_thread_.join();
+    metrics_export_task_.reset();
+  }
   dispatcher_task_->ExitLoop();
 }
 
@@ -99,7 +99,7 @@ void PostgresProtocolHandler::PutTupleDescriptor(
   pkt->msg_type = NetworkMessageType::ROW_DESCRIPTION;
   PacketPutInt(pkt.get(), tuple_descriptor.size(), 2);
 
-  for (auto col : tuple_descriptor) {
+  for (const auto &col : tuple_descriptor) {
     PacketPutStringWithTerminator(pkt.get(), std::get<0>(col));
     // TODO: Table Oid (int32)
     PacketPutInt(pkt.get(), 0, 4);
@@ -127,9 +127,19 @@ void PostgresProtocolHandler::SendDataRows(std::vector<ResultValue> &results,
   for (size_t i = 0; i < numrows; i++) {
     std::unique_ptr<OutputPacket> pkt(new OutputPacket());
     pkt->msg_type = NetworkMessageType::DATA_ROW;
+
+    // Size the packet buffer up front (column count plus a 4-byte length
+    // prefix and the payload per field), so the field values are copied
+    // exactly once, straight into their final position
+    size_t row_size = 2;
+    for (int j = 0; j < colcount; j++) {
+      row_size += 4 + results[i * colcount + j].size();
+    }
+    PacketReserveBytes(pkt.get(), row_size);
+
     PacketPutInt(pkt.get(), colcount, 2);
     for (int j = 0; j < colcount; j++) {
-      auto content = results[i * colcount + j];
+      const auto &content = results[i * colcount + j];
       if (content.size() == 0) {
         // content is NULL
         PacketPutInt(pkt.get(), NULL_CONTENT_SIZE, 4);
@@ -673,7 +683,6 @@ size_t PostgresProtocolHandler::ReadParamValue(
     std::vector<std::pair<type::TypeId, std::string>> &bind_parameters,
     std::vector<type::Value> &param_values, std::vector<int16_t> &formats) {
   auto begin = pkt->ptr;
-  ByteBuf param;
   for (int param_idx = 0; param_idx < num_params; param_idx++) {
     int param_len = PacketGetInt(pkt, 4);
     // BIND packet NULL parameter case
@@ -686,11 +695,13 @@ size_t PostgresProtocolHandler::ReadParamValue(
       param_values[param_idx] =
           type::ValueFactory::GetNullValueByType(peloton_type);
     } else {
-      PacketGetBytes(pkt, param_len, param);
+      // Decode the value in place from the packet; the only copy made is
+      // the one into the destination string or Value
+      auto param = PacketGetBytesView(pkt, param_len);
 
       if (formats[param_idx] == 0) {
         // TEXT mode
-        std::string param_str = std::string(std::begin(param), std::end(param));
+        std::string param_str = std::string(param, param + param_len);
         bind_parameters[param_idx] =
             std::make_pair(type::TypeId::VARCHAR, param_str);
         if ((unsigned int)param_idx >= param_types.size() ||
@@ -772,7 +783,8 @@ size_t PostgresProtocolHandler::ReadParamValue(
           case PostgresValueType::VARBINARY: {
             bind_parameters[param_idx] = std::make_pair(
                 type::TypeId::VARBINARY,
-                std::string(reinterpret_cast<char *>(&param[0]), param_len));
+                std::string(reinterpret_cast<const char *>(&param[0]),
+                            param_len));
             param_values[param_idx] = type::ValueFactory::GetVarbinaryValue(
                 &param[0], param_len, true);
             break;
@@ -802,11 +814,11 @@ ProcessResult PostgresProtocolHandler::ExecDescribeMessage(InputPacket *pkt) {
     return ProcessResult::COMPLETE;
   }
 
-  ByteBuf mode;
+  uchar mode = 0;
   std::string portal_name;
-  PacketGetBytes(pkt, 1, mode);
+  PacketGetByte(pkt, mode);
   GetStringToken(pkt, portal_name);
-  if (mode[0] == 'P') {
+  if (mode == 'P') {
     LOG_TRACE("Describe a portal");
     auto portal_itr = portals_.find(portal_name);
 
@@ -978,6 +990,26 @@ void PostgresProtocolHandler::ExecCloseMessage(InputPacket *pkt) {
 // The function tries to do a preliminary read to fetch the size value and
 // then reads the rest of the packet.
 // Assume: Packet length field is always 32-bit int
+bool PostgresProtocolHandler::HasCompletePacket(Buffer &rbuf) {
+  if (request.header_parsed) {
+    // header already consumed; is the rest of the body buffered?
+    if (request.is_extended) {
+      return rbuf.buf_size - rbuf.buf_ptr >= request.ExtendedBytesRequired();
+    }
+    return rbuf.IsReadDataAvailable(request.len);
+  }
+  // peek at the header: 1 type byte plus a 4-byte length counting itself
+  if (rbuf.IsReadDataAvailable(sizeof(int32_t) + 1) == false) {
+    return false;
+  }
+  size_t len = 0;
+  for (size_t i = 1; i <= sizeof(uint32_t); i++) {
+    size_t index = rbuf.buf_ptr + i;
+    len = (len << 8) | rbuf.GetByte(index);
+  }
+  return rbuf.IsReadDataAvailable(len + 1);
+}
+
 bool PostgresProtocolHandler::ReadPacketHeader(Buffer &rbuf,
                                                InputPacket &rpkt) {
   // All packets other than the startup packet have a 5 bytes header
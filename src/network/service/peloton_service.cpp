@@ -16,6 +16,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "executor/plan_executor.h"
+#include "logging/logical_log_manager.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/tile.h"
 #include "storage/tuple.h"
@@ -178,7 +179,7 @@ void PelotonService::TransactionDebug(
 }
 
 void PelotonService::SendData(::google::protobuf::RpcController *controller,
-                              UNUSED_ATTRIBUTE const SendDataRequest *request,
+                              const SendDataRequest *request,
                               UNUSED_ATTRIBUTE SendDataResponse *response,
                               ::google::protobuf::Closure *done) {
   if (controller->Failed()) {
@@ -186,6 +187,17 @@ void PelotonService::SendData(::google::protobuf::RpcController *controller,
     LOG_TRACE("PelotonService with controller failed:%s ", error.c_str());
   }
 
+  // Log-shipping entry point for read replicas: each attached blob is one
+  // durable group-commit batch from the leader, applied in arrival order
+  // through the logical replay path.
+  if (request != nullptr) {
+    auto &log_manager = logging::LogicalLogManager::GetInstance();
+    for (int data_itr = 0; data_itr < request->data_size(); data_itr++) {
+      const std::string &batch = request->data(data_itr);
+      log_manager.ApplyShippedBatch(batch.data(), batch.size());
+    }
+  }
+
   // if callback exist, run it
   if (done) {
     done->Run();
@@ -54,21 +54,29 @@ void ChildPropertyDeriver::Visit(const PhysicalIndexScan *op) {
   for (auto prop : requirements_->Properties()) {
     if (prop->Type() == PropertyType::SORT) {
       // Walk through all indices in the table, check if any of the index could
-      // provide the sort property
-      // TODO(boweic) : Now we only consider ascending sort property, since the
-      // index catalog interface does not support descending flag
+      // provide the sort property.
+      // Indexes are always built ascending (the index catalog has no
+      // direction flag), but walking the leaf chain backward serves a
+      // uniformly descending requirement, so either uniform direction can
+      // be fulfilled. Mixed directions would need a sort
       auto sort_prop = prop->As<PropertySort>();
       auto sort_col_size = sort_prop->GetSortColumnSize();
+      auto all_ascending = true;
+      auto all_descending = true;
       auto can_fulfill = true;
       for (size_t idx = 0; idx < sort_col_size; ++idx) {
-        if (!sort_prop->GetSortAscending(idx) ||
-            sort_prop->GetSortColumn(idx)->GetExpressionType() !=
-                ExpressionType::VALUE_TUPLE) {
+        if (sort_prop->GetSortAscending(idx)) {
+          all_descending = false;
+        } else {
+          all_ascending = false;
+        }
+        if (sort_prop->GetSortColumn(idx)->GetExpressionType() !=
+            ExpressionType::VALUE_TUPLE) {
           can_fulfill = false;
           break;
         }
       }
-      if (!can_fulfill) break;
+      if (!can_fulfill || !(all_ascending || all_descending)) break;
       for (auto &index : target_table->GetIndexObjects()) {
         auto key_oids = index.second->GetKeyAttrs();
         // If the sort column size is larger, then can't be fulfill by the index
@@ -154,6 +162,33 @@ void ChildPropertyDeriver::Visit(const PhysicalInnerHashJoin *) {
   DeriveForJoin();
 }
 
+void ChildPropertyDeriver::Visit(const PhysicalInnerMergeJoin *op) {
+  // Both inputs must arrive sorted on the join keys. An ordered index scan
+  // provides the property for free, otherwise the property enforcer places
+  // a sort on top of the child, which costing then has to pay for
+  vector<expression::AbstractExpression *> left_cols;
+  vector<expression::AbstractExpression *> right_cols;
+  for (auto &key : op->left_keys) left_cols.push_back(key.get());
+  for (auto &key : op->right_keys) right_cols.push_back(key.get());
+  shared_ptr<Property> left_sort(
+      new PropertySort(left_cols, vector<bool>(left_cols.size(), true)));
+  shared_ptr<Property> right_sort(
+      new PropertySort(right_cols, vector<bool>(right_cols.size(), true)));
+  output_.push_back(make_pair(
+      make_shared<PropertySet>(),
+      vector<shared_ptr<PropertySet>>{
+          make_shared<PropertySet>(vector<shared_ptr<Property>>{left_sort}),
+          make_shared<PropertySet>(vector<shared_ptr<Property>>{right_sort})}));
+}
+
+void ChildPropertyDeriver::Visit(const PhysicalSemiHashJoin *) {
+  DeriveForJoin();
+}
+
+void ChildPropertyDeriver::Visit(const PhysicalAntiHashJoin *) {
+  DeriveForJoin();
+}
+
 void ChildPropertyDeriver::Visit(const PhysicalLeftHashJoin *) {}
 void ChildPropertyDeriver::Visit(const PhysicalRightHashJoin *) {}
 void ChildPropertyDeriver::Visit(const PhysicalOuterHashJoin *) {}
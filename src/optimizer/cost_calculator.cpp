@@ -14,6 +14,7 @@
 
 #include <cmath>
 
+#include "catalog/index_catalog.h"
 #include "catalog/table_catalog.h"
 #include "optimizer/memo.h"
 #include "optimizer/operators.h"
@@ -52,8 +53,29 @@ void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalIndexScan *op) {
     output_cost_ = 0.f;
     return;
   }
+  // Index search cost
+  double index_search_cost =
+      std::log2(table_stats->num_rows) * DEFAULT_INDEX_TUPLE_COST;
+  // ART descends a radix trie whose depth is bounded by the key length, not
+  // the table size, so cost its point lookups independently of num_rows to
+  // let it win over comparison-based indexes on point-heavy predicates
+  auto index_object = op->table_->GetIndexObject(op->index_id, true);
+  if (index_object != nullptr &&
+      index_object->GetIndexType() == IndexType::ART &&
+      op->expr_type_list.empty() == false) {
+    bool all_equalities = true;
+    for (auto expr_type : op->expr_type_list) {
+      if (expr_type != ExpressionType::COMPARE_EQUAL) {
+        all_equalities = false;
+        break;
+      }
+    }
+    if (all_equalities) {
+      index_search_cost = DEFAULT_INDEX_TUPLE_COST;
+    }
+  }
   // Index search cost + scan cost
-  output_cost_ = std::log2(table_stats->num_rows) * DEFAULT_INDEX_TUPLE_COST +
+  output_cost_ = index_search_cost +
                  memo_->GetGroupByID(gexpr_->GetGroupID())->GetNumRows() *
                      DEFAULT_TUPLE_COST;
 }
@@ -86,9 +108,39 @@ void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalInnerHashJoin *op) {
       memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
   auto right_child_rows =
       memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows();
-  // TODO(boweic): Build (left) table should have different cost to probe table
+  // The build (left) side is materialized into the hash table while the probe
+  // side only streams past it, so charge build rows at the higher build rate.
+  // With histogram-backed cardinalities below the estimates this steers the
+  // search away from plans with over-sized build sides.
+  output_cost_ = left_child_rows * DEFAULT_BUILD_TUPLE_COST +
+                 right_child_rows * DEFAULT_TUPLE_COST;
+}
+void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalInnerMergeJoin *op) {
+  auto left_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+  auto right_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows();
+  // Both inputs stream past each other exactly once and nothing is
+  // materialized; the price of producing them in key order is paid by the
+  // children, either by an ordered index scan or by an enforced sort
   output_cost_ = (left_child_rows + right_child_rows) * DEFAULT_TUPLE_COST;
 }
+void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalSemiHashJoin *op) {
+  auto left_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+  auto right_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows();
+  output_cost_ = left_child_rows * DEFAULT_BUILD_TUPLE_COST +
+                 right_child_rows * DEFAULT_TUPLE_COST;
+}
+void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalAntiHashJoin *op) {
+  auto left_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(0))->GetNumRows();
+  auto right_child_rows =
+      memo_->GetGroupByID(gexpr_->GetChildGroupId(1))->GetNumRows();
+  output_cost_ = left_child_rows * DEFAULT_BUILD_TUPLE_COST +
+                 right_child_rows * DEFAULT_TUPLE_COST;
+}
 void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalLeftHashJoin *op) {}
 void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalRightHashJoin *op) {}
 void CostCalculator::Visit(UNUSED_ATTRIBUTE const PhysicalOuterHashJoin *op) {}
@@ -23,18 +23,21 @@ namespace optimizer {
 Group::Group(GroupID id, std::unordered_set<std::string> table_aliases)
     : id_(id), table_aliases_(std::move(table_aliases)) {
   has_explored_ = false;
+  has_implemented_ = false;
 }
 
 void Group::AddExpression(std::shared_ptr<GroupExpression> expr,
                           bool enforced) {
   // Do duplicate detection
   expr->SetGroupID(id_);
+  latch_.Lock();
   if (enforced)
     enforced_exprs_.push_back(expr);
   else if (expr->Op().IsPhysical())
     physical_expressions_.push_back(expr);
   else
     logical_expressions_.push_back(expr);
+  latch_.Unlock();
 }
 
 bool Group::SetExpressionCost(GroupExpression *expr, double cost,
@@ -95,11 +95,16 @@ bool GroupExpression::operator==(const GroupExpression &r) {
 }
 
 void GroupExpression::SetRuleExplored(Rule *rule) {
+  rule_mask_latch_.Lock();
   rule_mask_.set(rule->GetRuleIdx()) = true;
+  rule_mask_latch_.Unlock();
 }
 
 bool GroupExpression::HasRuleExplored(Rule *rule) {
-  return rule_mask_.test(rule->GetRuleIdx());
+  rule_mask_latch_.Lock();
+  bool explored = rule_mask_.test(rule->GetRuleIdx());
+  rule_mask_latch_.Unlock();
+  return explored;
 }
 
 }  // namespace optimizer
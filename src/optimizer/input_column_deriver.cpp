@@ -137,6 +137,18 @@ void InputColumnDeriver::Visit(const PhysicalInnerHashJoin *op) {
   JoinHelper(op);
 }
 
+void InputColumnDeriver::Visit(const PhysicalInnerMergeJoin *op) {
+  JoinHelper(op);
+}
+
+void InputColumnDeriver::Visit(const PhysicalSemiHashJoin *op) {
+  JoinHelper(op);
+}
+
+void InputColumnDeriver::Visit(const PhysicalAntiHashJoin *op) {
+  JoinHelper(op);
+}
+
 void InputColumnDeriver::Visit(const PhysicalLeftHashJoin *) {}
 
 void InputColumnDeriver::Visit(const PhysicalRightHashJoin *) {}
@@ -235,6 +247,21 @@ void InputColumnDeriver::JoinHelper(const BaseOperatorNode *op) {
     join_conds = &(join_op->join_predicates);
     left_keys = &(join_op->left_keys);
     right_keys = &(join_op->right_keys);
+  } else if (op->type() == OpType::InnerMergeJoin) {
+    auto join_op = reinterpret_cast<const PhysicalInnerMergeJoin *>(op);
+    join_conds = &(join_op->join_predicates);
+    left_keys = &(join_op->left_keys);
+    right_keys = &(join_op->right_keys);
+  } else if (op->type() == OpType::SemiHashJoin) {
+    auto join_op = reinterpret_cast<const PhysicalSemiHashJoin *>(op);
+    join_conds = &(join_op->join_predicates);
+    left_keys = &(join_op->left_keys);
+    right_keys = &(join_op->right_keys);
+  } else if (op->type() == OpType::AntiHashJoin) {
+    auto join_op = reinterpret_cast<const PhysicalAntiHashJoin *>(op);
+    join_conds = &(join_op->join_predicates);
+    left_keys = &(join_op->left_keys);
+    right_keys = &(join_op->right_keys);
   } else if (op->type() == OpType::InnerNLJoin) {
     auto join_op = reinterpret_cast<const PhysicalInnerNLJoin *>(op);
     join_conds = &(join_op->join_predicates);
@@ -0,0 +1,235 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_order_enumerator.cpp
+//
+// Identification: src/optimizer/join_order_enumerator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/join_order_enumerator.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "catalog/table_catalog.h"
+#include "common/logger.h"
+#include "expression/abstract_expression.h"
+#include "optimizer/operators.h"
+#include "optimizer/stats/stats_storage.h"
+#include "optimizer/stats/table_stats.h"
+#include "settings/settings_manager.h"
+
+namespace peloton {
+namespace optimizer {
+
+namespace {
+// Cardinality assumed for tables without collected statistics
+const double kDefaultTableCardinality = 1000.0;
+// Selectivity assumed for non-equality join predicates
+const double kDefaultJoinSelectivity = 0.1;
+
+int PopCount(uint64_t set) { return __builtin_popcountll(set); }
+}  // namespace
+
+std::shared_ptr<OperatorExpression> JoinOrderEnumerator::Enumerate(
+    std::shared_ptr<OperatorExpression> root) {
+  if (root == nullptr) return root;
+
+  if (root->Op().type() == OpType::InnerJoin) {
+    std::vector<std::shared_ptr<OperatorExpression>> leaves;
+    std::vector<AnnotatedExpression> predicates;
+    if (CollectJoinBlock(root, leaves, predicates)) {
+      size_t min_relations = static_cast<size_t>(
+          settings::SettingsManager::GetInt(
+              settings::SettingId::optimizer_dp_join_threshold));
+      if (leaves.size() >= min_relations && leaves.size() <= kMaxRelations) {
+        auto reordered = BuildJoinTree(leaves, predicates);
+        if (reordered != nullptr) {
+          LOG_TRACE("DP enumerator reordered a %lu-way join block",
+                    leaves.size());
+          return reordered;
+        }
+      }
+    }
+  }
+
+  // Not an eligible block at this node: recurse so that join blocks nested
+  // under projections, filters or derived tables are still reordered
+  auto copy = std::make_shared<OperatorExpression>(root->Op());
+  for (auto &child : root->Children()) {
+    copy->PushChild(Enumerate(child));
+  }
+  return copy;
+}
+
+bool JoinOrderEnumerator::CollectJoinBlock(
+    const std::shared_ptr<OperatorExpression> &node,
+    std::vector<std::shared_ptr<OperatorExpression>> &leaves,
+    std::vector<AnnotatedExpression> &predicates) {
+  if (node->Op().type() == OpType::InnerJoin) {
+    const auto *join = node->Op().As<LogicalInnerJoin>();
+    predicates.insert(predicates.end(), join->join_predicates.begin(),
+                      join->join_predicates.end());
+    for (auto &child : node->Children()) {
+      if (!CollectJoinBlock(child, leaves, predicates)) return false;
+    }
+    return true;
+  }
+  if (node->Op().type() == OpType::Get) {
+    const auto *get = node->Op().As<LogicalGet>();
+    // The alias identifies the relation in predicate alias sets; without
+    // one the predicates cannot be mapped onto the block
+    if (get->table_alias.empty()) return false;
+    leaves.push_back(node);
+    return true;
+  }
+  return false;
+}
+
+double JoinOrderEnumerator::EstimateLeafCardinality(
+    const std::shared_ptr<OperatorExpression> &leaf) {
+  const auto *get = leaf->Op().As<LogicalGet>();
+  if (get->table != nullptr) {
+    auto table_stats = StatsStorage::GetInstance()->GetTableStats(
+        get->table->GetDatabaseOid(), get->table->GetTableOid());
+    if (table_stats != nullptr && table_stats->num_rows > 0) {
+      return static_cast<double>(table_stats->num_rows);
+    }
+  }
+  return kDefaultTableCardinality;
+}
+
+std::shared_ptr<OperatorExpression> JoinOrderEnumerator::BuildJoinTree(
+    const std::vector<std::shared_ptr<OperatorExpression>> &leaves,
+    const std::vector<AnnotatedExpression> &predicates) {
+  size_t num_relations = leaves.size();
+  std::unordered_map<std::string, size_t> alias_to_idx;
+  std::vector<double> base_cardinalities(num_relations);
+  for (size_t i = 0; i < num_relations; i++) {
+    const auto *get = leaves[i]->Op().As<LogicalGet>();
+    // Self joins produce duplicate aliases only if binding failed; bail
+    if (!alias_to_idx.emplace(get->table_alias, i).second) return nullptr;
+    base_cardinalities[i] = EstimateLeafCardinality(leaves[i]);
+  }
+
+  // Map every predicate onto the set of relations it references and
+  // estimate its selectivity. Predicates referencing anything outside the
+  // block (e.g. a correlated outer column) make the block ineligible
+  struct PredicateInfo {
+    RelSet relations;
+    double selectivity;
+  };
+  std::vector<PredicateInfo> predicate_infos;
+  for (auto &predicate : predicates) {
+    PredicateInfo info{0, kDefaultJoinSelectivity};
+    double max_cardinality = 1.0;
+    for (auto &alias : predicate.table_alias_set) {
+      auto it = alias_to_idx.find(alias);
+      if (it == alias_to_idx.end()) return nullptr;
+      info.relations |= static_cast<RelSet>(1) << it->second;
+      max_cardinality =
+          std::max(max_cardinality, base_cardinalities[it->second]);
+    }
+    // Equi-joins reduce the cross product to roughly the larger input
+    if (predicate.expr != nullptr &&
+        predicate.expr->GetExpressionType() == ExpressionType::COMPARE_EQUAL &&
+        PopCount(info.relations) == 2) {
+      info.selectivity = 1.0 / max_cardinality;
+    }
+    predicate_infos.push_back(info);
+  }
+
+  RelSet full_set = (static_cast<RelSet>(1) << num_relations) - 1;
+  std::unordered_map<RelSet, SubPlan> dp;
+  // Predicates each sub-plan has absorbed into its join conditions
+  std::unordered_map<RelSet, std::vector<size_t>> applied;
+  for (size_t i = 0; i < num_relations; i++) {
+    RelSet single = static_cast<RelSet>(1) << i;
+    dp[single] = SubPlan{leaves[i], base_cardinalities[i], 0.0};
+    applied[single] = {};
+  }
+
+  // DPsub: enumerating set values in increasing order visits every subset
+  // before any of its supersets, so both halves of a split are always ready
+  for (RelSet set = 1; set <= full_set; set++) {
+    if (PopCount(set) < 2) continue;
+    for (RelSet left = (set - 1) & set; left > 0; left = (left - 1) & set) {
+      RelSet right = set & ~left;
+      auto left_it = dp.find(left);
+      auto right_it = dp.find(right);
+      if (left_it == dp.end() || right_it == dp.end()) continue;
+
+      // Only consider splits connected by a join predicate; unconnected
+      // splits would introduce a cross product the original query avoided
+      bool connected = false;
+      double selectivity = 1.0;
+      std::vector<size_t> new_predicates;
+      for (size_t pred_idx = 0; pred_idx < predicate_infos.size();
+           pred_idx++) {
+        auto &info = predicate_infos[pred_idx];
+        if ((info.relations & set) != info.relations) continue;
+        if ((info.relations & left) == info.relations) continue;
+        if ((info.relations & right) == info.relations) continue;
+        connected |= (info.relations & left) != 0 &&
+                     (info.relations & right) != 0;
+        selectivity *= info.selectivity;
+        new_predicates.push_back(pred_idx);
+      }
+      if (!connected) continue;
+
+      double cardinality = left_it->second.cardinality *
+                           right_it->second.cardinality * selectivity;
+      // C_out: charge every intermediate result once, so cheap plans are
+      // the ones with small intermediates
+      double cost =
+          left_it->second.cost + right_it->second.cost + cardinality;
+      auto existing = dp.find(set);
+      if (existing != dp.end() && existing->second.cost <= cost) continue;
+
+      std::vector<AnnotatedExpression> conditions;
+      for (auto pred_idx : new_predicates)
+        conditions.push_back(predicates[pred_idx]);
+      auto join_expr = std::make_shared<OperatorExpression>(
+          LogicalInnerJoin::make(conditions));
+      join_expr->PushChild(left_it->second.expr);
+      join_expr->PushChild(right_it->second.expr);
+      dp[set] = SubPlan{join_expr, cardinality, cost};
+      auto &applied_set = applied[set];
+      applied_set = applied[left];
+      applied_set.insert(applied_set.end(), applied[right].begin(),
+                         applied[right].end());
+      applied_set.insert(applied_set.end(), new_predicates.begin(),
+                         new_predicates.end());
+    }
+  }
+
+  auto best = dp.find(full_set);
+  if (best == dp.end()) return nullptr;
+
+  // Predicates no join absorbed (e.g. referencing a single relation) must
+  // not be lost: fold them into the root join's condition list
+  std::unordered_set<size_t> applied_predicates(applied[full_set].begin(),
+                                                applied[full_set].end());
+  std::vector<AnnotatedExpression> leftover;
+  for (size_t pred_idx = 0; pred_idx < predicates.size(); pred_idx++) {
+    if (applied_predicates.count(pred_idx) == 0)
+      leftover.push_back(predicates[pred_idx]);
+  }
+  if (leftover.empty()) return best->second.expr;
+
+  const auto *root_join = best->second.expr->Op().As<LogicalInnerJoin>();
+  std::vector<AnnotatedExpression> root_conditions = root_join->join_predicates;
+  root_conditions.insert(root_conditions.end(), leftover.begin(),
+                         leftover.end());
+  auto new_root =
+      std::make_shared<OperatorExpression>(LogicalInnerJoin::make(root_conditions));
+  for (auto &child : best->second.expr->Children()) new_root->PushChild(child);
+  return new_root;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -39,6 +39,8 @@ GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
     return nullptr;
   }
 
+  latch_.Lock();
+
   // Lookup in hash table
   auto it = group_expressions_.find(gexpr.get());
 
@@ -46,6 +48,7 @@ GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
     assert(target_group == UNDEFINED_GROUP ||
            target_group == (*it)->GetGroupID());
     gexpr->SetGroupID((*it)->GetGroupID());
+    latch_.Unlock();
     return *it;
   } else {
     group_expressions_.insert(gexpr.get());
@@ -57,8 +60,9 @@ GroupExpression *Memo::InsertExpression(std::shared_ptr<GroupExpression> gexpr,
     } else {
       group_id = target_group;
     }
-    Group *group = GetGroupByID(group_id);
+    Group *group = groups_[group_id].get();
     group->AddExpression(gexpr, enforced);
+    latch_.Unlock();
     return gexpr.get();
   }
 }
@@ -67,7 +71,13 @@ const std::vector<std::unique_ptr<Group>> &Memo::Groups() const {
   return groups_;
 }
 
-Group *Memo::GetGroupByID(GroupID id) { return groups_[id].get(); }
+Group *Memo::GetGroupByID(GroupID id) {
+  // Take the latch in case another worker is growing the group table
+  latch_.Lock();
+  Group *group = groups_[id].get();
+  latch_.Unlock();
+  return group;
+}
 
 GroupID Memo::AddNewGroup(std::shared_ptr<GroupExpression> gexpr) {
   GroupID new_group_id = groups_.size();
@@ -85,7 +95,8 @@ GroupID Memo::AddNewGroup(std::shared_ptr<GroupExpression> gexpr) {
   } else {
     // For other groups, need to aggregate the table alias from children
     for (auto child_group_id : gexpr->GetChildGroupIDs()) {
-      Group *child_group = GetGroupByID(child_group_id);
+      // Called with the latch held from InsertExpression, so index directly
+      Group *child_group = groups_[child_group_id].get();
       for (auto &table_alias : child_group->GetTableAliases()) {
         table_aliases.insert(table_alias);
       }
@@ -164,9 +164,10 @@ bool LogicalDependentJoin::operator==(const BaseOperatorNode &r) {
 //===--------------------------------------------------------------------===//
 // MarkJoin
 //===--------------------------------------------------------------------===//
-Operator LogicalMarkJoin::make() {
+Operator LogicalMarkJoin::make(bool anti_join) {
   LogicalMarkJoin *join = new LogicalMarkJoin;
   join->join_predicates = {};
+  join->anti_join = anti_join;
   return Operator(join);
 }
 
@@ -178,6 +179,7 @@ Operator LogicalMarkJoin::make(std::vector<AnnotatedExpression> &conditions) {
 
 hash_t LogicalMarkJoin::Hash() const {
   hash_t hash = BaseOperatorNode::Hash();
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&anti_join));
   for (auto &pred : join_predicates)
     hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
   return hash;
@@ -186,6 +188,7 @@ hash_t LogicalMarkJoin::Hash() const {
 bool LogicalMarkJoin::operator==(const BaseOperatorNode &r) {
   if (r.type() != OpType::LogicalMarkJoin) return false;
   const LogicalMarkJoin &node = *static_cast<const LogicalMarkJoin *>(&r);
+  if (anti_join != node.anti_join) return false;
   if (join_predicates.size() != node.join_predicates.size()) return false;
   for (size_t i = 0; i < join_predicates.size(); i++) {
     if (!join_predicates[i].expr->ExactlyEquals(*node.join_predicates[i].expr.get()))
@@ -292,15 +295,71 @@ Operator LogicalOuterJoin::make(expression::AbstractExpression *condition) {
 }
 
 //===--------------------------------------------------------------------===//
-// OuterJoin
+// SemiJoin
 //===--------------------------------------------------------------------===//
-Operator LogicalSemiJoin::make(expression::AbstractExpression *condition) {
+Operator LogicalSemiJoin::make() {
   LogicalSemiJoin *join = new LogicalSemiJoin;
-  join->join_predicate =
-      std::shared_ptr<expression::AbstractExpression>(condition);
+  join->join_predicates = {};
   return Operator(join);
 }
 
+Operator LogicalSemiJoin::make(std::vector<AnnotatedExpression> &conditions) {
+  LogicalSemiJoin *join = new LogicalSemiJoin;
+  join->join_predicates = std::move(conditions);
+  return Operator(join);
+}
+
+hash_t LogicalSemiJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  for (auto &pred : join_predicates)
+    hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
+  return hash;
+}
+
+bool LogicalSemiJoin::operator==(const BaseOperatorNode &r) {
+  if (r.type() != OpType::SemiJoin) return false;
+  const LogicalSemiJoin &node = *static_cast<const LogicalSemiJoin *>(&r);
+  if (join_predicates.size() != node.join_predicates.size()) return false;
+  for (size_t i = 0; i < join_predicates.size(); i++) {
+    if (!join_predicates[i].expr->ExactlyEquals(*node.join_predicates[i].expr.get()))
+      return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// AntiJoin
+//===--------------------------------------------------------------------===//
+Operator LogicalAntiJoin::make() {
+  LogicalAntiJoin *join = new LogicalAntiJoin;
+  join->join_predicates = {};
+  return Operator(join);
+}
+
+Operator LogicalAntiJoin::make(std::vector<AnnotatedExpression> &conditions) {
+  LogicalAntiJoin *join = new LogicalAntiJoin;
+  join->join_predicates = std::move(conditions);
+  return Operator(join);
+}
+
+hash_t LogicalAntiJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  for (auto &pred : join_predicates)
+    hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
+  return hash;
+}
+
+bool LogicalAntiJoin::operator==(const BaseOperatorNode &r) {
+  if (r.type() != OpType::AntiJoin) return false;
+  const LogicalAntiJoin &node = *static_cast<const LogicalAntiJoin *>(&r);
+  if (join_predicates.size() != node.join_predicates.size()) return false;
+  for (size_t i = 0; i < join_predicates.size(); i++) {
+    if (!join_predicates[i].expr->ExactlyEquals(*node.join_predicates[i].expr.get()))
+      return false;
+  }
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Aggregate
 //===--------------------------------------------------------------------===//
@@ -667,6 +726,147 @@ bool PhysicalInnerHashJoin::operator==(const BaseOperatorNode &r) {
   return true;
 }
 
+//===--------------------------------------------------------------------===//
+// SemiHashJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalSemiHashJoin::make(
+    std::vector<AnnotatedExpression> conditions,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& left_keys,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& right_keys) {
+  PhysicalSemiHashJoin *join = new PhysicalSemiHashJoin();
+  join->join_predicates = std::move(conditions);
+  join->left_keys = std::move(left_keys);
+  join->right_keys = std::move(right_keys);
+  return Operator(join);
+}
+
+hash_t PhysicalSemiHashJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  for (auto &expr : left_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates)
+    hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
+  return hash;
+}
+
+bool PhysicalSemiHashJoin::operator==(const BaseOperatorNode &r) {
+  if (r.type() != OpType::SemiHashJoin) return false;
+  const PhysicalSemiHashJoin &node =
+      *static_cast<const PhysicalSemiHashJoin *>(&r);
+  if (join_predicates.size() != node.join_predicates.size() ||
+      left_keys.size() != node.left_keys.size() ||
+      right_keys.size() != node.right_keys.size())
+    return false;
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (!left_keys[i]->ExactlyEquals(*node.left_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < right_keys.size(); i++) {
+    if (!right_keys[i]->ExactlyEquals(*node.right_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < join_predicates.size(); i++) {
+    if (!join_predicates[i].expr->
+        ExactlyEquals(*node.join_predicates[i].expr.get()))
+      return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// AntiHashJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalAntiHashJoin::make(
+    std::vector<AnnotatedExpression> conditions,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& left_keys,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& right_keys) {
+  PhysicalAntiHashJoin *join = new PhysicalAntiHashJoin();
+  join->join_predicates = std::move(conditions);
+  join->left_keys = std::move(left_keys);
+  join->right_keys = std::move(right_keys);
+  return Operator(join);
+}
+
+hash_t PhysicalAntiHashJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  for (auto &expr : left_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates)
+    hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
+  return hash;
+}
+
+bool PhysicalAntiHashJoin::operator==(const BaseOperatorNode &r) {
+  if (r.type() != OpType::AntiHashJoin) return false;
+  const PhysicalAntiHashJoin &node =
+      *static_cast<const PhysicalAntiHashJoin *>(&r);
+  if (join_predicates.size() != node.join_predicates.size() ||
+      left_keys.size() != node.left_keys.size() ||
+      right_keys.size() != node.right_keys.size())
+    return false;
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (!left_keys[i]->ExactlyEquals(*node.left_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < right_keys.size(); i++) {
+    if (!right_keys[i]->ExactlyEquals(*node.right_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < join_predicates.size(); i++) {
+    if (!join_predicates[i].expr->
+        ExactlyEquals(*node.join_predicates[i].expr.get()))
+      return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// InnerMergeJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalInnerMergeJoin::make(
+    std::vector<AnnotatedExpression> conditions,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& left_keys,
+    std::vector<std::unique_ptr<expression::AbstractExpression>>& right_keys) {
+  PhysicalInnerMergeJoin *join = new PhysicalInnerMergeJoin();
+  join->join_predicates = std::move(conditions);
+  join->left_keys = std::move(left_keys);
+  join->right_keys = std::move(right_keys);
+  return Operator(join);
+}
+
+hash_t PhysicalInnerMergeJoin::Hash() const {
+  hash_t hash = BaseOperatorNode::Hash();
+  for (auto &expr : left_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &expr : right_keys)
+    hash = HashUtil::CombineHashes(hash, expr->Hash());
+  for (auto &pred : join_predicates)
+    hash = HashUtil::CombineHashes(hash, pred.expr->Hash());
+  return hash;
+}
+
+bool PhysicalInnerMergeJoin::operator==(const BaseOperatorNode &r) {
+  if (r.type() != OpType::InnerMergeJoin) return false;
+  const PhysicalInnerMergeJoin &node =
+      *static_cast<const PhysicalInnerMergeJoin *>(&r);
+  if (join_predicates.size() != node.join_predicates.size() ||
+      left_keys.size() != node.left_keys.size() ||
+      right_keys.size() != node.right_keys.size())
+    return false;
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (!left_keys[i]->ExactlyEquals(*node.left_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < right_keys.size(); i++) {
+    if (!right_keys[i]->ExactlyEquals(*node.right_keys[i].get())) return false;
+  }
+  for (size_t i = 0; i < join_predicates.size(); i++) {
+    if (!join_predicates[i].expr->
+        ExactlyEquals(*node.join_predicates[i].expr.get()))
+      return false;
+  }
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // LeftHashJoin
 //===--------------------------------------------------------------------===//
@@ -859,6 +1059,8 @@ std::string OperatorNode<LogicalOuterJoin>::name_ = "LogicalOuterJoin";
 template <>
 std::string OperatorNode<LogicalSemiJoin>::name_ = "LogicalSemiJoin";
 template <>
+std::string OperatorNode<LogicalAntiJoin>::name_ = "LogicalAntiJoin";
+template <>
 std::string OperatorNode<LogicalAggregateAndGroupBy>::name_ = "LogicalAggregateAndGroupBy";
 template <>
 std::string OperatorNode<LogicalInsert>::name_ = "LogicalInsert";
@@ -896,6 +1098,13 @@ template <>
 std::string OperatorNode<PhysicalInnerHashJoin>::name_ =
     "PhysicalInnerHashJoin";
 template <>
+std::string OperatorNode<PhysicalInnerMergeJoin>::name_ =
+    "PhysicalInnerMergeJoin";
+template <>
+std::string OperatorNode<PhysicalSemiHashJoin>::name_ = "PhysicalSemiHashJoin";
+template <>
+std::string OperatorNode<PhysicalAntiHashJoin>::name_ = "PhysicalAntiHashJoin";
+template <>
 std::string OperatorNode<PhysicalLeftHashJoin>::name_ = "PhysicalLeftHashJoin";
 template <>
 std::string OperatorNode<PhysicalRightHashJoin>::name_ =
@@ -949,6 +1158,8 @@ OpType OperatorNode<LogicalOuterJoin>::type_ = OpType::OuterJoin;
 template <>
 OpType OperatorNode<LogicalSemiJoin>::type_ = OpType::SemiJoin;
 template <>
+OpType OperatorNode<LogicalAntiJoin>::type_ = OpType::AntiJoin;
+template <>
 OpType OperatorNode<LogicalAggregateAndGroupBy>::type_ = OpType::LogicalAggregateAndGroupBy;
 template <>
 OpType OperatorNode<LogicalInsert>::type_ = OpType::LogicalInsert;
@@ -987,6 +1198,12 @@ OpType OperatorNode<PhysicalOuterNLJoin>::type_ = OpType::OuterNLJoin;
 template <>
 OpType OperatorNode<PhysicalInnerHashJoin>::type_ = OpType::InnerHashJoin;
 template <>
+OpType OperatorNode<PhysicalInnerMergeJoin>::type_ = OpType::InnerMergeJoin;
+template <>
+OpType OperatorNode<PhysicalSemiHashJoin>::type_ = OpType::SemiHashJoin;
+template <>
+OpType OperatorNode<PhysicalAntiHashJoin>::type_ = OpType::AntiHashJoin;
+template <>
 OpType OperatorNode<PhysicalLeftHashJoin>::type_ = OpType::LeftHashJoin;
 template <>
 OpType OperatorNode<PhysicalRightHashJoin>::type_ = OpType::RightHashJoin;
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <memory>
+#include <thread>
 
 #include "optimizer/optimizer.h"
 
@@ -24,12 +25,14 @@
 #include "optimizer/property_enforcer.h"
 #include "optimizer/query_to_operator_transformer.h"
 #include "optimizer/input_column_deriver.h"
+#include "optimizer/join_order_enumerator.h"
 #include "optimizer/plan_generator.h"
 #include "optimizer/rule.h"
 #include "optimizer/rule_impls.h"
 #include "optimizer/optimizer_task_pool.h"
 #include "optimizer/optimize_context.h"
 #include "parser/create_statement.h"
+#include "settings/settings_manager.h"
 
 #include "planner/analyze_plan.h"
 #include "planner/create_function_plan.h"
@@ -79,6 +82,47 @@ void Optimizer::OptimizeLoop(int root_group_id,
     task->execute();
   }
 
+  // Explore the plan space on a worker pool before the costing pass when
+  // parallel optimization is enabled. Exploration tasks only insert logical
+  // expressions, which the memo and group latches serialize; the stats
+  // derivation tasks they generate are deferred and replayed serially so
+  // that per-group statistics stay single-writer.
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::parallel_optimizer)) {
+    int num_workers = settings::SettingsManager::GetInt(
+        settings::SettingId::optimizer_worker_pool_size);
+    if (num_workers > 1) {
+      OptimizerTaskQueue task_queue;
+      metadata_.SetTaskPool(&task_queue);
+      task_queue.Push(new ExploreGroup(
+          metadata_.memo.GetGroupByID(root_group_id), root_context));
+
+      std::vector<std::thread> workers;
+      for (int worker_itr = 0; worker_itr < num_workers; worker_itr++) {
+        workers.emplace_back([&task_queue] {
+          std::unique_ptr<OptimizerTask> task;
+          while (task_queue.WaitAndPop(task)) {
+            task->execute();
+            task_queue.MarkTaskCompleted();
+          }
+        });
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+
+      // Replay the deferred stats derivation tasks serially
+      metadata_.SetTaskPool(task_stack.get());
+      for (auto &deferred_task : task_queue.TakeDeferredTasks()) {
+        task_stack->Push(deferred_task.release());
+      }
+      while (!task_stack->Empty()) {
+        auto task = task_stack->Pop();
+        task->execute();
+      }
+    }
+  }
+
   // Perform optimization after the rewrite
   task_stack->Push(new OptimizeGroup(metadata_.memo.GetGroupByID(root_group_id),
                                      root_context));
@@ -87,10 +131,41 @@ void Optimizer::OptimizeLoop(int root_group_id,
       metadata_.memo.GetGroupByID(root_group_id)->GetLogicalExpression(),
       ExprSet{}, root_context));
 
-  // TODO: Add timer for early stop
+  // Bound the search by the configured task and wall time budget so that
+  // complex queries have a predictable optimization latency
+  OptimizerSearchBudget budget(
+      static_cast<uint32_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::optimizer_task_limit)),
+      static_cast<uint64_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::optimizer_timeout_ms)));
+  bool budget_exhausted = false;
   while (!task_stack->Empty()) {
+    if (budget.Exhausted()) {
+      budget_exhausted = true;
+      break;
+    }
     auto task = task_stack->Pop();
     task->execute();
+    budget.CountTask();
+  }
+
+  if (budget_exhausted) {
+    LOG_DEBUG("Optimizer search budget exhausted, falling back to greedy plan");
+    // Discard the pending search work, then complete the plan greedily:
+    // re-walk the memo applying implementation rules only, so the logical
+    // expressions found so far (at minimum the query's original join order)
+    // are fully implemented and costed without further exploration
+    while (!task_stack->Empty()) task_stack->Pop();
+    std::shared_ptr<OptimizeContext> fallback_context =
+        std::make_shared<OptimizeContext>(
+            &metadata_, required_props, std::numeric_limits<double>::max(),
+            true /*implementation_only*/);
+    task_stack->Push(new OptimizeGroup(
+        metadata_.memo.GetGroupByID(root_group_id), fallback_context));
+    while (!task_stack->Empty()) {
+      auto task = task_stack->Pop();
+      task->execute();
+    }
   }
 }
 
@@ -234,6 +309,13 @@ shared_ptr<GroupExpression> Optimizer::InsertQueryTree(
   QueryToOperatorTransformer converter(txn);
   shared_ptr<OperatorExpression> initial =
       converter.ConvertToOpExpression(tree);
+  // Pick the join order of large inner-join blocks up front with the DP
+  // enumerator; cascades only has a commutativity rule, so the order chosen
+  // here is the one that gets implemented
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::optimizer_dp_join_enumeration)) {
+    initial = JoinOrderEnumerator().Enumerate(initial);
+  }
   shared_ptr<GroupExpression> gexpr;
   metadata_.RecordTransformedExpression(initial, gexpr);
   return gexpr;
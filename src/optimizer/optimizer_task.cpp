@@ -67,9 +67,11 @@ void OptimizeGroup::execute() {
           nullptr)  // Has optimized given the context
     return;
 
-  // Push explore task first for logical expressions if the group has not been
-  // explored
-  if (!group_->HasExplored()) {
+  // Push explore task first for logical expressions if implementation rules
+  // have not been scheduled for the group yet. This is tracked separately
+  // from the exploration flag: a group explored by a transformation-only
+  // pass still needs its logical expressions implemented here.
+  if (!group_->HasImplemented() || context_->implementation_only) {
     for (auto &logical_expr : group_->GetLogicalExpressions())
       PushTask(new OptimizeExpression(logical_expr.get(), context_));
   }
@@ -79,9 +81,10 @@ void OptimizeGroup::execute() {
     PushTask(new OptimizeInputs(physical_expr.get(), context_));
   }
 
-  // Since there is no cycle in the tree, it is safe to set the flag even before
-  // all expressions are explored
+  // Since there is no cycle in the tree, it is safe to set the flags even
+  // before all expressions are explored
   group_->SetExplorationFlag();
+  group_->SetImplementationFlag();
 }
 
 //===--------------------------------------------------------------------===//
@@ -90,9 +93,12 @@ void OptimizeGroup::execute() {
 void OptimizeExpression::execute() {
   std::vector<RuleWithPromise> valid_rules;
 
-  // Construct valid transformation rules from rule set
-  ConstructValidRules(group_expr_, context_.get(),
-                      GetRuleSet().GetTransformationRules(), valid_rules);
+  // Construct valid transformation rules from rule set, unless the budget
+  // fallback restricted the search to implementation only
+  if (!context_->implementation_only) {
+    ConstructValidRules(group_expr_, context_.get(),
+                        GetRuleSet().GetTransformationRules(), valid_rules);
+  }
   // Construct valid implementation rules from rule set
   ConstructValidRules(group_expr_, context_.get(),
                       GetRuleSet().GetImplementationRules(), valid_rules);
@@ -320,7 +326,8 @@ void OptimizeInputs::execute() {
         PushTask(new OptimizeGroup(
             child_group, std::make_shared<OptimizeContext>(
                              context_->metadata, i_prop,
-                             context_->cost_upper_bound - cur_total_cost_)));
+                             context_->cost_upper_bound - cur_total_cost_,
+                             context_->implementation_only)));
         return;
       } else {  // If we return from OptimizeGroup, then there is no expr for
                 // the context
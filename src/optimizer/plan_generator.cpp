@@ -26,6 +26,7 @@
 #include "planner/index_scan_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/limit_plan.h"
+#include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
@@ -100,10 +101,32 @@ void PlanGenerator::Visit(const PhysicalIndexScan *op) {
                             op->table_->GetTableOid())
           ->GetIndexWithOid(op->index_id),
       op->key_column_id_list, op->expr_type_list, op->value_list, runtime_keys);
-  output_plan_.reset(new planner::IndexScanPlan(
+  auto *index_scan_plan = new planner::IndexScanPlan(
       storage::StorageManager::GetInstance()->GetTableWithOid(
           op->table_->GetDatabaseOid(), op->table_->GetTableOid()),
-      predicate.release(), column_ids, index_scan_desc, false));
+      predicate.release(), column_ids, index_scan_desc, false);
+
+  // When the index scan itself was chosen to satisfy the sort requirement,
+  // no order-by is enforced on top, so the requirement shows up here. A
+  // descending requirement is served by walking the ascending index
+  // backward
+  auto sort = required_props_->GetPropertyOfType(PropertyType::SORT);
+  if (sort != nullptr) {
+    auto sort_prop = sort->As<PropertySort>();
+    auto sort_col_size = sort_prop->GetSortColumnSize();
+    bool descending = sort_col_size > 0;
+    for (size_t idx = 0; idx < sort_col_size; ++idx) {
+      if (sort_prop->GetSortAscending(idx)) {
+        descending = false;
+        break;
+      }
+    }
+    if (descending) {
+      index_scan_plan->SetDescend(true);
+    }
+  }
+
+  output_plan_.reset(index_scan_plan);
 }
 
 void PlanGenerator::Visit(const QueryDerivedScan *) {
@@ -114,6 +137,27 @@ void PlanGenerator::Visit(const QueryDerivedScan *) {
 void PlanGenerator::Visit(const PhysicalLimit *op) {
   unique_ptr<planner::AbstractPlan> limit_plan(
       new planner::LimitPlan(op->limit, op->offset));
+
+  // Push the bound into the child so it can stop early: an order-by
+  // switches to a bounded top-K sort, an index scan stops walking version
+  // chains after enough visible matches. The LimitPlan on top still
+  // enforces the exact offset/limit window.
+  auto *child_plan = children_plans_[0].get();
+  if (child_plan != nullptr) {
+    if (child_plan->GetPlanNodeType() == PlanNodeType::ORDERBY) {
+      auto *order_by_plan = static_cast<planner::OrderByPlan *>(child_plan);
+      order_by_plan->SetLimit(true);
+      order_by_plan->SetLimitNumber(op->limit);
+      order_by_plan->SetLimitOffset(op->offset);
+    } else if (child_plan->GetPlanNodeType() == PlanNodeType::INDEXSCAN) {
+      auto *index_scan_plan =
+          static_cast<planner::IndexScanPlan *>(child_plan);
+      index_scan_plan->SetLimit(true);
+      index_scan_plan->SetLimitNumber(op->limit);
+      index_scan_plan->SetLimitOffset(op->offset);
+    }
+  }
+
   limit_plan->AddChild(move(children_plans_[0]));
   output_plan_ = move(limit_plan);
 }
@@ -221,12 +265,32 @@ void PlanGenerator::Visit(const PhysicalRightNLJoin *) {}
 void PlanGenerator::Visit(const PhysicalOuterNLJoin *) {}
 
 void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
+  BuildHashJoinPlan(JoinType::INNER, op->join_predicates, op->left_keys,
+                    op->right_keys);
+}
+
+void PlanGenerator::Visit(const PhysicalSemiHashJoin *op) {
+  BuildHashJoinPlan(JoinType::SEMI, op->join_predicates, op->left_keys,
+                    op->right_keys);
+}
+
+void PlanGenerator::Visit(const PhysicalAntiHashJoin *op) {
+  BuildHashJoinPlan(JoinType::ANTI, op->join_predicates, op->left_keys,
+                    op->right_keys);
+}
+
+void PlanGenerator::BuildHashJoinPlan(
+    JoinType join_type, const std::vector<AnnotatedExpression> &join_predicates,
+    const std::vector<std::unique_ptr<expression::AbstractExpression>>
+        &op_left_keys,
+    const std::vector<std::unique_ptr<expression::AbstractExpression>>
+        &op_right_keys) {
   std::unique_ptr<const planner::ProjectInfo> proj_info;
   std::shared_ptr<const catalog::Schema> proj_schema;
   GenerateProjectionForJoin(proj_info, proj_schema);
 
   auto join_predicate =
-      expression::ExpressionUtil::JoinAnnotatedExprs(op->join_predicates);
+      expression::ExpressionUtil::JoinAnnotatedExprs(join_predicates);
   expression::ExpressionUtil::EvaluateExpression(children_expr_map_,
                                                  join_predicate.get());
 
@@ -234,19 +298,19 @@ void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
   vector<unique_ptr<const expression::AbstractExpression>> right_keys;
   vector<ExprMap> l_child_map{move(children_expr_map_[0])};
   vector<ExprMap> r_child_map{move(children_expr_map_[1])};
-  for (auto &expr : op->left_keys) {
+  for (auto &expr : op_left_keys) {
     auto left_key = expr->Copy();
     expression::ExpressionUtil::EvaluateExpression(l_child_map, left_key);
     left_keys.emplace_back(left_key);
   }
-  for (auto &expr : op->right_keys) {
+  for (auto &expr : op_right_keys) {
     auto right_key = expr->Copy();
     expression::ExpressionUtil::EvaluateExpression(r_child_map, right_key);
     right_keys.emplace_back(right_key);
   }
   // Evaluate Expr for hash plan
   vector<unique_ptr<const expression::AbstractExpression>> hash_keys;
-  for (auto &expr : op->right_keys) {
+  for (auto &expr : op_right_keys) {
     auto hash_key = expr->Copy();
     expression::ExpressionUtil::EvaluateExpression(r_child_map, hash_key);
     hash_keys.emplace_back(hash_key);
@@ -256,15 +320,48 @@ void PlanGenerator::Visit(const PhysicalInnerHashJoin *op) {
   hash_plan->AddChild(move(children_plans_[1]));
 
   auto join_plan = unique_ptr<planner::AbstractPlan>(new planner::HashJoinPlan(
-      JoinType::INNER, move(join_predicate), move(proj_info), proj_schema,
-      left_keys, right_keys, settings::SettingsManager::GetBool(
-                                 settings::SettingId::hash_join_bloom_filter)));
+      join_type, move(join_predicate), move(proj_info), proj_schema, left_keys,
+      right_keys, settings::SettingsManager::GetBool(
+                      settings::SettingId::hash_join_bloom_filter)));
 
   join_plan->AddChild(move(children_plans_[0]));
   join_plan->AddChild(move(hash_plan));
   output_plan_ = move(join_plan);
 }
 
+void PlanGenerator::Visit(const PhysicalInnerMergeJoin *op) {
+  std::unique_ptr<const planner::ProjectInfo> proj_info;
+  std::shared_ptr<const catalog::Schema> proj_schema;
+  GenerateProjectionForJoin(proj_info, proj_schema);
+
+  auto join_predicate =
+      expression::ExpressionUtil::JoinAnnotatedExprs(op->join_predicates);
+  expression::ExpressionUtil::EvaluateExpression(children_expr_map_,
+                                                 join_predicate.get());
+
+  // Both children already produce their tuples in join key order, so the
+  // plan only carries the merge clauses; no hash or sort child is added
+  vector<ExprMap> l_child_map{move(children_expr_map_[0])};
+  vector<ExprMap> r_child_map{move(children_expr_map_[1])};
+  std::vector<planner::MergeJoinPlan::JoinClause> join_clauses;
+  PL_ASSERT(op->left_keys.size() == op->right_keys.size());
+  for (size_t i = 0; i < op->left_keys.size(); i++) {
+    auto left_key = op->left_keys[i]->Copy();
+    expression::ExpressionUtil::EvaluateExpression(l_child_map, left_key);
+    auto right_key = op->right_keys[i]->Copy();
+    expression::ExpressionUtil::EvaluateExpression(r_child_map, right_key);
+    join_clauses.emplace_back(left_key, right_key, false);
+  }
+
+  auto join_plan = unique_ptr<planner::AbstractPlan>(new planner::MergeJoinPlan(
+      JoinType::INNER, move(join_predicate), move(proj_info), proj_schema,
+      join_clauses));
+
+  join_plan->AddChild(move(children_plans_[0]));
+  join_plan->AddChild(move(children_plans_[1]));
+  output_plan_ = move(join_plan);
+}
+
 void PlanGenerator::Visit(const PhysicalLeftHashJoin *) {}
 
 void PlanGenerator::Visit(const PhysicalRightHashJoin *) {}
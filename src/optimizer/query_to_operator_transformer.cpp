@@ -149,8 +149,8 @@ void QueryToOperatorTransformer::Visit(parser::JoinDefinition *node) {
       break;
     }
     case JoinType::SEMI: {
-      join_expr = std::make_shared<OperatorExpression>(
-          LogicalSemiJoin::make(node->condition->Copy()));
+      CollectPredicates(node->condition.get());
+      join_expr = std::make_shared<OperatorExpression>(LogicalSemiJoin::make());
       break;
     }
     default:
@@ -347,7 +347,24 @@ void QueryToOperatorTransformer::Visit(expression::ComparisonExpression *expr) {
 }
 
 void QueryToOperatorTransformer::Visit(expression::OperatorExpression *expr) {
-  if (expr->GetExpressionType() == ExpressionType::OPERATOR_EXISTS) {
+  if (expr->GetExpressionType() == ExpressionType::OPERATOR_NOT &&
+      expr->GetChildrenSize() == 1 &&
+      expr->GetChild(0)->GetExpressionType() ==
+          ExpressionType::OPERATOR_EXISTS) {
+    // NOT EXISTS generates an anti mark-join; the anti join itself keeps
+    // only the unmatched outer rows and null-pads the sub-query side, so
+    // the rewritten predicate NOT(IS NOT NULL(col)) stays true on its
+    // output
+    auto exists_expr = expr->GetModifiableChild(0);
+    std::vector<expression::AbstractExpression *> select_list;
+    if (GenerateSubquerytree(exists_expr->GetModifiableChild(0), select_list,
+                             false, true) == true) {
+      PL_ASSERT(!select_list.empty());
+
+      exists_expr->SetExpressionType(ExpressionType::OPERATOR_IS_NOT_NULL);
+      exists_expr->SetChild(0, select_list.at(0)->Copy());
+    }
+  } else if (expr->GetExpressionType() == ExpressionType::OPERATOR_EXISTS) {
     std::vector<expression::AbstractExpression *> select_list;
     if (GenerateSubquerytree(expr->GetModifiableChild(0), select_list) ==
         true) {
@@ -399,7 +416,7 @@ void QueryToOperatorTransformer::CollectPredicates(
 bool QueryToOperatorTransformer::GenerateSubquerytree(
     expression::AbstractExpression *expr,
     std::vector<expression::AbstractExpression *> &select_list,
-    bool single_join) {
+    bool single_join, bool anti_join) {
   if (expr->GetExpressionType() != ExpressionType::ROW_SUBQUERY) {
     return false;
   }
@@ -415,7 +432,8 @@ bool QueryToOperatorTransformer::GenerateSubquerytree(
   if (single_join) {
     op_expr = std::make_shared<OperatorExpression>(LogicalSingleJoin::make());
   } else {
-    op_expr = std::make_shared<OperatorExpression>(LogicalMarkJoin::make());
+    op_expr =
+        std::make_shared<OperatorExpression>(LogicalMarkJoin::make(anti_join));
   }
 
   // Push previous output
@@ -41,16 +41,22 @@ RuleSet::RuleSet() {
   AddImplementationRule(new LogicalQueryDerivedGetToPhysical());
   AddImplementationRule(new InnerJoinToInnerNLJoin());
   AddImplementationRule(new InnerJoinToInnerHashJoin());
+  AddImplementationRule(new InnerJoinToInnerMergeJoin());
+  AddImplementationRule(new SemiJoinToSemiHashJoin());
+  AddImplementationRule(new AntiJoinToAntiHashJoin());
   AddImplementationRule(new ImplementDistinct());
   AddImplementationRule(new ImplementLimit());
 
   AddRewriteRule(RewriteRuleSetName::PREDICATE_PUSH_DOWN, new PushFilterThroughJoin());
+  AddRewriteRule(RewriteRuleSetName::PREDICATE_PUSH_DOWN, new PushFilterThroughSemiJoin());
+  AddRewriteRule(RewriteRuleSetName::PREDICATE_PUSH_DOWN, new PushFilterThroughAntiJoin());
   AddRewriteRule(RewriteRuleSetName::PREDICATE_PUSH_DOWN, new CombineConsecutiveFilter());
   AddRewriteRule(RewriteRuleSetName::PREDICATE_PUSH_DOWN, new EmbedFilterIntoGet());
 
   AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new PullFilterThroughMarkJoin());
-  AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new MarkJoinInnerJoinToInnerJoin());
-  AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new MarkJoinGetToInnerJoin());
+  AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new MarkJoinInnerJoinToSemiJoin());
+  AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new MarkJoinFilterToSemiJoin());
+  AddRewriteRule(RewriteRuleSetName::UNNEST_SUBQUERY, new MarkJoinGetToSemiJoin());
 
 
 }
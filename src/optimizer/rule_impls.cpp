@@ -632,6 +632,183 @@ void InnerJoinToInnerHashJoin::Transform(
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerMergeJoin
+InnerJoinToInnerMergeJoin::InnerJoinToInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  // Make three node types for pattern matching
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  // Initialize a pattern for optimizer to match
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+
+  // Add node - we match join relation R and S as well as the predicate exp
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+
+  return;
+}
+
+bool InnerJoinToInnerMergeJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                      OptimizeContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void InnerJoinToInnerMergeJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  const LogicalInnerJoin *inner_join = input->Op().As<LogicalInnerJoin>();
+
+  auto children = input->Children();
+  PL_ASSERT(children.size() == 2);
+  auto left_group_id = children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = children[1]->Op().As<LeafOperator>()->origin_group;
+  auto &left_group_alias =
+      context->metadata->memo.GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias =
+      context->metadata->memo.GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  util::ExtractEquiJoinKeys(inner_join->join_predicates, left_keys, right_keys,
+                            left_group_alias, right_group_alias);
+
+  PL_ASSERT(right_keys.size() == left_keys.size());
+  // A merge join needs equi-join keys to define the merge order; the sort
+  // requirements on the keys are derived in the child property deriver
+  if (!left_keys.empty()) {
+    auto result_plan =
+        std::make_shared<OperatorExpression>(PhysicalInnerMergeJoin::make(
+            inner_join->join_predicates, left_keys, right_keys));
+
+    // Then push all children into the child list of the new operator
+    result_plan->PushChild(children[0]);
+    result_plan->PushChild(children[1]);
+
+    transformed.push_back(result_plan);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// SemiJoinToSemiHashJoin
+SemiJoinToSemiHashJoin::SemiJoinToSemiHashJoin() {
+  type_ = RuleType::SEMI_JOIN_TO_HASH_JOIN;
+
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::SemiJoin);
+
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+
+  return;
+}
+
+bool SemiJoinToSemiHashJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                   OptimizeContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void SemiJoinToSemiHashJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  const LogicalSemiJoin *semi_join = input->Op().As<LogicalSemiJoin>();
+
+  auto children = input->Children();
+  PL_ASSERT(children.size() == 2);
+  auto left_group_id = children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = children[1]->Op().As<LeafOperator>()->origin_group;
+  auto &left_group_alias =
+      context->metadata->memo.GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias =
+      context->metadata->memo.GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  util::ExtractEquiJoinKeys(semi_join->join_predicates, left_keys, right_keys,
+                            left_group_alias, right_group_alias);
+
+  PL_ASSERT(right_keys.size() == left_keys.size());
+  // Correlated subqueries always carry an equality between the outer and
+  // the inner side, so unnested plans land here; without equi-join keys
+  // there is nothing to build the hash table on
+  if (!left_keys.empty()) {
+    auto result_plan =
+        std::make_shared<OperatorExpression>(PhysicalSemiHashJoin::make(
+            semi_join->join_predicates, left_keys, right_keys));
+
+    result_plan->PushChild(children[0]);
+    result_plan->PushChild(children[1]);
+
+    transformed.push_back(result_plan);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// AntiJoinToAntiHashJoin
+AntiJoinToAntiHashJoin::AntiJoinToAntiHashJoin() {
+  type_ = RuleType::ANTI_JOIN_TO_HASH_JOIN;
+
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::AntiJoin);
+
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+
+  return;
+}
+
+bool AntiJoinToAntiHashJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                   OptimizeContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+void AntiJoinToAntiHashJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  const LogicalAntiJoin *anti_join = input->Op().As<LogicalAntiJoin>();
+
+  auto children = input->Children();
+  PL_ASSERT(children.size() == 2);
+  auto left_group_id = children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = children[1]->Op().As<LeafOperator>()->origin_group;
+  auto &left_group_alias =
+      context->metadata->memo.GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias =
+      context->metadata->memo.GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> left_keys;
+  std::vector<std::unique_ptr<expression::AbstractExpression>> right_keys;
+
+  util::ExtractEquiJoinKeys(anti_join->join_predicates, left_keys, right_keys,
+                            left_group_alias, right_group_alias);
+
+  PL_ASSERT(right_keys.size() == left_keys.size());
+  if (!left_keys.empty()) {
+    auto result_plan =
+        std::make_shared<OperatorExpression>(PhysicalAntiHashJoin::make(
+            anti_join->join_predicates, left_keys, right_keys));
+
+    result_plan->PushChild(children[0]);
+    result_plan->PushChild(children[1]);
+
+    transformed.push_back(result_plan);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// ImplementDistinct
 ImplementDistinct::ImplementDistinct() {
@@ -790,6 +967,184 @@ void PushFilterThroughJoin::Transform(
   transformed.push_back(output);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// PushFilterThroughSemiJoin
+PushFilterThroughSemiJoin::PushFilterThroughSemiJoin() {
+  type_ = RuleType::PUSH_FILTER_THROUGH_SEMI_JOIN;
+
+  std::shared_ptr<Pattern> child(std::make_shared<Pattern>(OpType::SemiJoin));
+  child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::LogicalFilter);
+
+  match_pattern->AddChild(child);
+}
+
+bool PushFilterThroughSemiJoin::Check(std::shared_ptr<OperatorExpression>,
+                                      OptimizeContext *) const {
+  return true;
+}
+
+void PushFilterThroughSemiJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  auto &memo = context->metadata->memo;
+  auto join_op_expr = input->Children().at(0);
+  auto &join_children = join_op_expr->Children();
+  auto left_group_id = join_children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = join_children[1]->Op().As<LeafOperator>()->origin_group;
+  const auto &left_group_aliases_set =
+      memo.GetGroupByID(left_group_id)->GetTableAliases();
+  const auto &right_group_aliases_set =
+      memo.GetGroupByID(right_group_id)->GetTableAliases();
+
+  auto &predicates = input->Op().As<LogicalFilter>()->predicates;
+  std::vector<AnnotatedExpression> left_predicates;
+  std::vector<AnnotatedExpression> right_predicates;
+  std::vector<AnnotatedExpression> join_predicates;
+
+  // Same split as for inner joins: single-side predicates are evaluated
+  // in the matching child, everything else joins the match condition. The
+  // EXISTS marker predicate only references the inner side and ends up in
+  // the right child, where it is trivially true on real rows.
+  for (auto &predicate : predicates) {
+    if (util::IsSubset(left_group_aliases_set, predicate.table_alias_set))
+      left_predicates.emplace_back(predicate);
+    else if (util::IsSubset(right_group_aliases_set, predicate.table_alias_set))
+      right_predicates.emplace_back(predicate);
+    else
+      join_predicates.emplace_back(predicate);
+  }
+
+  // Construct join operator
+  auto pre_join_predicate =
+      join_op_expr->Op().As<LogicalSemiJoin>()->join_predicates;
+  join_predicates.insert(join_predicates.end(), pre_join_predicate.begin(),
+                         pre_join_predicate.end());
+  std::shared_ptr<OperatorExpression> output =
+      std::make_shared<OperatorExpression>(
+          LogicalSemiJoin::make(join_predicates));
+
+  // Construct left filter if any
+  if (!left_predicates.empty()) {
+    auto left_filter = std::make_shared<OperatorExpression>(
+        LogicalFilter::make(left_predicates));
+    left_filter->PushChild(join_op_expr->Children()[0]);
+    output->PushChild(left_filter);
+  } else {
+    output->PushChild(join_op_expr->Children()[0]);
+  }
+
+  // Construct right filter if any
+  if (!right_predicates.empty()) {
+    auto right_filter = std::make_shared<OperatorExpression>(
+        LogicalFilter::make(right_predicates));
+    right_filter->PushChild(join_op_expr->Children()[1]);
+    output->PushChild(right_filter);
+  } else {
+    output->PushChild(join_op_expr->Children()[1]);
+  }
+
+  PL_ASSERT(output->Children().size() == 2);
+
+  transformed.push_back(output);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// PushFilterThroughAntiJoin
+PushFilterThroughAntiJoin::PushFilterThroughAntiJoin() {
+  type_ = RuleType::PUSH_FILTER_THROUGH_ANTI_JOIN;
+
+  std::shared_ptr<Pattern> child(std::make_shared<Pattern>(OpType::AntiJoin));
+  child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  child->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+
+  match_pattern = std::make_shared<Pattern>(OpType::LogicalFilter);
+
+  match_pattern->AddChild(child);
+}
+
+bool PushFilterThroughAntiJoin::Check(std::shared_ptr<OperatorExpression>,
+                                      OptimizeContext *) const {
+  return true;
+}
+
+void PushFilterThroughAntiJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  auto &memo = context->metadata->memo;
+  auto join_op_expr = input->Children().at(0);
+  auto &join_children = join_op_expr->Children();
+  auto left_group_id = join_children[0]->Op().As<LeafOperator>()->origin_group;
+  auto right_group_id = join_children[1]->Op().As<LeafOperator>()->origin_group;
+  const auto &left_group_aliases_set =
+      memo.GetGroupByID(left_group_id)->GetTableAliases();
+  const auto &right_group_aliases_set =
+      memo.GetGroupByID(right_group_id)->GetTableAliases();
+
+  auto &predicates = input->Op().As<LogicalFilter>()->predicates;
+  std::vector<AnnotatedExpression> left_predicates;
+  std::vector<AnnotatedExpression> above_predicates;
+  std::vector<AnnotatedExpression> join_predicates;
+
+  // Predicates referencing only the inner side are the NOT EXISTS marker
+  // predicates: the anti join null-pads that side, so they have to stay
+  // in a filter above the join instead of being pushed below it. The
+  // sub-query's own inner-side predicates were already left below the
+  // mark join when its filter was pulled up.
+  for (auto &predicate : predicates) {
+    if (util::IsSubset(left_group_aliases_set, predicate.table_alias_set))
+      left_predicates.emplace_back(predicate);
+    else if (util::IsSubset(right_group_aliases_set, predicate.table_alias_set))
+      above_predicates.emplace_back(predicate);
+    else
+      join_predicates.emplace_back(predicate);
+  }
+
+  // Nothing to move below the filter: bail out so the rewrite saturates
+  if (left_predicates.empty() && join_predicates.empty()) {
+    return;
+  }
+
+  // Construct join operator
+  auto pre_join_predicate =
+      join_op_expr->Op().As<LogicalAntiJoin>()->join_predicates;
+  join_predicates.insert(join_predicates.end(), pre_join_predicate.begin(),
+                         pre_join_predicate.end());
+  std::shared_ptr<OperatorExpression> join =
+      std::make_shared<OperatorExpression>(
+          LogicalAntiJoin::make(join_predicates));
+
+  // Construct left filter if any
+  if (!left_predicates.empty()) {
+    auto left_filter = std::make_shared<OperatorExpression>(
+        LogicalFilter::make(left_predicates));
+    left_filter->PushChild(join_op_expr->Children()[0]);
+    join->PushChild(left_filter);
+  } else {
+    join->PushChild(join_op_expr->Children()[0]);
+  }
+
+  join->PushChild(join_op_expr->Children()[1]);
+
+  PL_ASSERT(join->Children().size() == 2);
+
+  // Keep the marker predicates in a filter above the join
+  std::shared_ptr<OperatorExpression> output;
+  if (!above_predicates.empty()) {
+    output = std::make_shared<OperatorExpression>(
+        LogicalFilter::make(above_predicates));
+    output->PushChild(join);
+  } else {
+    output = join;
+  }
+
+  transformed.push_back(output);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// CombineConsecutiveFilter
 CombineConsecutiveFilter::CombineConsecutiveFilter() {
@@ -874,17 +1229,17 @@ void EmbedFilterIntoGet::Transform(
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-/// MarkJoinGetToInnerJoin
-MarkJoinGetToInnerJoin::MarkJoinGetToInnerJoin() {
-  type_ = RuleType::MARK_JOIN_GET_TO_INNER_JOIN;
+/// MarkJoinGetToSemiJoin
+MarkJoinGetToSemiJoin::MarkJoinGetToSemiJoin() {
+  type_ = RuleType::MARK_JOIN_GET_TO_SEMI_JOIN;
 
   match_pattern = std::make_shared<Pattern>(OpType::LogicalMarkJoin);
   match_pattern->AddChild(std::make_shared<Pattern>(OpType::Leaf));
   match_pattern->AddChild(std::make_shared<Pattern>(OpType::Get));
 }
 
-bool MarkJoinGetToInnerJoin::Check(std::shared_ptr<OperatorExpression> plan,
-                                   OptimizeContext *context) const {
+bool MarkJoinGetToSemiJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                  OptimizeContext *context) const {
   (void)context;
   (void)plan;
 
@@ -894,17 +1249,22 @@ bool MarkJoinGetToInnerJoin::Check(std::shared_ptr<OperatorExpression> plan,
   return true;
 }
 
-void MarkJoinGetToInnerJoin::Transform(
+void MarkJoinGetToSemiJoin::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed,
     UNUSED_ATTRIBUTE OptimizeContext *context) const {
-  UNUSED_ATTRIBUTE auto mark_join = input->Op().As<LogicalMarkJoin>();
+  auto mark_join = input->Op().As<LogicalMarkJoin>();
   auto &join_children = input->Children();
 
   PL_ASSERT(mark_join->join_predicates.empty());
 
+  // A semi join emits every outer row at most once, so EXISTS/IN
+  // sub-queries keep their cardinality even when the inner side holds
+  // duplicates; an anti mark join (NOT EXISTS) keeps the unmatched rows
   std::shared_ptr<OperatorExpression> output =
-      std::make_shared<OperatorExpression>(LogicalInnerJoin::make());
+      std::make_shared<OperatorExpression>(mark_join->anti_join
+                                               ? LogicalAntiJoin::make()
+                                               : LogicalSemiJoin::make());
 
   output->PushChild(join_children[0]);
   output->PushChild(join_children[1]);
@@ -913,9 +1273,9 @@ void MarkJoinGetToInnerJoin::Transform(
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-/// MarkJoinInnerJoinToInnerJoin
-MarkJoinInnerJoinToInnerJoin::MarkJoinInnerJoinToInnerJoin() {
-  type_ = RuleType::MARK_JOIN_INNER_JOIN_TO_INNER_JOIN;
+/// MarkJoinInnerJoinToSemiJoin
+MarkJoinInnerJoinToSemiJoin::MarkJoinInnerJoinToSemiJoin() {
+  type_ = RuleType::MARK_JOIN_INNER_JOIN_TO_SEMI_JOIN;
 
   match_pattern = std::make_shared<Pattern>(OpType::LogicalMarkJoin);
   match_pattern->AddChild(std::make_shared<Pattern>(OpType::Leaf));
@@ -925,7 +1285,7 @@ MarkJoinInnerJoinToInnerJoin::MarkJoinInnerJoinToInnerJoin() {
   match_pattern->AddChild(inner_join);
 }
 
-bool MarkJoinInnerJoinToInnerJoin::Check(
+bool MarkJoinInnerJoinToSemiJoin::Check(
     std::shared_ptr<OperatorExpression> plan, OptimizeContext *context) const {
   (void)context;
   (void)plan;
@@ -936,17 +1296,79 @@ bool MarkJoinInnerJoinToInnerJoin::Check(
   return true;
 }
 
-void MarkJoinInnerJoinToInnerJoin::Transform(
+void MarkJoinInnerJoinToSemiJoin::Transform(
     std::shared_ptr<OperatorExpression> input,
     std::vector<std::shared_ptr<OperatorExpression>> &transformed,
     UNUSED_ATTRIBUTE OptimizeContext *context) const {
-  UNUSED_ATTRIBUTE auto mark_join = input->Op().As<LogicalMarkJoin>();
+  auto mark_join = input->Op().As<LogicalMarkJoin>();
   auto &join_children = input->Children();
 
   PL_ASSERT(mark_join->join_predicates.empty());
 
   std::shared_ptr<OperatorExpression> output =
-      std::make_shared<OperatorExpression>(LogicalInnerJoin::make());
+      std::make_shared<OperatorExpression>(mark_join->anti_join
+                                               ? LogicalAntiJoin::make()
+                                               : LogicalSemiJoin::make());
+
+  output->PushChild(join_children[0]);
+  output->PushChild(join_children[1]);
+
+  transformed.push_back(output);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// MarkJoinFilterToSemiJoin
+MarkJoinFilterToSemiJoin::MarkJoinFilterToSemiJoin() {
+  type_ = RuleType::MARK_JOIN_FILTER_TO_SEMI_JOIN;
+
+  match_pattern = std::make_shared<Pattern>(OpType::LogicalMarkJoin);
+  match_pattern->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  auto filter = std::make_shared<Pattern>(OpType::LogicalFilter);
+  filter->AddChild(std::make_shared<Pattern>(OpType::Leaf));
+  match_pattern->AddChild(filter);
+}
+
+bool MarkJoinFilterToSemiJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                     OptimizeContext *context) const {
+  (void)context;
+  (void)plan;
+
+  auto &children = plan->Children();
+  PL_ASSERT(children.size() == 2);
+  UNUSED_ATTRIBUTE auto &r_grandchildren = children[1]->Children();
+  PL_ASSERT(r_grandchildren.size() == 1);
+
+  return true;
+}
+
+void MarkJoinFilterToSemiJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed,
+    UNUSED_ATTRIBUTE OptimizeContext *context) const {
+  auto mark_join = input->Op().As<LogicalMarkJoin>();
+  auto &join_children = input->Children();
+
+  PL_ASSERT(mark_join->join_predicates.empty());
+
+  // Only convert once the filter below carries inner-side predicates
+  // exclusively; correlated predicates have to be pulled above the mark
+  // join first, which is PullFilterThroughMarkJoin's job
+  auto &memo = context->metadata->memo;
+  auto filter_child_group =
+      join_children[1]->Children()[0]->Op().As<LeafOperator>()->origin_group;
+  const auto &inner_aliases_set =
+      memo.GetGroupByID(filter_child_group)->GetTableAliases();
+  auto &predicates = join_children[1]->Op().As<LogicalFilter>()->predicates;
+  for (auto &predicate : predicates) {
+    if (!util::IsSubset(inner_aliases_set, predicate.table_alias_set)) {
+      return;
+    }
+  }
+
+  std::shared_ptr<OperatorExpression> output =
+      std::make_shared<OperatorExpression>(mark_join->anti_join
+                                               ? LogicalAntiJoin::make()
+                                               : LogicalSemiJoin::make());
 
   output->PushChild(join_children[0]);
   output->PushChild(join_children[1]);
@@ -985,19 +1407,52 @@ void PullFilterThroughMarkJoin::Transform(
     UNUSED_ATTRIBUTE OptimizeContext *context) const {
   UNUSED_ATTRIBUTE auto mark_join = input->Op().As<LogicalMarkJoin>();
   auto &join_children = input->Children();
-  auto filter = join_children[1]->Op();
   auto &filter_children = join_children[1]->Children();
 
   PL_ASSERT(mark_join->join_predicates.empty());
 
+  // Hoist only the predicates referencing the outer side so they become
+  // join predicates once the mark join turns into a semi/anti join.
+  // Inner-only predicates stay below the join, otherwise an anti join
+  // would wrongly filter the null-padded rows with them
+  auto &memo = context->metadata->memo;
+  auto filter_child_group =
+      filter_children[0]->Op().As<LeafOperator>()->origin_group;
+  const auto &inner_aliases_set =
+      memo.GetGroupByID(filter_child_group)->GetTableAliases();
+  auto &predicates = join_children[1]->Op().As<LogicalFilter>()->predicates;
+  std::vector<AnnotatedExpression> pulled_predicates;
+  std::vector<AnnotatedExpression> inner_predicates;
+  for (auto &predicate : predicates) {
+    if (util::IsSubset(inner_aliases_set, predicate.table_alias_set)) {
+      inner_predicates.emplace_back(predicate);
+    } else {
+      pulled_predicates.emplace_back(predicate);
+    }
+  }
+  // Nothing to hoist, leave the expression unchanged so the rewrite
+  // saturates and MarkJoinFilterToSemiJoin can fire
+  if (pulled_predicates.empty()) {
+    return;
+  }
+
   std::shared_ptr<OperatorExpression> output =
-      std::make_shared<OperatorExpression>(filter);
+      std::make_shared<OperatorExpression>(
+          LogicalFilter::make(pulled_predicates));
 
   std::shared_ptr<OperatorExpression> join =
       std::make_shared<OperatorExpression>(input->Op());
 
   join->PushChild(join_children[0]);
-  join->PushChild(filter_children[0]);
+  if (inner_predicates.empty()) {
+    join->PushChild(filter_children[0]);
+  } else {
+    std::shared_ptr<OperatorExpression> inner_filter =
+        std::make_shared<OperatorExpression>(
+            LogicalFilter::make(inner_predicates));
+    inner_filter->PushChild(filter_children[0]);
+    join->PushChild(inner_filter);
+  }
 
   output->PushChild(join);
 
@@ -159,7 +159,7 @@ double Selectivity::Like(const std::shared_ptr<TableStats> &table_stats,
   auto sampler = table_stats->GetSampler();
   PL_ASSERT(sampler != nullptr);
   if (sampler->GetSampledTuples().empty()) {
-    sampler->AcquireSampleTuples(DEFAULT_SAMPLE_SIZE);
+    sampler->AcquireBlockSampleTuples(DEFAULT_SAMPLE_SIZE);
   }
   auto &sample_tuples = sampler->GetSampledTuples();
   for (size_t i = 0; i < sample_tuples.size(); i++) {
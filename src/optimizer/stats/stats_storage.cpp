@@ -12,6 +12,8 @@
 
 #include "optimizer/stats/stats_storage.h"
 
+#include <algorithm>
+
 #include "catalog/catalog.h"
 #include "catalog/column_stats_catalog.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -23,6 +25,9 @@
 namespace peloton {
 namespace optimizer {
 
+// Minimum number of modified tuples before a small table counts as stale
+#define ANALYZE_STALE_TUPLE_FLOOR 1000
+
 // Get instance of the global stats storage
 StatsStorage *StatsStorage::GetInstance() {
   static StatsStorage global_stats_storage;
@@ -75,6 +80,14 @@ void StatsStorage::InsertOrUpdateTableStats(
     // TODO: Store common <value, freq> pairs for VARCHAR.
     std::vector<ValueFrequencyPair> most_common_val_freqs =
         column_stats_collector->GetCommonValueAndFrequency();
+    // When ANALYZE ran on a sample, scale the sample-local frequencies up to
+    // full-table counts; the selectivity formulas divide them by num_rows
+    double sample_ratio = table_stats_collector->GetSampleRatio();
+    if (sample_ratio > 1.0) {
+      for (auto &val_freq : most_common_val_freqs) {
+        val_freq.second *= sample_ratio;
+      }
+    }
     std::vector<double> histogram_bounds =
         column_stats_collector->GetHistogramBound();
 
@@ -310,6 +323,49 @@ ResultType StatsStorage::AnalyzeStatsForTable(storage::DataTable *table,
       new TableStatsCollector(table));
   table_stats_collector->CollectColumnStats();
   InsertOrUpdateTableStats(table, table_stats_collector.get(), txn);
+  table->ResetTuplesModifiedSinceAnalyze();
+  return ResultType::SUCCESS;
+}
+
+/**
+ * AnalyzeStaleTables - Re-analyze only the tables whose modification counter
+ * has outgrown their stored stats. Backs the plain (table-less) ANALYZE so
+ * keeping stats fresh does not require full scans of quiescent tables.
+ */
+ResultType StatsStorage::AnalyzeStaleTables(
+    concurrency::TransactionContext *txn) {
+  if (txn == nullptr) {
+    LOG_TRACE("Do not have transaction to analyze stale tables' stats.");
+    return ResultType::FAILURE;
+  }
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+
+  oid_t database_count = storage_manager->GetDatabaseCount();
+  for (oid_t db_offset = 0; db_offset < database_count; db_offset++) {
+    auto database = storage_manager->GetDatabaseWithOffset(db_offset);
+    if (database->GetOid() == CATALOG_DATABASE_OID) {
+      continue;
+    }
+    oid_t table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; table_offset++) {
+      auto table = database->GetTable(table_offset);
+      // Stale once a tenth of the table (with a floor for small tables) has
+      // been modified since the last ANALYZE
+      size_t modified = table->GetTuplesModifiedSinceAnalyze();
+      size_t threshold =
+          std::max<size_t>(ANALYZE_STALE_TUPLE_FLOOR, table->GetTupleCount() / 10);
+      if (modified < threshold) {
+        continue;
+      }
+      LOG_TRACE("Re-analyzing stale table: %s (%lu modified tuples)",
+                table->GetName().c_str(), modified);
+      ResultType result = AnalyzeStatsForTable(table, txn);
+      if (result != ResultType::SUCCESS) {
+        return result;
+      }
+    }
+  }
   return ResultType::SUCCESS;
 }
 
@@ -15,8 +15,10 @@
 #include <memory>
 
 #include "common/macros.h"
+#include "settings/settings_manager.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
+#include "storage/tile_group_iterator.h"
 #include "common/internal_types.h"
 #include "type/value.h"
 
@@ -42,11 +44,42 @@ void TableStatsCollector::CollectColumnStats() {
 
   InitColumnStatsCollectors();
 
-  size_t tile_group_count = table_->GetTileGroupCount();
-  // Collect stats for all tile groups.
-  for (size_t offset = 0; offset < tile_group_count; offset++) {
-    std::shared_ptr<storage::TileGroup> tile_group =
-        table_->GetTileGroup(offset);
+  // Row sampling rate; below 100 percent only a Bernoulli sample of the rows
+  // is fed to the streaming collectors, which is what makes ANALYZE on very
+  // large tables affordable. Tuple headers are still visited for every row so
+  // the active tuple count stays exact.
+  int sample_percent = settings::SettingsManager::GetInt(
+      settings::SettingId::analyze_sample_percent);
+  if (sample_percent < 1 || sample_percent > 100) {
+    sample_percent = 100;
+  }
+
+  // Block sampling visits only the chosen percentage of tile groups and
+  // scans those in full; skipped tile groups are never touched at all,
+  // which is what actually cuts the I/O on big tables. Row sampling below
+  // still reads every tile group and merely thins the rows fed to the
+  // collectors.
+  if (sample_percent < 100 &&
+      settings::SettingsManager::GetBool(
+          settings::SettingId::analyze_block_sampling)) {
+    CollectBlockSampledStats(sample_percent);
+    return;
+  }
+  // xorshift64*; any fixed non-zero seed works since we only need the sample
+  // to be spread evenly, not unpredictably
+  uint64_t rng_state = 0x853c49e6748fea9bULL;
+  auto next_random = [&rng_state]() {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+  };
+
+  // Collect stats for all tile groups; the window iterator pins a batch of
+  // tile groups at a time and prefetches their headers and data
+  storage::TileGroupWindowIterator tile_group_iterator(table_);
+  storage::TileGroup *tile_group = nullptr;
+  while (tile_group_iterator.Next(tile_group)) {
     storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
     oid_t tuple_count = tile_group->GetAllocatedTupleCount();
     active_tuple_count_ += tile_group_header->GetActiveTupleCount();
@@ -54,6 +87,12 @@ void TableStatsCollector::CollectColumnStats() {
     for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
       txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
       if (tuple_txn_id != INVALID_TXN_ID) {
+        visited_tuple_count_++;
+        if (sample_percent < 100 &&
+            next_random() % 100 >= static_cast<uint64_t>(sample_percent)) {
+          continue;
+        }
+        sampled_tuple_count_++;
         // Collect stats for all columns.
         for (oid_t column_id = 0; column_id < column_count_; column_id++) {
           type::Value value = tile_group->GetValue(tuple_id, column_id);
@@ -64,6 +103,67 @@ void TableStatsCollector::CollectColumnStats() {
   }   /* tile group */
 }
 
+void TableStatsCollector::CollectBlockSampledStats(int sample_percent) {
+  const size_t tile_group_count = table_->GetTileGroupCount();
+  if (tile_group_count == 0) {
+    return;
+  }
+
+  // Choose the requested fraction of tile groups uniformly without
+  // replacement (partial Fisher-Yates), then visit them in offset order so
+  // the reads stay roughly sequential.
+  size_t target_count =
+      (tile_group_count * static_cast<size_t>(sample_percent) + 99) / 100;
+  if (target_count == 0) {
+    target_count = 1;
+  }
+
+  uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+  auto next_random = [&rng_state]() {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+  };
+
+  std::vector<oid_t> offsets(tile_group_count);
+  for (size_t i = 0; i < tile_group_count; i++) {
+    offsets[i] = static_cast<oid_t>(i);
+  }
+  for (size_t i = 0; i < target_count && i + 1 < tile_group_count; i++) {
+    size_t j = i + next_random() % (tile_group_count - i);
+    std::swap(offsets[i], offsets[j]);
+  }
+  offsets.resize(target_count);
+  std::sort(offsets.begin(), offsets.end());
+
+  size_t visited_active_count = 0;
+  for (oid_t offset : offsets) {
+    auto tile_group = table_->GetTileGroup(offset);
+    storage::TileGroupHeader *tile_group_header = tile_group->GetHeader();
+    oid_t tuple_count = tile_group->GetAllocatedTupleCount();
+    visited_active_count += tile_group_header->GetActiveTupleCount();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+      if (tuple_txn_id == INVALID_TXN_ID) {
+        continue;
+      }
+      sampled_tuple_count_++;
+      for (oid_t column_id = 0; column_id < column_count_; column_id++) {
+        type::Value value = tile_group->GetValue(tuple_id, column_id);
+        column_stats_collectors_[column_id]->AddValue(value);
+      }
+    }
+  }
+
+  // The unvisited tile groups were never read, so the table-level counts
+  // are scaled up from the visited fraction; GetSampleRatio() then keeps
+  // estimating full-table frequencies the same way as with row sampling.
+  active_tuple_count_ = visited_active_count * tile_group_count / target_count;
+  visited_tuple_count_ =
+      sampled_tuple_count_ * tile_group_count / target_count;
+}
+
 void TableStatsCollector::InitColumnStatsCollectors() {
   oid_t database_id = table_->GetDatabaseOid();
   oid_t table_id = table_->GetOid();
@@ -71,6 +71,66 @@ size_t TupleSampler::AcquireSampleTuples(size_t target_sample_count) {
   return sampled_tuples.size();
 }
 
+/**
+ * AcquireBlockSampleTuples - Sample tuples a whole tile group at a time.
+ * Tile groups are visited in a random order without replacement and each
+ * one is drained front to back until the target is met, so the sample
+ * touches only about target / tuples-per-tile-group blocks.
+ */
+size_t TupleSampler::AcquireBlockSampleTuples(size_t target_sample_count) {
+  size_t tuple_count = table->GetTupleCount();
+  size_t tile_group_count = table->GetTileGroupCount();
+  LOG_TRACE("tuple_count = %lu, tile_group_count = %lu", tuple_count,
+            tile_group_count);
+  if (tile_group_count == 0) {
+    return sampled_tuples.size();
+  }
+
+  if (tuple_count < target_sample_count) {
+    target_sample_count = tuple_count;
+  }
+
+  srand(time(NULL));
+  catalog::Schema *tuple_schema = table->GetSchema();
+
+  // Random visiting order over all tile groups (Fisher-Yates)
+  std::vector<size_t> tile_group_offsets(tile_group_count);
+  for (size_t i = 0; i < tile_group_count; i++) {
+    tile_group_offsets[i] = i;
+  }
+  for (size_t i = 0; i + 1 < tile_group_count; i++) {
+    size_t j = i + rand() % (tile_group_count - i);
+    std::swap(tile_group_offsets[i], tile_group_offsets[j]);
+  }
+
+  for (size_t offset_itr = 0;
+       offset_itr < tile_group_count &&
+       sampled_tuples.size() < target_sample_count;
+       offset_itr++) {
+    storage::TileGroup *tile_group =
+        table->GetTileGroup(tile_group_offsets[offset_itr]).get();
+    oid_t tuple_per_group = tile_group->GetActiveTupleCount();
+    LOG_TRACE("tile_group: offset: %lu, addr: %p, tuple_per_group: %u",
+              tile_group_offsets[offset_itr], tile_group, tuple_per_group);
+
+    for (oid_t tuple_offset = 0;
+         tuple_offset < tuple_per_group &&
+         sampled_tuples.size() < target_sample_count;
+         tuple_offset++) {
+      std::unique_ptr<storage::Tuple> tuple(
+          new storage::Tuple(tuple_schema, true));
+      if (!GetTupleInTileGroup(tile_group, tuple_offset, tuple)) {
+        continue;
+      }
+      LOG_TRACE("Add sampled tuple: %s", tuple->GetInfo().c_str());
+      sampled_tuples.push_back(std::move(tuple));
+    }
+  }
+  LOG_TRACE("%lu Sample added - size: %lu", sampled_tuples.size(),
+            sampled_tuples.size() * tuple_schema->GetLength());
+  return sampled_tuples.size();
+}
+
 /**
  * GetTupleInTileGroup - This function is a helper function to get a tuple in
  * a tile group.
@@ -95,6 +95,12 @@ void StatsCalculator::Visit(const LogicalQueryDerivedGet *) {
 }
 
 void StatsCalculator::Visit(const LogicalInnerJoin *op) {
+  CalculateJoinStats(op->join_predicates, JoinType::INNER);
+}
+
+void StatsCalculator::CalculateJoinStats(
+    const std::vector<AnnotatedExpression> &join_predicates,
+    JoinType join_type) {
   // Check if there's join condition
   PL_ASSERT(gexpr_->GetChildrenGroupsSize() == 2);
   auto left_child_group = memo_->GetGroupByID(gexpr_->GetChildGroupId(0));
@@ -104,7 +110,7 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
   if (root_group->GetNumRows() == -1) {
     size_t curr_rows =
         left_child_group->GetNumRows() * right_child_group->GetNumRows();
-    for (auto &annotated_expr : op->join_predicates) {
+    for (auto &annotated_expr : join_predicates) {
       // See if there are join conditions
       if (annotated_expr.expr->GetExpressionType() ==
               ExpressionType::COMPARE_EQUAL &&
@@ -123,12 +129,42 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
                  right_child->GetColFullName())) ||
             (left_child_group->HasColumnStats(right_child->GetColFullName()) &&
              right_child_group->HasColumnStats(left_child->GetColFullName()))) {
-          curr_rows /= std::max(std::max(left_child_group->GetNumRows(),
-                                         right_child_group->GetNumRows()),
-                                1);
+          // The standard equi-join estimate divides by the larger distinct
+          // count of the two join keys. The HLL-backed cardinality from
+          // ANALYZE gives us that; when a side has no (or degenerate)
+          // cardinality we fall back to its row count, which reduces to the
+          // old estimate.
+          auto distinct_count = [&](Group *child_group,
+                                    const std::string &column_name) -> double {
+            if (child_group->HasColumnStats(column_name)) {
+              auto column_stats = child_group->GetStats(column_name);
+              if (column_stats->cardinality >= 1) {
+                return std::min(column_stats->cardinality,
+                                static_cast<double>(child_group->GetNumRows()));
+              }
+            }
+            return static_cast<double>(child_group->GetNumRows());
+          };
+          double max_distinct = std::max(
+              std::max(
+                  distinct_count(left_child_group, left_child->GetColFullName()),
+                  distinct_count(left_child_group,
+                                 right_child->GetColFullName())),
+              std::max(
+                  distinct_count(right_child_group,
+                                 left_child->GetColFullName()),
+                  distinct_count(right_child_group,
+                                 right_child->GetColFullName())));
+          curr_rows /= std::max(max_distinct, 1.0);
         }
       }
     }
+    size_t left_rows = left_child_group->GetNumRows();
+    if (join_type == JoinType::SEMI) {
+      curr_rows = std::min(curr_rows, left_rows);
+    } else if (join_type == JoinType::ANTI) {
+      curr_rows = left_rows - std::min(curr_rows, left_rows);
+    }
     root_group->SetNumRows(curr_rows);
   }
   size_t num_rows = root_group->GetNumRows();
@@ -155,7 +191,12 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalLeftJoin *op) {}
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalRightJoin *op) {}
 void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalOuterJoin *op) {}
-void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalSemiJoin *op) {}
+void StatsCalculator::Visit(const LogicalSemiJoin *op) {
+  CalculateJoinStats(op->join_predicates, JoinType::SEMI);
+}
+void StatsCalculator::Visit(const LogicalAntiJoin *op) {
+  CalculateJoinStats(op->join_predicates, JoinType::ANTI);
+}
 void StatsCalculator::Visit(const LogicalAggregateAndGroupBy *) {
   // TODO(boweic): For now we just pass the stats needed without any
   // computation,
@@ -367,9 +367,6 @@ std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(
     deserialize_parameters = true;
   }
 
-  std::unique_ptr<planner::AbstractPlan> copy_plan(
-      new planner::CopyPlan(copy_stmt->file_path, deserialize_parameters));
-
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
@@ -377,6 +374,19 @@ std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(
       copy_stmt->cpy_table->GetTableName(), txn);
   txn_manager.CommitTransaction(txn);
 
+  // Imports have no child plan; the copy executor parses the file and
+  // bulk-loads the target table itself
+  if (copy_stmt->type == CopyType::IMPORT_CSV ||
+      copy_stmt->type == CopyType::IMPORT_TSV) {
+    std::unique_ptr<planner::AbstractPlan> import_plan(new planner::CopyPlan(
+        target_table, copy_stmt->file_path, copy_stmt->delimiter));
+    LOG_DEBUG("Copy import plan for table %s created", table_name.c_str());
+    return import_plan;
+  }
+
+  std::unique_ptr<planner::AbstractPlan> copy_plan(
+      new planner::CopyPlan(copy_stmt->file_path, deserialize_parameters));
+
   std::unique_ptr<planner::SeqScanPlan> select_plan(
       new planner::SeqScanPlan(target_table, nullptr, {}, false));
 
@@ -557,15 +557,15 @@ expression::AbstractExpression *PostgresParser::FuncCallTransform(
 // parsenode and transfers it into the select_list of a Peloton SelectStatement.
 // It checks the type of each target and call the corresponding helpers.
 std::vector<std::unique_ptr<expression::AbstractExpression>>
-    *PostgresParser::TargetTransform(List *root) {
+    PostgresParser::TargetTransform(List *root) {
   // Statement like 'SELECT;' cannot detect by postgres parser and would lead to
   // null list
   if (root == nullptr) {
     throw ParserException("Error parsing SQL statement");
   }
 
-  auto result =
-      new std::vector<std::unique_ptr<expression::AbstractExpression>>();
+  std::vector<std::unique_ptr<expression::AbstractExpression>> result;
+  result.reserve(root->length);
   for (auto cell = root->head; cell != nullptr; cell = cell->next) {
     ResTarget *target = reinterpret_cast<ResTarget *>(cell->data.ptr_value);
     expression::AbstractExpression *expr = nullptr;
@@ -576,7 +576,7 @@ std::vector<std::unique_ptr<expression::AbstractExpression>>
           StringUtil::Format("Exception thrown in target val:\n%s", e.what()));
     }
     if (target->name != nullptr) expr->alias = target->name;
-    result->push_back(std::unique_ptr<expression::AbstractExpression>(expr));
+    result.push_back(std::unique_ptr<expression::AbstractExpression>(expr));
   }
   return result;
 }
@@ -1453,9 +1453,11 @@ parser::PrepareStatement *PostgresParser::PrepareTransform(PrepareStmt *root) {
   return result;
 }
 
-// TODO: Only support COPY TABLE TO FILE and DELIMITER option
+// TODO: Only support COPY TABLE TO/FROM FILE and DELIMITER option
 parser::CopyStatement *PostgresParser::CopyTransform(CopyStmt *root) {
-  auto result = new CopyStatement(peloton::CopyType::EXPORT_OTHER);
+  auto result = new CopyStatement(root->is_from
+                                      ? peloton::CopyType::IMPORT_CSV
+                                      : peloton::CopyType::EXPORT_OTHER);
   result->cpy_table.reset(RangeVarTransform(root->relation));
   result->file_path = root->filename;
   for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
@@ -1478,9 +1480,7 @@ parser::AnalyzeStatement *PostgresParser::VacuumTransform(VacuumStmt *root) {
   if (root->relation != NULL) {  // TOOD: check NULL vs nullptr
     result->analyze_table.reset(RangeVarTransform(root->relation));
   }
-  auto analyze_columns = ColumnNameTransform(root->va_cols);
-  result->analyze_columns = std::move(*analyze_columns);
-  delete analyze_columns;
+  result->analyze_columns = ColumnNameTransform(root->va_cols);
   return result;
 }
 
@@ -1489,14 +1489,15 @@ parser::VariableSetStatement *PostgresParser::VariableSetTransform(UNUSED_ATTRIB
   return res;
 }
 
-std::vector<std::string> *PostgresParser::ColumnNameTransform(List *root) {
-  auto result = new std::vector<std::string>();
+std::vector<std::string> PostgresParser::ColumnNameTransform(List *root) {
+  std::vector<std::string> result;
 
   if (root == nullptr) return result;
 
+  result.reserve(root->length);
   for (auto cell = root->head; cell != NULL; cell = cell->next) {
     ResTarget *target = (ResTarget *)(cell->data.ptr_value);
-    result->push_back(std::string(target->name));
+    result.push_back(std::string(target->name));
   }
 
   return result;
@@ -1507,9 +1508,10 @@ std::vector<std::string> *PostgresParser::ColumnNameTransform(List *root) {
 // This is a vector pointer of vector pointers because one InsertStmt can insert
 // multiple tuples.
 std::vector<std::vector<std::unique_ptr<expression::AbstractExpression>>>
-    *PostgresParser::ValueListsTransform(List *root) {
-  auto result = new std::vector<
-      std::vector<std::unique_ptr<expression::AbstractExpression>>>();
+    PostgresParser::ValueListsTransform(List *root) {
+  std::vector<std::vector<std::unique_ptr<expression::AbstractExpression>>>
+      result;
+  result.reserve(root->length);
 
   for (auto value_list = root->head; value_list != NULL;
        value_list = value_list->next) {
@@ -1531,14 +1533,8 @@ std::vector<std::vector<std::unique_ptr<expression::AbstractExpression>>>
           break;
         }
         case T_TypeCast: {
-          try {
-            cur_result.push_back(
-                std::unique_ptr<expression::AbstractExpression>(
-                    TypeCastTransform((TypeCast *)expr)));
-          } catch (Exception e) {
-            delete result;
-            throw e;
-          }
+          cur_result.push_back(std::unique_ptr<expression::AbstractExpression>(
+              TypeCastTransform((TypeCast *)expr)));
           break;
         }
         case T_SetToDefault: {
@@ -1553,7 +1549,7 @@ std::vector<std::vector<std::unique_ptr<expression::AbstractExpression>>>
               "Value of type %d not supported yet...\n", expr->type));
       }
     }
-    result->push_back(std::move(cur_result));
+    result.push_back(std::move(cur_result));
   }
 
   return result;
@@ -1618,25 +1614,19 @@ parser::SQLStatement *PostgresParser::InsertTransform(InsertStmt *root) {
     result = new parser::InsertStatement(InsertType::VALUES);
 
     PL_ASSERT(select_stmt->valuesLists != NULL);
-    std::vector<std::vector<std::unique_ptr<expression::AbstractExpression>>>
-        *insert_values = nullptr;
     try {
-      insert_values = ValueListsTransform(select_stmt->valuesLists);
+      result->insert_values = ValueListsTransform(select_stmt->valuesLists);
     } catch (Exception e) {
       delete result;
       throw e;
     }
-    result->insert_values = std::move(*insert_values);
-    delete insert_values;
   }
 
   // The table to insert into
   result->table_ref_.reset(RangeVarTransform(root->relation));
 
   // The columns to insert into
-  auto columns = ColumnNameTransform(root->cols);
-  result->columns = std::move(*columns);
-  delete columns;
+  result->columns = ColumnNameTransform(root->cols);
   return (parser::SQLStatement *)result;
 }
 
@@ -1650,9 +1640,7 @@ parser::SelectStatement *PostgresParser::SelectTransform(SelectStmt *root) {
     case SETOP_NONE:
       result = new parser::SelectStatement();
       try {
-        auto select_list = TargetTransform(root->targetList);
-        result->select_list = std::move(*select_list);
-        delete select_list;
+        result->select_list = TargetTransform(root->targetList);
         result->from_table.reset(FromTransform(root));
       } catch (ParserException &e) {
         delete (result);
@@ -1826,20 +1814,20 @@ parser::SQLStatementList* PostgresParser::ListTransform(List *root) {
 }
 
 std::vector<std::unique_ptr<parser::UpdateClause>>
-    *PostgresParser::UpdateTargetTransform(List *root) {
-  auto result = new std::vector<std::unique_ptr<parser::UpdateClause>>();
+    PostgresParser::UpdateTargetTransform(List *root) {
+  std::vector<std::unique_ptr<parser::UpdateClause>> result;
+  result.reserve(root->length);
   for (auto cell = root->head; cell != NULL; cell = cell->next) {
-    auto update_clause = new UpdateClause();
+    std::unique_ptr<UpdateClause> update_clause(new UpdateClause());
     ResTarget *target = (ResTarget *)(cell->data.ptr_value);
     update_clause->column = target->name;
     try {
       update_clause->value.reset(ExprTransform(target->val));
     } catch (NotImplementedException e) {
-      delete result;
       throw NotImplementedException(
           StringUtil::Format("Exception thrown in update expr:\n%s", e.what()));
     }
-    result->push_back(std::unique_ptr<UpdateClause>(update_clause));
+    result.push_back(std::move(update_clause));
   }
   return result;
 }
@@ -1857,9 +1845,7 @@ parser::UpdateStatement *PostgresParser::UpdateTransform(
     throw e;
   }
   try {
-    auto clauses = UpdateTargetTransform(update_stmt->targetList);
-    result->updates = std::move(*clauses);
-    delete clauses;
+    result->updates = UpdateTargetTransform(update_stmt->targetList);
   } catch (NotImplementedException e) {
     delete result;
     throw e;
@@ -50,14 +50,41 @@ IndexScanPlan::IndexScanPlan(storage::DataTable *table,
     values_.push_back(val.Copy());
   }
 
-  // Then add the only conjunction predicate into the index predicate list
-  // (at least for now we only supports single conjunction)
+  // Then add the first conjunction predicate into the index predicate list
   //
   // Values that are left blank will be recorded for future binding
   // and their offset inside the value array will be remembered
   index_predicate_.AddConjunctionScanPredicate(index_.get(), values_,
                                                key_column_ids_, expr_types_);
 
+  // Every OR'd value list becomes one more conjunction over the same
+  // columns and operators, so an IN list or a disjunction of ranges turns
+  // into several probe intervals rather than a full index scan. The
+  // executor's open range handling only knows one global boundary pair,
+  // so strict comparisons may not be combined with extra value lists
+  if (index_scan_desc.or_value_list.size() > 0) {
+    for (UNUSED_ATTRIBUTE auto expr_type : expr_types_) {
+      PL_ASSERT(expr_type != ExpressionType::COMPARE_LESSTHAN &&
+                expr_type != ExpressionType::COMPARE_GREATERTHAN);
+    }
+
+    for (const auto &or_values : index_scan_desc.or_value_list) {
+      or_values_with_params_.push_back(or_values);
+
+      or_values_.emplace_back();
+      for (const auto &val : or_values) {
+        or_values_.back().push_back(val.Copy());
+      }
+
+      index_predicate_.AddConjunctionScanPredicate(
+          index_.get(), or_values_.back(), key_column_ids_, expr_types_);
+    }
+
+    // Coalesce overlapping probe intervals so that executing the probes
+    // front to back yields the sorted union of all matches
+    index_predicate_.MergeConjunctions();
+  }
+
   // Check whether the scan range is left/right open. Because the index itself
   // is not able to handle that exactly, we must have extra logic in
   // IndexScanExecutor to handle that case.
@@ -100,6 +127,28 @@ void IndexScanPlan::SetParameterValues(std::vector<type::Value> *values) {
     }
   }
 
+  // Rebind the OR'd value lists the same way
+  for (size_t list_itr = 0; list_itr < or_values_.size(); list_itr++) {
+    auto &or_values = or_values_[list_itr];
+
+    or_values.clear();
+    for (auto val : or_values_with_params_[list_itr]) {
+      or_values.push_back(val.Copy());
+    }
+
+    for (unsigned int i = 0; i < or_values.size(); ++i) {
+      auto value = or_values[i];
+      auto column_id = key_column_ids_[i];
+      if (value.GetTypeId() == type::TypeId::PARAMETER_OFFSET) {
+        int offset = value.GetAs<int32_t>();
+        or_values[i] =
+            (values->at(offset))
+                .CastAs(
+                    GetTable()->GetSchema()->GetColumn(column_id).GetType());
+      }
+    }
+  }
+
   // Also bind values to index scan predicate object
   //
   // NOTE: This could only be called by one thread at a time
@@ -28,6 +28,14 @@ ProjectInfo::~ProjectInfo() {
   }
 }
 
+void ProjectInfo::CompileTargetPrograms() {
+  target_programs_.reserve(target_list_.size());
+  for (const auto &target : target_list_) {
+    target_programs_.push_back(
+        expression::ExpressionProgram::Compile(target.second.expr));
+  }
+}
+
 /**
  * @brief Evaluate projections from one or two source tuples and
  * put result in destination.
@@ -53,10 +61,13 @@ bool ProjectInfo::Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
   if (econtext != nullptr) pool = econtext->GetPool();
 
   // (A) Execute target list
-  for (auto target : target_list_) {
-    auto col_id = target.first;
-    auto expr = target.second.expr;
-    auto value = expr->Evaluate(tuple1, tuple2, econtext);
+  for (size_t i = 0; i < target_list_.size(); i++) {
+    auto col_id = target_list_[i].first;
+    auto *program = target_programs_[i].get();
+    auto value = (program != nullptr)
+                     ? program->Evaluate(tuple1, tuple2, econtext)
+                     : target_list_[i].second.expr->Evaluate(tuple1, tuple2,
+                                                             econtext);
 
     dest->SetValue(col_id, value, pool);
   }
@@ -84,10 +95,13 @@ bool ProjectInfo::Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
                            const AbstractTuple *tuple2,
                            executor::ExecutorContext *econtext) const {
   // (A) Execute target list
-  for (auto target : target_list_) {
-    auto col_id = target.first;
-    auto expr = target.second.expr;
-    auto value = expr->Evaluate(tuple1, tuple2, econtext);
+  for (size_t i = 0; i < target_list_.size(); i++) {
+    auto col_id = target_list_[i].first;
+    auto *program = target_programs_[i].get();
+    auto value = (program != nullptr)
+                     ? program->Evaluate(tuple1, tuple2, econtext)
+                     : target_list_[i].second.expr->Evaluate(tuple1, tuple2,
+                                                             econtext);
     dest->SetValue(col_id, value);
   }
 
@@ -31,15 +31,15 @@ namespace peloton {
 namespace settings {
 
 int32_t SettingsManager::GetInt(SettingId id) {
-  return GetInstance().GetValue(id).GetAs<int32_t>();
+  return GetCurrentSnapshot()->GetInt(id);
 }
 
 double SettingsManager::GetDouble(SettingId id) {
-  return GetInstance().GetValue(id).GetAs<double>();
+  return GetCurrentSnapshot()->GetDouble(id);
 }
 
 bool SettingsManager::GetBool(SettingId id) {
-  return GetInstance().GetValue(id).GetAs<bool>();
+  return GetCurrentSnapshot()->GetBool(id);
 }
 
 std::string SettingsManager::GetString(SettingId id) {
@@ -63,6 +63,20 @@ SettingsManager &SettingsManager::GetInstance() {
   return settings_manager;
 }
 
+const SettingsSnapshot *SettingsManager::GetCurrentSnapshot() {
+  // the thread-local shared_ptr keeps a superseded snapshot alive for
+  // readers that are still holding it while a SET swaps in a new one
+  static thread_local std::shared_ptr<SettingsSnapshot> local_snapshot;
+
+  auto &instance = GetInstance();
+  if (local_snapshot.get() == nullptr ||
+      local_snapshot->version !=
+          instance.snapshot_version_.load(std::memory_order_acquire)) {
+    local_snapshot = std::atomic_load(&instance.snapshot_);
+  }
+  return local_snapshot.get();
+}
+
 void SettingsManager::InitializeCatalog() {
   auto &settings_catalog = peloton::catalog::SettingsCatalog::GetInstance();
 
@@ -140,6 +154,36 @@ void SettingsManager::SetValue(SettingId id, const type::Value &value) {
     }
   }
   param->second.value = value;
+
+  RebuildSnapshot();
+}
+
+void SettingsManager::RebuildSnapshot() {
+  std::shared_ptr<SettingsSnapshot> snapshot(new SettingsSnapshot());
+  snapshot->version = snapshot_version_.load(std::memory_order_relaxed) + 1;
+
+  for (auto &s : settings_) {
+    size_t idx = static_cast<size_t>(s.first);
+    switch (s.second.value.GetTypeId()) {
+      case type::TypeId::INTEGER:
+        snapshot->int_values[idx] = s.second.value.GetAs<int32_t>();
+        break;
+      case type::TypeId::DECIMAL:
+        snapshot->double_values[idx] = s.second.value.GetAs<double>();
+        break;
+      case type::TypeId::BOOLEAN:
+        snapshot->bool_values[idx] = s.second.value.GetAs<bool>();
+        break;
+      default:
+        // string settings are served from the internal map
+        break;
+    }
+  }
+
+  // publish the snapshot before bumping the version so that readers that
+  // observe the new version always reload the new snapshot
+  std::atomic_store(&snapshot_, snapshot);
+  snapshot_version_.store(snapshot->version, std::memory_order_release);
 }
 
 bool SettingsManager::InsertIntoCatalog(const Param &param) {
@@ -160,7 +204,7 @@ bool SettingsManager::InsertIntoCatalog(const Param &param) {
   return true;
 }
 
-SettingsManager::SettingsManager() {
+SettingsManager::SettingsManager() : snapshot_version_(0) {
   catalog_initialized_ = false;
   pool_.reset(new type::EphemeralPool());
 
@@ -170,6 +214,8 @@ SettingsManager::SettingsManager() {
   #include "settings/settings_macro.h"
   #include "settings/settings.h"
   #undef __SETTING_DEFINE__
+
+  RebuildSnapshot();
 }
 
 }  // namespace settings
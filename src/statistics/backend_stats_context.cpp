@@ -107,13 +107,50 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+HistogramMetric* BackendStatsContext::GetQueryLatencyHistogram(
+    QueryType query_type) {
+  auto entry = query_latency_histograms_.find(query_type);
+  if (entry == query_latency_histograms_.end()) {
+    auto result = query_latency_histograms_.emplace(
+        query_type, std::unique_ptr<HistogramMetric>(
+                        new HistogramMetric{MetricType::HISTOGRAM}));
+    entry = result.first;
+  }
+  return entry->second.get();
+}
+
+// Resolve the table metric for a tile group, going through the catalog and
+// the metric map only when the slot cache misses. Sequential operations
+// against the same tile group (the common case for scans and bulk loads)
+// reduce to a plain per-thread counter bump.
+TableMetric* BackendStatsContext::GetCachedTableMetric(oid_t tile_group_id) {
+  if (table_metric_slot_.tile_group_id == tile_group_id) {
+    return table_metric_slot_.metric;
+  }
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  auto table_metric =
+      GetTableMetric(tile_group->GetDatabaseId(), tile_group->GetTableId());
+  table_metric_slot_.tile_group_id = tile_group_id;
+  table_metric_slot_.metric = table_metric;
+  return table_metric;
+}
+
+// Resolve the index metric for an index, bypassing the CuckooMap find and
+// its shared_ptr refcounting when the slot cache hits
+IndexMetric* BackendStatsContext::GetCachedIndexMetric(
+    index::IndexMetadata* metadata) {
+  if (index_metric_slot_.metadata == metadata) {
+    return index_metric_slot_.metric;
+  }
+  auto index_metric = GetIndexMetric(
+      metadata->GetDatabaseOid(), metadata->GetTableOid(), metadata->GetOid());
+  index_metric_slot_.metadata = metadata;
+  index_metric_slot_.metric = index_metric;
+  return index_metric;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
+  auto table_metric = GetCachedTableMetric(tile_group_id);
   PL_ASSERT(table_metric != nullptr);
   table_metric->GetTableAccess().IncrementReads();
   if (ongoing_query_metric_ != nullptr) {
@@ -122,12 +159,7 @@ void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
 }
 
 void BackendStatsContext::IncrementTableInserts(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
+  auto table_metric = GetCachedTableMetric(tile_group_id);
   PL_ASSERT(table_metric != nullptr);
   table_metric->GetTableAccess().IncrementInserts();
   if (ongoing_query_metric_ != nullptr) {
@@ -136,12 +168,7 @@ void BackendStatsContext::IncrementTableInserts(oid_t tile_group_id) {
 }
 
 void BackendStatsContext::IncrementTableUpdates(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
+  auto table_metric = GetCachedTableMetric(tile_group_id);
   PL_ASSERT(table_metric != nullptr);
   table_metric->GetTableAccess().IncrementUpdates();
   if (ongoing_query_metric_ != nullptr) {
@@ -150,12 +177,7 @@ void BackendStatsContext::IncrementTableUpdates(oid_t tile_group_id) {
 }
 
 void BackendStatsContext::IncrementTableDeletes(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
+  auto table_metric = GetCachedTableMetric(tile_group_id);
   PL_ASSERT(table_metric != nullptr);
   table_metric->GetTableAccess().IncrementDeletes();
   if (ongoing_query_metric_ != nullptr) {
@@ -165,40 +187,28 @@ void BackendStatsContext::IncrementTableDeletes(oid_t tile_group_id) {
 
 void BackendStatsContext::IncrementIndexReads(size_t read_count,
                                               index::IndexMetadata* metadata) {
-  oid_t index_id = metadata->GetOid();
-  oid_t table_id = metadata->GetTableOid();
-  oid_t database_id = metadata->GetDatabaseOid();
-  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  auto index_metric = GetCachedIndexMetric(metadata);
   PL_ASSERT(index_metric != nullptr);
   index_metric->GetIndexAccess().IncrementReads(read_count);
 }
 
 void BackendStatsContext::IncrementIndexInserts(
     index::IndexMetadata* metadata) {
-  oid_t index_id = metadata->GetOid();
-  oid_t table_id = metadata->GetTableOid();
-  oid_t database_id = metadata->GetDatabaseOid();
-  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  auto index_metric = GetCachedIndexMetric(metadata);
   PL_ASSERT(index_metric != nullptr);
   index_metric->GetIndexAccess().IncrementInserts();
 }
 
 void BackendStatsContext::IncrementIndexUpdates(
     index::IndexMetadata* metadata) {
-  oid_t index_id = metadata->GetOid();
-  oid_t table_id = metadata->GetTableOid();
-  oid_t database_id = metadata->GetDatabaseOid();
-  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  auto index_metric = GetCachedIndexMetric(metadata);
   PL_ASSERT(index_metric != nullptr);
   index_metric->GetIndexAccess().IncrementUpdates();
 }
 
 void BackendStatsContext::IncrementIndexDeletes(
     size_t delete_count, index::IndexMetadata* metadata) {
-  oid_t index_id = metadata->GetOid();
-  oid_t table_id = metadata->GetTableOid();
-  oid_t database_id = metadata->GetDatabaseOid();
-  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  auto index_metric = GetCachedIndexMetric(metadata);
   PL_ASSERT(index_metric != nullptr);
   index_metric->GetIndexAccess().IncrementDeletes(delete_count);
 }
@@ -223,6 +233,16 @@ void BackendStatsContext::InitQueryMetric(
   // TODO currently all queries belong to DEFAULT_DB
   ongoing_query_metric_.reset(new QueryMetric(
       MetricType::QUERY, statement->GetQueryString(), params, DEFAULT_DB_ID));
+  ongoing_query_type_ = statement->GetQueryType();
+}
+
+void BackendStatsContext::RecordPipelineStat(uint32_t pipeline_id,
+                                             const char *pipeline_info,
+                                             uint64_t cycles, uint64_t rows) {
+  auto *query_metric = GetOnGoingQueryMetric();
+  if (query_metric != nullptr) {
+    query_metric->RecordPipelineStat(pipeline_id, pipeline_info, cycles, rows);
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -234,6 +254,13 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
 
+  // Merge the per-query-type latency histograms; bucket counts add, so the
+  // merged percentiles are exact across backends
+  for (auto& histogram_item : source.query_latency_histograms_) {
+    GetQueryLatencyHistogram(histogram_item.first)
+        ->Aggregate(*histogram_item.second);
+  }
+
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
     GetDatabaseMetric(database_item.first)->Aggregate(*database_item.second);
@@ -268,6 +295,10 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
 
+  for (auto& histogram_item : query_latency_histograms_) {
+    histogram_item.second->Reset();
+  }
+
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
   }
@@ -364,8 +395,12 @@ void BackendStatsContext::CompleteQueryMetric() {
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetProcessorMetric().RecordTime();
     ongoing_query_metric_->GetQueryLatency().RecordLatency();
+    GetQueryLatencyHistogram(ongoing_query_type_)
+        ->RecordLatency(ongoing_query_metric_->GetQueryLatency()
+                            .GetFirstLatencyValue());
     completed_query_metrics_.Enqueue(ongoing_query_metric_);
     ongoing_query_metric_.reset();
+    ongoing_query_type_ = QueryType::QUERY_INVALID;
     LOG_TRACE("Ongoing query completed");
   }
 }
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// histogram_metric.cpp
+//
+// Identification: src/statistics/histogram_metric.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/histogram_metric.h"
+
+#include <sstream>
+
+namespace peloton {
+namespace stats {
+
+const size_t HistogramMetric::kSubBucketBits;
+const size_t HistogramMetric::kSubBucketCount;
+const size_t HistogramMetric::kBucketGroups;
+const size_t HistogramMetric::kNumBuckets;
+
+HistogramMetric::HistogramMetric(MetricType type) : AbstractMetric(type) {
+  Reset();
+}
+
+size_t HistogramMetric::BucketFor(uint64_t value_us) {
+  if (value_us < kSubBucketCount) {
+    // group 0: one bucket per value
+    return static_cast<size_t>(value_us);
+  }
+  // position of the highest set bit selects the group, the next
+  // kSubBucketBits bits select the linear sub-bucket within it
+  size_t msb = 63 - __builtin_clzll(value_us);
+  size_t group = msb - kSubBucketBits + 1;
+  size_t sub_bucket =
+      (value_us >> (msb - kSubBucketBits)) & (kSubBucketCount - 1);
+  size_t bucket = group * kSubBucketCount + sub_bucket;
+  return (bucket < kNumBuckets) ? bucket : (kNumBuckets - 1);
+}
+
+uint64_t HistogramMetric::BucketLowerBound(size_t bucket) {
+  size_t group = bucket / kSubBucketCount;
+  uint64_t sub_bucket = bucket % kSubBucketCount;
+  if (group == 0) {
+    return sub_bucket;
+  }
+  return (kSubBucketCount + sub_bucket) << (group - 1);
+}
+
+void HistogramMetric::RecordLatency(double latency_ms) {
+  if (latency_ms < 0.0) {
+    return;
+  }
+  uint64_t value_us = static_cast<uint64_t>(latency_ms * 1000.0);
+  counts_[BucketFor(value_us)]++;
+  total_count_++;
+  if (value_us > max_value_us_) {
+    max_value_us_ = value_us;
+  }
+}
+
+double HistogramMetric::GetPercentile(double fraction) const {
+  if (total_count_ == 0) {
+    return 0.0;
+  }
+  int64_t target = static_cast<int64_t>(fraction * total_count_);
+  if (target >= total_count_) {
+    target = total_count_ - 1;
+  }
+  int64_t cumulative = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; bucket++) {
+    cumulative += counts_[bucket];
+    if (cumulative > target) {
+      return static_cast<double>(BucketLowerBound(bucket)) / 1000.0;
+    }
+  }
+  return GetMaxLatency();
+}
+
+void HistogramMetric::Reset() {
+  PL_MEMSET(counts_, 0, sizeof(counts_));
+  total_count_ = 0;
+  max_value_us_ = 0;
+}
+
+void HistogramMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == MetricType::HISTOGRAM);
+  HistogramMetric &source_histogram = static_cast<HistogramMetric &>(source);
+  for (size_t bucket = 0; bucket < kNumBuckets; bucket++) {
+    counts_[bucket] += source_histogram.counts_[bucket];
+  }
+  total_count_ += source_histogram.total_count_;
+  if (source_histogram.max_value_us_ > max_value_us_) {
+    max_value_us_ = source_histogram.max_value_us_;
+  }
+}
+
+const std::string HistogramMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "[ count=" << total_count_ << ", p50=" << GetPercentile(0.5)
+     << "ms, p95=" << GetPercentile(0.95) << "ms, p99=" << GetPercentile(0.99)
+     << "ms, p999=" << GetPercentile(0.999) << "ms, max=" << GetMaxLatency()
+     << "ms ]";
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
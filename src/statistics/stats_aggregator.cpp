@@ -17,8 +17,13 @@
 #include "catalog/database_metrics_catalog.h"
 #include "catalog/table_metrics_catalog.h"
 #include "catalog/index_metrics_catalog.h"
+#include "catalog/latency_metrics_catalog.h"
 #include "catalog/query_metrics_catalog.h"
+#include "catalog/query_progress_catalog.h"
+#include "codegen/query_cache.h"
+#include "common/synchronization/mcs_latch.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "executor/query_progress_registry.h"
 #include "index/index.h"
 #include "storage/storage_manager.h"
 #include "type/ephemeral_pool.h"
@@ -113,9 +118,17 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   LOG_TRACE("Moving avg. throughput: %lf txn/s", weighted_avg_throughput);
   LOG_TRACE("Current throughput:     %lf txn/s", throughput_);
 
+  auto &query_cache = codegen::QueryCache::Instance();
+  LOG_TRACE("Query cache: %" PRIu64 " hits, %" PRIu64 " misses, %zu bytes",
+            query_cache.GetHitCount(), query_cache.GetMissCount(),
+            query_cache.GetMemoryBytes());
+
   // Write the stats to metric tables
   UpdateMetrics();
 
+  // Publish the flat text snapshot for the metrics export endpoint
+  PublishExportSnapshot();
+
   if (interval_cnt % STATS_LOG_INTERVALS == 0) {
     try {
       ofs_ << "At interval: " << interval_cnt << std::endl;
@@ -123,13 +136,77 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
       ofs_ << "Weighted avg. throughput=" << weighted_avg_throughput
            << std::endl;
       ofs_ << "Average throughput=" << avg_throughput_ << std::endl;
-      ofs_ << "Current throughput=" << throughput_;
+      ofs_ << "Current throughput=" << throughput_ << std::endl;
+      ofs_ << "Query cache hits=" << query_cache.GetHitCount()
+           << " misses=" << query_cache.GetMissCount()
+           << " bytes=" << query_cache.GetMemoryBytes();
     } catch (std::ofstream::failure &e) {
       LOG_ERROR("Error when writing to the stats log file %s", e.what());
     }
   }
 }
 
+std::shared_ptr<const std::string> StatsAggregator::GetExportSnapshot() {
+  return std::atomic_load(&export_snapshot_);
+}
+
+void StatsAggregator::PublishExportSnapshot() {
+  std::stringstream ss;
+
+  // transaction counters per database
+  for (auto &database_item : aggregated_stats_.database_metrics_) {
+    oid_t database_id = database_item.second->GetDatabaseId();
+    ss << "txn_committed{database=\"" << database_id << "\"} "
+       << database_item.second->GetTxnCommitted().GetCounter() << "\n";
+    ss << "txn_aborted{database=\"" << database_id << "\"} "
+       << database_item.second->GetTxnAborted().GetCounter() << "\n";
+  }
+
+  // access counters per table
+  for (auto &table_item : aggregated_stats_.table_metrics_) {
+    auto &table_metric = table_item.second;
+    auto &table_access = table_metric->GetTableAccess();
+    std::string labels = "{database=\"" +
+                         std::to_string(table_metric->GetDatabaseId()) +
+                         "\",table=\"" + table_metric->GetName() + "\"}";
+    ss << "table_reads" << labels << " " << table_access.GetReads() << "\n";
+    ss << "table_updates" << labels << " " << table_access.GetUpdates() << "\n";
+    ss << "table_inserts" << labels << " " << table_access.GetInserts() << "\n";
+    ss << "table_deletes" << labels << " " << table_access.GetDeletes() << "\n";
+  }
+
+  // access counters per index
+  for (auto index_id : aggregated_stats_.index_ids_) {
+    std::shared_ptr<IndexMetric> index_metric;
+    aggregated_stats_.index_metrics_.Find(index_id, index_metric);
+    if (index_metric == nullptr) continue;
+    auto &index_access = index_metric->GetIndexAccess();
+    std::string labels = "{database=\"" +
+                         std::to_string(index_metric->GetDatabaseId()) +
+                         "\",index=\"" + index_metric->GetName() + "\"}";
+    ss << "index_reads" << labels << " " << index_access.GetReads() << "\n";
+    ss << "index_inserts" << labels << " " << index_access.GetInserts() << "\n";
+    ss << "index_deletes" << labels << " " << index_access.GetDeletes() << "\n";
+  }
+
+  // transaction latency measurements in milliseconds
+  auto &txn_latency = aggregated_stats_.GetTxnLatencyMetric();
+  txn_latency.ComputeLatencies();
+  auto &measurements = txn_latency.GetMeasurements();
+  ss << "txn_latency_average_ms " << measurements.average_ << "\n";
+  ss << "txn_latency_median_ms " << measurements.median_ << "\n";
+  ss << "txn_latency_p99_ms " << measurements.perc_99th_ << "\n";
+  ss << "txn_latency_max_ms " << measurements.max_ << "\n";
+
+  ss << "query_count " << aggregated_stats_.GetQueryCount() << "\n";
+
+  // contention counters for every named queued latch
+  ss << common::synchronization::McsLatch::GetStatsInfo();
+
+  std::shared_ptr<const std::string> snapshot(new std::string(ss.str()));
+  std::atomic_store(&export_snapshot_, snapshot);
+}
+
 void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
                                          concurrency::TransactionContext *txn) {
   // Get the target query metrics table
@@ -182,6 +259,24 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
   }
 }
 
+void StatsAggregator::UpdateLatencyMetrics(
+    int64_t time_stamp, concurrency::TransactionContext *txn) {
+  // Publish the merged per-query-type latency histograms so tail latency is
+  // queryable (and alertable) from inside the DB
+  for (auto &histogram_item : aggregated_stats_.GetQueryLatencyHistograms()) {
+    auto *histogram = histogram_item.second.get();
+    if (histogram->GetTotalCount() == 0) {
+      continue;
+    }
+    catalog::LatencyMetricsCatalog::GetInstance()->InsertLatencyMetrics(
+        QueryTypeToString(histogram_item.first), histogram->GetTotalCount(),
+        histogram->GetPercentile(0.5), histogram->GetPercentile(0.95),
+        histogram->GetPercentile(0.99), histogram->GetPercentile(0.999),
+        histogram->GetMaxLatency(), time_stamp, pool_.get(), txn);
+    LOG_TRACE("Latency Metric Tuple inserted");
+  }
+}
+
 void StatsAggregator::UpdateMetrics() {
   // All tuples are inserted in a single txn
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -217,9 +312,39 @@ void StatsAggregator::UpdateMetrics() {
   // Update all query metrics
   UpdateQueryMetrics(time_stamp, txn);
 
+  // Update the per-query-type latency histograms
+  UpdateLatencyMetrics(time_stamp, txn);
+
+  // Refresh the live query snapshot
+  UpdateQueryProgress(txn);
+
   txn_manager.CommitTransaction(txn);
 }
 
+void StatsAggregator::UpdateQueryProgress(
+    concurrency::TransactionContext *txn) {
+  auto *progress_catalog = catalog::QueryProgressCatalog::GetInstance();
+
+  // drop the rows published last interval; finished queries disappear and
+  // still-running ones come back below with fresh counters
+  for (auto query_id : published_progress_ids_) {
+    progress_catalog->DeleteQueryProgress(query_id, txn);
+  }
+  published_progress_ids_.clear();
+
+  auto snapshot =
+      executor::QueryProgressRegistry::GetInstance().GetSnapshot();
+  for (auto &row : snapshot) {
+    progress_catalog->InsertQueryProgress(
+        row.query_id, row.query_text, row.start_time_us, row.elapsed_us,
+        static_cast<int64_t>(row.rows_produced), row.phase,
+        static_cast<int64_t>(row.memory_bytes), row.cancel_requested,
+        pool_.get(), txn);
+    published_progress_ids_.push_back(row.query_id);
+  }
+  LOG_TRACE("Query progress rows inserted: %lu", snapshot.size());
+}
+
 void StatsAggregator::UpdateTableMetrics(storage::Database *database,
                                          int64_t time_stamp,
                                          concurrency::TransactionContext *txn) {
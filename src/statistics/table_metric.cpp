@@ -34,6 +34,8 @@ void TableMetric::Aggregate(AbstractMetric& source) {
 
   TableMetric& table_metric = static_cast<TableMetric&>(source);
   table_access_.Aggregate(table_metric.GetTableAccess());
+  cold_tier_hits_.Aggregate(table_metric.GetColdTierHits());
+  cold_tier_misses_.Aggregate(table_metric.GetColdTierMisses());
 }
 
 }  // namespace stats
@@ -29,6 +29,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/internal_types.h"
+#include "storage/slab_allocator.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -449,7 +450,9 @@ void *BackendManager::Allocate(BackendType type, size_t size) {
   switch (type) {
     case BackendType::MM:
     case BackendType::NVM: {
-      return ::operator new(size);
+      // Serve tile-sized allocations from the slab allocator; it falls
+      // back to the global heap for sizes outside its range
+      return SlabAllocator::GetInstance().Allocate(size);
     } break;
 
     case BackendType::SSD:
@@ -496,7 +499,7 @@ void BackendManager::Release(BackendType type, void *address) {
   switch (type) {
     case BackendType::MM:
     case BackendType::NVM: {
-      ::operator delete(address);
+      SlabAllocator::GetInstance().Release(address);
     } break;
 
     case BackendType::SSD:
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cold_tier_cache.cpp
+//
+// Identification: src/storage/cold_tier_cache.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/cold_tier_cache.h"
+
+#include <vector>
+
+#include "common/logger.h"
+#include "settings/settings_manager.h"
+#include "statistics/backend_stats_context.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+ColdTierCache &ColdTierCache::GetInstance() {
+  static ColdTierCache cold_tier_cache;
+  return cold_tier_cache;
+}
+
+ColdTierCache::Partition &ColdTierCache::GetPartition(
+    const oid_t table_id, const size_t budget_bytes) {
+  std::lock_guard<std::mutex> guard(partition_mutex_);
+  auto &partition = partitions_[table_id];
+  if (partition == nullptr) {
+    partition.reset(new Partition(budget_bytes));
+  } else {
+    // pick up runtime changes to the budget setting
+    partition->SetBudget(budget_bytes);
+  }
+  return *partition;
+}
+
+void ColdTierCache::OnTileGroupAccess(TileGroup *tile_group) {
+  int budget_mb = settings::SettingsManager::GetInt(
+      settings::SettingId::cold_tier_cache_budget_mb);
+  if (budget_mb <= 0) {
+    return;
+  }
+  size_t budget_bytes = static_cast<size_t>(budget_mb) * 1024 * 1024;
+  bool stats_enabled =
+      static_cast<StatsType>(settings::SettingsManager::GetInt(
+          settings::SettingId::stats_mode)) != StatsType::INVALID;
+
+  oid_t tile_count = tile_group->GetTileCount();
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    Tile *tile = tile_group->GetTile(tile_itr);
+    if (tile == nullptr || tile->IsMemoryMapped() == false) {
+      continue;
+    }
+
+    auto &partition = GetPartition(tile->GetTableId(), budget_bytes);
+
+    bool promoted = false;
+    if (partition.Touch(tile->GetTileId(), promoted) == true) {
+      if (promoted == true) {
+        // second touch: this tile earned residency, fault it in ahead of
+        // the reads
+        tile->AdviseWillNeed();
+      }
+      if (stats_enabled == true) {
+        stats::BackendStatsContext::GetInstance()
+            ->GetTableMetric(tile->GetDatabaseId(), tile->GetTableId())
+            ->GetColdTierHits()
+            .Increment();
+      }
+    } else {
+      std::vector<Tile *> evicted;
+      partition.Insert(tile->GetTileId(), tile, tile->GetSize(), evicted);
+      // a one-pass scan only ever recycles these probationary victims,
+      // never the protected working set
+      for (auto *victim : evicted) {
+        victim->DropResidentPages();
+      }
+      if (stats_enabled == true) {
+        stats::BackendStatsContext::GetInstance()
+            ->GetTableMetric(tile->GetDatabaseId(), tile->GetTableId())
+            ->GetColdTierMisses()
+            .Increment();
+      }
+    }
+  }
+}
+
+void ColdTierCache::OnTileRelease(Tile *tile) {
+  std::lock_guard<std::mutex> guard(partition_mutex_);
+  auto partition_entry = partitions_.find(tile->GetTableId());
+  if (partition_entry != partitions_.end()) {
+    partition_entry->second->Erase(tile->GetTileId());
+  }
+}
+
+uint64_t ColdTierCache::GetHitCount(const oid_t table_id) {
+  std::lock_guard<std::mutex> guard(partition_mutex_);
+  auto partition_entry = partitions_.find(table_id);
+  return partition_entry == partitions_.end()
+             ? 0
+             : partition_entry->second->GetHitCount();
+}
+
+uint64_t ColdTierCache::GetMissCount(const oid_t table_id) {
+  std::lock_guard<std::mutex> guard(partition_mutex_);
+  auto partition_entry = partitions_.find(table_id);
+  return partition_entry == partitions_.end()
+             ? 0
+             : partition_entry->second->GetMissCount();
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <limits>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include "brain/clusterer.h"
@@ -28,6 +31,7 @@
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
+#include "settings/settings_manager.h"
 #include "storage/abstract_table.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
@@ -37,6 +41,7 @@
 #include "storage/tile_group_factory.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "type/value_factory.h"
 
 //===--------------------------------------------------------------------===//
 // Configuration Variables
@@ -56,6 +61,15 @@ oid_t DataTable::invalid_tile_group_id = -1;
 size_t DataTable::default_active_tilegroup_count_ = 1;
 size_t DataTable::default_active_indirection_array_count_ = 1;
 
+namespace {
+
+// Sharding of each table's recycled-slot cache, and how many slots a shard
+// pulls from the GC manager's shared queue at a time when it runs dry
+const size_t kRecycledSlotShardCount = 16;
+const size_t kRecycledSlotRefillBatch = 32;
+
+}  // namespace
+
 DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
                      const oid_t &database_oid, const oid_t &table_oid,
                      const size_t &tuples_per_tilegroup, const bool own_schema,
@@ -65,6 +79,7 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
       database_oid(database_oid),
       table_name(table_name),
       tuples_per_tilegroup_(tuples_per_tilegroup),
+      adaptive_tuples_per_tilegroup_(tuples_per_tilegroup),
       adapt_table_(adapt_table),
       trigger_list_(new trigger::TriggerList()) {
 
@@ -77,14 +92,33 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
   if (is_catalog == true) {
     active_tilegroup_count_ = 1;
     active_indirection_array_count_ = 1;
+    // catalog tables see little insert concurrency
+    max_active_tilegroup_count_ = 1;
   } else {
     active_tilegroup_count_ = default_active_tilegroup_count_;
     active_indirection_array_count_ = default_active_indirection_array_count_;
+    max_active_tilegroup_count_ =
+        std::max(default_active_tilegroup_count_,
+                 static_cast<size_t>(std::thread::hardware_concurrency()));
   }
 
-  active_tile_groups_.resize(active_tilegroup_count_);
+  // pre-size to the maximum so growing the active set never reallocates the
+  // vectors while inserters read them
+  active_tile_groups_.resize(max_active_tilegroup_count_);
+
+  recycled_slot_shards_.reserve(kRecycledSlotShardCount);
+  for (size_t shard_itr = 0; shard_itr < kRecycledSlotShardCount;
+       shard_itr++) {
+    recycled_slot_shards_.push_back(
+        std::make_shared<LockFreeQueue<ItemPointer>>(
+            kRecycledSlotRefillBatch));
+  }
+
+  active_tilegroup_numa_nodes_.resize(max_active_tilegroup_count_,
+                                      INVALID_NUMA_NODE);
 
   active_indirection_arrays_.resize(active_indirection_array_count_);
+  prepared_indirection_arrays_.resize(active_indirection_array_count_);
   // Create tile groups.
   for (size_t i = 0; i < active_tilegroup_count_; ++i) {
     AddDefaultTileGroup(i);
@@ -231,12 +265,103 @@ bool DataTable::CheckConstraints(const AbstractTuple *tuple) const {
 // in-place update at executor level.
 // however, when performing insert, we have to copy data immediately,
 // and the argument cannot be set to nullptr.
+namespace {
+
+// Each thread that ever claims a tuple slot gets a small dense id, used to
+// pick its insert stripe. Ids are process-wide, so a thread maps to the
+// same stripe in every table.
+std::atomic<size_t> next_inserter_thread_id(0);
+thread_local size_t inserter_thread_id = std::numeric_limits<size_t>::max();
+
+size_t GetInserterThreadId() {
+  if (inserter_thread_id == std::numeric_limits<size_t>::max()) {
+    inserter_thread_id = next_inserter_thread_id.fetch_add(1);
+  }
+  return inserter_thread_id;
+}
+
+
+}  // namespace
+
+size_t DataTable::GetActiveTileGroupId() const {
+  return GetInserterThreadId() % active_tilegroup_count_.load();
+}
+
+void DataTable::GrowActiveTileGroups(size_t target_count) {
+  if (target_count > max_active_tilegroup_count_) {
+    target_count = max_active_tilegroup_count_;
+  }
+
+  std::lock_guard<std::mutex> lock(tilegroup_grow_mutex_);
+  size_t current_count = active_tilegroup_count_.load();
+  if (target_count <= current_count) {
+    return;
+  }
+
+  // Fill the new stripes before publishing the larger count, so any stripe
+  // an inserter can pick already has a tile group
+  for (size_t active_tile_group_id = current_count;
+       active_tile_group_id < target_count; active_tile_group_id++) {
+    AddDefaultTileGroup(active_tile_group_id);
+  }
+
+  active_tilegroup_count_.store(target_count);
+
+  LOG_TRACE("Grew active tile group count to %lu", target_count);
+}
+
+ItemPointer DataTable::GetRecycledTupleSlot() {
+  auto &shard = *recycled_slot_shards_[GetInserterThreadId() %
+                                       kRecycledSlotShardCount];
+  auto &catalog_manager = catalog::Manager::GetInstance();
+
+  // A recycled slot is only usable while its tile group still takes
+  // writes: slots queued before the compaction service made their tile
+  // group immutable (or retired it) are discarded here. Reusing a slot
+  // un-deadens it for the compactor's accounting.
+  auto claim_slot = [&catalog_manager](const ItemPointer &slot) {
+    auto tile_group = catalog_manager.GetTileGroup(slot.block);
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->GetImmutability() == true) {
+      return false;
+    }
+    tile_group->GetHeader()->DecrementDeadTupleCount();
+    return true;
+  };
+
+  ItemPointer free_item_pointer;
+  while (shard.Dequeue(free_item_pointer) == true) {
+    if (claim_slot(free_item_pointer) == true) {
+      return free_item_pointer;
+    }
+  }
+
+  // The shard is dry: pull a batch from the GC manager's shared per-table
+  // queue, keep the first usable slot and cache the rest in the shard, so
+  // the shared dequeue (and its table lookup) is paid once per batch
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+  std::vector<ItemPointer> refill;
+  if (gc_manager.ReturnFreeSlots(this->table_oid, kRecycledSlotRefillBatch,
+                                 refill) == 0) {
+    return INVALID_ITEMPOINTER;
+  }
+  ItemPointer claimed = INVALID_ITEMPOINTER;
+  for (size_t slot_itr = 0; slot_itr < refill.size(); slot_itr++) {
+    if (claimed.IsNull() == true && claim_slot(refill[slot_itr]) == true) {
+      claimed = refill[slot_itr];
+    } else {
+      shard.Enqueue(refill[slot_itr]);
+    }
+  }
+  return claimed;
+}
+
 ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   //=============== garbage collection==================
   // check if there are recycled tuple slots
-  auto &gc_manager = gc::GCManagerFactory::GetInstance();
-  auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+  auto free_item_pointer = GetRecycledTupleSlot();
   if (free_item_pointer.IsNull() == false) {
+    recycled_slot_hits_.fetch_add(1);
     // when inserting a tuple
     if (tuple != nullptr) {
       auto tile_group =
@@ -245,9 +370,19 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
     }
     return free_item_pointer;
   }
+  recycled_slot_misses_.fetch_add(1);
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  // Sample insert concurrency: when more threads are claiming slots than
+  // there are stripes, the per-tile-group slot counters are contended, so
+  // grow the active set
+  size_t concurrent_inserters = active_inserter_count_.fetch_add(1) + 1;
+  if (concurrent_inserters > active_tilegroup_count_.load() &&
+      active_tilegroup_count_.load() < max_active_tilegroup_count_) {
+    GrowActiveTileGroups(concurrent_inserters);
+  }
+
+  size_t active_tile_group_id = GetActiveTileGroupId();
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
@@ -266,6 +401,8 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
     }
   }
 
+  active_inserter_count_.fetch_sub(1);
+
   // if this is the last tuple slot we can get
   // then create a new tile group
   if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
@@ -282,6 +419,74 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   return location;
 }
 
+bool DataTable::GetEmptyTupleSlots(
+    const std::vector<const storage::Tuple *> &tuples,
+    std::vector<ItemPointer> &locations) {
+  size_t tuple_count = tuples.size();
+  size_t tuple_itr = 0;
+
+  //=============== garbage collection==================
+  // recycled slots are scattered across tile groups, so they are still
+  // consumed one at a time before falling back to batched reservation
+  while (tuple_itr < tuple_count) {
+    auto free_item_pointer = GetRecycledTupleSlot();
+    if (free_item_pointer.IsNull() == true) {
+      break;
+    }
+    recycled_slot_hits_.fetch_add(1);
+    auto tile_group =
+        catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
+    tile_group->CopyTuple(tuples[tuple_itr], free_item_pointer.offset);
+    locations.push_back(free_item_pointer);
+    tuple_itr++;
+  }
+  if (tuple_itr == tuple_count) {
+    return true;
+  }
+  recycled_slot_misses_.fetch_add(1);
+  //====================================================
+
+  // Sample insert concurrency, as in GetEmptyTupleSlot()
+  size_t concurrent_inserters = active_inserter_count_.fetch_add(1) + 1;
+  if (concurrent_inserters > active_tilegroup_count_.load() &&
+      active_tilegroup_count_.load() < max_active_tilegroup_count_) {
+    GrowActiveTileGroups(concurrent_inserters);
+  }
+
+  size_t active_tile_group_id = GetActiveTileGroupId();
+
+  // reserve runs of consecutive slots: one fetch_add covers a whole run,
+  // crossing into the next tile group only when the current one fills up
+  while (tuple_itr < tuple_count) {
+    auto tile_group = active_tile_groups_[active_tile_group_id];
+
+    oid_t first_slot = INVALID_OID;
+    oid_t reserved = tile_group->InsertTupleBatch(
+        tuples, tuple_itr, tuple_count - tuple_itr, first_slot);
+    if (reserved == 0) {
+      // full tile group: wait for the inserter holding the last slot to
+      // install a fresh one, as in GetEmptyTupleSlot()
+      continue;
+    }
+
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+    for (oid_t slot_itr = 0; slot_itr < reserved; slot_itr++) {
+      locations.push_back(ItemPointer(tile_group_id, first_slot + slot_itr));
+    }
+    tuple_itr += reserved;
+
+    // if our run covers the last tuple slot
+    // then create a new tile group
+    if (first_slot + reserved == tile_group->GetAllocatedTupleCount()) {
+      AddDefaultTileGroup(active_tile_group_id);
+    }
+  }
+
+  active_inserter_count_.fetch_sub(1);
+
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // INSERT
 //===--------------------------------------------------------------------===//
@@ -412,6 +617,110 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   return location;
 }
 
+bool DataTable::InsertTupleBatch(
+    const std::vector<const storage::Tuple *> &tuples,
+    concurrency::TransactionContext *transaction,
+    std::vector<ItemPointer> &locations,
+    std::vector<ItemPointer *> &index_entry_ptrs, bool check_fk) {
+  size_t tuple_count = tuples.size();
+
+  locations.clear();
+  locations.reserve(tuple_count);
+  index_entry_ptrs.clear();
+  index_entry_ptrs.reserve(tuple_count);
+
+  for (auto *tuple : tuples) {
+    if (CheckConstraints(tuple) == false) {
+      LOG_TRACE("InsertTupleBatch(): Constraint violated");
+      return false;
+    }
+  }
+
+  // Claim slots for the whole batch in consecutive runs, so the slot
+  // counter is bumped once per run rather than once per tuple
+  if (GetEmptyTupleSlots(tuples, locations) == false) {
+    LOG_TRACE("Failed to get tuple slots.");
+    return false;
+  }
+
+  int index_count = GetIndexCount();
+  if (index_count == 0) {
+    index_entry_ptrs.assign(tuple_count, nullptr);
+  } else {
+    for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      index_entry_ptrs.push_back(AllocateIndirection(locations[tuple_itr]));
+    }
+
+    auto &transaction_manager =
+        concurrency::TransactionManagerFactory::GetInstance();
+
+    std::function<bool(const void *)> fn =
+        std::bind(&concurrency::TransactionManager::IsOccupied,
+                  &transaction_manager, transaction, std::placeholders::_1);
+
+    // Buffer the keys of the whole batch per index, sort them and apply them
+    // with one batched insertion per index. Inserting each index's keys in
+    // sorted order keeps consecutive traversals on mostly the same path.
+    typedef std::pair<std::unique_ptr<storage::Tuple>, ItemPointer *>
+        IndexEntry;
+    for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+      auto index = GetIndex(index_itr);
+      if (index == nullptr) continue;
+      auto index_schema = index->GetKeySchema();
+      auto indexed_columns = index_schema->GetIndexedColumns();
+
+      std::vector<IndexEntry> entries;
+      entries.reserve(tuple_count);
+      for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        std::unique_ptr<storage::Tuple> key(
+            new storage::Tuple(index_schema, true));
+        key->SetFromTuple(tuples[tuple_itr], indexed_columns,
+                          index->GetPool());
+        entries.emplace_back(std::move(key), index_entry_ptrs[tuple_itr]);
+      }
+      std::sort(entries.begin(), entries.end(),
+                [](const IndexEntry &lhs, const IndexEntry &rhs) {
+                  return lhs.first->Compare(*rhs.first) < 0;
+                });
+
+      switch (index->GetIndexType()) {
+        case IndexConstraintType::PRIMARY_KEY:
+        case IndexConstraintType::UNIQUE: {
+          // unique indexes still need the per-key visibility check
+          for (auto &entry : entries) {
+            if (index->CondInsertEntry(entry.first.get(), entry.second, fn) ==
+                false) {
+              LOG_TRACE("Index constraint violated");
+              return false;
+            }
+          }
+        } break;
+
+        case IndexConstraintType::DEFAULT:
+        default:
+          if (index->BulkInsertEntries(entries) == false) {
+            LOG_TRACE("Batched index insertion failed");
+            return false;
+          }
+          break;
+      }
+    }
+  }
+
+  // ForeignKey checks
+  if (check_fk == true) {
+    for (auto *tuple : tuples) {
+      if (CheckForeignKeyConstraints(tuple, transaction) == false) {
+        LOG_TRACE("ForeignKey constraint violated");
+        return false;
+      }
+    }
+  }
+
+  IncreaseTupleCount(tuple_count);
+  return true;
+}
+
 /**
  * @brief Insert a tuple into all indexes. If index is primary/unique,
  * check visibility of existing
@@ -421,36 +730,58 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
  * @returns True on success, false if a visible entry exists (in case of
  *primary/unique).
  */
-bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
-                                ItemPointer location,
-                                concurrency::TransactionContext *transaction,
-                                ItemPointer **index_entry_ptr) {
-  int index_count = GetIndexCount();
-
+ItemPointer *DataTable::AllocateIndirection(ItemPointer location) {
   size_t active_indirection_array_id =
       number_of_tuples_ % active_indirection_array_count_;
 
   size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
 
+  ItemPointer *index_entry_ptr = nullptr;
+
   while (true) {
     auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
+        std::atomic_load(&active_indirection_arrays_[active_indirection_array_id]);
     indirection_offset = active_indirection_array->AllocateIndirection();
 
     if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
+      index_entry_ptr =
           active_indirection_array->GetIndirectionByOffset(indirection_offset);
       break;
     }
   }
 
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
+  index_entry_ptr->block = location.block;
+  index_entry_ptr->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE / 2) {
+    // halfway through the array: build the replacement off the boundary,
+    // so the thread that later crosses it only swaps in a pointer
+    PrepareIndirectionArray(active_indirection_array_id);
+  } else if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    // swap in the pre-built replacement; fall back to building one inline
+    // if the preparation has not happened (e.g. tiny arrays)
+    std::shared_ptr<IndirectionArray> prepared = std::atomic_exchange(
+        &prepared_indirection_arrays_[active_indirection_array_id],
+        std::shared_ptr<IndirectionArray>());
+    if (prepared != nullptr) {
+      std::atomic_store(&active_indirection_arrays_[active_indirection_array_id],
+                        prepared);
+    } else {
+      AddDefaultIndirectionArray(active_indirection_array_id);
+    }
   }
 
+  return index_entry_ptr;
+}
+
+bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
+                                ItemPointer location,
+                                concurrency::TransactionContext *transaction,
+                                ItemPointer **index_entry_ptr) {
+  int index_count = GetIndexCount();
+
+  *index_entry_ptr = AllocateIndirection(location);
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -498,6 +829,13 @@ bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
     LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
   }
 
+  // An online index build is in progress: record the location so the
+  // builder's catch-up phase sees inserts that raced with its scan
+  if (index_build_logging_.load()) {
+    std::lock_guard<std::mutex> lock(index_build_log_mutex_);
+    index_build_log_.push_back(location);
+  }
+
   return true;
 }
 
@@ -832,6 +1170,7 @@ bool DataTable::CheckForeignKeyConstraints(
  */
 void DataTable::IncreaseTupleCount(const size_t &amount) {
   number_of_tuples_ += amount;
+  tuples_modified_since_analyze_ += amount;
   dirty_ = true;
 }
 
@@ -841,6 +1180,7 @@ void DataTable::IncreaseTupleCount(const size_t &amount) {
  */
 void DataTable::DecreaseTupleCount(const size_t &amount) {
   number_of_tuples_ -= amount;
+  tuples_modified_since_analyze_ += amount;
   dirty_ = true;
 }
 
@@ -875,10 +1215,79 @@ void DataTable::ResetDirty() { dirty_ = false; }
 //===--------------------------------------------------------------------===//
 
 TileGroup *DataTable::GetTileGroupWithLayout(
-    const column_map_type &partitioning) {
+    const column_map_type &partitioning, const int numa_node) {
   oid_t tile_group_id = catalog::Manager::GetInstance().GetNextTileGroupId();
-  return (AbstractTable::GetTileGroupWithLayout(
-      database_oid, tile_group_id, partitioning, tuples_per_tilegroup_));
+  return (AbstractTable::GetTileGroupWithLayout(database_oid, tile_group_id,
+                                                partitioning,
+                                                ComputeTileGroupSize(),
+                                                numa_node));
+}
+
+// Scans seen per tile group allocation beyond which the table counts as
+// scan-heavy and its tile groups shrink
+constexpr uint64_t kScanHeavyThreshold = 16;
+
+// Floor for adaptive sizing, whatever the CREATE TABLE size was
+constexpr size_t kMinAdaptiveTileGroupSize = 64;
+
+size_t DataTable::ComputeTileGroupSize() {
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::adaptive_tile_group_size) == false) {
+    return tuples_per_tilegroup_;
+  }
+
+  // The scans that arrived while the last tile group filled tell us which
+  // side of the trade-off this table sits on: a scan-heavy slow grower
+  // wants small tile groups that become immutable (and thus zone-mapped)
+  // quickly, while an insert-heavy table wants large ones so scans cross
+  // fewer tile group boundaries
+  uint64_t scans = scan_count_.load();
+  uint64_t scan_delta = scans - scans_at_last_tilegroup_.exchange(scans);
+
+  size_t current = adaptive_tuples_per_tilegroup_.load();
+  size_t proposed = current;
+  if (scan_delta >= kScanHeavyThreshold) {
+    proposed = std::max(current / 2, std::max(tuples_per_tilegroup_ / 8,
+                                              kMinAdaptiveTileGroupSize));
+  } else if (scan_delta == 0) {
+    proposed = std::min(current * 2, tuples_per_tilegroup_ * 8);
+  }
+  if (proposed != current) {
+    LOG_TRACE("Table %u tile group size %zu -> %zu (%lu scans since last)",
+              table_oid, current, proposed, scan_delta);
+    adaptive_tuples_per_tilegroup_ = proposed;
+  }
+  return proposed;
+}
+
+void DataTable::SetPartitionNumaNode(const size_t active_tile_group_id,
+                                     const int numa_node) {
+  PL_ASSERT(active_tile_group_id < active_tilegroup_numa_nodes_.size());
+  active_tilegroup_numa_nodes_[active_tile_group_id] = numa_node;
+}
+
+int DataTable::GetPartitionNumaNode(const size_t active_tile_group_id) const {
+  PL_ASSERT(active_tile_group_id < active_tilegroup_numa_nodes_.size());
+  return active_tilegroup_numa_nodes_[active_tile_group_id];
+}
+
+int DataTable::GetHomeNumaNode() const {
+  int home_node = INVALID_NUMA_NODE;
+  size_t active_tilegroup_count = active_tilegroup_count_.load();
+  for (size_t active_tile_group_id = 0;
+       active_tile_group_id < active_tilegroup_count; active_tile_group_id++) {
+    int numa_node = active_tilegroup_numa_nodes_[active_tile_group_id];
+    if (numa_node == INVALID_NUMA_NODE) {
+      continue;
+    }
+    if (home_node == INVALID_NUMA_NODE) {
+      home_node = numa_node;
+    } else if (home_node != numa_node) {
+      // partitions live on several sockets: no single home
+      return INVALID_NUMA_NODE;
+    }
+  }
+  return home_node;
 }
 
 oid_t DataTable::AddDefaultIndirectionArray(
@@ -890,9 +1299,23 @@ oid_t DataTable::AddDefaultIndirectionArray(
       new IndirectionArray(indirection_array_id));
   manager.AddIndirectionArray(indirection_array_id, indirection_array);
 
-  COMPILER_MEMORY_FENCE;
+  std::atomic_store(&active_indirection_arrays_[active_indirection_array_id],
+                    indirection_array);
+
+  return indirection_array_id;
+}
+
+oid_t DataTable::PrepareIndirectionArray(
+    const size_t &active_indirection_array_id) {
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t indirection_array_id = manager.GetNextIndirectionArrayId();
+
+  std::shared_ptr<IndirectionArray> indirection_array(
+      new IndirectionArray(indirection_array_id));
+  manager.AddIndirectionArray(indirection_array_id, indirection_array);
 
-  active_indirection_arrays_[active_indirection_array_id] = indirection_array;
+  std::atomic_store(&prepared_indirection_arrays_[active_indirection_array_id],
+                    indirection_array);
 
   return indirection_array_id;
 }
@@ -909,10 +1332,14 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   // Figure out the partitioning for given tilegroup layout
   column_map = GetTileGroupLayout();
 
-  // Create a tile group with that partitioning
-  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  // Create a tile group with that partitioning, honoring the partition's
+  // NUMA affinity if one has been set
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(
+      column_map, GetPartitionNumaNode(active_tile_group_id)));
   PL_ASSERT(tile_group.get());
 
+  tile_group->SetSchemaVersion(schema_version_.load());
+
   tile_group_id = tile_group->GetTileGroupId();
 
   LOG_TRACE("Added a tile group ");
@@ -936,6 +1363,70 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   return tile_group_id;
 }
 
+bool DataTable::AddDefaultNullColumn(const catalog::Column &column) {
+  // The fast path never touches existing rows, so it only applies to
+  // columns whose absence is indistinguishable from NULL
+  if (column.GetConstraints().empty() == false) {
+    return false;
+  }
+  // Retiring the old schema assumes we are the one deleting it
+  if (own_schema_ == false) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(schema_change_mutex_);
+
+  // Publish the widened schema. The retired schema stays alive so readers
+  // that fetched the pointer before the swap keep a valid view.
+  std::vector<catalog::Column> columns = schema->GetColumns();
+  columns.push_back(column);
+  auto *new_schema = new catalog::Schema(columns);
+  retired_schemas_.emplace_back(schema);
+  SetSchema(new_schema);
+
+  COMPILER_MEMORY_FENCE;
+
+  schema_version_++;
+
+  // Retire the active tile groups so new tuple slots come from tile
+  // groups laid out with the widened schema. Existing tile groups are
+  // left untouched -- that is what makes the ADD COLUMN instantaneous.
+  for (size_t active_tile_group_itr = 0;
+       active_tile_group_itr < active_tilegroup_count_;
+       active_tile_group_itr++) {
+    AddDefaultTileGroup(active_tile_group_itr);
+  }
+
+  return true;
+}
+
+std::shared_ptr<Tile> DataTable::GetNullFillTile(oid_t column_id,
+                                                 oid_t tuple_count) {
+  std::lock_guard<std::mutex> lock(schema_change_mutex_);
+
+  auto fill_tile_itr = null_fill_tiles_.find(column_id);
+  if (fill_tile_itr != null_fill_tiles_.end()) {
+    return fill_tile_itr->second;
+  }
+
+  // Build a single-column tile of the right capacity once and fill it
+  // with NULLs; every old-layout tile group shares it for this column
+  const catalog::Column column = schema->GetColumn(column_id);
+  catalog::Schema fill_schema({column});
+  std::shared_ptr<Tile> fill_tile(
+      TileFactory::GetTempTile(fill_schema, tuple_count));
+
+  storage::Tuple fill_tuple(fill_tile->GetSchema(), true);
+  fill_tuple.SetValue(
+      0, type::ValueFactory::GetNullValueByType(column.GetType()), nullptr);
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    fill_tile->InsertTuple(tuple_itr, &fill_tuple);
+  }
+
+  null_fill_tiles_[column_id] = fill_tile;
+  return fill_tile;
+}
+
 void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   PL_ASSERT(tile_group_id);
 
@@ -1034,6 +1525,28 @@ void DataTable::DropTileGroups() {
   tile_group_count_ = 0;
 }
 
+size_t DataTable::DropTileGroups(const std::size_t tile_group_offset,
+                                 const std::size_t max_count) {
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto tile_groups_size = tile_groups_.GetSize();
+
+  std::size_t tile_groups_itr = tile_group_offset;
+  std::size_t dropped_count = 0;
+
+  for (; tile_groups_itr < tile_groups_size && dropped_count < max_count;
+       tile_groups_itr++) {
+    auto tile_group_id = tile_groups_.Find(tile_groups_itr);
+
+    if (tile_group_id != invalid_tile_group_id) {
+      // drop tile group in catalog
+      catalog_manager.DropTileGroup(tile_group_id);
+      dropped_count++;
+    }
+  }
+
+  return tile_groups_itr - tile_group_offset;
+}
+
 //===--------------------------------------------------------------------===//
 // INDEX
 //===--------------------------------------------------------------------===//
@@ -1340,6 +1853,31 @@ void DataTable::ClearLayoutSamples() {
   }
 }
 
+void DataTable::BeginIndexBuildLogging() {
+  {
+    std::lock_guard<std::mutex> lock(index_build_log_mutex_);
+    index_build_log_.clear();
+  }
+  index_build_logging_.store(true);
+}
+
+std::vector<ItemPointer> DataTable::DrainIndexBuildLog() {
+  std::vector<ItemPointer> drained;
+  {
+    std::lock_guard<std::mutex> lock(index_build_log_mutex_);
+    drained.swap(index_build_log_);
+  }
+  return drained;
+}
+
+void DataTable::EndIndexBuildLogging() {
+  index_build_logging_.store(false);
+  {
+    std::lock_guard<std::mutex> lock(index_build_log_mutex_);
+    index_build_log_.clear();
+  }
+}
+
 void DataTable::RecordIndexSample(const brain::Sample &sample) {
   // Add index sample
   {
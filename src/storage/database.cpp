@@ -76,6 +76,7 @@ storage::DataTable *Database::GetTableWithName(
 }
 
 void Database::DropTableWithOid(const oid_t table_oid) {
+  storage::DataTable *dropped_table = nullptr;
   {
     std::lock_guard<std::mutex> lock(database_mutex);
 
@@ -90,16 +91,24 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     oid_t table_offset = 0;
     for (auto table : tables) {
       if (table->GetOid() == table_oid) {
-        delete table;
+        dropped_table = table;
         break;
       }
       table_offset++;
     }
     PL_ASSERT(table_offset < tables.size());
 
-    // Drop the table
+    // Unlink the table
     tables.erase(tables.begin() + table_offset);
   }
+
+  // The table's storage is torn down outside the lock, so dropping a large
+  // table does not stall every catalog access on database_mutex. The GC
+  // manager epoch-retires the table and releases its tile groups
+  // incrementally on the background workers.
+  if (dropped_table != nullptr) {
+    gc::GCManagerFactory::GetInstance().RecycleDroppedTable(dropped_table);
+  }
 }
 
 storage::DataTable *Database::GetTable(const oid_t table_offset) const {
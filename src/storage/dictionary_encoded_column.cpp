@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// dictionary_encoded_column.cpp
+//
+// Identification: src/storage/dictionary_encoded_column.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/dictionary_encoded_column.h"
+
+#include "common/logger.h"
+#include "storage/tile.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+void DictionaryEncodedColumn::Build(Tile *tile, const oid_t column_itr,
+                                    const oid_t tuple_count) {
+  PL_ASSERT(tile != nullptr);
+  PL_ASSERT(tile->GetSchema()->GetType(column_itr) == type::TypeId::VARCHAR);
+
+  codes_.resize(tuple_count);
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    type::Value value = tile->GetValue(tuple_itr, column_itr);
+    // NULLs get their own dictionary entry keyed by the empty string with a
+    // reserved marker appended, so they never collide with real values.
+    std::string key =
+        value.IsNull() ? std::string("\0", 1) : value.ToString();
+
+    auto entry = code_index_.find(key);
+    uint32_t code;
+    if (entry != code_index_.end()) {
+      code = entry->second;
+    } else {
+      code = static_cast<uint32_t>(dictionary_.size());
+      dictionary_.push_back(key);
+      code_index_[key] = code;
+    }
+    codes_[tuple_itr] = code;
+  }
+
+  LOG_TRACE("Dictionary encoded column %u: %lu tuples, %lu distinct values",
+            column_itr, codes_.size(), dictionary_.size());
+}
+
+type::Value DictionaryEncodedColumn::Decode(const uint32_t code) const {
+  PL_ASSERT(code < dictionary_.size());
+  const std::string &entry = dictionary_[code];
+  if (entry.size() == 1 && entry[0] == '\0') {
+    return type::ValueFactory::GetNullValueByType(type::TypeId::VARCHAR);
+  }
+  // Hand out a value that points at the dictionary's storage; the
+  // dictionary outlives any consumer of the decoded value.
+  return type::ValueFactory::GetVarcharValue(
+      entry.c_str(), static_cast<uint32_t>(entry.size()) + 1, false);
+}
+
+bool DictionaryEncodedColumn::TryGetCode(const type::Value &value,
+                                         uint32_t &code) const {
+  if (value.IsNull()) return false;
+  auto entry = code_index_.find(value.ToString());
+  if (entry == code_index_.end()) return false;
+  code = entry->second;
+  return true;
+}
+
+}  // namespace storage
+}  // namespace peloton
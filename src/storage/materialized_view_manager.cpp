@@ -0,0 +1,283 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// materialized_view_manager.cpp
+//
+// Identification: src/storage/materialized_view_manager.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/materialized_view_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// MaterializedView
+//===--------------------------------------------------------------------===//
+
+MaterializedView::MaterializedView(DataTable *table,
+                                   std::vector<oid_t> group_by_column_ids,
+                                   std::vector<AggTerm> agg_terms)
+    : table_(table),
+      group_by_column_ids_(std::move(group_by_column_ids)),
+      agg_terms_(std::move(agg_terms)) {
+  PL_ASSERT(table_ != nullptr);
+  for (UNUSED_ATTRIBUTE const auto &term : agg_terms_) {
+    PL_ASSERT(term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR ||
+              term.aggtype == ExpressionType::AGGREGATE_COUNT ||
+              term.aggtype == ExpressionType::AGGREGATE_SUM);
+  }
+}
+
+oid_t MaterializedView::GetTableOid() const { return table_->GetOid(); }
+
+std::vector<type::Value> MaterializedView::ExtractKey(
+    TileGroup *tile_group, oid_t tuple_offset) const {
+  std::vector<type::Value> key;
+  key.reserve(group_by_column_ids_.size());
+  for (oid_t column_id : group_by_column_ids_) {
+    key.push_back(tile_group->GetValue(tuple_offset, column_id));
+  }
+  return key;
+}
+
+void MaterializedView::ApplyTuple(TileGroup *tile_group, oid_t tuple_offset,
+                                  int64_t weight) {
+  auto &group = groups_[ExtractKey(tile_group, tuple_offset)];
+  if (group.counts.empty()) {
+    group.counts.resize(agg_terms_.size(), 0);
+    group.sums.resize(agg_terms_.size());
+  }
+  group.row_count += weight;
+
+  for (size_t term_itr = 0; term_itr < agg_terms_.size(); term_itr++) {
+    const auto &term = agg_terms_[term_itr];
+    if (term.aggtype == ExpressionType::AGGREGATE_COUNT_STAR) {
+      group.counts[term_itr] += weight;
+      continue;
+    }
+    type::Value val = tile_group->GetValue(tuple_offset, term.column_id);
+    if (val.IsNull()) {
+      continue;
+    }
+    group.counts[term_itr] += weight;
+    if (term.aggtype == ExpressionType::AGGREGATE_SUM) {
+      if (group.sums[term_itr].IsNull()) {
+        group.sums[term_itr] = val.Copy();
+      } else if (weight > 0) {
+        group.sums[term_itr] = group.sums[term_itr].Add(val);
+      } else {
+        group.sums[term_itr] = group.sums[term_itr].Subtract(val);
+      }
+    }
+  }
+
+  if (group.row_count == 0) {
+    groups_.erase(ExtractKey(tile_group, tuple_offset));
+  }
+}
+
+void MaterializedView::ApplyInsert(TileGroup *tile_group, oid_t tuple_offset) {
+  latch_.Lock();
+  ApplyTuple(tile_group, tuple_offset, 1);
+  latch_.Unlock();
+}
+
+void MaterializedView::ApplyDelete(TileGroup *tile_group, oid_t tuple_offset) {
+  latch_.Lock();
+  ApplyTuple(tile_group, tuple_offset, -1);
+  latch_.Unlock();
+}
+
+void MaterializedView::GetRows(std::vector<std::vector<type::Value>> &rows) {
+  rows.clear();
+  latch_.Lock();
+  rows.reserve(groups_.size());
+  for (const auto &entry : groups_) {
+    std::vector<type::Value> row = entry.first;
+    for (size_t term_itr = 0; term_itr < agg_terms_.size(); term_itr++) {
+      if (agg_terms_[term_itr].aggtype == ExpressionType::AGGREGATE_SUM) {
+        // SUM over zero non-null inputs is NULL
+        if (entry.second.counts[term_itr] == 0) {
+          row.push_back(
+              type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER));
+        } else {
+          row.push_back(entry.second.sums[term_itr]);
+        }
+      } else {
+        row.push_back(
+            type::ValueFactory::GetBigIntValue(entry.second.counts[term_itr]));
+      }
+    }
+    rows.push_back(std::move(row));
+  }
+  latch_.Unlock();
+}
+
+bool MaterializedView::Matches(oid_t table_oid,
+                               const std::vector<oid_t> &group_by_column_ids,
+                               const std::vector<AggTerm> &agg_terms) const {
+  if (table_oid != GetTableOid()) return false;
+  if (group_by_column_ids != group_by_column_ids_) return false;
+  if (agg_terms.size() != agg_terms_.size()) return false;
+  for (size_t term_itr = 0; term_itr < agg_terms_.size(); term_itr++) {
+    if (agg_terms[term_itr].aggtype != agg_terms_[term_itr].aggtype)
+      return false;
+    if (agg_terms_[term_itr].aggtype != ExpressionType::AGGREGATE_COUNT_STAR &&
+        agg_terms[term_itr].column_id != agg_terms_[term_itr].column_id)
+      return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// MaterializedViewManager
+//===--------------------------------------------------------------------===//
+
+MaterializedViewManager &MaterializedViewManager::GetInstance() {
+  static MaterializedViewManager global_materialized_view_manager;
+  return global_materialized_view_manager;
+}
+
+std::shared_ptr<MaterializedView> MaterializedViewManager::CreateView(
+    DataTable *table, std::vector<oid_t> group_by_column_ids,
+    std::vector<MaterializedView::AggTerm> agg_terms,
+    concurrency::TransactionContext *txn) {
+  auto view = std::make_shared<MaterializedView>(
+      table, std::move(group_by_column_ids), std::move(agg_terms));
+
+  // Fold in every row visible to the creating transaction
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  size_t tile_group_count = table->GetTileGroupCount();
+  for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    auto *tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (transaction_manager.IsVisible(txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        view->ApplyInsert(tile_group.get(), tuple_id);
+      }
+    }
+  }
+
+  latch_.Lock();
+  views_[table->GetOid()].push_back(view);
+  latch_.Unlock();
+  view_count_.fetch_add(1);
+
+  LOG_DEBUG("Created materialized view over table %u with %lu group-by cols",
+            table->GetOid(), view->GetGroupByColumnIds().size());
+  return view;
+}
+
+std::shared_ptr<MaterializedView> MaterializedViewManager::FindView(
+    oid_t table_oid, const std::vector<oid_t> &group_by_column_ids,
+    const std::vector<MaterializedView::AggTerm> &agg_terms) {
+  std::shared_ptr<MaterializedView> result;
+  latch_.Lock();
+  auto table_itr = views_.find(table_oid);
+  if (table_itr != views_.end()) {
+    for (const auto &view : table_itr->second) {
+      if (view->Matches(table_oid, group_by_column_ids, agg_terms)) {
+        result = view;
+        break;
+      }
+    }
+  }
+  latch_.Unlock();
+  return result;
+}
+
+void MaterializedViewManager::DropViews(oid_t table_oid) {
+  latch_.Lock();
+  auto table_itr = views_.find(table_oid);
+  if (table_itr != views_.end()) {
+    view_count_.fetch_sub(table_itr->second.size());
+    views_.erase(table_itr);
+  }
+  latch_.Unlock();
+}
+
+void MaterializedViewManager::ApplyTransactionDelta(
+    const ReadWriteSet &rw_set) {
+  // Commit-path fast path: no views registered anywhere
+  if (view_count_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &tile_group_entry : rw_set) {
+    oid_t tile_group_id = tile_group_entry.first;
+    auto *tile_group = manager.GetTileGroupRaw(tile_group_id);
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    // Collect the views over this tile group's table
+    std::vector<std::shared_ptr<MaterializedView>> table_views;
+    latch_.Lock();
+    auto table_itr = views_.find(tile_group->GetTableId());
+    if (table_itr != views_.end()) {
+      table_views = table_itr->second;
+    }
+    latch_.Unlock();
+    if (table_views.empty()) {
+      continue;
+    }
+
+    auto *tile_group_header = tile_group->GetHeader();
+    for (auto &tuple_entry : tile_group_entry.second) {
+      oid_t tuple_slot = tuple_entry.first;
+      switch (tuple_entry.second) {
+        case RWType::INSERT: {
+          for (const auto &view : table_views) {
+            view->ApplyInsert(tile_group, tuple_slot);
+          }
+          break;
+        }
+        case RWType::DELETE: {
+          // the slot still holds the deleted version's data
+          for (const auto &view : table_views) {
+            view->ApplyDelete(tile_group, tuple_slot);
+          }
+          break;
+        }
+        case RWType::UPDATE: {
+          // old version at the slot, new version behind the prev pointer
+          ItemPointer new_version =
+              tile_group_header->GetPrevItemPointer(tuple_slot);
+          PL_ASSERT(new_version.IsNull() == false);
+          auto *new_tile_group = manager.GetTileGroupRaw(new_version.block);
+          for (const auto &view : table_views) {
+            view->ApplyDelete(tile_group, tuple_slot);
+            view->ApplyInsert(new_tile_group, new_version.offset);
+          }
+          break;
+        }
+        default: {
+          // reads and insert-then-delete leave the committed contents
+          // unchanged
+          break;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace storage
+}  // namespace peloton
@@ -0,0 +1,347 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_allocator.cpp
+//
+// Identification: src/storage/slab_allocator.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/slab_allocator.h"
+
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <new>
+
+#ifdef PELOTON_NUMA
+#include <numa.h>
+#endif
+
+#include "common/logger.h"
+#include "settings/settings_manager.h"
+
+namespace peloton {
+namespace storage {
+
+const size_t SlabAllocator::kMinChunkSize;
+const size_t SlabAllocator::kMaxChunkSize;
+const size_t SlabAllocator::kRegionSize;
+const size_t SlabAllocator::kHugePageSize;
+const uint32_t SlabAllocator::kNumSizeClasses;
+const uint32_t SlabAllocator::kHugeObjectClass;
+
+// global singleton
+SlabAllocator &SlabAllocator::GetInstance() {
+  static SlabAllocator slab_allocator;
+  return slab_allocator;
+}
+
+SlabAllocator::SlabAllocator() {
+  uint32_t pool_count = 1;
+
+#ifdef PELOTON_NUMA
+  if (numa_available() >= 0) {
+    pool_count = std::max(1, numa_num_configured_nodes());
+  }
+#endif
+
+  for (uint32_t pool_itr = 0; pool_itr < pool_count; pool_itr++) {
+    pools_.emplace_back(new Pool());
+  }
+
+  LOG_TRACE("Slab allocator :: %u pools", pool_count);
+}
+
+SlabAllocator::~SlabAllocator() {
+  // Hand every region back to the OS. Chunks still handed out at this
+  // point belong to objects that outlive the allocator and are lost with
+  // the process anyway.
+  for (auto &region_entry : regions_) {
+    munmap(reinterpret_cast<void *>(region_entry.first),
+           region_entry.second.length);
+  }
+}
+
+uint32_t SlabAllocator::SizeClassIndex(size_t size) {
+  PL_ASSERT(size >= kMinChunkSize && size <= kMaxChunkSize);
+
+  uint32_t class_index = 0;
+  size_t chunk_size = kMinChunkSize;
+  while (chunk_size < size) {
+    chunk_size <<= 1;
+    class_index++;
+  }
+
+  PL_ASSERT(class_index < kNumSizeClasses);
+  return class_index;
+}
+
+size_t SlabAllocator::ChunkSize(uint32_t class_index) {
+  return kMinChunkSize << class_index;
+}
+
+uint32_t SlabAllocator::LocalPoolIndex() const {
+#ifdef PELOTON_NUMA
+  if (pools_.size() > 1) {
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+      int node = numa_node_of_cpu(cpu);
+      if (node >= 0 && static_cast<size_t>(node) < pools_.size()) {
+        return static_cast<uint32_t>(node);
+      }
+    }
+  }
+#endif
+
+  return 0;
+}
+
+void *SlabAllocator::MapRegion(size_t length, uint32_t pool_index,
+                               bool &used_hugetlb) {
+  used_hugetlb = false;
+
+#ifdef MAP_HUGETLB
+  // Try explicitly reserved huge pages first; the mapping comes aligned
+  // and already backed by 2MB pages
+  if (settings::SettingsManager::GetBool(settings::SettingId::huge_pages)) {
+    void *map = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (map != MAP_FAILED) {
+      used_hugetlb = true;
+#ifdef PELOTON_NUMA
+      if (pools_.size() > 1 && numa_available() >= 0) {
+        numa_tonode_memory(map, length, static_cast<int>(pool_index));
+      }
+#endif
+      return map;
+    }
+    LOG_TRACE("No reserved huge pages for region of size %lu; falling back",
+              length);
+  }
+#endif
+
+  // Over-allocate by one huge page so the region can be aligned to a
+  // huge page boundary, then trim the unaligned head and tail
+  size_t mmap_length = length + kHugePageSize;
+
+  void *raw = mmap(nullptr, mmap_length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    LOG_ERROR("Could not reserve slab region of size : %lu", length);
+    return nullptr;
+  }
+
+  uintptr_t start = (reinterpret_cast<uintptr_t>(raw) + kHugePageSize - 1) &
+                    ~(kHugePageSize - 1);
+
+  size_t head_slack = start - reinterpret_cast<uintptr_t>(raw);
+  if (head_slack > 0) {
+    munmap(raw, head_slack);
+  }
+
+  size_t tail_slack = mmap_length - head_slack - length;
+  if (tail_slack > 0) {
+    munmap(reinterpret_cast<void *>(start + length), tail_slack);
+  }
+
+#ifdef MADV_HUGEPAGE
+  madvise(reinterpret_cast<void *>(start), length, MADV_HUGEPAGE);
+#endif
+
+#ifdef PELOTON_NUMA
+  // Bind the region to the pool's node so chunks stay local to the
+  // threads that allocate from it
+  if (pools_.size() > 1 && numa_available() >= 0) {
+    numa_tonode_memory(reinterpret_cast<void *>(start), length,
+                       static_cast<int>(pool_index));
+  }
+#endif
+
+  return reinterpret_cast<void *>(start);
+}
+
+bool SlabAllocator::RefillFreeList(Pool &pool, uint32_t pool_index,
+                                   uint32_t class_index) {
+  bool used_hugetlb = false;
+  void *region = MapRegion(kRegionSize, pool_index, used_hugetlb);
+  if (region == nullptr) {
+    return false;
+  }
+
+  region_latch_.Lock();
+  regions_[reinterpret_cast<uintptr_t>(region)] = {kRegionSize, pool_index,
+                                                   class_index, used_hugetlb};
+  region_latch_.Unlock();
+
+  // Carve the whole region into chunks of this class
+  size_t chunk_size = ChunkSize(class_index);
+  size_t chunk_count = kRegionSize / chunk_size;
+
+  char *cursor = reinterpret_cast<char *>(region);
+  for (size_t chunk_itr = 0; chunk_itr < chunk_count; chunk_itr++) {
+    *reinterpret_cast<void **>(cursor) = pool.free_lists[class_index];
+    pool.free_lists[class_index] = cursor;
+    cursor += chunk_size;
+  }
+
+  pool.free_chunks[class_index] += chunk_count;
+  pool.total_chunks[class_index] += chunk_count;
+
+  return true;
+}
+
+void *SlabAllocator::Allocate(size_t size) {
+  // Sizes outside the slab range go straight to the global heap
+  if (size < kMinChunkSize || size > kMaxChunkSize) {
+    return ::operator new(size);
+  }
+
+  uint32_t class_index = SizeClassIndex(size);
+  uint32_t pool_index = LocalPoolIndex();
+  Pool &pool = *pools_[pool_index];
+
+  pool.latch.Lock();
+
+  if (pool.free_lists[class_index] == nullptr) {
+    if (RefillFreeList(pool, pool_index, class_index) == false) {
+      // Region reservation failed; fall back to the global heap
+      pool.latch.Unlock();
+      return ::operator new(size);
+    }
+  }
+
+  void *chunk = pool.free_lists[class_index];
+  pool.free_lists[class_index] = *reinterpret_cast<void **>(chunk);
+  pool.free_chunks[class_index]--;
+
+  pool.latch.Unlock();
+
+  return chunk;
+}
+
+void *SlabAllocator::AllocateHuge(size_t size) {
+  // Round the mapping up to the huge page granule
+  size_t length = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+
+  uint32_t pool_index = LocalPoolIndex();
+  bool used_hugetlb = false;
+  void *map = MapRegion(length, pool_index, used_hugetlb);
+  if (map == nullptr) {
+    // Reservation failed; fall back to the global heap
+    return ::operator new(size);
+  }
+
+  region_latch_.Lock();
+  regions_[reinterpret_cast<uintptr_t>(map)] = {length, pool_index,
+                                                kHugeObjectClass,
+                                                used_hugetlb};
+  region_latch_.Unlock();
+
+  return map;
+}
+
+void SlabAllocator::Release(void *address) {
+  if (address == nullptr) {
+    return;
+  }
+
+  // Look up the region containing the address to tell slab-managed
+  // chunks apart from heap-backed buffers
+  bool slab_managed = false;
+  uint32_t pool_index = 0;
+  uint32_t class_index = 0;
+
+  region_latch_.Lock();
+  auto region_itr = regions_.upper_bound(reinterpret_cast<uintptr_t>(address));
+  if (region_itr != regions_.begin()) {
+    --region_itr;
+    if (reinterpret_cast<uintptr_t>(address) <
+        region_itr->first + region_itr->second.length) {
+      slab_managed = true;
+      pool_index = region_itr->second.pool_index;
+      class_index = region_itr->second.class_index;
+
+      // A huge-object mapping is released as a whole
+      if (class_index == kHugeObjectClass) {
+        size_t length = region_itr->second.length;
+        regions_.erase(region_itr);
+        region_latch_.Unlock();
+        munmap(address, length);
+        return;
+      }
+    }
+  }
+  region_latch_.Unlock();
+
+  if (slab_managed == false) {
+    ::operator delete(address);
+    return;
+  }
+
+  Pool &pool = *pools_[pool_index];
+
+  pool.latch.Lock();
+  *reinterpret_cast<void **>(address) = pool.free_lists[class_index];
+  pool.free_lists[class_index] = address;
+  pool.free_chunks[class_index]++;
+  pool.latch.Unlock();
+}
+
+SlabAllocator::Stats SlabAllocator::GetStats() const {
+  Stats stats;
+  stats.region_count = 0;
+  stats.hugetlb_region_count = 0;
+  stats.thp_region_count = 0;
+  stats.reserved_bytes = 0;
+  stats.allocated_bytes = 0;
+
+  for (uint32_t class_itr = 0; class_itr < kNumSizeClasses; class_itr++) {
+    SizeClassStats class_stats;
+    class_stats.chunk_size = ChunkSize(class_itr);
+    class_stats.total_chunks = 0;
+    class_stats.free_chunks = 0;
+    stats.size_classes.push_back(class_stats);
+  }
+
+  region_latch_.Lock();
+  stats.region_count = regions_.size();
+  for (auto &region_entry : regions_) {
+    stats.reserved_bytes += region_entry.second.length;
+    if (region_entry.second.hugetlb) {
+      stats.hugetlb_region_count++;
+    } else {
+      stats.thp_region_count++;
+    }
+    // Huge-object mappings are in use for their whole lifetime
+    if (region_entry.second.class_index == kHugeObjectClass) {
+      stats.allocated_bytes += region_entry.second.length;
+    }
+  }
+  region_latch_.Unlock();
+
+  for (auto &pool : pools_) {
+    pool->latch.Lock();
+    for (uint32_t class_itr = 0; class_itr < kNumSizeClasses; class_itr++) {
+      stats.size_classes[class_itr].total_chunks +=
+          pool->total_chunks[class_itr];
+      stats.size_classes[class_itr].free_chunks += pool->free_chunks[class_itr];
+    }
+    pool->latch.Unlock();
+  }
+
+  for (auto &class_stats : stats.size_classes) {
+    stats.allocated_bytes += (class_stats.total_chunks -
+                              class_stats.free_chunks) *
+                             class_stats.chunk_size;
+  }
+
+  return stats;
+}
+
+}  // namespace storage
+}  // namespace peloton
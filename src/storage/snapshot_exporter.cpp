@@ -0,0 +1,353 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// snapshot_exporter.cpp
+//
+// Identification: src/storage/snapshot_exporter.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/snapshot_exporter.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "gc/gc_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "threadpool/mono_queue_pool.h"
+#include "threadpool/task_future.h"
+#include "type/limits.h"
+#include "type/value.h"
+#include "util/string_util.h"
+
+// Per-worker write buffer; flushed to the segment file whenever it fills
+#define SNAPSHOT_EXPORT_BUFFER_SIZE (1 << 20)
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+// Segment files use the same field separator, escaping and NULL spelling
+// as the COPY paths, so COPY FROM can reload them
+const char kDelimiter = ',';
+const char kNewline = '\n';
+
+// Buffered segment writer: the same raw append/escape discipline as the
+// direct COPY TO path, but private to one dump worker, so workers need no
+// coordination beyond writing disjoint files
+class SegmentWriter {
+ public:
+  SegmentWriter(FILE *file)
+      : file_(file), buffer_(new char[SNAPSHOT_EXPORT_BUFFER_SIZE]) {}
+
+  void Write(const char *data, size_t len) {
+    while (len > 0) {
+      if (fill_ == SNAPSHOT_EXPORT_BUFFER_SIZE) {
+        Flush();
+      }
+      size_t chunk = std::min(SNAPSHOT_EXPORT_BUFFER_SIZE - fill_, len);
+      PL_MEMCPY(buffer_.get() + fill_, data, chunk);
+      fill_ += chunk;
+      data += chunk;
+      len -= chunk;
+    }
+  }
+
+  // Copy maximal runs without escapable characters in one shot; the escape
+  // sequences match the COPY export paths byte for byte
+  void WriteEscaped(const char *data, size_t len) {
+    size_t run_start = 0;
+    for (size_t i = 0; i < len; i++) {
+      char ch = data[i];
+      if (ch == kDelimiter || ch == kNewline) {
+        Write(data + run_start, i - run_start);
+        if (ch == kDelimiter) {
+          char escaped[3] = {'\\', '\\', ch};
+          Write(escaped, 3);
+        } else {
+          char escaped[2] = {'\\', ch};
+          Write(escaped, 2);
+        }
+        run_start = i + 1;
+      }
+    }
+    Write(data + run_start, len - run_start);
+  }
+
+  void Flush() {
+    if (fill_ > 0) {
+      fwrite(buffer_.get(), 1, fill_, file_);
+      fill_ = 0;
+    }
+  }
+
+ private:
+  FILE *file_;
+  std::unique_ptr<char[]> buffer_;
+  size_t fill_ = 0;
+};
+
+}  // anonymous namespace
+
+SnapshotExporter &SnapshotExporter::GetInstance() {
+  static SnapshotExporter exporter;
+  return exporter;
+}
+
+cid_t SnapshotExporter::Freeze() {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // every transaction at or below the expired epoch has finished, so
+  // visibility at this commit id can never change under the dump
+  eid_t snapshot_eid = epoch_manager.GetExpiredEpochId();
+  if (snapshot_eid == MAX_EID) {
+    // no thread has registered with the epoch manager yet
+    snapshot_eid = epoch_manager.GetCurrentEpochId() - 1;
+  }
+  cid_t snapshot_cid = (snapshot_eid << 32) | 0xFFFFFFFF;
+
+  gc::GCManagerFactory::GetInstance().PinSnapshot(snapshot_cid);
+
+  LOG_TRACE("Frozen export snapshot at cid %lu", snapshot_cid);
+  return snapshot_cid;
+}
+
+void SnapshotExporter::Release(const cid_t snapshot_cid) {
+  gc::GCManagerFactory::GetInstance().UnpinSnapshot(snapshot_cid);
+}
+
+size_t SnapshotExporter::ExportTable(DataTable *table,
+                                     const std::string &file_prefix,
+                                     const cid_t snapshot_cid,
+                                     size_t worker_count) {
+  // tile groups appended after the freeze only hold post-snapshot tuples,
+  // so the count taken here covers everything the snapshot can see
+  size_t tile_group_count = table->GetTileGroupCount();
+  if (worker_count == 0) {
+    worker_count = 1;
+  }
+  if (worker_count > tile_group_count && tile_group_count > 0) {
+    worker_count = tile_group_count;
+  }
+
+  std::vector<size_t> tuple_counts(worker_count, 0);
+  std::vector<bool> successes(worker_count, true);
+
+  // chunk the tile group range; the calling thread takes the first chunk,
+  // like the other parallel table walks
+  size_t chunk_size = (tile_group_count + worker_count - 1) / worker_count;
+  std::vector<threadpool::TaskFuture> worker_futures;
+  auto &pool = threadpool::MonoQueuePool::GetInstance();
+
+  for (size_t worker_itr = 1; worker_itr < worker_count; worker_itr++) {
+    size_t begin = worker_itr * chunk_size;
+    size_t end = std::min(begin + chunk_size, tile_group_count);
+    std::string segment_path =
+        file_prefix + ".part-" + std::to_string(worker_itr);
+    worker_futures.push_back(pool.SubmitTaskWithFuture(
+        [this, table, begin, end, snapshot_cid, segment_path, worker_itr,
+         &tuple_counts, &successes] {
+          bool success = true;
+          tuple_counts[worker_itr] = DumpTileGroupRange(
+              table, begin, end, snapshot_cid, segment_path, &success);
+          successes[worker_itr] = success;
+        }));
+  }
+
+  bool success = true;
+  tuple_counts[0] =
+      DumpTileGroupRange(table, 0, std::min(chunk_size, tile_group_count),
+                         snapshot_cid, file_prefix + ".part-0", &success);
+  successes[0] = success;
+
+  if (worker_futures.empty() == false) {
+    threadpool::TaskFuture::WhenAll(worker_futures).Wait();
+  }
+
+  size_t exported_tuples = 0;
+  for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+    if (successes[worker_itr] == false) {
+      return 0;
+    }
+    exported_tuples += tuple_counts[worker_itr];
+  }
+
+  LOG_INFO("Exported %lu tuples from table %s into %lu segments",
+           exported_tuples, table->GetName().c_str(), worker_count);
+  return exported_tuples;
+}
+
+size_t SnapshotExporter::DumpTileGroupRange(DataTable *table,
+                                            const size_t tile_group_begin,
+                                            const size_t tile_group_end,
+                                            const cid_t snapshot_cid,
+                                            const std::string &segment_path,
+                                            bool *success) {
+  FILE *segment_file = fopen(segment_path.c_str(), "wb");
+  if (segment_file == nullptr) {
+    LOG_ERROR("Cannot open snapshot segment file: %s", segment_path.c_str());
+    *success = false;
+    return 0;
+  }
+  SegmentWriter writer(segment_file);
+
+  const catalog::Schema *schema = table->GetSchema();
+  const oid_t column_count = schema->GetColumnCount();
+
+  // Where a column lives inside one tile group
+  struct ColumnAccess {
+    storage::Tile *tile;
+    size_t offset;
+    type::TypeId type_id;
+    bool is_inlined;
+  };
+  std::vector<ColumnAccess> accessors(column_count);
+
+  char digits[32];
+  size_t exported_tuples = 0;
+  for (size_t tile_group_itr = tile_group_begin;
+       tile_group_itr < tile_group_end; tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    // Resolve each column's tile, offset and layout once per tile group
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      oid_t tile_offset, tile_column_itr;
+      tile_group->LocateTileAndColumn(column_itr, tile_offset,
+                                      tile_column_itr);
+      storage::Tile *tile = tile_group->GetTile(tile_offset);
+      const catalog::Schema *tile_schema = tile->GetSchema();
+      accessors[column_itr] = {tile, tile_schema->GetOffset(tile_column_itr),
+                               tile_schema->GetType(tile_column_itr),
+                               tile_schema->IsInlined(tile_column_itr)};
+    }
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // visibility at the frozen commit id: the version was committed at
+      // or before the snapshot and not invalidated until after it. All
+      // transactions below the snapshot have finished, so these fields
+      // can no longer change in a way the snapshot could observe.
+      if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+        continue;
+      }
+      cid_t begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+      cid_t end_cid = tile_group_header->GetEndCommitId(tuple_id);
+      if (begin_cid == MAX_CID || begin_cid > snapshot_cid ||
+          end_cid <= snapshot_cid) {
+        continue;
+      }
+
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        ColumnAccess &access = accessors[column_itr];
+        char *field = access.tile->GetTupleLocation(tuple_id) + access.offset;
+        bool is_null = false;
+        int64_t int_value = 0;
+        bool is_int = false;
+
+        switch (access.type_id) {
+          case type::TypeId::TINYINT: {
+            int8_t raw = *reinterpret_cast<int8_t *>(field);
+            is_null = (raw == type::PELOTON_INT8_NULL);
+            int_value = raw;
+            is_int = true;
+            break;
+          }
+          case type::TypeId::SMALLINT: {
+            int16_t raw = *reinterpret_cast<int16_t *>(field);
+            is_null = (raw == type::PELOTON_INT16_NULL);
+            int_value = raw;
+            is_int = true;
+            break;
+          }
+          case type::TypeId::INTEGER: {
+            int32_t raw = *reinterpret_cast<int32_t *>(field);
+            is_null = (raw == type::PELOTON_INT32_NULL);
+            int_value = raw;
+            is_int = true;
+            break;
+          }
+          case type::TypeId::BIGINT: {
+            int64_t raw = *reinterpret_cast<int64_t *>(field);
+            is_null = (raw == type::PELOTON_INT64_NULL);
+            int_value = raw;
+            is_int = true;
+            break;
+          }
+          case type::TypeId::DECIMAL: {
+            double raw = *reinterpret_cast<double *>(field);
+            if (raw == type::PELOTON_DECIMAL_NULL) {
+              is_null = true;
+            } else {
+              int len = snprintf(digits, sizeof(digits), "%.15g", raw);
+              writer.Write(digits, len);
+            }
+            break;
+          }
+          case type::TypeId::VARCHAR: {
+            const char *bytes = nullptr;
+            uint32_t length = 0;
+            if (access.is_inlined) {
+              length = *reinterpret_cast<uint32_t *>(field);
+              is_null = (length == type::PELOTON_VALUE_NULL);
+              bytes = field + sizeof(uint32_t);
+            } else {
+              char *varlen_ptr = *reinterpret_cast<char **>(field);
+              is_null = (varlen_ptr == nullptr);
+              if (!is_null) {
+                length = *reinterpret_cast<uint32_t *>(varlen_ptr);
+                bytes = varlen_ptr + sizeof(uint32_t);
+              }
+            }
+            if (!is_null) {
+              // The stored varchar length includes the terminating NUL
+              if (length > 0) length -= 1;
+              writer.WriteEscaped(bytes, length);
+            }
+            break;
+          }
+          default: {
+            // Types without a raw kernel (timestamps, varbinary, ...) fall
+            // back to the value layer
+            type::Value value = tile_group->GetValue(tuple_id, column_itr);
+            if (value.IsNull()) {
+              is_null = true;
+            } else {
+              std::string value_str = value.ToString();
+              writer.WriteEscaped(value_str.c_str(), value_str.length());
+            }
+            break;
+          }
+        }
+
+        if (is_null) {
+          writer.Write("\\N", 2);
+        } else if (is_int) {
+          writer.Write(digits, StringUtil::FastIntToString(int_value, digits));
+        }
+        writer.Write(column_itr == column_count - 1 ? &kNewline : &kDelimiter,
+                     1);
+      }
+      exported_tuples++;
+    }
+  }
+
+  writer.Flush();
+  fflush(segment_file);
+  fsync(fileno(segment_file));
+  fclose(segment_file);
+  return exported_tuples;
+}
+
+}  // namespace storage
+}  // namespace peloton
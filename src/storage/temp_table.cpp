@@ -12,28 +12,73 @@
 
 #include "storage/temp_table.h"
 
+#include <atomic>
+#include <cstdio>
 #include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "settings/settings_manager.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "type/memory_tracker.h"
 
 namespace peloton {
 namespace storage {
 
+namespace {
+
+// Distinguishes the spill directories of temp tables that share an oid
+// (most are built with INVALID_OID)
+std::atomic<uint64_t> temp_table_instance_counter{0};
+
+// Heap bytes held by a tile group's tiles
+size_t TileGroupHeapSize(const std::shared_ptr<storage::TileGroup> &tile_group) {
+  size_t heap_size = 0;
+  for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount(); tile_itr++) {
+    heap_size += tile_group->GetTile(tile_itr)->GetInlinedSize();
+  }
+  return heap_size;
+}
+
+}  // namespace
+
 TempTable::TempTable(const oid_t &table_oid, catalog::Schema *schema,
                      const bool own_schema,
                      const peloton::LayoutType layout_type)
     : AbstractTable(table_oid, schema, own_schema, layout_type) {
+  spill_budget_bytes_ =
+      static_cast<size_t>(settings::SettingsManager::GetInt(
+          settings::SettingId::temp_table_spill_budget_mb)) *
+      1024 * 1024;
+
   // We only want to instantiate a single TileGroup
   AddDefaultTileGroup();
 }
 
 TempTable::~TempTable() {
-  // Nothing to see, nothing to do
+  if (memory_tracker_ != nullptr) {
+    memory_tracker_->Release(resident_bytes_);
+  }
+  // Remove the spill files; the mappings themselves die with the tiles
+  for (auto tile_group_offset : spilled_groups_) {
+    auto &tile_group = tile_groups_[tile_group_offset];
+    for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount();
+         tile_itr++) {
+      std::string file_path = spill_dir_ + "/tile_" +
+                              std::to_string(tile_group->GetTileGroupId()) +
+                              "_" + std::to_string(tile_itr);
+      std::remove(file_path.c_str());
+    }
+  }
+  if (spilled_groups_.empty() == false) {
+    rmdir(spill_dir_.c_str());
+  }
 }
 
 ItemPointer TempTable::InsertTuple(
@@ -47,7 +92,10 @@ ItemPointer TempTable::InsertTuple(
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
 
-  for (int i = 0, cnt = (int)tile_groups_.size(); i < cnt; i++) {
+  // Tile groups before the spill cursor are on disk and full, so don't
+  // even bother offering them the tuple
+  for (int i = (int)spill_cursor_, cnt = (int)tile_groups_.size(); i < cnt;
+       i++) {
     tile_group = tile_groups_[i];
     tuple_slot = tile_group->InsertTuple(tuple);
 
@@ -124,13 +172,104 @@ oid_t TempTable::AddDefaultTileGroup() {
   PL_ASSERT(tile_group.get());
 
   tile_groups_.push_back(tile_group);
+  size_t heap_size = TileGroupHeapSize(tile_group);
+  resident_bytes_ += heap_size;
+  if (memory_tracker_ != nullptr) {
+    // May run our own SpillNow() hook or fail the query; either way the
+    // new tile group is already in place and consistently accounted
+    memory_tracker_->Consume(heap_size);
+  }
 
   LOG_TRACE("Created TileGroup for %s\n%s\n", GetName().c_str(),
             tile_group->GetInfo().c_str());
 
+  // Adding a tile group is the only way this table grows, so this is the
+  // one place we have to check the budget
+  CheckSpill();
+
   return tile_group_id;
 }
 
+void TempTable::CheckSpill() {
+  if (spill_budget_bytes_ == 0 || GetSchema()->IsInlined() == false) {
+    // Uninlined varlen values live in the tiles' pools and cannot be
+    // remapped, so those tables stay memory-resident
+    return;
+  }
+  // The last tile group is still accepting inserts; every group before it
+  // is full and safe to remap read-only
+  while (resident_bytes_ > spill_budget_bytes_ &&
+         spill_cursor_ + 1 < tile_groups_.size()) {
+    if (SpillTileGroup(spill_cursor_) == false) {
+      break;
+    }
+    spill_cursor_++;
+  }
+}
+
+bool TempTable::SpillTileGroup(const size_t tile_group_offset) {
+  if (spill_dir_.empty()) {
+    // TempTables routinely share tile group ids, so every instance gets
+    // its own directory to keep the spill files from clobbering each other
+    std::ostringstream os;
+    os << "/tmp/peloton-temp-" << getpid() << "-"
+       << temp_table_instance_counter.fetch_add(1);
+    spill_dir_ = os.str();
+    if (mkdir(spill_dir_.c_str(), 0700) != 0) {
+      LOG_WARN("Failed to create spill directory %s for %s",
+               spill_dir_.c_str(), GetName().c_str());
+      spill_dir_.clear();
+      spill_budget_bytes_ = 0;
+      return false;
+    }
+  }
+
+  auto &tile_group = tile_groups_[tile_group_offset];
+  size_t heap_size = TileGroupHeapSize(tile_group);
+
+  if (tile_group->WriteTilesToDirectory(spill_dir_) == false ||
+      tile_group->MapTilesFromDirectory(spill_dir_) == false) {
+    LOG_WARN("Failed to spill TileGroup %u of %s",
+             tile_group->GetTileGroupId(), GetName().c_str());
+    spill_budget_bytes_ = 0;
+    return false;
+  }
+
+  // Intermediate results are consumed front to back, so ask for readahead
+  for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount();
+       tile_itr++) {
+    tile_group->GetTile(tile_itr)->AdviseSequentialAccess();
+  }
+
+  resident_bytes_ -= heap_size;
+  if (memory_tracker_ != nullptr) {
+    memory_tracker_->Release(heap_size);
+  }
+  spilled_groups_.push_back(tile_group_offset);
+  LOG_TRACE("Spilled TileGroup %u of %s to %s",
+            tile_group->GetTileGroupId(), GetName().c_str(),
+            spill_dir_.c_str());
+  return true;
+}
+
+size_t TempTable::SpillNow() {
+  if (GetSchema()->IsInlined() == false) {
+    return 0;
+  }
+  size_t released = 0;
+  // Same walk as CheckSpill, but ignoring the budget: under memory
+  // pressure everything full goes to disk
+  while (spill_cursor_ + 1 < tile_groups_.size()) {
+    size_t before = resident_bytes_;
+    if (SpillTileGroup(spill_cursor_) == false) {
+      break;
+    }
+    spill_cursor_++;
+    released += before - resident_bytes_;
+  }
+  return released;
+}
+
 std::string TempTable::GetName() const {
   std::ostringstream os;
   os << "TEMP_TABLE[" << table_oid << "]";
@@ -11,7 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdio>
+#include <fcntl.h>
 #include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "catalog/schema.h"
 #include "common/exception.h"
@@ -21,6 +25,8 @@
 #include "type/ephemeral_pool.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/backend_manager.h"
+#include "storage/cold_tier_cache.h"
+#include "storage/dictionary_encoded_column.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
@@ -52,12 +58,11 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   tile_size = tuple_count * tuple_length;
 
-  // allocate tuple storage space for inlined data
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // data = reinterpret_cast<char *>(
-  // storage_manager.Allocate(backend_type, tile_size));
-
-  data = new char[tile_size];
+  // allocate tuple storage space for inlined data; the backend manager
+  // serves tile-sized blocks from huge-page-backed slabs
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  data = reinterpret_cast<char *>(
+      backend_manager.Allocate(backend_type, tile_size));
   PL_ASSERT(data != NULL);
 
   // zero out the data
@@ -71,10 +76,15 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // storage_manager.Release(backend_type, data);
-
-  delete[] data;
+  if (mmap_base_ != nullptr) {
+    // the cold tier cache must not hand out a destroyed tile as a victim
+    ColdTierCache::GetInstance().OnTileRelease(this);
+    munmap(mmap_base_, mmap_length_);
+    mmap_base_ = nullptr;
+  } else {
+    auto &backend_manager = storage::BackendManager::GetInstance();
+    backend_manager.Release(backend_type, data);
+  }
   data = NULL;
 
   // reclaim the tile memory (UNINLINED data)
@@ -98,6 +108,7 @@ Tile::~Tile() {
  */
 void Tile::InsertTuple(const oid_t tuple_offset, Tuple *tuple) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(IsMemoryMapped() == false);
 
   // Find slot location
   char *location = tuple_offset * tuple_length + data;
@@ -123,6 +134,33 @@ type::Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
   return type::Value::DeserializeFrom(field_location, column_type, is_inlined);
 }
 
+bool Tile::DictionaryEncodeColumn(const oid_t column_itr) {
+  PL_ASSERT(column_itr < schema.GetColumnCount());
+
+  // Only varchar columns benefit from dictionary codes
+  if (schema.GetType(column_itr) != type::TypeId::VARCHAR) {
+    return false;
+  }
+
+  // Already encoded
+  if (dict_encoded_columns_.count(column_itr) != 0) {
+    return true;
+  }
+
+  std::unique_ptr<DictionaryEncodedColumn> encoded_column(
+      new DictionaryEncodedColumn());
+  encoded_column->Build(this, column_itr, GetActiveTupleCount());
+  dict_encoded_columns_[column_itr] = std::move(encoded_column);
+  return true;
+}
+
+const DictionaryEncodedColumn *Tile::GetDictionaryEncodedColumn(
+    const oid_t column_itr) const {
+  auto entry = dict_encoded_columns_.find(column_itr);
+  if (entry == dict_encoded_columns_.end()) return nullptr;
+  return entry->second.get();
+}
+
 /*
  * Faster way to get value
  * By amortizing schema lookups
@@ -148,6 +186,7 @@ type::Value Tile::GetValueFast(const oid_t tuple_offset,
 void Tile::SetValue(const type::Value &value, const oid_t tuple_offset,
                     const oid_t column_id) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
+  PL_ASSERT(IsMemoryMapped() == false);
   PL_ASSERT(column_id < schema.GetColumnCount());
 
   char *tuple_location = GetTupleLocation(tuple_offset);
@@ -176,6 +215,7 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
                         const size_t column_offset, const bool is_inlined,
                         UNUSED_ATTRIBUTE const size_t column_length) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
+  PL_ASSERT(IsMemoryMapped() == false);
   PL_ASSERT(column_offset < schema.GetLength());
 
   char *tuple_location = GetTupleLocation(tuple_offset);
@@ -221,6 +261,46 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   return new_tile;
 }
 
+type::AbstractPool *Tile::CompactVarlenPool() {
+  if (pool == nullptr) return nullptr;
+
+  auto *old_pool = static_cast<type::EphemeralPool *>(pool);
+  auto *new_pool = new type::EphemeralPool();
+
+  for (oid_t col_itr = 0; col_itr < column_count; col_itr++) {
+    type::TypeId type_id = schema.GetType(col_itr);
+    if ((type_id != type::TypeId::VARCHAR &&
+         type_id != type::TypeId::VARBINARY) ||
+        schema.IsInlined(col_itr) == true) {
+      continue;
+    }
+
+    const size_t column_offset = schema.GetOffset(col_itr);
+    for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+      char *field_location = GetTupleLocation(tuple_itr) + column_offset;
+      char *varlen_ptr = type::Value::GetDataFromStorage(type_id, field_location);
+      if (varlen_ptr == nullptr) {
+        continue;
+      }
+
+      // Slots the GC already reset keep their stale pointer bytes; only
+      // live allocations are moved
+      size_t allocation_size = old_pool->AllocationSize(varlen_ptr);
+      if (allocation_size == 0) {
+        continue;
+      }
+
+      char *copy =
+          reinterpret_cast<char *>(new_pool->Allocate(allocation_size));
+      PL_MEMCPY(copy, varlen_ptr, allocation_size);
+      *reinterpret_cast<char **>(field_location) = copy;
+    }
+  }
+
+  pool = new_pool;
+  return old_pool;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -484,6 +564,127 @@ void Tile::Sync() {
   // storage_manager.Sync(backend_type, data, tile_size);
 }
 
+//===--------------------------------------------------------------------===//
+// Memory-mapped readonly storage
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// Page-sized file header preceding the raw tile data, so the data region
+// starts page-aligned in the mapping
+struct TileFileHeader {
+  uint32_t magic;
+  uint32_t num_tuple_slots;
+  uint64_t tuple_length;
+  uint64_t tile_size;
+};
+
+}  // namespace
+
+bool Tile::WriteToFile(const std::string &file_path) const {
+  // Uninlined values live in the varlen pool and cannot be remapped, so
+  // only fully-inlined schemas are eligible
+  if (schema.IsInlined() == false) {
+    return false;
+  }
+
+  FILE *tile_file = fopen(file_path.c_str(), "wb");
+  if (tile_file == nullptr) {
+    LOG_ERROR("Cannot open tile file: %s", file_path.c_str());
+    return false;
+  }
+
+  char header_page[kMmapHeaderSize];
+  PL_MEMSET(header_page, 0, sizeof(header_page));
+  TileFileHeader header;
+  header.magic = kTileFileMagic;
+  header.num_tuple_slots = num_tuple_slots;
+  header.tuple_length = tuple_length;
+  header.tile_size = tile_size;
+  PL_MEMCPY(header_page, &header, sizeof(header));
+
+  bool ok = (fwrite(header_page, 1, sizeof(header_page), tile_file) ==
+             sizeof(header_page)) &&
+            (fwrite(data, 1, tile_size, tile_file) == tile_size);
+  if (ok) {
+    fflush(tile_file);
+    fsync(fileno(tile_file));
+  }
+  fclose(tile_file);
+  return ok;
+}
+
+bool Tile::MapFromFile(const std::string &file_path) {
+  if (IsMemoryMapped() == true) {
+    return true;
+  }
+  if (schema.IsInlined() == false) {
+    return false;
+  }
+
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR("Cannot open tile file: %s", file_path.c_str());
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < kMmapHeaderSize + tile_size) {
+    LOG_ERROR("Tile file too small: %s", file_path.c_str());
+    close(fd);
+    return false;
+  }
+
+  size_t map_length = kMmapHeaderSize + tile_size;
+  void *map_base = mmap(nullptr, map_length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping holds its own reference to the file
+  close(fd);
+  if (map_base == MAP_FAILED) {
+    LOG_ERROR("Cannot map tile file: %s", file_path.c_str());
+    return false;
+  }
+
+  // The file must describe exactly this tile's layout
+  TileFileHeader header;
+  PL_MEMCPY(&header, map_base, sizeof(header));
+  if (header.magic != kTileFileMagic ||
+      header.num_tuple_slots != num_tuple_slots ||
+      header.tuple_length != tuple_length || header.tile_size != tile_size) {
+    LOG_ERROR("Tile file layout mismatch: %s", file_path.c_str());
+    munmap(map_base, map_length);
+    return false;
+  }
+
+  // Swap the heap buffer for the mapping; the OS pages data in on demand
+  storage::BackendManager::GetInstance().Release(backend_type, data);
+  mmap_base_ = static_cast<char *>(map_base);
+  mmap_length_ = map_length;
+  data = mmap_base_ + kMmapHeaderSize;
+  return true;
+}
+
+void Tile::AdviseSequentialAccess() {
+  if (mmap_base_ == nullptr) {
+    return;
+  }
+  madvise(mmap_base_, mmap_length_, MADV_SEQUENTIAL);
+}
+
+void Tile::AdviseWillNeed() {
+  if (mmap_base_ == nullptr) {
+    return;
+  }
+  madvise(mmap_base_, mmap_length_, MADV_WILLNEED);
+}
+
+void Tile::DropResidentPages() {
+  if (mmap_base_ == nullptr) {
+    return;
+  }
+  madvise(mmap_base_, mmap_length_, MADV_DONTNEED);
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -23,6 +23,7 @@
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "type/value_factory.h"
 #include "util/stringbox_util.h"
 
 namespace peloton {
@@ -164,6 +165,36 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
   return tuple_slot_id;
 }
 
+/**
+ * Grab up to max_count consecutive slots with one atomic operation and fill
+ * them with tuples[start_offset .. start_offset + reserved - 1]
+ *
+ * Returns the number of tuples inserted; zero when the tile group is full
+ */
+oid_t TileGroup::InsertTupleBatch(const std::vector<const Tuple *> &tuples,
+                                  const size_t start_offset,
+                                  const oid_t max_count, oid_t &first_slot) {
+  oid_t reserved =
+      tile_group_header->GetNextEmptyTupleSlots(max_count, first_slot);
+
+  LOG_TRACE("Tile Group Id :: %u reserved :: %u slots from %u ", tile_group_id,
+            reserved, first_slot);
+
+  for (oid_t slot_itr = 0; slot_itr < reserved; slot_itr++) {
+    oid_t tuple_slot_id = first_slot + slot_itr;
+
+    // copy tuple.
+    CopyTuple(tuples[start_offset + slot_itr], tuple_slot_id);
+
+    // Set MVCC info
+    PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot_id) ==
+              INVALID_TXN_ID);
+    PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_slot_id) == MAX_CID);
+    PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot_id) == MAX_CID);
+  }
+  return reserved;
+}
+
 /**
  * Grab specific slot and fill in the tuple
  * Used by recovery
@@ -333,6 +364,12 @@ oid_t TileGroup::GetTileColumnId(oid_t column_id) {
 
 type::Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
+  if (HasColumn(column_id) == false) {
+    // column added to the table after this tile group was built; every
+    // row here reads it back as NULL
+    return type::ValueFactory::GetNullValueByType(
+        table->GetSchema()->GetColumn(column_id).GetType());
+  }
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
@@ -380,6 +417,30 @@ void TileGroup::Sync() {
   }
 }
 
+bool TileGroup::WriteTilesToDirectory(const std::string &dir_path) const {
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    std::string file_path = dir_path + "/tile_" +
+                            std::to_string(tile_group_id) + "_" +
+                            std::to_string(tile_itr);
+    if (tiles[tile_itr]->WriteToFile(file_path) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TileGroup::MapTilesFromDirectory(const std::string &dir_path) {
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    std::string file_path = dir_path + "/tile_" +
+                            std::to_string(tile_group_id) + "_" +
+                            std::to_string(tile_itr);
+    if (tiles[tile_itr]->MapFromFile(file_path) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -12,8 +12,14 @@
 
 #include "storage/tile_group_factory.h"
 // #include "logging/logging_util.h"
+#include "storage/tile.h"
 #include "storage/tile_group_header.h"
 
+#ifdef PELOTON_NUMA
+#include <numa.h>
+#include <unistd.h>
+#endif
+
 //===--------------------------------------------------------------------===//
 // GUC Variables
 //===--------------------------------------------------------------------===//
@@ -27,7 +33,7 @@ namespace storage {
 TileGroup *TileGroupFactory::GetTileGroup(
     oid_t database_id, oid_t table_id, oid_t tile_group_id,
     AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-    const column_map_type &column_map, int tuple_count) {
+    const column_map_type &column_map, int tuple_count, int numa_node) {
   // Allocate the data on appropriate backend
   BackendType backend_type = BackendType::MM;
       // logging::LoggingUtil::GetBackendType(peloton_logging_mode);
@@ -42,8 +48,36 @@ TileGroup *TileGroupFactory::GetTileGroup(
   tile_group->tile_group_id = tile_group_id;
   tile_group->table_id = table_id;
 
+  if (numa_node != INVALID_NUMA_NODE) {
+    BindToNumaNode(tile_group, numa_node);
+  }
+
   return tile_group;
 }
 
+void TileGroupFactory::BindToNumaNode(UNUSED_ATTRIBUTE TileGroup *tile_group,
+                                      UNUSED_ATTRIBUTE int numa_node) {
+#ifdef PELOTON_NUMA
+  if (numa_available() < 0 || numa_node > numa_max_node()) {
+    return;
+  }
+
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const oid_t tile_count = tile_group->GetTileCount();
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    Tile *tile = tile_group->GetTile(tile_itr);
+
+    // Round the tuple storage down to its page boundary; the binding policy
+    // applies per page anyway.
+    uintptr_t start = reinterpret_cast<uintptr_t>(tile->GetTupleLocation(0));
+    uintptr_t aligned_start = start & ~(page_size - 1);
+    size_t length = tile->GetInlinedSize() + (start - aligned_start);
+
+    numa_tonode_memory(reinterpret_cast<void *>(aligned_start), length,
+                       numa_node);
+  }
+#endif
+}
+
 }  // namespace storage
 }  // namespace peloton
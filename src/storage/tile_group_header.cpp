@@ -37,14 +37,17 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      compact_header(false),
+      visibility_bitmap(nullptr),
+      frozen_begin_cid(INVALID_CID) {
   header_size = num_tuple_slots * header_entry_size;
 
-  // allocate storage space for header
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // data = reinterpret_cast<char *>(
-  // storage_manager.Allocate(backend_type, header_size));
-  data = new char[header_size];
+  // allocate storage space for header; the backend manager serves
+  // header-sized blocks from huge-page-backed slabs
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  data = reinterpret_cast<char *>(
+      backend_manager.Allocate(backend_type, header_size));
   PL_ASSERT(data != nullptr);
 
   // zero out the data
@@ -62,14 +65,126 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
 
   // Initially immutabile flag to false initially.
   immutable = false;
+
+  // Never accessed so far
+  last_access_epoch_id = INVALID_EID;
+
+  // No dead slots yet
+  dead_tuple_count = 0;
 }
 
 TileGroupHeader::~TileGroupHeader() {
   // reclaim the space
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // storage_manager.Release(backend_type, data);
-  delete[] data;
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  backend_manager.Release(backend_type, data);
+  data = nullptr;
+
+  delete[] visibility_bitmap;
+  visibility_bitmap = nullptr;
+}
+
+bool TileGroupHeader::Freeze() {
+  tile_header_lock.Lock();
+
+  if (compact_header == true || immutable == false) {
+    tile_header_lock.Unlock();
+    return false;
+  }
+
+  oid_t active_tuple_slots = GetCurrentNextTupleSlot();
+  cid_t max_begin_cid = 0;
+
+  // verify that every occupied slot is all-visible: committed, not
+  // write-locked, and with an unbounded end timestamp
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < active_tuple_slots;
+       tuple_slot_id++) {
+    txn_id_t tuple_txn_id = GetTransactionId(tuple_slot_id);
+    if (tuple_txn_id == INVALID_TXN_ID) {
+      // empty slot
+      continue;
+    }
+    cid_t tuple_begin_cid = GetBeginCommitId(tuple_slot_id);
+    cid_t tuple_end_cid = GetEndCommitId(tuple_slot_id);
+    if (tuple_txn_id != INITIAL_TXN_ID || tuple_begin_cid == MAX_CID ||
+        tuple_end_cid != MAX_CID) {
+      tile_header_lock.Unlock();
+      return false;
+    }
+    if (tuple_begin_cid > max_begin_cid) {
+      max_begin_cid = tuple_begin_cid;
+    }
+  }
+
+  // build the visibility bitmap
+  size_t bitmap_size = (num_tuple_slots + 7) / 8;
+  char *bitmap = new char[bitmap_size];
+  PL_MEMSET(bitmap, 0, bitmap_size);
+
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < active_tuple_slots;
+       tuple_slot_id++) {
+    if (GetTransactionId(tuple_slot_id) != INVALID_TXN_ID) {
+      bitmap[tuple_slot_id >> 3] |= (char)(1 << (tuple_slot_id & 7));
+    }
+  }
+
+  visibility_bitmap = bitmap;
+  frozen_begin_cid = max_begin_cid;
+  compact_header = true;
+
+  // drop the full header storage
+  storage::BackendManager::GetInstance().Release(backend_type, data);
   data = nullptr;
+
+  tile_header_lock.Unlock();
+
+  LOG_TRACE("froze tile group header: %u slots, begin cid %lu",
+            num_tuple_slots, (unsigned long)frozen_begin_cid);
+
+  return true;
+}
+
+void TileGroupHeader::Expand() {
+  tile_header_lock.Lock();
+
+  if (compact_header == false) {
+    tile_header_lock.Unlock();
+    return;
+  }
+
+  char *expanded_data =
+      reinterpret_cast<char *>(storage::BackendManager::GetInstance().Allocate(
+          backend_type, header_size));
+  PL_MEMSET(expanded_data, 0, header_size);
+
+  // rebuild the per-tuple header from the frozen state. the fields are
+  // written through raw offsets because the setters would re-enter Expand()
+  // while the compact flag is still set.
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+       tuple_slot_id++) {
+    char *entry = expanded_data + (tuple_slot_id * header_entry_size);
+    bool visible = GetFrozenVisibility(tuple_slot_id);
+
+    *((txn_id_t *)(entry + txn_id_offset)) =
+        visible ? INITIAL_TXN_ID : INVALID_TXN_ID;
+    *((cid_t *)(entry + begin_cid_offset)) =
+        visible ? frozen_begin_cid : MAX_CID;
+    *((cid_t *)(entry + end_cid_offset)) = MAX_CID;
+    *((ItemPointer *)(entry + next_pointer_offset)) = INVALID_ITEMPOINTER;
+    *((ItemPointer *)(entry + prev_pointer_offset)) = INVALID_ITEMPOINTER;
+    *((ItemPointer **)(entry + indirection_offset)) = nullptr;
+  }
+
+  data = expanded_data;
+  // publish the full header before dropping the compact state, so that
+  // lock-free readers never observe the flag cleared with a null header
+  compact_header = false;
+
+  delete[] visibility_bitmap;
+  visibility_bitmap = nullptr;
+
+  tile_header_lock.Unlock();
+
+  LOG_TRACE("expanded compact tile group header: %u slots", num_tuple_slots);
 }
 
 //===--------------------------------------------------------------------===//
@@ -13,6 +13,7 @@
 
 #include "storage/tile_group_iterator.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 
 namespace peloton {
@@ -32,5 +33,44 @@ bool TileGroupIterator::HasNext() {
   return (tile_group_itr_ < table_->GetTileGroupCount());
 }
 
+bool TileGroupWindowIterator::FillWindow() {
+  window_.clear();
+  window_pos_ = 0;
+
+  auto tile_group_count = table_->GetTileGroupCount();
+  while (tile_group_itr_ < tile_group_count &&
+         window_.size() < window_size_) {
+    window_.push_back(table_->GetTileGroup(tile_group_itr_));
+    tile_group_itr_++;
+  }
+
+  // Warm the lines the sweep touches first in each pinned group: the
+  // header (per-tuple visibility info) and the start of each tile's data
+  for (auto &tile_group : window_) {
+    __builtin_prefetch(tile_group->GetHeader(), 0, 3);
+    auto tile_count = tile_group->GetTileCount();
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      auto *tile = tile_group->GetTile(tile_itr);
+      if (tile != nullptr) {
+        __builtin_prefetch(tile->GetTupleLocation(0), 0, 3);
+      }
+    }
+  }
+
+  return (window_.empty() == false);
+}
+
+bool TileGroupWindowIterator::Next(TileGroup *&tile_group) {
+  if (window_pos_ >= window_.size()) {
+    if (FillWindow() == false) {
+      return false;
+    }
+  }
+
+  tile_group = window_[window_pos_].get();
+  window_pos_++;
+  return true;
+}
+
 }  // namespace storage
 }  // namespace peloton
@@ -16,6 +16,7 @@
 #include <sstream>
 
 #include "catalog/schema.h"
+#include "catalog/tuple_accessor.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
@@ -36,6 +37,14 @@ Tuple::~Tuple() {
 type::Value Tuple::GetValue(oid_t column_id) const {
   PL_ASSERT(tuple_schema_);
   PL_ASSERT(tuple_data_);
+
+  // Fixed-width inlined columns load through the typed accessor picked
+  // when the schema was created, skipping the Type singleton dispatch
+  const auto *accessor = tuple_schema_->GetTupleAccessor();
+  if (accessor != nullptr && accessor->HasDirectAccess(column_id)) {
+    return accessor->LoadValue(tuple_data_, column_id);
+  }
+
   const type::TypeId column_type = tuple_schema_->GetType(column_id);
   const char *data_ptr = GetDataPtr(column_id);
   const bool is_inlined = tuple_schema_->IsInlined(column_id);
@@ -45,6 +54,14 @@ type::Value Tuple::GetValue(oid_t column_id) const {
 // Set all columns by value into this tuple.
 void Tuple::SetValue(const oid_t column_offset, const type::Value &value,
                      type::AbstractPool *data_pool) {
+  // Matching fixed-width values store through the typed accessor; only
+  // type mismatches and varlen columns need the dispatching path below
+  const auto *accessor = tuple_schema_->GetTupleAccessor();
+  if (accessor != nullptr &&
+      accessor->StoreValue(tuple_data_, column_offset, value)) {
+    return;
+  }
+
   const type::TypeId type = tuple_schema_->GetType(column_offset);
   LOG_TRACE("c offset: %d; using pool: %p", column_offset, data_pool);
 
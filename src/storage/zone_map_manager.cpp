@@ -81,37 +81,72 @@ void ZoneMapManager::CreateOrUpdateZoneMapForTileGroup(
     storage::DataTable *table, oid_t tile_group_idx,
     concurrency::TransactionContext *txn) {
   LOG_DEBUG("Creating Zone Maps for TileGroupId : %u", tile_group_idx);
-  
+
+  auto schema = table->GetSchema();
+  size_t num_columns = schema->GetColumnCount();
+
+  for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
+    CreateOrUpdateZoneMapForColumn(table, tile_group_idx, col_itr, txn);
+  }
+}
+
+/**
+ * @brief   The function creates the zone map for a single column of a tile
+ *          group, so callers that select columns by observed predicates do
+ *          not pay for the full-width scan.
+ * @param   table_ptr, tile_group_index, column_id and transaction_ptr
+ */
+void ZoneMapManager::CreateOrUpdateZoneMapForColumn(
+    storage::DataTable *table, oid_t tile_group_idx, oid_t col_id,
+    concurrency::TransactionContext *txn) {
   oid_t database_id = table->GetDatabaseOid();
   oid_t table_id = table->GetOid();
   auto schema = table->GetSchema();
-  size_t num_columns = schema->GetColumnCount();
   auto tile_group = table->GetTileGroup(tile_group_idx);
 
-  for (oid_t col_itr = 0; col_itr < num_columns; col_itr++) {
-    // Set temp min and temp max as the first value.
-    type::Value min = tile_group->GetValue(0, col_itr);
-    type::Value max = tile_group->GetValue(0, col_itr);
-    // Iterate over all tuples in this column
-    oid_t num_tuple_slots = tile_group->GetAllocatedTupleCount();
-    for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
-      type::Value current_val = tile_group->GetValue(tuple_itr, col_itr);
-      if (current_val.CompareGreaterThan(max) == CmpBool::TRUE) {
-        max = current_val;
-      }
-      if (current_val.CompareLessThan(min) == CmpBool::TRUE) {
-        min = current_val;
-      }
+  // Only keep statistics for types the skipping checks can compare
+  if (!IsZoneMappableType(schema->GetType(col_id))) {
+    return;
+  }
+
+  // Iterate over all tuples in this column, skipping NULLs so they never
+  // poison the min/max
+  type::Value min;
+  type::Value max;
+  bool found_value = false;
+  oid_t num_tuple_slots = tile_group->GetAllocatedTupleCount();
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+    type::Value current_val = tile_group->GetValue(tuple_itr, col_id);
+    if (current_val.IsNull()) {
+      continue;
+    }
+    if (!found_value) {
+      min = current_val;
+      max = current_val;
+      found_value = true;
+      continue;
+    }
+    if (current_val.CompareGreaterThan(max) == CmpBool::TRUE) {
+      max = current_val;
+    }
+    if (current_val.CompareLessThan(min) == CmpBool::TRUE) {
+      min = current_val;
     }
-    type::TypeId val_type = min.GetTypeId();
-    std::string converted_min = min.ToString();
-    std::string converted_max = max.ToString();
-    std::string converted_type = TypeIdToString(val_type);
-
-    CreateOrUpdateZoneMapInCatalog(database_id, table_id, tile_group_idx,
-                                   col_itr, converted_min, converted_max,
-                                   converted_type, txn);
   }
+
+  // All-NULL column in this tile group; nothing to record
+  if (!found_value) {
+    return;
+  }
+
+  type::TypeId val_type = min.GetTypeId();
+  std::string converted_min = min.ToString();
+  std::string converted_max = max.ToString();
+  std::string converted_type = TypeIdToString(val_type);
+
+  CreateOrUpdateZoneMapInCatalog(database_id, table_id, tile_group_idx, col_id,
+                                 converted_min, converted_max, converted_type,
+                                 txn);
 }
 
 /**
@@ -214,6 +249,19 @@ bool ZoneMapManager::ShouldScanTileGroup(
     if (stats == nullptr) {
       return true;
     }
+
+    // The statistics carry the column's native type, but the literal in the
+    // plan may be narrower (INTEGER against a DECIMAL column) or a string
+    // (TIMESTAMP literals); cast before comparing so the checks below never
+    // compare across types.
+    type::TypeId stats_type = stats->min.GetTypeId();
+    if (predicate_value.GetTypeId() != stats_type) {
+      if (!predicate_value.CheckComparable(stats->min)) {
+        return true;
+      }
+      predicate_value = predicate_value.CastAs(stats_type);
+    }
+
     switch (comparison_operator) {
       case (int)ExpressionType::COMPARE_EQUAL:
         if (!checkEqual(predicate_value, stats.get())) {
@@ -252,5 +300,20 @@ bool ZoneMapManager::ShouldScanTileGroup(
  */
 bool ZoneMapManager::ZoneMapTableExists() { return zone_map_table_exists; }
 
+bool ZoneMapManager::IsZoneMappableType(type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace storage
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// mono_queue_pool.cpp
+//
+// Identification: src/threadpool/mono_queue_pool.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "threadpool/mono_queue_pool.h"
+
+#include <algorithm>
+
+#ifdef PELOTON_NUMA
+#include <numa.h>
+#endif
+
+namespace peloton {
+namespace threadpool {
+
+int MonoQueuePool::NumaNodeCount() {
+#ifdef PELOTON_NUMA
+  if (numa_available() >= 0) {
+    return numa_max_node() + 1;
+  }
+#endif
+  return 1;
+}
+
+std::vector<std::unique_ptr<MonoQueuePool>> &MonoQueuePool::GetNodeInstances() {
+  // Split the configured worker budget across the sockets; every socket
+  // keeps at least one worker
+  static std::vector<std::unique_ptr<MonoQueuePool>> node_pools = []() {
+    uint32_t task_queue_size = settings::SettingsManager::GetInt(
+        settings::SettingId::monoqueue_task_queue_size);
+    uint32_t worker_pool_size = settings::SettingsManager::GetInt(
+        settings::SettingId::monoqueue_worker_pool_size);
+    int node_count = NumaNodeCount();
+    uint32_t per_node_size =
+        std::max<uint32_t>(worker_pool_size / node_count, 1);
+
+    std::vector<std::unique_ptr<MonoQueuePool>> pools;
+    for (int node = 0; node < node_count; node++) {
+      pools.emplace_back(
+          new MonoQueuePool(task_queue_size, per_node_size, node));
+    }
+    return pools;
+  }();
+  return node_pools;
+}
+
+MonoQueuePool &MonoQueuePool::GetInstance(int numa_node) {
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::numa_partition_mode) == false) {
+    return GetInstance();
+  }
+  int node_count = NumaNodeCount();
+  if (node_count <= 1 || numa_node == INVALID_NUMA_NODE ||
+      numa_node >= node_count) {
+    // no topology to exploit, or no single home socket: stay on the shared
+    // coordination pool
+    return GetInstance();
+  }
+  return *(GetNodeInstances()[numa_node]);
+}
+
+void MonoQueuePool::StartupNodeInstances() {
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::numa_partition_mode) == false ||
+      NumaNodeCount() <= 1) {
+    return;
+  }
+  for (auto &pool : GetNodeInstances()) {
+    pool->Startup();
+  }
+}
+
+void MonoQueuePool::ShutdownNodeInstances() {
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::numa_partition_mode) == false ||
+      NumaNodeCount() <= 1) {
+    return;
+  }
+  for (auto &pool : GetNodeInstances()) {
+    pool->Shutdown();
+  }
+}
+
+}  // namespace threadpool
+}  // namespace peloton
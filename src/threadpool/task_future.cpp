@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_future.cpp
+//
+// Identification: src/threadpool/task_future.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "threadpool/task_future.h"
+
+#include <atomic>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace threadpool {
+
+void TaskFuture::TaskState::Complete() {
+  std::vector<std::function<void()>> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    PL_ASSERT(done == false);
+    done = true;
+    pending.swap(continuations);
+  }
+  cv.notify_all();
+  for (auto &continuation : pending) {
+    if (pool != nullptr) {
+      pool->SubmitTask(std::move(continuation));
+    } else {
+      continuation();
+    }
+  }
+}
+
+void TaskFuture::TaskState::AddContinuation(
+    std::function<void()> continuation) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (done == false) {
+      continuations.emplace_back(std::move(continuation));
+      return;
+    }
+  }
+  // already complete: the continuation is runnable right away
+  if (pool != nullptr) {
+    pool->SubmitTask(std::move(continuation));
+  } else {
+    continuation();
+  }
+}
+
+bool TaskFuture::IsDone() const {
+  PL_ASSERT(IsValid());
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->done;
+}
+
+void TaskFuture::Wait() const {
+  PL_ASSERT(IsValid());
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  state_->cv.wait(lock, [this] { return state_->done; });
+}
+
+TaskFuture TaskFuture::Then(std::function<void()> continuation) const {
+  PL_ASSERT(IsValid());
+  auto next_state = MakeState(state_->pool);
+  std::function<void()> task =
+      [continuation, next_state]() {
+        continuation();
+        next_state->Complete();
+      };
+  state_->AddContinuation(std::move(task));
+  return TaskFuture(next_state);
+}
+
+TaskFuture TaskFuture::WhenAll(const std::vector<TaskFuture> &futures) {
+  auto joint_state =
+      MakeState(futures.empty() ? nullptr : futures.front().state_->pool);
+  if (futures.empty()) {
+    joint_state->Complete();
+    return TaskFuture(joint_state);
+  }
+
+  // the last future to finish completes the joint future on its worker
+  auto remaining = std::make_shared<std::atomic<size_t>>(futures.size());
+  for (auto &future : futures) {
+    PL_ASSERT(future.IsValid());
+    future.state_->AddContinuation([joint_state, remaining]() {
+      if (remaining->fetch_sub(1) == 1) {
+        joint_state->Complete();
+      }
+    });
+  }
+  return TaskFuture(joint_state);
+}
+
+std::shared_ptr<TaskFuture::TaskState> TaskFuture::MakeState(
+    WorkStealingPool *pool) {
+  auto state = std::make_shared<TaskState>();
+  state->pool = pool;
+  return state;
+}
+
+}  // namespace threadpool
+}  // namespace peloton
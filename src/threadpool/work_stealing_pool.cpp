@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// work_stealing_pool.cpp
+//
+// Identification: src/threadpool/work_stealing_pool.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "threadpool/work_stealing_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef PELOTON_NUMA
+#include <numa.h>
+#endif
+
+namespace peloton {
+namespace threadpool {
+
+void WorkStealingPool::BindToNumaNode() {
+#ifdef PELOTON_NUMA
+  if (numa_node_ == INVALID_NUMA_NODE || numa_available() < 0 ||
+      numa_node_ > numa_max_node()) {
+    return;
+  }
+  // run on the node's cores and allocate from its local memory
+  numa_run_on_node(numa_node_);
+  numa_set_preferred(numa_node_);
+#endif
+}
+
+void WorkStealingPool::Startup() {
+  queues_.clear();
+  for (size_t worker_itr = 0; worker_itr < num_workers_; worker_itr++) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  should_shutdown_ = false;
+  for (size_t worker_itr = 0; worker_itr < num_workers_; worker_itr++) {
+    workers_.emplace_back(&WorkStealingPool::WorkerLoop, this, worker_itr);
+  }
+}
+
+void WorkStealingPool::Shutdown() {
+  if (workers_.empty()) {
+    return;
+  }
+  should_shutdown_ = true;
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void WorkStealingPool::SubmitTask(std::function<void()> func) {
+  // no placement preference: spread submissions round-robin
+  SubmitTask(submit_cursor_.fetch_add(1), std::move(func));
+}
+
+void WorkStealingPool::SubmitTask(size_t affinity_hint,
+                                  std::function<void()> func) {
+  WorkerQueue &queue = *queues_[affinity_hint % num_workers_];
+  queue.latch.Lock();
+  queue.tasks.push_back(std::move(func));
+  queue.approx_size.store(queue.tasks.size());
+  queue.latch.Unlock();
+}
+
+bool WorkStealingPool::PopLocal(size_t worker_id,
+                                std::function<void()> &task) {
+  WorkerQueue &queue = *queues_[worker_id];
+  if (queue.approx_size.load() == 0) {
+    return false;
+  }
+  queue.latch.Lock();
+  if (queue.tasks.empty()) {
+    queue.latch.Unlock();
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  queue.approx_size.store(queue.tasks.size());
+  queue.latch.Unlock();
+  return true;
+}
+
+bool WorkStealingPool::StealHalf(size_t worker_id,
+                                 std::function<void()> &task) {
+  for (size_t victim_itr = 1; victim_itr < num_workers_; victim_itr++) {
+    size_t victim_id = (worker_id + victim_itr) % num_workers_;
+    WorkerQueue &victim = *queues_[victim_id];
+    if (victim.approx_size.load() == 0) {
+      continue;
+    }
+
+    // Take the older half of the victim's deque from the front; the victim
+    // keeps the newer tasks it is about to pop for locality. The loot is
+    // moved out under the victim's latch only, so no two latches are ever
+    // held at once.
+    std::vector<std::function<void()>> loot;
+    victim.latch.Lock();
+    size_t steal_count = (victim.tasks.size() + 1) / 2;
+    for (size_t steal_itr = 0; steal_itr < steal_count; steal_itr++) {
+      loot.emplace_back(std::move(victim.tasks.front()));
+      victim.tasks.pop_front();
+    }
+    victim.approx_size.store(victim.tasks.size());
+    victim.latch.Unlock();
+
+    if (loot.empty()) {
+      continue;
+    }
+
+    // run the oldest stolen task now, queue the rest locally
+    task = std::move(loot.front());
+    if (loot.size() > 1) {
+      WorkerQueue &queue = *queues_[worker_id];
+      queue.latch.Lock();
+      for (size_t loot_itr = 1; loot_itr < loot.size(); loot_itr++) {
+        queue.tasks.push_back(std::move(loot[loot_itr]));
+      }
+      queue.approx_size.store(queue.tasks.size());
+      queue.latch.Unlock();
+    }
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingPool::HasPendingTasks() const {
+  for (auto &queue : queues_) {
+    if (queue->approx_size.load() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::WorkerLoop(size_t worker_id) {
+  BindToNumaNode();
+
+  constexpr auto kMinPauseTime = std::chrono::microseconds(1);
+  constexpr auto kMaxPauseTime = std::chrono::microseconds(1000);
+
+  auto pause_time = kMinPauseTime;
+  while (!should_shutdown_.load() || HasPendingTasks()) {
+    std::function<void()> task;
+    if (PopLocal(worker_id, task) || StealHalf(worker_id, task)) {
+      task();
+      pause_time = kMinPauseTime;
+    } else {
+      // Polling with exponential backoff
+      std::this_thread::sleep_for(pause_time);
+      pause_time = std::min(pause_time * 2, kMaxPauseTime);
+    }
+  }
+}
+
+}  // namespace threadpool
+}  // namespace peloton
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// admission_controller.cpp
+//
+// Identification: src/traffic_cop/admission_controller.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "traffic_cop/admission_controller.h"
+
+#include <vector>
+
+#include "settings/settings_manager.h"
+
+namespace peloton {
+namespace tcop {
+
+AdmissionController &AdmissionController::GetInstance() {
+  static AdmissionController admission_controller;
+  return admission_controller;
+}
+
+size_t AdmissionController::ClassLimit(AdmissionClass admission_class) {
+  settings::SettingId id;
+  switch (admission_class) {
+    case AdmissionClass::HIGH:
+      id = settings::SettingId::admission_high_limit;
+      break;
+    case AdmissionClass::NORMAL:
+      id = settings::SettingId::admission_normal_limit;
+      break;
+    default:
+      id = settings::SettingId::admission_low_limit;
+      break;
+  }
+  int limit = settings::SettingsManager::GetInt(id);
+  return limit > 0 ? static_cast<size_t>(limit) : 0;
+}
+
+void AdmissionController::Submit(AdmissionClass admission_class,
+                                 std::function<void()> submit) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto &state = classes_[static_cast<size_t>(admission_class)];
+    size_t limit = ClassLimit(admission_class);
+    if (limit != 0 &&
+        (state.running >= limit || state.queued.empty() == false)) {
+      // At the cap, or behind earlier arrivals of the class: wait for a
+      // slot. Queued submissions run in arrival order
+      state.queued.push_back(std::move(submit));
+      return;
+    }
+    state.running++;
+  }
+  submit();
+}
+
+void AdmissionController::Finish(AdmissionClass admission_class) {
+  std::vector<std::function<void()>> dispatch;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto &state = classes_[static_cast<size_t>(admission_class)];
+    PL_ASSERT(state.running > 0);
+    state.running--;
+
+    // Hand the freed capacity out highest class first
+    for (size_t class_itr = 0; class_itr < kNumClasses; class_itr++) {
+      auto &drain_state = classes_[class_itr];
+      size_t limit = ClassLimit(static_cast<AdmissionClass>(class_itr));
+      while (drain_state.queued.empty() == false &&
+             (limit == 0 || drain_state.running < limit)) {
+        dispatch.push_back(std::move(drain_state.queued.front()));
+        drain_state.queued.pop_front();
+        drain_state.running++;
+      }
+    }
+  }
+  // Run the dispatched submissions outside the latch; they only hand
+  // their statements to a worker pool
+  for (auto &submit : dispatch) {
+    submit();
+  }
+}
+
+size_t AdmissionController::QueuedCount(AdmissionClass admission_class) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return classes_[static_cast<size_t>(admission_class)].queued.size();
+}
+
+}  // namespace tcop
+}  // namespace peloton
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// result_cache.cpp
+//
+// Identification: src/traffic_cop/result_cache.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "traffic_cop/result_cache.h"
+
+namespace peloton {
+namespace tcop {
+
+ResultCache &ResultCache::GetInstance() {
+  static ResultCache cache;
+  return cache;
+}
+
+ResultCache::TableEpochVector ResultCache::SnapshotTableEpochs(
+    const std::set<oid_t> &table_oids) {
+  TableEpochVector epochs;
+  epochs.reserve(table_oids.size());
+  latch_.ReadLock();
+  for (oid_t table_oid : table_oids) {
+    auto it = table_epochs_.find(table_oid);
+    epochs.emplace_back(table_oid,
+                        it == table_epochs_.end() ? 0 : it->second);
+  }
+  latch_.Unlock();
+  return epochs;
+}
+
+void ResultCache::BumpTableEpochs(const std::set<oid_t> &table_oids) {
+  latch_.WriteLock();
+  for (oid_t table_oid : table_oids) {
+    table_epochs_[table_oid]++;
+  }
+  latch_.Unlock();
+}
+
+bool ResultCache::Get(const std::string &key, std::vector<ResultValue> &rows,
+                      int &rows_affected) {
+  latch_.ReadLock();
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    latch_.Unlock();
+    return false;
+  }
+  // a relation written since the fill makes the entry stale; report a miss
+  // and let the refill overwrite it rather than mutating under a read lock
+  for (const auto &table_epoch : it->second.table_epochs) {
+    auto epoch_it = table_epochs_.find(table_epoch.first);
+    uint64_t current =
+        epoch_it == table_epochs_.end() ? 0 : epoch_it->second;
+    if (current != table_epoch.second) {
+      latch_.Unlock();
+      return false;
+    }
+  }
+  rows = it->second.rows;
+  rows_affected = it->second.rows_affected;
+  latch_.Unlock();
+  return true;
+}
+
+void ResultCache::Put(const std::string &key, std::vector<ResultValue> rows,
+                      int rows_affected, TableEpochVector table_epochs) {
+  latch_.WriteLock();
+  if (entries_.size() >= kMaxEntries && entries_.count(key) == 0) {
+    entries_.clear();
+  }
+  auto &entry = entries_[key];
+  entry.rows = std::move(rows);
+  entry.rows_affected = rows_affected;
+  entry.table_epochs = std::move(table_epochs);
+  latch_.Unlock();
+}
+
+void ResultCache::Clear() {
+  latch_.WriteLock();
+  entries_.clear();
+  table_epochs_.clear();
+  latch_.Unlock();
+}
+
+}  // namespace tcop
+}  // namespace peloton
@@ -12,32 +12,331 @@
 
 #include "traffic_cop/traffic_cop.h"
 
+#include <chrono>
+#include <thread>
 #include <utility>
 
 #include "binder/bind_node_visitor.h"
+#include "catalog/catalog_name_cache.h"
 #include "common/internal_types.h"
+#include "common/statement_cache_manager.h"
 #include "concurrency/transaction_context.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
 #include "optimizer/optimizer.h"
+#include "parser/select_statement.h"
+#include "planner/abstract_scan_plan.h"
+#include "planner/delete_plan.h"
+#include "planner/insert_plan.h"
 #include "planner/plan_util.h"
+#include "planner/update_plan.h"
 #include "settings/settings_manager.h"
+#include "storage/data_table.h"
 #include "threadpool/mono_queue_pool.h"
 
 namespace peloton {
 namespace tcop {
 
+namespace {
+
+// Mask string and numeric literals in the query text so that queries that
+// differ only in constants produce the same fingerprint.
+std::string MaskQueryLiterals(const std::string &query) {
+  std::string masked;
+  masked.reserve(query.size());
+  char prev = '\0';
+  size_t i = 0;
+  while (i < query.size()) {
+    char c = query[i];
+    if (c == '\'') {
+      // string literal; a doubled quote is an escaped quote
+      masked.push_back('$');
+      i++;
+      while (i < query.size()) {
+        if (query[i] == '\'') {
+          if (i + 1 < query.size() && query[i + 1] == '\'') {
+            i += 2;
+            continue;
+          }
+          i++;
+          break;
+        }
+        i++;
+      }
+      prev = '\'';
+      continue;
+    }
+    if (isdigit(c) && isalnum(prev) == false && prev != '_') {
+      // numeric literal
+      masked.push_back('#');
+      while (i < query.size() && (isdigit(query[i]) || query[i] == '.')) {
+        i++;
+      }
+      prev = '0';
+      continue;
+    }
+    masked.push_back(c);
+    prev = c;
+    i++;
+  }
+  return masked;
+}
+
+// True if the expression tree contains a parameter or a subquery. Trees
+// with parameters come from PREPARE and must keep their parameter indices;
+// subqueries carry expressions we cannot see from here.
+bool ContainsParameterOrSubquery(const expression::AbstractExpression *expr) {
+  if (expr == nullptr) {
+    return false;
+  }
+  auto type = expr->GetExpressionType();
+  if (type == ExpressionType::VALUE_PARAMETER ||
+      type == ExpressionType::ROW_SUBQUERY ||
+      type == ExpressionType::SELECT_SUBQUERY) {
+    return true;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    if (ContainsParameterOrSubquery(expr->GetChild(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Replace every constant below expr with a parameter slot, collecting the
+// constant values in traversal order.
+void ParameterizeConstants(expression::AbstractExpression *expr,
+                           std::vector<type::Value> &param_values) {
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    auto *child = expr->GetModifiableChild(i);
+    if (child == nullptr) {
+      continue;
+    }
+    if (child->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+      param_values.push_back(
+          static_cast<expression::ConstantValueExpression *>(child)
+              ->GetValue());
+      expr->SetChild(i, new expression::ParameterValueExpression(
+                            static_cast<int>(param_values.size() - 1)));
+    } else {
+      ParameterizeConstants(child, param_values);
+    }
+  }
+}
+
+// Append the textual form of every constant in the tree to the
+// fingerprint. Used for the clauses we do not parameterize: their
+// constants must match exactly for a cached plan to be reused.
+void AppendConstantsToFingerprint(const expression::AbstractExpression *expr,
+                                  std::string &fingerprint) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+    fingerprint.push_back('|');
+    fingerprint.append(
+        static_cast<const expression::ConstantValueExpression *>(expr)
+            ->GetValue()
+            .ToString());
+    return;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    AppendConstantsToFingerprint(expr->GetChild(i), fingerprint);
+  }
+}
+
+// Compute the plan cache key for a single-table select and replace its
+// where-clause constants with parameter slots. Returns false (leaving the
+// parse tree untouched) for shapes the cache does not handle.
+bool ComputeSelectPlanCacheKey(const std::string &query_string,
+                               const std::string &default_database_name,
+                               parser::SelectStatement *select,
+                               std::string &fingerprint,
+                               std::vector<type::Value> &param_values) {
+  if (select->union_select != nullptr || select->from_table == nullptr ||
+      select->from_table->type != TableReferenceType::NAME) {
+    return false;
+  }
+
+  if (ContainsParameterOrSubquery(select->where_clause.get())) {
+    return false;
+  }
+  for (auto &expr : select->select_list) {
+    if (ContainsParameterOrSubquery(expr.get())) {
+      return false;
+    }
+  }
+  if (select->group_by != nullptr) {
+    for (auto &expr : select->group_by->columns) {
+      if (ContainsParameterOrSubquery(expr.get())) {
+        return false;
+      }
+    }
+    if (ContainsParameterOrSubquery(select->group_by->having.get())) {
+      return false;
+    }
+  }
+  if (select->order != nullptr) {
+    for (auto &expr : select->order->exprs) {
+      if (ContainsParameterOrSubquery(expr.get())) {
+        return false;
+      }
+    }
+  }
+
+  fingerprint = default_database_name;
+  fingerprint.push_back('|');
+  fingerprint.append(MaskQueryLiterals(query_string));
+
+  // only the where clause is parameterized; constants anywhere else keep
+  // their values in the key
+  for (auto &expr : select->select_list) {
+    AppendConstantsToFingerprint(expr.get(), fingerprint);
+  }
+  if (select->group_by != nullptr) {
+    for (auto &expr : select->group_by->columns) {
+      AppendConstantsToFingerprint(expr.get(), fingerprint);
+    }
+    AppendConstantsToFingerprint(select->group_by->having.get(), fingerprint);
+  }
+  if (select->order != nullptr) {
+    for (auto &expr : select->order->exprs) {
+      AppendConstantsToFingerprint(expr.get(), fingerprint);
+    }
+  }
+  if (select->limit != nullptr) {
+    fingerprint.push_back('|');
+    fingerprint.append(std::to_string(select->limit->limit));
+    fingerprint.push_back(',');
+    fingerprint.append(std::to_string(select->limit->offset));
+  }
+
+  if (select->where_clause != nullptr) {
+    if (select->where_clause->GetExpressionType() ==
+        ExpressionType::VALUE_CONSTANT) {
+      // a bare constant predicate stays in the key instead
+      AppendConstantsToFingerprint(select->where_clause.get(), fingerprint);
+    } else {
+      ParameterizeConstants(select->where_clause.get(), param_values);
+    }
+  }
+  return true;
+}
+
+
+// True if the prepared statement is a plain SELECT that can run as a
+// declared read-only transaction. SELECT ... FOR UPDATE acquires tuple
+// ownership during reads, so it has to stay on the regular path.
+bool IsReadOnlyStatement(const std::shared_ptr<Statement> &statement) {
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::read_only_fast_path) == false) {
+    return false;
+  }
+  if (statement->GetQueryType() != QueryType::QUERY_SELECT) {
+    return false;
+  }
+  auto &sql_stmt_list = statement->GetStmtParseTreeList();
+  for (size_t i = 0; i < sql_stmt_list->GetNumStatements(); i++) {
+    auto *sql_stmt = sql_stmt_list->GetStatement(i);
+    if (sql_stmt->GetType() != StatementType::SELECT) {
+      return false;
+    }
+    if (static_cast<parser::SelectStatement *>(sql_stmt)->is_for_update) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// True if the statement's finished result may be served from (and stored
+// into) the process-wide result cache: a plain SELECT outside any explicit
+// transaction whose referenced relations are known, since those relations
+// drive the epoch-based invalidation. SELECT ... FOR UPDATE acquires tuple
+// ownership during reads, which a cache hit would silently skip.
+bool IsResultCacheableStatement(const std::shared_ptr<Statement> &statement) {
+  if (settings::SettingsManager::GetBool(settings::SettingId::result_cache) ==
+      false) {
+    return false;
+  }
+  if (statement == nullptr ||
+      statement->GetQueryType() != QueryType::QUERY_SELECT ||
+      statement->GetReferencedTables().empty()) {
+    return false;
+  }
+  auto &sql_stmt_list = statement->GetStmtParseTreeList();
+  if (sql_stmt_list == nullptr) {
+    return false;
+  }
+  for (size_t i = 0; i < sql_stmt_list->GetNumStatements(); i++) {
+    auto *sql_stmt = sql_stmt_list->GetStatement(i);
+    if (sql_stmt->GetType() != StatementType::SELECT) {
+      return false;
+    }
+    if (static_cast<parser::SelectStatement *>(sql_stmt)->is_for_update) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Home NUMA node of the statement's target table, used to route execution
+// to that socket's worker pool in NUMA partition mode. Statements without a
+// single target table (joins, DDL, ...) have no home node and stay on the
+// shared pool.
+int PlanHomeNumaNode(const planner::AbstractPlan *plan) {
+  storage::DataTable *target_table = nullptr;
+  switch (plan->GetPlanNodeType()) {
+    case PlanNodeType::SEQSCAN:
+    case PlanNodeType::INDEXSCAN:
+      target_table =
+          static_cast<const planner::AbstractScan *>(plan)->GetTable();
+      break;
+    case PlanNodeType::INSERT:
+      target_table =
+          static_cast<const planner::InsertPlan *>(plan)->GetTable();
+      break;
+    case PlanNodeType::UPDATE:
+      target_table =
+          static_cast<const planner::UpdatePlan *>(plan)->GetTable();
+      break;
+    case PlanNodeType::DELETE:
+      target_table =
+          static_cast<const planner::DeletePlan *>(plan)->GetTable();
+      break;
+    default:
+      break;
+  }
+  if (target_table == nullptr) {
+    return INVALID_NUMA_NODE;
+  }
+  return target_table->GetHomeNumaNode();
+}
+
+}  // namespace
+
 TrafficCop::TrafficCop()
     : is_queuing_(false),
       rows_affected_(0),
       optimizer_(new optimizer::Optimizer()),
-      single_statement_txn_(true) {}
+      single_statement_txn_(true) {
+  if (StatementCacheManager::GetStmtCacheManager().get() != nullptr) {
+    StatementCacheManager::GetStmtCacheManager()->RegisterStatementCache(
+        &plan_cache_);
+  }
+}
 
 TrafficCop::TrafficCop(void (*task_callback)(void *), void *task_callback_arg)
     : optimizer_(new optimizer::Optimizer()),
       single_statement_txn_(true),
       task_callback_(task_callback),
-      task_callback_arg_(task_callback_arg) {}
+      task_callback_arg_(task_callback_arg) {
+  if (StatementCacheManager::GetStmtCacheManager().get() != nullptr) {
+    StatementCacheManager::GetStmtCacheManager()->RegisterStatementCache(
+        &plan_cache_);
+  }
+}
 
 void TrafficCop::Reset() {
   std::stack<TcopTxnState> new_tcop_txn_state;
@@ -50,6 +349,10 @@ void TrafficCop::Reset() {
 }
 
 TrafficCop::~TrafficCop() {
+  if (StatementCacheManager::GetStmtCacheManager().get() != nullptr) {
+    StatementCacheManager::GetStmtCacheManager()->UnRegisterStatementCache(
+        &plan_cache_);
+  }
   // Abort all running transactions
   while (!tcop_txn_state_.empty()) {
     AbortQueryHelper();
@@ -93,6 +396,21 @@ ResultType TrafficCop::BeginQueryHelper(size_t thread_id) {
   return ResultType::SUCCESS;
 }
 
+concurrency::TransactionContext *TrafficCop::GetOrBeginTransaction(
+    size_t thread_id) {
+  if (!tcop_txn_state_.empty()) {
+    return tcop_txn_state_.top().first;
+  }
+  // materialize the deferred implicit transaction
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = deferred_txn_read_only_
+                 ? txn_manager.BeginTransaction(thread_id,
+                                                IsolationLevelType::READ_ONLY)
+                 : txn_manager.BeginTransaction(thread_id);
+  tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
+  return txn;
+}
+
 ResultType TrafficCop::CommitQueryHelper() {
   // do nothing if we have no active txns
   if (tcop_txn_state_.empty()) return ResultType::NOOP;
@@ -106,9 +424,28 @@ ResultType TrafficCop::CommitQueryHelper() {
   // 'ROLLBACK' After receive 'COMMIT', see if it is rollback or really commit.
   if (curr_state.second != ResultType::ABORTED) {
     // txn committed
-    return txn_manager.CommitTransaction(txn);
+    auto commit_result = txn_manager.CommitTransaction(txn);
+    // the writes are visible now; stale out any cached results over the
+    // written relations. DDL is not attributable to epochs, so it drops
+    // the whole cache
+    if (commit_result == ResultType::SUCCESS) {
+      if (txn_ran_ddl_) {
+        ResultCache::GetInstance().Clear();
+      } else if (txn_written_tables_.empty() == false) {
+        ResultCache::GetInstance().BumpTableEpochs(txn_written_tables_);
+      }
+    }
+    if (tcop_txn_state_.empty()) {
+      txn_written_tables_.clear();
+      txn_ran_ddl_ = false;
+    }
+    return commit_result;
   } else {
     // otherwise, rollback
+    if (tcop_txn_state_.empty()) {
+      txn_written_tables_.clear();
+      txn_ran_ddl_ = false;
+    }
     return txn_manager.AbortTransaction(txn);
   }
 }
@@ -118,6 +455,10 @@ ResultType TrafficCop::AbortQueryHelper() {
   if (tcop_txn_state_.empty()) return ResultType::NOOP;
   auto &curr_state = tcop_txn_state_.top();
   tcop_txn_state_.pop();
+  if (tcop_txn_state_.empty()) {
+    txn_written_tables_.clear();
+    txn_ran_ddl_ = false;
+  }
   // explicitly abort the txn only if it has not aborted already
   if (curr_state.second != ResultType::ABORTED) {
     auto txn = curr_state.first;
@@ -152,20 +493,61 @@ ResultType TrafficCop::ExecuteStatementGetResult() {
 executor::ExecutionResult TrafficCop::ExecuteHelper(
     std::shared_ptr<planner::AbstractPlan> plan,
     const std::vector<type::Value> &params, std::vector<ResultValue> &result,
-    const std::vector<int> &result_format, size_t thread_id) {
+    const std::vector<int> &result_format, size_t thread_id,
+    std::shared_ptr<Statement> statement) {
   auto &curr_state = GetCurrentTxnState();
 
   concurrency::TransactionContext *txn;
   if (!tcop_txn_state_.empty()) {
     txn = curr_state.first;
   } else {
-    // No active txn, single-statement txn
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    // new txn, reset result status
+    // No active txn: materialize the deferred single-statement txn here,
+    // on the first data access
     curr_state.second = ResultType::SUCCESS;
     single_statement_txn_ = true;
-    txn = txn_manager.BeginTransaction(thread_id);
-    tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
+    txn = GetOrBeginTransaction(thread_id);
+  }
+
+  // Anything but a plain read can touch its referenced relations; remember
+  // them so the result cache epochs are bumped when this txn commits. DDL
+  // plans report no referenced relations at all, so their effects cannot be
+  // attributed to epochs; remember that separately and drop the whole
+  // result cache at commit.
+  if (statement != nullptr &&
+      statement->GetQueryType() != QueryType::QUERY_SELECT) {
+    const auto tables = statement->GetReferencedTables();
+    txn_written_tables_.insert(tables.begin(), tables.end());
+
+    switch (statement->GetQueryType()) {
+      case QueryType::QUERY_CREATE_TABLE:
+      case QueryType::QUERY_CREATE_DB:
+      case QueryType::QUERY_CREATE_INDEX:
+      case QueryType::QUERY_CREATE_TRIGGER:
+      case QueryType::QUERY_CREATE_SCHEMA:
+      case QueryType::QUERY_CREATE_VIEW:
+      case QueryType::QUERY_DROP:
+      case QueryType::QUERY_RENAME:
+      case QueryType::QUERY_ALTER:
+        txn_ran_ddl_ = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Retain the execution context so a conflict abort of a single-statement
+  // txn can be retried server-side from ExecuteStatementPlanGetResult().
+  // Statements inside an explicit transaction are never retried: earlier
+  // statements' effects cannot be replayed.
+  if (single_statement_txn_) {
+    retry_plan_ = plan;
+    retry_params_ = &params;
+    retry_result_ = &result;
+    retry_result_format_ = &result_format;
+    retry_thread_id_ = thread_id;
+    retry_statement_ = statement;
+  } else {
+    retry_plan_ = nullptr;
   }
 
   // skip if already aborted
@@ -190,11 +572,33 @@ executor::ExecutionResult TrafficCop::ExecuteHelper(
     task_callback_(task_callback_arg_);
   };
 
-  auto &pool = threadpool::MonoQueuePool::GetInstance();
-  pool.SubmitTask([plan, txn, &params, &result, &result_format, on_complete] {
-    executor::PlanExecutor::ExecutePlan(plan, txn, params, result_format,
-                                        on_complete);
-  });
+  // in NUMA partition mode, single-table statements run on the target
+  // table's home socket pool; everything else stays on the shared pool
+  auto &pool =
+      threadpool::MonoQueuePool::GetInstance(PlanHomeNumaNode(plan.get()));
+  auto execute_task =
+      [plan, txn, &params, &result, &result_format, on_complete, statement] {
+        executor::PlanExecutor::ExecutePlan(plan, txn, params, result_format,
+                                            on_complete, statement);
+      };
+  if (settings::SettingsManager::GetBool(
+          settings::SettingId::admission_control)) {
+    // The statement takes a slot of its session's priority class before
+    // reaching the worker pool (queuing behind the class cap) and hands
+    // it back once execution finished. The captured references stay valid
+    // while queued: the protocol layer keeps them alive until the
+    // statement's result is handed back
+    auto admission_class = admission_class_;
+    AdmissionController::GetInstance().Submit(
+        admission_class, [&pool, admission_class, execute_task] {
+          pool.SubmitTask([admission_class, execute_task] {
+            execute_task();
+            AdmissionController::GetInstance().Finish(admission_class);
+          });
+        });
+  } else {
+    pool.SubmitTask(execute_task);
+  }
 
   is_queuing_ = true;
 
@@ -223,13 +627,116 @@ void TrafficCop::ExecuteStatementPlanGetResult() {
         LOG_TRACE("Abort Transaction");
         if (single_statement_txn_) {
           LOG_TRACE("Tcop_txn_state size: %lu", tcop_txn_state_.size());
+          // A single-statement txn that lost a conflict can be replayed from
+          // the retained plan without involving the client.
+          if (RetrySingleStatementTxn()) {
+            break;
+          }
           p_status_.m_result = AbortQueryHelper();
         } else {
           tcop_txn_state_.top().second = ResultType::ABORTED;
           p_status_.m_result = ResultType::ABORTED;
         }
     }
+    // a committed cacheable SELECT fills its result cache entry; the rows
+    // retained for the retry path are exactly what went to the client
+    if (result_cache_fill_) {
+      result_cache_fill_ = false;
+      if (p_status_.m_result == ResultType::SUCCESS &&
+          retry_result_ != nullptr) {
+        ResultCache::GetInstance().Put(result_cache_key_, *retry_result_,
+                                       p_status_.m_processed,
+                                       std::move(result_cache_epochs_));
+      }
+    }
+  }
+}
+
+/*
+ * Replay a conflict-aborted single-statement transaction from the context
+ * retained by ExecuteHelper(). Each attempt aborts the failed transaction,
+ * backs off with randomized exponential delay, and re-executes the plan
+ * synchronously in a fresh transaction. Returns true once an attempt
+ * commits; after the configured number of attempts the last failed
+ * transaction is left on the state stack for the caller to abort as usual.
+ */
+bool TrafficCop::RetrySingleStatementTxn() {
+  int max_retries = settings::SettingsManager::GetInt(
+      settings::SettingId::single_statement_txn_retries);
+  if (max_retries <= 0 || retry_plan_ == nullptr) {
+    return false;
+  }
+
+  // Only transaction-level conflicts are worth replaying; anything the
+  // executor itself reported (constraint violation, bad plan) will fail
+  // the same way again.
+  if (GetCurrentTxnState().first->GetResult() != ResultType::FAILURE) {
+    return false;
+  }
+
+  // per-connection xorshift64* stream for backoff jitter; seeded off this
+  // object so concurrent connections do not back off in lock step
+  uint64_t jitter_state =
+      reinterpret_cast<uintptr_t>(this) ^
+      static_cast<uint64_t>(
+          std::chrono::steady_clock::now().time_since_epoch().count());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  // whether a failed transaction is still sitting on the state stack; a
+  // commit-time conflict is cleaned up inside CommitQueryHelper already
+  bool failed_txn_on_stack = true;
+  for (int attempt = 1; attempt <= max_retries; attempt++) {
+    // roll back the failed attempt
+    if (failed_txn_on_stack) {
+      AbortQueryHelper();
+    }
+
+    // randomized exponential backoff: [0, 64us), [0, 128us), [0, 256us), ...
+    jitter_state ^= jitter_state >> 12;
+    jitter_state ^= jitter_state << 25;
+    jitter_state ^= jitter_state >> 27;
+    uint64_t window_us = 64ULL << (attempt - 1);
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        (jitter_state * 0x2545F4914F6CDD1DULL) % window_us));
+
+    LOG_TRACE("Retrying single-statement txn, attempt %d of %d", attempt,
+              max_retries);
+    auto txn = txn_manager.BeginTransaction(retry_thread_id_);
+    single_statement_txn_ = true;
+    tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
+    retry_result_->clear();
+
+    // Execute inline: we are already in the result phase of this statement,
+    // so there is no task callback to re-arm.
+    auto on_complete = [this](executor::ExecutionResult p_status,
+                              std::vector<ResultValue> &&values) {
+      this->p_status_ = p_status;
+      this->error_message_ = std::move(p_status.m_error_message);
+      *retry_result_ = std::move(values);
+    };
+    executor::PlanExecutor::ExecutePlan(retry_plan_, txn, *retry_params_,
+                                        *retry_result_format_, on_complete,
+                                        retry_statement_);
+
+    if (p_status_.m_result != ResultType::FAILURE &&
+        txn->GetResult() == ResultType::SUCCESS) {
+      auto commit_result = CommitQueryHelper();
+      if (commit_result != ResultType::ABORTED) {
+        p_status_.m_result = commit_result;
+        return true;
+      }
+      failed_txn_on_stack = false;
+    } else {
+      failed_txn_on_stack = true;
+    }
+  }
+  if (failed_txn_on_stack == false) {
+    // the last attempt died at commit; CommitQueryHelper has already popped
+    // and aborted it, so there is nothing left for the caller to clean up
+    p_status_.m_result = ResultType::ABORTED;
+    return true;
   }
+  return false;
 }
 
 /*
@@ -284,43 +791,108 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
       return statement;
     }
   } else {
-    // Begin new transaction when received single-statement query or "BEGIN"
-    // from multi-statement query
     if (statement->GetQueryType() ==
         QueryType::QUERY_BEGIN) {  // only begin a new transaction
-      // note this transaction is not single-statement transaction
+      // note this transaction is not single-statement transaction; an
+      // explicit BEGIN must establish the block's snapshot right away
       LOG_TRACE("BEGIN");
       single_statement_txn_ = false;
+      auto txn = txn_manager.BeginTransaction(thread_id);
+      // this shouldn't happen
+      if (txn == nullptr) {
+        LOG_TRACE("Begin txn failed");
+      }
+      // initialize the current result as success
+      tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
     } else {
-      // single statement
+      // single statement: only record that an implicit transaction will
+      // be needed. The MVCC begin (taking a timestamp and entering the
+      // epoch) is deferred to the first data access, so trivial
+      // statements and cache hits never consume timestamp bandwidth.
       LOG_TRACE("SINGLE TXN");
       single_statement_txn_ = true;
+      // A single-statement SELECT can never write, so when the deferred
+      // transaction materializes it is declared read-only: reads skip the
+      // read-set bookkeeping and commit skips validation, using only the
+      // snapshot epoch
+      deferred_txn_read_only_ = IsReadOnlyStatement(statement);
+      deferred_txn_thread_id_ = thread_id;
     }
-    auto txn = txn_manager.BeginTransaction(thread_id);
-    // this shouldn't happen
-    if (txn == nullptr) {
-      LOG_TRACE("Begin txn failed");
-    }
-    // initialize the current result as success
-    tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
   }
 
   if (settings::SettingsManager::GetBool(settings::SettingId::brain)) {
-    tcop_txn_state_.top().first->AddQueryString(query_string.c_str());
+    GetOrBeginTransaction(thread_id)->AddQueryString(query_string.c_str());
   }
 
   // TODO(Tianyi) Move Statement Planing into Statement's method
   // to increase coherence
   try {
-    auto plan = optimizer_->BuildPelotonPlanTree(
-        statement->GetStmtParseTreeList(), default_database_name_,
-        tcop_txn_state_.top().first);
-    statement->SetPlanTree(plan);
-    // Get the tables that our plan references so that we know how to
-    // invalidate it at a later point when the catalog changes
-    const std::set<oid_t> table_oids =
-        planner::PlanUtil::GetTablesReferenced(plan.get());
-    statement->SetReferencedTables(table_oids);
+    bool plan_is_set = false;
+
+    // Read the catalog epoch before binding: if a DDL slips in while we
+    // plan, the stamped epoch is already stale and the first execution
+    // replans, so the stamp can never vouch for a plan bound against a
+    // schema that changed under it.
+    const uint64_t bind_epoch =
+        catalog::CatalogNameCache::GetInstance().GetEpoch();
+
+    // Try the plan cache first: our workloads re-issue the same statement
+    // shapes with different literal constants, and each one pays for a
+    // full optimizer pass otherwise.
+    if (settings::SettingsManager::GetBool(settings::SettingId::plan_cache) &&
+        query_type == QueryType::QUERY_SELECT &&
+        statement->GetStmtParseTreeList()->GetNumStatements() == 1) {
+      auto *select_stmt = static_cast<parser::SelectStatement *>(
+          statement->GetStmtParseTreeList()->GetStatement(0));
+
+      std::string fingerprint;
+      std::vector<type::Value> cache_params;
+      if (ComputeSelectPlanCacheKey(query_string, default_database_name_,
+                                    select_stmt, fingerprint, cache_params)) {
+        auto cached_statement =
+            plan_cache_.GetStatementByFingerprint(fingerprint);
+        if (cached_statement != nullptr &&
+            cached_statement->GetNeedsReplan() == false &&
+            cached_statement->GetCachedPlanParams().size() ==
+                cache_params.size()) {
+          // reuse the optimized plan; the extracted constants are bound as
+          // parameter values at execution
+          statement->SetPlanTree(cached_statement->GetPlanTree());
+          statement->SetReferencedTables(
+              cached_statement->GetReferencedTables());
+          statement->SetCachedPlanParams(std::move(cache_params));
+          statement->SetBoundCatalogEpoch(
+              cached_statement->GetBoundCatalogEpoch());
+          plan_is_set = true;
+        } else {
+          // optimize the parameterized tree once and remember it under the
+          // fingerprint
+          auto plan = optimizer_->BuildPelotonPlanTree(
+              statement->GetStmtParseTreeList(), default_database_name_,
+              GetOrBeginTransaction(thread_id));
+          statement->SetPlanTree(plan);
+          statement->SetReferencedTables(
+              planner::PlanUtil::GetTablesReferenced(plan.get()));
+          statement->SetCachedPlanParams(std::move(cache_params));
+          statement->SetBoundCatalogEpoch(bind_epoch);
+          plan_cache_.AddFingerprintedStatement(fingerprint, statement);
+          plan_is_set = true;
+        }
+      }
+    }
+
+    if (plan_is_set == false) {
+      auto plan = optimizer_->BuildPelotonPlanTree(
+          statement->GetStmtParseTreeList(), default_database_name_,
+          GetOrBeginTransaction(thread_id));
+      statement->SetPlanTree(plan);
+      // Get the tables that our plan references so that we know how to
+      // invalidate it at a later point when the catalog changes
+      const std::set<oid_t> table_oids =
+          planner::PlanUtil::GetTablesReferenced(plan.get());
+      statement->SetReferencedTables(table_oids);
+      statement->SetBoundCatalogEpoch(bind_epoch);
+    }
 
     if (query_type == QueryType::QUERY_SELECT) {
       auto tuple_descriptor = GenerateTupleDescriptor(
@@ -367,18 +939,14 @@ bool TrafficCop::BindParamsForCachePlan(
     const size_t thread_id UNUSED_ATTRIBUTE) {
   if (tcop_txn_state_.empty()) {
     single_statement_txn_ = true;
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    auto txn = txn_manager.BeginTransaction(thread_id);
-    // this shouldn't happen
-    if (txn == nullptr) {
-      LOG_ERROR("Begin txn failed");
-    }
-    // initialize the current result as success
-    tcop_txn_state_.emplace(txn, ResultType::SUCCESS);
+    // the prepared statement may write, so the implicit transaction that
+    // materializes for the bind must be a regular one
+    deferred_txn_read_only_ = false;
+    deferred_txn_thread_id_ = thread_id;
   }
   // Run binder
   auto bind_node_visitor = std::make_shared<binder::BindNodeVisitor>(
-      tcop_txn_state_.top().first, default_database_name_);
+      GetOrBeginTransaction(thread_id), default_database_name_);
 
   std::vector<type::Value> param_values;
   for (const std::unique_ptr<expression::AbstractExpression> &param :
@@ -417,7 +985,7 @@ void TrafficCop::GetTableColumns(parser::TableRef *from_table,
           static_cast<storage::DataTable *>(
               catalog::Catalog::GetInstance()->GetTableWithName(
                   from_table->GetDatabaseName(), from_table->GetTableName(),
-                  GetCurrentTxnState().first))
+                  GetOrBeginTransaction(deferred_txn_thread_id_)))
               ->GetSchema()
               ->GetColumns();
       target_columns.insert(target_columns.end(), columns.begin(),
@@ -575,20 +1143,85 @@ ResultType TrafficCop::ExecuteStatement(
         return AbortQueryHelper();
       }
       default:
+        // In the extended protocol other statements may have run between
+        // this statement's prepare and its execute, so re-derive what the
+        // deferred transaction should look like before anything can
+        // materialize it
+        if (tcop_txn_state_.empty()) {
+          deferred_txn_read_only_ = IsReadOnlyStatement(statement);
+          deferred_txn_thread_id_ = thread_id;
+        }
+
         // The statement may be out of date
         // It needs to be replan
         if (statement->GetNeedsReplan()) {
-          // TODO(Tianyi) Move Statement Replan into Statement's method
-          // to increase coherence
-          auto plan = optimizer_->BuildPelotonPlanTree(
-              statement->GetStmtParseTreeList(), default_database_name_,
-              tcop_txn_state_.top().first);
-          statement->SetPlanTree(plan);
-          statement->SetNeedsReplan(true);
+          // The invalidation flag is only a hint; the catalog epoch is what
+          // actually proves staleness. If no DDL has run since the plan was
+          // bound, this single compare replaces the full binder/optimizer
+          // pass the replan would otherwise repeat on every execution.
+          const uint64_t current_epoch =
+              catalog::CatalogNameCache::GetInstance().GetEpoch();
+          if (statement->GetBoundCatalogEpoch() == current_epoch) {
+            statement->SetNeedsReplan(false);
+          } else {
+            // TODO(Tianyi) Move Statement Replan into Statement's method
+            // to increase coherence
+            auto plan = optimizer_->BuildPelotonPlanTree(
+                statement->GetStmtParseTreeList(), default_database_name_,
+                GetOrBeginTransaction(thread_id));
+            statement->SetPlanTree(plan);
+            statement->SetBoundCatalogEpoch(current_epoch);
+            statement->SetNeedsReplan(false);
+          }
+        }
+
+        // a plan that came out of the plan cache carries the constants
+        // stripped from the query; bind them as this execution's parameters
+        const std::vector<type::Value> &exec_params =
+            (params.empty() &&
+             statement->GetCachedPlanParams().empty() == false)
+                ? statement->GetCachedPlanParams()
+                : params;
+
+        // Try the result cache: identical read-only statements issued by
+        // many clients can be answered from the previous execution's rows
+        // without touching the executor.
+        if (tcop_txn_state_.empty() && IsResultCacheableStatement(statement)) {
+          // the same query text can name different relations in different
+          // databases, so the session's database is part of the identity
+          result_cache_key_ = default_database_name_;
+          result_cache_key_.push_back('\x1f');
+          result_cache_key_.append(statement->GetQueryString());
+          for (const auto &value : exec_params) {
+            result_cache_key_.push_back('\x1f');
+            result_cache_key_.append(value.ToString());
+          }
+          // the rows are cached as formatted, so the format is part of
+          // the identity
+          for (int format : result_format) {
+            result_cache_key_.push_back(format == 0 ? 't' : 'b');
+          }
+          int cached_rows_affected = 0;
+          if (ResultCache::GetInstance().Get(result_cache_key_, result,
+                                             cached_rows_affected)) {
+            setRowsAffected(cached_rows_affected);
+            p_status_.m_result = ResultType::SUCCESS;
+            p_status_.m_processed = cached_rows_affected;
+            is_queuing_ = false;
+            return ResultType::SUCCESS;
+          }
+          // snapshot the epochs before the transaction begins so a write
+          // committing while this statement runs is guaranteed to stale
+          // the fill
+          result_cache_epochs_ = ResultCache::GetInstance().SnapshotTableEpochs(
+              statement->GetReferencedTables());
+          result_cache_fill_ = true;
+        } else {
+          result_cache_fill_ = false;
         }
 
-        ExecuteHelper(statement->GetPlanTree(), params, result, result_format,
-                      thread_id);
+        ExecuteHelper(statement->GetPlanTree(), exec_params, result,
+                      result_format, thread_id, statement);
         if (GetQueuing()) {
           return ResultType::QUEUING;
         } else {
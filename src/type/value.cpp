@@ -34,7 +34,10 @@ Value::Value(const Value &other) {
       if (size_.len == PELOTON_VALUE_NULL) {
         value_.varlen = nullptr;
       } else {
-        if (manage_data_) {
+        if (HasInlinedVarlen()) {
+          // the payload lives in the union itself; no allocation needed
+          value_ = other.value_;
+        } else if (manage_data_) {
           value_.varlen = new char[size_.len];
           PL_MEMCPY(value_.varlen, other.value_.varlen, size_.len);
         } else {
@@ -301,10 +304,14 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data)
         manage_data_ = manage_data;
         if (manage_data_) {
           PL_ASSERT(len < PELOTON_VARCHAR_MAX_LEN);
-          value_.varlen = new char[len];
-          PL_ASSERT(value_.varlen != nullptr);
           size_.len = len;
-          PL_MEMCPY(value_.varlen, data, len);
+          if (len <= kInlinedVarlenMax) {
+            PL_MEMCPY(value_.inlined, data, len);
+          } else {
+            value_.varlen = new char[len];
+            PL_ASSERT(value_.varlen != nullptr);
+            PL_MEMCPY(value_.varlen, data, len);
+          }
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen = data;
@@ -328,10 +335,14 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
       manage_data_ = true;
       // TODO: How to represent a null string here?
       uint32_t len = data.length() + (type == TypeId::VARCHAR);
-      value_.varlen = new char[len];
-      PL_ASSERT(value_.varlen != nullptr);
       size_.len = len;
-      PL_MEMCPY(value_.varlen, data.c_str(), len);
+      if (len <= kInlinedVarlenMax) {
+        PL_MEMCPY(value_.inlined, data.c_str(), len);
+      } else {
+        value_.varlen = new char[len];
+        PL_ASSERT(value_.varlen != nullptr);
+        PL_MEMCPY(value_.varlen, data.c_str(), len);
+      }
       break;
     }
     default: {
@@ -349,7 +360,7 @@ Value::~Value() {
   switch (type_id_) {
     case TypeId::VARBINARY:
     case TypeId::VARCHAR:
-      if (manage_data_) {
+      if (manage_data_ && HasInlinedVarlen() == false) {
         delete[] value_.varlen;
       }
       break;
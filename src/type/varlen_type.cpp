@@ -43,6 +43,9 @@ VarlenType::~VarlenType() {}
 
 // Access the raw variable length data
 const char *VarlenType::GetData(const Value &val) const {
+  if (val.HasInlinedVarlen()) {
+    return val.value_.inlined;
+  }
   return val.value_.varlen;
 }
 
@@ -170,9 +173,17 @@ void VarlenType::SerializeTo(const Value &val, SerializeOutput &out) const {
 }
 
 void VarlenType::SerializeTo(const Value &val, char *storage,
-                             bool inlined UNUSED_ATTRIBUTE,
-                             AbstractPool *pool) const {
+                             bool inlined, AbstractPool *pool) const {
   uint32_t len = GetLength(val);
+  if (inlined) {
+    // Inlined storage is the length prefix followed by the bytes, written
+    // directly into the tuple; NULL is the length sentinel alone
+    PL_MEMCPY(storage, &len, sizeof(uint32_t));
+    if (len > 0 && len < PELOTON_VALUE_NULL) {
+      PL_MEMCPY(storage + sizeof(uint32_t), GetData(val), len);
+    }
+    return;
+  }
   char *data;
   if (len == PELOTON_VALUE_NULL) {
     data = nullptr;
@@ -180,16 +191,21 @@ void VarlenType::SerializeTo(const Value &val, char *storage,
     uint32_t size = len + sizeof(uint32_t);
     data = (pool == nullptr) ? new char[size] : (char *)pool->Allocate(size);
     PL_MEMCPY(data, &len, sizeof(uint32_t));
-    PL_MEMCPY(data + sizeof(uint32_t), val.value_.varlen,
-              size - sizeof(uint32_t));
+    PL_MEMCPY(data + sizeof(uint32_t), GetData(val), size - sizeof(uint32_t));
   }
   *reinterpret_cast<const char **>(storage) = data;
 }
 
 // Deserialize a value of the given type from the given storage space.
-Value VarlenType::DeserializeFrom(const char *storage,
-                                  const bool inlined UNUSED_ATTRIBUTE,
+Value VarlenType::DeserializeFrom(const char *storage, const bool inlined,
                                   AbstractPool *pool UNUSED_ATTRIBUTE) const {
+  if (inlined) {
+    uint32_t len = *reinterpret_cast<const uint32_t *>(storage);
+    if (len == PELOTON_VALUE_NULL) {
+      return Value(type_id_, nullptr, 0, false);
+    }
+    return Value(type_id_, storage + sizeof(uint32_t), len, false);
+  }
   const char *ptr = *reinterpret_cast<const char *const *>(storage);
   if (ptr == nullptr) {
     return Value(type_id_, nullptr, 0, false);
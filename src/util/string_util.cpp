@@ -103,6 +103,47 @@ std::string StringUtil::FormatSize(long bytes) {
   return (os.str());
 }
 
+namespace {
+
+// Two-digit lookup table for the integer-to-string kernel
+const char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+}  // anonymous namespace
+
+uint32_t StringUtil::FastIntToString(int64_t value, char *out) {
+  char tmp[20];
+  char *pos = tmp + sizeof(tmp);
+  bool negative = value < 0;
+  uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value)
+                                : static_cast<uint64_t>(value);
+  while (magnitude >= 100) {
+    uint64_t rem = magnitude % 100;
+    magnitude /= 100;
+    pos -= 2;
+    memcpy(pos, kDigitPairs + rem * 2, 2);
+  }
+  if (magnitude >= 10) {
+    pos -= 2;
+    memcpy(pos, kDigitPairs + magnitude * 2, 2);
+  } else {
+    *--pos = static_cast<char>('0' + magnitude);
+  }
+  if (negative) *--pos = '-';
+  uint32_t len = static_cast<uint32_t>(tmp + sizeof(tmp) - pos);
+  memcpy(out, pos, len);
+  return len;
+}
+
 std::string StringUtil::Bold(const std::string &str) {
   std::string SET_PLAIN_TEXT = "\033[0;0m";
   std::string SET_BOLD_TEXT = "\033[0;1m";
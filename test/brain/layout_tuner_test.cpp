@@ -113,6 +113,9 @@ TEST_F(LayoutTunerTests, BasicTest) {
   // Ensure that the layout has been changed
   EXPECT_NE(new_default_layout, old_default_layout);
 
+  // The adoption must have survived hysteresis and been counted
+  EXPECT_GT(layout_tuner.GetLayoutUpdateCount(), 0);
+
   // Check the new default table layout
   column_count = new_default_layout.size();
   EXPECT_EQ(column_count, 4);
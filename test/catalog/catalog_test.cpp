@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "catalog/catalog.h"
+#include "catalog/catalog_name_cache.h"
 #include "catalog/database_catalog.h"
 #include "catalog/table_catalog.h"
 #include "catalog/index_catalog.h"
@@ -185,6 +186,60 @@ TEST_F(CatalogTests, TableObject) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CatalogTests, NameCacheEpoch) {
+  auto &name_cache = catalog::CatalogNameCache::GetInstance();
+
+  uint64_t epoch = name_cache.GetEpoch();
+  name_cache.FillTable(epoch, "name_cache_db", "name_cache_table", 1, 2);
+
+  oid_t database_oid = INVALID_OID;
+  oid_t table_oid = INVALID_OID;
+  EXPECT_TRUE(name_cache.ResolveTable("name_cache_db", "name_cache_table",
+                                      database_oid, table_oid));
+  EXPECT_EQ(1, database_oid);
+  EXPECT_EQ(2, table_oid);
+
+  // a DDL epoch bump invalidates every cached resolution
+  name_cache.BumpEpoch();
+  EXPECT_FALSE(name_cache.ResolveTable("name_cache_db", "name_cache_table",
+                                       database_oid, table_oid));
+
+  // a fill whose epoch predates a DDL is dropped, not cached
+  name_cache.FillTable(epoch, "name_cache_db", "name_cache_table", 1, 2);
+  EXPECT_FALSE(name_cache.ResolveTable("name_cache_db", "name_cache_table",
+                                       database_oid, table_oid));
+
+  // refilled under the current epoch, the entry is served again
+  name_cache.FillTable(name_cache.GetEpoch(), "name_cache_db",
+                       "name_cache_table", 3, 4);
+  EXPECT_TRUE(name_cache.ResolveTable("name_cache_db", "name_cache_table",
+                                      database_oid, table_oid));
+  EXPECT_EQ(3, database_oid);
+  EXPECT_EQ(4, table_oid);
+}
+
+TEST_F(CatalogTests, IndexDDLBumpsEpoch) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &name_cache = catalog::CatalogNameCache::GetInstance();
+  auto catalog = catalog::Catalog::GetInstance();
+
+  // creating an index does not change name resolution, but it invalidates
+  // bound plans, so it must advance the epoch used as schema fingerprint
+  auto txn = txn_manager.BeginTransaction();
+  uint64_t epoch = name_cache.GetEpoch();
+  EXPECT_EQ(ResultType::SUCCESS,
+            catalog->CreateIndex("EMP_DB", "department_table", {1},
+                                 "department_table_name_idx", false,
+                                 IndexType::BWTREE, txn));
+  EXPECT_GT(name_cache.GetEpoch(), epoch);
+
+  epoch = name_cache.GetEpoch();
+  EXPECT_EQ(ResultType::SUCCESS,
+            catalog->DropIndex("department_table_name_idx", txn));
+  EXPECT_GT(name_cache.GetEpoch(), epoch);
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(CatalogTests, DroppingTable) {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
@@ -57,6 +57,51 @@ void AddTileGroup(UNUSED_ATTRIBUTE uint64_t thread_id) {
   }
 }
 
+TEST_F(ManagerTests, RawTileGroupAccessTest) {
+
+  // TILES
+  std::vector<std::string> tile_column_names;
+  std::vector<std::vector<std::string>> column_names;
+
+  tile_column_names.push_back("INTEGER COL");
+  column_names.push_back(tile_column_names);
+
+  std::vector<catalog::Schema> schemas;
+  std::vector<catalog::Column> columns;
+
+  // SCHEMA
+  catalog::Column column1(type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+                          "A", true);
+  columns.push_back(column1);
+
+  std::unique_ptr<catalog::Schema> schema1(new catalog::Schema(columns));
+  schemas.push_back(*schema1);
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t tile_group_id = manager.GetNextTileGroupId();
+
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  manager.AddTileGroup(tile_group_id, tile_group);
+
+  // the raw locator mirrors the owning locator
+  EXPECT_EQ(manager.GetTileGroupRaw(tile_group_id), tile_group.get());
+  EXPECT_EQ(manager.GetTileGroup(tile_group_id).get(), tile_group.get());
+
+  // dropping cuts off new raw readers, but the group is retired, not freed
+  manager.DropTileGroup(tile_group_id);
+  EXPECT_EQ(manager.GetTileGroupRaw(tile_group_id), nullptr);
+
+  // reclaiming past the retire epoch releases the parked reference
+  manager.ReclaimRetiredTileGroups(MAX_EID);
+  EXPECT_EQ(tile_group.use_count(), 1);
+}
+
 TEST_F(ManagerTests, TransactionTest) {
   LaunchParallelTest(8, AddTileGroup);
 
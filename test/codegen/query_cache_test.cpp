@@ -524,6 +524,43 @@ TEST_F(QueryCacheTest, CacheNestedLoopJoinPlan) {
   EXPECT_FALSE(found);
 }
 
+TEST_F(QueryCacheTest, CodeSharingAcrossIdenticalQueries) {
+  auto scan1 = GetSeqScanPlan();
+  auto scan2 = GetSeqScanPlan();
+
+  planner::BindingContext context_1, context_2;
+  scan1->PerformBinding(context_1);
+  scan2->PerformBinding(context_2);
+
+  uint64_t shared_before = codegen::QueryCache::Instance().GetSharedCount();
+
+  // Compile the first query and add it to the cache
+  codegen::BufferingConsumer buffer_1{{0}, context_1};
+  bool cached;
+  CompileAndExecuteCache(scan1, buffer_1, cached);
+  EXPECT_FALSE(cached);
+  EXPECT_EQ(NumRowsInTestTable() - 4, buffer_1.GetOutputTuples().size());
+  EXPECT_EQ(shared_before, codegen::QueryCache::Instance().GetSharedCount());
+
+  // A structurally identical plan compiled outside of the plan-level cache
+  // generates byte-identical IR, so it adopts the cached query's machine
+  // code instead of JIT compiling its own, and still computes the same
+  // result
+  codegen::BufferingConsumer buffer_2{{0}, context_2};
+  CompileAndExecute(*scan2, buffer_2);
+  EXPECT_EQ(NumRowsInTestTable() - 4, buffer_2.GetOutputTuples().size());
+  EXPECT_EQ(shared_before + 1,
+            codegen::QueryCache::Instance().GetSharedCount());
+
+  // Only the first query ever went into the cache
+  EXPECT_EQ(1, codegen::QueryCache::Instance().GetCount());
+
+  // PelotonCodeTest dies after each TEST_F()
+  // So, we delete the cache
+  codegen::QueryCache::Instance().Clear();
+  EXPECT_EQ(0, codegen::QueryCache::Instance().GetCount());
+}
+
 TEST_F(QueryCacheTest, PerformanceBenchmark) {
   codegen::QueryCache::Instance().Clear();
   Timer<std::ratio<1, 1000>> timer1, timer2;
@@ -55,6 +55,53 @@ TEST_F(CuckooMapTests, BasicTest) {
   }
 }
 
+// Test presized construction, bulk find and snapshot
+TEST_F(CuckooMapTests, BulkAndSnapshotTest) {
+  typedef uint32_t key_type;
+  typedef uint32_t value_type;
+
+  {
+    size_t const element_count = 100;
+    CuckooMap<key_type, value_type> map(element_count);
+
+    EXPECT_TRUE(map.IsEmpty());
+
+    for (size_t element = 0; element < element_count; ++element) {
+      value_type val(element);
+      auto status = map.Insert(element, val);
+      EXPECT_TRUE(status);
+    }
+
+    // bulk find: one hit per key, plus one miss
+    std::vector<key_type> keys;
+    for (size_t element = 0; element < element_count; ++element) {
+      keys.push_back(element);
+    }
+    keys.push_back(element_count);
+
+    std::vector<value_type> values;
+    auto found_count = map.FindBulk(keys, values);
+    EXPECT_EQ(found_count, element_count);
+    EXPECT_EQ(values.size(), keys.size());
+    for (size_t element = 0; element < element_count; ++element) {
+      EXPECT_EQ(values[element], element);
+    }
+
+    // snapshot: full contents, map unlocked afterwards
+    std::vector<std::pair<key_type, value_type>> snapshot;
+    map.GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.size(), element_count);
+    for (auto &entry : snapshot) {
+      EXPECT_EQ(entry.first, entry.second);
+    }
+    EXPECT_TRUE(map.Contains(1));
+
+    auto reserve_status = map.Reserve(element_count * 10);
+    EXPECT_TRUE(reserve_status);
+    EXPECT_EQ(map.GetSize(), element_count);
+  }
+}
+
 // Test shared pointers
 TEST_F(CuckooMapTests, SharedPointerTest) {
   typedef oid_t key_type;
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// distributed_readwrite_latch_test.cpp
+//
+// Identification: test/common/distributed_readwrite_latch_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/synchronization/distributed_readwrite_latch.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Distributed Read-Write Latch Test
+//===--------------------------------------------------------------------===//
+
+class DistributedReadWriteLatchTests : public PelotonTest {};
+
+TEST_F(DistributedReadWriteLatchTests, BasicTest) {
+  common::synchronization::DistributedReadWriteLatch latch;
+
+  // readers nest on the same thread
+  latch.ReadLock();
+  latch.ReadLock();
+  latch.ReadUnlock();
+  latch.ReadUnlock();
+
+  latch.WriteLock();
+  latch.WriteUnlock();
+
+  // a writer releases back to readers
+  latch.ReadLock();
+  latch.ReadUnlock();
+}
+
+// Concurrent writers and readers; writers must never lose an update and
+// readers must never observe a torn pair
+TEST_F(DistributedReadWriteLatchTests, ReadersAndWritersTest) {
+  common::synchronization::DistributedReadWriteLatch latch;
+  size_t counter_a = 0;
+  size_t counter_b = 0;
+
+  size_t const num_threads = 4;
+  size_t const iteration_count = 10000;
+
+  LaunchParallelTest(num_threads, [&latch, &counter_a,
+                                   &counter_b](uint64_t thread_id) {
+    for (size_t itr = 0; itr < iteration_count; ++itr) {
+      if (thread_id == 0) {
+        // sole writer keeps the two counters in lock step
+        latch.WriteLock();
+        counter_a++;
+        counter_b++;
+        latch.WriteUnlock();
+      } else {
+        latch.ReadLock();
+        EXPECT_EQ(counter_a, counter_b);
+        latch.ReadUnlock();
+      }
+    }
+  });
+
+  EXPECT_EQ(counter_a, iteration_count);
+  EXPECT_EQ(counter_b, iteration_count);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// epoch_retire_list_test.cpp
+//
+// Identification: test/common/epoch_retire_list_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/synchronization/epoch_retire_list.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Epoch Retire List Test
+//===--------------------------------------------------------------------===//
+
+class EpochRetireListTests : public PelotonTest {};
+
+// Retired objects must survive until their retire epoch expires and be
+// destroyed exactly once afterwards
+TEST_F(EpochRetireListTests, BasicTest) {
+  common::synchronization::EpochRetireList<std::shared_ptr<oid_t>> retire_list;
+
+  EXPECT_TRUE(retire_list.IsEmpty());
+
+  std::shared_ptr<oid_t> object = std::make_shared<oid_t>(42);
+  std::weak_ptr<oid_t> observer = object;
+
+  retire_list.Retire(std::move(object), 10);
+  EXPECT_FALSE(retire_list.IsEmpty());
+
+  // an epoch below the retire epoch reclaims nothing
+  auto reclaimed = retire_list.Reclaim(9);
+  EXPECT_EQ(reclaimed, 0);
+  EXPECT_FALSE(observer.expired());
+
+  // the retire epoch itself is sufficient
+  reclaimed = retire_list.Reclaim(10);
+  EXPECT_EQ(reclaimed, 1);
+  EXPECT_TRUE(observer.expired());
+  EXPECT_TRUE(retire_list.IsEmpty());
+}
+
+// Concurrent retirers followed by a full sweep must account for every object
+TEST_F(EpochRetireListTests, ConcurrentRetireTest) {
+  common::synchronization::EpochRetireList<std::shared_ptr<oid_t>> retire_list;
+
+  size_t const num_threads = 4;
+  size_t const element_count = 100;
+
+  LaunchParallelTest(num_threads, [&retire_list](uint64_t thread_id) {
+    for (size_t element = 0; element < element_count; ++element) {
+      retire_list.Retire(std::make_shared<oid_t>(element),
+                         static_cast<eid_t>(thread_id));
+    }
+  });
+
+  auto reclaimed = retire_list.ReclaimAll();
+  EXPECT_EQ(reclaimed, num_threads * element_count);
+  EXPECT_TRUE(retire_list.IsEmpty());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -1146,5 +1146,39 @@ TEST_F(InternalTypesTests, PostgresValueTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(InternalTypesTests, TileGroupRWSetTest) {
+  TileGroupRWSet rw_set;
+  EXPECT_TRUE(rw_set.empty());
+  EXPECT_EQ(rw_set.find(0), rw_set.end());
+
+  // Touch enough tuples to push the set through its sparse phase into the
+  // direct-mapped one; lookups and retyping must behave the same on both
+  // sides of the switch
+  const oid_t num_tuples = 1000;
+  for (oid_t tuple_id = 0; tuple_id < num_tuples; tuple_id++) {
+    rw_set[tuple_id] = (tuple_id % 2 == 0) ? RWType::READ : RWType::UPDATE;
+  }
+  EXPECT_EQ(num_tuples, rw_set.size());
+
+  for (oid_t tuple_id = 0; tuple_id < num_tuples; tuple_id++) {
+    auto itr = rw_set.find(tuple_id);
+    EXPECT_NE(itr, rw_set.end());
+    EXPECT_EQ(tuple_id, itr->first);
+    EXPECT_EQ((tuple_id % 2 == 0) ? RWType::READ : RWType::UPDATE,
+              itr->second);
+  }
+  EXPECT_EQ(rw_set.find(num_tuples), rw_set.end());
+
+  // Retype through at(), the way RecordReadOwn upgrades a READ
+  rw_set.at(0) = RWType::READ_OWN;
+  EXPECT_EQ(RWType::READ_OWN, rw_set.at(0));
+
+  // Entries come back in recording order
+  oid_t expected_id = 0;
+  for (const auto &tuple_entry : rw_set) {
+    EXPECT_EQ(expected_id++, tuple_entry.first);
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
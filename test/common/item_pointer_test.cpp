@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// item_pointer_test.cpp
+//
+// Identification: test/common/item_pointer_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/item_pointer.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ItemPointer Test
+//===--------------------------------------------------------------------===//
+
+class ItemPointerTests : public PelotonTest {};
+
+TEST_F(ItemPointerTests, PackedRepresentationTest) {
+  // the packed form actually shrinks the footprint
+  EXPECT_EQ(sizeof(PackedItemPointer), 6u);
+  EXPECT_EQ(sizeof(ItemPointer), 8u);
+
+  // round trip through pack and unpack
+  ItemPointer location(1234, 567);
+  PackedItemPointer packed(location);
+  EXPECT_EQ(packed.GetBlock(), 1234u);
+  EXPECT_EQ(packed.GetOffset(), 567u);
+  EXPECT_FALSE(packed.IsNull());
+  ItemPointer widened = packed.ToItemPointer();
+  EXPECT_EQ(widened.block, location.block);
+  EXPECT_EQ(widened.offset, location.offset);
+
+  // the field-width limits round trip too
+  PackedItemPointer extreme(PackedItemPointer::kMaxBlock,
+                            PackedItemPointer::kMaxOffset);
+  EXPECT_EQ(extreme.GetBlock(), PackedItemPointer::kMaxBlock);
+  EXPECT_EQ(extreme.GetOffset(), PackedItemPointer::kMaxOffset);
+  EXPECT_FALSE(extreme.IsNull());
+}
+
+TEST_F(ItemPointerTests, PackedNullAndOrderingTest) {
+  // default construction and INVALID_OID both give the null location
+  PackedItemPointer null_pointer;
+  EXPECT_TRUE(null_pointer.IsNull());
+  EXPECT_EQ(null_pointer.GetBlock(), INVALID_OID);
+  EXPECT_EQ(null_pointer.GetOffset(), INVALID_OID);
+  EXPECT_TRUE(null_pointer.ToItemPointer().IsNull());
+
+  PackedItemPointer from_invalid(INVALID_ITEMPOINTER);
+  EXPECT_TRUE(from_invalid.IsNull());
+  EXPECT_TRUE(null_pointer == from_invalid);
+
+  // ordering matches the wide form: block first, then offset
+  PackedItemPointer low(1, 100);
+  PackedItemPointer high(2, 5);
+  EXPECT_TRUE(low < high);
+  EXPECT_TRUE(PackedItemPointer(1, 5) < low);
+  EXPECT_TRUE(low != high);
+}
+
+}  // namespace test
+}  // namespace peloton
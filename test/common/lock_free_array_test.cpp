@@ -44,6 +44,36 @@ TEST_F(LockFreeArrayTests, BasicTest) {
 
 }
 
+// Test that entries survive crossing segment boundaries
+TEST_F(LockFreeArrayTests, SegmentBoundaryTest) {
+
+  typedef uint32_t  value_type;
+
+  {
+    LockFreeArray<value_type> array;
+
+    // Enough elements to span several lazily-allocated segments
+    size_t const element_count = 5000;
+    for (size_t element = 0; element < element_count; ++element ) {
+      auto status = array.Append(element + 1);
+      EXPECT_TRUE(status);
+    }
+
+    EXPECT_EQ(array.GetSize(), element_count);
+    for (size_t element = 0; element < element_count; ++element ) {
+      EXPECT_EQ(array.Find(element), element + 1);
+    }
+
+    // Slots in never-touched segments read back as the default value
+    EXPECT_EQ(array.Find(900000), 0u);
+
+    array.Clear(0);
+    EXPECT_EQ(array.GetSize(), 0u);
+    EXPECT_TRUE(array.IsEmpty());
+  }
+
+}
+
 // Test shared pointers
 TEST_F(LockFreeArrayTests, SharedPointerTest) {
 
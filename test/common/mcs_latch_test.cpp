@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// mcs_latch_test.cpp
+//
+// Identification: test/common/mcs_latch_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/synchronization/mcs_latch.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// MCS Latch Test
+//===--------------------------------------------------------------------===//
+
+class McsLatchTests : public PelotonTest {};
+
+TEST_F(McsLatchTests, BasicTest) {
+  common::synchronization::McsLatch latch;
+
+  EXPECT_FALSE(latch.IsLocked());
+
+  common::synchronization::McsQueueNode node;
+  latch.Lock(node);
+  EXPECT_TRUE(latch.IsLocked());
+
+  // a second acquirer cannot sneak in
+  common::synchronization::McsQueueNode other_node;
+  EXPECT_FALSE(latch.TryLock(other_node));
+
+  latch.Unlock(node);
+  EXPECT_FALSE(latch.IsLocked());
+
+  // uncontended acquisitions count, but neither contend nor spin
+  EXPECT_EQ(latch.GetAcquisitionCount(), 1u);
+  EXPECT_EQ(latch.GetContendedCount(), 0u);
+  EXPECT_EQ(latch.GetSpinCycleCount(), 0u);
+
+  {
+    common::synchronization::ScopedMcsLatch guard(latch);
+    EXPECT_TRUE(latch.IsLocked());
+  }
+  EXPECT_FALSE(latch.IsLocked());
+  EXPECT_EQ(latch.GetAcquisitionCount(), 2u);
+}
+
+// Concurrent incrementers under the latch must never lose an update
+TEST_F(McsLatchTests, MutualExclusionTest) {
+  common::synchronization::McsLatch latch;
+  size_t counter = 0;
+
+  size_t const num_threads = 4;
+  size_t const increment_count = 10000;
+
+  LaunchParallelTest(num_threads,
+                     [&latch, &counter](uint64_t thread_id UNUSED_ATTRIBUTE) {
+    for (size_t itr = 0; itr < increment_count; ++itr) {
+      common::synchronization::ScopedMcsLatch guard(latch);
+      counter++;
+    }
+  });
+
+  EXPECT_EQ(counter, num_threads * increment_count);
+  EXPECT_EQ(latch.GetAcquisitionCount(), num_threads * increment_count);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// scan_resistant_cache_test.cpp
+//
+// Identification: test/common/scan_resistant_cache_test.cpp
+//
+// Copyright (c) 2015-18, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "common/scan_resistant_cache.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Scan Resistant Cache Tests
+//===--------------------------------------------------------------------===//
+
+class ScanResistantCacheTests : public PelotonTest {};
+
+TEST_F(ScanResistantCacheTests, PromotionOnSecondTouchTest) {
+  ScanResistantCache<int, int> cache(100);
+  std::vector<int> evicted;
+
+  bool promoted = false;
+  EXPECT_FALSE(cache.Touch(1, promoted));
+  cache.Insert(1, 10, 10, evicted);
+  EXPECT_TRUE(evicted.empty());
+
+  // first re-reference promotes into the protected segment
+  EXPECT_TRUE(cache.Touch(1, promoted));
+  EXPECT_TRUE(promoted);
+
+  // further references are plain protected-segment hits
+  EXPECT_TRUE(cache.Touch(1, promoted));
+  EXPECT_FALSE(promoted);
+
+  EXPECT_EQ(2u, cache.GetHitCount());
+  EXPECT_EQ(1u, cache.GetMissCount());
+}
+
+TEST_F(ScanResistantCacheTests, ScanResistanceTest) {
+  // Budget of 10 unit-sized entries
+  ScanResistantCache<int, int> cache(10);
+  std::vector<int> evicted;
+  bool promoted = false;
+
+  // Build a protected working set of 3 entries
+  for (int key = 0; key < 3; key++) {
+    cache.Insert(key, key, 1, evicted);
+    EXPECT_TRUE(cache.Touch(key, promoted));
+    EXPECT_TRUE(promoted);
+  }
+
+  // A one-pass scan of 50 never-re-referenced entries churns only the
+  // probationary segment
+  for (int key = 100; key < 150; key++) {
+    EXPECT_FALSE(cache.Touch(key, promoted));
+    cache.Insert(key, key, 1, evicted);
+  }
+  EXPECT_FALSE(evicted.empty());
+
+  // The working set survived the scan
+  for (int key = 0; key < 3; key++) {
+    EXPECT_TRUE(cache.Touch(key, promoted));
+    EXPECT_FALSE(promoted);
+  }
+
+  EXPECT_LE(cache.GetOccupiedBytes(), 10u);
+}
+
+TEST_F(ScanResistantCacheTests, BudgetAndDemotionTest) {
+  ScanResistantCache<int, int> cache(4);
+  std::vector<int> evicted;
+  bool promoted = false;
+
+  // Promote 4 entries: the protected segment is capped below the full
+  // budget, so the oldest promotions get demoted rather than pinned
+  for (int key = 0; key < 4; key++) {
+    cache.Insert(key, key, 1, evicted);
+    cache.Touch(key, promoted);
+  }
+  EXPECT_TRUE(evicted.empty());
+
+  // New insertions now push the demoted entries out, oldest first
+  cache.Insert(10, 10, 1, evicted);
+  cache.Insert(11, 11, 1, evicted);
+  EXPECT_EQ(2u, evicted.size());
+  EXPECT_EQ(0, evicted[0]);
+  EXPECT_EQ(1, evicted[1]);
+  EXPECT_EQ(2u, cache.GetEvictionCount());
+
+  // The most recently promoted entries are still cached
+  EXPECT_TRUE(cache.Touch(2, promoted));
+  EXPECT_TRUE(cache.Touch(3, promoted));
+}
+
+TEST_F(ScanResistantCacheTests, EraseTest) {
+  ScanResistantCache<int, int> cache(10);
+  std::vector<int> evicted;
+  bool promoted = false;
+
+  cache.Insert(1, 10, 4, evicted);
+  cache.Insert(2, 20, 4, evicted);
+  cache.Touch(2, promoted);
+
+  EXPECT_TRUE(cache.Erase(1));
+  EXPECT_TRUE(cache.Erase(2));
+  EXPECT_FALSE(cache.Erase(3));
+  EXPECT_EQ(0u, cache.GetSize());
+  EXPECT_EQ(0u, cache.GetOccupiedBytes());
+}
+
+}  // namespace test
+}  // namespace peloton
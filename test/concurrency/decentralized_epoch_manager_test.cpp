@@ -137,6 +137,60 @@ TEST_F(DecentralizedEpochManagerTests, MultipleThreadsTest) {
 }
 
 
+TEST_F(DecentralizedEpochManagerTests, IdleThreadParkingTest) {
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  epoch_manager.SetCurrentEpochId(1);
+
+  // two connection handler threads.
+  epoch_manager.RegisterThread(0);
+
+  epoch_manager.RegisterThread(1);
+
+  epoch_manager.SetCurrentEpochId(2);
+
+  // run one transaction on thread 0, then let it go idle.
+  cid_t txn_id = epoch_manager.EnterEpoch(0, TimestampType::READ);
+
+  eid_t epoch_id = txn_id >> 32;
+
+  epoch_manager.ExitEpoch(0, epoch_id);
+
+  // both threads are parked: the horizon tracks the global epoch even
+  // though neither thread has reported in for many epochs.
+  epoch_manager.SetCurrentEpochId(10);
+
+  uint64_t tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(9, tail_epoch_id);
+
+  // a new transaction unparks thread 1 and constrains the horizon again.
+  txn_id = epoch_manager.EnterEpoch(1, TimestampType::READ);
+
+  epoch_id = txn_id >> 32;
+
+  EXPECT_EQ(10, epoch_id);
+
+  epoch_manager.SetCurrentEpochId(12);
+
+  tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(9, tail_epoch_id);
+
+  epoch_manager.ExitEpoch(1, epoch_id);
+
+  tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(11, tail_epoch_id);
+
+  epoch_manager.DeregisterThread(0);
+
+  epoch_manager.DeregisterThread(1);
+}
+
+
 }  // namespace test
 }  // namespace peloton
 
@@ -82,13 +82,19 @@ TEST_F(LocalEpochTests, TransactionTest) {
 
   local_epoch.ExitEpoch(15);
 
-  // the last transaction has left.
-  // then max_eid should be 25 - 1.
+  // the last transaction has left, so the local epoch parks itself and no
+  // longer constrains the reclamation horizon; the reducer skips it.
   max_eid = local_epoch.GetExpiredEpochId(25);
-  EXPECT_EQ(max_eid, 24);
+  EXPECT_EQ(max_eid, UINT64_MAX);
 
-  max_eid = local_epoch.GetExpiredEpochId(30);
-  EXPECT_EQ(max_eid, 29);
+  // the next transaction unparks the thread.
+  rt = local_epoch.EnterEpoch(26, TimestampType::READ);
+  EXPECT_TRUE(rt);
+
+  max_eid = local_epoch.GetExpiredEpochId(27);
+  EXPECT_EQ(max_eid, 25);
+
+  local_epoch.ExitEpoch(26);
 }
 
 
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// savepoint_test.cpp
+//
+// Identification: test/concurrency/savepoint_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/testing_transaction_util.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Savepoint Tests
+//===--------------------------------------------------------------------===//
+
+class SavepointTests : public PelotonTest {};
+
+namespace {
+
+// Committed value of the row with the given id, or -1 when invisible
+int ReadCommitted(storage::DataTable *table, int id) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  int value = -1;
+  TestingTransactionUtil::ExecuteRead(txn, table, id, value);
+  txn_manager.CommitTransaction(txn);
+  return value;
+}
+
+}  // namespace
+
+TEST_F(SavepointTests, PartialRollbackTest) {
+  // CreateTable seeds ids 0..9, all with value 0
+  storage::DataTable *table =
+      TestingTransactionUtil::CreateTable(10, "SP_TEST_TABLE");
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+
+  // Work before the mark survives the partial rollback
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 0, 100));
+
+  txn->SetSavepoint("batch");
+
+  // Work after the mark is undone: an update, an insert and a delete
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 1, 200));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, 100, 1));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 2));
+
+  EXPECT_FALSE(txn_manager.RollbackToSavepoint(txn, "no_such_savepoint"));
+  EXPECT_TRUE(txn_manager.RollbackToSavepoint(txn, "batch"));
+
+  // The transaction is still alive and can do more work
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 3, 300));
+
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(100, ReadCommitted(table, 0));  // before the mark: kept
+  EXPECT_EQ(0, ReadCommitted(table, 1));    // rolled back update
+  EXPECT_EQ(0, ReadCommitted(table, 2));    // rolled back delete
+  EXPECT_EQ(300, ReadCommitted(table, 3));  // after the rollback: kept
+  EXPECT_EQ(-1, ReadCommitted(table, 100));  // rolled back insert
+}
+
+TEST_F(SavepointTests, RetypedEntryRollbackTest) {
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "SP_RETYPE_TABLE", CATALOG_DATABASE_OID, TEST_TABLE_OID + 1, 1235);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // A pre-mark update retyped to DELETE after the mark must come back as
+  // the update, and a pre-mark insert deleted after the mark must come
+  // back as the insert
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 5, 55));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, 200, 20));
+
+  txn->SetSavepoint("mark");
+
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 5));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 200));
+
+  EXPECT_TRUE(txn_manager.RollbackToSavepoint(txn, "mark"));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(55, ReadCommitted(table, 5));
+  EXPECT_EQ(20, ReadCommitted(table, 200));
+}
+
+TEST_F(SavepointTests, AbortAfterPartialRollbackTest) {
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "SP_ABORT_TABLE", CATALOG_DATABASE_OID, TEST_TABLE_OID + 3, 1237);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // An abort after a partial rollback must undo only the work that is
+  // still live: the post-mark entries were already rolled back and must
+  // not be touched a second time
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 8, 88));
+
+  // reads leave no physical trace and need no undo on abort
+  int value = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 1, value));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 2, value));
+
+  txn->SetSavepoint("mark");
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 9, 99));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, 300, 30));
+  EXPECT_TRUE(txn_manager.RollbackToSavepoint(txn, "mark"));
+
+  EXPECT_EQ(ResultType::ABORTED, txn_manager.AbortTransaction(txn));
+
+  EXPECT_EQ(0, ReadCommitted(table, 8));     // aborted pre-mark update
+  EXPECT_EQ(0, ReadCommitted(table, 9));     // already rolled back
+  EXPECT_EQ(-1, ReadCommitted(table, 300));  // already rolled back
+}
+
+TEST_F(SavepointTests, ReleaseSavepointTest) {
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      10, "SP_RELEASE_TABLE", CATALOG_DATABASE_OID, TEST_TABLE_OID + 2, 1236);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Releasing an inner savepoint folds its undo information into the
+  // enclosing one, so rolling back to the outer mark still undoes the
+  // inner work
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 6, 66));
+
+  txn->SetSavepoint("outer");
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 7, 77));
+
+  txn->SetSavepoint("inner");
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 7));
+  EXPECT_TRUE(txn->ReleaseSavepoint("inner"));
+  EXPECT_FALSE(txn->ReleaseSavepoint("inner"));
+
+  EXPECT_TRUE(txn_manager.RollbackToSavepoint(txn, "outer"));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(66, ReadCommitted(table, 6));
+  EXPECT_EQ(0, ReadCommitted(table, 7));
+}
+
+}  // namespace test
+}  // namespace peloton
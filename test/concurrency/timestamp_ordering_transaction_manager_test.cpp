@@ -29,5 +29,58 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+// The batched visibility kernel must agree with per-tuple IsVisible for
+// every slot, including deleted rows and the reader's own uncommitted write
+TEST_F(TimestampOrderingTransactionManagerTests, BatchVisibilityTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  // commit a handful of rows, then delete one and update another so the
+  // tile group holds a mix of live, dead and superseded versions
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 1; id <= 5; id++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, id, id));
+  }
+  txn_manager.CommitTransaction(txn);
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 2));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 3, 33));
+  txn_manager.CommitTransaction(txn);
+
+  // reader with its own in-flight write
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 4, 44));
+
+  for (size_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    if (active_tuple_count == 0) {
+      continue;
+    }
+
+    std::vector<uint64_t> visibility_bitmap(
+        (static_cast<size_t>(active_tuple_count) + 63) / 64);
+    txn_manager.IsVisibleBatch(txn, tile_group_header, 0, active_tuple_count,
+                               visibility_bitmap.data());
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      bool batch_visible =
+          (visibility_bitmap[tuple_id >> 6] >> (tuple_id & 63)) & 1ULL;
+      bool tuple_visible =
+          (txn_manager.IsVisible(txn, tile_group_header, tuple_id) ==
+           VisibilityType::OK);
+      EXPECT_EQ(batch_visible, tuple_visible);
+    }
+  }
+
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -22,13 +22,21 @@
 #include "type/value.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/aggregate_executor.h"
+#include "executor/aggregator.h"
 #include "executor/executor_context.h"
+#include "settings/settings_manager.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/expression_util.h"
+#include "index/index_factory.h"
 #include "planner/abstract_plan.h"
+#include "executor/seq_scan_executor.h"
 #include "planner/aggregate_plan.h"
+#include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/zone_map_manager.h"
 
 #include "executor/mock_executor.h"
 
@@ -466,6 +474,110 @@ TEST_F(AggregateTests, MinMaxTest) {
   EXPECT_TRUE(cmp == CmpBool::TRUE);
 }
 
+TEST_F(AggregateTests, ZoneMapMinMaxTest) {
+  // SELECT MIN(b), MAX(b) from table, answered through the zone map fast
+  // path: the immutable tile groups carry zone maps, so only tile groups
+  // whose bounds can still change the answer plus the mutable tail are
+  // scanned. MIN(b) lives in a zone-mapped tile group and MAX(b) in the
+  // mutable tail, so both passes of the fast path are exercised.
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), 4 * tuple_count, false,
+                                     false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Freeze all but the last tile group and build zone maps over them
+  oid_t num_tile_groups = data_table->GetTileGroupCount();
+  for (oid_t i = 0; i < num_tile_groups - 1; i++) {
+    data_table->GetTileGroup(i)->GetHeader()->SetImmutability();
+  }
+  auto* zone_map_manager = storage::ZoneMapManager::GetInstance();
+  zone_map_manager->CreateZoneMapTableInCatalog();
+  txn = txn_manager.BeginTransaction();
+  zone_map_manager->CreateZoneMapsForTable(data_table.get(), txn);
+  txn_manager.CommitTransaction(txn);
+
+  // (1-5) Setup plan node
+
+  // 1) Set up group-by columns
+  std::vector<oid_t> group_by_columns;
+
+  // 2) Set up project info
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}};
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  // 3) Set up unique aggregates
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  planner::AggregatePlan::AggTerm minB(
+      ExpressionType::AGGREGATE_MIN,
+      expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER, 0,
+                                                    1),
+      false);
+  planner::AggregatePlan::AggTerm maxB(
+      ExpressionType::AGGREGATE_MAX,
+      expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER, 0,
+                                                    1),
+      false);
+  agg_terms.push_back(minB);
+  agg_terms.push_back(maxB);
+
+  // 4) Set up predicate (empty)
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  // 5) Create output table schema
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<oid_t> set = {1, 1};
+  std::vector<catalog::Column> columns;
+  for (auto column_index : set) {
+    columns.push_back(data_table_schema->GetColumn(column_index));
+  }
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  // OK) Create the plan node, with a real seq scan child so that the zone
+  // map fast path can recognize the shape
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::PLAIN);
+  std::unique_ptr<planner::AbstractPlan> seq_scan_node(new planner::SeqScanPlan(
+      data_table.get(), nullptr, std::vector<oid_t>{0, 1, 2, 3}));
+  auto* seq_scan_node_ptr =
+      static_cast<planner::SeqScanPlan*>(seq_scan_node.get());
+  node.AddChild(std::move(seq_scan_node));
+
+  // Create and set up executor
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::AggregateExecutor executor(&node, context.get());
+  executor::SeqScanExecutor child_executor(seq_scan_node_ptr, context.get());
+  executor.AddChild(&child_executor);
+
+  EXPECT_TRUE(executor.Init());
+
+  EXPECT_TRUE(executor.Execute());
+
+  txn_manager.CommitTransaction(txn);
+
+  // Verify result
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_TRUE(result_tile.get() != nullptr);
+  type::Value val = (result_tile->GetValue(0, 0));
+  CmpBool cmp = (val.CompareEquals(type::ValueFactory::GetIntegerValue(1)));
+  EXPECT_TRUE(cmp == CmpBool::TRUE);
+  val = (result_tile->GetValue(0, 1));
+  cmp = (val.CompareEquals(type::ValueFactory::GetIntegerValue(191)));
+  EXPECT_TRUE(cmp == CmpBool::TRUE);
+}
+
 TEST_F(AggregateTests, HashDistinctTest) {
   // SELECT d, a, b, c FROM table GROUP BY a, b, c, d;
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
@@ -863,5 +975,154 @@ TEST_F(AggregateTests, PlainSumCountDistinctTest) {
   EXPECT_TRUE(cmp == CmpBool::TRUE);
 }
 
+TEST_F(AggregateTests, IndexDistinctCountTest) {
+  // SELECT COUNT(DISTINCT b) from table, answered by walking a BWTree
+  // index that leads with b: the leaf walk hands entries back in key
+  // order, so duplicate runs collapse with one comparison per entry
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+
+  // Non-unique ordered index on column 1, added before population so the
+  // inserts maintain it
+  std::vector<oid_t> key_attrs = {1};
+  auto tuple_schema = data_table->GetSchema();
+  catalog::Schema *key_schema =
+      catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  auto *index_metadata = new index::IndexMetadata(
+      "distinct_btree_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, tuple_schema, key_schema, key_attrs,
+      false);
+  std::shared_ptr<index::Index> sec_index(
+      index::IndexFactory::GetIndex(index_metadata));
+  data_table->AddIndex(sec_index);
+
+  // random population gives column 1 duplicated values
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), 4 * tuple_count, false,
+                                     true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // compute the expected count straight off the base table
+  std::set<int32_t> expected_values;
+  oid_t num_tile_groups = data_table->GetTileGroupCount();
+  for (oid_t tile_group_itr = 0; tile_group_itr < num_tile_groups;
+       tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      expected_values.insert(tile_group->GetValue(tuple_id, 1).GetAs<int32_t>());
+    }
+  }
+  EXPECT_GT(expected_values.size(), 0u);
+  EXPECT_LT(expected_values.size(), static_cast<size_t>(4 * tuple_count));
+
+  // (1-5) Setup plan node
+
+  // 1) Set up group-by columns
+  std::vector<oid_t> group_by_columns;
+
+  // 2) Set up project info
+  DirectMapList direct_map_list = {{0, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  // 3) Set up unique aggregates
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  planner::AggregatePlan::AggTerm countDistinctB(
+      ExpressionType::AGGREGATE_COUNT,
+      expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER, 0,
+                                                    1),
+      true);  // Flag distinct
+  agg_terms.push_back(countDistinctB);
+
+  // 4) Set up predicate (empty)
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  // 5) Create output table schema
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<oid_t> set = {1};
+  std::vector<catalog::Column> columns;
+  for (auto column_index : set) {
+    columns.push_back(data_table_schema->GetColumn(column_index));
+  }
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  // OK) Create the plan node, with a real seq scan child so that the
+  // index distinct fast path can recognize the shape
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::PLAIN);
+  std::unique_ptr<planner::AbstractPlan> seq_scan_node(new planner::SeqScanPlan(
+      data_table.get(), nullptr, std::vector<oid_t>{0, 1, 2, 3}));
+  auto* seq_scan_node_ptr =
+      static_cast<planner::SeqScanPlan*>(seq_scan_node.get());
+  node.AddChild(std::move(seq_scan_node));
+
+  // Create and set up executor
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::AggregateExecutor executor(&node, context.get());
+  executor::SeqScanExecutor child_executor(seq_scan_node_ptr, context.get());
+  executor.AddChild(&child_executor);
+
+  EXPECT_TRUE(executor.Init());
+
+  EXPECT_TRUE(executor.Execute());
+
+  txn_manager.CommitTransaction(txn);
+
+  // Verify result
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_TRUE(result_tile.get() != nullptr);
+  type::Value val = (result_tile->GetValue(0, 0));
+  CmpBool cmp = (val.CompareEquals(type::ValueFactory::GetIntegerValue(
+      static_cast<int32_t>(expected_values.size()))));
+  EXPECT_TRUE(cmp == CmpBool::TRUE);
+}
+
+TEST_F(AggregateTests, SpilledDistinctCountTest) {
+  // COUNT(DISTINCT) whose value set exceeds the distinct spill budget: the
+  // buffered set is flushed to disk as hash-partitioned runs and each
+  // partition is re-deduplicated at finalize, so values that recur across
+  // spills must still count exactly once
+  int32_t old_budget = settings::SettingsManager::GetInt(
+      settings::SettingId::agg_distinct_spill_budget_mb);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::agg_distinct_spill_budget_mb, 1);
+
+  const int distinct_count = 12000;
+
+  std::unique_ptr<executor::AbstractAttributeAggregator> aggregator(
+      executor::GetAttributeAggregatorInstance(
+          ExpressionType::AGGREGATE_COUNT));
+  aggregator->SetDistinct(true);
+  aggregator->SetDistinctSpillArena(
+      std::make_shared<executor::DistinctSpillArena>(nullptr));
+
+  // Two passes over the same values: the second pass re-sends every value
+  // after most of the first pass has already been spilled
+  for (int pass = 0; pass < 2; pass++) {
+    for (int value_itr = 0; value_itr < distinct_count; value_itr++) {
+      aggregator->Advance(type::ValueFactory::GetVarcharValue(
+          "distinct_value_" + std::to_string(value_itr)));
+    }
+  }
+
+  type::Value result = aggregator->Finalize();
+  CmpBool cmp = result.CompareEquals(
+      type::ValueFactory::GetBigIntValue(distinct_count));
+  EXPECT_TRUE(cmp == CmpBool::TRUE);
+
+  settings::SettingsManager::SetInt(
+      settings::SettingId::agg_distinct_spill_budget_mb, old_budget);
+}
+
 }  // namespace test
 }  // namespace peloton
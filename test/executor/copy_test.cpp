@@ -153,5 +153,223 @@ TEST_F(CopyTests, Copying) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CopyTests, CopyFrom) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateDatabase("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::Optimizer);
+
+  // Create a table without primary key
+  TestingStatsUtil::CreateTable(false);
+
+  // Write the input file: a plain row, a NULL second column, and an
+  // escaped delimiter inside a string
+  std::string file_name = "./copy_input.csv";
+  FILE *input_file = fopen(file_name.c_str(), "w");
+  EXPECT_TRUE(input_file != nullptr);
+  fputs("1,hello\n2,\\N\n3,hello\\,world\n", input_file);
+  fclose(input_file);
+
+  std::string copy_sql = "COPY emp_db.department_table FROM '" + file_name +
+                         "' DELIMITER ',';";
+  txn = txn_manager.BeginTransaction();
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto copy_stmt = peloton_parser.BuildParseTree(copy_sql);
+  auto copy_plan =
+      optimizer->BuildPelotonPlanTree(copy_stmt, DEFAULT_DB_NAME, txn);
+
+  // Import plans have no child; the copy executor loads the table itself
+  EXPECT_EQ(0UL, copy_plan->GetChildren().size());
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  std::unique_ptr<executor::AbstractExecutor> copy_executor(
+      new executor::CopyExecutor(copy_plan.get(), context.get()));
+
+  auto status = copy_executor->Init();
+  EXPECT_TRUE(status);
+  while (status == true) {
+    status = copy_executor->Execute();
+  }
+  EXPECT_EQ(3, context->num_processed);
+  txn_manager.CommitTransaction(txn);
+
+  // The loaded rows are visible to a subsequent transaction
+  txn = txn_manager.BeginTransaction();
+  auto target_table = catalog->GetTableWithName(
+      "emp_db", "department_table", txn);
+  EXPECT_EQ(3UL, target_table->GetTupleCount());
+  txn_manager.CommitTransaction(txn);
+
+  // Clean up
+  std::remove(file_name.c_str());
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(CopyTests, ArrowExport) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateDatabase("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::Optimizer);
+
+  // Create a table without primary key
+  TestingStatsUtil::CreateTable(false);
+
+  // Load three rows through COPY FROM, including a NULL string
+  std::string input_name = "./copy_arrow_input.csv";
+  FILE *input_file = fopen(input_name.c_str(), "w");
+  EXPECT_TRUE(input_file != nullptr);
+  fputs("1,hello\n2,\\N\n3,hello\\,world\n", input_file);
+  fclose(input_file);
+
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  {
+    std::string copy_sql = "COPY emp_db.department_table FROM '" + input_name +
+                           "' DELIMITER ',';";
+    txn = txn_manager.BeginTransaction();
+    auto copy_stmt = peloton_parser.BuildParseTree(copy_sql);
+    auto copy_plan =
+        optimizer->BuildPelotonPlanTree(copy_stmt, DEFAULT_DB_NAME, txn);
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+    std::unique_ptr<executor::AbstractExecutor> copy_executor(
+        new executor::CopyExecutor(copy_plan.get(), context.get()));
+    auto status = copy_executor->Init();
+    EXPECT_TRUE(status);
+    while (status == true) {
+      status = copy_executor->Execute();
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+
+  // Export the table in Arrow layout; the .arrow suffix selects the
+  // columnar writer
+  std::string output_name = "./copy_output.arrow";
+  {
+    std::string copy_sql = "COPY emp_db.department_table TO '" + output_name +
+                           "' DELIMITER ',';";
+    txn = txn_manager.BeginTransaction();
+    auto copy_stmt = peloton_parser.BuildParseTree(copy_sql);
+    auto copy_plan =
+        optimizer->BuildPelotonPlanTree(copy_stmt, DEFAULT_DB_NAME, txn);
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+    auto copy_executor =
+        new executor::CopyExecutor(copy_plan.get(), context.get());
+    std::unique_ptr<executor::AbstractExecutor> root_executor(copy_executor);
+    std::unique_ptr<executor::AbstractExecutor> seq_scan_executor(
+        new executor::SeqScanExecutor(copy_plan->GetChildren()[0].get(),
+                                      context.get()));
+    copy_executor->AddChild(seq_scan_executor.get());
+    auto status = root_executor->Init();
+    EXPECT_TRUE(status);
+    while (status == true) {
+      status = root_executor->Execute();
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+
+  // Decode the columnar file
+  FILE *output_file = fopen(output_name.c_str(), "r");
+  EXPECT_TRUE(output_file != nullptr);
+  fseek(output_file, 0, SEEK_END);
+  std::vector<char> bytes(ftell(output_file));
+  fseek(output_file, 0, SEEK_SET);
+  EXPECT_EQ(bytes.size(),
+            fread(bytes.data(), sizeof(char), bytes.size(), output_file));
+  fclose(output_file);
+
+  size_t offset = 0;
+  auto read_u32 = [&bytes, &offset]() {
+    uint32_t value;
+    PL_MEMCPY(&value, bytes.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+  };
+  auto read_u64 = [&bytes, &offset]() {
+    uint64_t value;
+    PL_MEMCPY(&value, bytes.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+  };
+  // Every buffer starts on a 64-byte boundary
+  auto align64 = [&offset]() { offset = (offset + 63) & ~(size_t)63; };
+
+  EXPECT_EQ(0, std::memcmp(bytes.data(), "PLARROW1", 8));
+  offset = 8;
+  uint32_t column_count = read_u32();
+  uint64_t row_count = read_u64();
+  EXPECT_EQ(2U, column_count);
+  EXPECT_EQ(3U, row_count);
+
+  // Schema block: int32 column with no NULLs, utf8 column with one
+  std::vector<uint32_t> type_tags;
+  std::vector<uint64_t> null_counts;
+  for (uint32_t column_itr = 0; column_itr < column_count; column_itr++) {
+    uint32_t name_length = read_u32();
+    offset += name_length;
+    type_tags.push_back(read_u32());
+    null_counts.push_back(read_u64());
+  }
+  EXPECT_EQ(3U, type_tags[0]);  // int32
+  EXPECT_EQ(6U, type_tags[1]);  // utf8
+  EXPECT_EQ(0U, null_counts[0]);
+  EXPECT_EQ(1U, null_counts[1]);
+
+  // Column 0: all three rows valid, values 1, 2, 3
+  uint64_t validity_length = read_u64();
+  align64();
+  EXPECT_EQ(1U, validity_length);
+  EXPECT_EQ(0x07, bytes[offset]);
+  offset += validity_length;
+  uint64_t data_length = read_u64();
+  align64();
+  EXPECT_EQ(3 * sizeof(int32_t), data_length);
+  int32_t int_values[3];
+  PL_MEMCPY(int_values, bytes.data() + offset, sizeof(int_values));
+  EXPECT_EQ(1, int_values[0]);
+  EXPECT_EQ(2, int_values[1]);
+  EXPECT_EQ(3, int_values[2]);
+  offset += data_length;
+
+  // Column 1: NULL second row, offsets close the empty slot in place
+  validity_length = read_u64();
+  align64();
+  EXPECT_EQ(1U, validity_length);
+  EXPECT_EQ(0x05, bytes[offset]);
+  offset += validity_length;
+  uint64_t offsets_length = read_u64();
+  align64();
+  EXPECT_EQ(4 * sizeof(int32_t), offsets_length);
+  int32_t string_offsets[4];
+  PL_MEMCPY(string_offsets, bytes.data() + offset, sizeof(string_offsets));
+  EXPECT_EQ(0, string_offsets[0]);
+  EXPECT_EQ(5, string_offsets[1]);
+  EXPECT_EQ(5, string_offsets[2]);
+  EXPECT_EQ(16, string_offsets[3]);
+  offset += offsets_length;
+  data_length = read_u64();
+  align64();
+  EXPECT_EQ(16U, data_length);
+  EXPECT_EQ(0, std::memcmp(bytes.data() + offset, "hellohello,world", 16));
+
+  // Clean up
+  std::remove(input_name.c_str());
+  std::remove(output_name.c_str());
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -371,6 +371,135 @@ TEST_F(HashSetOptTests, IntersectAllTest) {
 
   RunTest(executor, 2 * (tile_size - 2 * (tile_size * 2 / 5)));
 }
+
+// Streaming merge over sorted children. Same setup as IntersectTest, but
+// the plan advertises the sort order, and the executor must stop pulling
+// the left child as soon as the right side is exhausted: the left tile's
+// visible rows run past the right tile's, so the left child's Execute()
+// is expected exactly once.
+TEST_F(HashSetOptTests, StreamingIntersectTest) {
+  planner::SetOpPlan node(SetOpType::INTERSECT, true);
+
+  executor::HashSetOpExecutor executor(&node, nullptr);
+
+  MockExecutor child_executor1;
+  MockExecutor child_executor2;
+
+  executor.AddChild(&child_executor1);
+  executor.AddChild(&child_executor2);
+
+  EXPECT_CALL(child_executor1, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor2, DInit()).WillOnce(Return(true));
+
+  // Early-out: no second Execute() on the left child
+  EXPECT_CALL(child_executor1, DExecute()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor2, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  size_t tile_size = 10;
+
+  std::unique_ptr<storage::DataTable> data_table1(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table1.get(), tile_size * 5, false,
+                                   false, false, txn);
+  std::unique_ptr<storage::DataTable> data_table2(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table2.get(), tile_size * 5, false,
+                                   false, false, txn);
+
+  txn_manager.CommitTransaction(txn);
+
+  // PopulateTable produces rows in increasing order, so each visible-row
+  // stream is sorted. Hiding the first rows on the left and the last rows
+  // on the right leaves rows [4, 9] against rows [0, 5].
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(
+          data_table1->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(
+          data_table2->GetTileGroup(0)));
+
+  for (oid_t id = 0; id < tile_size * 2 / 5; id++) {
+    source_logical_tile1->RemoveVisibility(id);
+    source_logical_tile2->RemoveVisibility(tile_size - 1 - id);
+  }
+
+  EXPECT_CALL(child_executor1, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()));
+
+  EXPECT_CALL(child_executor2, GetOutput())
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  RunTest(executor, tile_size - 2 * (tile_size * 2 / 5));
+}
+
+// Streaming EXCEPT over sorted children; same setup and expected result
+// as ExceptTest.
+TEST_F(HashSetOptTests, StreamingExceptTest) {
+  planner::SetOpPlan node(SetOpType::EXCEPT, true);
+
+  executor::HashSetOpExecutor executor(&node, nullptr);
+
+  MockExecutor child_executor1;
+  MockExecutor child_executor2;
+
+  executor.AddChild(&child_executor1);
+  executor.AddChild(&child_executor2);
+
+  EXPECT_CALL(child_executor1, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor2, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor1, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(child_executor2, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  size_t tile_size = 10;
+
+  std::unique_ptr<storage::DataTable> data_table1(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table1.get(), tile_size * 5, false,
+                                   false, false, txn);
+  std::unique_ptr<storage::DataTable> data_table2(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table2.get(), tile_size * 5, false,
+                                   false, false, txn);
+
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(
+          data_table1->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(
+          data_table2->GetTileGroup(0)));
+
+  for (oid_t id = 0; id < tile_size * 2 / 5; id++) {
+    source_logical_tile1->RemoveVisibility(id);
+    source_logical_tile2->RemoveVisibility(tile_size - 1 - id);
+  }
+
+  EXPECT_CALL(child_executor1, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()));
+
+  EXPECT_CALL(child_executor2, GetOutput())
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  RunTest(executor, tile_size * 2 / 5);
+}
 }
 
 }  // namespace test
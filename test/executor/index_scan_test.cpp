@@ -171,5 +171,85 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Index scan over a disjunction of intervals: every OR'd value list turns
+// into one probe, and overlapping probes are coalesced at plan time.
+TEST_F(IndexScanTests, DisjunctionPredicateTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateAndPopulateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 BETWEEN 0 AND 20
+  //   OR ATTR 0 = 50 OR ATTR 0 BETWEEN 40 AND 60 OR ATTR 0 BETWEEN 60 AND 80
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids;
+  std::vector<ExpressionType> expr_types;
+  std::vector<type::Value> values;
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  key_column_ids.push_back(0);
+  key_column_ids.push_back(0);
+  expr_types.push_back(ExpressionType::COMPARE_GREATERTHANOREQUALTO);
+  expr_types.push_back(ExpressionType::COMPARE_LESSTHANOREQUALTO);
+  values.push_back(type::ValueFactory::GetIntegerValue(0).Copy());
+  values.push_back(type::ValueFactory::GetIntegerValue(20).Copy());
+
+  // The IN element is a degenerate closed interval; the two ranges overlap
+  // it and each other, so all three branches collapse into one probe
+  std::vector<std::vector<type::Value>> or_value_list;
+  or_value_list.push_back({type::ValueFactory::GetIntegerValue(50).Copy(),
+                           type::ValueFactory::GetIntegerValue(50).Copy()});
+  or_value_list.push_back({type::ValueFactory::GetIntegerValue(40).Copy(),
+                           type::ValueFactory::GetIntegerValue(60).Copy()});
+  or_value_list.push_back({type::ValueFactory::GetIntegerValue(60).Copy(),
+                           type::ValueFactory::GetIntegerValue(80).Copy()});
+
+  // Create index scan desc
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys, or_value_list);
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  // Create plan node.
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+
+  // [0, 20] and the coalesced [40, 80] are the only probes left
+  EXPECT_EQ(node.GetIndexPredicate().GetConjunctionList().size(), 2);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Run the executor: matching keys are 0, 10, 20 and 40..80, i.e. four
+  // tuples in each of the first two tile groups
+  executor::IndexScanExecutor executor(&node, context.get());
+  int expected_num_tiles = 2;
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+
+  for (int i = 0; i < expected_num_tiles; i++) {
+    EXPECT_TRUE(executor.Execute());
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+    result_tiles.emplace_back(result_tile.release());
+  }
+
+  EXPECT_FALSE(executor.Execute());
+  EXPECT_EQ(result_tiles.size(), expected_num_tiles);
+  EXPECT_EQ(result_tiles[0].get()->GetTupleCount(), 4);
+  EXPECT_EQ(result_tiles[1].get()->GetTupleCount(), 4);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -32,6 +32,7 @@
 #include "expression/tuple_value_expression.h"
 
 #include "planner/hash_join_plan.h"
+#include "settings/settings_manager.h"
 #include "planner/hash_plan.h"
 #include "planner/index_scan_plan.h"
 #include "planner/merge_join_plan.h"
@@ -145,6 +146,20 @@ TEST_F(JoinTests, JoinTypesTest) {
   }
 }
 
+TEST_F(JoinTests, BuildSideCapSwitchTest) {
+  // With the cap at one row every build side overflows it, so the hash
+  // join switches roles and builds over the left input instead; results
+  // must match the normal path for every join type
+  settings::SettingsManager::SetInt(settings::SettingId::hash_build_row_cap,
+                                    1);
+  for (auto join_type : join_types) {
+    LOG_TRACE("JOIN TYPE :: %s", JoinTypeToString(join_type).c_str());
+    ExecuteJoinTest(PlanNodeType::HASHJOIN, join_type, BASIC_TEST);
+  }
+  settings::SettingsManager::SetInt(settings::SettingId::hash_build_row_cap,
+                                    0);
+}
+
 TEST_F(JoinTests, ComplicatedTest) {
   // Go over all join algorithms
   for (auto join_algorithm : join_algorithms) {
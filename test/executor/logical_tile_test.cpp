@@ -199,5 +199,66 @@ TEST_F(LogicalTileTests, TileMaterializationTest) {
   LOG_TRACE("%s", logical_tile->GetInfo().c_str());
 }
 
+TEST_F(LogicalTileTests, IdentityPositionListTest) {
+  const int tuple_count = 4;
+  std::shared_ptr<storage::TileGroup> tile_group(
+      TestingExecutorUtil::CreateTileGroup(tuple_count));
+
+  std::vector<catalog::Schema> &tile_schemas = tile_group->GetTileSchemas();
+  std::unique_ptr<catalog::Schema> schema(
+      catalog::Schema::AppendSchemaList(tile_schemas));
+
+  const bool allocate = true;
+  storage::Tuple tuple(schema.get(), allocate);
+  auto pool = tile_group->GetTilePool(1);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(tuple_itr), pool);
+    tuple.SetValue(1, type::ValueFactory::GetIntegerValue(tuple_itr), pool);
+    tuple.SetValue(2, type::ValueFactory::GetTinyIntValue(tuple_itr), pool);
+    tuple.SetValue(3, type::ValueFactory::GetVarcharValue("tuple"), pool);
+
+    auto tuple_id = tile_group->InsertTuple(&tuple);
+    ItemPointer *index_entry_ptr = nullptr;
+    txn_manager.PerformInsert(
+        txn, ItemPointer(tile_group->GetTileGroupId(), tuple_id),
+        index_entry_ptr);
+  }
+
+  txn_manager.CommitTransaction(txn);
+
+  // pass-through tile: no explicit position list is constructed
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::GetTile());
+
+  std::vector<oid_t> column_ids = {0, 1, 2, 3};
+  logical_tile->AddColumns(tile_group, column_ids);
+  logical_tile->AddIdentityPositionList(tuple_count);
+
+  EXPECT_TRUE(logical_tile->HasIdentityPositionList());
+  EXPECT_EQ((size_t)tuple_count, logical_tile->GetTupleCount());
+
+  // values resolve through the tuple position directly
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    type::Value value = logical_tile->GetValue(tuple_itr, 0);
+    type::Value expected = type::ValueFactory::GetIntegerValue(tuple_itr);
+    EXPECT_TRUE(value.CompareEquals(expected) == CmpBool::TRUE);
+  }
+
+  // visibility removal still works in pass-through mode
+  logical_tile->RemoveVisibility(1);
+  EXPECT_EQ((size_t)tuple_count - 1, logical_tile->GetTupleCount());
+
+  // consumers that demand the explicit lists trigger lazy materialization
+  auto &position_list = logical_tile->GetPositionList(0);
+  EXPECT_EQ((size_t)tuple_count, position_list.size());
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ((oid_t)tuple_itr, position_list[tuple_itr]);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
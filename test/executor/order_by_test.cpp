@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
@@ -22,6 +24,7 @@
 #include "planner/order_by_plan.h"
 #include "common/internal_types.h"
 #include "type/value.h"
+#include "type/value_factory.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/order_by_executor.h"
@@ -300,6 +303,147 @@ TEST_F(OrderByTests, StringDescIntAscTest) {
 
   RunTest(executor, tile_size * 2, sort_keys, descend_flags);
 }
+
+/**
+ * LIMIT over an integer sort key: the executor runs its bounded top-K
+ * sort and must emit exactly the limit smallest tuples in order.
+ */
+TEST_F(OrderByTests, IntAscLimitTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({1});
+  std::vector<bool> descend_flags({false});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+  node.SetLimit(true);
+  node.SetLimitNumber(5);
+  node.SetLimitOffset(0);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile. Populated without
+  // randomness so that the expected top-5 values are known.
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tile_size * 2, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+
+  ASSERT_EQ(1, result_tiles.size());
+  ASSERT_EQ(5, result_tiles[0]->GetTupleCount());
+  for (oid_t id = 0; id < 5; id++) {
+    type::Value expected = type::ValueFactory::GetIntegerValue(
+        TestingExecutorUtil::PopulatedValue(id, 1));
+    EXPECT_EQ(CmpBool::TRUE,
+              expected.CompareEquals(result_tiles[0]->GetValue(id, 1)));
+  }
+}
+
+/**
+ * LIMIT over a VARCHAR sort key exercises the partial-sort path, since
+ * variable-width keys cannot be normalized.
+ */
+TEST_F(OrderByTests, StringDescLimitTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({3});
+  std::vector<bool> descend_flags({true});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+  node.SetLimit(true);
+  node.SetLimitNumber(5);
+  node.SetLimitOffset(0);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tile_size));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tile_size * 2, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+
+  ASSERT_EQ(1, result_tiles.size());
+  ASSERT_EQ(5, result_tiles[0]->GetTupleCount());
+
+  // Compute the expected top-5 strings straight from the generator
+  std::vector<std::string> expected_strings;
+  for (size_t id = 0; id < tile_size * 2; id++) {
+    expected_strings.push_back(
+        std::to_string(TestingExecutorUtil::PopulatedValue(id, 3)));
+  }
+  std::sort(expected_strings.begin(), expected_strings.end(),
+            std::greater<std::string>());
+  for (oid_t id = 0; id < 5; id++) {
+    type::Value expected =
+        type::ValueFactory::GetVarcharValue(expected_strings[id]);
+    EXPECT_EQ(CmpBool::TRUE,
+              expected.CompareEquals(result_tiles[0]->GetValue(id, 3)));
+  }
+}
 }
 
 }  // namespace test
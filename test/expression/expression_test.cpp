@@ -20,6 +20,9 @@
 #include "expression/expression_util.h"
 #include "expression/function_expression.h"
 #include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/operator_expression.h"
+#include "expression/expression_program.h"
 #include "expression/case_expression.h"
 #include "type/value.h"
 #include "type/value_factory.h"
@@ -387,5 +390,100 @@ TEST_F(ExpressionTests, SimpleCaseWithDefault) {
   EXPECT_EQ(CmpBool::TRUE, expected.CompareEquals(result));
 }
 
+TEST_F(ExpressionTests, ExpressionProgramTest) {
+  // Helper to build "<left constant> <cmp> <right constant>"
+  auto MakeCompare = [](ExpressionType cmp, const type::Value &left,
+                        const type::Value &right) {
+    return new expression::ComparisonExpression(
+        cmp, new expression::ConstantValueExpression(left),
+        new expression::ConstantValueExpression(right));
+  };
+
+  // Integer comparison takes the typed unboxed path
+  std::unique_ptr<expression::AbstractExpression> int_eq(
+      MakeCompare(ExpressionType::COMPARE_EQUAL,
+                  type::ValueFactory::GetIntegerValue(5),
+                  type::ValueFactory::GetBigIntValue(5)));
+  auto program = expression::ExpressionProgram::Compile(int_eq.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsTrue());
+
+  // Mixed integer/decimal comparison promotes onto the decimal lane
+  std::unique_ptr<expression::AbstractExpression> mixed_gt(
+      MakeCompare(ExpressionType::COMPARE_GREATERTHAN,
+                  type::ValueFactory::GetDecimalValue(2.5),
+                  type::ValueFactory::GetIntegerValue(2)));
+  program = expression::ExpressionProgram::Compile(mixed_gt.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsTrue());
+
+  // Non-numeric operands fall back to the boxed comparison
+  std::unique_ptr<expression::AbstractExpression> str_eq(
+      MakeCompare(ExpressionType::COMPARE_EQUAL,
+                  type::ValueFactory::GetVarcharValue("abc"),
+                  type::ValueFactory::GetVarcharValue("abd")));
+  program = expression::ExpressionProgram::Compile(str_eq.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsFalse());
+
+  // Three-valued logic: (NULL = 1) is unknown, so AND with false is
+  // false, OR with true is true, and NOT keeps it unknown
+  auto null_int = type::ValueFactory::GetNullValueByType(type::TypeId::INTEGER);
+  std::unique_ptr<expression::AbstractExpression> null_and(
+      new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_AND,
+          MakeCompare(ExpressionType::COMPARE_EQUAL, null_int,
+                      type::ValueFactory::GetIntegerValue(1)),
+          MakeCompare(ExpressionType::COMPARE_EQUAL,
+                      type::ValueFactory::GetIntegerValue(1),
+                      type::ValueFactory::GetIntegerValue(2))));
+  program = expression::ExpressionProgram::Compile(null_and.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsFalse());
+
+  std::unique_ptr<expression::AbstractExpression> null_or(
+      new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_OR,
+          MakeCompare(ExpressionType::COMPARE_EQUAL, null_int,
+                      type::ValueFactory::GetIntegerValue(1)),
+          MakeCompare(ExpressionType::COMPARE_EQUAL,
+                      type::ValueFactory::GetIntegerValue(1),
+                      type::ValueFactory::GetIntegerValue(1))));
+  program = expression::ExpressionProgram::Compile(null_or.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsTrue());
+
+  std::unique_ptr<expression::AbstractExpression> null_not(
+      new expression::OperatorExpression(
+          ExpressionType::OPERATOR_NOT, type::TypeId::BOOLEAN,
+          MakeCompare(ExpressionType::COMPARE_EQUAL, null_int,
+                      type::ValueFactory::GetIntegerValue(1)),
+          nullptr));
+  program = expression::ExpressionProgram::Compile(null_not.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsNull());
+
+  // IS NULL over an unknown comparison result is true
+  std::unique_ptr<expression::AbstractExpression> is_null(
+      new expression::OperatorExpression(
+          ExpressionType::OPERATOR_IS_NULL, type::TypeId::BOOLEAN,
+          MakeCompare(ExpressionType::COMPARE_EQUAL, null_int,
+                      type::ValueFactory::GetIntegerValue(1)),
+          nullptr));
+  program = expression::ExpressionProgram::Compile(is_null.get());
+  ASSERT_TRUE(program != nullptr);
+  EXPECT_TRUE(program->Evaluate(nullptr, nullptr, nullptr).IsTrue());
+
+  // Unsupported nodes make Compile() decline, leaving the tree walk
+  std::unique_ptr<expression::AbstractExpression> unary_minus(
+      new expression::OperatorExpression(
+          ExpressionType::OPERATOR_UNARY_MINUS, type::TypeId::INTEGER,
+          new expression::ConstantValueExpression(
+              type::ValueFactory::GetIntegerValue(1)),
+          nullptr));
+  EXPECT_TRUE(expression::ExpressionProgram::Compile(unary_minus.get()) ==
+              nullptr);
+}
+
 }  // namespace test
 }  // namespace peloton
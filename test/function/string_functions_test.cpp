@@ -72,6 +72,83 @@ TEST_F(StringFunctionsTests, LikeTest) {
       GetExecutorContext(), s4.c_str(), s4.size(), p4.c_str(), p4.size()));
 }
 
+TEST_F(StringFunctionsTests, LikePatternClassificationTest) {
+  using LikePatternType = function::StringFunctions::LikePatternType;
+  const char *literal;
+  uint32_t literal_length;
+
+  std::string prefix = "abc%";
+  EXPECT_EQ(LikePatternType::Prefix,
+            function::StringFunctions::ClassifyLikePattern(
+                prefix.c_str(), prefix.size(), &literal, &literal_length));
+  EXPECT_EQ("abc", std::string(literal, literal_length));
+
+  std::string suffix = "%son";
+  EXPECT_EQ(LikePatternType::Suffix,
+            function::StringFunctions::ClassifyLikePattern(
+                suffix.c_str(), suffix.size(), &literal, &literal_length));
+  EXPECT_EQ("son", std::string(literal, literal_length));
+
+  std::string contains = "%%bes a%";
+  EXPECT_EQ(LikePatternType::Contains,
+            function::StringFunctions::ClassifyLikePattern(
+                contains.c_str(), contains.size(), &literal, &literal_length));
+  EXPECT_EQ("bes a", std::string(literal, literal_length));
+
+  std::string exact = "abc";
+  EXPECT_EQ(LikePatternType::Exact,
+            function::StringFunctions::ClassifyLikePattern(
+                exact.c_str(), exact.size(), &literal, &literal_length));
+  EXPECT_EQ("abc", std::string(literal, literal_length));
+
+  // '_' and escapes keep the recursive matcher
+  std::string underscore = "a_c%";
+  EXPECT_EQ(LikePatternType::General,
+            function::StringFunctions::ClassifyLikePattern(
+                underscore.c_str(), underscore.size(), &literal,
+                &literal_length));
+
+  std::string escaped = "abc\\%";  // "abc\%": the '%' is literal
+  EXPECT_EQ(LikePatternType::General,
+            function::StringFunctions::ClassifyLikePattern(
+                escaped.c_str(), escaped.size(), &literal, &literal_length));
+
+  std::string middle = "a%c";
+  EXPECT_EQ(LikePatternType::General,
+            function::StringFunctions::ClassifyLikePattern(
+                middle.c_str(), middle.size(), &literal, &literal_length));
+}
+
+TEST_F(StringFunctionsTests, LikeFastPathTest) {
+  auto like = [this](const std::string &t, const std::string &p) {
+    return function::StringFunctions::Like(GetExecutorContext(), t.c_str(),
+                                           t.size(), p.c_str(), p.size());
+  };
+
+  // prefix / suffix / contains probes
+  EXPECT_TRUE(like("forbes avenue", "forbes%"));
+  EXPECT_FALSE(like("forbes avenue", "avenue%"));
+  EXPECT_TRUE(like("forbes avenue", "%avenue"));
+  EXPECT_FALSE(like("forbes avenue", "%forbes"));
+  EXPECT_TRUE(like("forbes avenue", "%bes a%"));
+  EXPECT_FALSE(like("forbes avenue", "%main%"));
+
+  // the fast paths keep the matcher's case folding
+  EXPECT_TRUE(like("Forbes Avenue", "forbes%"));
+  EXPECT_TRUE(like("forbes avenue", "%AVENUE"));
+  EXPECT_TRUE(like("forbes avenue", "FORBES AVENUE"));
+
+  // literal longer than the text never matches
+  EXPECT_FALSE(like("ave", "avenue%"));
+  EXPECT_FALSE(like("ave", "%avenue"));
+  EXPECT_FALSE(like("ave", "%avenue%"));
+
+  // bare '%' runs match everything, including the empty string
+  EXPECT_TRUE(like("anything", "%"));
+  EXPECT_TRUE(like("", "%%"));
+  EXPECT_FALSE(like("nonempty", ""));
+}
+
 TEST_F(StringFunctionsTests, AsciiTest) {
   const char column_char = 'A';
   for (int i = 0; i < 52; i++) {
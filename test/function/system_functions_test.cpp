@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// system_functions_test.cpp
+//
+// Identification: test/function/system_functions_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "executor/query_progress_registry.h"
+#include "function/system_functions.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class SystemFunctionsTests : public PelotonTest {};
+
+TEST_F(SystemFunctionsTests, QueryProgressRegistryTest) {
+  auto &registry = executor::QueryProgressRegistry::GetInstance();
+  size_t baseline = registry.GetLiveQueryCount();
+
+  auto entry = registry.Register("SELECT * FROM big_table");
+  EXPECT_EQ(baseline + 1, registry.GetLiveQueryCount());
+
+  entry->rows_produced_.fetch_add(42);
+  entry->phase_.store("execute");
+  entry->memory_bytes_.store(4096);
+
+  // the snapshot reflects the live counters
+  bool found = false;
+  for (auto &row : registry.GetSnapshot()) {
+    if (row.query_id != entry->query_id_) continue;
+    found = true;
+    EXPECT_EQ("SELECT * FROM big_table", row.query_text);
+    EXPECT_EQ(42, row.rows_produced);
+    EXPECT_EQ(std::string("execute"), row.phase);
+    EXPECT_EQ(4096, row.memory_bytes);
+    EXPECT_GE(row.elapsed_us, 0);
+    EXPECT_FALSE(row.cancel_requested);
+  }
+  EXPECT_TRUE(found);
+
+  registry.Unregister(entry->query_id_);
+  EXPECT_EQ(baseline, registry.GetLiveQueryCount());
+
+  // the entry outlives its registration, but cancelling it is a no-op
+  EXPECT_FALSE(registry.RequestCancel(entry->query_id_));
+  EXPECT_FALSE(entry->cancel_requested_.load());
+}
+
+TEST_F(SystemFunctionsTests, KillQueryTest) {
+  auto &registry = executor::QueryProgressRegistry::GetInstance();
+  auto entry = registry.Register("UPDATE big_table SET x = 0");
+
+  // unknown id: nothing to kill
+  auto result = function::SystemFunctions::KillQuery(
+      {type::ValueFactory::GetBigIntValue(entry->query_id_ + 1000)});
+  EXPECT_FALSE(result.IsTrue());
+  EXPECT_FALSE(entry->cancel_requested_.load());
+
+  // live id: the cancel flag comes on
+  result = function::SystemFunctions::KillQuery(
+      {type::ValueFactory::GetBigIntValue(entry->query_id_)});
+  EXPECT_TRUE(result.IsTrue());
+  EXPECT_TRUE(entry->cancel_requested_.load());
+
+  // NULL propagates
+  result = function::SystemFunctions::KillQuery(
+      {type::ValueFactory::GetNullValueByType(type::TypeId::BIGINT)});
+  EXPECT_TRUE(result.IsNull());
+
+  registry.Unregister(entry->query_id_);
+}
+
+}  // namespace test
+}  // namespace peloton
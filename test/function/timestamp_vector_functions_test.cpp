@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// timestamp_vector_functions_test.cpp
+//
+// Identification: test/function/timestamp_vector_functions_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "function/timestamp_functions.h"
+#include "function/timestamp_vector_functions.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+
+namespace test {
+
+class TimestampVectorFunctionsTests : public PelotonTest {};
+
+namespace {
+
+// A small batch covering month/year/week boundaries plus a NULL slot
+std::vector<uint64_t> BuildTimestampBatch() {
+  std::vector<std::string> dates = {
+      "2016-12-07 13:26:02.123456-05", "2017-01-01 00:00:00.000000-05",
+      "2017-12-31 23:59:59.999999-05", "2016-02-29 10:45:30.000001-05",
+      "2017-07-04 12:00:00.500000-05"};
+  std::vector<uint64_t> timestamps;
+  for (auto &date : dates) {
+    timestamps.push_back(type::ValueFactory::CastAsTimestamp(
+                             type::ValueFactory::GetVarcharValue(date))
+                             .GetAs<uint64_t>());
+  }
+  timestamps.push_back(type::PELOTON_TIMESTAMP_NULL);
+  return timestamps;
+}
+
+const std::vector<DatePartType> kTruncParts = {
+    DatePartType::CENTURY,     DatePartType::DAY,
+    DatePartType::DECADE,      DatePartType::HOUR,
+    DatePartType::MICROSECOND, DatePartType::MILLENNIUM,
+    DatePartType::MILLISECOND, DatePartType::MINUTE,
+    DatePartType::MONTH,       DatePartType::QUARTER,
+    DatePartType::SECOND,      DatePartType::WEEK,
+    DatePartType::YEAR};
+
+}  // namespace
+
+// The batch kernels must agree element-wise with the scalar functions for
+// every date part
+TEST_F(TimestampVectorFunctionsTests, DateTruncBatchTest) {
+  auto timestamps = BuildTimestampBatch();
+  std::vector<uint64_t> results(timestamps.size());
+
+  for (auto part : kTruncParts) {
+    function::TimestampVectorFunctions::DateTruncBatch(
+        part, timestamps.data(), results.data(), timestamps.size());
+
+    std::string part_string = DatePartTypeToString(part);
+    for (size_t i = 0; i < timestamps.size(); i++) {
+      EXPECT_EQ(function::TimestampFunctions::DateTrunc(part_string.c_str(),
+                                                        timestamps[i]),
+                results[i]);
+    }
+  }
+}
+
+TEST_F(TimestampVectorFunctionsTests, DatePartBatchTest) {
+  auto timestamps = BuildTimestampBatch();
+  std::vector<double> results(timestamps.size());
+
+  auto parts = kTruncParts;
+  parts.push_back(DatePartType::DOW);
+  parts.push_back(DatePartType::DOY);
+
+  for (auto part : parts) {
+    function::TimestampVectorFunctions::DatePartBatch(
+        part, timestamps.data(), results.data(), timestamps.size());
+
+    std::string part_string = DatePartTypeToString(part);
+    for (size_t i = 0; i < timestamps.size(); i++) {
+      EXPECT_EQ(function::TimestampFunctions::DatePart(part_string.c_str(),
+                                                       timestamps[i]),
+                results[i]);
+    }
+  }
+}
+
+// Truncating in place is allowed
+TEST_F(TimestampVectorFunctionsTests, DateTruncBatchInPlaceTest) {
+  auto timestamps = BuildTimestampBatch();
+  auto expected = timestamps;
+  for (auto &value : expected) {
+    value = function::TimestampFunctions::DateTrunc("day", value);
+  }
+
+  function::TimestampVectorFunctions::DateTruncBatch(
+      DatePartType::DAY, timestamps.data(), timestamps.data(),
+      timestamps.size());
+  EXPECT_EQ(expected, timestamps);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/gc/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+#include "common/harness.h"
+#include "gc/tile_group_compactor.h"
+#include "gc/transaction_level_gc_manager.h"
+#include "concurrency/epoch_manager.h"
+
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+static ResultType DeleteTuple(storage::DataTable *table, const int key) {
+  srand(15721);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  scheduler.Txn(0).Delete(key);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+
+  return scheduler.schedules[0].txn_result;
+}
+
+static ResultType SelectTuple(storage::DataTable *table, const int key,
+                              std::vector<int> &results) {
+  srand(15721);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  scheduler.Txn(0).Read(key);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+
+  results = scheduler.schedules[0].results;
+
+  return scheduler.schedules[0].txn_result;
+}
+
+// Run one manual unlink+reclaim GC cycle at the given epoch
+static void RunGCCycle(gc::TransactionLevelGCManager &gc_manager,
+                       concurrency::EpochManager &epoch_manager,
+                       const eid_t epoch) {
+  epoch_manager.SetCurrentEpochId(epoch);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  gc_manager.Reclaim(0, expired_eid);
+  gc_manager.Unlink(0, expired_eid);
+}
+
+// Bulk-delete most of one tile group, then let the compactor freeze it,
+// move the survivor out, and finally retire it once the GC has reclaimed
+// every version
+TEST_F(TileGroupCompactorTests, SparseTileGroupCompactionTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto database = TestingExecutorUtil::InitializeDatabase("COMPACTION_DB");
+  oid_t db_id = database->GetOid();
+
+  // 20 tuples across 10-slot tile groups: tile group 0 holds keys 0-9
+  const int num_key = 20;
+  const size_t tuples_per_tilegroup = 10;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "COMPACTION_TABLE", db_id, INVALID_OID, 1234, true,
+      tuples_per_tilegroup));
+
+  auto tile_group = table->GetTileGroup(0);
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  auto tile_group_header = tile_group->GetHeader();
+
+  // Delete 9 of the 10 tuples in tile group 0; after the GC resets the
+  // deleted versions the tile group is 90% dead
+  for (int key = 0; key < 9; key++) {
+    EXPECT_EQ(ResultType::SUCCESS, DeleteTuple(table.get(), key));
+  }
+
+  RunGCCycle(gc_manager, epoch_manager, 2);
+  RunGCCycle(gc_manager, epoch_manager, 3);
+
+  EXPECT_EQ(9u, tile_group_header->GetDeadTupleCount());
+
+  // First pass freezes the sparse tile group and moves the survivor out
+  auto actions = gc::TileGroupCompactor::CompactTable(table.get());
+  EXPECT_GE(actions, 1u);
+  EXPECT_TRUE(tile_group_header->GetImmutability());
+
+  // The surviving tuple is still reachable through its index entry: the
+  // move only redirected the indirection
+  std::vector<int> results;
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 9, results));
+  EXPECT_EQ(1u, results.size());
+  EXPECT_EQ(0, results[0]);
+
+  // Let the GC reclaim the moved-out version, then retire the empty tile
+  // group: a one-slot shell takes its place under the same oid
+  RunGCCycle(gc_manager, epoch_manager, 4);
+  RunGCCycle(gc_manager, epoch_manager, 5);
+
+  actions = gc::TileGroupCompactor::CompactTable(table.get());
+  EXPECT_GE(actions, 1u);
+
+  auto shell = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  EXPECT_NE(nullptr, shell);
+  EXPECT_EQ(1, shell->GetAllocatedTupleCount());
+  EXPECT_EQ(0, shell->GetNextTupleSlot());
+  EXPECT_TRUE(shell->GetHeader()->GetImmutability());
+
+  // Scans and index lookups still see every surviving tuple
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 9, results));
+  EXPECT_EQ(0, results[0]);
+  EXPECT_EQ(ResultType::SUCCESS, SelectTuple(table.get(), 15, results));
+  EXPECT_EQ(0, results[0]);
+
+  // Untouched full tile groups are left alone
+  auto second_tile_group = table->GetTileGroup(1);
+  EXPECT_FALSE(second_tile_group->GetHeader()->GetImmutability());
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase("COMPACTION_DB");
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -17,6 +17,7 @@
 #include "concurrency/epoch_manager.h"
 
 #include "catalog/catalog.h"
+#include "catalog/manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
@@ -374,6 +375,71 @@ TEST_F(TransactionLevelGCManagerTests, ReInsertTest) {
   // EXPECT_FALSE(storage_manager->HasDatabase(db_id));
 }
 
+// drop -> incremental background teardown
+TEST_F(TransactionLevelGCManagerTests, DroppedTableTeardownTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+  gc_manager.Reset();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("DroppedTableDB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  // one tuple per tile group, so the table spans more tile groups than a
+  // single release pass may drop
+  const int num_key = 150;
+  storage::DataTable *table = TestingTransactionUtil::CreateTable(
+      num_key, "TABLE2", db_id, INVALID_OID, 1234, true, 1);
+  oid_t table_id = table->GetOid();
+
+  size_t tile_group_count = table->GetTileGroupCount();
+  EXPECT_GT(tile_group_count, (size_t)DROPPED_TABLE_GROUPS_PER_PASS);
+
+  std::vector<oid_t> tile_group_ids;
+  for (size_t offset = 0; offset < tile_group_count; offset++) {
+    tile_group_ids.push_back(table->GetTileGroup(offset)->GetTileGroupId());
+  }
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+
+  // unlink the table the way DROP TABLE does; the storage is handed to the
+  // GC manager rather than freed inline
+  epoch_manager.SetCurrentEpochId(2);
+  database->DropTableWithOid(table_id);
+  EXPECT_THROW(database->GetTableWithOid(table_id), CatalogException);
+
+  // nothing may be released while a reader from the retire epoch could
+  // still be active
+  gc_manager.Reclaim(0, 1);
+  EXPECT_TRUE(catalog_manager.GetTileGroup(tile_group_ids[0]) != nullptr);
+
+  // first eligible pass releases a bounded slice from the front, no more
+  epoch_manager.SetCurrentEpochId(3);
+  gc_manager.Reclaim(0, 2);
+  EXPECT_TRUE(catalog_manager.GetTileGroup(tile_group_ids[0]) == nullptr);
+  EXPECT_TRUE(catalog_manager.GetTileGroup(tile_group_ids.back()) != nullptr);
+
+  // later passes drain the rest and finally delete the table itself
+  for (eid_t eid = 4; eid < 10; eid++) {
+    epoch_manager.SetCurrentEpochId(eid);
+    gc_manager.Reclaim(0, eid - 1);
+  }
+  for (auto tile_group_id : tile_group_ids) {
+    EXPECT_TRUE(catalog_manager.GetTileGroup(tile_group_id) == nullptr);
+  }
+
+  gc_manager.StopGC();
+  gc::GCManagerFactory::Configure(0);
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("DroppedTableDB");
+}
+
 /*
 Brief Summary : This tests tries to check immutability of a tile group.
 Once a tile group is set immutable, gc should not recycle slots from the
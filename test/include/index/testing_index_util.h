@@ -50,6 +50,10 @@ class TestingIndexUtil {
 
   static void NonUniqueKeyMultiThreadedStressTest2(IndexType index_type);
 
+  static void DescendingScanTest(IndexType index_type);
+
+  static void SkipScanTest(IndexType index_type);
+
   //===--------------------------------------------------------------------===//
   // Utility Methods
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bitmap_index_test.cpp
+//
+// Identification: test/index/bitmap_index_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gmock/gtest/gtest.h"
+
+#include "index/bitmap_index.h"
+#include "index/testing_index_util.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+class BitmapIndexTests : public PelotonTest {};
+
+namespace {
+
+using IndexPtr = std::unique_ptr<index::Index, void (*)(index::Index *)>;
+
+IndexPtr BuildBitmapIndex() {
+  return IndexPtr{TestingIndexUtil::BuildIndex(IndexType::BITMAP, false),
+                  TestingIndexUtil::DestroyIndex};
+}
+
+std::unique_ptr<storage::Tuple> MakeKey(const index::Index &index,
+                                        int32_t col_a,
+                                        const std::string &col_b) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index.GetKeySchema(), true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(col_a), pool);
+  key->SetValue(1, type::ValueFactory::GetVarcharValue(col_b), pool);
+  return key;
+}
+
+}  // namespace
+
+TEST_F(BitmapIndexTests, BasicTest) {
+  TestingIndexUtil::BasicTest(IndexType::BITMAP);
+}
+
+TEST_F(BitmapIndexTests, NonUniqueKeyDeleteTest) {
+  // Each entry is its own row with its own slot, the way a table populates
+  // a bitmap index; duplicates of a key value share one bitmap.
+  auto index = BuildBitmapIndex();
+  auto key0 = MakeKey(*index, 100, "a");
+  auto key1 = MakeKey(*index, 200, "b");
+
+  std::vector<std::unique_ptr<ItemPointer>> rows;
+  for (oid_t row = 0; row < 6; row++) {
+    rows.emplace_back(new ItemPointer(1, row));
+  }
+  // rows 0, 2, 4 carry key0; rows 1, 3, 5 carry key1
+  for (oid_t row = 0; row < 6; row++) {
+    index->InsertEntry(row % 2 == 0 ? key0.get() : key1.get(),
+                       rows[row].get());
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(3, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(6, location_ptrs.size());
+  location_ptrs.clear();
+
+  // deleting one row leaves the key's other rows in place
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), rows[2].get()));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  for (auto *location : location_ptrs) {
+    EXPECT_NE(rows[2].get(), location);
+  }
+  location_ptrs.clear();
+
+  // a second delete of the same entry is a no-op
+  EXPECT_FALSE(index->DeleteEntry(key0.get(), rows[2].get()));
+}
+
+TEST_F(BitmapIndexTests, DenseContainerConversionTest) {
+  // Push one key value past the sparse container threshold inside a single
+  // tile group so its container flips to packed bit words, then make sure
+  // membership and deletion still line up.
+  auto index = BuildBitmapIndex();
+  auto key0 = MakeKey(*index, 7, "hot");
+
+  const oid_t num_rows = 200;
+  std::vector<std::unique_ptr<ItemPointer>> rows;
+  for (oid_t row = 0; row < num_rows; row++) {
+    rows.emplace_back(new ItemPointer(3, row));
+    index->InsertEntry(key0.get(), rows[row].get());
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(num_rows, location_ptrs.size());
+  location_ptrs.clear();
+
+  for (oid_t row = 0; row < num_rows; row += 2) {
+    EXPECT_TRUE(index->DeleteEntry(key0.get(), rows[row].get()));
+  }
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(num_rows / 2, location_ptrs.size());
+}
+
+TEST_F(BitmapIndexTests, SelectionCombineTest) {
+  // Two bitmap indexes over the same row set, standing in for two
+  // low-cardinality columns (say status and region): ANDing one key bitmap
+  // from each is the multi-predicate filter path.
+  auto status_index = BuildBitmapIndex();
+  auto region_index = BuildBitmapIndex();
+
+  auto status_active = MakeKey(*status_index, 1, "active");
+  auto status_closed = MakeKey(*status_index, 2, "closed");
+  auto region_east = MakeKey(*region_index, 10, "east");
+  auto region_west = MakeKey(*region_index, 20, "west");
+
+  // row i: status = active iff i % 2 == 0, region = east iff i % 3 == 0
+  const oid_t num_rows = 90;
+  std::vector<std::unique_ptr<ItemPointer>> rows;
+  for (oid_t row = 0; row < num_rows; row++) {
+    rows.emplace_back(new ItemPointer(row / 64, row % 64));
+    status_index->InsertEntry(
+        row % 2 == 0 ? status_active.get() : status_closed.get(),
+        rows[row].get());
+    region_index->InsertEntry(
+        row % 3 == 0 ? region_east.get() : region_west.get(), rows[row].get());
+  }
+
+  auto *status_bitmap_index =
+      static_cast<index::BitmapIndex *>(status_index.get());
+  auto *region_bitmap_index =
+      static_cast<index::BitmapIndex *>(region_index.get());
+
+  // status = active AND region = east <=> row % 6 == 0
+  index::BitmapSelection selection;
+  EXPECT_TRUE(status_bitmap_index->ReadKeyBitmap(status_active.get(),
+                                                 selection));
+  index::BitmapSelection region_selection;
+  EXPECT_TRUE(region_bitmap_index->ReadKeyBitmap(region_east.get(),
+                                                 region_selection));
+  selection.And(region_selection);
+  EXPECT_EQ(15, selection.GetCardinality());
+
+  std::vector<ItemPointer *> location_ptrs;
+  status_bitmap_index->Materialize(selection, location_ptrs);
+  EXPECT_EQ(15, location_ptrs.size());
+  for (auto *location : location_ptrs) {
+    oid_t row = location->block * 64 + location->offset;
+    EXPECT_EQ(0, row % 6);
+  }
+
+  // status = active OR region = east <=> 45 + 30 - 15 rows
+  index::BitmapSelection union_selection;
+  EXPECT_TRUE(status_bitmap_index->ReadKeyBitmap(status_active.get(),
+                                                 union_selection));
+  EXPECT_TRUE(region_bitmap_index->ReadKeyBitmap(region_east.get(),
+                                                 region_selection));
+  union_selection.Or(region_selection);
+  EXPECT_EQ(60, union_selection.GetCardinality());
+
+  // a key value with no rows reports a miss and leaves the selection alone
+  auto status_missing = MakeKey(*status_index, 99, "missing");
+  index::BitmapSelection untouched;
+  EXPECT_FALSE(
+      status_bitmap_index->ReadKeyBitmap(status_missing.get(), untouched));
+  EXPECT_TRUE(untouched.IsEmpty());
+}
+
+}  // namespace test
+}  // namespace peloton
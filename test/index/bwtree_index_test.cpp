@@ -65,5 +65,13 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, DescendingScanTest) {
+  TestingIndexUtil::DescendingScanTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, SkipScanTest) {
+  TestingIndexUtil::SkipScanTest(IndexType::BWTREE);
+}
+
 }  // namespace test
 }  // namespace peloton
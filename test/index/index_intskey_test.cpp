@@ -17,8 +17,10 @@
 #include "common/platform.h"
 #include "common/timer.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
 #include "storage/tuple.h"
 #include "type/value_factory.h"
+#include "type/value_peeker.h"
 
 namespace peloton {
 namespace test {
@@ -239,5 +241,101 @@ TEST_F(IndexIntsKeyTests, IndexIntsKeyTest) {
 // IndexIntsKeyHelper(IndexType::BTREE);
 // }
 
+// A (tenant_id, name) style key: bounded-length VARCHARs are packed as zero
+// padded byte runs alongside the integers, so the whole key still compares
+// with a single memcmp
+TEST_F(IndexIntsKeyTests, CompactIntsKeyStringTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // 4 integer bytes plus a 12 byte padded run -> CompactIntsKey<2>
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "tenant_id", true));
+  columns.push_back(catalog::Column(type::TypeId::VARCHAR, 12, "name", false));
+
+  std::unique_ptr<catalog::Schema> schema(new catalog::Schema(columns));
+
+  auto make_key = [&](int tenant_id, const std::string &name) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(tenant_id), pool);
+    tuple.SetValue(1, type::ValueFactory::GetVarcharValue(name), pool);
+
+    index::CompactIntsKey<2> key;
+    key.SetFromKey(&tuple);
+    return key;
+  };
+
+  auto key_apple = make_key(1, "apple");
+
+  // Equal keys pack to equal bytes
+  EXPECT_EQ(index::CompactIntsKey<2>::Compare(key_apple, make_key(1, "apple")),
+            0);
+
+  // The zero padding ranks a short string before every longer string
+  // sharing its prefix, exactly like VARCHAR comparison
+  EXPECT_LT(
+      index::CompactIntsKey<2>::Compare(key_apple, make_key(1, "applesauce")),
+      0);
+  EXPECT_LT(index::CompactIntsKey<2>::Compare(key_apple, make_key(1, "banana")),
+            0);
+
+  // The leading integer dominates the string, including its sign
+  EXPECT_LT(index::CompactIntsKey<2>::Compare(make_key(1, "zzz"),
+                                              make_key(2, "")),
+            0);
+  EXPECT_LT(index::CompactIntsKey<2>::Compare(make_key(-5, "zzz"),
+                                              make_key(1, "")),
+            0);
+
+  // Both fields survive the round trip through the comparison tuple
+  storage::Tuple round_trip = key_apple.GetTupleForComparison(schema.get());
+  EXPECT_EQ(type::ValuePeeker::PeekInteger(round_trip.GetValue(0)), 1);
+  EXPECT_EQ(std::string(type::ValuePeeker::PeekVarchar(round_trip.GetValue(1))),
+            "apple");
+
+  // End to end: the factory must route this schema to the compact key
+  std::vector<oid_t> key_attrs = {0, 1};
+  catalog::Schema *index_key_schema = new catalog::Schema(columns);
+  index_key_schema->SetIndexedColumns(key_attrs);
+  std::unique_ptr<catalog::Schema> index_tuple_schema(
+      new catalog::Schema(columns));
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "MAGIC_STRING_TEST_INDEX", 126,  // Index oid
+      INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, index_tuple_schema.get(), index_key_schema,
+      key_attrs, true);
+
+  std::unique_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+  EXPECT_TRUE(index != nullptr);
+
+  std::vector<std::shared_ptr<storage::Tuple>> keys;
+  std::vector<std::shared_ptr<ItemPointer>> items;
+  for (int i = 0; i < 64; i++) {
+    std::shared_ptr<storage::Tuple> key(
+        new storage::Tuple(index_key_schema, true));
+    std::shared_ptr<ItemPointer> item(new ItemPointer(i, i * i));
+
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(i % 4), pool);
+    key->SetValue(1, type::ValueFactory::GetVarcharValue(
+                         "name_" + std::to_string(i)),
+                  pool);
+
+    index->InsertEntry(key.get(), item.get());
+    keys.push_back(key);
+    items.push_back(item);
+  }  // FOR
+
+  std::vector<ItemPointer *> location_ptrs;
+  for (int i = 0; i < 64; i++) {
+    location_ptrs.clear();
+    index->ScanKey(keys[i].get(), location_ptrs);
+    EXPECT_EQ(location_ptrs.size(), 1);
+    EXPECT_EQ(location_ptrs[0]->block, items[i]->block);
+  }  // FOR
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -21,6 +21,7 @@
 #include "catalog/catalog.h"
 #include "index/index.h"
 #include "index/index_util.h"
+#include "index/scan_optimizer.h"
 #include "storage/tuple.h"
 #include "type/value_factory.h"
 
@@ -663,6 +664,140 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(
   location_ptrs.clear();
 }
 
+void TestingIndexUtil::DescendingScanTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Three distinct keys in ascending key order
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key2(new storage::Tuple(key_schema, true));
+  key0->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(200), pool);
+  key1->SetValue(1, type::ValueFactory::GetVarcharValue("b"), pool);
+  key2->SetValue(0, type::ValueFactory::GetIntegerValue(300), pool);
+  key2->SetValue(1, type::ValueFactory::GetVarcharValue("c"), pool);
+
+  index->InsertEntry(key0.get(), TestingIndexUtil::item0.get());
+  index->InsertEntry(key1.get(), TestingIndexUtil::item1.get());
+  index->InsertEntry(key2.get(), TestingIndexUtil::item2.get());
+
+  type::Value key0_val0 = (key0->GetValue(0));
+
+  // A forward range scan returns ascending key order
+  index->ScanTest({key0_val0}, {0},
+                  {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+                  ScanDirectionType::FORWARD, location_ptrs);
+  EXPECT_EQ(3, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item0.get(), location_ptrs[0]);
+  EXPECT_EQ(TestingIndexUtil::item1.get(), location_ptrs[1]);
+  EXPECT_EQ(TestingIndexUtil::item2.get(), location_ptrs[2]);
+  location_ptrs.clear();
+
+  // The same range scanned backward returns descending key order
+  index->ScanTest({key0_val0}, {0},
+                  {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+                  ScanDirectionType::BACKWARD, location_ptrs);
+  EXPECT_EQ(3, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item2.get(), location_ptrs[0]);
+  EXPECT_EQ(TestingIndexUtil::item1.get(), location_ptrs[1]);
+  EXPECT_EQ(TestingIndexUtil::item0.get(), location_ptrs[2]);
+  location_ptrs.clear();
+
+  // A descending limit scan hands out the whole range in descending key
+  // order: the index cannot check visibility, so it must not terminate
+  // early and the executor windows the result after its visibility pass
+  index::IndexScanPredicate isp{};
+  isp.AddConjunctionScanPredicate(
+      index.get(), {key0_val0}, {0},
+      {ExpressionType::COMPARE_GREATERTHANOREQUALTO});
+  index->ScanLimit({key0_val0}, {0},
+                   {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+                   ScanDirectionType::BACKWARD, location_ptrs,
+                   &isp.GetConjunctionList()[0], 2, 0);
+  EXPECT_EQ(3, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item2.get(), location_ptrs[0]);
+  EXPECT_EQ(TestingIndexUtil::item1.get(), location_ptrs[1]);
+  EXPECT_EQ(TestingIndexUtil::item0.get(), location_ptrs[2]);
+  location_ptrs.clear();
+}
+
+void TestingIndexUtil::SkipScanTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index, void (*)(index::Index *)> index(
+      TestingIndexUtil::BuildIndex(index_type, false), DestroyIndex);
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Two prefix groups on the first key column, several suffix values each
+  std::unique_ptr<storage::Tuple> key0(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key1(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key2(new storage::Tuple(key_schema, true));
+  std::unique_ptr<storage::Tuple> key3(new storage::Tuple(key_schema, true));
+  key0->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key0->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  key1->SetValue(0, type::ValueFactory::GetIntegerValue(100), pool);
+  key1->SetValue(1, type::ValueFactory::GetVarcharValue("c"), pool);
+  key2->SetValue(0, type::ValueFactory::GetIntegerValue(200), pool);
+  key2->SetValue(1, type::ValueFactory::GetVarcharValue("b"), pool);
+  key3->SetValue(0, type::ValueFactory::GetIntegerValue(300), pool);
+  key3->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+
+  index->InsertEntry(key0.get(), TestingIndexUtil::item0.get());
+  index->InsertEntry(key1.get(), TestingIndexUtil::item1.get());
+  index->InsertEntry(key2.get(), TestingIndexUtil::item2.get());
+  index->InsertEntry(key3.get(), TestingIndexUtil::item0.get());
+
+  // A predicate on the second key column alone leaves the first column as
+  // an unconstrained, skip-scannable prefix
+  type::Value value_b = type::ValueFactory::GetVarcharValue("b");
+
+  index::IndexScanPredicate isp{};
+  isp.AddConjunctionScanPredicate(
+      index.get(), {value_b}, {1},
+      {ExpressionType::COMPARE_GREATERTHANOREQUALTO});
+  const index::ConjunctionScanPredicate &csp = isp.GetConjunctionList()[0];
+  EXPECT_TRUE(csp.IsSkipScannable());
+  EXPECT_EQ(1, csp.GetSkipPrefixColumnCount());
+
+  // The probes enforce the suffix bound under every prefix group, so
+  // (100, "a") and (300, "a") are never returned; results stay in
+  // ascending full-key order
+  index->Scan({value_b}, {1}, {ExpressionType::COMPARE_GREATERTHANOREQUALTO},
+              ScanDirectionType::FORWARD, location_ptrs, &csp);
+  EXPECT_EQ(2, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item1.get(), location_ptrs[0]);
+  EXPECT_EQ(TestingIndexUtil::item2.get(), location_ptrs[1]);
+  location_ptrs.clear();
+
+  // Equality on the suffix alone is a range probe per prefix group, not a
+  // point query
+  type::Value value_a = type::ValueFactory::GetVarcharValue("a");
+
+  index::IndexScanPredicate isp_eq{};
+  isp_eq.AddConjunctionScanPredicate(index.get(), {value_a}, {1},
+                                     {ExpressionType::COMPARE_EQUAL});
+  const index::ConjunctionScanPredicate &csp_eq =
+      isp_eq.GetConjunctionList()[0];
+  EXPECT_FALSE(csp_eq.IsPointQuery());
+  EXPECT_TRUE(csp_eq.IsSkipScannable());
+
+  index->Scan({value_a}, {1}, {ExpressionType::COMPARE_EQUAL},
+              ScanDirectionType::FORWARD, location_ptrs, &csp_eq);
+  EXPECT_EQ(2, location_ptrs.size());
+  EXPECT_EQ(TestingIndexUtil::item0.get(), location_ptrs[0]);
+  EXPECT_EQ(TestingIndexUtil::item0.get(), location_ptrs[1]);
+  location_ptrs.clear();
+}
+
 std::unique_ptr<index::IndexMetadata> TestingIndexUtil::BuildTestIndexMetadata(
     const IndexType index_type, const bool unique_keys) {
   LOG_DEBUG("Build index type: %s [unique_keys=%s]",
@@ -10,9 +10,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include "logging/checkpoint_manager_factory.h"
+#include "logging/logical_checkpoint_manager.h"
 #include "common/harness.h"
 
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+
 namespace peloton {
 namespace test {
 
@@ -22,12 +32,112 @@ namespace test {
 
 class NewCheckpointingTests : public PelotonTest {};
 
+namespace {
+
+// Remove the epoch-stamped checkpoint directories a test left in the
+// working directory
+void RemoveCheckpointDirs() {
+  DIR *cwd = opendir(".");
+  if (cwd == nullptr) {
+    return;
+  }
+  struct dirent *entry;
+  while ((entry = readdir(cwd)) != nullptr) {
+    std::string name(entry->d_name);
+    if (name.compare(0, 11, "checkpoint_") != 0) {
+      continue;
+    }
+    DIR *dir = opendir(name.c_str());
+    if (dir == nullptr) {
+      continue;
+    }
+    struct dirent *file;
+    while ((file = readdir(dir)) != nullptr) {
+      std::string file_name(file->d_name);
+      if (file_name == "." || file_name == "..") {
+        continue;
+      }
+      std::remove((name + "/" + file_name).c_str());
+    }
+    closedir(dir);
+    rmdir(name.c_str());
+  }
+  closedir(cwd);
+}
+
+}  // namespace
+
 TEST_F(NewCheckpointingTests, MyTest) {
   auto &checkpoint_manager = logging::CheckpointManagerFactory::GetInstance();
   checkpoint_manager.Reset();
-  
+
   EXPECT_TRUE(true);
 }
 
+TEST_F(NewCheckpointingTests, PrioritizedRestoreTest) {
+  RemoveCheckpointDirs();
+
+  auto &checkpoint_manager = logging::LogicalCheckpointManager::GetInstance();
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  const oid_t db_oid = 77777;
+  const oid_t first_oid = 77001;
+  const oid_t second_oid = 77002;
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP * 3;
+
+  // Two populated tables registered with the checkpointer
+  auto first_table =
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true,
+                                       first_oid);
+  auto second_table =
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true,
+                                       second_oid);
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(first_table, tuple_count, false, false,
+                                     true, txn);
+  TestingExecutorUtil::PopulateTable(second_table, tuple_count / 3, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto database = new storage::Database(db_oid);
+  database->AddTable(first_table);
+  database->AddTable(second_table);
+  storage_manager->AddDatabaseToStorageManager(database);
+
+  checkpoint_manager.RegisterTable(first_oid);
+  checkpoint_manager.RegisterTable(second_oid);
+  checkpoint_manager.PerformCheckpoint();
+
+  // Drop everything and rebuild empty tables with the same identities,
+  // the way a restarting instance would from its catalog
+  EXPECT_TRUE(storage_manager->RemoveDatabaseFromStorageManager(db_oid));
+  first_table = TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP,
+                                                 true, first_oid);
+  second_table = TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP,
+                                                  true, second_oid);
+  database = new storage::Database(db_oid);
+  database->AddTable(first_table);
+  database->AddTable(second_table);
+  storage_manager->AddDatabaseToStorageManager(database);
+
+  EXPECT_TRUE(checkpoint_manager.PerformRestore());
+
+  EXPECT_EQ(static_cast<size_t>(tuple_count), first_table->GetTupleCount());
+  EXPECT_EQ(static_cast<size_t>(tuple_count / 3),
+            second_table->GetTupleCount());
+
+  // Residency is published per table, so admission does not have to wait
+  // for the full restore
+  EXPECT_TRUE(checkpoint_manager.IsTableRestored(first_oid));
+  EXPECT_TRUE(checkpoint_manager.IsTableRestored(second_oid));
+  checkpoint_manager.WaitForTableRestored(second_oid);
+
+  checkpoint_manager.DeregisterTable(first_oid);
+  checkpoint_manager.DeregisterTable(second_oid);
+  storage_manager->RemoveDatabaseFromStorageManager(db_oid);
+  RemoveCheckpointDirs();
 }
-}
+
+}  // namespace test
+}  // namespace peloton
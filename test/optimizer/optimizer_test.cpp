@@ -24,6 +24,7 @@
 #include "expression/tuple_value_expression.h"
 #include "optimizer/operators.h"
 #include "optimizer/rule_impls.h"
+#include "settings/settings_manager.h"
 #include "traffic_cop/traffic_cop.h"
 
 namespace peloton {
@@ -446,5 +447,114 @@ TEST_F(OptimizerTests, PredicatePushDownRewriteTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(OptimizerTests, ParallelExplorationTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT, c INT);");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test1(a INT PRIMARY KEY, b INT, c INT);");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test2(a INT PRIMARY KEY, b INT, c INT);");
+
+  // Explore the join query on the worker pool; the resulting plan must be
+  // a valid join tree just like in the serial case
+  settings::SettingsManager::SetBool(settings::SettingId::parallel_optimizer,
+                                     true);
+
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(
+      "SELECT * FROM test, test1, test2 WHERE test.a = test1.a AND "
+      "test1.b = test2.b");
+
+  optimizer::Optimizer optimizer;
+  txn = txn_manager.BeginTransaction();
+  auto plan = optimizer.BuildPelotonPlanTree(stmt, DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  settings::SettingsManager::SetBool(settings::SettingId::parallel_optimizer,
+                                     false);
+
+  ASSERT_NE(nullptr, plan);
+  // The costing pass must still have produced a full physical plan tree
+  EXPECT_FALSE(plan->GetChildren().empty());
+}
+
+TEST_F(OptimizerTests, SearchBudgetFallbackTest) {
+  // Reuse the tables created by ParallelExplorationTest. A tiny task budget
+  // cannot finish exploring a three-way join, so the optimizer must fall
+  // back to greedily implementing the plans found so far and still return
+  // a complete physical plan
+  settings::SettingsManager::SetInt(settings::SettingId::optimizer_task_limit,
+                                    5);
+
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(
+      "SELECT * FROM test, test1, test2 WHERE test.a = test1.a AND "
+      "test1.b = test2.b");
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  optimizer::Optimizer optimizer;
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = optimizer.BuildPelotonPlanTree(stmt, DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  settings::SettingsManager::SetInt(settings::SettingId::optimizer_task_limit,
+                                    0);
+
+  ASSERT_NE(nullptr, plan);
+  EXPECT_FALSE(plan->GetChildren().empty());
+}
+
+TEST_F(OptimizerTests, DpJoinEnumerationTest) {
+  // Reuse the tables created by ParallelExplorationTest. With the DP
+  // enumerator picking the join order for the block, cascades must still
+  // produce a complete physical plan
+  settings::SettingsManager::SetBool(
+      settings::SettingId::optimizer_dp_join_enumeration, true);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::optimizer_dp_join_threshold, 3);
+
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(
+      "SELECT * FROM test, test1, test2 WHERE test.a = test1.a AND "
+      "test1.b = test2.b");
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  optimizer::Optimizer optimizer;
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = optimizer.BuildPelotonPlanTree(stmt, DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::optimizer_dp_join_enumeration, false);
+  settings::SettingsManager::SetInt(
+      settings::SettingId::optimizer_dp_join_threshold, 4);
+
+  ASSERT_NE(nullptr, plan);
+  EXPECT_FALSE(plan->GetChildren().empty());
+}
+
+TEST_F(OptimizerTests, MergeJoinPlanningTest) {
+  // Reuse the tables created by ParallelExplorationTest. With the merge join
+  // implementation rule in the rule set, a join on indexed primary-key
+  // columns with a sort requirement on the join key must still plan cleanly
+  auto &peloton_parser = parser::PostgresParser::GetInstance();
+  auto stmt = peloton_parser.BuildParseTree(
+      "SELECT * FROM test, test1 WHERE test.a = test1.a ORDER BY test.a");
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  optimizer::Optimizer optimizer;
+  auto txn = txn_manager.BeginTransaction();
+  auto plan = optimizer.BuildPelotonPlanTree(stmt, DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  ASSERT_NE(nullptr, plan);
+  EXPECT_FALSE(plan->GetChildren().empty());
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -55,5 +55,31 @@ TEST_F(TupleSamplerTests, SampleCountTest) {
   EXPECT_EQ(sampled_tuples.size(), 10);
 }
 
+TEST_F(TupleSamplerTests, BlockSampleCountTest) {
+  const int tuple_count = 100;
+  const int tuple_per_tilegroup = 10;
+
+  // Create a table spread over several tile groups
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_per_tilegroup, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  TupleSampler sampler(data_table.get());
+
+  // 25 samples span at least three 10-tuple tile groups
+  size_t sampled_count = sampler.AcquireBlockSampleTuples(25);
+  EXPECT_EQ(sampled_count, 25);
+  EXPECT_EQ(sampler.GetSampledTuples().size(), 25);
+
+  // Asking for more tuples than the table holds caps at the table size
+  TupleSampler full_sampler(data_table.get());
+  size_t full_count = full_sampler.AcquireBlockSampleTuples(1000);
+  EXPECT_EQ(full_count, static_cast<size_t>(tuple_count));
+}
+
 }  // namespace test
 }  // namespace peloton
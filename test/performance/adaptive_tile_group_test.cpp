@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// adaptive_tile_group_test.cpp
+//
+// Identification: test/performance/adaptive_tile_group_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+#include "common/timer.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "executor/testing_executor_util.h"
+#include "settings/settings_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Adaptive Tile Group Sizing Tests
+//===--------------------------------------------------------------------===//
+
+class AdaptiveTileGroupTests : public PelotonTest {};
+
+namespace {
+
+// Tuples per tile group at CREATE TABLE; adaptive sizing drifts between
+// an eighth (floored at 64) and eight times of this
+const int kBaseTileGroupSize = 64;
+
+void Populate(storage::DataTable *table, int num_rows) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, num_rows, false, false, true, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+// Walk every tuple of column 0 through logical tile wrappers, the way a
+// sequential scan does, and return the wall time
+double TimeFullScan(storage::DataTable *table) {
+  Timer<> timer;
+  timer.Start();
+  size_t tuples_seen = 0;
+  for (size_t tg_itr = 0; tg_itr < table->GetTileGroupCount(); tg_itr++) {
+    auto tile_group = table->GetTileGroup(tg_itr);
+    std::unique_ptr<executor::LogicalTile> logical_tile(
+        executor::LogicalTileFactory::WrapTileGroup(tile_group));
+    for (oid_t tuple_itr = 0; tuple_itr < logical_tile->GetTupleCount();
+         tuple_itr++) {
+      logical_tile->GetValue(tuple_itr, 0);
+      tuples_seen++;
+    }
+  }
+  timer.Stop();
+  LOG_INFO("Scanned %zu tuples over %zu tile groups in %.4lf s", tuples_seen,
+           table->GetTileGroupCount(), timer.GetDuration());
+  return timer.GetDuration();
+}
+
+}  // namespace
+
+TEST_F(AdaptiveTileGroupTests, ScanInsertMixTest) {
+  // Control table: fixed-size tile groups
+  std::unique_ptr<storage::DataTable> fixed_table(
+      TestingExecutorUtil::CreateTable(kBaseTileGroupSize, false));
+  Populate(fixed_table.get(), kBaseTileGroupSize * 40);
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::adaptive_tile_group_size, true);
+
+  std::unique_ptr<storage::DataTable> adaptive_table(
+      TestingExecutorUtil::CreateTable(kBaseTileGroupSize, false));
+
+  // Insert-heavy phase: no scans between allocations, so tile groups grow
+  Populate(adaptive_table.get(), kBaseTileGroupSize * 40);
+
+  auto last_group = adaptive_table->GetTileGroup(
+      adaptive_table->GetTileGroupCount() - 1);
+  EXPECT_GT(last_group->GetAllocatedTupleCount(),
+            static_cast<oid_t>(kBaseTileGroupSize));
+  EXPECT_LT(adaptive_table->GetTileGroupCount(),
+            fixed_table->GetTileGroupCount());
+
+  // The payoff of the grown layout: the same pass crosses fewer tile
+  // group boundaries
+  auto fixed_duration = TimeFullScan(fixed_table.get());
+  auto adaptive_duration = TimeFullScan(adaptive_table.get());
+  LOG_INFO("Full scan: fixed %.4lf s, adaptive %.4lf s", fixed_duration,
+           adaptive_duration);
+
+  // Scan-heavy phase: frequent scans between allocations shrink the tile
+  // groups back down, so they become immutable sooner
+  for (int round = 0; round < 8; round++) {
+    for (int scan_itr = 0; scan_itr < 20; scan_itr++) {
+      adaptive_table->RecordScan();
+    }
+    Populate(adaptive_table.get(), kBaseTileGroupSize * 8);
+  }
+  last_group = adaptive_table->GetTileGroup(
+      adaptive_table->GetTileGroupCount() - 1);
+  EXPECT_LE(last_group->GetAllocatedTupleCount(),
+            static_cast<oid_t>(kBaseTileGroupSize));
+
+  settings::SettingsManager::SetBool(
+      settings::SettingId::adaptive_tile_group_size, false);
+}
+
+}  // namespace test
+}  // namespace peloton
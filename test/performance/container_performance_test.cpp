@@ -0,0 +1,306 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// container_performance_test.cpp
+//
+// Identification: test/performance/container_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+#include <atomic>
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "catalog/schema.h"
+#include "common/container/cuckoo_map.h"
+#include "common/container/lock_free_queue.h"
+#include "common/synchronization/spin_latch.h"
+#include "common/timer.h"
+#include "index/index_factory.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Container Performance Tests
+//===--------------------------------------------------------------------===//
+// Microbenchmarks for the core concurrent data structures. Each benchmark
+// sweeps the thread count so that scalability regressions show up in the
+// reported per-thread-count throughput, not just in the single-threaded
+// number. Run these before and after touching any of the containers.
+//===--------------------------------------------------------------------===//
+
+class ContainerPerformanceTests : public PelotonTest {};
+
+// Thread counts to sweep for the contention curves
+static const std::vector<size_t> benchmark_thread_counts = {1, 2, 4, 8};
+
+// Operations issued by each thread in one benchmark round
+static const size_t benchmark_ops_per_thread = 1 << 18;
+
+static void ReportThroughput(const char *benchmark_name,
+                             const size_t num_threads, const size_t total_ops,
+                             const double duration) {
+  LOG_INFO("%s :: %d threads :: %.2lf Mops/sec", benchmark_name,
+           (int)num_threads, total_ops / duration / 1000.0 / 1000.0);
+}
+
+//===------------------------------===//
+// CuckooMap
+//===------------------------------===//
+
+static void CuckooMapMixedTask(CuckooMap<uint32_t, uint32_t> *map,
+                               uint64_t thread_itr) {
+  uint32_t base = (uint32_t)thread_itr * benchmark_ops_per_thread;
+
+  // 50% inserts, 50% lookups over a thread-private key range, so the
+  // benchmark measures bucket/latch contention rather than key conflicts
+  for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+    uint32_t key = base + (uint32_t)op_itr;
+    if ((op_itr & 1) == 0) {
+      map->Insert(key, key);
+    } else {
+      uint32_t value = 0;
+      map->Find(base + (uint32_t)(op_itr >> 1), value);
+    }
+  }
+}
+
+TEST_F(ContainerPerformanceTests, CuckooMapMixedBenchmark) {
+  for (auto num_threads : benchmark_thread_counts) {
+    CuckooMap<uint32_t, uint32_t> map;
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(num_threads, CuckooMapMixedTask, &map);
+    timer.Stop();
+
+    ReportThroughput("cuckoo_map mixed", num_threads,
+                     num_threads * benchmark_ops_per_thread,
+                     timer.GetDuration());
+
+    EXPECT_EQ(num_threads * benchmark_ops_per_thread / 2, map.GetSize());
+  }
+}
+
+//===------------------------------===//
+// LockFreeQueue
+//===------------------------------===//
+
+static void LockFreeQueueTask(LockFreeQueue<uint32_t> *queue,
+                              std::atomic<size_t> *dequeue_count,
+                              uint64_t thread_itr) {
+  if ((thread_itr & 1) == 0) {
+    // producer
+    for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+      queue->Enqueue((uint32_t)op_itr);
+    }
+  } else {
+    // consumer: spin until the matching producer's items have been drained
+    size_t consumed = 0;
+    uint32_t item = 0;
+    while (consumed < benchmark_ops_per_thread) {
+      if (queue->Dequeue(item) == true) {
+        consumed++;
+      }
+    }
+    dequeue_count->fetch_add(consumed);
+  }
+}
+
+TEST_F(ContainerPerformanceTests, LockFreeQueueBenchmark) {
+  // producer/consumer pairs, so sweep even thread counts only
+  for (auto num_threads : benchmark_thread_counts) {
+    if (num_threads < 2) continue;
+
+    LockFreeQueue<uint32_t> queue(benchmark_ops_per_thread);
+    std::atomic<size_t> dequeue_count(0);
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(num_threads, LockFreeQueueTask, &queue, &dequeue_count);
+    timer.Stop();
+
+    ReportThroughput("lock_free_queue enqueue/dequeue", num_threads,
+                     num_threads * benchmark_ops_per_thread,
+                     timer.GetDuration());
+
+    EXPECT_EQ((num_threads / 2) * benchmark_ops_per_thread,
+              dequeue_count.load());
+  }
+}
+
+//===------------------------------===//
+// BWTree point operations
+//===------------------------------===//
+
+static catalog::Schema *bwtree_key_schema = nullptr;
+static catalog::Schema *bwtree_tuple_schema = nullptr;
+
+static std::shared_ptr<ItemPointer> bwtree_item(new ItemPointer(120, 5));
+
+static index::Index *BuildBWTreeIndex() {
+  catalog::Column column1(type::TypeId::INTEGER,
+                          type::Type::GetTypeSize(type::TypeId::INTEGER), "A",
+                          true);
+  catalog::Column column2(type::TypeId::INTEGER,
+                          type::Type::GetTypeSize(type::TypeId::INTEGER), "B",
+                          true);
+
+  std::vector<catalog::Column> key_columns = {column1};
+  std::vector<catalog::Column> tuple_columns = {column1, column2};
+
+  bwtree_key_schema = new catalog::Schema(key_columns);
+  bwtree_tuple_schema = new catalog::Schema(tuple_columns);
+
+  std::vector<oid_t> key_attrs = {0};
+  bwtree_key_schema->SetIndexedColumns(key_attrs);
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "bwtree_perf_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, bwtree_tuple_schema, bwtree_key_schema,
+      key_attrs, false);
+
+  return index::IndexFactory::GetIndex(index_metadata);
+}
+
+static void BWTreePointOpTask(index::Index *index, uint64_t thread_itr) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(bwtree_key_schema, true));
+
+  int base = (int)(thread_itr * benchmark_ops_per_thread);
+
+  // insert a thread-private key range, then read it back point-wise
+  for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+    key->SetValue(0,
+                  type::ValueFactory::GetIntegerValue(base + (int)op_itr),
+                  pool);
+    index->InsertEntry(key.get(), bwtree_item.get());
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+  for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+    key->SetValue(0,
+                  type::ValueFactory::GetIntegerValue(base + (int)op_itr),
+                  pool);
+    location_ptrs.clear();
+    index->ScanKey(key.get(), location_ptrs);
+  }
+}
+
+TEST_F(ContainerPerformanceTests, BWTreePointOpBenchmark) {
+  for (auto num_threads : benchmark_thread_counts) {
+    std::unique_ptr<index::Index> index(BuildBWTreeIndex());
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(num_threads, BWTreePointOpTask, index.get());
+    timer.Stop();
+
+    // each thread does one insert and one point lookup per key
+    ReportThroughput("bwtree insert+lookup", num_threads,
+                     2 * num_threads * benchmark_ops_per_thread,
+                     timer.GetDuration());
+
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(num_threads * benchmark_ops_per_thread, location_ptrs.size());
+  }
+}
+
+TEST_F(ContainerPerformanceTests, BWTreeRangeScanBenchmark) {
+  const size_t num_scans = 64;
+
+  std::unique_ptr<index::Index> index(BuildBWTreeIndex());
+
+  // single-threaded load, then repeated full-range scans
+  LaunchParallelTest(1, BWTreePointOpTask, index.get());
+
+  Timer<> timer;
+  timer.Start();
+  for (size_t scan_itr = 0; scan_itr < num_scans; scan_itr++) {
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(benchmark_ops_per_thread, location_ptrs.size());
+  }
+  timer.Stop();
+
+  ReportThroughput("bwtree range scan", 1,
+                   num_scans * benchmark_ops_per_thread, timer.GetDuration());
+}
+
+//===------------------------------===//
+// EphemeralPool allocation
+//===------------------------------===//
+
+static void EphemeralPoolTask(type::EphemeralPool *pool, uint64_t) {
+  const size_t allocation_size = 64;
+
+  // allocate then immediately free, keeping the location set small so the
+  // benchmark stresses the pool latch rather than the allocator
+  for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+    void *location = pool->Allocate(allocation_size);
+    pool->Free(location);
+  }
+}
+
+TEST_F(ContainerPerformanceTests, EphemeralPoolBenchmark) {
+  for (auto num_threads : benchmark_thread_counts) {
+    type::EphemeralPool pool;
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(num_threads, EphemeralPoolTask, &pool);
+    timer.Stop();
+
+    ReportThroughput("ephemeral_pool allocate/free", num_threads,
+                     num_threads * benchmark_ops_per_thread,
+                     timer.GetDuration());
+
+    EXPECT_TRUE(pool.locations_.empty());
+  }
+}
+
+//===------------------------------===//
+// SpinLatch contention
+//===------------------------------===//
+
+static void SpinLatchTask(common::synchronization::SpinLatch *latch,
+                          size_t *shared_counter, uint64_t) {
+  for (size_t op_itr = 0; op_itr < benchmark_ops_per_thread; op_itr++) {
+    latch->Lock();
+    (*shared_counter)++;
+    latch->Unlock();
+  }
+}
+
+TEST_F(ContainerPerformanceTests, SpinLatchContentionBenchmark) {
+  for (auto num_threads : benchmark_thread_counts) {
+    common::synchronization::SpinLatch latch;
+    size_t shared_counter = 0;
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(num_threads, SpinLatchTask, &latch, &shared_counter);
+    timer.Stop();
+
+    ReportThroughput("spin_latch lock/unlock", num_threads,
+                     num_threads * benchmark_ops_per_thread,
+                     timer.GetDuration());
+
+    EXPECT_EQ(num_threads * benchmark_ops_per_thread, shared_counter);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
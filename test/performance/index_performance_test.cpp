@@ -369,6 +369,10 @@ TEST_F(IndexPerformanceTests, BwTreeMultiThreadedTest) {
   TestIndexPerformance(IndexType::BWTREE);
 }
 
+TEST_F(IndexPerformanceTests, SkipListMultiThreadedTest) {
+  TestIndexPerformance(IndexType::SKIPLIST);
+}
+
 // TEST_F(IndexPerformanceTests, BTreeMultiThreadedTest) {
 //  TestIndexPerformance(IndexType::BTREE);
 //}
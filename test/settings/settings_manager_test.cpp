@@ -113,5 +113,24 @@ TEST_F(SettingsManagerTests, ModificationTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(SettingsManagerTests, SnapshotTest) {
+  const settings::SettingsSnapshot *snapshot =
+      settings::SettingsManager::GetCurrentSnapshot();
+  EXPECT_NE(nullptr, snapshot);
+  uint64_t old_version = snapshot->version;
+  EXPECT_EQ(settings::SettingsManager::GetInt(settings::SettingId::port),
+            snapshot->GetInt(settings::SettingId::port));
+
+  // a SET publishes a new snapshot with a higher version
+  settings::SettingsManager::SetInt(settings::SettingId::port, 54321);
+
+  const settings::SettingsSnapshot *new_snapshot =
+      settings::SettingsManager::GetCurrentSnapshot();
+  EXPECT_GT(new_snapshot->version, old_version);
+  EXPECT_EQ(54321, new_snapshot->GetInt(settings::SettingId::port));
+  EXPECT_EQ(54321,
+            settings::SettingsManager::GetInt(settings::SettingId::port));
+}
+
 }  // namespace test
 }  // namespace peloton
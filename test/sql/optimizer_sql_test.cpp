@@ -731,6 +731,18 @@ TEST_F(OptimizerSQLTests, NestedQueryTest) {
       "select B.a from test as B where exists (select b as a from test as T "
       "where a = B.a and exists (select c from test where T.c = c));",
       {"1", "2", "3", "4"}, false);
+  TestUtil(
+      "select B.a from test as B where not exists (select b as a from test2 "
+      "where a = B.a);",
+      {"4"}, false);
+  TestUtil(
+      "select B.a from test as B where not exists (select b as a from test2 "
+      "where a = B.a and b < 20);",
+      {"1", "3", "4"}, false);
+  // Duplicate rows on the inner side must not duplicate the outer rows
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test2 VALUES (6, 22, 'dup');");
+  TestUtil("select a from test where b in (select b from test2)",
+           {"1", "2", "3", "4"}, false);
 }
 
 /*
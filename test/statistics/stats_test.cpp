@@ -113,6 +113,39 @@ void TransactionTest(storage::Database *database, storage::DataTable *table,
   }
 }
 
+TEST_F(StatsTests, LatencyHistogramTest) {
+  stats::HistogramMetric histogram{MetricType::HISTOGRAM};
+
+  // Empty histogram reports zeros
+  EXPECT_EQ(0, histogram.GetTotalCount());
+  EXPECT_DOUBLE_EQ(0.0, histogram.GetPercentile(0.99));
+
+  // 99 fast queries and one slow outlier: the average would hide the
+  // outlier, the histogram's P99 must not
+  for (int i = 0; i < 99; i++) {
+    histogram.RecordLatency(1.0);
+  }
+  histogram.RecordLatency(500.0);
+
+  EXPECT_EQ(100, histogram.GetTotalCount());
+  EXPECT_LT(histogram.GetPercentile(0.5), 2.0);
+  // log-bucketing bounds the relative error to one sub-bucket (12.5%)
+  EXPECT_GE(histogram.GetPercentile(0.99), 500.0 * 0.875);
+  EXPECT_DOUBLE_EQ(500.0, histogram.GetMaxLatency());
+
+  // Merging two histograms adds their buckets
+  stats::HistogramMetric other{MetricType::HISTOGRAM};
+  for (int i = 0; i < 100; i++) {
+    other.RecordLatency(1.0);
+  }
+  histogram.Aggregate(other);
+  EXPECT_EQ(200, histogram.GetTotalCount());
+  EXPECT_GE(histogram.GetPercentile(0.999), 500.0 * 0.875);
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.GetTotalCount());
+}
+
 TEST_F(StatsTests, MultiThreadStatsTest) {
   auto catalog = catalog::Catalog::GetInstance();
   catalog->Bootstrap();
@@ -190,6 +223,16 @@ TEST_F(StatsTests, MultiThreadStatsTest) {
   ASSERT_EQ(index_access.GetInserts(),
             num_threads * NUM_ITERATION * NUM_INDEX_INSERT);
 
+  // Check the flat text snapshot served by the metrics export endpoint
+  auto snapshot = aggregator.GetExportSnapshot();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_NE(std::string::npos,
+            snapshot->find("txn_committed{database=\"" +
+                           std::to_string(db_oid) + "\"} " +
+                           std::to_string(db_metric->GetTxnCommitted()
+                                              .GetCounter())));
+  EXPECT_NE(std::string::npos, snapshot->find("txn_latency_average_ms "));
+
   txn = txn_manager.BeginTransaction();
   catalog->DropDatabaseWithName("emp_db", txn);
   txn_manager.CommitTransaction(txn);
@@ -14,7 +14,12 @@
 
 #include "storage/data_table.h"
 
+#include "catalog/column.h"
+#include "catalog/constraint.h"
 #include "executor/testing_executor_util.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
@@ -87,5 +92,67 @@ TEST_F(DataTableTests, GlobalTableTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(DataTableTests, AddDefaultNullColumnTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                   false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto old_column_count = data_table->GetSchema()->GetColumnCount();
+  auto old_tile_group = data_table->GetTileGroup(0);
+  EXPECT_EQ(0u, data_table->GetSchemaVersion());
+
+  // Metadata-only add: the schema widens and the version bumps, but the
+  // existing tile group keeps its old layout
+  catalog::Column added_column(type::TypeId::INTEGER,
+                               type::Type::GetTypeSize(type::TypeId::INTEGER),
+                               "added_col", true);
+  EXPECT_TRUE(data_table->AddDefaultNullColumn(added_column));
+  EXPECT_EQ(old_column_count + 1, data_table->GetSchema()->GetColumnCount());
+  EXPECT_EQ(1u, data_table->GetSchemaVersion());
+  EXPECT_FALSE(old_tile_group->HasColumn(old_column_count));
+  EXPECT_EQ(0u, old_tile_group->GetSchemaVersion());
+
+  // Old rows read the new column back as NULL, both directly through the
+  // tile group and through a wrapped logical tile
+  EXPECT_TRUE(old_tile_group->GetValue(0, old_column_count).IsNull());
+
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::GetTile());
+  logical_tile->AddColumns(old_tile_group, {0, old_column_count});
+  logical_tile->AddIdentityPositionList(tuple_count);
+  EXPECT_FALSE(logical_tile->GetValue(0, 0).IsNull());
+  EXPECT_TRUE(logical_tile->GetValue(0, 1).IsNull());
+
+  // The NULL fill tile is built once and shared
+  auto fill_tile = data_table->GetNullFillTile(
+      old_column_count, old_tile_group->GetAllocatedTupleCount());
+  ASSERT_TRUE(fill_tile != nullptr);
+  EXPECT_EQ(fill_tile.get(),
+            data_table
+                ->GetNullFillTile(old_column_count,
+                                  old_tile_group->GetAllocatedTupleCount())
+                .get());
+
+  // Tile groups created after the change carry the widened layout
+  auto new_tile_group =
+      data_table->GetTileGroup(data_table->GetTileGroupCount() - 1);
+  EXPECT_TRUE(new_tile_group->HasColumn(old_column_count));
+  EXPECT_EQ(1u, new_tile_group->GetSchemaVersion());
+
+  // Constrained columns do not qualify for the fast path
+  catalog::Column not_null_column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "not_null_col", true);
+  not_null_column.AddConstraint(
+      catalog::Constraint(ConstraintType::NOTNULL, "not_null"));
+  EXPECT_FALSE(data_table->AddDefaultNullColumn(not_null_column));
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// materialized_view_test.cpp
+//
+// Identification: test/storage/materialized_view_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/testing_transaction_util.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/materialized_view_manager.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Materialized View Tests
+//===--------------------------------------------------------------------===//
+
+class MaterializedViewTests : public PelotonTest {};
+
+namespace {
+
+// Find the row whose group-by key equals the given integer, or nullptr
+const std::vector<type::Value> *FindGroup(
+    const std::vector<std::vector<type::Value>> &rows, int key) {
+  for (const auto &row : rows) {
+    if (row[0].CompareEquals(type::ValueFactory::GetIntegerValue(key)) ==
+        CmpBool::TRUE) {
+      return &row;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_F(MaterializedViewTests, IncrementalMaintenanceTest) {
+  // SELECT value, COUNT(*), SUM(id) FROM test_table GROUP BY value;
+  // CreateTable seeds ids 0..9, all with value 0
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &view_manager = storage::MaterializedViewManager::GetInstance();
+
+  std::vector<storage::MaterializedView::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, INVALID_OID},
+      {ExpressionType::AGGREGATE_SUM, 0}};
+
+  auto txn = txn_manager.BeginTransaction();
+  auto view = view_manager.CreateView(table, {1}, agg_terms, txn);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_NE(view, nullptr);
+
+  // The initial build folds in the seeded rows: one group, count 10,
+  // sum of ids 0..9
+  std::vector<std::vector<type::Value>> rows;
+  view->GetRows(rows);
+  EXPECT_EQ(1, rows.size());
+  auto *group = FindGroup(rows, 0);
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(CmpBool::TRUE, (*group)[1].CompareEquals(
+                               type::ValueFactory::GetBigIntValue(10)));
+  EXPECT_EQ(CmpBool::TRUE, (*group)[2].CompareEquals(
+                               type::ValueFactory::GetIntegerValue(45)));
+
+  // Committed update moves id 3 from group 0 to group 1
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 3, 1));
+  txn_manager.CommitTransaction(txn);
+
+  // Committed delete removes id 5 from group 0
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, 5));
+  txn_manager.CommitTransaction(txn);
+
+  // Committed insert adds id 20 to group 1
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table, 20, 1));
+  txn_manager.CommitTransaction(txn);
+
+  // An aborted write must leave the view untouched
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table, 7, 5));
+  txn_manager.AbortTransaction(txn);
+
+  view->GetRows(rows);
+  EXPECT_EQ(2, rows.size());
+  group = FindGroup(rows, 0);
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(CmpBool::TRUE, (*group)[1].CompareEquals(
+                               type::ValueFactory::GetBigIntValue(8)));
+  EXPECT_EQ(CmpBool::TRUE, (*group)[2].CompareEquals(
+                               type::ValueFactory::GetIntegerValue(37)));
+  group = FindGroup(rows, 1);
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(CmpBool::TRUE, (*group)[1].CompareEquals(
+                               type::ValueFactory::GetBigIntValue(2)));
+  EXPECT_EQ(CmpBool::TRUE, (*group)[2].CompareEquals(
+                               type::ValueFactory::GetIntegerValue(23)));
+
+  // The registry matches on table, group-by columns and aggregate terms
+  EXPECT_EQ(view, view_manager.FindView(table->GetOid(), {1}, agg_terms));
+  EXPECT_EQ(nullptr, view_manager.FindView(table->GetOid(), {0}, agg_terms));
+
+  view_manager.DropViews(table->GetOid());
+  EXPECT_EQ(nullptr, view_manager.FindView(table->GetOid(), {1}, agg_terms));
+}
+
+}  // namespace test
+}  // namespace peloton
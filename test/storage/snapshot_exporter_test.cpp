@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// snapshot_exporter_test.cpp
+//
+// Identification: test/storage/snapshot_exporter_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+#include "storage/data_table.h"
+#include "storage/snapshot_exporter.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Snapshot Exporter Tests
+//===--------------------------------------------------------------------===//
+
+class SnapshotExporterTests : public PelotonTest {};
+
+TEST_F(SnapshotExporterTests, SingleSegmentExportTest) {
+  auto database = TestingExecutorUtil::InitializeDatabase("SnapshotExportDB");
+  oid_t database_id = database->GetOid();
+
+  const int tuple_count = 10;
+  auto table = TestingTransactionUtil::CreateTable(
+      tuple_count, "EXPORT_TABLE", database_id, TEST_TABLE_OID, 1234, false,
+      100);
+
+  auto &exporter = storage::SnapshotExporter::GetInstance();
+
+  // freeze after the inserts have committed; with GC off the pin is a no-op
+  // but the snapshot commit id still fixes visibility for the dump
+  cid_t snapshot_cid = exporter.Freeze();
+
+  std::string file_prefix = "snapshot_exporter_test_dump";
+  size_t exported_tuples =
+      exporter.ExportTable(table, file_prefix, snapshot_cid, 1);
+  EXPECT_EQ(tuple_count, exported_tuples);
+
+  // one worker produces exactly one segment, in the COPY text format
+  std::string segment_path = file_prefix + ".part-0";
+  std::ifstream segment(segment_path);
+  EXPECT_TRUE(segment.good());
+  std::stringstream contents;
+  contents << segment.rdbuf();
+
+  std::string expected;
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    expected += std::to_string(tuple_itr) + ",0\n";
+  }
+  EXPECT_EQ(expected, contents.str());
+
+  exporter.Release(snapshot_cid);
+
+  std::remove(segment_path.c_str());
+  TestingExecutorUtil::DeleteDatabase("SnapshotExportDB");
+}
+
+}  // namespace test
+}  // namespace peloton
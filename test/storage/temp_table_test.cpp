@@ -103,5 +103,67 @@ TEST_F(TempTableTests, InsertTest) {
   EXPECT_EQ(tuple_count, found_tuple_count);
 }
 
+TEST_F(TempTableTests, SpillTest) {
+  const int tuple_count = storage::TEMPTABLE_DEFAULT_SIZE * 4;
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Only inlined columns, so the table is eligible for spilling
+  catalog::Schema *schema = new catalog::Schema(
+      {TestingExecutorUtil::GetColumnInfo(0),
+       TestingExecutorUtil::GetColumnInfo(1)});
+
+  storage::TempTable table(INVALID_OID, schema, true);
+
+  // A one-byte budget forces every full tile group out to disk
+  table.SetSpillBudget(1);
+  EXPECT_EQ(0, table.GetSpilledTileGroupCount());
+
+  std::vector<type::Value> values;
+  for (int i = 0; i < tuple_count; i++) {
+    std::unique_ptr<storage::Tuple> tuple(
+        new storage::Tuple(table.GetSchema(), true));
+    auto val1 = type::ValueFactory::GetIntegerValue(
+        TestingExecutorUtil::PopulatedValue(i, 0));
+    auto val2 = type::ValueFactory::GetIntegerValue(
+        TestingExecutorUtil::PopulatedValue(i, 1));
+    tuple->SetValue(0, val1, pool);
+    tuple->SetValue(1, val2, pool);
+    table.InsertTuple(tuple.get());
+    values.push_back(val1);
+  }
+  EXPECT_EQ(tuple_count, table.GetTupleCount());
+
+  // Everything but the tile group still taking inserts should be on disk
+  EXPECT_GE(table.GetSpilledTileGroupCount(),
+            table.GetTileGroupCount() - 2);
+  EXPECT_GT(table.GetSpilledTileGroupCount(), 0);
+
+  // Scanning back must be oblivious to where each tile group lives
+  oid_t found_tuple_count = 0;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table.GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table.GetTileGroup(tile_group_itr);
+    for (oid_t tile_itr = 0; tile_itr < tile_group->GetTileCount();
+         tile_itr++) {
+      storage::Tile *tile = tile_group->GetTile(tile_itr);
+      if (tile == nullptr) continue;
+      storage::Tuple tuple(tile->GetSchema());
+      storage::TupleIterator tuple_itr(tile);
+      while (tuple_itr.Next(tuple)) {
+        auto tupleVal = tuple.GetValue(0);
+        EXPECT_FALSE(tupleVal.IsNull());
+        bool found = false;
+        for (auto val : values) {
+          found = val.CompareEquals(tupleVal) == CmpBool::TRUE;
+          if (found) break;
+        }  // FOR
+        EXPECT_TRUE(found);
+        found_tuple_count++;
+      }
+    }
+  }  // FOR
+  EXPECT_EQ(tuple_count, found_tuple_count);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -58,5 +58,33 @@ TEST_F(TileGroupIteratorTests, BasicTest) {
   EXPECT_EQ(allocated_tilegroup_count, actual_tile_group_count);
 }
 
+TEST_F(TileGroupIteratorTests, WindowBasicTest) {
+  const int tuples_per_tilegroup = TESTS_TUPLES_PER_TILEGROUP;
+  const int expected_tilegroup_count = 5;
+  const int allocated_tilegroup_count = 6;
+  const int tuple_count = tuples_per_tilegroup * expected_tilegroup_count;
+
+  // Create a table and wrap it in logical tiles
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tilegroup, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // A window smaller than the table forces several refills
+  storage::TileGroupWindowIterator tile_group_itr(data_table.get(), 2);
+  storage::TileGroup *tile_group = nullptr;
+  int actual_tile_group_count = 0;
+  while (tile_group_itr.Next(tile_group)) {
+    if (tile_group != nullptr) {
+      actual_tile_group_count += 1;
+    }
+  }  // WHILE
+
+  EXPECT_EQ(allocated_tilegroup_count, actual_tile_group_count);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -531,5 +531,46 @@ TEST_F(TileGroupTests, TileCopyTest) {
   EXPECT_TRUE(intended_behavior);
 }
 
+TEST_F(TileGroupTests, CompactHeaderTest) {
+  const oid_t tuple_count = 8;
+  const oid_t committed_count = 4;
+
+  storage::TileGroupHeader header(BackendType::MM, tuple_count);
+
+  // commit a few versions the way the transaction manager would
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < committed_count;
+       tuple_slot_id++) {
+    EXPECT_EQ(tuple_slot_id, header.GetNextEmptyTupleSlot());
+    header.SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+    header.SetBeginCommitId(tuple_slot_id, 2 + tuple_slot_id);
+    header.SetEndCommitId(tuple_slot_id, MAX_CID);
+  }
+
+  // freezing requires the immutable flag
+  EXPECT_FALSE(header.Freeze());
+  EXPECT_TRUE(header.SetImmutability());
+  EXPECT_TRUE(header.Freeze());
+  EXPECT_TRUE(header.IsCompact());
+
+  // visible slots read as committed versions at the frozen timestamp
+  EXPECT_EQ(INITIAL_TXN_ID, header.GetTransactionId(0));
+  EXPECT_EQ(2 + committed_count - 1, header.GetBeginCommitId(0));
+  EXPECT_EQ(MAX_CID, header.GetEndCommitId(0));
+
+  // empty slots read as never-inserted
+  EXPECT_EQ(INVALID_TXN_ID, header.GetTransactionId(committed_count));
+  EXPECT_EQ(MAX_CID, header.GetBeginCommitId(committed_count));
+
+  // a writer touch lazily re-expands the full header
+  header.SetEndCommitId(0, 10);
+  EXPECT_FALSE(header.IsCompact());
+  EXPECT_EQ(10, header.GetEndCommitId(0));
+  EXPECT_EQ(2 + committed_count - 1, header.GetBeginCommitId(1));
+  EXPECT_EQ(INVALID_TXN_ID, header.GetTransactionId(committed_count));
+
+  // the deleted version is no longer all-visible, so freezing must fail
+  EXPECT_FALSE(header.Freeze());
+}
+
 }  // namespace test
 }  // namespace peloton
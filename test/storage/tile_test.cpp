@@ -15,6 +15,7 @@
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tuple_iterator.h"
+#include "type/ephemeral_pool.h"
 #include "type/value_factory.h"
 
 namespace peloton {
@@ -99,5 +100,65 @@ TEST_F(TileTests, BasicTest) {
   tile->InsertTuple(2, tuple3.get());
 }
 
+TEST_F(TileTests, CompactVarlenPoolTest) {
+  // An integer column plus a varchar long enough to stay uninlined
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      type::TypeId::INTEGER, type::Type::GetTypeSize(type::TypeId::INTEGER),
+      "A", true));
+  columns.push_back(catalog::Column(type::TypeId::VARCHAR, 128, "B", false));
+  std::unique_ptr<catalog::Schema> schema(new catalog::Schema(columns));
+  EXPECT_FALSE(schema->IsInlined(1));
+
+  const int tuple_count = 4;
+  std::unique_ptr<storage::TileGroupHeader> header(
+      new storage::TileGroupHeader(BackendType::MM, tuple_count));
+  std::unique_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      header.get(), *schema, nullptr, tuple_count));
+
+  auto *pool = static_cast<type::EphemeralPool *>(tile->GetPool());
+  EXPECT_TRUE(pool != nullptr);
+
+  std::vector<std::string> strings = {std::string(80, 'a'),
+                                      std::string(90, 'b'),
+                                      std::string(100, 'c')};
+  for (int tuple_itr = 0; tuple_itr < 3; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(tuple_itr), pool);
+    tuple.SetValue(1, type::ValueFactory::GetVarcharValue(strings[tuple_itr]),
+                   pool);
+    tile->InsertTuple(tuple_itr, &tuple);
+  }
+  EXPECT_EQ(3UL, pool->locations_.size());
+  EXPECT_EQ(0UL, pool->GetFreedBytes());
+
+  // Free the varlen of the middle tuple the way the GC does on slot reset
+  char *field_location =
+      tile->GetTupleLocation(1) + schema->GetOffset(1);
+  char *varlen_ptr =
+      type::Value::GetDataFromStorage(type::TypeId::VARCHAR, field_location);
+  EXPECT_TRUE(varlen_ptr != nullptr);
+  pool->Free(varlen_ptr);
+  EXPECT_GT(pool->GetFreedBytes(), 0UL);
+
+  // Compact: survivors move into a fresh pool, the old pool is handed back
+  std::unique_ptr<type::AbstractPool> retired_pool(tile->CompactVarlenPool());
+  EXPECT_EQ(pool, retired_pool.get());
+
+  auto *new_pool = static_cast<type::EphemeralPool *>(tile->GetPool());
+  EXPECT_NE(pool, new_pool);
+  EXPECT_EQ(2UL, new_pool->locations_.size());
+  EXPECT_EQ(0UL, new_pool->GetFreedBytes());
+
+  // The surviving values read back unchanged through the new pool
+  for (int tuple_itr : {0, 2}) {
+    type::Value value = tile->GetValue(tuple_itr, 1);
+    EXPECT_EQ(CmpBool::TRUE,
+              value.CompareEquals(
+                  type::ValueFactory::GetVarcharValue(strings[tuple_itr])));
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// admission_controller_test.cpp
+//
+// Identification: test/trafficcop/admission_controller_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "settings/settings_manager.h"
+#include "traffic_cop/admission_controller.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Admission Controller Tests
+//===--------------------------------------------------------------------===//
+
+class AdmissionControllerTests : public PelotonTest {};
+
+TEST_F(AdmissionControllerTests, ClassCapAndQueueTest) {
+  // Cap the low class at one concurrent statement: the second low
+  // submission has to queue until the first finishes, while the uncapped
+  // high class keeps passing straight through
+  int32_t old_limit = settings::SettingsManager::GetInt(
+      settings::SettingId::admission_low_limit);
+  settings::SettingsManager::SetInt(settings::SettingId::admission_low_limit,
+                                    1);
+
+  auto &controller = tcop::AdmissionController::GetInstance();
+  int executed = 0;
+
+  controller.Submit(tcop::AdmissionClass::LOW, [&executed] { executed++; });
+  EXPECT_EQ(1, executed);
+
+  controller.Submit(tcop::AdmissionClass::LOW, [&executed] { executed++; });
+  EXPECT_EQ(1, executed);
+  EXPECT_EQ(1u, controller.QueuedCount(tcop::AdmissionClass::LOW));
+
+  controller.Submit(tcop::AdmissionClass::HIGH, [&executed] { executed++; });
+  EXPECT_EQ(2, executed);
+  controller.Finish(tcop::AdmissionClass::HIGH);
+
+  // Finishing the first low statement dispatches the queued one
+  controller.Finish(tcop::AdmissionClass::LOW);
+  EXPECT_EQ(3, executed);
+  EXPECT_EQ(0u, controller.QueuedCount(tcop::AdmissionClass::LOW));
+  controller.Finish(tcop::AdmissionClass::LOW);
+
+  settings::SettingsManager::SetInt(settings::SettingId::admission_low_limit,
+                                    old_limit);
+}
+
+}  // namespace test
+}  // namespace peloton
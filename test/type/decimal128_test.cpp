@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// decimal128_test.cpp
+//
+// Identification: test/type/decimal128_test.cpp
+//
+// Copyright (c) 2015-2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "type/decimal128.h"
+
+namespace peloton {
+namespace test {
+
+class Decimal128Tests : public PelotonTest {};
+
+TEST_F(Decimal128Tests, RoundTripTest) {
+  // Amounts with at most 8 fractional digits round-trip exactly
+  double amounts[] = {0.0, 0.01, -0.01, 19.99, -1234567.89, 0.00000001,
+                      99999999999.25};
+  for (double amount : amounts) {
+    EXPECT_DOUBLE_EQ(amount, type::Decimal128::FromDouble(amount).ToDouble());
+  }
+
+  EXPECT_EQ(42.0, type::Decimal128::FromInteger(42).ToDouble());
+  EXPECT_TRUE(type::Decimal128().IsZero());
+}
+
+TEST_F(Decimal128Tests, NoDriftTest) {
+  // One million adds of a cent amount that is not exactly representable as
+  // a double; the fixed-point sum is still exact
+  type::Decimal128 sum;
+  auto increment = type::Decimal128::FromDouble(0.10);
+  for (int i = 0; i < 1000000; i++) {
+    sum.Add(increment);
+  }
+  EXPECT_DOUBLE_EQ(100000.0, sum.ToDouble());
+
+  for (int i = 0; i < 1000000; i++) {
+    sum.Subtract(increment);
+  }
+  EXPECT_TRUE(sum.IsZero());
+}
+
+TEST_F(Decimal128Tests, MergeOrderTest) {
+  // Integer addition is associative, so partial sums merge to the same
+  // result regardless of order
+  double amounts[] = {0.1, 0.2, 0.3, 1000000.07, -0.55, 12.34};
+
+  type::Decimal128 forward;
+  for (double amount : amounts) {
+    forward.Add(type::Decimal128::FromDouble(amount));
+  }
+
+  type::Decimal128 backward;
+  for (int i = 5; i >= 0; i--) {
+    backward.Add(type::Decimal128::FromDouble(amounts[i]));
+  }
+
+  EXPECT_TRUE(forward == backward);
+  EXPECT_DOUBLE_EQ(1000012.46, forward.ToDouble());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -14,6 +14,7 @@
 #include <pthread.h>
 
 #include "type/ephemeral_pool.h"
+#include "type/memory_tracker.h"
 #include "gtest/gtest.h"
 #include "common/harness.h"
 
@@ -63,5 +64,70 @@ TEST_F(PoolTests, AllocateOnceTest) {
   pool->Free(p);
 }
 
+// A tracked pool charges the query memory tracker for its live bytes
+TEST_F(PoolTests, MemoryTrackerAccountingTest) {
+  type::QueryMemoryTracker tracker;
+  {
+    type::EphemeralPool pool(&tracker);
+
+    void *p = pool.Allocate(100);
+    EXPECT_EQ(100u, tracker.GetUsageBytes());
+
+    void *q = pool.Allocate(50);
+    EXPECT_EQ(150u, tracker.GetUsageBytes());
+    EXPECT_EQ(150u, tracker.GetPeakUsageBytes());
+
+    pool.Free(p);
+    EXPECT_EQ(50u, tracker.GetUsageBytes());
+    EXPECT_EQ(150u, tracker.GetPeakUsageBytes());
+
+    // q is released by the pool's destructor
+    (void)q;
+  }
+  EXPECT_EQ(0u, tracker.GetUsageBytes());
+}
+
+// An over-budget allocation fails the query with an executor error,
+// without the pool leaking the rejected block
+TEST_F(PoolTests, MemoryTrackerBudgetTest) {
+  type::QueryMemoryTracker tracker;
+  tracker.SetBudget(100);
+  type::EphemeralPool pool(&tracker);
+
+  void *p = pool.Allocate(80);
+  EXPECT_TRUE(p != nullptr);
+  EXPECT_THROW(pool.Allocate(80), peloton::ExecutorException);
+
+  // the rejected allocation was never charged
+  EXPECT_EQ(80u, tracker.GetUsageBytes());
+  EXPECT_EQ(80u, pool.GetAllocatedBytes());
+}
+
+// Spill hooks run before the budget check fails; a hook that frees
+// enough memory averts the error
+TEST_F(PoolTests, MemoryTrackerSpillHookTest) {
+  type::QueryMemoryTracker tracker;
+  tracker.SetBudget(100);
+  type::EphemeralPool pool(&tracker);
+
+  void *p = pool.Allocate(80);
+  int spill_count = 0;
+  tracker.RegisterSpillHook(&pool, [&]() -> size_t {
+    spill_count++;
+    pool.Free(p);
+    return 80;
+  });
+
+  // Over budget, but the hook sheds the first allocation
+  void *q = pool.Allocate(80);
+  EXPECT_TRUE(q != nullptr);
+  EXPECT_EQ(1, spill_count);
+  EXPECT_EQ(80u, tracker.GetUsageBytes());
+
+  // With the hook gone there is nothing left to shed
+  tracker.UnregisterSpillHook(&pool);
+  EXPECT_THROW(pool.Allocate(80), peloton::ExecutorException);
+}
+
 }  // namespace test
 }  // namespace peloton